@@ -6,9 +6,13 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "helics/core/ActionMessage.hpp"
+#include "helics/core/ActionMessageCodec.hpp"
 #include "helics_benchmark_main.h"
 
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace helics;  // NOLINT
 
@@ -251,4 +255,143 @@ static void BMdepacketizeStringsJson(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BMdepacketizeStringsJson);
 
+/** generate a mix of messages typical of a co-simulation exchange*/
+static std::vector<ActionMessage> generateMessageMix()
+{
+    std::vector<ActionMessage> mix;
+    ActionMessage treq(CMD_TIME_REQUEST);
+    treq.source_id = GlobalFederateId{131072};
+    treq.dest_id = GlobalFederateId{131073};
+    treq.actionTime = 10.0;
+    treq.Te = 10.5;
+    treq.Tdemin = 10.0;
+    treq.Tso = 10.0;
+    ActionMessage pub(CMD_PUB);
+    pub.source_id = GlobalFederateId{131072};
+    pub.source_handle = InterfaceHandle{4};
+    pub.dest_id = GlobalFederateId{131075};
+    pub.dest_handle = InterfaceHandle{2};
+    pub.actionTime = 10.0;
+    pub.payload = std::string(16, 'v');
+    ActionMessage mess(CMD_SEND_MESSAGE);
+    mess.source_id = GlobalFederateId{131072};
+    mess.source_handle = InterfaceHandle{7};
+    mess.dest_id = GlobalFederateId{131075};
+    mess.dest_handle = InterfaceHandle{1};
+    mess.actionTime = 10.0;
+    mess.payload = std::string(64, 'm');
+    mess.setStringData("fed2/endpoint_receive", "fed1/endpoint_send", "fed1/endpoint_send");
+    for (int ii = 0; ii < 4; ++ii) {
+        mix.push_back(treq);
+        mix.push_back(pub);
+        mix.push_back(mess);
+        treq.actionTime += 1.0;
+        treq.Te += 1.0;
+        pub.actionTime += 1.0;
+        mess.actionTime += 1.0;
+    }
+    return mix;
+}
+
+static const auto messageMix = generateMessageMix();
+
+static void BMpacketizeMix(benchmark::State& state)
+{
+    std::string load;
+    load.reserve(500);
+    std::size_t bytes{0};
+    for (auto _ : state) {
+        for (const auto& cmd : messageMix) {
+            cmd.packetize(load);
+            bytes += load.size();
+        }
+    }
+    state.counters["bytes_per_message"] = benchmark::Counter(
+        static_cast<double>(bytes) /
+        static_cast<double>(state.iterations() * static_cast<int64_t>(messageMix.size())));
+}
+// Register the function as a benchmark
+BENCHMARK(BMpacketizeMix);
+
+static void BMdepacketizeMix(benchmark::State& state)
+{
+    std::string load;
+    for (const auto& cmd : messageMix) {
+        load.append(cmd.packetize());
+    }
+    ActionMessage conv;
+    for (auto _ : state) {
+        std::size_t used_total{0};
+        while (used_total < load.size()) {
+            used_total +=
+                conv.depacketize(reinterpret_cast<const std::byte*>(load.data()) + used_total,
+                                 load.size() - used_total);
+        }
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMdepacketizeMix);
+
+static void BMpacketizeMixCompact(benchmark::State& state)
+{
+    std::string load;
+    load.reserve(500);
+    std::size_t bytes{0};
+    CompactMessageEncoder encoder(true);
+    for (auto _ : state) {
+        for (const auto& cmd : messageMix) {
+            encoder.packetize(cmd, load);
+            bytes += load.size();
+        }
+    }
+    state.counters["bytes_per_message"] = benchmark::Counter(
+        static_cast<double>(bytes) /
+        static_cast<double>(state.iterations() * static_cast<int64_t>(messageMix.size())));
+}
+// Register the function as a benchmark
+BENCHMARK(BMpacketizeMixCompact);
+
+static void BMdepacketizeMixCompact(benchmark::State& state)
+{
+    std::string load;
+    std::string packet;
+    // without interning so every pass through the stream decodes the same way
+    CompactMessageEncoder encoder;
+    for (const auto& cmd : messageMix) {
+        encoder.packetize(cmd, packet);
+        load.append(packet);
+    }
+    ActionMessage conv;
+    CompactMessageDecoder decoder;
+    for (auto _ : state) {
+        std::size_t used_total{0};
+        while (used_total < load.size()) {
+            used_total +=
+                decoder.depacketize(reinterpret_cast<const std::byte*>(load.data()) + used_total,
+                                    load.size() - used_total,
+                                    conv);
+        }
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMdepacketizeMixCompact);
+
+static void BMmessageConversion(benchmark::State& state)
+{
+    const std::string source = "federate_source/endpoint_1";
+    const std::string destination = "federate_dest/endpoint_2";
+    for (auto _ : state) {
+        auto message = std::make_unique<Message>();
+        message->source = source;
+        message->original_source = source;
+        message->dest = destination;
+        message->data = "payload of 32 bytes.............";
+        ActionMessage cmd(std::move(message));
+        auto received = createMessageFromCommand(std::move(cmd));
+        benchmark::DoNotOptimize(received);
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMmessageConversion);
+
 HELICS_BENCHMARK_MAIN(actionMessageBenchmark);
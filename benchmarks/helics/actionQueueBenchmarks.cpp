@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/ActionQueue.hpp"
+#include "helics_benchmark_main.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace helics;  // NOLINT
+
+/** contention on the primary routing queue of a core or broker
+@details several producer threads push messages as fast as possible, as federate and comms threads
+would, while a single consumer pops them, every 16th message is a priority message*/
+static void BMactionQueue_contention(benchmark::State& state, bool lockFree)
+{
+    const auto producerCount = static_cast<int>(state.range(0));
+    static constexpr int totalMessages{1 << 17};
+    const int messagesPerProducer = totalMessages / producerCount;
+    for (auto _ : state) {
+        state.PauseTiming();
+        ActionQueue queue;
+        queue.setLockFree(lockFree);
+        std::atomic<int> ready{0};
+        std::atomic<bool> start{false};
+        std::vector<std::thread> producers;
+        producers.reserve(producerCount);
+        for (int ii = 0; ii < producerCount; ++ii) {
+            producers.emplace_back([&, ii]() {
+                ++ready;
+                while (!start.load()) {
+                    std::this_thread::yield();
+                }
+                for (int jj = 0; jj < messagesPerProducer; ++jj) {
+                    if ((jj & 0x0F) == 0) {
+                        queue.emplacePriority(CMD_PING_PRIORITY);
+                    } else {
+                        ActionMessage message(CMD_PUB);
+                        message.messageID = ii;
+                        message.sequenceID = jj;
+                        queue.push(std::move(message));
+                    }
+                }
+            });
+        }
+        while (ready.load() < producerCount) {
+            std::this_thread::yield();
+        }
+        state.ResumeTiming();
+        start.store(true);
+        for (int ii = 0; ii < messagesPerProducer * producerCount; ++ii) {
+            benchmark::DoNotOptimize(queue.pop());
+        }
+        state.PauseTiming();
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * messagesPerProducer * producerCount);
+}
+
+BENCHMARK_CAPTURE(BMactionQueue_contention, blocking, false)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BMactionQueue_contention, lockfree, true)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(actionQueueBenchmark);
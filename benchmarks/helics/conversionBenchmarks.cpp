@@ -5,11 +5,14 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 
+#include "helics/application_api/TranslatorOperations.hpp"
 #include "helics/application_api/ValueConverter.hpp"
 #include "helics_benchmark_main.h"
 
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 template<class T>
@@ -69,4 +72,33 @@ BENCHMARK_CAPTURE(BMinterpret,
 
 BENCHMARK_CAPTURE(BMinterpret, vector_interp, std::vector<double>{26.5, 18.6, -48.5, -5.4e-12});
 
+/** convert a value to a JSON message and back through a JSON translator, the argument selects the
+general conversion (0) or the schema conversion (1)*/
+template<class T>
+static void BMjsonTranslator(benchmark::State& state, const T& arg)
+{
+    helics::JsonTranslatorOperator translator;
+    translator.setSchema((state.range(0) == 0) ? helics::DataType::HELICS_UNKNOWN :
+                                                 helics::DataType::HELICS_ANY);
+    helics::TranslatorOperator& op = translator;
+    auto value = helics::ValueConverter<T>::convert(arg);
+    for (auto _ : state) {
+        auto message = op.convertToMessage(value);
+        auto result = op.convertToValue(std::move(message));
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_CAPTURE(BMjsonTranslator, double_json, -356.56e-27)->Arg(0)->Arg(1);
+
+BENCHMARK_CAPTURE(BMjsonTranslator, string_json, std::string{"test a longer string"})
+    ->Arg(0)
+    ->Arg(1);
+
+BENCHMARK_CAPTURE(BMjsonTranslator,
+                  vector_json,
+                  std::vector<double>{26.5, 18.6, -48.5, -5.4e-12, 1.0, 7.25e8})
+    ->Arg(0)
+    ->Arg(1);
+
 HELICS_BENCHMARK_MAIN(conversionBenchmark);
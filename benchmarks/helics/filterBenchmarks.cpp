@@ -7,7 +7,10 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "EchoMessageHubFederate.hpp"
 #include "EchoMessageLeafFederate.hpp"
+#include "helics/application_api/FilterOperations.hpp"
 #include "helics/application_api/Filters.hpp"
+#include "helics/application_api/MessageOperators.hpp"
+#include "helics/core/ActionMessage.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/CoreFactory.hpp"
 #include "helics/helics-config.h"
@@ -18,6 +21,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <fstream>
 #include <gmlc/concurrency/Barrier.hpp>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -79,6 +83,172 @@ BENCHMARK(BMfilter_singleCore)
     ->Iterations(1)
     ->UseRealTime();
 
+static void BMfilter_reroute_singleCore(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+
+        int feds = static_cast<int>(state.range(0));
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(feds) + 1);
+        auto wcore = helics::CoreFactory::create(CoreType::INPROC,
+                                                 std::string("--autobroker --federates=") +
+                                                     std::to_string(feds + 1));
+        EchoMessageHub hub;
+        hub.initialize(wcore->getIdentifier(), "");
+        std::vector<EchoMessageLeaf> leafs(feds);
+        for (int ii = 0; ii < feds; ++ii) {
+            std::string bmInit = "--index=" + std::to_string(ii);
+            leafs[ii].initialize(wcore->getIdentifier(), bmInit);
+        }
+        // reroute all the echo responses back to their original destination through a set of
+        // 10 conditions with only the last one matching so each message evaluates every condition
+        auto filt1 = make_filter(helics::FilterTypes::REROUTE, wcore.get());
+        filt1->addSourceTarget("echo");
+        for (int ii = 0; ii < 9; ++ii) {
+            filt1->setString("condition", "^nomatch_" + std::to_string(ii) + "/.*$");
+        }
+        filt1->setString("condition", "leaf$");
+        filt1->setString("newdestination", "${dest}");
+
+        std::vector<std::thread> threadlist(static_cast<size_t>(feds));
+        for (int ii = 0; ii < feds; ++ii) {
+            threadlist[ii] =
+                std::thread([&](EchoMessageLeaf& lf) { lf.run([&brr]() { brr.wait(); }); },
+                            std::ref(leafs[ii]));
+        }
+        hub.makeReady();
+        brr.wait();
+        state.ResumeTiming();
+        hub.run([]() {});
+        state.PauseTiming();
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        wcore.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMfilter_reroute_singleCore)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
+/** run a chain of delay, reroute, and random drop operators on a message
+@details range(0)==1 runs the operators directly on the ActionMessage, otherwise each operator gets
+a Message built from the ActionMessage as operators without command processing do*/
+static void BMfilter_operatorChain(benchmark::State& state)
+{
+    helics::DelayFilterOperation delay;
+    delay.set("delay", 0.001);
+    helics::RerouteFilterOperation reroute;
+    reroute.setString("condition", "leaf$");
+    reroute.setString("newdestination", "${dest}");
+    helics::RandomDropFilterOperation drop;
+    drop.set("prob", 0.0);
+    const std::vector<std::shared_ptr<helics::FilterOperator>> operators{delay.getOperator(),
+                                                                         reroute.getOperator(),
+                                                                         drop.getOperator()};
+
+    helics::ActionMessage command(helics::CMD_SEND_MESSAGE);
+    command.setString(helics::targetStringLoc, "echo_leaf");
+    command.setString(helics::sourceStringLoc, "echo");
+    command.setString(helics::origSourceStringLoc, "echo");
+    command.payload = std::string(256, 'a');
+    const bool direct = (state.range(0) == 1);
+    for (auto _ : state) {
+        for (const auto& filterOp : operators) {
+            if (direct) {
+                filterOp->processCommand(command);
+            } else {
+                command = filterOp->process(helics::createMessageFromCommand(std::move(command)));
+            }
+        }
+        benchmark::DoNotOptimize(command);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BMfilter_operatorChain)->DenseRange(1, 2);
+
+/** the same delay, reroute, and random drop chain as BMfilter_operatorChain on the echo messages
+@details range(1)==1 uses the built-in filters, otherwise the operations are custom operators that
+need a Message*/
+static void BMfilter_chain_singleCore(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+
+        int feds = static_cast<int>(state.range(0));
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(feds) + 1);
+        auto wcore = helics::CoreFactory::create(CoreType::INPROC,
+                                                 std::string("--autobroker --federates=") +
+                                                     std::to_string(feds + 1));
+        EchoMessageHub hub;
+        hub.initialize(wcore->getIdentifier(), "");
+        std::vector<EchoMessageLeaf> leafs(feds);
+        for (int ii = 0; ii < feds; ++ii) {
+            std::string bmInit = "--index=" + std::to_string(ii);
+            leafs[ii].initialize(wcore->getIdentifier(), bmInit);
+        }
+        std::vector<std::unique_ptr<helics::Filter>> filters;
+        if (state.range(1) == 1) {
+            filters.push_back(make_filter(helics::FilterTypes::DELAY, wcore.get()));
+            filters.push_back(make_filter(helics::FilterTypes::REROUTE, wcore.get()));
+            filters.back()->setString("condition", "leaf$");
+            filters.back()->setString("newdestination", "${dest}");
+            filters.push_back(make_filter(helics::FilterTypes::RANDOM_DROP, wcore.get()));
+            filters.back()->set("prob", 0.0);
+        } else {
+            for (int ii = 0; ii < 3; ++ii) {
+                filters.push_back(make_filter(helics::FilterTypes::CUSTOM, wcore.get()));
+            }
+            filters[0]->setOperator(std::make_shared<helics::CustomMessageOperator>(
+                [](std::unique_ptr<helics::Message> message) { return message; }));
+            filters[1]->setOperator(std::make_shared<helics::CustomMessageOperator>(
+                [](std::unique_ptr<helics::Message> message) {
+                    if (message->original_dest.empty()) {
+                        message->original_dest = message->dest;
+                    }
+                    return message;
+                }));
+            filters[2]->setOperator(std::make_shared<helics::CustomMessageOperator>(
+                [](std::unique_ptr<helics::Message> message) { return message; }));
+        }
+        for (auto& filt : filters) {
+            filt->addSourceTarget("echo");
+        }
+
+        std::vector<std::thread> threadlist(static_cast<size_t>(feds));
+        for (int ii = 0; ii < feds; ++ii) {
+            threadlist[ii] =
+                std::thread([&](EchoMessageLeaf& lf) { lf.run([&brr]() { brr.wait(); }); },
+                            std::ref(leafs[ii]));
+        }
+        hub.makeReady();
+        brr.wait();
+        state.ResumeTiming();
+        hub.run([]() {});
+        state.PauseTiming();
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        wcore.reset();
+        helics::cleanupHelicsLibrary();
+        state.ResumeTiming();
+    }
+}
+// Register the function as a benchmark
+BENCHMARK(BMfilter_chain_singleCore)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 32}, {1, 2}})
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->Iterations(1)
+    ->UseRealTime();
+
 static void BMfilter_multiCore(benchmark::State& state, CoreType cType)
 {
     for (auto _ : state) {
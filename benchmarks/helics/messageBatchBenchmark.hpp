@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "MessageExchangeFederate.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/CoreFactory.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <gmlc/concurrency/Barrier.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** exchange messages between two federates on separate network cores with and without the batched
+transmit mode enabled in the comms*/
+inline void BMmessageBatch(benchmark::State& state, helics::CoreType cType, bool batching)
+{
+    const std::string batchArgs = batching ? " --batch_transmit --max_batch_size=256" : "";
+    int64_t totalMessages{0};
+    for (auto _ : state) {
+        state.PauseTiming();
+
+        int fed_count = 2;
+        gmlc::concurrency::Barrier brr(static_cast<size_t>(fed_count + 1));
+
+        auto broker = helics::BrokerFactory::create(cType,
+                                                    "brokerb",
+                                                    std::string("--federates=") +
+                                                        std::to_string(fed_count) + batchArgs);
+        broker->setLoggingLevel(HELICS_LOG_LEVEL_NO_PRINT);
+
+        std::vector<MessageExchangeFederate> feds(fed_count);
+        std::vector<std::shared_ptr<helics::Core>> cores(fed_count);
+
+        int msg_size = static_cast<int>(state.range(0));
+        int msg_count = static_cast<int>(state.range(1));
+        for (int ii = 0; ii < fed_count; ++ii) {
+            std::string bmInit = "--index=" + std::to_string(ii) +
+                " --msg_size=" + std::to_string(msg_size) +
+                " --msg_count=" + std::to_string(msg_count);
+            cores[ii] =
+                helics::CoreFactory::create(cType, "-f 1 --log_level=no_print" + batchArgs);
+            cores[ii]->connect();
+            feds[ii].initialize(cores[ii]->getIdentifier(), bmInit);
+        }
+
+        std::vector<std::thread> threadlist(static_cast<size_t>(fed_count));
+        for (int ii = 0; ii < fed_count; ++ii) {
+            threadlist[ii] = std::thread(
+                [&](MessageExchangeFederate& f) {
+                    f.run(
+                        [&brr]() {
+                            brr.wait();
+                            brr.wait();
+                        },
+                        [&brr]() { brr.wait(); });
+                },
+                std::ref(feds[ii]));
+        }
+
+        brr.wait();
+        state.ResumeTiming();
+        brr.wait();
+        brr.wait();
+        state.PauseTiming();
+
+        for (auto& thrd : threadlist) {
+            thrd.join();
+        }
+        totalMessages += static_cast<int64_t>(msg_count) * fed_count;
+
+        broker->disconnect();
+        broker.reset();
+        cores.clear();
+        helics::cleanupHelicsLibrary();
+
+        state.ResumeTiming();
+    }
+    state.counters["msg/s"] =
+        benchmark::Counter(static_cast<double>(totalMessages), benchmark::Counter::kIsRate);
+}
@@ -10,6 +10,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/CoreFactory.hpp"
+#include "helics/core/HandleManager.hpp"
+#include "helics/core/RouteTable.hpp"
 #include "helics/helics-config.h"
 #include "helics_benchmark_main.h"
 
@@ -18,10 +20,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <fstream>
 #include <gmlc/concurrency/Barrier.hpp>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <random>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 /** class implementing the hub for an echo test*/
@@ -213,6 +217,122 @@ BENCHMARK_CAPTURE(BMmgen_multiCore, inprocCore_big8, CoreType::INPROC)
     ->Ranges({{1 << 17, 1 << 19}, {8, 8}})
     ->Iterations(1)
     ->UseRealTime();
+/** generate a random sequence of federate ids to route, the ids are drawn from a set of federates
+and brokers assigned in the same way as the root broker does*/
+static std::vector<helics::GlobalFederateId> routeTargets(int count)
+{
+    std::vector<helics::GlobalFederateId> targets(1 << 14);
+    std::mt19937 gen(count);
+    std::uniform_int_distribution<int> dist(0, count - 1);
+    for (auto& target : targets) {
+        const auto index = dist(gen);
+        // one id in 8 is a broker
+        target = (index % 8 == 0) ?
+            helics::GlobalFederateId(helics::gGlobalBrokerIdShift + index / 8) :
+            helics::GlobalFederateId(helics::gGlobalFederateIdShift + index);
+    }
+    return targets;
+}
+
+/** route lookups through a table type indexed by GlobalFederateId*/
+template<class TABLE, class LOOKUP>
+static void routeLookups(benchmark::State& state, TABLE& table, LOOKUP lookup)
+{
+    const auto count = static_cast<int>(state.range(0));
+    for (int ii = 0; ii < count; ++ii) {
+        const helics::route_id route(ii % 64 + 1);
+        table.emplace(helics::GlobalFederateId(helics::gGlobalFederateIdShift + ii), route);
+        table.emplace(helics::GlobalFederateId(helics::gGlobalBrokerIdShift + ii / 8), route);
+    }
+    const auto targets = routeTargets(count);
+    for (auto _ : state) {
+        int32_t total{0};
+        for (const auto& target : targets) {
+            total += lookup(table, target).baseValue();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(targets.size()));
+}
+
+static void BMroute_map(benchmark::State& state)
+{
+    std::map<helics::GlobalFederateId, helics::route_id> table;
+    routeLookups(state, table, [](const auto& tab, helics::GlobalFederateId fid) {
+        auto fnd = tab.find(fid);
+        return (fnd != tab.end()) ? fnd->second : helics::parent_route_id;
+    });
+}
+
+static void BMroute_unorderedMap(benchmark::State& state)
+{
+    std::unordered_map<helics::GlobalFederateId, helics::route_id> table;
+    routeLookups(state, table, [](const auto& tab, helics::GlobalFederateId fid) {
+        auto fnd = tab.find(fid);
+        return (fnd != tab.end()) ? fnd->second : helics::parent_route_id;
+    });
+}
+
+static void BMroute_routeTable(benchmark::State& state)
+{
+    helics::RouteTable table;
+    routeLookups(state, table, [](const auto& tab, helics::GlobalFederateId fid) {
+        return tab.find(fid);
+    });
+}
+
+BENCHMARK(BMroute_map)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(BMroute_unorderedMap)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(BMroute_routeTable)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+/** resolve the destination of messages sent by name from a set of sources each sending to a fixed
+destination, using the name lookup directly or through the destination cache*/
+static void BMroute_namedDestination(benchmark::State& state)
+{
+    const auto count = static_cast<int>(state.range(0));
+    const bool cached = (state.range(1) != 0);
+    helics::HandleManager handles;
+    std::vector<std::string> names;
+    for (int ii = 0; ii < count; ++ii) {
+        names.push_back("fed" + std::to_string(ii) + "/endpoint_" + std::to_string(ii));
+        handles.addHandle(helics::GlobalFederateId(helics::gGlobalFederateIdShift + ii),
+                          helics::InterfaceHandle(ii),
+                          helics::InterfaceType::ENDPOINT,
+                          names.back(),
+                          "",
+                          "");
+    }
+    // each endpoint sends to its neighbor
+    std::vector<std::pair<helics::GlobalHandle, std::string>> sends;
+    for (int ii = 0; ii < count; ++ii) {
+        sends.emplace_back(helics::GlobalHandle(helics::GlobalFederateId(
+                                                    helics::gGlobalFederateIdShift + ii),
+                                                helics::InterfaceHandle(ii)),
+                           names[(ii + 1) % count]);
+    }
+    helics::DestinationCache cache;
+    for (auto _ : state) {
+        int64_t found{0};
+        for (const auto& send : sends) {
+            helics::BasicHandleInfo* destination{nullptr};
+            if (!cached) {
+                destination =
+                    handles.getInterfaceHandle(send.second, helics::InterfaceType::ENDPOINT);
+            } else if (!cache.find(
+                           send.first, send.second, handles.nameGeneration(), destination)) {
+                destination =
+                    handles.getInterfaceHandle(send.second, helics::InterfaceType::ENDPOINT);
+                cache.store(send.first, send.second, handles.nameGeneration(), destination);
+            }
+            found += (destination != nullptr) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BMroute_namedDestination)->Ranges({{8, 1 << 12}, {0, 1}});
+
 /*
 // Register the ZMQ benchmarks
 BENCHMARK_CAPTURE (BM_ring_multiCore, zmqCore, CoreType::ZMQ)
@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Inputs.hpp"
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+
+using helics::CoreType;
+using helics::MultiInputHandlingMethod;
+
+/** aggregate the values from a number of publications on a single input
+@details the input is linked to the publications so the source types and units come from the core,
+the timed loop only runs the aggregation on stored values*/
+template<class T>
+static void BMmultiInput(benchmark::State& state, MultiInputHandlingMethod method, const T& value)
+{
+    const auto sources = static_cast<int>(state.range(0));
+    auto wcore = helics::CoreFactory::create(CoreType::INPROC, "--autobroker --federates=1");
+    helics::FederateInfo fedInfo(CoreType::INPROC);
+    fedInfo.coreName = wcore->getIdentifier();
+    auto vFed = std::make_unique<helics::ValueFederate>("aggregator", fedInfo);
+
+    auto& input = vFed->registerInput<T>("input", "m");
+    input.setOption(HELICS_HANDLE_OPTION_MULTI_INPUT_HANDLING_METHOD, method);
+    std::vector<std::shared_ptr<const helics::SmallBuffer>> values;
+    for (int ii = 0; ii < sources; ++ii) {
+        auto& pub = vFed->registerGlobalPublication<T>("pub" + std::to_string(ii), "km");
+        input.addTarget(pub.getName());
+        values.push_back(
+            std::make_shared<helics::SmallBuffer>(helics::ValueConverter<T>::convert(value)));
+    }
+    vFed->enterExecutingMode();
+    input.vectorDataProcess(values);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(input.vectorDataProcess(values));
+    }
+    state.SetItemsProcessed(state.iterations() * sources);
+    vFed->finalize();
+    vFed.reset();
+    wcore.reset();
+    helics::cleanupHelicsLibrary();
+}
+
+static const std::vector<double> testVector{26.5, 18.6, -48.5, -5.4e-12, 7.0, 1.5, -2.25, 3.0};
+
+BENCHMARK_CAPTURE(BMmultiInput, sum_double, MultiInputHandlingMethod::SUM_OPERATION, 45.3)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput, max_double, MultiInputHandlingMethod::MAX_OPERATION, 45.3)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput, diff_double, MultiInputHandlingMethod::DIFF_OPERATION, 45.3)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput,
+                  average_vector,
+                  MultiInputHandlingMethod::AVERAGE_OPERATION,
+                  testVector)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput, max_vector, MultiInputHandlingMethod::MAX_OPERATION, testVector)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput,
+                  vectorize_vector,
+                  MultiInputHandlingMethod::VECTORIZE_OPERATION,
+                  testVector)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+BENCHMARK_CAPTURE(BMmultiInput,
+                  max_complex,
+                  MultiInputHandlingMethod::MAX_OPERATION,
+                  std::complex<double>{45.7, -19.5})
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+HELICS_BENCHMARK_MAIN(multiInputBenchmark);
@@ -0,0 +1,33 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/helics-config.h"
+#include "helics_benchmark_main.h"
+#include "messageBatchBenchmark.hpp"
+
+using helics::CoreType;
+
+#ifdef HELICS_ENABLE_TCP_CORE
+// The first element in the ranges is message size, and the second is message count
+// clang-format off
+BENCHMARK_CAPTURE(BMmessageBatch, tcpCore/unbatched, CoreType::TCP, false)
+    // clang-format on
+    ->Ranges({{8, 1 << 10}, {1 << 4, 1 << 12}})
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+// clang-format off
+BENCHMARK_CAPTURE(BMmessageBatch, tcpCore/batched, CoreType::TCP, true)
+    // clang-format on
+    ->Ranges({{8, 1 << 10}, {1 << 4, 1 << 12}})
+    ->Iterations(1)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+#endif
+
+HELICS_BENCHMARK_MAIN(tcpBatchBenchmark);
@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/TimerWheel.hpp"
+#include "helics_benchmark_main.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace helics;  // NOLINT
+using namespace std::literals::chrono_literals;
+
+using time_type = std::chrono::steady_clock::time_point;
+
+namespace {
+/** records how late each timer fired*/
+class LatenessRecorder: public TimerWheel::Client {
+  public:
+    explicit LatenessRecorder(std::size_t timerCount):
+        expirations(timerCount), lateness(timerCount)
+    {
+    }
+    void timerExpired(std::int32_t index) override
+    {
+        lateness[index] = std::chrono::steady_clock::now() - expirations[index];
+        ++fired;
+    }
+
+    std::vector<time_type> expirations;
+    std::vector<std::chrono::nanoseconds> lateness;
+    std::atomic<std::size_t> fired{0};
+};
+
+std::vector<std::chrono::nanoseconds> generateSpans(std::size_t timerCount,
+                                                    std::chrono::nanoseconds window)
+{
+    std::mt19937_64 generator(std::random_device{}());
+    std::uniform_int_distribution<std::int64_t> dist(0, window.count());
+    std::vector<std::chrono::nanoseconds> spans(timerCount);
+    for (auto& span : spans) {
+        span = std::chrono::nanoseconds(dist(generator));
+    }
+    return spans;
+}
+
+void setLatenessCounters(benchmark::State& state,
+                         std::vector<std::chrono::nanoseconds>& lateness,
+                         std::clock_t cpuStart)
+{
+    std::sort(lateness.begin(), lateness.end());
+    const auto toMicroseconds = [](std::chrono::nanoseconds span) {
+        return std::chrono::duration<double, std::micro>(span).count();
+    };
+    state.counters["late_p50_us"] = toMicroseconds(lateness[lateness.size() / 2]);
+    state.counters["late_p99_us"] = toMicroseconds(lateness[lateness.size() * 99 / 100]);
+    state.counters["late_max_us"] = toMicroseconds(lateness.back());
+    // process cpu time so the work done in the asio thread is included
+    state.counters["process_cpu_ms"] =
+        1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+}
+}  // namespace
+
+/** accuracy and cpu cost of firing timers spread over 200ms through the timer wheel
+@details the second argument is the tick length in microseconds*/
+static void BMtimerWheel_accuracy(benchmark::State& state)
+{
+    const auto timerCount = static_cast<std::size_t>(state.range(0));
+    auto wheel = std::make_shared<TimerWheel>(std::chrono::microseconds(state.range(1)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto recorder = std::make_shared<LatenessRecorder>(timerCount);
+        const auto spans = generateSpans(timerCount, 200ms);
+        std::vector<std::int32_t> timers(timerCount);
+        for (std::size_t ii = 0; ii < timerCount; ++ii) {
+            timers[ii] = wheel->createTimer(static_cast<std::int32_t>(ii));
+        }
+        const auto cpuStart = std::clock();
+        state.ResumeTiming();
+        const auto start = std::chrono::steady_clock::now() + 10ms;
+        for (std::size_t ii = 0; ii < timerCount; ++ii) {
+            recorder->expirations[ii] = start + spans[ii];
+            wheel->schedule(timers[ii], recorder->expirations[ii], recorder);
+        }
+        while (recorder->fired.load() < timerCount) {
+            std::this_thread::sleep_for(1ms);
+        }
+        state.PauseTiming();
+        setLatenessCounters(state, recorder->lateness, cpuStart);
+        for (auto timer : timers) {
+            wheel->releaseTimer(timer);
+        }
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BMtimerWheel_accuracy)
+    ->Args({10000, 1000})
+    ->Args({10000, 100})
+    ->Args({10000, 10})
+    ->Iterations(5)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+/** the same measurement with one asio timer per expiration as MessageTimer used previously*/
+static void BMasioTimer_accuracy(benchmark::State& state)
+{
+    const auto timerCount = static_cast<std::size_t>(state.range(0));
+    auto contextPtr = gmlc::networking::AsioContextManager::getContextPointer();
+    auto loopHandle = contextPtr->startContextLoop();
+    for (auto _ : state) {
+        state.PauseTiming();
+        LatenessRecorder recorder(timerCount);
+        const auto spans = generateSpans(timerCount, 200ms);
+        std::vector<std::unique_ptr<asio::steady_timer>> timers(timerCount);
+        const auto cpuStart = std::clock();
+        state.ResumeTiming();
+        const auto start = std::chrono::steady_clock::now() + 10ms;
+        for (std::size_t ii = 0; ii < timerCount; ++ii) {
+            recorder.expirations[ii] = start + spans[ii];
+            timers[ii] = std::make_unique<asio::steady_timer>(contextPtr->getBaseContext());
+            timers[ii]->expires_at(recorder.expirations[ii]);
+            timers[ii]->async_wait([&recorder, ii](const std::error_code& error) {
+                if (error != asio::error::operation_aborted) {
+                    recorder.timerExpired(static_cast<std::int32_t>(ii));
+                }
+            });
+        }
+        while (recorder.fired.load() < timerCount) {
+            std::this_thread::sleep_for(1ms);
+        }
+        state.PauseTiming();
+        setLatenessCounters(state, recorder.lateness, cpuStart);
+        timers.clear();
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BMasioTimer_accuracy)
+    ->Arg(10000)
+    ->Iterations(5)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+/** cost of rescheduling and cancelling a timer with 10k other timers active*/
+static void BMtimerWheel_reschedule(benchmark::State& state)
+{
+    const auto timerCount = static_cast<std::size_t>(state.range(0));
+    auto wheel = std::make_shared<TimerWheel>();
+    auto recorder = std::make_shared<LatenessRecorder>(timerCount);
+    const auto spans = generateSpans(timerCount, 100s);
+    const auto start = std::chrono::steady_clock::now() + 100s;
+    std::vector<std::int32_t> timers(timerCount);
+    for (std::size_t ii = 0; ii < timerCount; ++ii) {
+        timers[ii] = wheel->createTimer(static_cast<std::int32_t>(ii));
+        wheel->schedule(timers[ii], start + spans[ii], recorder);
+    }
+    std::size_t index{0};
+    for (auto _ : state) {
+        wheel->schedule(timers[index], start + spans[timerCount - 1 - index], recorder);
+        const auto other = timers[(index + timerCount / 2) % timerCount];
+        wheel->cancel(other);
+        wheel->schedule(other, start + spans[index], recorder);
+        index = (index + 1) % timerCount;
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+    for (auto timer : timers) {
+        wheel->releaseTimer(timer);
+    }
+}
+
+BENCHMARK(BMtimerWheel_reschedule)->Arg(10000)->Unit(benchmark::TimeUnit::kNanosecond);
+
+/** the same operations on asio timers*/
+static void BMasioTimer_reschedule(benchmark::State& state)
+{
+    const auto timerCount = static_cast<std::size_t>(state.range(0));
+    auto contextPtr = gmlc::networking::AsioContextManager::getContextPointer();
+    auto loopHandle = contextPtr->startContextLoop();
+    const auto spans = generateSpans(timerCount, 100s);
+    const auto start = std::chrono::steady_clock::now() + 100s;
+    const auto handler = [](const std::error_code& /*error*/) {};
+    std::vector<std::unique_ptr<asio::steady_timer>> timers(timerCount);
+    for (std::size_t ii = 0; ii < timerCount; ++ii) {
+        timers[ii] = std::make_unique<asio::steady_timer>(contextPtr->getBaseContext());
+        timers[ii]->expires_at(start + spans[ii]);
+        timers[ii]->async_wait(handler);
+    }
+    std::size_t index{0};
+    for (auto _ : state) {
+        timers[index]->expires_at(start + spans[timerCount - 1 - index]);
+        timers[index]->async_wait(handler);
+        auto& other = timers[(index + timerCount / 2) % timerCount];
+        other->cancel();
+        other->expires_at(start + spans[index]);
+        other->async_wait(handler);
+        index = (index + 1) % timerCount;
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+    timers.clear();
+}
+
+BENCHMARK(BMasioTimer_reschedule)->Arg(10000)->Unit(benchmark::TimeUnit::kNanosecond);
+
+HELICS_BENCHMARK_MAIN(timerWheelBenchmark);
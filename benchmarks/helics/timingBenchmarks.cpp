@@ -7,16 +7,20 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "TimingHubFederate.hpp"
 #include "TimingLeafFederate.hpp"
+#include "helics/core/ActionMessage.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/CoreFactory.hpp"
+#include "helics/core/TimeCoordinator.hpp"
 #include "helics/helics-config.h"
 #include "helics_benchmark_main.h"
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <chrono>
 #include <fstream>
 #include <gmlc/concurrency/Barrier.hpp>
 #include <iostream>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
@@ -185,4 +189,58 @@ BENCHMARK_CAPTURE(BMtiming_multiCore, udpCore, CoreType::UDP)
     ->UseRealTime();
 #endif
 
+/** time step processing of a federate with a large number of dependencies
+@details each step every dependency sends a time request in a random order and each message is
+processed by the time coordinator followed by a time grant check, as a federate does*/
+static void BMtiming_dependencyUpdate(benchmark::State& state)
+{
+    using namespace helics;  // NOLINT
+    const auto depCount = static_cast<int>(state.range(0));
+    TimeCoordinator coord([](const ActionMessage& /*message*/) {});
+    coord.setSourceId(GlobalFederateId(131071));
+    std::vector<GlobalFederateId> ids;
+    ids.reserve(depCount);
+    for (int ii = 0; ii < depCount; ++ii) {
+        ids.emplace_back(131072 + ii);
+        coord.addDependency(ids.back());
+    }
+    coord.enteringExecMode(IterationRequest::NO_ITERATIONS);
+    ActionMessage execGrant(CMD_EXEC_GRANT);
+    for (const auto& id : ids) {
+        execGrant.source_id = id;
+        coord.processTimeMessage(execGrant);
+    }
+    coord.checkExecEntry();
+
+    std::mt19937 gen(1234);
+    ActionMessage request(CMD_TIME_REQUEST);
+    Time step{timeZero};
+    int grants{0};
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::shuffle(ids.begin(), ids.end(), gen);
+        step += 1.0;
+        coord.timeRequest(step, IterationRequest::NO_ITERATIONS, Time::maxVal(), Time::maxVal());
+        state.ResumeTiming();
+        for (const auto& id : ids) {
+            request.source_id = id;
+            request.actionTime = step;
+            request.Te = step;
+            request.Tdemin = step;
+            if (coord.processTimeMessage(request) != TimeProcessingResult::NOT_PROCESSED &&
+                coord.checkTimeGrant() == MessageProcessingResult::NEXT_STEP) {
+                ++grants;
+            }
+        }
+    }
+    benchmark::DoNotOptimize(grants);
+    state.SetItemsProcessed(state.iterations() * depCount);
+}
+BENCHMARK(BMtiming_dependencyUpdate)
+    ->Arg(1000)
+    ->Arg(2000)
+    ->Arg(5000)
+    ->Arg(10000)
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
+
 HELICS_BENCHMARK_MAIN(timingBenchmark);
@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/application_api/Inputs.hpp"
+#include "helics/application_api/Publications.hpp"
+#include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics_benchmark_main.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+using helics::CoreType;
+
+/** the ways the updated values are read by the federate after each time step*/
+enum class UpdateRead { PER_INPUT, BULK };
+
+/** a federate publishing to and reading back a large number of its own inputs each time step*/
+class UpdateFederate {
+  public:
+    explicit UpdateFederate(int inputs)
+    {
+        wcore = helics::CoreFactory::create(CoreType::INPROC, "--autobroker --federates=1");
+        helics::FederateInfo fedInfo(CoreType::INPROC);
+        fedInfo.coreName = wcore->getIdentifier();
+        fedInfo.setProperty(HELICS_PROPERTY_TIME_PERIOD, 1.0);
+        vFed = std::make_unique<helics::ValueFederate>("updates", fedInfo);
+        for (int ii = 0; ii < inputs; ++ii) {
+            pubs.push_back(&vFed->registerIndexedPublication<double>("pub", ii));
+            vFed->registerIndexedSubscription("pub", ii);
+        }
+    }
+    ~UpdateFederate()
+    {
+        vFed->finalize();
+        vFed.reset();
+        wcore.reset();
+        helics::cleanupHelicsLibrary();
+    }
+    /** publish a value on every publication and advance the federate by a step*/
+    void step()
+    {
+        for (auto* pub : pubs) {
+            pub->publish(++counter);
+        }
+        vFed->requestNextStep();
+    }
+
+    std::shared_ptr<helics::Core> wcore;
+    std::unique_ptr<helics::ValueFederate> vFed;
+    std::vector<helics::Publication*> pubs;
+    double counter{0.0};
+};
+
+/** read the values of all the updated inputs after each time step*/
+static void BMvalueUpdates(benchmark::State& state, UpdateRead method)
+{
+    const auto inputs = static_cast<int>(state.range(0));
+    UpdateFederate fed(inputs);
+    fed.vFed->enterExecutingMode();
+    std::vector<double> values(inputs);
+    std::vector<int> indices(inputs);
+    for (auto _ : state) {
+        state.PauseTiming();
+        fed.step();
+        state.ResumeTiming();
+        if (method == UpdateRead::BULK) {
+            benchmark::DoNotOptimize(
+                fed.vFed->getUpdatedValues(values.data(), indices.data(), inputs));
+        } else {
+            int count{0};
+            for (auto index : fed.vFed->queryUpdates()) {
+                values[count++] = fed.vFed->getInput(index).getValue<double>();
+            }
+            benchmark::DoNotOptimize(count);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * inputs);
+}
+
+BENCHMARK_CAPTURE(BMvalueUpdates, per_input, UpdateRead::PER_INPUT)
+    ->RangeMultiplier(10)
+    ->Range(100, 20000)
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
+
+BENCHMARK_CAPTURE(BMvalueUpdates, bulk, UpdateRead::BULK)
+    ->RangeMultiplier(10)
+    ->Range(100, 20000)
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
+
+/** a small fixed amount of computation in each input callback*/
+static double callbackWork(double input)
+{
+    double value{input};
+    for (int ii = 0; ii < 200; ++ii) {
+        value = std::sqrt(value * value + 1.0);
+    }
+    return value;
+}
+
+/** time steps of a federate with a notification callback on each input run on a varying number
+of threads*/
+static void BMinputCallbacks(benchmark::State& state)
+{
+    constexpr int inputs{5000};
+    const auto threads = static_cast<int>(state.range(0));
+    UpdateFederate fed(inputs);
+    std::vector<double> results(inputs);
+    for (int ii = 0; ii < inputs; ++ii) {
+        fed.vFed->setInputNotificationCallback(fed.vFed->getInput(ii),
+                                               [&results, ii](helics::Input& inp, helics::Time) {
+                                                   results[ii] =
+                                                       callbackWork(inp.getValue<double>());
+                                               });
+    }
+    fed.vFed->setInputCallbackThreads(threads);
+    fed.vFed->enterExecutingMode();
+    for (auto _ : state) {
+        fed.step();
+    }
+    state.SetItemsProcessed(state.iterations() * inputs);
+}
+
+BENCHMARK(BMinputCallbacks)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::TimeUnit::kMillisecond)
+    ->UseRealTime();
+
+HELICS_BENCHMARK_MAIN(valueUpdateBenchmark);
@@ -31,6 +31,9 @@
 %ignore helicsFilterSetCustomCallback;
 %ignore helicsTranslatorSetCustomCallback;
 %ignore helicsFederateSetQueryCallback;
+%ignore helicsFederateRequestTimeAsyncCallback;
+%ignore helicsFederateGetUpdatedDoubles;
+%ignore helicsFederateGetUpdatedIntegers;
 %ignore helicsQueryBufferFill;
 %ignore helicsLoadSignalHandlerCallback;
 
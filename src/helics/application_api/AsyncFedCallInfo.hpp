@@ -7,11 +7,69 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 #include "../core/helicsTime.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace helics {
+/** the shared state of a time request completed by the core*/
+class TimeRequestCompletion {
+  public:
+    std::promise<iteration_time> result;
+    std::function<void()> callback;
+    /** called by the federate once the future is stored and by the core once the result is set,
+    the second one to arrive calls the callback*/
+    void arrive()
+    {
+        if (arrivals.fetch_add(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (callback) {
+            {
+                const std::lock_guard<std::mutex> lock(callbackLock);
+                callbackThread = std::this_thread::get_id();
+            }
+            try {
+                callback();
+            }
+            catch (...) {
+                finishCallback();
+                throw;
+            }
+        }
+        finishCallback();
+    }
+    /** wait for the callback to finish so its effects are visible to the caller
+    @details returns immediately when called from inside the callback*/
+    void waitForCallback()
+    {
+        std::unique_lock<std::mutex> lock(callbackLock);
+        if (callbackThread == std::this_thread::get_id()) {
+            return;
+        }
+        callbackFinished.wait(lock, [this]() { return callbackDone; });
+    }
+
+  private:
+    void finishCallback()
+    {
+        const std::lock_guard<std::mutex> lock(callbackLock);
+        callbackDone = true;
+        callbackFinished.notify_all();
+    }
+    std::atomic<int> arrivals{0};
+    std::mutex callbackLock;
+    std::condition_variable callbackFinished;
+    std::thread::id callbackThread;
+    bool callbackDone{false};
+};
+
 /** helper class for Federate info that holds the futures for asynchronous calls*/
 class AsyncFedCallInfo {
   public:
@@ -20,9 +78,11 @@ class AsyncFedCallInfo {
     /** future for the enter execution mode call*/
     std::future<iteration_time> execFuture;
     /** future for the timeRequest call*/
-    std::future<Time> timeRequestFuture;
+    std::future<iteration_time> timeRequestFuture;
     /** future for the time request iterative call*/
     std::future<iteration_time> timeRequestIterativeFuture;
+    /** the completion of a time request made through the core, if any*/
+    std::shared_ptr<TimeRequestCompletion> timeRequestCompletion;
     /** future for the finalize call*/
     std::future<void> finalizeFuture;
     /** future for the iterative init call*/
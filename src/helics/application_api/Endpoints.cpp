@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Endpoints.hpp"
 
 #include "../core/Core.hpp"
+#include "../core/MessagePool.hpp"
 #include "../core/core-exceptions.hpp"
 #include "MessageFederate.hpp"
 
@@ -121,6 +122,13 @@ void Endpoint::send(std::unique_ptr<Message> mess) const
     }
 }
 
+void Endpoint::send(const Message& mess) const
+{
+    auto message = acquireMessage();
+    *message = mess;
+    send(std::move(message));
+}
+
 void Endpoint::setDefaultDestination(std::string_view target)
 {
     if (defDest.empty() && fed->getCurrentMode() < Federate::Modes::EXECUTING) {
@@ -144,6 +152,17 @@ std::unique_ptr<Message> Endpoint::getMessage() const
     return (fed != nullptr) ? fed->getMessage(*this) : nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> Endpoint::receiveAll() const
+{
+    return (fed != nullptr) ? fed->receiveAll(*this) : std::vector<std::unique_ptr<Message>>{};
+}
+
+std::vector<std::unique_ptr<Message>> Endpoint::receiveAll(std::size_t maxCount) const
+{
+    return (fed != nullptr) ? fed->receiveAll(*this, maxCount) :
+                              std::vector<std::unique_ptr<Message>>{};
+}
+
 /** check if there is a message available*/
 bool Endpoint::hasMessage() const
 {
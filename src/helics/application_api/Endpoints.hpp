@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace helics {
 class MessageFederate;
@@ -153,10 +154,14 @@ class HELICS_CXX_EXPORT Endpoint: public Interface {
     @details this is to send a pre-built message
     @param mess a reference to an actual message object
     */
-    void send(const Message& mess) const { send(std::make_unique<Message>(mess)); }
+    void send(const Message& mess) const;
 
     /** get an available message if there is no message the returned object is empty*/
     std::unique_ptr<Message> getMessage() const;
+    /** get all the available messages in time order in a single call*/
+    std::vector<std::unique_ptr<Message>> receiveAll() const;
+    /** get up to a maximum number of the available messages in time order in a single call*/
+    std::vector<std::unique_ptr<Message>> receiveAll(std::size_t maxCount) const;
     /** check if there is a message available*/
     bool hasMessage() const;
     /** Get the number of available messages*/
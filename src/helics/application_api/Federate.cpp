@@ -26,7 +26,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/utilities/stringOps.h"
 #include "helics/helics-config.h"
 
+#include <atomic>
 #include <fmt/format.h>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -1009,42 +1012,103 @@ iteration_time Federate::requestTimeIterative(Time nextInternalTimeStep, Iterati
     throw(InvalidFunctionCall("cannot call request time in present state"));
 }
 
-void Federate::requestTimeAsync(Time nextInternalTimeStep)
+void Federate::startTimeRequest(Time nextTime,
+                                IterationRequest iterate,
+                                Modes pendingMode,
+                                std::function<void()> callback)
 {
     if (singleThreadFederate) {
         throw(InvalidFunctionCall(
             "Async function calls and methods are not allowed for single thread federates"));
     }
     auto exp = Modes::EXECUTING;
-    if (currentMode.compare_exchange_strong(exp, Modes::PENDING_TIME)) {
-        preTimeRequestOperations(nextInternalTimeStep, false);
-        auto asyncInfo = asyncCallInfo->lock();
-        asyncInfo->timeRequestFuture =
-            std::async(std::launch::async, [this, nextInternalTimeStep]() {
-                return coreObject->timeRequest(fedID, nextInternalTimeStep);
-            });
-    } else {
+    if (!currentMode.compare_exchange_strong(exp, pendingMode)) {
         throw(InvalidFunctionCall("cannot call request time in present state"));
     }
+    preTimeRequestOperations(nextTime, iterate != IterationRequest::NO_ITERATIONS);
+    auto completion = std::make_shared<TimeRequestCompletion>();
+    completion->callback = std::move(callback);
+    auto future = completion->result.get_future();
+    auto coreCompletion = [completion, pendingMode](iteration_time granted,
+                                                    std::exception_ptr error) {
+        // the iterative call reports errors through the result like requestTimeIterative
+        if (error && pendingMode == Modes::PENDING_TIME) {
+            completion->result.set_exception(std::move(error));
+        } else {
+            completion->result.set_value(granted);
+        }
+        completion->arrive();
+    };
+    bool started{false};
+    try {
+        started =
+            coreObject->requestTimeAsync(fedID, nextTime, iterate, std::move(coreCompletion));
+    }
+    catch (...) {
+        // report the error through the future like the blocking call would
+        completion->result.set_exception(std::current_exception());
+        completion->arrive();
+        started = true;
+    }
+    if (!started) {
+        if (completion->callback) {
+            currentMode.store(Modes::EXECUTING);
+            throw(InvalidFunctionCall(
+                "time request completion callbacks are not available for this federate"));
+        }
+        future = std::async(std::launch::async, [this, nextTime, iterate, pendingMode]() {
+            if (pendingMode == Modes::PENDING_TIME) {
+                return iteration_time{coreObject->timeRequest(fedID, nextTime),
+                                      IterationResult::NEXT_STEP};
+            }
+            return coreObject->requestTimeIterative(fedID, nextTime, iterate);
+        });
+    }
+    {
+        auto asyncInfo = asyncCallInfo->lock();
+        if (pendingMode == Modes::PENDING_TIME) {
+            asyncInfo->timeRequestFuture = std::move(future);
+        } else {
+            asyncInfo->timeRequestIterativeFuture = std::move(future);
+        }
+        asyncInfo->timeRequestCompletion = started ? completion : nullptr;
+    }
+    if (started) {
+        completion->arrive();
+    }
 }
 
-void Federate::requestTimeIterativeAsync(Time nextInternalTimeStep, IterationRequest iterate)
+void Federate::requestTimeAsync(Time nextInternalTimeStep)
 {
-    if (singleThreadFederate) {
-        throw(InvalidFunctionCall(
-            "Async function calls and methods are not allowed for single thread federates"));
+    startTimeRequest(
+        nextInternalTimeStep, IterationRequest::NO_ITERATIONS, Modes::PENDING_TIME, {});
+}
+
+void Federate::requestTimeAsync(Time nextInternalTimeStep, std::function<void()> callback)
+{
+    if (!callback) {
+        throw(InvalidParameter("a callback is required for a completion based time request"));
     }
-    auto exp = Modes::EXECUTING;
-    if (currentMode.compare_exchange_strong(exp, Modes::PENDING_ITERATIVE_TIME)) {
-        preTimeRequestOperations(nextInternalTimeStep, iterate != IterationRequest::NO_ITERATIONS);
-        auto asyncInfo = asyncCallInfo->lock();
-        asyncInfo->timeRequestIterativeFuture =
-            std::async(std::launch::async, [this, nextInternalTimeStep, iterate]() {
-                return coreObject->requestTimeIterative(fedID, nextInternalTimeStep, iterate);
-            });
-    } else {
-        throw(InvalidFunctionCall("cannot call request time in present state"));
+    startTimeRequest(nextInternalTimeStep,
+                     IterationRequest::NO_ITERATIONS,
+                     Modes::PENDING_TIME,
+                     std::move(callback));
+}
+
+void Federate::requestTimeIterativeAsync(Time nextInternalTimeStep, IterationRequest iterate)
+{
+    startTimeRequest(nextInternalTimeStep, iterate, Modes::PENDING_ITERATIVE_TIME, {});
+}
+
+void Federate::requestTimeIterativeAsync(Time nextInternalTimeStep,
+                                         IterationRequest iterate,
+                                         std::function<void()> callback)
+{
+    if (!callback) {
+        throw(InvalidParameter("a callback is required for a completion based time request"));
     }
+    startTimeRequest(
+        nextInternalTimeStep, iterate, Modes::PENDING_ITERATIVE_TIME, std::move(callback));
 }
 
 Time Federate::requestTimeComplete()
@@ -1052,10 +1116,35 @@ Time Federate::requestTimeComplete()
     auto exp = Modes::PENDING_TIME;
     if (currentMode.compare_exchange_strong(exp, Modes::EXECUTING)) {
         auto asyncInfo = asyncCallInfo->lock();
-        auto newTime = asyncInfo->timeRequestFuture.get();
+        auto future = std::move(asyncInfo->timeRequestFuture);
+        auto completion = std::move(asyncInfo->timeRequestCompletion);
         asyncInfo.unlock();  // remove the lock;
-        postTimeRequestOperations(newTime, false);
-        return newTime;
+        iteration_time granted;
+        try {
+            granted = future.get();
+        }
+        catch (const FunctionExecutionFailure&) {
+            updateFederateMode(Modes::ERROR_STATE);
+            throw;
+        }
+        catch (const RegistrationFailure&) {
+            updateFederateMode(Modes::ERROR_STATE);
+            throw;
+        }
+        if (completion) {
+            completion->waitForCallback();
+        }
+        switch (granted.state) {
+            case IterationResult::ERROR_RESULT:
+                throw(FunctionExecutionFailure("time request returned an error result"));
+            case IterationResult::HALTED:
+                granted.grantedTime = Time::maxVal();
+                break;
+            default:
+                break;
+        }
+        postTimeRequestOperations(granted.grantedTime, false);
+        return granted.grantedTime;
     }
     throw(InvalidFunctionCall(
         "cannot call requestTimeComplete without first calling requestTimeAsync function"));
@@ -1068,7 +1157,13 @@ iteration_time Federate::requestTimeIterativeComplete()
     auto exp = Modes::PENDING_ITERATIVE_TIME;
     if (currentMode.compare_exchange_strong(exp, Modes::EXECUTING)) {
         auto asyncInfo = asyncCallInfo->lock();
-        auto iterativeTime = asyncInfo->timeRequestIterativeFuture.get();
+        auto future = std::move(asyncInfo->timeRequestIterativeFuture);
+        auto completion = std::move(asyncInfo->timeRequestCompletion);
+        asyncInfo.unlock();
+        auto iterativeTime = future.get();
+        if (completion) {
+            completion->waitForCallback();
+        }
         switch (iterativeTime.state) {
             case IterationResult::NEXT_STEP:
                 postTimeRequestOperations(iterativeTime.grantedTime, false);
@@ -297,6 +297,29 @@ class HELICS_CXX_EXPORT Federate {
     */
     void requestTimeIterativeAsync(Time nextInternalTimeStep, IterationRequest iterate);
 
+    /** request a time advancement and have a function called once it can be completed
+    @details no thread waits on the request, the callback is called on one of the core threads once
+    the time has been granted so many federates can be run from a small number of threads.  The
+    callback should not make blocking calls on the federate; /ref requestTimeComplete finishes the
+    operation.  Called from the callback it returns without blocking, called from another thread
+    it waits for the callback to finish.  Errors are thrown from /ref requestTimeComplete with the
+    same exceptions as /ref requestTime.
+    @param nextInternalTimeStep the next requested time step
+    @param callback the function to call when the request can be completed
+    @throws InvalidFunctionCall if the core cannot complete requests for the federate
+    asynchronously, such as for realtime federates*/
+    void requestTimeAsync(Time nextInternalTimeStep, std::function<void()> callback);
+
+    /** request an iterative time advancement and have a function called once it can be completed
+    @details works the same as /ref requestTimeAsync with a callback; /ref
+    requestTimeIterativeComplete should be called to finish the operation
+    @param nextInternalTimeStep the next requested time step
+    @param iterate a requested iteration level (none, require, optional)
+    @param callback the function to call when the request can be completed*/
+    void requestTimeIterativeAsync(Time nextInternalTimeStep,
+                                   IterationRequest iterate,
+                                   std::function<void()> callback);
+
     /** request a time advancement
     @return the granted time step*/
     Time requestTimeComplete();
@@ -859,6 +882,14 @@ received
     void potentialInterfacesStartupSequence();
     /** function to deal with any operations that need to occur on a time update*/
     void updateSimulationTime(Time newTime, Time oldTime, bool iterating);
+    /** start an asynchronous time request
+    @details the core completes the request without a waiting thread if it can, otherwise a thread
+    is started to make a blocking request unless a callback is given
+    @param pendingMode the mode of the federate while the request is outstanding*/
+    void startTimeRequest(Time nextTime,
+                          IterationRequest iterate,
+                          Modes pendingMode,
+                          std::function<void()> callback);
     /** register connector(filters,translators) interfaces defined in  file or string
   @details call is only valid in startup mode
   @param jsonString  the location of the file or config String to load to generate the interfaces
@@ -236,7 +236,7 @@ static constexpr frozen::unordered_map<std::string_view, int, 97> flagStringsTra
     {"disableremotecontrol", HELICS_FLAG_DISABLE_REMOTE_CONTROL},
     {"disable_remote_control", HELICS_FLAG_DISABLE_REMOTE_CONTROL}};
 
-static constexpr frozen::unordered_map<std::string_view, int, 42> optionStringsTranslations{
+static constexpr frozen::unordered_map<std::string_view, int, 48> optionStringsTranslations{
     {"buffer_data", HELICS_HANDLE_OPTION_BUFFER_DATA},
     {"bufferdata", HELICS_HANDLE_OPTION_BUFFER_DATA},
     {"bufferData", HELICS_HANDLE_OPTION_BUFFER_DATA},
@@ -271,6 +271,12 @@ static constexpr frozen::unordered_map<std::string_view, int, 42> optionStringsT
     {"connections", HELICS_HANDLE_OPTION_CONNECTIONS},
     {"timerestricted", HELICS_HANDLE_OPTION_TIME_RESTRICTED},
     {"timeRestricted", HELICS_HANDLE_OPTION_TIME_RESTRICTED},
+    {"delta_encoding", HELICS_HANDLE_OPTION_DELTA_ENCODING},
+    {"deltaencoding", HELICS_HANDLE_OPTION_DELTA_ENCODING},
+    {"deltaEncoding", HELICS_HANDLE_OPTION_DELTA_ENCODING},
+    {"delta_tolerance", HELICS_HANDLE_OPTION_DELTA_TOLERANCE},
+    {"deltatolerance", HELICS_HANDLE_OPTION_DELTA_TOLERANCE},
+    {"deltaTolerance", HELICS_HANDLE_OPTION_DELTA_TOLERANCE},
     {"clear_priority_list", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
     {"clearPriorityList", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
     {"clearprioritylist", HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST},
@@ -7,7 +7,9 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "FilterOperations.hpp"
 
+#include "../core/ActionMessage.hpp"
 #include "../core/Core.hpp"
+#include "../core/MessagePool.hpp"
 #include "../core/core-exceptions.hpp"
 #include "MessageOperators.hpp"
 #include "gmlc/utilities/timeStringOps.hpp"
@@ -23,6 +25,78 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <vector>
 
 namespace helics {
+namespace {
+    /** conditional operator whose condition does not depend on the message contents so it can run
+    directly on an ActionMessage*/
+    class CommandConditionalOperator final: public MessageConditionalOperator {
+      public:
+        explicit CommandConditionalOperator(std::function<bool()> condition):
+            MessageConditionalOperator([this](const Message* /*unused*/) { return mCondition(); }),
+            mCondition(std::move(condition))
+        {
+        }
+        virtual bool supportsCommandProcessing() const override { return true; }
+
+      private:
+        std::function<bool()> mCondition;
+        virtual bool processCommand(ActionMessage& /*command*/) override { return mCondition(); }
+    };
+
+    /** firewall operator that checks the source and destination of a message*/
+    class CommandFirewallOperator final: public FirewallOperator {
+      public:
+        using AddressCheck = std::function<bool(std::string_view, std::string_view)>;
+        explicit CommandFirewallOperator(AddressCheck check):
+            FirewallOperator(
+                [this](const Message* mess) { return mCheck(mess->source, mess->dest); }),
+            mCheck(std::move(check))
+        {
+        }
+        virtual bool supportsCommandProcessing() const override { return true; }
+
+      private:
+        AddressCheck mCheck;
+        virtual bool processCommand(ActionMessage& command) override
+        {
+            return applyOperation(mCheck(command.getString(sourceStringLoc),
+                                         command.getString(targetStringLoc)),
+                                  command.flags);
+        }
+    };
+
+    /** clone operator that can also copy a message held in an ActionMessage*/
+    class CommandCloneOperator final: public CloneOperator {
+      public:
+        using MessageCloneFunction =
+            std::function<std::vector<std::unique_ptr<Message>>(const Message*)>;
+        using CommandCloneFunction =
+            std::function<void(const ActionMessage&, std::vector<ActionMessage>&)>;
+        CommandCloneOperator(MessageCloneFunction messageClone, CommandCloneFunction commandClone):
+            CloneOperator(std::move(messageClone)), mCommandClone(std::move(commandClone))
+        {
+        }
+        virtual bool supportsCommandProcessing() const override { return true; }
+
+      private:
+        CommandCloneFunction mCommandClone;
+        virtual bool processCommand(ActionMessage& command) override
+        {
+            // match CloneOperator::process which only replaces the message with a single copy
+            std::vector<ActionMessage> messages;
+            mCommandClone(command, messages);
+            if (messages.size() == 1) {
+                command = std::move(messages.front());
+            }
+            return true;
+        }
+        virtual bool processCommandVector(const ActionMessage& command,
+                                          std::vector<ActionMessage>& messages) override
+        {
+            mCommandClone(command, messages);
+            return true;
+        }
+    };
+}  // namespace
 
 void FilterOperations::set(std::string_view /*property*/, double /*val*/) {}
 void FilterOperations::setString(std::string_view /*property*/, std::string_view /*val*/) {}
@@ -287,7 +361,7 @@ std::shared_ptr<FilterOperator> RandomDelayFilterOperation::getOperator()
 }
 
 RandomDropFilterOperation::RandomDropFilterOperation():
-    tcond(std::make_shared<MessageConditionalOperator>([this](const Message* /*unused*/) {
+    tcond(std::make_shared<CommandConditionalOperator>([this]() {
         return (randDouble(RandomDistributions::BERNOULLI, (1.0 - dropProb), 1.0) > 0.1);
     }))
 {
@@ -340,13 +414,17 @@ void RerouteFilterOperation::set(std::string_view /*property*/, double /*val*/)
 void RerouteFilterOperation::setString(std::string_view property, std::string_view val)
 {
     if (property == "newdestination") {
+        auto segments = parseDestinationFormula(val);
         newDest = val;
+        *newDestSegments.lock() = std::move(segments);
     } else if (property == "condition") {
         try {
-            // this line is to verify that it is a valid regex
-            auto test = std::regex(val.data(), val.size());
+            // compile the expression once here so it can be reused for every message
+            std::regex reg(val.data(), val.size());
             auto cond = conditions.lock();
-            cond->emplace(val);
+            if (cond->find(val) == cond->end()) {
+                cond->emplace(val, std::move(reg));
+            }
         }
         catch (const std::regex_error& re) {
             std::cerr << "filter expression is not a valid Regular expression " << re.what()
@@ -373,12 +451,12 @@ std::string RerouteFilterOperation::getString(std::string_view property)
             return {};
         }
         if (cond->size() == 1) {
-            return *cond->begin();
+            return cond->begin()->first;
         }
         std::string results{"["};
         for (const auto& condition : cond) {
             results.push_back('"');
-            results.append(condition);
+            results.append(condition.first);
             results.push_back('"');
             results.push_back(',');
         }
@@ -394,16 +472,73 @@ std::shared_ptr<FilterOperator> RerouteFilterOperation::getOperator()
     return std::static_pointer_cast<FilterOperator>(op);
 }
 
-std::string newDestGeneration(const std::string& src, const std::string& dest, std::string formula)
+std::vector<RerouteFilterOperation::DestinationSegment>
+    RerouteFilterOperation::parseDestinationFormula(std::string_view formula)
 {
-    if (formula.find_first_of('$') == std::string::npos) {
-        return formula;
+    static constexpr std::string_view sourceKey{"${source}"};
+    static constexpr std::string_view destKey{"${dest}"};
+    using SegmentType = DestinationSegment::SegmentType;
+
+    std::vector<DestinationSegment> segments;
+    std::string literal;
+    std::size_t loc{0};
+    while (loc < formula.size()) {
+        auto next = formula.find('$', loc);
+        if (next == std::string_view::npos) {
+            literal.append(formula.substr(loc));
+            break;
+        }
+        literal.append(formula.substr(loc, next - loc));
+        const auto remaining = formula.substr(next);
+        SegmentType type{SegmentType::LITERAL};
+        std::size_t keyLength{1};
+        if (remaining.compare(0, sourceKey.size(), sourceKey) == 0) {
+            type = SegmentType::SOURCE;
+            keyLength = sourceKey.size();
+        } else if (remaining.compare(0, destKey.size(), destKey) == 0) {
+            type = SegmentType::DESTINATION;
+            keyLength = destKey.size();
+        }
+        if (type == SegmentType::LITERAL) {
+            literal.push_back('$');
+        } else {
+            if (!literal.empty()) {
+                segments.push_back({SegmentType::LITERAL, std::move(literal)});
+                literal.clear();
+            }
+            segments.push_back({type, std::string{}});
+        }
+        loc = next + keyLength;
+    }
+    if (!literal.empty() || segments.empty()) {
+        segments.push_back({SegmentType::LITERAL, std::move(literal)});
     }
-    const std::regex srcreg(R"(\$\{source\})");
-    formula = std::regex_replace(formula, srcreg, std::string{src});
-    const std::regex destreg(R"(\$\{dest\})");
-    formula = std::regex_replace(formula, destreg, std::string{dest});
-    return formula;
+    return segments;
+}
+
+std::string RerouteFilterOperation::newDestGeneration(const std::string& src,
+                                                      const std::string& dest) const
+{
+    using SegmentType = DestinationSegment::SegmentType;
+    auto segments = newDestSegments.lock_shared();
+    if (segments->size() == 1 && segments->front().type == SegmentType::LITERAL) {
+        return segments->front().text;
+    }
+    std::string result;
+    for (const auto& segment : *segments) {
+        switch (segment.type) {
+            case SegmentType::LITERAL:
+                result.append(segment.text);
+                break;
+            case SegmentType::SOURCE:
+                result.append(src);
+                break;
+            case SegmentType::DESTINATION:
+                result.append(dest);
+                break;
+        }
+    }
+    return result;
 }
 
 std::string RerouteFilterOperation::rerouteOperation(const std::string& src,
@@ -411,21 +546,22 @@ std::string RerouteFilterOperation::rerouteOperation(const std::string& src,
 {
     auto cond = conditions.lock_shared();
     if (cond->empty()) {
-        return newDestGeneration(src, dest, newDest.load());
+        return newDestGeneration(src, dest);
     }
 
     for (const auto& condition : *cond) {
-        const std::regex reg(condition);
-        if (std::regex_search(dest, reg, std::regex_constants::match_any)) {
-            return newDestGeneration(src, dest, newDest.load());
+        if (std::regex_search(dest, condition.second, std::regex_constants::match_any)) {
+            return newDestGeneration(src, dest);
         }
     }
     return dest;
 }
 
 FirewallFilterOperation::FirewallFilterOperation():
-    op(std::make_shared<FirewallOperator>(
-        [this](const Message* mess) { return allowPassed(mess); }))
+    op(std::make_shared<CommandFirewallOperator>(
+        [this](std::string_view source, std::string_view dest) {
+            return allowPassed(source, dest);
+        }))
 {
 }
 
@@ -451,14 +587,19 @@ std::shared_ptr<FilterOperator> FirewallFilterOperation::getOperator()
 }
 
 // NOLINTNEXTLINE
-bool FirewallFilterOperation::allowPassed(const Message* /*mess*/) const
+bool FirewallFilterOperation::allowPassed(std::string_view /*source*/,
+                                          std::string_view /*dest*/) const
 {
     /* TODO (PT) this has not been completed yet*/
     return true;
 }
 
 CloneFilterOperation::CloneFilterOperation():
-    op(std::make_shared<CloneOperator>([this](const Message* mess) { return sendMessage(mess); }))
+    op(std::make_shared<CommandCloneOperator>(
+        [this](const Message* mess) { return sendMessage(mess); },
+        [this](const ActionMessage& command, std::vector<ActionMessage>& messages) {
+            sendCommand(command, messages);
+        }))
 {
 }
 
@@ -537,10 +678,22 @@ std::vector<std::unique_ptr<Message>> CloneFilterOperation::sendMessage(const Me
     std::vector<std::unique_ptr<Message>> messages;
     auto lock = deliveryAddresses.lock_shared();
     for (const auto& add : *lock) {
-        messages.push_back(std::make_unique<Message>(*mess));
+        messages.push_back(acquireMessage());
+        *messages.back() = *mess;
         messages.back()->original_dest = messages.back()->dest;
         messages.back()->dest = add;
     }
     return messages;
 }
+
+void CloneFilterOperation::sendCommand(const ActionMessage& command,
+                                       std::vector<ActionMessage>& messages) const
+{
+    auto lock = deliveryAddresses.lock_shared();
+    for (const auto& add : *lock) {
+        messages.push_back(command);
+        messages.back().setString(origDestStringLoc, command.getString(targetStringLoc));
+        messages.back().setString(targetStringLoc, add);
+    }
+}
 }  // namespace helics
@@ -15,13 +15,18 @@ file defines some common filter operations
 #include "gmlc/libguarded/cow_guarded.hpp"
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <regex>
 #include <set>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace helics {
+class ActionMessage;
 class Core;
 class FilterOperator;
 class MessageTimeOperator;
@@ -120,11 +125,21 @@ class RandomDropFilterOperation: public FilterOperations {
 
 /** filter for rerouting a packet to a particular endpoint*/
 class RerouteFilterOperation: public FilterOperations {
+  public:
+    /** a piece of a new destination formula, either literal text or a placeholder*/
+    struct DestinationSegment {
+        enum class SegmentType : std::uint8_t { LITERAL, SOURCE, DESTINATION };
+        SegmentType type{SegmentType::LITERAL};
+        std::string text;  //!< the text of a literal segment
+    };
+
   private:
     std::shared_ptr<MessageDestOperator> op;  //!< the actual operator
     atomic_guarded<std::string> newDest;  //!< the target destination
-    shared_guarded<std::set<std::string>>
-        conditions;  //!< the conditions on which the rerouting will occur
+    /// the target destination split into literal and placeholder segments
+    shared_guarded<std::vector<DestinationSegment>> newDestSegments;
+    /// the conditions on which the rerouting will occur along with the compiled expressions
+    shared_guarded<std::map<std::string, std::regex, std::less<>>> conditions;
 
   public:
     RerouteFilterOperation();
@@ -135,9 +150,15 @@ class RerouteFilterOperation: public FilterOperations {
     virtual std::string getString(std::string_view property) override;
     virtual std::shared_ptr<FilterOperator> getOperator() override;
 
+    /** split a new destination formula into literal and placeholder segments
+    @details the recognized placeholders are ${source} and ${dest}*/
+    static std::vector<DestinationSegment> parseDestinationFormula(std::string_view formula);
+
   private:
     /** function to execute the rerouting operation*/
     std::string rerouteOperation(const std::string& src, const std::string& dest) const;
+    /** generate the new destination from the parsed formula*/
+    std::string newDestGeneration(const std::string& src, const std::string& dest) const;
 };
 
 /** filter for rerouting a packet to a particular endpoint*/
@@ -160,7 +181,7 @@ class FirewallFilterOperation: public FilterOperations {
 
   private:
     /** function to execute the rerouting operation*/
-    bool allowPassed(const Message* mess) const;
+    bool allowPassed(std::string_view source, std::string_view dest) const;
 };
 
 /** filter for rerouting a packet to a particular endpoint*/
@@ -184,6 +205,10 @@ class CloneFilterOperation: public FilterOperations {
     /** run the send message function which copies the message and forwards to all destinations
     @param mess a message to clone*/
     std::vector<std::unique_ptr<Message>> sendMessage(const Message* mess) const;
+    /** copy a message held in an ActionMessage for each of the delivery addresses
+    @param command the message to clone
+    @param[out] messages the copies are appended to the vector*/
+    void sendCommand(const ActionMessage& command, std::vector<ActionMessage>& messages) const;
 };
 
 }  // namespace helics
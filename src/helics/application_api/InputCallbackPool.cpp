@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "InputCallbackPool.hpp"
+
+#include <utility>
+
+namespace helics {
+
+InputCallbackPool::InputCallbackPool(int threads)
+{
+    for (int ii = 1; ii < threads; ++ii) {
+        mWorkers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+InputCallbackPool::~InputCallbackPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+    }
+    mStart.notify_all();
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void InputCallbackPool::run(std::size_t count, const Operation& operation)
+{
+    if (mWorkers.empty() || count < 2) {
+        for (std::size_t ii = 0; ii < count; ++ii) {
+            operation(ii);
+        }
+        return;
+    }
+    {
+        const std::lock_guard<std::mutex> lock(mLock);
+        mOperation = &operation;
+        mCount = count;
+        mNext.store(0);
+        mActive = mWorkers.size();
+        ++mGeneration;
+    }
+    mStart.notify_all();
+    process(operation, count);
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+        mDone.wait(lock, [this]() { return mActive == 0; });
+        mOperation = nullptr;
+        error = std::exchange(mError, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void InputCallbackPool::process(const Operation& operation, std::size_t count)
+{
+    for (auto index = mNext.fetch_add(1); index < count; index = mNext.fetch_add(1)) {
+        try {
+            operation(index);
+        }
+        catch (...) {
+            const std::lock_guard<std::mutex> lock(mLock);
+            if (!mError) {
+                mError = std::current_exception();
+            }
+        }
+    }
+}
+
+void InputCallbackPool::workerLoop()
+{
+    std::uint64_t generation{0};
+    while (true) {
+        const Operation* operation{nullptr};
+        std::size_t count{0};
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mStart.wait(lock,
+                        [this, generation]() { return mStopping || mGeneration != generation; });
+            if (mStopping) {
+                return;
+            }
+            generation = mGeneration;
+            operation = mOperation;
+            count = mCount;
+        }
+        process(*operation, count);
+        const std::lock_guard<std::mutex> lock(mLock);
+        if (--mActive == 0) {
+            mDone.notify_one();
+        }
+    }
+}
+
+}  // namespace helics
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helics {
+/** a fixed set of threads used to run the input notification callbacks of a value federate in
+parallel
+@details the thread calling run takes part in the processing and run does not return until all the
+operations have finished*/
+class InputCallbackPool {
+  public:
+    using Operation = std::function<void(std::size_t)>;
+    /** construct the pool
+    @param threads the total number of threads to use including the thread calling run*/
+    explicit InputCallbackPool(int threads);
+    ~InputCallbackPool();
+    InputCallbackPool(const InputCallbackPool&) = delete;
+    InputCallbackPool& operator=(const InputCallbackPool&) = delete;
+
+    /** run an operation for each index in [0,count) and wait for all of them to complete
+    @details if any of the operations throw, the first exception is rethrown once all the others
+    have finished*/
+    void run(std::size_t count, const Operation& operation);
+    /** get the total number of threads including the calling thread*/
+    int size() const { return static_cast<int>(mWorkers.size()) + 1; }
+
+  private:
+    void workerLoop();
+    /** claim and run indices until there are none left*/
+    void process(const Operation& operation, std::size_t count);
+
+    std::vector<std::thread> mWorkers;
+    std::mutex mLock;
+    std::condition_variable mStart;
+    std::condition_variable mDone;
+    const Operation* mOperation{nullptr};  //!< the operation for the current batch
+    std::size_t mCount{0};  //!< the number of indices in the current batch
+    std::atomic<std::size_t> mNext{0};  //!< the next index to claim
+    std::size_t mActive{0};  //!< the number of workers still processing the current batch
+    std::uint64_t mGeneration{0};  //!< incremented for each batch
+    bool mStopping{false};
+    std::exception_ptr mError;  //!< the first exception thrown in the current batch
+};
+
+}  // namespace helics
@@ -13,6 +13,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "units/units.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
 #include <limits>
 #include <memory>
 #include <string>
@@ -408,71 +411,449 @@ static bool changeDetected(const defV& prevValue, const defV& newVal, double del
     return std::visit(visitor, newVal);
 }
 
-bool Input::vectorDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV)
+UnitConversion::UnitConversion(const std::shared_ptr<units::precise_unit>& inputUnits,
+                               const std::shared_ptr<units::precise_unit>& outputUnits)
 {
-    if (injectionType == DataType::HELICS_UNKNOWN ||
-        static_cast<int32_t>(dataV.size()) != prevInputCount) {
-        loadSourceInformation();
-        prevInputCount = static_cast<int32_t>(dataV.size());
+    if (!inputUnits || !outputUnits) {
+        return;
     }
-    std::vector<defV> res;
-    res.reserve(dataV.size());
-    for (size_t ii = 0; ii < dataV.size(); ++ii) {
-        if (dataV[ii]) {
-            auto localTargetType = (injectionType == helics::DataType::HELICS_MULTI) ?
-                sourceTypes[ii].first :
-                injectionType;
+    offset = units::convert(0.0, *inputUnits, *outputUnits);
+    scale = units::convert(1.0, *inputUnits, *outputUnits) - offset;
+    for (const double check : {-1000.0, 1000.0}) {
+        const double expected = units::convert(check, *inputUnits, *outputUnits);
+        // written so a NaN from an invalid conversion also uses the full conversion
+        if (!(std::abs(check * scale + offset - expected) <=
+              1e-12 * std::max(1.0, std::abs(expected)))) {
+            linear = false;
+        }
+    }
+    if (!linear) {
+        this->inputUnits = inputUnits;
+        this->outputUnits = outputUnits;
+    }
+    active = !linear || scale != 1.0 || offset != 0.0;
+}
+
+double UnitConversion::convert(double value) const
+{
+    if (!active) {
+        return value;
+    }
+    return (linear) ? value * scale + offset : units::convert(value, *inputUnits, *outputUnits);
+}
+
+std::complex<double> UnitConversion::convert(std::complex<double> value) const
+{
+    if (!active) {
+        return value;
+    }
+    if (linear) {
+        return {value.real() * scale + offset, value.imag() * scale};
+    }
+    const double magnitude = std::abs(value);
+    const double converted = units::convert(magnitude, *inputUnits, *outputUnits);
+    return (magnitude != 0.0) ? value * (converted / magnitude) : std::complex<double>(converted);
+}
 
-            const auto& localUnits = (multiUnits) ? sourceTypes[ii].second : inputUnits;
-            if (localTargetType == helics::DataType::HELICS_DOUBLE) {
-                res.emplace_back(doubleExtractAndConvert(*dataV[ii], localUnits, outputUnits));
-            } else if (localTargetType == helics::DataType::HELICS_INT) {
-                res.emplace_back();
-                integerExtractAndConvert(res.back(), *dataV[ii], localUnits, outputUnits);
+void UnitConversion::convert(double* values, std::size_t count) const
+{
+    if (!active) {
+        return;
+    }
+    if (linear) {
+        // a single pass the compiler can vectorize
+        const double localScale = scale;
+        const double localOffset = offset;
+        for (std::size_t ii = 0; ii < count; ++ii) {
+            values[ii] = values[ii] * localScale + localOffset;
+        }
+    } else {
+        for (std::size_t ii = 0; ii < count; ++ii) {
+            values[ii] = units::convert(values[ii], *inputUnits, *outputUnits);
+        }
+    }
+}
+
+#if defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wstrict-aliasing"
+// std::complex is explicitly allowed to alias like this in the standard
+#endif
+void UnitConversion::convert(std::complex<double>* values, std::size_t count) const
+{
+    if (!active) {
+        return;
+    }
+    if (linear) {
+        auto* parts = reinterpret_cast<double*>(values);
+        const double localScale = scale;
+        const double localOffset = offset;
+        for (std::size_t ii = 0; ii < 2 * count; ii += 2) {
+            parts[ii] = parts[ii] * localScale + localOffset;
+            parts[ii + 1] *= localScale;
+        }
+    } else {
+        for (std::size_t ii = 0; ii < count; ++ii) {
+            values[ii] = convert(values[ii]);
+        }
+    }
+}
+#if defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#endif
+
+/** extract a value of a specific type and convert it to the output units
+@return false if the value does not need a conversion and can be extracted directly*/
+static bool convertedExtract(const data_view& dv,
+                             DataType type,
+                             const UnitConversion& conversion,
+                             defV& val)
+{
+    switch (type) {
+        case DataType::HELICS_DOUBLE:
+            val = conversion.convert(ValueConverter<double>::interpret(dv));
+            return true;
+        case DataType::HELICS_INT: {
+            auto intValue = ValueConverter<int64_t>::interpret(dv);
+            if (conversion.isActive()) {
+                val = conversion.convert(static_cast<double>(intValue));
             } else {
-                res.emplace_back();
-                valueExtract(*dataV[ii], localTargetType, res.back());
+                val = intValue;
+            }
+            return true;
+        }
+        case DataType::HELICS_COMPLEX:
+            if (!conversion.isActive()) {
+                return false;
+            }
+            val = conversion.convert(ValueConverter<std::complex<double>>::interpret(dv));
+            return true;
+        case DataType::HELICS_VECTOR: {
+            if (!conversion.isActive()) {
+                return false;
             }
+            std::vector<double> values;
+            ValueConverter<std::vector<double>>::interpret(dv, values);
+            conversion.convert(values.data(), values.size());
+            val = std::move(values);
+            return true;
         }
+        case DataType::HELICS_COMPLEX_VECTOR: {
+            if (!conversion.isActive()) {
+                return false;
+            }
+            std::vector<std::complex<double>> values;
+            ValueConverter<std::vector<std::complex<double>>>::interpret(dv, values);
+            conversion.convert(values.data(), values.size());
+            val = std::move(values);
+            return true;
+        }
+        default:
+            return false;
     }
-    DataType type = DataType::HELICS_MULTI;
-    switch (inputVectorOp) {
+}
+
+bool Input::extractAndConvert(const data_view& dv, defV& val) const
+{
+    return convertedExtract(dv, injectionType, inputConversion, val);
+}
+
+/** get the type all source values are converted to before an aggregation operation*/
+static DataType aggregationType(MultiInputHandlingMethod operation, DataType targetType)
+{
+    switch (operation) {
         case MultiInputHandlingMethod::AND_OPERATION:
         case MultiInputHandlingMethod::OR_OPERATION:
-            type = DataType::HELICS_BOOL;
-            break;
+            return DataType::HELICS_BOOL;
         case MultiInputHandlingMethod::AVERAGE_OPERATION:
-            type = DataType::HELICS_VECTOR;
-            break;
+            return DataType::HELICS_VECTOR;
         case MultiInputHandlingMethod::SUM_OPERATION:
             switch (targetType) {
                 case DataType::HELICS_STRING:
                 case DataType::HELICS_CHAR:
-                    type = DataType::HELICS_STRING;
-                    break;
+                    return DataType::HELICS_STRING;
                 default:
-                    type = DataType::HELICS_VECTOR;
-                    break;
+                    return DataType::HELICS_VECTOR;
             }
-            break;
         case MultiInputHandlingMethod::VECTORIZE_OPERATION:
             switch (targetType) {
                 case DataType::HELICS_STRING:
                 case DataType::HELICS_CHAR:
-                    type = DataType::HELICS_STRING;
-                    break;
+                    return DataType::HELICS_STRING;
                 case DataType::HELICS_COMPLEX:
                 case DataType::HELICS_COMPLEX_VECTOR:
-                    type = DataType::HELICS_COMPLEX_VECTOR;
-                    break;
+                    return DataType::HELICS_COMPLEX_VECTOR;
                 default:
-                    type = DataType::HELICS_VECTOR;
-                    break;
+                    return DataType::HELICS_VECTOR;
             }
-            break;
         default:
-            type = (targetType == DataType::HELICS_UNKNOWN) ? DataType::HELICS_DOUBLE : targetType;
+            return (targetType == DataType::HELICS_UNKNOWN) ? DataType::HELICS_DOUBLE : targetType;
+    }
+}
+
+/** check if a typed kernel produces the same result as converting each value to the common type*/
+static bool typedKernelAvailable(MultiInputHandlingMethod operation,
+                                 DataType sourceType,
+                                 DataType type)
+{
+    switch (operation) {
+        case MultiInputHandlingMethod::SUM_OPERATION:
+        case MultiInputHandlingMethod::AVERAGE_OPERATION:
+            return type == DataType::HELICS_VECTOR;
+        case MultiInputHandlingMethod::MAX_OPERATION:
+        case MultiInputHandlingMethod::MIN_OPERATION:
+            return type == sourceType;
+        case MultiInputHandlingMethod::DIFF_OPERATION:
+            return (type == sourceType) ||
+                (type == DataType::HELICS_VECTOR && sourceType == DataType::HELICS_DOUBLE);
+        case MultiInputHandlingMethod::VECTORIZE_OPERATION:
+            return (sourceType == DataType::HELICS_COMPLEX) ?
+                (type == DataType::HELICS_COMPLEX_VECTOR) :
+                (type == DataType::HELICS_VECTOR);
+        default:
+            return false;
+    }
+}
+
+// the kernels use independent accumulators so the loops can be vectorized
+static constexpr std::size_t kernelLanes{4};
+
+static double kernelSum(const double* values, std::size_t count)
+{
+    std::array<double, kernelLanes> lanes{};
+    std::size_t ii{0};
+    for (; ii + kernelLanes <= count; ii += kernelLanes) {
+        for (std::size_t lane = 0; lane < kernelLanes; ++lane) {
+            lanes[lane] += values[ii + lane];
+        }
+    }
+    double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; ii < count; ++ii) {
+        result += values[ii];
+    }
+    return result;
+}
+
+/** find the extreme value with the same semantics as varMax/varMin, a NaN is only returned if it
+is the first value
+@param count the number of values, must be greater than 0*/
+template<class Compare>
+static double kernelExtreme(const double* values, std::size_t count, Compare replace)
+{
+    std::array<double, kernelLanes> lanes;
+    lanes.fill(values[0]);
+    std::size_t ii{0};
+    for (; ii + kernelLanes <= count; ii += kernelLanes) {
+        for (std::size_t lane = 0; lane < kernelLanes; ++lane) {
+            lanes[lane] = replace(values[ii + lane], lanes[lane]) ? values[ii + lane] : lanes[lane];
+        }
+    }
+    double result = values[0];
+    for (const auto lane : lanes) {
+        if (replace(lane, result)) {
+            result = lane;
+        }
+    }
+    for (; ii < count; ++ii) {
+        if (replace(values[ii], result)) {
+            result = values[ii];
+        }
+    }
+    return result;
+}
+
+bool Input::typedDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV,
+                             DataType type,
+                             defV& result)
+{
+    const bool selectSource = (inputVectorOp == MultiInputHandlingMethod::MAX_OPERATION ||
+                               inputVectorOp == MultiInputHandlingMethod::MIN_OPERATION) &&
+        type != DataType::HELICS_DOUBLE;
+    const bool selectMax = (inputVectorOp == MultiInputHandlingMethod::MAX_OPERATION);
+    const bool dropZeroImag = (inputVectorOp == MultiInputHandlingMethod::SUM_OPERATION ||
+                               inputVectorOp == MultiInputHandlingMethod::AVERAGE_OPERATION);
+    DataType sourceType{DataType::HELICS_UNKNOWN};
+    std::byte typeCode{0};
+    // the location of the source selected by a max or min of vectors or complex values
+    double selectedNorm =
+        selectMax ? -std::numeric_limits<double>::max() : std::numeric_limits<double>::max();
+    std::size_t selectedStart{0};
+    std::size_t selectedCount{0};
+    std::size_t sourceCount{0};
+
+    aggregateBuffer.clear();
+    aggregateBuffer.reserve(dataV.size());
+    for (size_t ii = 0; ii < dataV.size(); ++ii) {
+        if (!dataV[ii]) {
+            continue;
+        }
+        const auto localTargetType = (injectionType == helics::DataType::HELICS_MULTI) ?
+            sourceTypes[ii].first :
+            injectionType;
+        if (sourceCount == 0) {
+            sourceType = localTargetType;
+            if ((sourceType != DataType::HELICS_DOUBLE && sourceType != DataType::HELICS_VECTOR &&
+                 sourceType != DataType::HELICS_COMPLEX) ||
+                !typedKernelAvailable(inputVectorOp, sourceType, type)) {
+                return false;
+            }
+        } else if (localTargetType != sourceType) {
+            return false;
+        }
+        const auto& data = *dataV[ii];
+        if (data.size() < 8) {
+            return false;
+        }
+        // every source has the same type so the type lookup is only needed for the first one
+        if (sourceCount == 0) {
+            if (detail::detectType(data.data()) != sourceType) {
+                return false;
+            }
+            typeCode = data[0];
+        } else if (data[0] != typeCode) {
+            return false;
+        }
+        const std::size_t elements = (sourceType == DataType::HELICS_DOUBLE) ?
+            1 :
+            ((sourceType == DataType::HELICS_COMPLEX) ? 2 : detail::getDataSize(data.data()));
+        if (data.size() < 8 + elements * sizeof(double)) {
+            return false;
+        }
+        const auto& conversion = (multiUnits) ? sourceConversions[ii] : inputConversion;
+        const std::size_t start = aggregateBuffer.size();
+        aggregateBuffer.resize(start + elements);
+        double* values = aggregateBuffer.data() + start;
+        if (sourceType == DataType::HELICS_DOUBLE) {
+            detail::convertFromBinary(data.data(), values[0]);
+            values[0] = conversion.convert(values[0]);
+        } else if (sourceType == DataType::HELICS_COMPLEX) {
+            std::complex<double> cval;
+            detail::convertFromBinary(data.data(), cval);
+            cval = conversion.convert(cval);
+            values[0] = cval.real();
+            values[1] = cval.imag();
+        } else {
+            detail::convertFromBinary(data.data(), values);
+            conversion.convert(values, elements);
+        }
+        if (sourceCount == 0) {
+            selectedCount = elements;
+        }
+        ++sourceCount;
+
+        switch (sourceType) {
+            case DataType::HELICS_DOUBLE:
+                break;
+            case DataType::HELICS_COMPLEX:
+                if (selectSource) {
+                    const double norm = std::abs(std::complex<double>(values[0], values[1]));
+                    if (selectMax ? (norm > selectedNorm) : (norm < selectedNorm)) {
+                        selectedNorm = norm;
+                        selectedStart = start;
+                    }
+                } else if (dropZeroImag && values[1] == 0.0) {
+                    // the vector form of a complex value only includes a nonzero imaginary part
+                    aggregateBuffer.pop_back();
+                }
+                break;
+            default:
+                if (selectSource) {
+                    const double norm = vectorNorm(values, elements);
+                    if (selectMax ? (norm > selectedNorm) : (norm < selectedNorm)) {
+                        selectedNorm = norm;
+                        selectedStart = start;
+                        selectedCount = elements;
+                    }
+                }
+                break;
+        }
+    }
+    if (sourceCount == 0) {
+        return false;
+    }
+
+    const double* values = aggregateBuffer.data();
+    const std::size_t count = aggregateBuffer.size();
+    switch (inputVectorOp) {
+        case MultiInputHandlingMethod::SUM_OPERATION:
+            result = kernelSum(values, count);
             break;
+        case MultiInputHandlingMethod::AVERAGE_OPERATION:
+            result = kernelSum(values, count) / static_cast<double>(count);
+            break;
+        case MultiInputHandlingMethod::MAX_OPERATION:
+        case MultiInputHandlingMethod::MIN_OPERATION:
+            if (sourceType == DataType::HELICS_DOUBLE) {
+                result = selectMax ?
+                    kernelExtreme(values, count, [](double a, double b) { return a > b; }) :
+                    kernelExtreme(values, count, [](double a, double b) { return a < b; });
+            } else if (sourceType == DataType::HELICS_COMPLEX) {
+                result = std::complex<double>(values[selectedStart], values[selectedStart + 1]);
+            } else {
+                result = std::vector<double>(values + selectedStart,
+                                             values + selectedStart + selectedCount);
+            }
+            break;
+        case MultiInputHandlingMethod::DIFF_OPERATION:
+            if (type == DataType::HELICS_VECTOR) {
+                std::vector<double> diff;
+                diff.reserve(count);
+                double previous{invalidDouble};
+                for (std::size_t ii = 0; ii < count; ++ii) {
+                    if (previous != invalidDouble) {
+                        diff.push_back(previous - values[ii]);
+                    }
+                    previous = values[ii];
+                }
+                result = std::move(diff);
+            } else if (sourceType == DataType::HELICS_COMPLEX) {
+                std::complex<double> diff(values[0], values[1]);
+                for (std::size_t ii = 2; ii + 1 < count; ii += 2) {
+                    diff = diff - std::complex<double>(values[ii], values[ii + 1]);
+                }
+                result = diff;
+            } else {
+                double diff = values[0];
+                for (std::size_t ii = 1; ii < count; ++ii) {
+                    diff = diff - values[ii];
+                }
+                result = diff;
+            }
+            break;
+        case MultiInputHandlingMethod::VECTORIZE_OPERATION:
+            if (sourceType == DataType::HELICS_COMPLEX) {
+                std::vector<std::complex<double>> cvals(count / 2);
+                for (std::size_t ii = 0; ii < cvals.size(); ++ii) {
+                    cvals[ii] = std::complex<double>(values[2 * ii], values[2 * ii + 1]);
+                }
+                result = std::move(cvals);
+            } else {
+                result = aggregateBuffer;
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+defV Input::genericDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV,
+                               DataType type)
+{
+    std::vector<defV> res;
+    res.reserve(dataV.size());
+    for (size_t ii = 0; ii < dataV.size(); ++ii) {
+        if (dataV[ii]) {
+            auto localTargetType = (injectionType == helics::DataType::HELICS_MULTI) ?
+                sourceTypes[ii].first :
+                injectionType;
+
+            const auto& conversion = (multiUnits) ? sourceConversions[ii] : inputConversion;
+            res.emplace_back();
+            if (!convertedExtract(*dataV[ii], localTargetType, conversion, res.back())) {
+                valueExtract(*dataV[ii], localTargetType, res.back());
+            }
+        }
     }
     // convert everything to a uniform type
     for (auto& ival : res) {
@@ -527,6 +908,21 @@ bool Input::vectorDataProcess(const std::vector<std::shared_ptr<const SmallBuffe
         default:
             break;
     }
+    return result;
+}
+
+bool Input::vectorDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV)
+{
+    if (injectionType == DataType::HELICS_UNKNOWN ||
+        static_cast<int32_t>(dataV.size()) != prevInputCount) {
+        loadSourceInformation();
+        prevInputCount = static_cast<int32_t>(dataV.size());
+    }
+    const DataType type = aggregationType(inputVectorOp, targetType);
+    defV result;
+    if (!typedDataProcess(dataV, type, result)) {
+        result = genericDataProcess(dataV, type);
+    }
     if (changeDetectionEnabled) {
         if (changeDetected(lastValue, result, delta)) {
             lastValue = result;
@@ -552,12 +948,8 @@ bool Input::checkUpdate(bool assumeUpdate)
             auto visitor = [&, this](auto&& arg) {
                 std::remove_reference_t<decltype(arg)> newVal;
                 (void)arg;  // suppress VS2015 warning
-                if (injectionType == helics::DataType::HELICS_DOUBLE) {
-                    defV val = doubleExtractAndConvert(dv, inputUnits, outputUnits);
-                    valueExtract(val, newVal);
-                } else if (injectionType == helics::DataType::HELICS_INT) {
-                    defV val;
-                    integerExtractAndConvert(val, dv, inputUnits, outputUnits);
+                defV val;
+                if (extractAndConvert(dv, val)) {
                     valueExtract(val, newVal);
                 } else {
                     valueExtract(dv, injectionType, newVal);
@@ -772,6 +1164,13 @@ void Input::loadSourceInformation()
             }
         }
     }
+    inputConversion = UnitConversion(inputUnits, outputUnits);
+    sourceConversions.clear();
+    if (multiUnits) {
+        for (const auto& src : sourceTypes) {
+            sourceConversions.emplace_back(src.second, outputUnits);
+        }
+    }
 }
 
 double doubleExtractAndConvert(const data_view& dv,
@@ -812,7 +1211,9 @@ void Input::forceCoreDataUpdate()
     }
     auto dv = fed->getBytes(*this);
     if (!dv.empty()) {
-        valueExtract(dv, injectionType, lastValue);
+        if (!extractAndConvert(dv, lastValue)) {
+            valueExtract(dv, injectionType, lastValue);
+        }
     } else if (getMultiInputMode() != MultiInputHandlingMethod::NO_OP) {
         fed->forceCoreUpdate(*this);
     }
@@ -860,7 +1261,8 @@ char Input::getValueChar()
         } else {
             int64_t out = invalidValue<int64_t>();
             if (injectionType == helics::DataType::HELICS_DOUBLE) {
-                out = static_cast<int64_t>(doubleExtractAndConvert(dv, inputUnits, outputUnits));
+                out = static_cast<int64_t>(
+                    inputConversion.convert(ValueConverter<double>::interpret(dv)));
             } else {
                 valueExtract(dv, injectionType, out);
             }
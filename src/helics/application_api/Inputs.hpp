@@ -22,6 +22,40 @@ class precise_unit;
 namespace helics {
 
 class ValueFederate;
+
+/** a conversion from the units of a data source to the units of an input
+@details the conversion is determined once when the source information is loaded, a linear
+conversion is applied as a scale and offset and the full unit conversion is only used for units
+which are not linear such as logarithmic units.  For complex values the scale applies to both parts
+and the offset to the real part, a non linear conversion applies to the magnitude.
+*/
+class HELICS_CXX_EXPORT UnitConversion {
+  public:
+    UnitConversion() = default;
+    /** construct the conversion between two units, it does nothing if either is missing*/
+    UnitConversion(const std::shared_ptr<units::precise_unit>& inputUnits,
+                   const std::shared_ptr<units::precise_unit>& outputUnits);
+    /** check if the conversion changes values*/
+    bool isActive() const { return active; }
+    /** check if the conversion is a scale and offset*/
+    bool isLinear() const { return linear; }
+    double convert(double value) const;
+    std::complex<double> convert(std::complex<double> value) const;
+    /** convert an array of values in place*/
+    void convert(double* values, std::size_t count) const;
+    /** convert an array of complex values in place*/
+    void convert(std::complex<double>* values, std::size_t count) const;
+
+  private:
+    double scale{1.0};
+    double offset{0.0};
+    bool active{false};
+    bool linear{true};
+    /// the units are only kept for a conversion that is not linear
+    std::shared_ptr<units::precise_unit> inputUnits;
+    std::shared_ptr<units::precise_unit> outputUnits;
+};
+
 enum MultiInputHandlingMethod : uint16_t {
     NO_OP = HELICS_MULTI_INPUT_NO_OP,
     VECTORIZE_OPERATION = HELICS_MULTI_INPUT_VECTORIZE_OPERATION,
@@ -59,6 +93,9 @@ class HELICS_CXX_EXPORT Input: public Interface {
     std::shared_ptr<units::precise_unit> inputUnits;  //!< the units of the linked publications
     std::vector<std::pair<DataType, std::shared_ptr<units::precise_unit>>>
         sourceTypes;  //!< source information for input sources
+    UnitConversion inputConversion;  //!< the conversion from the inputUnits to the outputUnits
+    std::vector<UnitConversion> sourceConversions;  //!< the conversion for each source if multiUnits
+    std::vector<double> aggregateBuffer;  //!< decoded source values for the typed aggregation
     std::string givenTarget;  //!< the first target set for the input
     double delta{-1.0};  //!< the minimum difference
     double threshold{0.0};  //!< the threshold to use for binary decisions
@@ -408,6 +445,18 @@ class HELICS_CXX_EXPORT Input: public Interface {
   private:
     /** load some information about the data source such as type and units*/
     void loadSourceInformation();
+    /** extract a value from a single source converting it to the output units
+    @return false if the value does not need a conversion and can be extracted directly*/
+    bool extractAndConvert(const data_view& dv, defV& val) const;
+    /** aggregate the sources directly from the serialized data if they are all doubles, vectors,
+    or complex values of the declared type
+    @return false if the sources need the generic conversion*/
+    bool typedDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV,
+                          DataType type,
+                          defV& result);
+    /** aggregate the sources by converting each value to the common type*/
+    defV genericDataProcess(const std::vector<std::shared_ptr<const SmallBuffer>>& dataV,
+                            DataType type);
     /** helper class for getting a character since that is a bit odd*/
     char getValueChar();
     /** check if updates from the federate are allowed*/
@@ -442,12 +491,8 @@ void Input::getValue_impl(std::integral_constant<int, primaryType> /*V*/, X& out
             loadSourceInformation();
         }
 
-        if (injectionType == helics::DataType::HELICS_DOUBLE) {
-            defV val = doubleExtractAndConvert(dv, inputUnits, outputUnits);
-            valueExtract(val, out);
-        } else if (injectionType == helics::DataType::HELICS_INT) {
-            defV val;
-            integerExtractAndConvert(val, dv, inputUnits, outputUnits);
+        defV val;
+        if (extractAndConvert(dv, val)) {
             valueExtract(val, out);
         } else {
             valueExtract(dv, injectionType, out);
@@ -502,12 +547,8 @@ const X& Input::getValueRef()
 
         if (changeDetectionEnabled) {
             X out;
-            if (injectionType == helics::DataType::HELICS_DOUBLE) {
-                defV val = doubleExtractAndConvert(dv, inputUnits, outputUnits);
-                valueExtract(val, out);
-            } else if (injectionType == helics::DataType::HELICS_INT) {
-                defV val;
-                integerExtractAndConvert(val, dv, inputUnits, outputUnits);
+            defV val;
+            if (extractAndConvert(dv, val)) {
                 valueExtract(val, out);
             } else {
                 valueExtract(dv, injectionType, out);
@@ -515,7 +556,7 @@ const X& Input::getValueRef()
             if (changeDetected(lastValue, out, delta)) {
                 lastValue = make_valid(std::move(out));
             }
-        } else {
+        } else if (!extractAndConvert(dv, lastValue)) {
             valueExtract(dv, injectionType, lastValue);
         }
     } else {
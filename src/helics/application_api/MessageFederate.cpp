@@ -385,6 +385,23 @@ std::unique_ptr<Message> MessageFederate::getMessage(const Endpoint& ept)
     return nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> MessageFederate::receiveAll(const Endpoint& ept)
+{
+    if (currentMode >= Modes::INITIALIZING) {
+        return mfManager->receiveAll(ept);
+    }
+    return {};
+}
+
+std::vector<std::unique_ptr<Message>> MessageFederate::receiveAll(const Endpoint& ept,
+                                                                  std::size_t maxCount)
+{
+    if (currentMode >= Modes::INITIALIZING) {
+        return mfManager->receiveAll(ept, maxCount);
+    }
+    return {};
+}
+
 Endpoint& MessageFederate::getEndpoint(std::string_view eptName) const
 {
     auto& ept = mfManager->getEndpoint(eptName);
@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace helics {
 class MessageFederateManager;
@@ -199,6 +200,15 @@ class HELICS_CXX_EXPORT MessageFederate:
     @param ept the identifier for the endpoint
     @return a message object*/
     std::unique_ptr<Message> getMessage(const Endpoint& ept);
+    /** receive all the pending messages for a particular endpoint in a single call
+    @param ept the identifier for the endpoint
+    @return a vector of the messages in time order, empty if there are no messages*/
+    std::vector<std::unique_ptr<Message>> receiveAll(const Endpoint& ept);
+    /** receive up to a maximum number of the pending messages for an endpoint in a single call
+    @param ept the identifier for the endpoint
+    @param maxCount the maximum number of messages to retrieve
+    @return a vector of the messages in time order, empty if there are no messages*/
+    std::vector<std::unique_ptr<Message>> receiveAll(const Endpoint& ept, std::size_t maxCount);
     /** receive a communication message for any endpoint in the federate
     @details the return order will be in order of endpoint creation then order of arrival
     all messages for the first endpoint, then all for the second, and so on
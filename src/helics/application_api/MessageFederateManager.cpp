@@ -11,7 +11,9 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/queryHelpers.hpp"
 #include "helics/core/core-exceptions.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -166,6 +168,30 @@ std::unique_ptr<Message> MessageFederateManager::getMessage(const Endpoint& ept)
     return nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> MessageFederateManager::receiveAll(const Endpoint& ept)
+{
+    return receiveAll(ept, std::numeric_limits<std::size_t>::max());
+}
+
+std::vector<std::unique_ptr<Message>> MessageFederateManager::receiveAll(const Endpoint& ept,
+                                                                         std::size_t maxCount)
+{
+    std::vector<std::unique_ptr<Message>> messages;
+    if (ept.dataReference != nullptr && maxCount > 0) {
+        auto* eptDat = static_cast<EndpointData*>(ept.dataReference);
+        messages.reserve(std::min(maxCount, eptDat->messages.size()));
+        auto message = eptDat->messages.pop();
+        while (message) {
+            messages.push_back(std::move(*message));
+            if (messages.size() >= maxCount) {
+                break;
+            }
+            message = eptDat->messages.pop();
+        }
+    }
+    return messages;
+}
+
 std::unique_ptr<Message> MessageFederateManager::getMessage()
 {
     // just start with the first endpoint and check until a queue isn't empty
@@ -191,6 +217,19 @@ void MessageFederateManager::updateTime(Time newTime, Time /*oldTime*/)
     InterfaceHandle endpoint_id;
     auto epts = mLocalEndpoints.lock();
     auto mcall = allCallback.load();
+    if (!mcall) {
+        // without callbacks the order across endpoints does not matter so transfer in bulk
+        for (auto& ept : *epts) {
+            auto* eData = static_cast<EndpointData*>(ept.dataReference);
+            if (eData == nullptr || eData->callback) {
+                continue;
+            }
+            for (auto& message : coreObject->receiveAll(ept.getHandle(), newTime)) {
+                eData->messages.emplace(std::move(message));
+            }
+        }
+        epCount = coreObject->receiveCountAny(fedID);
+    }
     for (size_t ii = 0; ii < epCount; ++ii) {
         auto message = coreObject->receiveAny(fedID, endpoint_id);
         if (!message) {
@@ -74,6 +74,16 @@ class MessageFederateManager {
     @param ept the identifier for the endpoint
     @return a message object*/
     static std::unique_ptr<Message> getMessage(const Endpoint& ept);
+    /** receive all the pending messages for a particular endpoint in a single call
+    @param ept the identifier for the endpoint
+    @return a vector of messages in time order*/
+    static std::vector<std::unique_ptr<Message>> receiveAll(const Endpoint& ept);
+    /** receive up to a maximum number of the pending messages for an endpoint in a single call
+    @param ept the identifier for the endpoint
+    @param maxCount the maximum number of messages to retrieve
+    @return a vector of messages in time order*/
+    static std::vector<std::unique_ptr<Message>> receiveAll(const Endpoint& ept,
+                                                            std::size_t maxCount);
     /* receive a communication message for any endpoint in the federate*/
     std::unique_ptr<Message> getMessage();
 
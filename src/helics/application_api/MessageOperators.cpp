@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "MessageOperators.hpp"
 
+#include "../core/ActionMessage.hpp"
 #include "../core/flagOperations.hpp"
 
 #include <memory>
@@ -27,6 +28,14 @@ std::unique_ptr<Message> MessageTimeOperator::process(std::unique_ptr<Message> m
     return message;
 }
 
+bool MessageTimeOperator::processCommand(ActionMessage& command)
+{
+    if (TimeFunction) {
+        command.actionTime = TimeFunction(command.actionTime);
+    }
+    return true;
+}
+
 void MessageTimeOperator::setTimeFunction(std::function<Time(Time)> userTimeFunction)
 {
     TimeFunction = std::move(userTimeFunction);
@@ -73,6 +82,21 @@ std::unique_ptr<Message> MessageDestOperator::process(std::unique_ptr<Message> m
     return message;
 }
 
+bool MessageDestOperator::processCommand(ActionMessage& command)
+{
+    if (DestUpdateFunction) {
+        auto newDest = DestUpdateFunction(command.getString(sourceStringLoc),
+                                          command.getString(targetStringLoc));
+        if (command.getString(origDestStringLoc).empty()) {
+            // copy first since setString can reallocate the string storage
+            const std::string dest = command.getString(targetStringLoc);
+            command.setString(origDestStringLoc, dest);
+        }
+        command.setString(targetStringLoc, newDest);
+    }
+    return true;
+}
+
 MessageConditionalOperator::MessageConditionalOperator(
     std::function<bool(const Message*)> userConditionalFunction):
     evalFunction(std::move(userConditionalFunction))
@@ -140,40 +164,41 @@ void FirewallOperator::setCheckFunction(std::function<bool(const Message*)> user
 std::unique_ptr<Message> FirewallOperator::process(std::unique_ptr<Message> message)
 {
     if (checkFunction) {
-        bool res = checkFunction(message.get());
-        switch (operation) {
-            case operations::drop:
-                if (res) {
-                    message = nullptr;
-                }
-                break;
-            case operations::pass:
-                if (!res) {
-                    message = nullptr;
-                }
-                break;
-            case operations::set_flag1:
-                if (res) {
-                    setActionFlag(*message, user_custom_message_flag1);
-                }
-                break;
-            case operations::set_flag2:
-                if (res) {
-                    setActionFlag(*message, user_custom_message_flag2);
-                }
-                break;
-            case operations::set_flag3:
-                if (res) {
-                    setActionFlag(*message, user_custom_message_flag3);
-                }
-                break;
-            case operations::none:
-                break;
+        if (!applyOperation(checkFunction(message.get()), message->flags)) {
+            message = nullptr;
         }
     }
     return message;
 }
 
+bool FirewallOperator::applyOperation(bool checkResult, std::uint16_t& messageFlags) const
+{
+    switch (operation) {
+        case operations::drop:
+            return !checkResult;
+        case operations::pass:
+            return checkResult;
+        case operations::set_flag1:
+            if (checkResult) {
+                messageFlags |= make_flags(user_custom_message_flag1);
+            }
+            break;
+        case operations::set_flag2:
+            if (checkResult) {
+                messageFlags |= make_flags(user_custom_message_flag2);
+            }
+            break;
+        case operations::set_flag3:
+            if (checkResult) {
+                messageFlags |= make_flags(user_custom_message_flag3);
+            }
+            break;
+        case operations::none:
+            break;
+    }
+    return true;
+}
+
 CustomMessageOperator::CustomMessageOperator(
     std::function<std::unique_ptr<Message>(std::unique_ptr<Message>)> userMessageFunction):
     messageFunction(std::move(userMessageFunction))
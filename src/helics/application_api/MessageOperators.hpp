@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics_cxx_export.h"
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -29,10 +30,12 @@ class HELICS_CXX_EXPORT MessageTimeOperator: public FilterOperator {
     explicit MessageTimeOperator(std::function<Time(Time)> userTimeFunction);
     /** set the function to modify the time of the message*/
     void setTimeFunction(std::function<Time(Time)> userTimeFunction);
+    virtual bool supportsCommandProcessing() const override { return true; }
 
   private:
     std::function<Time(Time)> TimeFunction;  //!< the function that actually does the processing
     virtual std::unique_ptr<Message> process(std::unique_ptr<Message> message) override;
+    virtual bool processCommand(ActionMessage& command) override;
 };
 
 /** class defining an message operator that operates purely on the destination aspect of a message*/
@@ -47,11 +50,13 @@ class HELICS_CXX_EXPORT MessageDestOperator: public FilterOperator {
     void setDestFunction(
         std::function<std::string(const std::string&, const std::string&)> userDestFunction);
     virtual bool isMessageGenerating() const override { return true; }
+    virtual bool supportsCommandProcessing() const override { return true; }
 
   private:
     std::function<std::string(const std::string&, const std::string&)>
         DestUpdateFunction;  //!< the function that actually does the processing
     virtual std::unique_ptr<Message> process(std::unique_ptr<Message> message) override;
+    virtual bool processCommand(ActionMessage& command) override;
 };
 
 /** class defining an message operator that operates purely on the data aspect of a message*/
@@ -137,6 +142,13 @@ class HELICS_CXX_EXPORT FirewallOperator: public FilterOperator {
     /** set the operation to perform on positive checkFunction*/
     void setOperation(operations newop) { operation.store(newop); }
 
+  protected:
+    /** apply the firewall operation to a message given the result of the check function
+    @param checkResult the result of the check
+    @param messageFlags the flags of the message
+    @return false if the message should be dropped*/
+    bool applyOperation(bool checkResult, std::uint16_t& messageFlags) const;
+
   private:
     std::function<bool(const Message*)>
         checkFunction;  //!< the function actually doing the processing
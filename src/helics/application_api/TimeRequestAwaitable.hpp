@@ -0,0 +1,78 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "Federate.hpp"
+
+/** @file
+@details awaitable time requests for use in C++20 coroutines.  The coroutine is suspended while
+the request is outstanding and resumed on the core thread that grants it, so no thread is blocked
+waiting on the grant.  Code between two requests runs on the core thread and should not make
+blocking calls on the federate; a coroutine that needs to do longer work can hand itself off to
+another executor after resuming.
+*/
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#    include <coroutine>
+
+namespace helics {
+/** awaitable object for a time request from a coroutine
+@details the result of co_await is the granted time as returned by Federate::requestTimeComplete*/
+class TimeRequestAwaitable {
+  public:
+    TimeRequestAwaitable(Federate& fed, Time nextTime): mFed(fed), mNextTime(nextTime) {}
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // the coroutine may be resumed before this returns so no members are used after the call
+        mFed.requestTimeAsync(mNextTime, [handle]() { handle.resume(); });
+    }
+    Time await_resume() { return mFed.requestTimeComplete(); }
+
+  private:
+    Federate& mFed;
+    Time mNextTime;
+};
+
+/** awaitable object for an iterative time request from a coroutine
+@details the result of co_await is the iteration_time returned by
+Federate::requestTimeIterativeComplete*/
+class IterativeTimeRequestAwaitable {
+  public:
+    IterativeTimeRequestAwaitable(Federate& fed, Time nextTime, IterationRequest iterate):
+        mFed(fed), mNextTime(nextTime), mIterate(iterate)
+    {
+    }
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        mFed.requestTimeIterativeAsync(mNextTime, mIterate, [handle]() { handle.resume(); });
+    }
+    iteration_time await_resume() { return mFed.requestTimeIterativeComplete(); }
+
+  private:
+    Federate& mFed;
+    Time mNextTime;
+    IterationRequest mIterate;
+};
+
+/** generate an awaitable time request
+@code
+auto granted = co_await helics::requestTimeAwaitable(fed, 5.0);
+@endcode*/
+inline TimeRequestAwaitable requestTimeAwaitable(Federate& fed, Time nextTime)
+{
+    return {fed, nextTime};
+}
+
+/** generate an awaitable iterative time request*/
+inline IterativeTimeRequestAwaitable
+    requestTimeIterativeAwaitable(Federate& fed, Time nextTime, IterationRequest iterate)
+{
+    return {fed, nextTime, iterate};
+}
+}  // namespace helics
+#endif
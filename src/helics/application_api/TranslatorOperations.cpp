@@ -8,18 +8,482 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "TranslatorOperations.hpp"
 
 #include "../core/Core.hpp"
+#include "../core/MessagePool.hpp"
 #include "../core/core-exceptions.hpp"
 #include "../utilities/timeStringOps.hpp"
 #include "HelicsPrimaryTypes.hpp"
+#include "ValueConverter.hpp"
 
+#include <cmath>
+#include <complex>
+#include <fmt/format.h>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace helics {
 
+namespace {
+    /** check if a type can be used as the schema of a JSON translator*/
+    bool isSchemaType(DataType type)
+    {
+        switch (type) {
+            case DataType::HELICS_DOUBLE:
+            case DataType::HELICS_INT:
+            case DataType::HELICS_BOOL:
+            case DataType::HELICS_STRING:
+            case DataType::HELICS_COMPLEX:
+            case DataType::HELICS_VECTOR:
+            case DataType::HELICS_COMPLEX_VECTOR:
+            case DataType::HELICS_NAMED_POINT:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** storage reused between conversions on the same thread so reading and writing the JSON does
+    not allocate once the buffers have grown to the size of the data*/
+    struct JsonScratch {
+        std::string type;
+        std::string name;
+        std::string text;
+        std::vector<double> numbers;
+        std::vector<std::complex<double>> complexNumbers;
+        NamedPoint point;
+    };
+
+    JsonScratch& jsonScratch()
+    {
+        thread_local JsonScratch scratch;
+        return scratch;
+    }
+
+    /** SAX handler collecting the fields of a {"type":..,"value":..,"name":..} JSON object
+    @details any structure that does not fit the expected shape stops the parse so the message can
+    be handed to the general conversion*/
+    class SchemaJsonReader {
+      public:
+        enum class ValueKind { NONE, NUMBER, BOOLEAN, STRING, ARRAY };
+
+        explicit SchemaJsonReader(JsonScratch& scratch): data(scratch) { data.numbers.clear(); }
+
+        bool null() { return depth > 0 && !isTracked(); }
+        bool boolean(bool val)
+        {
+            return (inValueArray && depth == 2) ? number(val ? 1.0 : 0.0) :
+                                                  scalar(ValueKind::BOOLEAN, [&]() { flag = val; });
+        }
+        bool number_integer(nlohmann::json::number_integer_t val)
+        {
+            return number(static_cast<double>(val), val);
+        }
+        bool number_unsigned(nlohmann::json::number_unsigned_t val)
+        {
+            if (val > static_cast<nlohmann::json::number_unsigned_t>(
+                          (std::numeric_limits<std::int64_t>::max)())) {
+                return number(static_cast<double>(val));
+            }
+            return number(static_cast<double>(val), static_cast<std::int64_t>(val));
+        }
+        bool number_float(nlohmann::json::number_float_t val, const std::string& /*unused*/)
+        {
+            return number(val);
+        }
+        bool string(std::string& val)
+        {
+            if (depth != 1) {
+                return depth > 1 && !isTracked();
+            }
+            switch (field) {
+                case Field::TYPE:
+                    data.type.assign(val);
+                    hasType = true;
+                    break;
+                case Field::NAME:
+                    data.name.assign(val);
+                    hasName = true;
+                    break;
+                case Field::VALUE:
+                    data.text.assign(val);
+                    kind = ValueKind::STRING;
+                    break;
+                case Field::OTHER:
+                    break;
+            }
+            return true;
+        }
+        bool binary(nlohmann::json::binary_t& /*val*/) { return depth > 0 && !isTracked(); }
+        bool start_object(std::size_t /*elements*/)
+        {
+            if (depth > 0 && isTracked()) {
+                return false;
+            }
+            ++depth;
+            return true;
+        }
+        bool key(std::string& val)
+        {
+            if (depth == 1) {
+                if (val == "type") {
+                    field = Field::TYPE;
+                } else if (val == "value") {
+                    field = Field::VALUE;
+                } else if (val == "name") {
+                    field = Field::NAME;
+                } else {
+                    field = Field::OTHER;
+                }
+            }
+            return true;
+        }
+        bool end_object()
+        {
+            --depth;
+            return true;
+        }
+        bool start_array(std::size_t /*elements*/)
+        {
+            if (depth == 0 || inValueArray) {
+                return false;
+            }
+            if (depth == 1 && field != Field::OTHER) {
+                if (field != Field::VALUE) {
+                    return false;
+                }
+                inValueArray = true;
+                kind = ValueKind::ARRAY;
+                data.numbers.clear();
+            }
+            ++depth;
+            return true;
+        }
+        bool end_array()
+        {
+            --depth;
+            if (depth == 1) {
+                inValueArray = false;
+            }
+            return true;
+        }
+        bool parse_error(std::size_t /*position*/,
+                         const std::string& /*lastToken*/,
+                         const nlohmann::detail::exception& /*ex*/)
+        {
+            return false;
+        }
+
+        /** generate the value buffer for a type from the collected fields
+        @return false if the fields do not describe a value of the type*/
+        bool generate(DataType type, SmallBuffer& result);
+
+        bool hasType{false};
+        JsonScratch& data;
+
+      private:
+        enum class Field { OTHER, TYPE, VALUE, NAME };
+
+        /** check if the current location is one of the fields being collected*/
+        bool isTracked() const
+        {
+            return (depth == 1 && field != Field::OTHER) || (depth == 2 && inValueArray);
+        }
+        bool number(double val, std::optional<std::int64_t> ival = std::nullopt)
+        {
+            if (inValueArray && depth == 2) {
+                data.numbers.push_back(val);
+                return true;
+            }
+            return scalar(ValueKind::NUMBER, [&]() {
+                value = val;
+                integer = ival;
+            });
+        }
+        template<class Store>
+        bool scalar(ValueKind newKind, Store store)
+        {
+            if (depth != 1) {
+                return depth > 1 && !isTracked();
+            }
+            if (field == Field::VALUE) {
+                kind = newKind;
+                store();
+                return true;
+            }
+            // the type and name fields must be strings
+            return field == Field::OTHER;
+        }
+
+        int depth{0};
+        Field field{Field::OTHER};
+        bool inValueArray{false};
+        bool hasName{false};
+        ValueKind kind{ValueKind::NONE};
+        double value{0.0};
+        std::optional<std::int64_t> integer;  //!< set if the value was an integer in the JSON
+        bool flag{false};
+    };
+
+    bool SchemaJsonReader::generate(DataType type, SmallBuffer& result)
+    {
+        switch (type) {
+            case DataType::HELICS_DOUBLE:
+                if (kind != ValueKind::NUMBER) {
+                    return false;
+                }
+                ValueConverter<double>::convert(value, result);
+                return true;
+            case DataType::HELICS_INT:
+                if (kind != ValueKind::NUMBER) {
+                    return false;
+                }
+                if (!integer) {
+                    // floating point values outside [-2^63, 2^63) go to the general conversion
+                    constexpr double intLimit{9223372036854775808.0};
+                    if (!(value >= -intLimit && value < intLimit)) {
+                        return false;
+                    }
+                    integer = static_cast<std::int64_t>(value);
+                }
+                ValueConverter<std::int64_t>::convert(*integer, result);
+                return true;
+            case DataType::HELICS_BOOL:
+                // booleans are delivered as integers
+                if (kind != ValueKind::BOOLEAN) {
+                    return false;
+                }
+                ValueConverter<std::int64_t>::convert(flag ? 1 : 0, result);
+                return true;
+            case DataType::HELICS_STRING:
+                if (kind != ValueKind::STRING) {
+                    return false;
+                }
+                ValueConverter<std::string_view>::convert(data.text, result);
+                return true;
+            case DataType::HELICS_COMPLEX:
+                if (kind != ValueKind::ARRAY || data.numbers.size() < 2) {
+                    return false;
+                }
+                ValueConverter<std::complex<double>>::convert(
+                    std::complex<double>(data.numbers[0], data.numbers[1]), result);
+                return true;
+            case DataType::HELICS_VECTOR:
+                if (kind != ValueKind::ARRAY) {
+                    return false;
+                }
+                ValueConverter<double>::convert(data.numbers.data(), data.numbers.size(), result);
+                return true;
+            case DataType::HELICS_COMPLEX_VECTOR:
+                if (kind != ValueKind::ARRAY || data.numbers.empty()) {
+                    return false;
+                }
+                data.complexNumbers.clear();
+                for (std::size_t ii = 0; ii + 1 < data.numbers.size(); ii += 2) {
+                    data.complexNumbers.emplace_back(data.numbers[ii], data.numbers[ii + 1]);
+                }
+                ValueConverter<std::complex<double>>::convert(data.complexNumbers.data(),
+                                                              data.complexNumbers.size(),
+                                                              result);
+                return true;
+            case DataType::HELICS_NAMED_POINT:
+                if (kind != ValueKind::NUMBER || !hasName) {
+                    return false;
+                }
+                data.point.name.assign(data.name);
+                data.point.value = value;
+                ValueConverter<NamedPoint>::convert(data.point, result);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    using JsonOutput = fmt::memory_buffer;
+
+    void appendText(JsonOutput& out, std::string_view text)
+    {
+        out.append(text.data(), text.data() + text.size());
+    }
+
+    void writeJsonNumber(JsonOutput& out, double val)
+    {
+        // JSON has no representation for nan or infinity
+        if (std::isfinite(val)) {
+            fmt::format_to(std::back_inserter(out), "{}", val);
+        } else {
+            appendText(out, "null");
+        }
+    }
+
+    void writeJsonString(JsonOutput& out, std::string_view str)
+    {
+        static constexpr std::string_view hexDigits{"0123456789abcdef"};
+        out.push_back('"');
+        for (const char character : str) {
+            switch (character) {
+                case '"':
+                    appendText(out, R"(\")");
+                    break;
+                case '\\':
+                    appendText(out, R"(\\)");
+                    break;
+                case '\n':
+                    appendText(out, R"(\n)");
+                    break;
+                case '\r':
+                    appendText(out, R"(\r)");
+                    break;
+                case '\t':
+                    appendText(out, R"(\t)");
+                    break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20U) {
+                        const auto code = static_cast<unsigned char>(character);
+                        appendText(out, R"(\u00)");
+                        out.push_back(hexDigits[code >> 4U]);
+                        out.push_back(hexDigits[code & 0x0FU]);
+                    } else {
+                        out.push_back(character);
+                    }
+                    break;
+            }
+        }
+        out.push_back('"');
+    }
+
+    /** write a value as a compact JSON object of the given type*/
+    void writeSchemaJson(const SmallBuffer& value, DataType type, JsonOutput& out)
+    {
+        const data_view view(value);
+        const auto baseType = detail::detectType(value.data());
+        auto& scratch = jsonScratch();
+        appendText(out, R"({"type":")");
+        appendText(out, typeNameStringRef(type));
+        appendText(out, R"(",)");
+        switch (type) {
+            case DataType::HELICS_DOUBLE: {
+                double val{0.0};
+                valueExtract(view, baseType, val);
+                appendText(out, R"("value":)");
+                writeJsonNumber(out, val);
+            } break;
+            case DataType::HELICS_INT: {
+                std::int64_t val{0};
+                valueExtract(view, baseType, val);
+                fmt::format_to(std::back_inserter(out), R"("value":{})", val);
+            } break;
+            case DataType::HELICS_BOOL: {
+                bool val{false};
+                valueExtract(view, baseType, val);
+                appendText(out, val ? R"("value":true)" : R"("value":false)");
+            } break;
+            case DataType::HELICS_STRING:
+                appendText(out, R"("value":)");
+                if (baseType == DataType::HELICS_STRING) {
+                    writeJsonString(out, ValueConverter<std::string_view>::interpret(view));
+                } else {
+                    valueExtract(view, baseType, scratch.text);
+                    writeJsonString(out, scratch.text);
+                }
+                break;
+            case DataType::HELICS_COMPLEX: {
+                std::complex<double> val;
+                valueExtract(view, baseType, val);
+                appendText(out, R"("value":[)");
+                writeJsonNumber(out, val.real());
+                out.push_back(',');
+                writeJsonNumber(out, val.imag());
+                out.push_back(']');
+            } break;
+            case DataType::HELICS_VECTOR:
+                valueExtract(view, baseType, scratch.numbers);
+                appendText(out, R"("value":[)");
+                for (std::size_t ii = 0; ii < scratch.numbers.size(); ++ii) {
+                    if (ii > 0) {
+                        out.push_back(',');
+                    }
+                    writeJsonNumber(out, scratch.numbers[ii]);
+                }
+                out.push_back(']');
+                break;
+            case DataType::HELICS_COMPLEX_VECTOR:
+                valueExtract(view, baseType, scratch.complexNumbers);
+                appendText(out, R"("value":[)");
+                for (std::size_t ii = 0; ii < scratch.complexNumbers.size(); ++ii) {
+                    if (ii > 0) {
+                        out.push_back(',');
+                    }
+                    writeJsonNumber(out, scratch.complexNumbers[ii].real());
+                    out.push_back(',');
+                    writeJsonNumber(out, scratch.complexNumbers[ii].imag());
+                }
+                out.push_back(']');
+                break;
+            case DataType::HELICS_NAMED_POINT:
+            default:
+                valueExtract(view, baseType, scratch.point);
+                appendText(out, R"("name":)");
+                writeJsonString(out, scratch.point.name);
+                appendText(out, R"(,"value":)");
+                writeJsonNumber(out, scratch.point.value);
+                break;
+        }
+        out.push_back('}');
+    }
+}  // namespace
+
+void JsonTranslatorOperator::setSchema(DataType type)
+{
+    if (type != DataType::HELICS_ANY && type != DataType::HELICS_UNKNOWN && !isSchemaType(type)) {
+        throw(InvalidParameter("JSON translator schema must be a basic value type"));
+    }
+    mSchema.store(type);
+}
+
+DataType JsonTranslatorOperator::resolveSchema(DataType detected)
+{
+    auto schema = mSchema.load();
+    if (schema == DataType::HELICS_ANY) {
+        if (!isSchemaType(detected)) {
+            return DataType::HELICS_UNKNOWN;
+        }
+        // if another conversion fixed the schema first use that one
+        if (!mSchema.compare_exchange_strong(schema, detected)) {
+            return (schema == DataType::HELICS_ANY) ? DataType::HELICS_UNKNOWN : schema;
+        }
+        return detected;
+    }
+    return schema;
+}
+
 SmallBuffer JsonTranslatorOperator::convertToValue(std::unique_ptr<Message> message)
 {
+    if (mSchema.load() != DataType::HELICS_UNKNOWN) {
+        SchemaJsonReader reader(jsonScratch());
+        const auto* text = message->data.char_data();
+        const bool parsed = nlohmann::json::sax_parse(text,
+                                                      text + message->data.size(),
+                                                      &reader,
+                                                      nlohmann::json::input_format_t::json,
+                                                      true,
+                                                      true);
+        if (parsed && reader.hasType) {
+            auto schema = mSchema.load();
+            if (schema == DataType::HELICS_ANY) {
+                schema = resolveSchema(getTypeFromString(reader.data.type));
+            }
+            SmallBuffer result;
+            if (schema != DataType::HELICS_UNKNOWN &&
+                reader.data.type == typeNameStringRef(schema) && reader.generate(schema, result)) {
+                return result;
+            }
+        }
+    }
     defV val;
     val = readJsonValue(message->data.to_string());
     return typeConvertDefV(val);
@@ -28,10 +492,20 @@ SmallBuffer JsonTranslatorOperator::convertToValue(std::unique_ptr<Message> mess
 /** convert a value to a message*/
 std::unique_ptr<Message> JsonTranslatorOperator::convertToMessage(const SmallBuffer& value)
 {
+    if (mSchema.load() != DataType::HELICS_UNKNOWN && !value.empty()) {
+        const auto schema = resolveSchema(detail::detectType(value.data()));
+        if (schema != DataType::HELICS_UNKNOWN) {
+            JsonOutput out;
+            writeSchemaJson(value, schema, out);
+            auto m = acquireMessage();
+            m->data.assign(out.data(), out.size());
+            return m;
+        }
+    }
     defV val;
     valueExtract(value, DataType::HELICS_ANY, val);
     auto sb = typeConvertDefV(DataType::HELICS_JSON, val);
-    auto m = std::make_unique<Message>();
+    auto m = acquireMessage();
     m->data = sb.to_string();
     return m;
 }
@@ -46,7 +520,7 @@ SmallBuffer BinaryTranslatorOperator::convertToValue(std::unique_ptr<Message> me
 /** convert a value to a message*/
 std::unique_ptr<Message> BinaryTranslatorOperator::convertToMessage(const SmallBuffer& value)
 {
-    auto m = std::make_unique<Message>();
+    auto m = acquireMessage();
     m->data = value;
     return m;
 }
@@ -88,6 +562,26 @@ JsonTranslatorOperation::JsonTranslatorOperation(): to(std::make_shared<JsonTran
 {
 }
 
+void JsonTranslatorOperation::setString(std::string_view property, std::string_view val)
+{
+    if (property != "schema") {
+        TranslatorOperations::setString(property, val);
+        return;
+    }
+    if (val.empty() || val == "none") {
+        to->setSchema(DataType::HELICS_UNKNOWN);
+    } else if (val == "auto" || val == "any") {
+        to->setSchema(DataType::HELICS_ANY);
+    } else {
+        const auto type = getTypeFromString(val);
+        if (type == DataType::HELICS_CUSTOM || type == DataType::HELICS_ANY) {
+            throw(InvalidParameter(std::string("unrecognized JSON translator schema type ") +
+                                   std::string(val)));
+        }
+        to->setSchema(type);
+    }
+}
+
 BinaryTranslatorOperation::BinaryTranslatorOperation():
     to(std::make_shared<BinaryTranslatorOperator>())
 {
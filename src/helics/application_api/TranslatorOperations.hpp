@@ -13,27 +13,47 @@ file defines some common translator operations
 #include "../common/GuardedTypes.hpp"
 #include "../core/core-data.hpp"
 #include "../core/helicsTime.hpp"
+#include "helicsTypes.hpp"
 
 #include <atomic>
 #include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace helics {
 class Core;
 
-/** class defining translator operations that converts values to a json string and vice versa*/
+/** class defining translator operations that converts values to a json string and vice versa
+@details by default every message is parsed into a full JSON document and every value is written
+through one.  If a schema is set the shape of the JSON is known in advance, so messages are read
+with a streaming parser straight into the value buffer and values are formatted directly into the
+message.  Messages that do not match the schema fall back to the general conversion.
+*/
 class JsonTranslatorOperator: public TranslatorOperator {
   public:
     /** default constructor*/
     JsonTranslatorOperator() = default;
 
+    /** set the type of value carried in the JSON
+    @param type the type of the value, HELICS_ANY to take the type from the first message or value
+    converted, or HELICS_UNKNOWN to always use the general conversion
+    @throw InvalidParameter if the type is not one that can be carried in the JSON*/
+    void setSchema(DataType type);
+    /** get the current schema type, HELICS_UNKNOWN if no schema is in use*/
+    DataType getSchema() const { return mSchema.load(); }
+
   private:
     virtual SmallBuffer convertToValue(std::unique_ptr<Message> message) override;
     virtual std::unique_ptr<Message> convertToMessage(const SmallBuffer& value) override;
+    /** get the schema to use for a conversion, fixing it to the detected type if not yet set
+    @return the schema type or HELICS_UNKNOWN if the general conversion should be used*/
+    DataType resolveSchema(DataType detected);
+
+    std::atomic<DataType> mSchema{DataType::HELICS_UNKNOWN};
 };
 
 /** class defining translator operations that simply move the binary value data into a message and
@@ -119,6 +139,10 @@ class JsonTranslatorOperation: public TranslatorOperations {
 
   public:
     JsonTranslatorOperation();
+    /** set a string property, the "schema" property sets the type of value in the JSON
+    @details the schema is a type name, "auto" to use the type of the first message or value, or
+    "none" to turn off the schema*/
+    virtual void setString(std::string_view property, std::string_view val) override;
     virtual std::shared_ptr<TranslatorOperator> getOperator() override
     {
         return std::static_pointer_cast<TranslatorOperator>(to);
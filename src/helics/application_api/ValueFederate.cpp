@@ -599,6 +599,29 @@ std::vector<int> ValueFederate::queryUpdates()
     return vfManager->queryUpdates();
 }
 
+int ValueFederate::getUpdatedValues(double* values, int* indices, int maxCount)
+{
+    return vfManager->getUpdatedValues(values, indices, maxCount);
+}
+
+int ValueFederate::getUpdatedValues(std::int64_t* values, int* indices, int maxCount)
+{
+    return vfManager->getUpdatedValues(values, indices, maxCount);
+}
+
+std::pair<std::vector<int>, std::vector<double>> ValueFederate::getUpdatedValues()
+{
+    const auto inputCount = getInputCount();
+    std::pair<std::vector<int>, std::vector<double>> updates;
+    updates.first.resize(inputCount);
+    updates.second.resize(inputCount);
+    const auto count =
+        vfManager->getUpdatedValues(updates.second.data(), updates.first.data(), inputCount);
+    updates.first.resize(count);
+    updates.second.resize(count);
+    return updates;
+}
+
 const std::string& ValueFederate::getTarget(const Input& inp) const
 {
     return vfManager->getTarget(inp);
@@ -704,6 +727,15 @@ void ValueFederate::setInputNotificationCallback(Input& inp,
     vfManager->setInputNotificationCallback(inp, std::move(callback));
 }
 
+void ValueFederate::setInputCallbackThreads(int threads)
+{
+    if (singleThreadFederate && threads > 1) {
+        throw(InvalidFunctionCall(
+            "parallel input callbacks are not allowed for single thread federates"));
+    }
+    vfManager->setCallbackThreads(threads);
+}
+
 int ValueFederate::getPublicationCount() const
 {
     return vfManager->getPublicationCount();
@@ -13,10 +13,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "ValueConverter.hpp"
 #include "data_view.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace helics {
@@ -448,6 +450,21 @@ class HELICS_CXX_EXPORT ValueFederate:
     @return a vector of input indices with all the values that have not been retrieved since updated
     */
     std::vector<int> queryUpdates();
+    /** get the values of all the updated inputs as doubles in a single call
+    @details this is equivalent to calling getValue<double> on each updated input with a double,
+    integer, boolean, or time type but the inputs are only locked once for the call.  Updates to
+    inputs of other types are left pending
+    @param values the array to store the values in
+    @param indices the array to store the index of the input for each value, may be nullptr
+    @param maxCount the capacity of the arrays
+    @return the number of values stored, updates beyond maxCount remain pending*/
+    int getUpdatedValues(double* values, int* indices, int maxCount);
+    /** get the values of all the updated inputs as integers in a single call
+    @copydetails getUpdatedValues(double*,int*,int)*/
+    int getUpdatedValues(std::int64_t* values, int* indices, int maxCount);
+    /** get the values of all the updated inputs as doubles
+    @return a pair of vectors with the input indices and the values*/
+    std::pair<std::vector<int>, std::vector<double>> getUpdatedValues();
 
     /** get the name of the first target for an input
     @return empty string if an invalid input is passed or it has no target*/
@@ -548,6 +565,13 @@ class HELICS_CXX_EXPORT ValueFederate:
     @param callback the function to call
     */
     void setInputNotificationCallback(Input& inp, std::function<void(Input&, Time)> callback);
+    /** set the number of threads used to run the input notification callbacks
+    @details with more than one thread the callbacks for inputs updated in the same time step are
+    run concurrently on a pool of threads, so they must not depend on each other or on the order
+    they are called in.  The default is 1 which runs them sequentially on the thread granting time.
+    @param threads the total number of threads used for the callbacks
+    @throw InvalidFunctionCall if the federate is a single thread federate*/
+    void setInputCallbackThreads(int threads);
 
     /** get a count of the number publications registered*/
     int getPublicationCount() const;
@@ -11,10 +11,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../core/EmptyCore.hpp"
 #include "../core/core-exceptions.hpp"
 #include "../core/queryHelpers.hpp"
+#include "InputCallbackPool.hpp"
 #include "Inputs.hpp"
 #include "Publications.hpp"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -255,14 +257,19 @@ Time ValueFederateManager::getLastUpdateTime(const Input& inp)
 
 bool ValueFederateManager::getUpdateFromCore(Input& inp)
 {
-    auto* iData = static_cast<InputData*>(inp.dataReference);
     if (inp.getMultiInputMode() != MultiInputHandlingMethod::NO_OP) {
+        auto* iData = static_cast<InputData*>(inp.dataReference);
         const auto& dataV = coreObject->getAllValues(inp.handle);
         iData->hasUpdate = false;
         return inp.vectorDataProcess(dataV);
     }
-    const auto& data = coreObject->getValue(inp.handle);
-    iData->lastData = data;
+    return loadUpdate(inp, coreObject->getValue(inp.handle));
+}
+
+bool ValueFederateManager::loadUpdate(Input& inp, std::shared_ptr<const SmallBuffer> data)
+{
+    auto* iData = static_cast<InputData*>(inp.dataReference);
+    iData->lastData = std::move(data);
     iData->hasUpdate = true;
     return inp.checkUpdate(true);
 }
@@ -274,39 +281,61 @@ void ValueFederateManager::updateTime(Time newTime, Time /*oldTime*/)
     if (handles.empty()) {
         return;
     }
-    // lock the data updates
-    auto inpHandle = inputs.lock();
+    // read all the updated values from the core in one call
+    coreObject->getValues(fedID, handles, updateData);
     auto allCall = allCallback.load();
-    for (auto handle : handles) {
-        /** find the id*/
-        auto fid = inpHandle->find(handle);
-        if (fid != inpHandle->end()) {  // assign the data
-            auto* iData = static_cast<InputData*>(fid->dataReference);
-            iData->lastUpdate = CurrentTime;
-
-            bool updated = getUpdateFromCore(*fid);
-
-            if (updated) {
-                if (iData->callback) {
-                    Input& inp = *fid;
-
-                    inpHandle.unlock();  // need to free the lock
-
-                    // callbacks can do all sorts of things, best not to have it locked during the
-                    // callback
-                    iData->callback(inp, CurrentTime);
-                    inpHandle = inputs.lock();
-                } else if (allCall) {
-                    Input& inp = *fid;
-                    inpHandle.unlock();  // need to free the lock
-                    // callbacks can do all sorts of strange things, best not to have it locked
-                    // during the callback
-                    allCall(inp, CurrentTime);
-                    inpHandle = inputs.lock();
+    notifications.clear();
+    {
+        // lock the data updates once for all the handles
+        auto inpHandle = inputs.lock();
+        for (std::size_t ii = 0; ii < handles.size(); ++ii) {
+            /** find the id*/
+            auto fid = inpHandle->find(handles[ii]);
+            if (fid != inpHandle->end()) {  // assign the data
+                auto* iData = static_cast<InputData*>(fid->dataReference);
+                iData->lastUpdate = CurrentTime;
+
+                bool updated = (fid->getMultiInputMode() == MultiInputHandlingMethod::NO_OP) ?
+                    loadUpdate(*fid, std::move(updateData[ii])) :
+                    getUpdateFromCore(*fid);
+                if (updated && (iData->callback || allCall)) {
+                    notifications.push_back(&(*fid));
                 }
             }
         }
     }
+    // callbacks can do all sorts of things, best not to have the inputs locked during the callbacks
+    if (callbackPool) {
+        callbackPool->run(notifications.size(), [this, &allCall](std::size_t index) {
+            notifyInput(*notifications[index], allCall);
+        });
+    } else {
+        for (auto* inp : notifications) {
+            notifyInput(*inp, allCall);
+        }
+    }
+}
+
+void ValueFederateManager::notifyInput(Input& inp,
+                                       const std::function<void(Input&, Time)>& allCall) const
+{
+    auto* iData = static_cast<InputData*>(inp.dataReference);
+    if (iData->callback) {
+        iData->callback(inp, CurrentTime);
+    } else {
+        allCall(inp, CurrentTime);
+    }
+}
+
+void ValueFederateManager::setCallbackThreads(int threads)
+{
+    if (threads > 1) {
+        if (!callbackPool || callbackPool->size() != threads) {
+            callbackPool = std::make_unique<InputCallbackPool>(threads);
+        }
+    } else {
+        callbackPool.reset();
+    }
 }
 
 void ValueFederateManager::startupToInitializeStateTransition()
@@ -411,6 +440,59 @@ std::vector<int> ValueFederateManager::queryUpdates()
     }
     return updates;
 }
+/** check if an input carries a value that can be read as a number*/
+static bool isNumericInput(const Input& inp)
+{
+    auto iType = inp.getHelicsType();
+    if (iType == DataType::HELICS_ANY || iType == DataType::HELICS_UNKNOWN) {
+        iType = inp.getHelicsInjectionType();
+    }
+    switch (iType) {
+        case DataType::HELICS_DOUBLE:
+        case DataType::HELICS_INT:
+        case DataType::HELICS_BOOL:
+        case DataType::HELICS_TIME:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class X>
+int ValueFederateManager::loadUpdatedValues(X* values, int* indices, int maxCount)
+{
+    if (values == nullptr || maxCount <= 0) {
+        return 0;
+    }
+    int count{0};
+    int index{0};
+    auto inpHandle = inputs.lock();
+    for (auto& inp : *inpHandle) {
+        // other types are left pending for getValue with a matching type
+        if (isNumericInput(inp) && inp.isUpdated()) {
+            values[count] = inp.getValue<X>();
+            if (indices != nullptr) {
+                indices[count] = index;
+            }
+            if (++count == maxCount) {
+                break;
+            }
+        }
+        ++index;
+    }
+    return count;
+}
+
+int ValueFederateManager::getUpdatedValues(double* values, int* indices, int maxCount)
+{
+    return loadUpdatedValues(values, indices, maxCount);
+}
+
+int ValueFederateManager::getUpdatedValues(std::int64_t* values, int* indices, int maxCount)
+{
+    return loadUpdatedValues(values, indices, maxCount);
+}
+
 // NOLINTNEXTLINE
 static const std::string emptyStr;
 
@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/containers/DualStringMappedVector.hpp"
 #include "helicsTypes.hpp"
 
+#include <cstdint>
 #include <deque>
 #include <map>
 #include <memory>
@@ -24,6 +25,7 @@ namespace helics {
 /** forward declaration of Core*/
 class Core;
 class ValueFederate;
+class InputCallbackPool;
 
 /** structure used to contain information about a publication*/
 struct publication_info {
@@ -151,6 +153,16 @@ class ValueFederateManager {
     */
     std::vector<int> queryUpdates();
 
+    /** load the values of all the updated inputs into contiguous arrays
+    @details the inputs are locked once for the whole call, each input stored is marked as read as
+    if getValue had been called on it
+    @param values the array to store the values in
+    @param indices the array to store the input index of each value in, may be nullptr
+    @param maxCount the capacity of the arrays
+    @return the number of values stored, any additional updates are left in place*/
+    int getUpdatedValues(double* values, int* indices, int maxCount);
+    int getUpdatedValues(std::int64_t* values, int* indices, int maxCount);
+
     /** get the target of a input*/
     const std::string& getTarget(const Input& inp) const;
 
@@ -189,6 +201,11 @@ class ValueFederateManager {
     */
     static void setInputNotificationCallback(const Input& inp,
                                              std::function<void(Input&, Time)> callback);
+    /** set the number of threads used to run the input notification callbacks
+    @details with more than one thread the callbacks for the inputs updated in a time step run
+    concurrently so they must not depend on each other, must not be called during a time update
+    @param threads the number of threads including the thread processing the time update*/
+    void setCallbackThreads(int threads);
 
     /** disconnect from the coreObject*/
     void disconnect();
@@ -225,9 +242,21 @@ class ValueFederateManager {
     shared_guarded_opt<std::multimap<std::string, InterfaceHandle>> targetIDs;
     /// container for the specified input targets
     shared_guarded_opt<std::multimap<InterfaceHandle, std::string>> inputTargets;
+    /// the inputs with a notification callback to run for the current time update
+    std::vector<Input*> notifications;
+    /// the data read from the core for the current time update
+    std::vector<std::shared_ptr<const SmallBuffer>> updateData;
+    /// the worker threads for the notification callbacks if they run in parallel
+    std::unique_ptr<InputCallbackPool> callbackPool;
 
   private:
     void getUpdateFromCore(InterfaceHandle handle);
+    /** store new data for an input and check if it is an update*/
+    bool loadUpdate(Input& inp, std::shared_ptr<const SmallBuffer> data);
+    /** run the notification callback for an input*/
+    void notifyInput(Input& inp, const std::function<void(Input&, Time)>& allCall) const;
+    template<class X>
+    int loadUpdatedValues(X* values, int* indices, int maxCount);
 };
 
 }  // namespace helics
@@ -352,6 +352,8 @@ HELICS_CXX_EXPORT std::complex<double> getComplexFromString(std::string_view val
 HELICS_CXX_EXPORT bool helicsBoolValue(std::string_view val);
 /** compute the L2 norm of a vector*/
 HELICS_CXX_EXPORT double vectorNorm(const std::vector<double>& vec);
+/** compute the L2 norm of an array of doubles*/
+HELICS_CXX_EXPORT double vectorNorm(const double* vec, std::size_t size);
 /** compute the L2 norm of a magnitudes of a complex vector*/
 HELICS_CXX_EXPORT double vectorNorm(const std::vector<std::complex<double>>& vec);
 /** convert a value to a data block to be interpreted using the specified type
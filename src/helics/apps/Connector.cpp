@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "../application_api/HelicsPrimaryTypes.hpp"
 #include "../common/JsonProcessingFunctions.hpp"
+#include "../common/NameMatcher.hpp"
 #include "../core/helicsCLI11.hpp"
 #include "../core/helicsVersion.hpp"
 #include "gmlc/utilities/stringOps.h"
@@ -21,6 +22,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <optional>
 #include <regex>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -817,7 +819,7 @@ class RegexMatcher {
   public:
     RegexMatcher() = default;
 
-    std::regex rmatch;
+    std::optional<NamePattern> pattern;
     std::vector<std::string> keys;
     std::string_view interface1;
     std::string_view interface2;
@@ -825,26 +827,32 @@ class RegexMatcher {
     std::string generateMatch(std::string_view testString)
     {
         std::match_results<typename decltype(testString)::const_iterator> matchResults{};
-        if (std::regex_match(testString.begin(), testString.end(), matchResults, rmatch)) {
-            std::string matcher(interface2);
-            if (matcher.compare(0, 6, "REGEX:") == 0) {
-                matcher.erase(0, 6);
-                for (std::size_t ii = 0; ii < keys.size(); ++ii) {
-                    auto keyloc = matcher.find(keys[ii]);
-                    while (keyloc != std::string::npos) {
-                        auto endloc = matcher.find_first_of(')', keyloc);
-                        matcher.replace(matcher.begin() + keyloc - 1,
-                                        matcher.begin() + endloc + 1,
-                                        matchResults[ii + 1].first,
-                                        matchResults[ii + 1].second);
-                        keyloc = matcher.find(keys[ii]);
-                    }
+        // literal, prefix, and glob patterns have no capture groups so skip the regex engine
+        const auto* rmatch = pattern->regex();
+        if (rmatch == nullptr) {
+            if (!pattern->matches(testString)) {
+                return {};
+            }
+        } else if (testString.compare(0, pattern->prefix().size(), pattern->prefix()) != 0 ||
+                   !std::regex_match(testString.begin(), testString.end(), matchResults, *rmatch)) {
+            return {};
+        }
+        std::string matcher(interface2);
+        if (matcher.compare(0, 6, "REGEX:") == 0) {
+            matcher.erase(0, 6);
+            for (std::size_t ii = 0; ii < keys.size(); ++ii) {
+                auto keyloc = matcher.find(keys[ii]);
+                while (keyloc != std::string::npos) {
+                    auto endloc = matcher.find_first_of(')', keyloc);
+                    matcher.replace(matcher.begin() + keyloc - 1,
+                                    matcher.begin() + endloc + 1,
+                                    matchResults[ii + 1].first,
+                                    matchResults[ii + 1].second);
+                    keyloc = matcher.find(keys[ii]);
                 }
             }
-
-            return matcher;
         }
-        return {};
+        return matcher;
     }
 };
 
@@ -1659,10 +1667,10 @@ void Connector::generateRegexMatchers()
         rmatcher->interface2 = rmatch.interface2;
         rmatcher->tags = rmatch.tags;
         try {
-            rmatcher->rmatch = std::regex(rstring);
+            rmatcher->pattern.emplace(rstring);
             regexMatchers.push_back(std::move(rmatcher));
         }
-        catch (const std::regex_error& e) {
+        catch (const std::invalid_argument& e) {
             fed->localError(-101, e.what());
         }
     }
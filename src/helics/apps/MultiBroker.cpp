@@ -224,6 +224,7 @@ std::string MultiBroker::generateLocalAddressString() const
         case CoreType::INPROC:
         case CoreType::IPC:
         case CoreType::INTERPROCESS:
+        case CoreType::SHM:
         case CoreType::TEST:
             return getIdentifier();
         default:
@@ -0,0 +1,668 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "PlaybackIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32) || defined(WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace helics::apps {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept:
+    mappedData(other.mappedData), mappedSize(other.mappedSize), opened(other.opened)
+{
+    other.mappedData = nullptr;
+    other.mappedSize = 0;
+    other.opened = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        mappedData = other.mappedData;
+        mappedSize = other.mappedSize;
+        opened = other.opened;
+        other.mappedData = nullptr;
+        other.mappedSize = 0;
+        other.opened = false;
+    }
+    return *this;
+}
+
+#if defined(_WIN32) || defined(WIN32)
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+    HANDLE file = CreateFileA(filename.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        opened = true;
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    // the view keeps the mapping alive
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return false;
+    }
+    mappedData = static_cast<const char*>(view);
+    mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+    opened = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mappedData != nullptr) {
+        UnmapViewOfFile(mappedData);
+    }
+    mappedData = nullptr;
+    mappedSize = 0;
+    opened = false;
+}
+#else
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (fileStat.st_size == 0) {
+        ::close(fd);
+        opened = true;
+        return true;
+    }
+    auto size = static_cast<std::size_t>(fileStat.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    mappedData = static_cast<const char*>(view);
+    mappedSize = size;
+    opened = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mappedData != nullptr) {
+        munmap(const_cast<char*>(mappedData), mappedSize);
+    }
+    mappedData = nullptr;
+    mappedSize = 0;
+    opened = false;
+}
+#endif
+
+namespace {
+    /// the header of the sidecar index file, the entries follow the header directly
+    struct IndexHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;  //!< detect files written on a machine of different endianness
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+        std::int32_t units;
+        std::uint32_t entrySize;
+        std::uint64_t pointCount;
+        std::uint64_t messageCount;
+        std::uint64_t tableOffset;  //!< offset of the string table
+        std::uint64_t tableSize;
+    };
+    constexpr char indexMagic[8]{'H', 'E', 'L', 'I', 'C', 'S', 'P', 'I'};
+    constexpr std::uint32_t indexVersion{1};
+    constexpr std::uint32_t indexByteOrder{0x01020304};
+    constexpr std::uint32_t noKey{std::numeric_limits<std::uint32_t>::max()};
+
+    static_assert(sizeof(IndexHeader) % alignof(PlaybackIndexEntry) == 0,
+                  "entries must be aligned after the header");
+    static_assert(sizeof(PlaybackIndexEntry) == 24, "index entries must be packed");
+
+    void writeString(std::string& table, std::string_view str)
+    {
+        auto size = static_cast<std::uint32_t>(str.size());
+        table.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        table.append(str);
+    }
+
+    bool readCount(std::string_view& table, std::uint32_t& count)
+    {
+        if (table.size() < sizeof(count)) {
+            return false;
+        }
+        std::memcpy(&count, table.data(), sizeof(count));
+        table.remove_prefix(sizeof(count));
+        return true;
+    }
+
+    bool readString(std::string_view& table, std::string& str)
+    {
+        std::uint32_t size{0};
+        if (!readCount(table, size) || table.size() < size) {
+            return false;
+        }
+        str.assign(table.data(), size);
+        table.remove_prefix(size);
+        return true;
+    }
+
+    std::int64_t modificationTime(const std::string& filename)
+    {
+        std::error_code ec;
+        auto writeTime = std::filesystem::last_write_time(filename, ec);
+        if (ec) {
+            return 0;
+        }
+        return static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+    }
+
+    bool pointLess(const PlaybackIndexEntry& e1, const PlaybackIndexEntry& e2)
+    {
+        return (e1.time == e2.time) ? (e1.iteration < e2.iteration) : (e1.time < e2.time);
+    }
+
+    bool messageLess(const PlaybackIndexEntry& e1, const PlaybackIndexEntry& e2)
+    {
+        return e1.time < e2.time;
+    }
+
+    /** sorts index entries holding at most a run of entries in memory
+    @details full runs are sorted and spilled to a temporary file and merged when the entries are
+    written, entries arriving in order extend the previous run so they are never sorted or merged.
+    The sort is stable so entries with the same time keep the order of the file*/
+    class EntrySorter {
+      public:
+        using Compare = bool (*)(const PlaybackIndexEntry&, const PlaybackIndexEntry&);
+        EntrySorter(std::string tempFile, std::size_t runSize, Compare compare):
+            runFileName(std::move(tempFile)), maxRunSize(runSize), less(compare)
+        {
+        }
+        ~EntrySorter()
+        {
+            runFile.close();
+            if (!runs.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(runFileName, ec);
+            }
+        }
+        EntrySorter(const EntrySorter&) = delete;
+        EntrySorter& operator=(const EntrySorter&) = delete;
+
+        void add(const PlaybackIndexEntry& entry)
+        {
+            if (total > 0 && less(entry, lastEntry)) {
+                ordered = false;
+            }
+            lastEntry = entry;
+            ++total;
+            entries.push_back(entry);
+            if (entries.size() >= maxRunSize) {
+                spill();
+            }
+        }
+        /** complete the sort
+        @return true if all the entries are in memory*/
+        bool finish()
+        {
+            if (runs.empty()) {
+                if (!ordered) {
+                    std::stable_sort(entries.begin(), entries.end(), less);
+                }
+                return true;
+            }
+            spill();
+            runFile.close();
+            return false;
+        }
+        /** check that all the spilled runs were written*/
+        bool good() const { return !failed; }
+        std::vector<PlaybackIndexEntry>& memoryEntries() { return entries; }
+        std::uint64_t count() const { return total; }
+        /** write the sorted entries after finish, merging the spilled runs*/
+        bool writeSorted(std::ostream& out) const;
+
+      private:
+        void spill();
+
+        std::string runFileName;
+        std::size_t maxRunSize;
+        Compare less;
+        std::vector<PlaybackIndexEntry> entries;
+        std::ofstream runFile;
+        /// the first and last entry positions of each sorted run in the run file
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> runs;
+        std::uint64_t spilled{0};
+        std::uint64_t total{0};
+        PlaybackIndexEntry lastEntry{};
+        bool ordered{true};
+        bool failed{false};
+    };
+
+    void EntrySorter::spill()
+    {
+        if (entries.empty() || failed) {
+            return;
+        }
+        if (runs.empty()) {
+            runFile.open(runFileName, std::ios::binary | std::ios::trunc);
+            if (!runFile) {
+                // without a temporary file the entries are all sorted in memory
+                maxRunSize = std::numeric_limits<std::size_t>::max();
+                return;
+            }
+        }
+        if (ordered && !runs.empty()) {
+            runs.back().second += entries.size();
+        } else {
+            if (!ordered) {
+                std::stable_sort(entries.begin(), entries.end(), less);
+            }
+            runs.emplace_back(spilled, spilled + entries.size());
+        }
+        runFile.write(reinterpret_cast<const char*>(entries.data()),
+                      static_cast<std::streamsize>(entries.size() * sizeof(PlaybackIndexEntry)));
+        spilled += entries.size();
+        entries.clear();
+        if (!runFile) {
+            failed = true;
+        }
+    }
+
+    bool EntrySorter::writeSorted(std::ostream& out) const
+    {
+        if (runs.empty()) {
+            out.write(reinterpret_cast<const char*>(entries.data()),
+                      static_cast<std::streamsize>(entries.size() * sizeof(PlaybackIndexEntry)));
+            return static_cast<bool>(out);
+        }
+        MappedFile runData;
+        if (failed || !runData.open(runFileName) ||
+            runData.size() != spilled * sizeof(PlaybackIndexEntry)) {
+            return false;
+        }
+        // the mapping is page aligned so the entries can be used in place
+        const auto* data = reinterpret_cast<const PlaybackIndexEntry*>(runData.data());
+        if (runs.size() == 1) {
+            out.write(runData.data(), static_cast<std::streamsize>(runData.size()));
+            return static_cast<bool>(out);
+        }
+        struct Cursor {
+            std::uint64_t position;
+            std::uint64_t end;
+            std::size_t run;
+        };
+        // ties go to the earlier run to keep the sort stable
+        auto later = [data, this](const Cursor& cursor1, const Cursor& cursor2) {
+            if (less(data[cursor2.position], data[cursor1.position])) {
+                return true;
+            }
+            if (less(data[cursor1.position], data[cursor2.position])) {
+                return false;
+            }
+            return cursor1.run > cursor2.run;
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heads(later);
+        for (std::size_t run = 0; run < runs.size(); ++run) {
+            heads.push({runs[run].first, runs[run].second, run});
+        }
+        constexpr std::size_t blockSize{4096};
+        std::vector<PlaybackIndexEntry> block;
+        block.reserve(blockSize);
+        while (!heads.empty()) {
+            auto cursor = heads.top();
+            heads.pop();
+            block.push_back(data[cursor.position]);
+            if (++cursor.position < cursor.end) {
+                heads.push(cursor);
+            }
+            if (block.size() == blockSize || heads.empty()) {
+                out.write(reinterpret_cast<const char*>(block.data()),
+                          static_cast<std::streamsize>(block.size() * sizeof(PlaybackIndexEntry)));
+                block.clear();
+            }
+        }
+        return static_cast<bool>(out);
+    }
+}  // namespace
+
+bool PlaybackIndex::open(const std::string& filename)
+{
+    fileName = filename;
+    sidecarName = filename + ".pidx";
+    if (!source.open(filename)) {
+        return false;
+    }
+    sourceTime = modificationTime(filename);
+    return true;
+}
+
+template<class Callable>
+void PlaybackIndex::forEachLine(Callable&& callable) const
+{
+    // follows the same rules as the AppTextParser
+    auto text = source.view();
+    bool inMline{false};
+    int lineNumber{0};
+    std::size_t position{0};
+    while (position < text.size()) {
+        auto end = text.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        auto line = text.substr(position, end - position);
+        auto offset = position;
+        position = end + 1;
+        ++lineNumber;
+
+        auto firstChar = line.find_first_not_of(" \t\n\r");
+        if (firstChar == std::string_view::npos) {
+            continue;
+        }
+        if (inMline) {
+            if (firstChar + 2 < line.size() && line.compare(firstChar, 3, "##]") == 0) {
+                inMline = false;
+            }
+            continue;
+        }
+        if (line[firstChar] == '#') {
+            if (firstChar + 2 < line.size() && line.compare(firstChar, 3, "##[") == 0) {
+                inMline = true;
+            }
+            continue;
+        }
+        if (line[firstChar] == '!') {
+            callable(line.substr(firstChar + 1), lineNumber, offset, true);
+            continue;
+        }
+        callable(line, lineNumber, offset, false);
+    }
+}
+
+void PlaybackIndex::scanConfiguration()
+{
+    configStr.clear();
+    forEachLine(
+        [this](std::string_view line, int /*lineNumber*/, std::size_t /*offset*/, bool config) {
+            if (config) {
+                configStr.append(line);
+                configStr.push_back('\n');
+            }
+        });
+}
+
+bool PlaybackIndex::buildIndex(const LineParser& parser, std::int32_t unitCode)
+{
+    units = unitCode;
+    keys.clear();
+    sources.clear();
+    pointEntries.clear();
+    messageEntries.clear();
+    sidecar.close();
+    pointData = nullptr;
+    pointEntryCount = 0;
+    messageData = nullptr;
+    messageEntryCount = 0;
+
+    EntrySorter pointSorter(sidecarName + ".points.tmp", runSize, pointLess);
+    EntrySorter messageSorter(sidecarName + ".messages.tmp", runSize, messageLess);
+    std::unordered_map<std::string, std::uint32_t> keyIds;
+    std::unordered_map<std::string, std::uint32_t> sourceIds;
+    std::uint32_t lastKey{noKey};
+    PlaybackLineInfo info;
+    forEachLine([&](std::string_view line, int lineNumber, std::size_t offset, bool config) {
+        if (config) {
+            return;
+        }
+        info.message = false;
+        info.iteration = 0;
+        info.key.clear();
+        info.type.clear();
+        if (!parser(line, lineNumber, info)) {
+            return;
+        }
+        if (info.message) {
+            auto res = sourceIds.emplace(info.key, static_cast<std::uint32_t>(sources.size()));
+            if (res.second) {
+                sources.push_back(info.key);
+            }
+            messageSorter.add({info.time.getBaseTimeCode(), 0, res.first->second, offset});
+            return;
+        }
+        std::uint32_t key{lastKey};
+        if (!info.key.empty() || lastKey == noKey) {
+            auto res = keyIds.emplace(info.key, static_cast<std::uint32_t>(keys.size()));
+            if (res.second) {
+                keys.emplace_back(info.key, std::string{});
+            }
+            key = res.first->second;
+        }
+        if (keys[key].second.empty()) {
+            keys[key].second = info.type;
+        }
+        lastKey = key;
+        pointSorter.add(
+            {info.time.getBaseTimeCode(), static_cast<std::int32_t>(info.iteration), key, offset});
+    });
+
+    const bool pointsInMemory = pointSorter.finish();
+    const bool messagesInMemory = messageSorter.finish();
+    if (pointsInMemory && messagesInMemory) {
+        pointEntries = std::move(pointSorter.memoryEntries());
+        messageEntries = std::move(messageSorter.memoryEntries());
+        pointData = pointEntries.data();
+        pointEntryCount = pointEntries.size();
+        messageData = messageEntries.data();
+        messageEntryCount = messageEntries.size();
+        return true;
+    }
+    // the index is too large to hold in memory so the runs are merged into the sidecar
+    if (!pointSorter.good() || !messageSorter.good()) {
+        return false;
+    }
+    const bool written = writeSidecar(pointSorter.count(),
+                                      messageSorter.count(),
+                                      [&pointSorter, &messageSorter](std::ostream& out) {
+                                          return pointSorter.writeSorted(out) &&
+                                              messageSorter.writeSorted(out);
+                                      });
+    return written && loadIndex();
+}
+
+bool PlaybackIndex::writeIndex() const
+{
+    if (sidecar.isOpen()) {
+        // the index was loaded from the sidecar or merged directly into it
+        return true;
+    }
+    return writeSidecar(pointEntryCount, messageEntryCount, [this](std::ostream& out) {
+        out.write(reinterpret_cast<const char*>(pointData),
+                  static_cast<std::streamsize>(pointEntryCount * sizeof(PlaybackIndexEntry)));
+        out.write(reinterpret_cast<const char*>(messageData),
+                  static_cast<std::streamsize>(messageEntryCount * sizeof(PlaybackIndexEntry)));
+        return static_cast<bool>(out);
+    });
+}
+
+bool PlaybackIndex::writeSidecar(std::size_t points,
+                                 std::size_t messages,
+                                 const std::function<bool(std::ostream&)>& writeEntries) const
+{
+    std::string table;
+    writeString(table, configStr);
+    auto count = static_cast<std::uint32_t>(keys.size());
+    table.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& key : keys) {
+        writeString(table, key.first);
+        writeString(table, key.second);
+    }
+    count = static_cast<std::uint32_t>(sources.size());
+    table.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& src : sources) {
+        writeString(table, src);
+    }
+
+    IndexHeader header{};
+    std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    header.version = indexVersion;
+    header.byteOrder = indexByteOrder;
+    header.sourceSize = source.size();
+    header.sourceTime = sourceTime;
+    header.units = units;
+    header.entrySize = sizeof(PlaybackIndexEntry);
+    header.pointCount = points;
+    header.messageCount = messages;
+    header.tableOffset = sizeof(IndexHeader) + (points + messages) * sizeof(PlaybackIndexEntry);
+    header.tableSize = table.size();
+
+    // write to a temporary file so a partially written index is never used
+    const std::string tempName = sidecarName + ".tmp";
+    {
+        std::ofstream out(tempName, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const bool entriesWritten = writeEntries(out);
+        out.write(table.data(), static_cast<std::streamsize>(table.size()));
+        if (!out || !entriesWritten) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tempName, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempName, sidecarName, ec);
+    if (ec) {
+        std::filesystem::remove(tempName, ec);
+        return false;
+    }
+    return true;
+}
+
+bool PlaybackIndex::loadIndex()
+{
+    if (!sidecar.open(sidecarName)) {
+        return false;
+    }
+    IndexHeader header{};
+    bool valid = sidecar.size() >= sizeof(IndexHeader);
+    if (valid) {
+        std::memcpy(&header, sidecar.data(), sizeof(IndexHeader));
+        const std::uint64_t entryBytes =
+            (header.pointCount + header.messageCount) * sizeof(PlaybackIndexEntry);
+        valid = std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) == 0 &&
+            header.version == indexVersion && header.byteOrder == indexByteOrder &&
+            header.entrySize == sizeof(PlaybackIndexEntry) &&
+            header.sourceSize == source.size() && header.sourceTime == sourceTime &&
+            header.pointCount <= sidecar.size() && header.messageCount <= sidecar.size() &&
+            header.tableOffset == sizeof(IndexHeader) + entryBytes &&
+            header.tableOffset + header.tableSize == sidecar.size();
+    }
+    std::vector<std::pair<std::string, std::string>> newKeys;
+    std::vector<std::string> newSources;
+    std::string newConfig;
+    if (valid) {
+        std::string_view table(sidecar.data() + header.tableOffset, header.tableSize);
+        std::uint32_t count{0};
+        valid = readString(table, newConfig) && readCount(table, count);
+        for (std::uint32_t ii = 0; valid && ii < count; ++ii) {
+            newKeys.emplace_back();
+            valid = readString(table, newKeys.back().first) &&
+                readString(table, newKeys.back().second);
+        }
+        valid = valid && readCount(table, count);
+        for (std::uint32_t ii = 0; valid && ii < count; ++ii) {
+            newSources.emplace_back();
+            valid = readString(table, newSources.back());
+        }
+    }
+    if (!valid) {
+        sidecar.close();
+        return false;
+    }
+    configStr = std::move(newConfig);
+    keys = std::move(newKeys);
+    sources = std::move(newSources);
+    units = header.units;
+    pointEntries.clear();
+    messageEntries.clear();
+    // the header size is a multiple of the entry alignment and the mapping is page aligned
+    pointData = reinterpret_cast<const PlaybackIndexEntry*>(sidecar.data() + sizeof(IndexHeader));
+    pointEntryCount = header.pointCount;
+    messageData = pointData + header.pointCount;
+    messageEntryCount = header.messageCount;
+    return true;
+}
+
+std::string_view PlaybackIndex::line(const PlaybackIndexEntry& entry) const
+{
+    auto text = source.view();
+    if (entry.offset >= text.size()) {
+        return {};
+    }
+    text.remove_prefix(entry.offset);
+    return text.substr(0, text.find('\n'));
+}
+
+}  // namespace helics::apps
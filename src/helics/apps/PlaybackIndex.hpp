@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+
+#include "../core/helicsTime.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/** @file
+@details memory mapped playback of Player text files.  The input file is mapped and indexed by the
+time of each value and message line, the index is stored in a sidecar file (the input file name
+with ".pidx" appended) which is reused on later runs as long as the input file is unchanged.
+
+The sidecar is a fixed header followed by the value and message entry arrays (sorted by time)
+and a table of the publication keys, message sources, and configuration lines of the file.  The
+entry arrays are used directly from a mapping of the sidecar so opening an indexed file only
+touches the pages that are actually read.
+
+Building the index holds at most a run of entries in memory.  Files with more entries are sorted
+in runs which are spilled to temporary files next to the sidecar and merged into the sidecar, runs
+of entries that are already in time order are written without sorting.
+*/
+namespace helics::apps {
+
+/** read only memory mapping of a file*/
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    /** map a file, any existing mapping is closed
+    @return true if the file was mapped*/
+    bool open(const std::string& filename);
+    /** remove the mapping*/
+    void close();
+    bool isOpen() const { return opened; }
+    const char* data() const { return mappedData; }
+    std::size_t size() const { return mappedSize; }
+    std::string_view view() const { return {mappedData, mappedSize}; }
+
+  private:
+    const char* mappedData{nullptr};
+    std::size_t mappedSize{0};
+    bool opened{false};
+};
+
+/** an index entry for a value or message line of a playback file*/
+struct PlaybackIndexEntry {
+    std::int64_t time;  //!< base time code of the value or the send time of the message
+    std::int32_t iteration;  //!< the iteration of a value
+    std::uint32_t key;  //!< index of the publication key or message source
+    std::uint64_t offset;  //!< offset of the line in the file
+};
+
+/** the information extracted from a data line to build the index*/
+struct PlaybackLineInfo {
+    bool message{false};  //!< the line is a message
+    Time time;  //!< time of the value or the send time of the message
+    int iteration{0};
+    std::string key;  //!< publication key or message source, empty to use the previous key
+    std::string type;  //!< type of the value if specified
+};
+
+/** class holding a memory mapped text playback file and its time index*/
+class PlaybackIndex {
+  public:
+    /** function to extract the index information from a data line
+    @return false if the line should not be indexed*/
+    using LineParser = std::function<bool(std::string_view, int, PlaybackLineInfo&)>;
+    /// the default number of entries sorted in memory at a time when building the index
+    static constexpr std::size_t defaultRunSize{1U << 20U};
+
+    /** map the playback file
+    @return true if the file could be mapped*/
+    bool open(const std::string& filename);
+    /** load the index from the sidecar file if it is valid for the mapped file
+    @return true if the index was loaded*/
+    bool loadIndex();
+    /** scan the file for configuration lines, used before building the index*/
+    void scanConfiguration();
+    /** set the maximum number of entries of each type held in memory while building the index*/
+    void setRunSize(std::size_t entries) { runSize = std::max<std::size_t>(entries, 1); }
+    /** build the index from the data lines of the file
+    @details if the entries do not fit in a single run the index is merged directly into the
+    sidecar file and used from there
+    @param parser function extracting the times and keys from a line
+    @param unitCode identifier of the time units used to interpret the file
+    @return false if the temporary or sidecar files for a large index could not be written*/
+    bool buildIndex(const LineParser& parser, std::int32_t unitCode);
+    /** write the index to the sidecar file
+    @return true if the sidecar was written*/
+    bool writeIndex() const;
+
+    /** get the name of the sidecar index file*/
+    const std::string& indexFileName() const { return sidecarName; }
+    /** get the configuration lines of the file*/
+    const std::string& configString() const { return configStr; }
+    /** get the identifier of the time units used when the index was built*/
+    std::int32_t unitCode() const { return units; }
+    /** get the publication keys and types referenced by the value entries*/
+    const std::vector<std::pair<std::string, std::string>>& getKeys() const { return keys; }
+    /** get the message sources referenced by the message entries*/
+    const std::vector<std::string>& getSources() const { return sources; }
+
+    std::size_t pointCount() const { return pointEntryCount; }
+    std::size_t messageCount() const { return messageEntryCount; }
+    /** get a value entry, sorted by time and iteration*/
+    const PlaybackIndexEntry& point(std::size_t index) const { return pointData[index]; }
+    /** get a message entry, sorted by send time*/
+    const PlaybackIndexEntry& message(std::size_t index) const { return messageData[index]; }
+    /** get the text of a line from an entry*/
+    std::string_view line(const PlaybackIndexEntry& entry) const;
+
+  private:
+    /** call a function with each data line and line number of the file*/
+    template<class Callable>
+    void forEachLine(Callable&& callable) const;
+    /** write the sidecar file with the entries generated by a callback
+    @param writeEntries function writing the value entries followed by the message entries*/
+    bool writeSidecar(std::size_t points,
+                      std::size_t messages,
+                      const std::function<bool(std::ostream&)>& writeEntries) const;
+
+    std::string fileName;
+    std::string sidecarName;
+    MappedFile source;  //!< the playback file
+    MappedFile sidecar;  //!< the mapped index file
+    std::int64_t sourceTime{0};  //!< modification time of the playback file
+    std::string configStr;
+    std::int32_t units{0};
+    std::size_t runSize{defaultRunSize};
+    std::vector<std::pair<std::string, std::string>> keys;
+    std::vector<std::string> sources;
+    /// entries built in memory, unused if the index was loaded from the sidecar
+    std::vector<PlaybackIndexEntry> pointEntries;
+    std::vector<PlaybackIndexEntry> messageEntries;
+    const PlaybackIndexEntry* pointData{nullptr};
+    const PlaybackIndexEntry* messageData{nullptr};
+    std::size_t pointEntryCount{0};
+    std::size_t messageEntryCount{0};
+};
+
+}  // namespace helics::apps
@@ -10,14 +10,17 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../common/JsonProcessingFunctions.hpp"
 #include "../core/helicsCLI11.hpp"
 #include "../core/helicsVersion.hpp"
+#include "PlaybackIndex.hpp"
 #include "PrecHelper.hpp"
 #include "gmlc/utilities/base64.h"
 #include "gmlc/utilities/stringOps.h"
 #include "gmlc/utilities/timeStringOps.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -54,6 +57,12 @@ static inline bool mComp(const MessageHolder& m1, const MessageHolder& m2)
 {
     return (m1.sendTime < m2.sendTime);
 }
+static inline Time entryTime(const PlaybackIndexEntry& entry)
+{
+    Time time;
+    time.setBaseTimeCode(entry.time);
+    return time;
+}
 
 Player::Player(std::vector<std::string> args): App("player_${#}", std::move(args))
 {
@@ -67,6 +76,10 @@ Player::Player(int argc, char* argv[]): App("player_${#}", argc, argv)
     initialSetup();
 }
 
+Player::Player(Player&& other_player) = default;
+Player& Player::operator=(Player&& fed) = default;
+Player::~Player() = default;
+
 void Player::processArgs()
 {
     auto app = generateParser();
@@ -121,6 +134,25 @@ std::unique_ptr<helicsCLI11App> Player::generateParser()
            false)
         ->take_last()
         ->ignore_underscore();
+    app->add_flag("--mapped",
+                  mappedPlayback,
+                  "memory map text input files and decode the points and messages as the "
+                  "simulation advances, the time index of each file is stored in a sidecar file "
+                  "(<file>.pidx) and reused on later runs")
+        ->ignore_underscore();
+    app->add_option("--lookahead",
+                    lookAhead,
+                    "the number of points and messages decoded at a time in mapped playback")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str()
+        ->ignore_underscore();
+    app->add_option("--index_run_size",
+                    indexRunSize,
+                    "the number of entries sorted in memory at a time when building the index "
+                    "of a file for mapped playback, larger indexes are merged from temporary files")
+        ->check(CLI::PositiveNumber)
+        ->capture_default_str()
+        ->ignore_underscore();
 
     return app;
 }
@@ -192,10 +224,96 @@ helics::Time Player::extractTime(std::string_view str, int lineNumber) const
     }
 }
 
+void Player::enableMappedPlayback(std::size_t lookAheadCount, std::size_t indexRunCount)
+{
+    mappedPlayback = true;
+    lookAhead = std::max<std::size_t>(lookAheadCount, 1);
+    indexRunSize = std::max<std::size_t>(indexRunCount, 1);
+}
+
+std::size_t Player::pointCount() const
+{
+    std::size_t count = windowed ? loadedPoints.size() : points.size();
+    for (const auto& input : mappedInputs) {
+        count += input.index->pointCount();
+    }
+    return count;
+}
+
+std::size_t Player::messageCount() const
+{
+    std::size_t count = windowed ? loadedMessages.size() : messages.size();
+    for (const auto& input : mappedInputs) {
+        count += input.index->messageCount();
+    }
+    return count;
+}
+
+bool Player::extractPointInfo(std::vector<std::string>& blk,
+                              ValueSetter& point,
+                              int lineNumber) const
+{
+    using namespace gmlc::utilities::stringOps;  // NOLINT
+    if (blk.size() < 2 || blk.size() > 4) {
+        std::cerr << "unknown publish format line " << lineNumber << '\n';
+        return false;
+    }
+    auto cloc = blk[0].find_last_of(':');
+    if (cloc == std::string::npos) {
+        if ((point.time = extractTime(trim(blk[0]), lineNumber)) == Time::minVal()) {
+            return false;
+        }
+    } else {
+        if ((point.time = extractTime(trim(blk[0]).substr(0, cloc), lineNumber)) ==
+            Time::minVal()) {
+            return false;
+        }
+        point.iteration = std::stoi(blk[0].substr(cloc + 1));
+    }
+    // an empty name uses the name of the previous point
+    if (blk.size() > 2) {
+        point.pubName = blk[1];
+    }
+    if (blk.size() == 4) {
+        point.type = blk[2];
+    }
+    return true;
+}
+
+bool Player::extractMessageInfo(std::vector<std::string>& blk,
+                                MessageHolder& message,
+                                int lineNumber) const
+{
+    switch (blk.size()) {
+        case 5:
+            if ((message.sendTime = extractTime(blk[1], lineNumber)) == Time::minVal()) {
+                return false;
+            }
+            message.mess.source = blk[2];
+            message.mess.dest = blk[3];
+            message.mess.time = message.sendTime;
+            return true;
+        case 6:
+            if ((message.sendTime = extractTime(blk[1], lineNumber)) == Time::minVal()) {
+                return false;
+            }
+            message.mess.source = blk[3];
+            message.mess.dest = blk[4];
+            return ((message.mess.time = extractTime(blk[2], lineNumber)) != Time::minVal());
+        default:
+            std::cerr << "unknown message format line " << lineNumber << '\n';
+            return false;
+    }
+}
+
 void Player::loadTextFile(const std::string& filename)
 {
     using namespace gmlc::utilities::stringOps;  // NOLINT
 
+    if (mappedPlayback) {
+        loadMappedFile(filename);
+        return;
+    }
     AppTextParser aparser(filename);
     auto cnts = aparser.preParseFile({'m', 'M'});
 
@@ -223,110 +341,92 @@ void Player::loadTextFile(const std::string& filename)
         trimString(blk[0]);
         if ((blk[0].front() == 'm') || (blk[0].front() == 'M')) {
             // deal with messages
-            switch (blk.size()) {
-                case 5:
-                    if ((messages[mIndex].sendTime = extractTime(blk[1], lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-
-                    messages[mIndex].mess.source = blk[2];
-                    messages[mIndex].mess.dest = blk[3];
-                    messages[mIndex].mess.time = messages[mIndex].sendTime;
-                    messages[mIndex].mess.data = decode(std::move(blk[4]));
-                    break;
-                case 6:
-                    if ((messages[mIndex].sendTime = extractTime(blk[1], lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-
-                    messages[mIndex].mess.source = blk[3];
-                    messages[mIndex].mess.dest = blk[4];
-                    if ((messages[mIndex].mess.time = extractTime(blk[2], lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-                    messages[mIndex].mess.data = decode(std::move(blk[5]));
-                    break;
-                default:
-                    std::cerr << "unknown message format line " << lineNumber << '\n';
-                    break;
+            if (!extractMessageInfo(blk, messages[mIndex], lineNumber)) {
+                continue;
             }
+            messages[mIndex].mess.data = decode(std::move(blk.back()));
             ++mIndex;
         } else {
-            if (blk.size() == 2) {
-                auto cloc = blk[0].find_last_of(':');
-                if (cloc == std::string::npos) {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]), lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-                } else {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]).substr(0, cloc),
-                                                           lineNumber)) == Time::minVal()) {
-                        continue;
-                    }
-                    points[pIndex].iteration = std::stoi(blk[0].substr(cloc + 1));
-                }
+            auto& point = points[pIndex];
+            if (!extractPointInfo(blk, point, lineNumber)) {
+                continue;
+            }
+            if (point.pubName.empty()) {
                 if (pIndex > 0) {
-                    points[pIndex].pubName = points[static_cast<size_t>(pIndex) - 1].pubName;
-                } else {
+                    point.pubName = points[static_cast<size_t>(pIndex) - 1].pubName;
+                } else if (blk.size() == 2) {
                     std::cerr
                         << "lines without publication name but follow one with a publication line "
                         << lineNumber << '\n';
                 }
-                points[pIndex].value = decode(std::move(blk[1]));
-                ++pIndex;
-            } else if (blk.size() == 3) {
-                auto cloc = blk[0].find_last_of(':');
-                if (cloc == std::string::npos) {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]), lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-                } else {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]).substr(0, cloc),
-                                                           lineNumber)) == Time::minVal()) {
-                        continue;
-                    }
-                    points[pIndex].iteration = std::stoi(blk[0].substr(cloc + 1));
-                }
-                if ((blk[1].empty()) && (pIndex > 0)) {
-                    points[pIndex].pubName = points[static_cast<size_t>(pIndex) - 1].pubName;
-                } else {
-                    points[pIndex].pubName = blk[1];
-                }
+            }
+            point.value = decode(std::move(blk.back()));
+            ++pIndex;
+        }
+    }
+}
 
-                points[pIndex].value = decode(std::move(blk[2]));
-                ++pIndex;
-            } else if (blk.size() == 4) {
-                auto cloc = blk[0].find_last_of(':');
-                if (cloc == std::string::npos) {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]), lineNumber)) ==
-                        Time::minVal()) {
-                        continue;
-                    }
-                } else {
-                    if ((points[pIndex].time = extractTime(trim(blk[0]).substr(0, cloc),
-                                                           lineNumber)) == Time::minVal()) {
-                        continue;
-                    }
-                    points[pIndex].iteration = std::stoi(blk[0].substr(cloc + 1));
-                }
-                if ((blk[1].empty()) && (pIndex > 0)) {
-                    points[pIndex].pubName = points[static_cast<size_t>(pIndex) - 1].pubName;
-                } else {
-                    points[pIndex].pubName = blk[1];
+void Player::loadMappedFile(const std::string& filename)
+{
+    using namespace gmlc::utilities::stringOps;  // NOLINT
+
+    auto index = std::make_unique<PlaybackIndex>();
+    if (!index->open(filename)) {
+        std::cerr << "unable to open file " << filename << '\n';
+        return;
+    }
+    bool indexed = index->loadIndex();
+    if (!indexed) {
+        index->scanConfiguration();
+    }
+    if (!index->configString().empty()) {
+        App::loadConfigString(index->configString());
+        auto app = generateParser();
+        std::istringstream sstr(index->configString());
+        app->parse_from_stream(sstr);
+    }
+    // the index stores parsed times so it is only valid for the same time units
+    if (!indexed || index->unitCode() != static_cast<std::int32_t>(units)) {
+        auto parser = [this](std::string_view line, int lineNumber, PlaybackLineInfo& info) {
+            auto blk = splitlineBracket(
+                std::string(line), ",\t ", default_bracket_chars, delimiter_compression::on);
+            trimString(blk[0]);
+            if (blk[0].empty()) {
+                return false;
+            }
+            if ((blk[0].front() == 'm') || (blk[0].front() == 'M')) {
+                MessageHolder message;
+                if (!extractMessageInfo(blk, message, lineNumber)) {
+                    return false;
                 }
-                points[pIndex].type = blk[2];
-                points[pIndex].value = decode(std::move(blk[3]));
-                ++pIndex;
-            } else {
-                std::cerr << "unknown publish format line " << lineNumber << '\n';
+                info.message = true;
+                info.time = message.sendTime;
+                info.key = std::move(message.mess.source);
+                return true;
             }
+            ValueSetter point;
+            if (!extractPointInfo(blk, point, lineNumber)) {
+                return false;
+            }
+            info.time = point.time;
+            info.iteration = point.iteration;
+            info.key = std::move(point.pubName);
+            info.type = std::move(point.type);
+            return true;
+        };
+        index->setRunSize(indexRunSize);
+        if (!index->buildIndex(parser, static_cast<std::int32_t>(units))) {
+            std::cerr << "unable to merge index file " << index->indexFileName()
+                      << ", building the index in memory\n";
+            index->setRunSize(std::numeric_limits<std::size_t>::max());
+            index->buildIndex(parser, static_cast<std::int32_t>(units));
+        }
+        if (!index->writeIndex()) {
+            std::cerr << "unable to write index file " << index->indexFileName() << '\n';
         }
     }
+    mappedInputs.emplace_back();
+    mappedInputs.back().index = std::move(index);
 }
 
 void Player::loadJsonFile(const std::string& jsonString, bool enableFederateInterfaceRegistration)
@@ -528,6 +628,19 @@ void Player::sortTags()
     for (auto& ms : messages) {
         epts.emplace(ms.mess.source);
     }
+    for (const auto& input : mappedInputs) {
+        for (const auto& key : input.index->getKeys()) {
+            auto fnd = tags.find(key.first);
+            if (fnd == tags.end()) {
+                tags.emplace(key.first, key.second);
+            } else if (fnd->second.empty()) {
+                fnd->second = key.second;
+            }
+        }
+        for (const auto& source : input.index->getSources()) {
+            epts.emplace(source);
+        }
+    }
 }
 
 /** helper function to generate the publications*/
@@ -560,6 +673,16 @@ void Player::cleanUpPointList()
     for (auto& ms : messages) {
         ms.index = eptids[ms.mess.source];
     }
+    for (auto& input : mappedInputs) {
+        input.pubIndex.clear();
+        for (const auto& key : input.index->getKeys()) {
+            input.pubIndex.push_back(pubids[key.first]);
+        }
+        input.eptIndex.clear();
+        for (const auto& source : input.index->getSources()) {
+            input.eptIndex.push_back(eptids[source]);
+        }
+    }
 }
 
 void Player::initialize()
@@ -570,39 +693,150 @@ void Player::initialize()
         generatePublications();
         generateEndpoints();
         cleanUpPointList();
+        if (!mappedInputs.empty()) {
+            // the points and messages are now decoded in windows merged with the mapped files
+            loadedPoints = std::move(points);
+            loadedMessages = std::move(messages);
+            windowed = true;
+            loadPointWindow();
+            loadMessageWindow();
+        }
         fed->enterInitializingMode();
     }
 }
 
-void Player::sendInformation(Time sendTime, int iteration)
+bool Player::hasPoint()
 {
-    if (isValidIndex(pointIndex, points)) {
-        while (points[pointIndex].time < sendTime) {
-            publications[points[pointIndex].index].publish(points[pointIndex].value);
-            ++pointIndex;
-            if (pointIndex >= points.size()) {
-                break;
+    if (pointIndex < points.size()) {
+        return true;
+    }
+    return windowed && loadPointWindow();
+}
+
+bool Player::hasMessage()
+{
+    if (messageIndex < messages.size()) {
+        return true;
+    }
+    return windowed && loadMessageWindow();
+}
+
+bool Player::loadPointWindow()
+{
+    using namespace gmlc::utilities::stringOps;  // NOLINT
+    points.clear();
+    pointIndex = 0;
+    while (points.size() < lookAhead) {
+        MappedInput* next{nullptr};
+        const PlaybackIndexEntry* nextEntry{nullptr};
+        for (auto& input : mappedInputs) {
+            if (input.nextPoint >= input.index->pointCount()) {
+                continue;
+            }
+            const auto& entry = input.index->point(input.nextPoint);
+            if (nextEntry == nullptr || entry.time < nextEntry->time ||
+                (entry.time == nextEntry->time && entry.iteration < nextEntry->iteration)) {
+                next = &input;
+                nextEntry = &entry;
             }
         }
-        if (isValidIndex(pointIndex, points)) {
-            while ((points[pointIndex].time == sendTime) &&
-                   (points[pointIndex].iteration == iteration)) {
-                publications[points[pointIndex].index].publish(points[pointIndex].value);
-                ++pointIndex;
-                if (pointIndex >= points.size()) {
-                    break;
-                }
+        if (loadedPointIndex < loadedPoints.size()) {
+            auto& loaded = loadedPoints[loadedPointIndex];
+            if (nextEntry == nullptr || loaded.time < entryTime(*nextEntry) ||
+                (loaded.time == entryTime(*nextEntry) &&
+                 loaded.iteration <= nextEntry->iteration)) {
+                points.push_back(std::move(loaded));
+                ++loadedPointIndex;
+                continue;
             }
         }
+        if (next == nullptr) {
+            break;
+        }
+        ++next->nextPoint;
+        if (nextEntry->key >= next->pubIndex.size()) {
+            continue;
+        }
+        auto blk = splitlineBracket(std::string(next->index->line(*nextEntry)),
+                                    ",\t ",
+                                    default_bracket_chars,
+                                    delimiter_compression::on);
+        if (blk.size() < 2) {
+            continue;
+        }
+        points.emplace_back();
+        auto& point = points.back();
+        point.time = entryTime(*nextEntry);
+        point.iteration = nextEntry->iteration;
+        point.index = next->pubIndex[nextEntry->key];
+        point.pubName = next->index->getKeys()[nextEntry->key].first;
+        point.value = decode(std::move(blk.back()));
     }
-    if (isValidIndex(messageIndex, messages)) {
-        while (messages[messageIndex].sendTime <= sendTime) {
-            endpoints[messages[messageIndex].index].send(messages[messageIndex].mess);
-            ++messageIndex;
-            if (messageIndex >= messages.size()) {
-                break;
+    return !points.empty();
+}
+
+bool Player::loadMessageWindow()
+{
+    using namespace gmlc::utilities::stringOps;  // NOLINT
+    messages.clear();
+    messageIndex = 0;
+    while (messages.size() < lookAhead) {
+        MappedInput* next{nullptr};
+        const PlaybackIndexEntry* nextEntry{nullptr};
+        for (auto& input : mappedInputs) {
+            if (input.nextMessage >= input.index->messageCount()) {
+                continue;
+            }
+            const auto& entry = input.index->message(input.nextMessage);
+            if (nextEntry == nullptr || entry.time < nextEntry->time) {
+                next = &input;
+                nextEntry = &entry;
+            }
+        }
+        if (loadedMessageIndex < loadedMessages.size()) {
+            auto& loaded = loadedMessages[loadedMessageIndex];
+            if (nextEntry == nullptr || loaded.sendTime <= entryTime(*nextEntry)) {
+                messages.push_back(std::move(loaded));
+                ++loadedMessageIndex;
+                continue;
             }
         }
+        if (next == nullptr) {
+            break;
+        }
+        ++next->nextMessage;
+        if (nextEntry->key >= next->eptIndex.size()) {
+            continue;
+        }
+        auto blk = splitlineBracket(std::string(next->index->line(*nextEntry)),
+                                    ",\t ",
+                                    default_bracket_chars,
+                                    delimiter_compression::on);
+        MessageHolder message;
+        if (!extractMessageInfo(blk, message, 0)) {
+            continue;
+        }
+        message.mess.data = decode(std::move(blk.back()));
+        message.index = next->eptIndex[nextEntry->key];
+        messages.push_back(std::move(message));
+    }
+    return !messages.empty();
+}
+
+void Player::sendInformation(Time sendTime, int iteration)
+{
+    while (hasPoint() && points[pointIndex].time < sendTime) {
+        publications[points[pointIndex].index].publish(points[pointIndex].value);
+        ++pointIndex;
+    }
+    while (hasPoint() && (points[pointIndex].time == sendTime) &&
+           (points[pointIndex].iteration == iteration)) {
+        publications[points[pointIndex].index].publish(points[pointIndex].value);
+        ++pointIndex;
+    }
+    while (hasMessage() && messages[messageIndex].sendTime <= sendTime) {
+        endpoints[messages[messageIndex].index].send(messages[messageIndex].mess);
+        ++messageIndex;
     }
 }
 
@@ -620,21 +854,11 @@ void Player::runTo(Time stopTime_input)
         sendInformation(timeZero);
     } else {
         auto ctime = fed->getCurrentTime();
-        if (isValidIndex(pointIndex, points)) {
-            while (points[pointIndex].time <= ctime) {
-                ++pointIndex;
-                if (pointIndex >= points.size()) {
-                    break;
-                }
-            }
+        while (hasPoint() && points[pointIndex].time <= ctime) {
+            ++pointIndex;
         }
-        if (isValidIndex(messageIndex, messages)) {
-            while (messages[messageIndex].sendTime <= ctime) {
-                ++messageIndex;
-                if (messageIndex >= messages.size()) {
-                    break;
-                }
-            }
+        while (hasMessage() && messages[messageIndex].sendTime <= ctime) {
+            ++messageIndex;
         }
     }
 
@@ -644,11 +868,11 @@ void Player::runTo(Time stopTime_input)
     int currentIteration{0};
     while (moreToSend) {
         auto nextSendTime = Time::maxVal();
-        if (isValidIndex(pointIndex, points)) {
+        if (hasPoint()) {
             nextSendTime = std::min(nextSendTime, points[pointIndex].time);
             nextIteration = points[pointIndex].iteration;
         }
-        if (isValidIndex(messageIndex, messages)) {
+        if (hasMessage()) {
             nextSendTime = std::min(nextSendTime, messages[messageIndex].sendTime);
             nextIteration = 0;
         }
@@ -35,6 +35,8 @@ namespace apps {
         Message mess;
     };
 
+    class PlaybackIndex;
+
     /** class implementing a Player object, which is capable of reading a file and generating
 interfaces and sending signals at the appropriate times
 @details  the Player class is not thread-safe,  don't try to use it from multiple threads without
@@ -81,9 +83,11 @@ external protection, that will result in undefined behavior
         Player(std::string_view appName, const std::string& configString);
 
         /** move construction*/
-        Player(Player&& other_player) = default;
+        Player(Player&& other_player);
         /** move assignment*/
-        Player& operator=(Player&& fed) = default;
+        Player& operator=(Player&& fed);
+        /** destructor*/
+        ~Player();
 
         /** initialize the Player federate
     @details generate all the publications and organize the points, the final publication count will
@@ -184,17 +188,32 @@ external protection, that will result in undefined behavior
                         std::string_view dest,
                         std::string_view payload);
 
+        /** use memory mapped playback for text files loaded after this call
+    @details the files are indexed by time and the points and messages are decoded as the
+    simulation advances instead of loading the entire file, the index is stored in a sidecar file
+    (the file name with .pidx appended) and reused on later runs if the file is unchanged
+    @param lookAheadCount the number of points and messages decoded at a time
+    @param indexRunCount the number of index entries sorted in memory at a time when building the
+    index, larger indexes are sorted in runs merged from temporary files
+    */
+        void enableMappedPlayback(std::size_t lookAheadCount = 4096,
+                                  std::size_t indexRunCount = 1048576);
+
         /** get the number of points loaded*/
-        auto pointCount() const { return points.size(); }
+        std::size_t pointCount() const;
         /** get the number of messages loaded*/
-        auto messageCount() const { return messages.size(); }
+        std::size_t messageCount() const;
         /** get the number of publications */
         auto publicationCount() const { return publications.size(); }
         /** get the number of endpoints*/
         auto endpointCount() const { return endpoints.size(); }
-        /** get the point from an index*/
+        /** get the point from an index
+    @details with mapped playback the index is into the currently decoded points after
+    initialization*/
         const auto& getPoint(int index) const { return points[index]; }
-        /** get the messages from an index*/
+        /** get the messages from an index
+    @details with mapped playback the index is into the currently decoded messages after
+    initialization*/
         const auto& getMessage(int index) const { return messages[index]; }
 
       private:
@@ -211,6 +230,17 @@ external protection, that will result in undefined behavior
                                   bool enableFederateInterfaceRegistration) override;
         /** load a text file*/
         virtual void loadTextFile(const std::string& filename) override;
+        /** map and index a text file for incremental playback*/
+        void loadMappedFile(const std::string& filename);
+        /** extract the time, iteration, key, and type of a value line, the value is not decoded
+    @return false if the line is not a valid value line*/
+        bool extractPointInfo(std::vector<std::string>& blk, ValueSetter& point, int lineNumber)
+            const;
+        /** extract the times, source, and destination of a message line, the data is not decoded
+    @return false if the line is not a valid message line*/
+        bool extractMessageInfo(std::vector<std::string>& blk,
+                                MessageHolder& message,
+                                int lineNumber) const;
         /** helper function to sort through the tags*/
         void sortTags();
         /** helper function to generate the publications*/
@@ -222,6 +252,17 @@ external protection, that will result in undefined behavior
 
         /** send all points and messages up to the specified time*/
         void sendInformation(Time sendTime, int iteration = 0);
+        /** check if there is a point at pointIndex, decoding more points from mapped files if
+        needed*/
+        bool hasPoint();
+        /** check if there is a message at messageIndex, decoding more messages from mapped files
+        if needed*/
+        bool hasMessage();
+        /** decode the next set of points from the mapped files merged with the loaded points*/
+        bool loadPointWindow();
+        /** decode the next set of messages from the mapped files merged with the loaded
+        messages*/
+        bool loadMessageWindow();
 
         /** extract a time from the string based on Player parameters
     @param str the string containing the time
@@ -242,6 +283,26 @@ external protection, that will result in undefined behavior
             helics::DataType::HELICS_STRING;  //!< the default data type unless otherwise specified
         size_t pointIndex = 0;  //!< the current point index
         size_t messageIndex = 0;  //!< the current message index
+
+        /** a text file used for mapped playback*/
+        struct MappedInput {
+            std::unique_ptr<PlaybackIndex> index;
+            std::vector<int> pubIndex;  //!< the publication index of each key in the file
+            std::vector<int> eptIndex;  //!< the endpoint index of each message source in the file
+            std::size_t nextPoint{0};  //!< the next point entry to decode
+            std::size_t nextMessage{0};  //!< the next message entry to decode
+        };
+        std::vector<MappedInput> mappedInputs;  //!< the files used for mapped playback
+        bool mappedPlayback{false};  //!< load text files for mapped playback
+        bool windowed{false};  //!< the points and messages are decoded windows of the inputs
+        std::size_t lookAhead{4096};  //!< the number of points and messages decoded at a time
+        /// the number of index entries sorted in memory at a time when building an index
+        std::size_t indexRunSize{1048576};
+        /// points and messages loaded in memory, merged with the mapped files during playback
+        std::vector<ValueSetter> loadedPoints;
+        std::vector<MessageHolder> loadedMessages;
+        std::size_t loadedPointIndex{0};
+        std::size_t loadedMessageIndex{0};
         time_units units = time_units::sec;
         double timeMultiplier =
             1.0;  //!< specify the time multiplier for different time specifications
@@ -13,7 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../common/JsonProcessingFunctions.hpp"
 #include "../core/helicsCLI11.hpp"
 #include "PrecHelper.hpp"
-#include "gmlc/utilities/base64.h"
+#include "RecorderStream.hpp"
 #include "gmlc/utilities/stringOps.h"
 
 #include <algorithm>
@@ -33,15 +33,6 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <utility>
 #include <vector>
 
-/** encode the string in base64 if needed otherwise just return the string*/
-static std::string encode(std::string_view str2encode)
-{
-    return std::string("b64[") +
-        gmlc::utilities::base64_encode(reinterpret_cast<const unsigned char*>(str2encode.data()),
-                                       str2encode.size()) +
-        ']';
-}
-
 namespace helics::apps {
 Recorder::Recorder(std::string_view appName, FederateInfo& fedInfo): App(appName, fedInfo)
 {
@@ -91,6 +82,9 @@ Recorder::Recorder(std::string_view appName, const std::string& jsonString):
     initialSetup();
 }
 
+Recorder::Recorder(Recorder&& other_recorder) = default;
+Recorder& Recorder::operator=(Recorder&& other_recorder) = default;
+
 Recorder::~Recorder()
 {
     try {
@@ -247,48 +241,19 @@ void Recorder::writeJsonFile(const std::string& filename)
     if (!points.empty()) {
         doc["points"] = nlohmann::json(nlohmann::json::array());
         for (auto& point : points) {
-            nlohmann::json pointData;
-            pointData["key"] = subscriptions[point.index].getTarget();
-            pointData["value"] = point.value;
-            pointData["time"] = static_cast<double>(point.time);
-            if (point.iteration > 0) {
-                pointData["iteration"] = point.iteration;
-            }
-            if (point.first) {
-                pointData["type"] = subscriptions[point.index].getPublicationType();
-            }
-            doc["points"].push_back(pointData);
+            const auto& type = subscriptions[point.index].getPublicationType();
+            doc["points"].push_back(generateJsonPoint(point.time,
+                                                      point.iteration,
+                                                      subscriptions[point.index].getTarget(),
+                                                      point.first ? &type : nullptr,
+                                                      point.value));
         }
     }
 
     if (!messages.empty()) {
         doc["messages"] = nlohmann::json(nlohmann::json::array());
         for (auto& mess : messages) {
-            nlohmann::json message;
-            message["time"] = static_cast<double>(mess->time);
-            message["src"] = mess->source;
-            if ((!mess->original_source.empty()) && (mess->original_source != mess->source)) {
-                message["original_source"] = mess->original_source;
-            }
-            if ((mess->dest.size() < 7) ||
-                (mess->dest.compare(mess->dest.size() - 6, 6, "cloneE") != 0)) {
-                message["dest"] = mess->dest;
-                message["orig_dest"] = mess->original_dest;
-            } else {
-                message["dest"] = mess->original_dest;
-            }
-            if (isBinaryData(mess->data)) {
-                if (isEscapableData(mess->data)) {
-                    message["message"] = std::string(mess->data.to_string());
-                } else {
-                    message["encoding"] = "base64";
-                    message["message"] = encode(std::string(mess->data.to_string()));
-                }
-
-            } else {
-                message["message"] = std::string(mess->data.to_string());
-            }
-            doc["messages"].push_back(message);
+            doc["messages"].push_back(generateJsonMessage(*mess));
         }
     }
 
@@ -303,50 +268,31 @@ void Recorder::writeTextFile(const std::string& filename)
         outFile << "#time \ttag\t type*\t value\n";
     }
     for (auto& point : points) {
-        if (point.first) {
-            outFile << static_cast<double>(point.time) << "\t\t"
-                    << subscriptions[point.index].getTarget() << '\t'
-                    << subscriptions[point.index].getPublicationType() << '\t'
-                    << generateJsonQuotedString(point.value) << '\n';
-        } else {
-            if (point.iteration > 0) {
-                outFile << static_cast<double>(point.time) << ':' << point.iteration << "\t\t"
-                        << subscriptions[point.index].getTarget() << '\t'
-                        << generateJsonQuotedString(point.value) << '\n';
-            } else {
-                outFile << static_cast<double>(point.time) << "\t\t"
-                        << subscriptions[point.index].getTarget() << '\t'
-                        << generateJsonQuotedString(point.value) << '\n';
-            }
-        }
+        const auto& type = subscriptions[point.index].getPublicationType();
+        writeTextPoint(outFile,
+                       point.time,
+                       point.iteration,
+                       subscriptions[point.index].getTarget(),
+                       point.first ? &type : nullptr,
+                       point.value);
     }
     if (!messages.empty()) {
         outFile << "# m\t time \tsource\t dest\t message\n";
     }
     for (auto& mess : messages) {
-        outFile << "m\t" << static_cast<double>(mess->time) << '\t' << mess->source << '\t';
-        if ((mess->dest.size() < 7) ||
-            (mess->dest.compare(mess->dest.size() - 6, 6, "cloneE") != 0)) {
-            outFile << mess->dest;
-        } else {
-            outFile << mess->original_dest;
-        }
-        if (isBinaryData(mess->data)) {
-            if (isEscapableData(mess->data)) {
-                outFile << "\t" << generateJsonQuotedString(std::string(mess->data.to_string()))
-                        << "\n";
-            } else {
-                outFile << "\t\"" << encode(mess->data.to_string()) << "\"\n";
-            }
-
-        } else {
-            outFile << "\t\"" << mess->data.to_string() << "\"\n";
-        }
+        writeTextMessage(outFile, *mess);
     }
 }
 
 void Recorder::initialize()
 {
+    if (streaming && !streamWriter) {
+        streamWriter = std::make_unique<CaptureStreamWriter>(outFileName,
+                                                             streamMemoryLimit,
+                                                             streamFlushInterval.to_ms(),
+                                                             rotateSize,
+                                                             rotatePeriod);
+    }
     fed->enterInitializingModeIterative();
     generateInterfaces();
 
@@ -394,9 +340,20 @@ void Recorder::captureForCurrentTime(Time currentTime, int iteration)
         if (sub.isUpdated()) {
             auto val = sub.getValue<std::string>();
             const int subId = subids[sub.getHandle()];
-            points.emplace_back(currentTime, subId, val);
-            if (iteration > 0) {
-                points.back().iteration = iteration;
+            if (streamWriter) {
+                if (vStat[subId].cnt == 0) {
+                    streamWriter->defineKey(subId, sub.getTarget(), sub.getPublicationType());
+                }
+                streamWriter->addPoint(currentTime, subId, static_cast<int16_t>(iteration), val);
+                ++streamedPoints;
+            } else {
+                points.emplace_back(currentTime, subId, val);
+                if (iteration > 0) {
+                    points.back().iteration = iteration;
+                }
+                if (vStat[subId].cnt == 0) {
+                    points.back().first = true;
+                }
             }
             if (verbose) {
                 std::string valstr;
@@ -429,9 +386,6 @@ void Recorder::captureForCurrentTime(Time currentTime, int iteration)
                 }
                 spdlog::info(valstr);
             }
-            if (vStat[subId].cnt == 0) {
-                points.back().first = true;
-            }
             ++vStat[subId].cnt;
             vStat[subId].lastVal = val;
             vStat[subId].time = -1.0;
@@ -458,15 +412,28 @@ void Recorder::captureForCurrentTime(Time currentTime, int iteration)
                 }
                 spdlog::info(messstr);
             }
-            messages.push_back(std::move(mess));
+            captureMessage(std::move(mess));
         }
     }
     // get the clone endpoints
     if (cloneEndpoint) {
         while (cloneEndpoint->hasMessage()) {
-            messages.push_back(cloneEndpoint->getMessage());
+            captureMessage(cloneEndpoint->getMessage());
         }
     }
+    if (streamWriter) {
+        streamWriter->commit();
+    }
+}
+
+void Recorder::captureMessage(std::unique_ptr<Message> message)
+{
+    if (streamWriter) {
+        streamWriter->addMessage(std::move(message));
+        ++streamedMessages;
+    } else {
+        messages.push_back(std::move(message));
+    }
 }
 
 /** run the Player until the specified time*/
@@ -534,6 +501,14 @@ void Recorder::runTo(Time runToTime)
         std::cerr << "error generate on run\n";
     }
 }
+void Recorder::finalize()
+{
+    App::finalize();
+    if (streamWriter) {
+        streamWriter->close();
+    }
+}
+
 /** add a subscription to record*/
 void Recorder::addSubscription(std::string_view key)
 {
@@ -604,6 +579,11 @@ std::unique_ptr<Message> Recorder::getMessage(std::size_t index) const
 /** save the data to a file*/
 void Recorder::saveFile(const std::string& filename)
 {
+    if (streamWriter) {
+        // the data has already been written to the stream files
+        streamWriter->close();
+        return;
+    }
     auto lastP = filename.find_last_of('.');
     auto ext = (lastP != std::string::npos) ? filename.substr(lastP) : std::string{};
     if ((ext == ".json") || (ext == ".JSON")) {
@@ -613,6 +593,16 @@ void Recorder::saveFile(const std::string& filename)
     }
 }
 
+void Recorder::enableStreaming(const std::string& filename,
+                               std::uint64_t maxFileSize,
+                               Time rotationPeriod)
+{
+    streaming = true;
+    outFileName = filename;
+    rotateSize = maxFileSize;
+    rotatePeriod = rotationPeriod;
+}
+
 std::shared_ptr<helicsCLI11App> Recorder::buildArgParserApp()
 {
     using gmlc::utilities::stringOps::removeQuotes;
@@ -633,6 +623,42 @@ std::shared_ptr<helicsCLI11App> Recorder::buildArgParserApp()
     app->add_option("--output,-o", outFileName, "the output file for recording the data")
         ->capture_default_str();
 
+    auto* stream_group = app->add_option_group(
+        "streaming", "Options related to writing the captured data during the simulation");
+    stream_group->add_flag(
+        "--stream",
+        streaming,
+        "write the captured data to the output file during the simulation instead of holding it "
+        "in memory, use a .hcap extension on the output file for the binary capture format");
+    stream_group
+        ->add_option("--memory_limit",
+                     streamMemoryLimit,
+                     "the approximate maximum memory used to buffer captured data in streaming "
+                     "mode (can also be entered with units like '100MB')")
+        ->transform(CLI::AsSizeValue(false))
+        ->ignore_underscore()
+        ->capture_default_str();
+    stream_group
+        ->add_option("--flush_interval",
+                     streamFlushInterval,
+                     "the maximum time captured data is held in memory before it is written in "
+                     "streaming mode; default unit is in ms (can also be entered as a time like "
+                     "'10s' or '45ms')")
+        ->ignore_underscore();
+    stream_group
+        ->add_option("--rotate_size",
+                     rotateSize,
+                     "start a new output file when the file exceeds the given size in streaming "
+                     "mode (can also be entered with units like '1GB')")
+        ->transform(CLI::AsSizeValue(false))
+        ->ignore_underscore();
+    stream_group
+        ->add_option("--rotate_time",
+                     rotatePeriod,
+                     "start a new output file for each span of simulation time in streaming mode "
+                     "(can also be entered as a time like '1h')")
+        ->ignore_underscore();
+
     auto* clone_group =
         app->add_option_group("cloning",
                               "Options related to endpoint cloning operations and specifications");
@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../application_api/Subscriptions.hpp"
 #include "helicsApp.hpp"
 
+#include <cstdint>
 #include <deque>
 #include <map>
 #include <memory>
@@ -23,6 +24,8 @@ namespace helics {
 class CloningFilter;
 
 namespace apps {
+    class CaptureStreamWriter;
+
     /** class designed to capture data points from a set of subscriptions or endpoints*/
     class HELICS_CXX_EXPORT Recorder: public App {
       public:
@@ -60,13 +63,15 @@ namespace apps {
     */
         Recorder(std::string_view name, const std::string& jsonString);
         /** move construction*/
-        Recorder(Recorder&& other_recorder) = default;
+        Recorder(Recorder&& other_recorder);
         /** move assignment*/
-        Recorder& operator=(Recorder&& other_recorder) = default;
+        Recorder& operator=(Recorder&& other_recorder);
         /** destructor*/
         ~Recorder();
         /** run the Player until the specified time*/
         virtual void runTo(Time runToTime) override;
+        /** finalize the Recorder and complete any streamed output files*/
+        virtual void finalize() override;
         /** add a subscription to capture*/
         void addSubscription(std::string_view key);
         /** add an endpoint*/
@@ -79,12 +84,26 @@ namespace apps {
     @param captureDesc describes a federate to capture all the interfaces for
     */
         void addCapture(std::string_view captureDesc);
-        /** save the data to a file*/
+        /** save the data to a file
+        @details in streaming mode the data has already been written so this completes the
+        streamed output files*/
         void saveFile(const std::string& filename);
+        /** write the captured data to files during the simulation instead of holding it in memory
+        until the end
+        @details must be called before the Recorder is initialized, captured values and messages
+        are not available through getValue and getMessage in streaming mode
+        @param filename the output file, the extension selects the format (.txt, .json, or .hcap
+        for the binary capture format)
+        @param maxFileSize start a new file when the file exceeds this size in bytes (0 to disable)
+        @param rotationPeriod start a new file for each span of simulation time (0 to disable)
+        */
+        void enableStreaming(const std::string& filename,
+                             std::uint64_t maxFileSize = 0,
+                             Time rotationPeriod = timeZero);
         /** get the number of captured points*/
-        auto pointCount() const { return points.size(); }
+        std::size_t pointCount() const { return points.size() + streamedPoints; }
         /** get the number of captured messages*/
-        auto messageCount() const { return messages.size(); }
+        std::size_t messageCount() const { return messages.size() + streamedMessages; }
         /** get a string with the value of point index
     @param index the number of the point to retrieve
     @return a tuple with Time as the first element the tag as the 2nd element and the value as the
@@ -115,6 +134,8 @@ namespace apps {
         virtual void initialize() override;
         void generateInterfaces();
         void captureForCurrentTime(Time currentTime, int iteration = 0);
+        /** store a captured message or send it to the stream writer*/
+        void captureMessage(std::unique_ptr<Message> message);
         void loadCaptureInterfaces();
 
         /** build the command line argument processing application*/
@@ -165,6 +186,14 @@ namespace apps {
         std::vector<ValueStats> vStat;  //!< storage for statistics capture
         std::vector<std::string> captureInterfaces;  //!< storage for the interfaces to capture
         std::string mapfile;  //!< file name for the on-line file updater
+        bool streaming{false};  //!< write the captured data during the simulation
+        std::size_t streamMemoryLimit{64 * 1024 * 1024};  //!< memory limit for streaming mode
+        Time streamFlushInterval{1.0};  //!< max wall clock time data is held before writing
+        std::uint64_t rotateSize{0};  //!< size to start a new file in streaming mode
+        Time rotatePeriod{timeZero};  //!< simulation time span of each file in streaming mode
+        std::unique_ptr<CaptureStreamWriter> streamWriter;  //!< writer for streaming mode
+        std::size_t streamedPoints{0};  //!< the number of points written by the stream writer
+        std::size_t streamedMessages{0};  //!< the number of messages written by the stream writer
     };
 
 }  // namespace apps
@@ -0,0 +1,989 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "RecorderStream.hpp"
+
+#include "../common/JsonGeneration.hpp"
+#include "../core/core-exceptions.hpp"
+#include "PrecHelper.hpp"
+#include "gmlc/utilities/base64.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace helics::apps {
+
+/// the first bytes of a binary capture file
+static constexpr std::string_view captureFileMagic{"HELICSCP"};
+static constexpr std::uint32_t captureFileVersion{1};
+/// the last bytes of a binary capture file with an index
+static constexpr std::string_view captureIndexMagic{"HCPINDEX"};
+static constexpr std::uint32_t chunkMarker{0x4B484352U};
+static constexpr std::uint32_t indexMarker{0x58444E49U};
+static constexpr std::size_t captureHeaderSize{captureFileMagic.size() + sizeof(std::uint32_t)};
+static constexpr std::size_t captureTrailerSize{sizeof(std::uint64_t) + captureIndexMagic.size()};
+static constexpr std::size_t chunkHeaderSize{sizeof(std::uint32_t) + sizeof(std::uint64_t)};
+static constexpr std::uint8_t valueKeyKind{0};
+static constexpr std::uint8_t endpointKeyKind{1};
+/// the maximum number of values or messages written between checks of the rotation size
+static constexpr std::size_t maxRotationRecords{256};
+/// key used in binary files for an empty endpoint name
+static constexpr std::uint32_t noKey{0xFFFFFFFFU};
+
+/** encode the string in base64 if needed otherwise just return the string*/
+static std::string encode(std::string_view str2encode)
+{
+    return std::string("b64[") +
+        gmlc::utilities::base64_encode(reinterpret_cast<const unsigned char*>(str2encode.data()),
+                                       str2encode.size()) +
+        ']';
+}
+
+/** append an integer in little endian byte order*/
+template<typename T>
+static void appendValue(std::string& buffer, T value)
+{
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (std::size_t ii = 0; ii < sizeof(T); ++ii) {
+        buffer.push_back(static_cast<char>(bits & 0xFFU));
+        if constexpr (sizeof(T) > 1) {
+            bits >>= 8U;
+        }
+    }
+}
+
+static void appendString(std::string& buffer, std::string_view str)
+{
+    appendValue(buffer, static_cast<std::uint32_t>(str.size()));
+    buffer.append(str);
+}
+
+namespace {
+    /** helper for reading little endian values from a byte buffer*/
+    class ByteReader {
+      public:
+        ByteReader(const char* data, std::size_t size): buffer(data), bufferSize(size) {}
+        template<typename T>
+        T read()
+        {
+            if (!good || bufferSize - position < sizeof(T)) {
+                good = false;
+                return T{};
+            }
+            std::make_unsigned_t<T> bits{0};
+            for (std::size_t ii = 0; ii < sizeof(T); ++ii) {
+                bits |= static_cast<std::make_unsigned_t<T>>(
+                            static_cast<unsigned char>(buffer[position + ii]))
+                    << (8U * ii);
+            }
+            position += sizeof(T);
+            return static_cast<T>(bits);
+        }
+        std::string_view readBytes(std::size_t count)
+        {
+            if (!good || bufferSize - position < count) {
+                good = false;
+                return {};
+            }
+            std::string_view result(buffer + position, count);
+            position += count;
+            return result;
+        }
+        std::string_view readString() { return readBytes(read<std::uint32_t>()); }
+        template<typename T>
+        std::vector<T> readColumn(std::size_t count)
+        {
+            std::vector<T> column;
+            if (!good || (bufferSize - position) / sizeof(T) < count) {
+                good = false;
+                return column;
+            }
+            column.reserve(count);
+            for (std::size_t ii = 0; ii < count; ++ii) {
+                column.push_back(read<T>());
+            }
+            return column;
+        }
+        bool isGood() const { return good; }
+
+      private:
+        const char* buffer;
+        std::size_t bufferSize;
+        std::size_t position{0};
+        bool good{true};
+    };
+}  // namespace
+
+static Time timeFromCode(std::int64_t code)
+{
+    Time result;
+    result.setBaseTimeCode(code);
+    return result;
+}
+
+CaptureFormat captureFormatFromFileName(std::string_view filename)
+{
+    auto lastP = filename.find_last_of('.');
+    auto ext = (lastP != std::string_view::npos) ? filename.substr(lastP) : std::string_view{};
+    if ((ext == ".json") || (ext == ".JSON")) {
+        return CaptureFormat::JSON;
+    }
+    if ((ext == ".hcap") || (ext == ".HCAP")) {
+        return CaptureFormat::BINARY;
+    }
+    return CaptureFormat::TEXT;
+}
+
+const std::string& recordedDestination(const Message& message)
+{
+    if ((message.dest.size() < 7) ||
+        (message.dest.compare(message.dest.size() - 6, 6, "cloneE") != 0)) {
+        return message.dest;
+    }
+    return message.original_dest;
+}
+
+void writeTextPoint(std::ostream& out,
+                    Time time,
+                    int iteration,
+                    std::string_view key,
+                    const std::string* type,
+                    const std::string& value)
+{
+    if (type != nullptr) {
+        out << static_cast<double>(time) << "\t\t" << key << '\t' << *type << '\t'
+            << generateJsonQuotedString(value) << '\n';
+    } else if (iteration > 0) {
+        out << static_cast<double>(time) << ':' << iteration << "\t\t" << key << '\t'
+            << generateJsonQuotedString(value) << '\n';
+    } else {
+        out << static_cast<double>(time) << "\t\t" << key << '\t'
+            << generateJsonQuotedString(value) << '\n';
+    }
+}
+
+void writeTextMessage(std::ostream& out, Message& message)
+{
+    out << "m\t" << static_cast<double>(message.time) << '\t' << message.source << '\t'
+        << recordedDestination(message);
+    if (isBinaryData(message.data)) {
+        if (isEscapableData(message.data)) {
+            out << "\t" << generateJsonQuotedString(std::string(message.data.to_string())) << "\n";
+        } else {
+            out << "\t\"" << encode(message.data.to_string()) << "\"\n";
+        }
+
+    } else {
+        out << "\t\"" << message.data.to_string() << "\"\n";
+    }
+}
+
+nlohmann::json generateJsonPoint(Time time,
+                                 int iteration,
+                                 std::string_view key,
+                                 const std::string* type,
+                                 const std::string& value)
+{
+    nlohmann::json pointData;
+    pointData["key"] = key;
+    pointData["value"] = value;
+    pointData["time"] = static_cast<double>(time);
+    if (iteration > 0) {
+        pointData["iteration"] = iteration;
+    }
+    if (type != nullptr) {
+        pointData["type"] = *type;
+    }
+    return pointData;
+}
+
+nlohmann::json generateJsonMessage(Message& message)
+{
+    nlohmann::json mess;
+    mess["time"] = static_cast<double>(message.time);
+    mess["src"] = message.source;
+    if ((!message.original_source.empty()) && (message.original_source != message.source)) {
+        mess["original_source"] = message.original_source;
+    }
+    const auto& dest = recordedDestination(message);
+    mess["dest"] = dest;
+    if (&dest == &message.dest) {
+        mess["orig_dest"] = message.original_dest;
+    }
+    if (isBinaryData(message.data)) {
+        if (isEscapableData(message.data)) {
+            mess["message"] = std::string(message.data.to_string());
+        } else {
+            mess["encoding"] = "base64";
+            mess["message"] = encode(std::string(message.data.to_string()));
+        }
+    } else {
+        mess["message"] = std::string(message.data.to_string());
+    }
+    return mess;
+}
+
+CaptureStreamWriter::CaptureStreamWriter(std::string filename,
+                                         std::size_t maxMemory,
+                                         std::chrono::milliseconds flushPeriod,
+                                         std::uint64_t maxFileSize,
+                                         Time rotationPeriod):
+    fileName(std::move(filename)), format(captureFormatFromFileName(fileName)),
+    memoryLimit(std::max<std::size_t>(maxMemory, 1024)),
+    flushInterval(std::max(flushPeriod, std::chrono::milliseconds(1))), rotateSize(maxFileSize),
+    rotatePeriod(rotationPeriod)
+{
+    if (rotatePeriod > timeZero) {
+        nextRotationTime = rotatePeriod;
+    }
+    if (!openSegment()) {
+        throw(InvalidParameter("unable to open capture file " + fileName));
+    }
+    writerThread = std::thread(&CaptureStreamWriter::writerLoop, this);
+}
+
+CaptureStreamWriter::~CaptureStreamWriter()
+{
+    try {
+        close();
+    }
+    catch (...) {
+        // destructor should not throw
+        ;
+    }
+}
+
+void CaptureStreamWriter::defineKey(int index, std::string_view key, std::string_view type)
+{
+    local.keys.emplace_back(index, std::make_pair(std::string(key), std::string(type)));
+    local.bytes += key.size() + type.size() + 2 * sizeof(std::string);
+}
+
+void CaptureStreamWriter::addPoint(Time time,
+                                   int index,
+                                   std::int16_t iteration,
+                                   std::string_view value)
+{
+    if (index < 0) {
+        return;
+    }
+    local.points.emplace_back(time, index, iteration, value);
+    local.bytes += sizeof(CapturedValue) + value.size();
+}
+
+void CaptureStreamWriter::addMessage(std::unique_ptr<Message> message)
+{
+    local.bytes += sizeof(Message) + message->data.size() + message->source.size() +
+        message->dest.size() + message->original_source.size() + message->original_dest.size();
+    local.messages.push_back(std::move(message));
+}
+
+void CaptureStreamWriter::commit()
+{
+    if (local.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(dataLock);
+    if (closing) {
+        local = CaptureBlock{};
+        return;
+    }
+    // limit the memory in use by waiting for the writer thread to catch up
+    spaceAvailable.wait(lock, [this]() { return bufferedBytes < memoryLimit || closing; });
+    bufferedBytes += local.bytes;
+    if (pending.empty()) {
+        std::swap(pending, local);
+    } else {
+        pending.keys.insert(pending.keys.end(),
+                            std::make_move_iterator(local.keys.begin()),
+                            std::make_move_iterator(local.keys.end()));
+        pending.points.insert(pending.points.end(),
+                              std::make_move_iterator(local.points.begin()),
+                              std::make_move_iterator(local.points.end()));
+        pending.messages.insert(pending.messages.end(),
+                                std::make_move_iterator(local.messages.begin()),
+                                std::make_move_iterator(local.messages.end()));
+        pending.bytes += local.bytes;
+    }
+    local.keys.clear();
+    local.points.clear();
+    local.messages.clear();
+    local.bytes = 0;
+    if (pending.bytes >= memoryLimit / 2) {
+        lock.unlock();
+        writerTrigger.notify_one();
+    }
+}
+
+void CaptureStreamWriter::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(dataLock);
+        if (closing) {
+            return;
+        }
+    }
+    commit();
+    {
+        std::lock_guard<std::mutex> lock(dataLock);
+        closing = true;
+    }
+    writerTrigger.notify_all();
+    spaceAvailable.notify_all();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    closeSegment();
+}
+
+std::vector<std::string> CaptureStreamWriter::getFiles() const
+{
+    std::lock_guard<std::mutex> lock(fileListLock);
+    return files;
+}
+
+void CaptureStreamWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(dataLock);
+    while (true) {
+        writerTrigger.wait_for(lock, flushInterval, [this]() {
+            return closing || pending.bytes >= memoryLimit / 2;
+        });
+        if (pending.empty()) {
+            if (closing) {
+                break;
+            }
+            continue;
+        }
+        CaptureBlock block;
+        std::swap(block, pending);
+        lock.unlock();
+        try {
+            writeBlock(block);
+            if (segmentOpen) {
+                out.flush();
+                if (messageOut.is_open()) {
+                    messageOut.flush();
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            spdlog::error("error writing capture file {}: {}", fileName, e.what());
+        }
+        lock.lock();
+        bufferedBytes -= block.bytes;
+        spaceAvailable.notify_all();
+    }
+}
+
+void CaptureStreamWriter::writeBlock(CaptureBlock& block)
+{
+    for (auto& key : block.keys) {
+        if (key.first < 0) {
+            continue;
+        }
+        if (static_cast<std::size_t>(key.first) >= keyTable.size()) {
+            keyTable.resize(static_cast<std::size_t>(key.first) + 1);
+        }
+        keyTable[key.first] = std::move(key.second);
+    }
+    const std::size_t pointCount = block.points.size();
+    const std::size_t messageCount = block.messages.size();
+    std::size_t pointIndex{0};
+    std::size_t messageIndex{0};
+    while (pointIndex < pointCount || messageIndex < messageCount) {
+        std::size_t pointEnd{pointCount};
+        std::size_t messageEnd{messageCount};
+        if (rotatePeriod > timeZero) {
+            Time next = Time::maxVal();
+            if (pointIndex < pointCount) {
+                next = block.points[pointIndex].time;
+            }
+            if (messageIndex < messageCount) {
+                next = std::min(next, block.messages[messageIndex]->time);
+            }
+            if (next >= nextRotationTime && nextRotationTime < Time::maxVal()) {
+                if (segmentPoints + segmentMessages > 0) {
+                    closeSegment();
+                }
+                const auto period = rotatePeriod.getBaseTimeCode();
+                const auto code = next.getBaseTimeCode();
+                auto count = code / period;
+                if (code < 0 && code % period != 0) {
+                    --count;
+                }
+                nextRotationTime = (count < Time::maxVal().getBaseTimeCode() / period - 1) ?
+                    timeFromCode((count + 1) * period) :
+                    Time::maxVal();
+            }
+            pointEnd = pointIndex;
+            while (pointEnd < pointCount && block.points[pointEnd].time < nextRotationTime) {
+                ++pointEnd;
+            }
+            messageEnd = messageIndex;
+            while (messageEnd < messageCount &&
+                   block.messages[messageEnd]->time < nextRotationTime) {
+                ++messageEnd;
+            }
+        }
+        if (rotateSize > 0) {
+            // limit the amount a file can exceed the rotation size
+            pointEnd = std::min(pointEnd, pointIndex + maxRotationRecords);
+            messageEnd = std::min(messageEnd, messageIndex + maxRotationRecords);
+        }
+        if (!segmentOpen && !openSegment()) {
+            spdlog::error("unable to open capture file {}, captured data discarded",
+                          segmentFileName(segment));
+            return;
+        }
+        writeRange(block, pointIndex, pointEnd, messageIndex, messageEnd);
+        pointIndex = pointEnd;
+        messageIndex = messageEnd;
+        if (rotateSize > 0 && segmentBytes >= rotateSize) {
+            closeSegment();
+        }
+    }
+}
+
+void CaptureStreamWriter::writeRange(CaptureBlock& block,
+                                     std::size_t pointStart,
+                                     std::size_t pointEnd,
+                                     std::size_t messageStart,
+                                     std::size_t messageEnd)
+{
+    if (format == CaptureFormat::BINARY) {
+        writeBinaryChunk(block, pointStart, pointEnd, messageStart, messageEnd);
+        return;
+    }
+    static const std::pair<std::string, std::string> unknownKey;
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        const auto& point = block.points[ii];
+        const auto index = static_cast<std::size_t>(point.index);
+        const auto& keyInfo = (index < keyTable.size()) ? keyTable[index] : unknownKey;
+        // the type is written on the first occurrence of each key in a file
+        const std::string* type{nullptr};
+        if (index >= segmentKeySeen.size()) {
+            segmentKeySeen.resize(index + 1, false);
+        }
+        if (!segmentKeySeen[index]) {
+            segmentKeySeen[index] = true;
+            type = &keyInfo.second;
+        }
+        if (format == CaptureFormat::JSON) {
+            if (segmentPoints > 0) {
+                out << ',';
+            }
+            out << generateJsonPoint(point.time, point.iteration, keyInfo.first, type, point.value);
+        } else {
+            if (segmentPoints == 0) {
+                out << "#time \ttag\t type*\t value\n";
+            }
+            writeTextPoint(out, point.time, point.iteration, keyInfo.first, type, point.value);
+        }
+        ++segmentPoints;
+    }
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        auto& message = *block.messages[ii];
+        if (format == CaptureFormat::JSON) {
+            if (segmentMessages > 0) {
+                messageOut << ',';
+            }
+            messageOut << generateJsonMessage(message);
+        } else {
+            if (segmentMessages == 0) {
+                out << "# m\t time \tsource\t dest\t message\n";
+            }
+            writeTextMessage(out, message);
+        }
+        ++segmentMessages;
+    }
+    segmentBytes = static_cast<std::uint64_t>(out.tellp());
+    if (format == CaptureFormat::JSON) {
+        segmentBytes += static_cast<std::uint64_t>(messageOut.tellp());
+    }
+}
+
+std::uint32_t CaptureStreamWriter::binaryEndpointKey(const std::string& name,
+                                                     std::string& keyData,
+                                                     std::uint32_t& newKeys)
+{
+    if (name.empty()) {
+        return noKey;
+    }
+    auto fnd = endpointFileKeys.find(name);
+    if (fnd != endpointFileKeys.end()) {
+        return fnd->second;
+    }
+    auto key = static_cast<std::uint32_t>(fileKeys.size());
+    fileKeys.push_back(FileKey{name, std::string{}, endpointKeyKind, {}});
+    endpointFileKeys.emplace(name, key);
+    appendValue(keyData, key);
+    appendValue(keyData, endpointKeyKind);
+    appendString(keyData, name);
+    appendString(keyData, std::string_view{});
+    ++newKeys;
+    return key;
+}
+
+void CaptureStreamWriter::writeBinaryChunk(CaptureBlock& block,
+                                           std::size_t pointStart,
+                                           std::size_t pointEnd,
+                                           std::size_t messageStart,
+                                           std::size_t messageEnd)
+{
+    std::string keyData;
+    std::uint32_t newKeys{0};
+    std::vector<std::uint32_t> pointKeys;
+    pointKeys.reserve(pointEnd - pointStart);
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        const auto index = static_cast<std::size_t>(block.points[ii].index);
+        if (index >= pointFileKeys.size()) {
+            pointFileKeys.resize(index + 1, -1);
+        }
+        if (pointFileKeys[index] < 0) {
+            auto key = static_cast<std::uint32_t>(fileKeys.size());
+            FileKey fileKey;
+            if (index < keyTable.size()) {
+                fileKey.name = keyTable[index].first;
+                fileKey.type = keyTable[index].second;
+            }
+            fileKey.kind = valueKeyKind;
+            appendValue(keyData, key);
+            appendValue(keyData, fileKey.kind);
+            appendString(keyData, fileKey.name);
+            appendString(keyData, fileKey.type);
+            ++newKeys;
+            fileKeys.push_back(std::move(fileKey));
+            pointFileKeys[index] = key;
+        }
+        pointKeys.push_back(static_cast<std::uint32_t>(pointFileKeys[index]));
+    }
+    const auto messageCount = messageEnd - messageStart;
+    std::vector<std::uint32_t> messageKeys;
+    messageKeys.reserve(4 * messageCount);
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        const auto& message = *block.messages[ii];
+        messageKeys.push_back(binaryEndpointKey(message.source, keyData, newKeys));
+        messageKeys.push_back(binaryEndpointKey(recordedDestination(message), keyData, newKeys));
+        messageKeys.push_back(binaryEndpointKey(message.original_source, keyData, newKeys));
+        messageKeys.push_back(binaryEndpointKey(message.original_dest, keyData, newKeys));
+    }
+    // count the records in the chunk using each key for the index
+    std::vector<std::uint32_t> keyCounts(fileKeys.size(), 0U);
+    for (auto key : pointKeys) {
+        ++keyCounts[key];
+    }
+    for (std::size_t ii = 0; ii < messageCount; ++ii) {
+        const auto source = messageKeys[4 * ii];
+        const auto dest = messageKeys[4 * ii + 1];
+        if (source != noKey) {
+            ++keyCounts[source];
+        }
+        if (dest != noKey && dest != source) {
+            ++keyCounts[dest];
+        }
+    }
+
+    std::string chunk;
+    appendValue(chunk, chunkMarker);
+    appendValue(chunk, std::uint64_t{0});
+    appendValue(chunk, newKeys);
+    chunk.append(keyData);
+
+    appendValue(chunk, static_cast<std::uint32_t>(pointEnd - pointStart));
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        appendValue(chunk, block.points[ii].time.getBaseTimeCode());
+    }
+    for (auto key : pointKeys) {
+        appendValue(chunk, key);
+    }
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        appendValue(chunk, block.points[ii].iteration);
+    }
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        appendValue(chunk, static_cast<std::uint32_t>(block.points[ii].value.size()));
+    }
+    for (auto ii = pointStart; ii < pointEnd; ++ii) {
+        chunk.append(block.points[ii].value);
+    }
+
+    appendValue(chunk, static_cast<std::uint32_t>(messageCount));
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        appendValue(chunk, block.messages[ii]->time.getBaseTimeCode());
+    }
+    for (std::size_t column = 0; column < 4; ++column) {
+        for (std::size_t ii = 0; ii < messageCount; ++ii) {
+            appendValue(chunk, messageKeys[4 * ii + column]);
+        }
+    }
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        appendValue(chunk, block.messages[ii]->flags);
+    }
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        appendValue(chunk, static_cast<std::uint32_t>(block.messages[ii]->data.size()));
+    }
+    for (auto ii = messageStart; ii < messageEnd; ++ii) {
+        chunk.append(block.messages[ii]->data.to_string());
+    }
+    // fill in the chunk size
+    std::string chunkSize;
+    appendValue(chunkSize, static_cast<std::uint64_t>(chunk.size() - chunkHeaderSize));
+    chunk.replace(sizeof(std::uint32_t), chunkSize.size(), chunkSize);
+
+    const auto offset = segmentBytes;
+    out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    segmentBytes += chunk.size();
+    segmentPoints += pointEnd - pointStart;
+    segmentMessages += messageCount;
+    for (std::size_t ii = 0; ii < keyCounts.size(); ++ii) {
+        if (keyCounts[ii] > 0) {
+            fileKeys[ii].chunks.emplace_back(offset, keyCounts[ii]);
+        }
+    }
+}
+
+std::string CaptureStreamWriter::segmentFileName(int segmentIndex) const
+{
+    if (segmentIndex == 0) {
+        return fileName;
+    }
+    auto lastP = fileName.find_last_of('.');
+    auto lastSep = fileName.find_last_of("/\\");
+    if (lastP == std::string::npos || (lastSep != std::string::npos && lastSep > lastP)) {
+        return fileName + '_' + std::to_string(segmentIndex);
+    }
+    return fileName.substr(0, lastP) + '_' + std::to_string(segmentIndex) +
+        fileName.substr(lastP);
+}
+
+bool CaptureStreamWriter::openSegment()
+{
+    auto name = segmentFileName(segment);
+    out.open(name,
+             (format == CaptureFormat::BINARY) ? (std::ios::out | std::ios::binary) :
+                                                 std::ios::out);
+    if (!out.is_open()) {
+        return false;
+    }
+    if (format == CaptureFormat::JSON) {
+        messageOut.open(name + ".messages");
+        if (!messageOut.is_open()) {
+            out.close();
+            return false;
+        }
+        out << "{\"points\":[";
+    } else if (format == CaptureFormat::BINARY) {
+        std::string header(captureFileMagic);
+        appendValue(header, captureFileVersion);
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+    segmentOpen = true;
+    segmentBytes = static_cast<std::uint64_t>(out.tellp());
+    segmentPoints = 0;
+    segmentMessages = 0;
+    segmentKeySeen.clear();
+    pointFileKeys.clear();
+    endpointFileKeys.clear();
+    fileKeys.clear();
+    std::lock_guard<std::mutex> lock(fileListLock);
+    files.push_back(std::move(name));
+    return true;
+}
+
+void CaptureStreamWriter::closeSegment()
+{
+    if (!segmentOpen) {
+        return;
+    }
+    if (format == CaptureFormat::JSON) {
+        out << ']';
+        messageOut.close();
+        auto messageFile = segmentFileName(segment) + ".messages";
+        if (segmentMessages > 0) {
+            out << ",\"messages\":[";
+            std::ifstream messageIn(messageFile);
+            out << messageIn.rdbuf();
+            out << ']';
+        }
+        out << "}\n";
+        std::remove(messageFile.c_str());
+    } else if (format == CaptureFormat::BINARY) {
+        const auto footerOffset = segmentBytes;
+        std::string footer;
+        appendValue(footer, indexMarker);
+        appendValue(footer, static_cast<std::uint32_t>(fileKeys.size()));
+        for (const auto& key : fileKeys) {
+            appendValue(footer, key.kind);
+            appendString(footer, key.name);
+            appendString(footer, key.type);
+            appendValue(footer, static_cast<std::uint32_t>(key.chunks.size()));
+            for (const auto& chunkRef : key.chunks) {
+                appendValue(footer, chunkRef.first);
+                appendValue(footer, chunkRef.second);
+            }
+        }
+        appendValue(footer, footerOffset);
+        footer.append(captureIndexMagic);
+        out.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+    }
+    out.close();
+    segmentOpen = false;
+    ++segment;
+}
+
+bool CaptureFileReader::open(const std::string& filename)
+{
+    in.close();
+    in.clear();
+    keys.clear();
+    chunkOffsets.clear();
+    complete = false;
+    in.open(filename, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    fileSize = static_cast<std::uint64_t>(in.tellg());
+    if (fileSize < captureHeaderSize) {
+        return false;
+    }
+    std::string header(captureHeaderSize, '\0');
+    in.seekg(0);
+    in.read(header.data(), static_cast<std::streamsize>(header.size()));
+    ByteReader headerReader(header.data(), header.size());
+    if (headerReader.readBytes(captureFileMagic.size()) != captureFileMagic ||
+        headerReader.read<std::uint32_t>() > captureFileVersion) {
+        return false;
+    }
+    dataEnd = fileSize;
+    if (fileSize >= captureHeaderSize + captureTrailerSize) {
+        std::string trailer(captureTrailerSize, '\0');
+        in.seekg(static_cast<std::streamoff>(fileSize - captureTrailerSize));
+        in.read(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+        ByteReader trailerReader(trailer.data(), trailer.size());
+        const auto footerOffset = trailerReader.read<std::uint64_t>();
+        if (trailerReader.readBytes(captureIndexMagic.size()) == captureIndexMagic &&
+            footerOffset >= captureHeaderSize && footerOffset < fileSize - captureTrailerSize) {
+            std::string footer(fileSize - captureTrailerSize - footerOffset, '\0');
+            in.seekg(static_cast<std::streamoff>(footerOffset));
+            in.read(footer.data(), static_cast<std::streamsize>(footer.size()));
+            ByteReader footerReader(footer.data(), footer.size());
+            if (footerReader.read<std::uint32_t>() == indexMarker) {
+                const auto keyCount = footerReader.read<std::uint32_t>();
+                for (std::uint32_t ii = 0; ii < keyCount && footerReader.isGood(); ++ii) {
+                    KeyInfo info;
+                    info.endpoint = (footerReader.read<std::uint8_t>() == endpointKeyKind);
+                    info.name = footerReader.readString();
+                    info.type = footerReader.readString();
+                    const auto chunkCount = footerReader.read<std::uint32_t>();
+                    for (std::uint32_t jj = 0; jj < chunkCount && footerReader.isGood(); ++jj) {
+                        auto offset = footerReader.read<std::uint64_t>();
+                        auto count = footerReader.read<std::uint32_t>();
+                        info.chunks.emplace_back(offset, count);
+                    }
+                    keys.push_back(std::move(info));
+                }
+                if (footerReader.isGood()) {
+                    complete = true;
+                    dataEnd = footerOffset;
+                } else {
+                    keys.clear();
+                }
+            }
+        }
+    }
+    in.clear();
+    return scanChunks();
+}
+
+bool CaptureFileReader::scanChunks()
+{
+    std::uint64_t offset{captureHeaderSize};
+    std::string chunkHeader(chunkHeaderSize, '\0');
+    while (offset + chunkHeaderSize <= dataEnd) {
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(chunkHeader.data(), static_cast<std::streamsize>(chunkHeader.size()));
+        ByteReader headerReader(chunkHeader.data(), chunkHeader.size());
+        const auto marker = headerReader.read<std::uint32_t>();
+        const auto chunkSize = headerReader.read<std::uint64_t>();
+        if (!in || marker != chunkMarker || chunkSize > dataEnd - offset - chunkHeaderSize) {
+            // a partially written chunk at the end of an incomplete file is ignored
+            break;
+        }
+        chunkOffsets.push_back(offset);
+        if (!complete) {
+            // rebuild the key index from the chunk contents
+            if (!readChunk(offset, -1, nullptr, nullptr)) {
+                chunkOffsets.pop_back();
+                break;
+            }
+        }
+        offset += chunkHeaderSize + chunkSize;
+    }
+    in.clear();
+    return true;
+}
+
+bool CaptureFileReader::readChunk(std::uint64_t offset,
+                                  int keyFilter,
+                                  std::vector<CapturedValue>* points,
+                                  std::vector<std::unique_ptr<Message>>* messages)
+{
+    std::string chunkHeader(chunkHeaderSize, '\0');
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(chunkHeader.data(), static_cast<std::streamsize>(chunkHeader.size()));
+    ByteReader headerReader(chunkHeader.data(), chunkHeader.size());
+    if (headerReader.read<std::uint32_t>() != chunkMarker) {
+        in.clear();
+        return false;
+    }
+    std::string data(headerReader.read<std::uint64_t>(), '\0');
+    in.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!in) {
+        in.clear();
+        return false;
+    }
+    // reading a chunk without any output adds it to the key index
+    const bool indexing = (points == nullptr && messages == nullptr);
+    ByteReader reader(data.data(), data.size());
+    const auto newKeys = reader.read<std::uint32_t>();
+    for (std::uint32_t ii = 0; ii < newKeys && reader.isGood(); ++ii) {
+        const auto key = reader.read<std::uint32_t>();
+        const auto kind = reader.read<std::uint8_t>();
+        auto name = reader.readString();
+        auto type = reader.readString();
+        if (indexing && reader.isGood()) {
+            if (key >= keys.size()) {
+                keys.resize(static_cast<std::size_t>(key) + 1);
+            }
+            keys[key].name = name;
+            keys[key].type = type;
+            keys[key].endpoint = (kind == endpointKeyKind);
+        }
+    }
+    const auto pointCount = reader.read<std::uint32_t>();
+    auto pointTimes = reader.readColumn<std::int64_t>(pointCount);
+    auto pointKeys = reader.readColumn<std::uint32_t>(pointCount);
+    auto iterations = reader.readColumn<std::int16_t>(pointCount);
+    auto valueSizes = reader.readColumn<std::uint32_t>(pointCount);
+    std::vector<std::string_view> values;
+    values.reserve(pointCount);
+    for (auto valueSize : valueSizes) {
+        values.push_back(reader.readBytes(valueSize));
+    }
+    const auto messageCount = reader.read<std::uint32_t>();
+    auto messageTimes = reader.readColumn<std::int64_t>(messageCount);
+    auto sources = reader.readColumn<std::uint32_t>(messageCount);
+    auto dests = reader.readColumn<std::uint32_t>(messageCount);
+    auto originalSources = reader.readColumn<std::uint32_t>(messageCount);
+    auto originalDests = reader.readColumn<std::uint32_t>(messageCount);
+    auto flags = reader.readColumn<std::uint16_t>(messageCount);
+    auto dataSizes = reader.readColumn<std::uint32_t>(messageCount);
+    std::vector<std::string_view> messageData;
+    messageData.reserve(messageCount);
+    for (auto dataSize : dataSizes) {
+        messageData.push_back(reader.readBytes(dataSize));
+    }
+    if (!reader.isGood()) {
+        return false;
+    }
+    auto validKey = [this](std::uint32_t key) { return key == noKey || key < keys.size(); };
+    if (!std::all_of(pointKeys.begin(), pointKeys.end(), validKey) ||
+        !std::all_of(sources.begin(), sources.end(), validKey) ||
+        !std::all_of(dests.begin(), dests.end(), validKey) ||
+        !std::all_of(originalSources.begin(), originalSources.end(), validKey) ||
+        !std::all_of(originalDests.begin(), originalDests.end(), validKey)) {
+        return false;
+    }
+    if (indexing) {
+        std::vector<std::uint32_t> keyCounts(keys.size(), 0U);
+        for (auto key : pointKeys) {
+            ++keyCounts[key];
+        }
+        for (std::size_t ii = 0; ii < messageCount; ++ii) {
+            if (sources[ii] != noKey) {
+                ++keyCounts[sources[ii]];
+            }
+            if (dests[ii] != noKey && dests[ii] != sources[ii]) {
+                ++keyCounts[dests[ii]];
+            }
+        }
+        for (std::size_t ii = 0; ii < keyCounts.size(); ++ii) {
+            if (keyCounts[ii] > 0) {
+                keys[ii].chunks.emplace_back(offset, keyCounts[ii]);
+            }
+        }
+    }
+    if (points != nullptr) {
+        for (std::size_t ii = 0; ii < pointCount; ++ii) {
+            if (keyFilter < 0 || pointKeys[ii] == static_cast<std::uint32_t>(keyFilter)) {
+                points->emplace_back(timeFromCode(pointTimes[ii]),
+                                     static_cast<int>(pointKeys[ii]),
+                                     iterations[ii],
+                                     values[ii]);
+            }
+        }
+    }
+    if (messages != nullptr) {
+        auto keyName = [this](std::uint32_t key) {
+            return (key == noKey) ? std::string{} : keys[key].name;
+        };
+        for (std::size_t ii = 0; ii < messageCount; ++ii) {
+            auto message = std::make_unique<Message>();
+            message->time = timeFromCode(messageTimes[ii]);
+            message->flags = flags[ii];
+            message->source = keyName(sources[ii]);
+            message->dest = keyName(dests[ii]);
+            message->original_source = keyName(originalSources[ii]);
+            message->original_dest = keyName(originalDests[ii]);
+            message->data.assign(messageData[ii].data(), messageData[ii].size());
+            messages->push_back(std::move(message));
+        }
+    }
+    return true;
+}
+
+std::vector<CapturedValue> CaptureFileReader::readPoints(std::string_view key)
+{
+    std::vector<CapturedValue> points;
+    for (std::size_t ii = 0; ii < keys.size(); ++ii) {
+        if (keys[ii].endpoint || keys[ii].name != key) {
+            continue;
+        }
+        for (const auto& chunkRef : keys[ii].chunks) {
+            readChunk(chunkRef.first, static_cast<int>(ii), &points, nullptr);
+        }
+    }
+    return points;
+}
+
+std::vector<CapturedValue> CaptureFileReader::readAllPoints()
+{
+    std::vector<CapturedValue> points;
+    for (auto offset : chunkOffsets) {
+        readChunk(offset, -1, &points, nullptr);
+    }
+    return points;
+}
+
+std::vector<std::unique_ptr<Message>> CaptureFileReader::readMessages()
+{
+    std::vector<std::unique_ptr<Message>> messages;
+    for (auto offset : chunkOffsets) {
+        readChunk(offset, -1, nullptr, &messages);
+    }
+    return messages;
+}
+
+}  // namespace helics::apps
@@ -0,0 +1,235 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+
+#include "../core/core-data.hpp"
+#include "../core/helicsTime.hpp"
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** @file
+@details streaming output for the Recorder app.  Captured values and messages are handed to a
+background thread which writes them to text, JSON, or a columnar binary capture file.
+
+The binary capture format is a file header followed by a sequence of self-delimited chunks, each
+containing the key definitions first used in the chunk and the captured values and messages stored
+column wise.  A footer written when the file is closed contains an index of the chunks that
+reference each key, so a single key can be read without scanning the entire file.  If the footer
+is missing (for example after a crash) the chunks can still be read sequentially.
+*/
+namespace helics::apps {
+
+/** a single captured value*/
+struct CapturedValue {
+    Time time;
+    int index{-1};  //!< index of the key of the value
+    std::int16_t iteration{0};
+    std::string value;
+    CapturedValue() = default;
+    CapturedValue(Time captureTime, int keyIndex, std::int16_t iter, std::string_view val):
+        time(captureTime), index(keyIndex), iteration(iter), value(val)
+    {
+    }
+};
+
+/** output formats supported by the CaptureStreamWriter*/
+enum class CaptureFormat { TEXT, JSON, BINARY };
+
+/** determine the capture format from the extension of a file name*/
+CaptureFormat captureFormatFromFileName(std::string_view filename);
+
+/** get the destination to record for a message, messages delivered to the recorder clone endpoint
+record the original destination*/
+const std::string& recordedDestination(const Message& message);
+
+/** write a value point in the recorder text format
+@param type the type of the value, written if not nullptr*/
+void writeTextPoint(std::ostream& out,
+                    Time time,
+                    int iteration,
+                    std::string_view key,
+                    const std::string* type,
+                    const std::string& value);
+/** write a message in the recorder text format*/
+void writeTextMessage(std::ostream& out, Message& message);
+/** generate a JSON object for a value point in the recorder JSON format
+@param type the type of the value, included if not nullptr*/
+nlohmann::json generateJsonPoint(Time time,
+                                 int iteration,
+                                 std::string_view key,
+                                 const std::string* type,
+                                 const std::string& value);
+/** generate a JSON object for a message in the recorder JSON format*/
+nlohmann::json generateJsonMessage(Message& message);
+
+/** class writing captured data to files from a background thread
+@details the add* and define functions are intended to be called from a single producer thread
+and are collected locally until commit is called, which hands them to the writer thread.  The data
+held in memory is limited to approximately memoryLimit bytes, commit blocks if the writer thread
+falls behind.  Output files can be rotated when they exceed a size or a span of simulation time,
+rotated files are named with an index before the extension, out.txt, out_1.txt, out_2.txt ...
+*/
+class CaptureStreamWriter {
+  public:
+    /** construct the writer and open the first output file
+    @param filename the name of the output file, the extension selects the format
+    @param memoryLimit the approximate maximum number of bytes held in memory
+    @param flushInterval the maximum time to hold data in memory before writing it
+    @param rotateSize start a new file after the file exceeds this many bytes (0 to disable)
+    @param rotatePeriod start a new file for each span of simulation time (0 to disable)
+    @throw InvalidParameter if the file cannot be opened
+    */
+    CaptureStreamWriter(std::string filename,
+                        std::size_t memoryLimit,
+                        std::chrono::milliseconds flushInterval,
+                        std::uint64_t rotateSize,
+                        Time rotatePeriod);
+    /** destructor writes all remaining data and closes the files*/
+    ~CaptureStreamWriter();
+    CaptureStreamWriter(const CaptureStreamWriter&) = delete;
+    CaptureStreamWriter& operator=(const CaptureStreamWriter&) = delete;
+
+    /** define the key and type used for a value index*/
+    void defineKey(int index, std::string_view key, std::string_view type);
+    /** add a value point for an index defined with defineKey*/
+    void addPoint(Time time, int index, std::int16_t iteration, std::string_view value);
+    /** add a message*/
+    void addMessage(std::unique_ptr<Message> message);
+    /** hand the data added since the last commit to the writer thread*/
+    void commit();
+    /** write all remaining data and close the files, no more data can be added after close*/
+    void close();
+    /** get the names of the files that have been created*/
+    std::vector<std::string> getFiles() const;
+
+  private:
+    /** a block of captured data passed to the writer thread*/
+    struct CaptureBlock {
+        std::vector<std::pair<int, std::pair<std::string, std::string>>> keys;
+        std::vector<CapturedValue> points;
+        std::vector<std::unique_ptr<Message>> messages;
+        std::size_t bytes{0};
+        bool empty() const { return keys.empty() && points.empty() && messages.empty(); }
+    };
+    /** a key in the current binary file*/
+    struct FileKey {
+        std::string name;
+        std::string type;
+        std::uint8_t kind{0};
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> chunks;
+    };
+
+    void writerLoop();
+    void writeBlock(CaptureBlock& block);
+    void writeRange(CaptureBlock& block,
+                    std::size_t pointStart,
+                    std::size_t pointEnd,
+                    std::size_t messageStart,
+                    std::size_t messageEnd);
+    void writeBinaryChunk(CaptureBlock& block,
+                          std::size_t pointStart,
+                          std::size_t pointEnd,
+                          std::size_t messageStart,
+                          std::size_t messageEnd);
+    std::uint32_t
+        binaryEndpointKey(const std::string& name, std::string& keyData, std::uint32_t& newKeys);
+    bool openSegment();
+    void closeSegment();
+    std::string segmentFileName(int segment) const;
+
+    std::string fileName;
+    CaptureFormat format{CaptureFormat::TEXT};
+    std::size_t memoryLimit;
+    std::chrono::milliseconds flushInterval;
+    std::uint64_t rotateSize;
+    Time rotatePeriod;
+
+    CaptureBlock local;  //!< data collected by the producer thread since the last commit
+    std::mutex dataLock;  //!< lock protecting the pending data
+    std::condition_variable writerTrigger;  //!< wake the writer thread
+    std::condition_variable spaceAvailable;  //!< wake the producer when memory is available
+    CaptureBlock pending;  //!< data waiting for the writer thread
+    std::size_t bufferedBytes{0};  //!< bytes pending or being written
+    bool closing{false};
+    std::thread writerThread;
+
+    // all the following are only used by the writer thread after construction
+    std::vector<std::pair<std::string, std::string>> keyTable;  //!< key and type of each index
+    std::ofstream out;  //!< the current output file
+    std::ofstream messageOut;  //!< temporary message storage for JSON files
+    int segment{0};
+    bool segmentOpen{false};
+    std::uint64_t segmentBytes{0};
+    std::size_t segmentPoints{0};
+    std::size_t segmentMessages{0};
+    Time nextRotationTime{Time::maxVal()};
+    std::vector<bool> segmentKeySeen;  //!< keys which have already been written in the file
+    std::vector<std::int64_t> pointFileKeys;  //!< file key of each index in a binary file
+    std::unordered_map<std::string, std::uint32_t> endpointFileKeys;
+    std::vector<FileKey> fileKeys;  //!< the keys in the current binary file
+    std::vector<std::string> files;  //!< the files which have been created
+    mutable std::mutex fileListLock;  //!< lock protecting the file list
+};
+
+/** class for reading binary capture files written by the Recorder*/
+class CaptureFileReader {
+  public:
+    /** information about a key in the file*/
+    struct KeyInfo {
+        std::string name;
+        std::string type;
+        bool endpoint{false};  //!< the key is an endpoint name used by messages
+        /// the file offset of each chunk using the key and the number of records using it
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> chunks;
+    };
+    /** open a capture file
+    @return true if the file is a valid capture file*/
+    bool open(const std::string& filename);
+    /** check if the file contained the key index footer*/
+    bool isComplete() const { return complete; }
+    /** get the keys in the file*/
+    const std::vector<KeyInfo>& getKeys() const { return keys; }
+    /** read all the values for a single key, using the index to read only the relevant chunks
+    @details the index of the returned values is the index of the key in getKeys()*/
+    std::vector<CapturedValue> readPoints(std::string_view key);
+    /** read all the values in the file*/
+    std::vector<CapturedValue> readAllPoints();
+    /** read all the messages in the file*/
+    std::vector<std::unique_ptr<Message>> readMessages();
+
+  private:
+    /** read a chunk of the file, if both points and messages are nullptr the chunk is added to
+    the key index*/
+    bool readChunk(std::uint64_t offset,
+                   int keyFilter,
+                   std::vector<CapturedValue>* points,
+                   std::vector<std::unique_ptr<Message>>* messages);
+    bool scanChunks();
+
+    std::ifstream in;
+    std::uint64_t fileSize{0};
+    std::uint64_t dataEnd{0};  //!< the end of the chunk data
+    bool complete{false};
+    std::vector<KeyInfo> keys;
+    std::vector<std::uint64_t> chunkOffsets;
+};
+
+}  // namespace helics::apps
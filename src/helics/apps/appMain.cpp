@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "../application_api/BrokerApp.hpp"
+#include "../core/ProfilerBuffer.hpp"
 #include "../core/core-exceptions.hpp"
 #include "../core/helicsCLI11.hpp"
 #include "Clone.hpp"
@@ -17,6 +18,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Source.hpp"
 #include "Tracer.hpp"
 
+#include <filesystem>
 #include <iostream>
 #include <spdlog/logger.h>
 #include <string>
@@ -135,6 +137,27 @@ int main(int argc, char* argv[])
             helics::BrokerApp broker(argc, argv);
             return std::string{};
         });
+    std::string profileInput;
+    std::string profileOutput;
+    auto* profile = app.add_subcommand(
+        "profile", "convert a binary (.hprof) profile file to the Chrome trace event format");
+    profile->add_option("input", profileInput, "the binary profile file to convert")->required();
+    profile->add_option("-o,--output",
+                        profileOutput,
+                        "the trace file to write, defaults to the input file with a .json extension");
+    profile->callback([&profileInput, &profileOutput]() {
+        if (profileOutput.empty()) {
+            profileOutput = std::filesystem::path(profileInput).replace_extension(".json").string();
+        }
+        try {
+            auto count = helics::convertProfileToTrace(profileInput, profileOutput);
+            std::cout << "wrote " << count << " trace events to " << profileOutput << '\n';
+        }
+        catch (const std::ios_base::failure& e) {
+            std::cerr << "unable to convert " << profileInput << ": " << e.what() << '\n';
+        }
+    });
+
     app.footer(
         "helics_app [SUBCOMMAND] --help will display the options for a particular subcommand");
     app.addSystemInfoCall();
@@ -242,7 +242,11 @@ void AppTextParser::reset()
 
 void App::loadConfigOptions(AppTextParser& aparser)
 {
-    const auto& configStr = aparser.configString();
+    loadConfigString(aparser.configString());
+}
+
+void App::loadConfigString(const std::string& configStr)
+{
     if (!configStr.empty()) {
         auto app = generateParser();
         std::istringstream sstr(configStr);
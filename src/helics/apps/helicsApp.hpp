@@ -134,6 +134,8 @@ configuration
     void loadInputFiles();
     /** load the config options from a text parser*/
     void loadConfigOptions(AppTextParser& aparser);
+    /** load the config options from the configuration lines of a text file*/
+    void loadConfigString(const std::string& configStr);
 
   private:
     void loadConfigOptions(const fileops::JsonBuffer& element);
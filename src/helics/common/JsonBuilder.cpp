@@ -10,7 +10,10 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "JsonProcessingFunctions.hpp"
 #include "gmlc/utilities/stringOps.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +21,305 @@ SPDX-License-Identifier: BSD-3-Clause
 namespace helics::fileops {
 using stringVector = gmlc::utilities::stringVector;
 
+namespace {
+    /** dump a JSON value with the same settings as generateJsonString*/
+    std::string dumpJson(const nlohmann::json& json, int indent)
+    {
+        return json.dump(indent, ' ', true, nlohmann::json::error_handler_t::hex);
+    }
+
+    /** check if a string can be written without any escapes*/
+    bool isPlainString(std::string_view str)
+    {
+        for (const char test : str) {
+            const auto code = static_cast<unsigned char>(test);
+            if (code < 0x20U || code > 0x7EU || test == '"' || test == '\\') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void appendQuoted(std::string& out, std::string_view str)
+    {
+        if (isPlainString(str)) {
+            out.push_back('"');
+            out.append(str);
+            out.push_back('"');
+        } else {
+            out.append(dumpJson(nlohmann::json(std::string(str)), -1));
+        }
+    }
+
+    /** append JSON text, indenting every line after the first*/
+    void appendIndented(std::string& out, std::string_view json, std::size_t padding)
+    {
+        // newlines only occur in the structure since they are escaped inside strings
+        auto newline = json.find('\n');
+        while (newline != std::string_view::npos) {
+            out.append(json.substr(0, newline + 1));
+            out.append(padding, ' ');
+            json.remove_prefix(newline + 1);
+            newline = json.find('\n');
+        }
+        out.append(json);
+    }
+
+    /** reformat valid JSON text into the pretty printed form produced by nlohmann::json
+    @details this only handles text which nlohmann::json would write back unchanged apart from
+    whitespace, sorted unique keys, plain strings and integers, anything else returns false so
+    the text can be parsed and dumped instead*/
+    class JsonFormatter {
+      public:
+        JsonFormatter(std::string& output, std::string_view json, int indent):
+            out(output), text(json), indentSize(static_cast<std::size_t>(indent))
+        {
+        }
+        bool format(std::size_t depth) { return value(depth) && (skipSpace(), pos == text.size()); }
+
+      private:
+        void skipSpace()
+        {
+            while (pos < text.size() &&
+                   (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' ||
+                    text[pos] == '\t')) {
+                ++pos;
+            }
+        }
+        char next()
+        {
+            skipSpace();
+            return (pos < text.size()) ? text[pos] : '\0';
+        }
+        void newLine(std::size_t depth)
+        {
+            out.push_back('\n');
+            out.append(depth * indentSize, ' ');
+        }
+        /** read a string token and return the contents if it has no escapes*/
+        bool plainString(std::string_view& contents)
+        {
+            const auto close = text.find('"', pos + 1);
+            if (close == std::string_view::npos) {
+                return false;
+            }
+            contents = text.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+            return isPlainString(contents);
+        }
+        bool number()
+        {
+            const auto start = pos;
+            while (pos < text.size() &&
+                   std::string_view("0123456789+-.eE").find(text[pos]) != std::string_view::npos) {
+                ++pos;
+            }
+            auto token = text.substr(start, pos - start);
+            auto digits = (!token.empty() && token.front() == '-') ? token.substr(1) : token;
+            // only integers are guaranteed to be written back with the same text
+            if (digits.empty() || digits.size() > 18 ||
+                digits.find_first_not_of("0123456789") != std::string_view::npos ||
+                (digits.front() == '0' && token.size() > 1)) {
+                return false;
+            }
+            out.append(token);
+            return true;
+        }
+        bool literal()
+        {
+            for (std::string_view word : {"true", "false", "null"}) {
+                if (text.substr(pos, word.size()) == word) {
+                    out.append(word);
+                    pos += word.size();
+                    return true;
+                }
+            }
+            return false;
+        }
+        bool container(std::size_t depth, char close)
+        {
+            ++pos;
+            out.push_back(close == '}' ? '{' : '[');
+            if (next() == close) {
+                ++pos;
+                out.push_back(close);
+                return true;
+            }
+            std::string_view lastKey;
+            bool first{true};
+            while (true) {
+                if (!first) {
+                    out.push_back(',');
+                }
+                newLine(depth + 1);
+                if (close == '}') {
+                    std::string_view keyName;
+                    if (next() != '"' || !plainString(keyName) ||
+                        (!first && !(lastKey < keyName)) || next() != ':') {
+                        return false;
+                    }
+                    ++pos;
+                    lastKey = keyName;
+                    out.push_back('"');
+                    out.append(keyName);
+                    out.append("\": ");
+                }
+                if (!value(depth + 1)) {
+                    return false;
+                }
+                first = false;
+                const auto separator = next();
+                ++pos;
+                if (separator == close) {
+                    break;
+                }
+                if (separator != ',') {
+                    return false;
+                }
+            }
+            newLine(depth);
+            out.push_back(close);
+            return true;
+        }
+        bool value(std::size_t depth)
+        {
+            switch (next()) {
+                case '{':
+                    return container(depth, '}');
+                case '[':
+                    return container(depth, ']');
+                case '"': {
+                    std::string_view contents;
+                    if (!plainString(contents)) {
+                        return false;
+                    }
+                    appendQuoted(out, contents);
+                    return true;
+                }
+                case 't':
+                case 'f':
+                case 'n':
+                    return literal();
+                default:
+                    return number();
+            }
+        }
+
+        std::string& out;
+        std::string_view text;
+        std::size_t indentSize;
+        std::size_t pos{0};
+    };
+}  // namespace
+
+void JsonStreamWriter::newLine()
+{
+    out.push_back('\n');
+    out.append(hasMembers.size() * static_cast<std::size_t>(indentSize), ' ');
+}
+
+void JsonStreamWriter::nextValue()
+{
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (!hasMembers.empty()) {
+        if (hasMembers.back()) {
+            out.push_back(',');
+        }
+        hasMembers.back() = true;
+        if (indentSize >= 0) {
+            newLine();
+        }
+    }
+}
+
+void JsonStreamWriter::beginObject()
+{
+    nextValue();
+    out.push_back('{');
+    hasMembers.push_back(false);
+}
+
+void JsonStreamWriter::endObject()
+{
+    const bool hadMembers = hasMembers.back();
+    hasMembers.pop_back();
+    if (hadMembers && indentSize >= 0) {
+        newLine();
+    }
+    out.push_back('}');
+}
+
+void JsonStreamWriter::beginArray()
+{
+    nextValue();
+    out.push_back('[');
+    hasMembers.push_back(false);
+}
+
+void JsonStreamWriter::endArray()
+{
+    const bool hadMembers = hasMembers.back();
+    hasMembers.pop_back();
+    if (hadMembers && indentSize >= 0) {
+        newLine();
+    }
+    out.push_back(']');
+}
+
+void JsonStreamWriter::key(std::string_view name)
+{
+    nextValue();
+    appendQuoted(out, name);
+    out.append((indentSize >= 0) ? ": " : ":");
+    afterKey = true;
+}
+
+void JsonStreamWriter::value(std::string_view str)
+{
+    nextValue();
+    appendQuoted(out, str);
+}
+
+void JsonStreamWriter::value(std::int64_t number)
+{
+    nextValue();
+    out.append(std::to_string(number));
+}
+
+void JsonStreamWriter::value(std::uint64_t number)
+{
+    nextValue();
+    out.append(std::to_string(number));
+}
+
+void JsonStreamWriter::value(const nlohmann::json& json)
+{
+    nextValue();
+    appendIndented(out,
+                   dumpJson(json, indentSize),
+                   hasMembers.size() * static_cast<std::size_t>(std::max(indentSize, 0)));
+}
+
+void JsonStreamWriter::rawValue(std::string_view json)
+{
+    nextValue();
+    if (indentSize < 0) {
+        out.append(json);
+        return;
+    }
+    const auto start = out.size();
+    JsonFormatter formatter(out, json, indentSize);
+    if (!formatter.format(hasMembers.size())) {
+        out.resize(start);
+        appendIndented(out,
+                       dumpJson(nlohmann::json::parse(json), indentSize),
+                       hasMembers.size() * static_cast<std::size_t>(indentSize));
+    }
+}
+
 JsonMapBuilder::JsonMapBuilder() noexcept {}
 
 JsonMapBuilder::~JsonMapBuilder() = default;
@@ -27,6 +329,10 @@ nlohmann::json& JsonMapBuilder::getJValue()
     if (!jMap) {
         jMap = std::make_unique<nlohmann::json>();
     }
+    for (auto& component : components) {
+        (*jMap)[component.location].push_back(nlohmann::json::parse(component.json));
+    }
+    components.clear();
     return *jMap;
 }
 
@@ -46,17 +352,28 @@ bool JsonMapBuilder::addComponent(const std::string& info, int index) noexcept
 {
     auto loc = missing_components.find(index);
     if (loc != missing_components.end()) {
-        if (info == "#invalid") {
-            (*jMap)[loc->second.first].push_back(nlohmann::json::object());
-        } else {
-            try {
-                auto element = loadJsonStr(info);
-                (*jMap)[loc->second.first].push_back(element);
-            }
-            catch (const std::invalid_argument&) {
-                (*jMap)[loc->second.first].push_back(nlohmann::json::object());
+        auto& component = components.emplace_back();
+        component.location = loc->second.first;
+        component.code = loc->second.second;
+        if (info != "#invalid") {
+            // valid components are kept as is, others are normalized or replaced
+            if (nlohmann::json::accept(info)) {
+                component.json = info;
+            } else {
+                try {
+                    component.json = loadJsonStr(info).dump();
+                }
+                catch (const std::invalid_argument&) {
+                    component.json.clear();
+                }
+                catch (const nlohmann::json::type_error&) {
+                    component.json.clear();
+                }
             }
         }
+        if (component.json.empty()) {
+            component.json = "{}";
+        }
 
         missing_components.erase(loc);
 
@@ -65,6 +382,16 @@ bool JsonMapBuilder::addComponent(const std::string& info, int index) noexcept
     return false;
 }
 
+void JsonMapBuilder::addComponent(Component component)
+{
+    components.push_back(std::move(component));
+}
+
+std::vector<JsonMapBuilder::Component> JsonMapBuilder::extractComponents()
+{
+    return std::exchange(components, {});
+}
+
 bool JsonMapBuilder::clearComponents(int32_t code)
 {
     for (auto b = missing_components.begin(); b != missing_components.end(); ++b) {
@@ -82,18 +409,357 @@ bool JsonMapBuilder::clearComponents()
     return static_cast<bool>(jMap);
 }
 
-std::string JsonMapBuilder::generate()
+void JsonMapBuilder::writeMap(JsonStreamWriter& writer) const
+{
+    // the members are written in sorted order to match the ordering of a json object
+    std::set<std::string_view> locations;
+    for (const auto& component : components) {
+        locations.emplace(component.location);
+    }
+    auto writeLocation = [this, &writer](std::string_view location,
+                                         const nlohmann::json* existing) {
+        writer.key(location);
+        writer.beginArray();
+        if (existing != nullptr && existing->is_array()) {
+            for (const auto& element : *existing) {
+                writer.value(element);
+            }
+        }
+        for (const auto& component : components) {
+            if (component.location == location) {
+                writer.rawValue(component.json);
+            }
+        }
+        writer.endArray();
+    };
+    writer.beginObject();
+    auto location = locations.begin();
+    if (jMap && jMap->is_object()) {
+        for (const auto& element : jMap->items()) {
+            const std::string_view name = element.key();
+            while (location != locations.end() && *location < name) {
+                writeLocation(*location++, nullptr);
+            }
+            if (location != locations.end() && *location == name) {
+                writeLocation(*location++, &element.value());
+                continue;
+            }
+            writer.key(name);
+            writer.value(element.value());
+        }
+    }
+    while (location != locations.end()) {
+        writeLocation(*location++, nullptr);
+    }
+    writer.endObject();
+}
+
+std::string JsonMapBuilder::generateBase() const
 {
     if (jMap) {
-        return generateJsonString(*jMap);
+        return dumpJson(*jMap, -1);
     }
     return "{}";
 }
 
+std::string JsonMapBuilder::generate() const
+{
+    if (!jMap) {
+        return "{}";
+    }
+    std::string output;
+    JsonStreamWriter writer(output, jsonIndent);
+    writeMap(writer);
+    return output;
+}
+
 void JsonMapBuilder::reset()
 {
     jMap = nullptr;
     missing_components.clear();
+    components.clear();
+}
+
+/** check if a member is an array of objects with unique integer ids*/
+static bool isElementList(const nlohmann::json& member)
+{
+    if (!member.is_array()) {
+        return false;
+    }
+    std::set<std::int64_t> ids;
+    for (const auto& element : member) {
+        if (!element.is_object()) {
+            return false;
+        }
+        auto id = element.find("id");
+        if (id == element.end() || !id->is_number_integer() ||
+            !ids.insert(id->get<std::int64_t>()).second) {
+            return false;
+        }
+    }
+    return ids.count(std::numeric_limits<std::int64_t>::min()) == 0;
+}
+
+bool JsonMapHistory::updateItems(Entry& entry, std::uint64_t revision, bool& changed)
+{
+    auto component = nlohmann::json::parse(entry.json, nullptr, false);
+    if (!component.is_object()) {
+        return false;
+    }
+    std::set<std::pair<std::string, std::int64_t>> current;
+    auto setItem = [&entry, &current, &changed, revision](const std::string& name,
+                                                           std::int64_t element,
+                                                           std::string json,
+                                                           bool list) {
+        auto key = std::make_pair(name, element);
+        auto& item = entry.items[key];
+        if (item.revision == 0 || item.removed || item.list != list || item.json != json) {
+            item.json = std::move(json);
+            item.revision = revision;
+            item.removed = false;
+            item.list = list;
+            changed = true;
+        }
+        current.insert(std::move(key));
+    };
+    for (const auto& member : component.items()) {
+        if (isElementList(member.value())) {
+            setItem(member.key(), noElement, "[]", true);
+            for (const auto& element : member.value()) {
+                setItem(member.key(),
+                        element["id"].get<std::int64_t>(),
+                        dumpJson(element, -1),
+                        false);
+            }
+        } else {
+            setItem(member.key(), noElement, dumpJson(member.value(), -1), false);
+        }
+    }
+    for (auto& [key, item] : entry.items) {
+        if (!item.removed && current.count(key) == 0) {
+            item.json.clear();
+            item.revision = revision;
+            item.removed = true;
+            changed = true;
+        }
+    }
+    return true;
+}
+
+std::uint64_t JsonMapHistory::update(const JsonMapBuilder& builder)
+{
+    const std::uint64_t next{mRevision + 1};
+    bool changed{false};
+    auto base = builder.generateBase();
+    if (base != mBase) {
+        mBase = std::move(base);
+        mBaseRevision = next;
+        changed = true;
+    }
+    std::set<std::pair<std::string_view, int32_t>> current;
+    for (const auto& component : builder.getComponents()) {
+        current.emplace(component.location, component.code);
+        auto& entry = mEntries[std::make_pair(component.location, component.code)];
+        if (entry.revision == 0 || entry.removed) {
+            entry = Entry{};
+            entry.json = component.json;
+            entry.revision = next;
+            entry.added = next;
+            bool itemChanged{false};
+            updateItems(entry, next, itemChanged);
+            changed = true;
+        } else if (entry.json != component.json) {
+            entry.json = component.json;
+            bool itemChanged{false};
+            if (!updateItems(entry, next, itemChanged)) {
+                // components which can't be split are always sent whole
+                entry.items.clear();
+                entry.added = next;
+                itemChanged = true;
+            }
+            if (itemChanged) {
+                entry.revision = next;
+                changed = true;
+            }
+        }
+    }
+    for (auto& [key, entry] : mEntries) {
+        if (!entry.removed &&
+            current.count(std::make_pair(std::string_view(key.first), key.second)) == 0) {
+            entry.json.clear();
+            entry.items.clear();
+            entry.revision = next;
+            entry.removed = true;
+            changed = true;
+        }
+    }
+    if (changed) {
+        mRevision = next;
+        mSnapshot = builder.generate();
+    }
+    return mRevision;
+}
+
+void JsonMapHistory::writeChanges(JsonStreamWriter& writer,
+                                  int32_t code,
+                                  const Entry& entry,
+                                  std::uint64_t since)
+{
+    writer.beginObject();
+    writer.key("id");
+    writer.value(static_cast<std::int64_t>(code));
+    // the member item sorts ahead of its elements so each member is a contiguous block
+    const Item* member{nullptr};
+    const std::string* memberName{nullptr};
+    bool listOpen{false};
+    auto finishMember = [&]() {
+        if (listOpen) {
+            writer.endArray();
+        } else if (member != nullptr && member->list && !member->removed &&
+                   member->revision > since) {
+            writer.key(*memberName);
+            writer.beginArray();
+            writer.endArray();
+        }
+        listOpen = false;
+        member = nullptr;
+    };
+    for (const auto& [key, item] : entry.items) {
+        if (key.second == noElement) {
+            finishMember();
+            if (key.first == "id") {
+                continue;
+            }
+            member = &item;
+            memberName = &key.first;
+            if (!item.list && item.revision > since) {
+                writer.key(key.first);
+                writer.rawValue(item.removed ? std::string_view("null") : item.json);
+            } else if (item.removed && item.revision > since) {
+                writer.key(key.first);
+                writer.rawValue("null");
+            }
+            continue;
+        }
+        if (member == nullptr || member->removed || item.removed || item.revision <= since) {
+            continue;
+        }
+        if (!listOpen) {
+            writer.key(*memberName);
+            writer.beginArray();
+            listOpen = true;
+        }
+        writer.rawValue(item.json);
+    }
+    finishMember();
+    writer.endObject();
+}
+
+bool JsonMapHistory::hasRemovedElements(const Entry& entry, std::uint64_t since)
+{
+    return std::any_of(entry.items.begin(), entry.items.end(), [since](const auto& item) {
+        return item.first.second != noElement && item.second.removed &&
+            item.second.revision > since;
+    });
+}
+
+void JsonMapHistory::writeRemovedElements(JsonStreamWriter& writer,
+                                          int32_t code,
+                                          const Entry& entry,
+                                          std::uint64_t since)
+{
+    writer.beginObject();
+    writer.key("id");
+    writer.value(static_cast<std::int64_t>(code));
+    const std::string* memberName{nullptr};
+    for (const auto& [key, item] : entry.items) {
+        if (key.second == noElement || !item.removed || item.revision <= since) {
+            continue;
+        }
+        if (memberName == nullptr || *memberName != key.first) {
+            if (memberName != nullptr) {
+                writer.endArray();
+            }
+            memberName = &key.first;
+            writer.key(key.first);
+            writer.beginArray();
+        }
+        writer.value(key.second);
+    }
+    if (memberName != nullptr) {
+        writer.endArray();
+    }
+    writer.endObject();
+}
+
+std::string JsonMapHistory::generateDelta(std::uint64_t since) const
+{
+    if (since > mRevision) {
+        since = 0;
+    }
+    std::string output;
+    JsonStreamWriter writer(output);
+    writer.beginObject();
+    writer.key("revision");
+    writer.value(mRevision);
+    writer.key("since");
+    writer.value(since);
+    if (mBaseRevision > since) {
+        writer.key("base");
+        writer.rawValue(mBase);
+    }
+    // entries are sorted by location so each location is a contiguous block
+    const std::string* location{nullptr};
+    auto startEntry = [&writer, &location](std::string_view section, const std::string& name) {
+        if (location != nullptr && *location == name) {
+            return;
+        }
+        if (location == nullptr) {
+            writer.key(section);
+            writer.beginObject();
+        } else {
+            writer.endArray();
+        }
+        location = &name;
+        writer.key(name);
+        writer.beginArray();
+    };
+    auto endSection = [&writer, &location]() {
+        if (location != nullptr) {
+            writer.endArray();
+            writer.endObject();
+            location = nullptr;
+        }
+    };
+    for (const auto& [key, entry] : mEntries) {
+        if (entry.removed || entry.revision <= since) {
+            continue;
+        }
+        startEntry("updated", key.first);
+        if (entry.added > since) {
+            writer.rawValue(entry.json);
+        } else {
+            writeChanges(writer, key.second, entry, since);
+        }
+    }
+    endSection();
+    if (since > 0) {
+        for (const auto& [key, entry] : mEntries) {
+            if (entry.revision <= since) {
+                continue;
+            }
+            if (entry.removed) {
+                startEntry("removed", key.first);
+                writer.value(static_cast<std::int64_t>(key.second));
+            } else if (entry.added <= since && hasRemovedElements(entry, since)) {
+                startEntry("removed", key.first);
+                writeRemovedElements(writer, key.second, entry, since);
+            }
+        }
+        endSection();
+    }
+    writer.endObject();
+    return output;
 }
 
 JsonBuilder::JsonBuilder() noexcept {}
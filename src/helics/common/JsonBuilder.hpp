@@ -5,28 +5,87 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <nlohmann/json_fwd.hpp>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace helics::fileops {
 
-/** class handling the construction in pieces of a JSON map*/
+/** write JSON text directly to a string without building a document
+@details the output matches the formatting of generateJsonString for the same indentation*/
+class JsonStreamWriter {
+  public:
+    /** @param indent the number of spaces to indent nested values, negative for compact text*/
+    explicit JsonStreamWriter(std::string& output, int indent = -1):
+        out(output), indentSize(indent)
+    {
+    }
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    /** write the name of the next member of an object*/
+    void key(std::string_view name);
+    void value(std::string_view str);
+    void value(const char* str) { value(std::string_view(str)); }
+    void value(std::int64_t number);
+    void value(std::uint64_t number);
+    /** write a value from a JSON document*/
+    void value(const nlohmann::json& json);
+    /** write text which is already valid JSON, it is reformatted if the writer indents*/
+    void rawValue(std::string_view json);
+
+  private:
+    /** write a separator if needed before the next value*/
+    void nextValue();
+    /** start a new line at the current indentation*/
+    void newLine();
+
+    std::string& out;
+    int indentSize{-1};
+    std::vector<bool> hasMembers;  //!< whether each open container already has a value
+    bool afterKey{false};
+};
+
+/** class handling the construction in pieces of a JSON map
+@details components are stored as JSON text and written directly into the generated string, they
+are only parsed if the JSON value is requested*/
 class JsonMapBuilder {
+  public:
+    /** the indentation of the generated map*/
+    static constexpr int jsonIndent{3};
+    /** a filled place holder*/
+    struct Component {
+        std::string location;
+        int32_t code{0};
+        std::string json;
+    };
+
   private:
     std::unique_ptr<nlohmann::json> jMap;
     std::map<int, std::pair<std::string, int32_t>> missing_components;
+    std::vector<Component> components;
     int counterCode{0};  // a code for the user to include for various purposes
+    /** write the map and the components*/
+    void writeMap(JsonStreamWriter& writer) const;
+
   public:
     JsonMapBuilder() noexcept;
     ~JsonMapBuilder();
     JsonMapBuilder(JsonMapBuilder&& map) noexcept = default;
     JsonMapBuilder& operator=(JsonMapBuilder&& map) = default;
-    /** get the underlying json object*/
+    /** get the underlying json object, this includes any components added*/
     nlohmann::json& getJValue();
+    /** get the components that have been added and not yet merged into the json object*/
+    const std::vector<Component>& getComponents() const { return components; }
+    /** generate the JSON value without the components*/
+    std::string generateBase() const;
     /** check if the map has completed*/
     bool isCompleted() const;
     // check whether a map is currently completed or under construction
@@ -37,6 +96,10 @@ class JsonMapBuilder {
     @return true if successfully added
     */
     bool addComponent(const std::string& info, int index) noexcept;
+    /** add a component which was previously received and does not need a place holder*/
+    void addComponent(Component component);
+    /** remove and return the components so they can be carried into a rebuilt map*/
+    std::vector<Component> extractComponents();
     /** generate a new location to fill in later
     @return the index value of the location for use in addComponent*/
     int generatePlaceHolder(const std::string& location, int32_t code);
@@ -47,7 +110,7 @@ class JsonMapBuilder {
     return true if the builder can be generated*/
     bool clearComponents();
     /** generate the JSON value*/
-    std::string generate();
+    std::string generate() const;
     /** reset the builder*/
     void reset();
     /** set the counter code value*/
@@ -55,6 +118,62 @@ class JsonMapBuilder {
     int getCounterCode() const { return counterCode; }
 };
 
+/** keep the last completed version of a JSON map so repeated requests can be answered with the
+changes since a previous revision
+@details the members of each component are tracked separately, members which are arrays of objects
+with unique integer "id" values are tracked by element*/
+class JsonMapHistory {
+  public:
+    /** record a completed map, the revision is incremented if anything changed
+    @return the current revision*/
+    std::uint64_t update(const JsonMapBuilder& builder);
+    std::uint64_t revision() const { return mRevision; }
+    /** get the full map as of the current revision*/
+    const std::string& snapshot() const { return mSnapshot; }
+    /** generate a JSON object containing the changes since a previous revision
+    @details revision 0 or an unknown revision generates all the components*/
+    std::string generateDelta(std::uint64_t since) const;
+
+  private:
+    /** a member of a component or an element of a member array*/
+    struct Item {
+        std::string json;
+        std::uint64_t revision{0};
+        bool removed{false};
+        bool list{false};  //!< the member is an array with elements tracked separately
+    };
+    struct Entry {
+        std::string json;
+        std::uint64_t revision{0};
+        std::uint64_t added{0};  //!< the revision the component was added
+        bool removed{false};
+        /** the items keyed by member name and element id, noElement for the member itself*/
+        std::map<std::pair<std::string, std::int64_t>, Item> items;
+    };
+    static constexpr std::int64_t noElement{std::numeric_limits<std::int64_t>::min()};
+    /** update the items of an entry from the text of a component
+    @return false if the component is not an object*/
+    static bool updateItems(Entry& entry, std::uint64_t revision, bool& changed);
+    /** write the members of a component which changed since a revision*/
+    static void writeChanges(JsonStreamWriter& writer,
+                             int32_t code,
+                             const Entry& entry,
+                             std::uint64_t since);
+    /** check if any elements were removed from a component since a revision*/
+    static bool hasRemovedElements(const Entry& entry, std::uint64_t since);
+    /** write the elements removed from a component since a revision*/
+    static void writeRemovedElements(JsonStreamWriter& writer,
+                                     int32_t code,
+                                     const Entry& entry,
+                                     std::uint64_t since);
+
+    std::map<std::pair<std::string, int32_t>, Entry> mEntries;
+    std::string mBase;
+    std::string mSnapshot;
+    std::uint64_t mBaseRevision{0};
+    std::uint64_t mRevision{0};
+};
+
 /** class to help with the generation of JSON*/
 class JsonBuilder {
   private:
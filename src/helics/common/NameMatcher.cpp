@@ -0,0 +1,324 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "NameMatcher.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+namespace helics {
+
+/// the `.` wildcard of an ECMAScript expression does not match line terminators
+static bool isLineTerminator(char test)
+{
+    return test == '\n' || test == '\r';
+}
+
+static bool isQuantifier(char test)
+{
+    return test == '*' || test == '+' || test == '?' || test == '{';
+}
+
+static bool isMetaCharacter(char test)
+{
+    switch (test) {
+        case '\\':
+        case '^':
+        case '$':
+        case '.':
+        case '|':
+        case '?':
+        case '*':
+        case '+':
+        case '(':
+        case ')':
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** get the literal prefix of an arbitrary regular expression
+@details the prefix stops at the first special character, a literal followed by a quantifier is
+optional so is excluded, and any alternation makes the prefix empty*/
+static std::string regexPrefix(std::string_view expression)
+{
+    int depth{0};
+    bool inClass{false};
+    for (std::size_t ii = 0; ii < expression.size(); ++ii) {
+        const char test = expression[ii];
+        if (test == '\\') {
+            ++ii;
+        } else if (inClass) {
+            inClass = (test != ']');
+        } else if (test == '[') {
+            inClass = true;
+        } else if (test == '(') {
+            ++depth;
+        } else if (test == ')') {
+            --depth;
+        } else if (test == '|' && depth == 0) {
+            return {};
+        }
+    }
+    std::string prefix;
+    for (std::size_t ii = 0; ii < expression.size(); ++ii) {
+        char test = expression[ii];
+        std::size_t next{ii + 1};
+        if (test == '\\') {
+            if (next >= expression.size() ||
+                std::isalnum(static_cast<unsigned char>(expression[next])) != 0) {
+                break;
+            }
+            test = expression[next];
+            ++next;
+        } else if (isMetaCharacter(test)) {
+            if (ii == 0 && test == '^') {
+                continue;
+            }
+            break;
+        }
+        if (next < expression.size() && isQuantifier(expression[next])) {
+            break;
+        }
+        prefix.push_back(test);
+        ii = next - 1;
+    }
+    return prefix;
+}
+
+NamePattern::NamePattern(std::string_view expression): mExpression(expression)
+{
+    bool globCompatible{true};
+    std::string literal;
+    auto pushToken = [this, &literal](GlobToken::Kind kind) {
+        if (!literal.empty()) {
+            mTokens.push_back({GlobToken::Kind::LITERAL, std::move(literal)});
+            literal.clear();
+        }
+        if (kind != GlobToken::Kind::LITERAL) {
+            mTokens.push_back({kind, std::string{}});
+        }
+    };
+    for (std::size_t ii = 0; ii < expression.size() && globCompatible; ++ii) {
+        const char test = expression[ii];
+        const bool hasNext = ii + 1 < expression.size();
+        if (test == '\\') {
+            // only escaped punctuation is a literal, classes such as \d need the regex engine
+            if (!hasNext || std::isalnum(static_cast<unsigned char>(expression[ii + 1])) != 0) {
+                globCompatible = false;
+                break;
+            }
+            ++ii;
+            if (ii + 1 < expression.size() && isQuantifier(expression[ii + 1])) {
+                globCompatible = false;
+                break;
+            }
+            literal.push_back(expression[ii]);
+        } else if (test == '.') {
+            if (hasNext && expression[ii + 1] == '*') {
+                pushToken(GlobToken::Kind::ANY_SEQUENCE);
+                ++ii;
+            } else if (hasNext && expression[ii + 1] == '+') {
+                pushToken(GlobToken::Kind::ANY_CHAR);
+                pushToken(GlobToken::Kind::ANY_SEQUENCE);
+                ++ii;
+            } else {
+                pushToken(GlobToken::Kind::ANY_CHAR);
+            }
+            if (ii + 1 < expression.size() && isQuantifier(expression[ii + 1])) {
+                globCompatible = false;
+            }
+        } else if (isMetaCharacter(test)) {
+            // anchors are implied since the whole name must match
+            if ((test == '^' && ii == 0) || (test == '$' && !hasNext)) {
+                continue;
+            }
+            globCompatible = false;
+        } else {
+            if (hasNext && isQuantifier(expression[ii + 1])) {
+                globCompatible = false;
+                break;
+            }
+            literal.push_back(test);
+        }
+    }
+    if (globCompatible) {
+        pushToken(GlobToken::Kind::LITERAL);
+        if (!mTokens.empty() && mTokens.front().kind == GlobToken::Kind::LITERAL) {
+            mPrefix = mTokens.front().text;
+        }
+        if (mTokens.empty() ||
+            (mTokens.size() == 1 && mTokens.front().kind == GlobToken::Kind::LITERAL)) {
+            mTier = PatternTier::LITERAL;
+        } else if (mTokens.back().kind == GlobToken::Kind::ANY_SEQUENCE &&
+                   (mTokens.size() == 1 ||
+                    (mTokens.size() == 2 && mTokens.front().kind == GlobToken::Kind::LITERAL))) {
+            mTier = PatternTier::PREFIX;
+        } else {
+            mTier = PatternTier::GLOB;
+        }
+        return;
+    }
+    mTokens.clear();
+    mTier = PatternTier::REGEX;
+    mPrefix = regexPrefix(expression);
+    try {
+        mRegex.emplace(mExpression);
+    }
+    catch (const std::regex_error& re) {
+        throw std::invalid_argument(re.what());
+    }
+}
+
+bool NamePattern::globMatch(std::string_view name) const
+{
+    // greedy wildcard matching, backtracking to the last sequence wildcard on a mismatch
+    std::size_t token{0};
+    std::size_t position{0};
+    std::size_t starToken{mTokens.size()};
+    std::size_t starPosition{0};
+    while (true) {
+        if (token < mTokens.size()) {
+            const auto& current = mTokens[token];
+            switch (current.kind) {
+                case GlobToken::Kind::ANY_SEQUENCE:
+                    starToken = token++;
+                    starPosition = position;
+                    continue;
+                case GlobToken::Kind::ANY_CHAR:
+                    if (position < name.size() && !isLineTerminator(name[position])) {
+                        ++token;
+                        ++position;
+                        continue;
+                    }
+                    break;
+                case GlobToken::Kind::LITERAL:
+                    if (name.compare(position, current.text.size(), current.text) == 0) {
+                        ++token;
+                        position += current.text.size();
+                        continue;
+                    }
+                    break;
+            }
+        } else if (position == name.size()) {
+            return true;
+        }
+        if (starToken == mTokens.size() || starPosition >= name.size() ||
+            isLineTerminator(name[starPosition])) {
+            return false;
+        }
+        token = starToken + 1;
+        position = ++starPosition;
+    }
+}
+
+bool NamePattern::matches(std::string_view name) const
+{
+    switch (mTier) {
+        case PatternTier::LITERAL:
+            return name == mPrefix;
+        case PatternTier::PREFIX:
+            return name.compare(0, mPrefix.size(), mPrefix) == 0 &&
+                name.find_first_of("\n\r", mPrefix.size()) == std::string_view::npos;
+        case PatternTier::GLOB:
+            return globMatch(name);
+        case PatternTier::REGEX:
+        default:
+            return name.compare(0, mPrefix.size(), mPrefix) == 0 &&
+                std::regex_match(name.begin(), name.end(), *mRegex);
+    }
+}
+
+NameMatcher::NameMatcher(std::vector<std::string_view> names)
+{
+    setNames(std::move(names));
+}
+
+void NameMatcher::setNames(std::vector<std::string_view> names)
+{
+    mNames = std::move(names);
+    std::sort(mNames.begin(), mNames.end());
+}
+
+std::vector<std::vector<std::string_view>>
+    NameMatcher::match(const std::vector<NamePattern>& patterns)
+{
+    const auto start = std::chrono::steady_clock::now();
+    mStats = NameMatchStatistics{};
+    mStats.names = mNames.size();
+    std::vector<std::vector<std::string_view>> results(patterns.size());
+    // regex patterns without a prefix are evaluated together in one pass over the names
+    std::vector<std::size_t> fullScan;
+
+    for (std::size_t ii = 0; ii < patterns.size(); ++ii) {
+        const auto& pattern = patterns[ii];
+        ++mStats.patterns[static_cast<int>(pattern.tier())];
+        const auto& prefix = pattern.prefix();
+        if (pattern.tier() == PatternTier::LITERAL) {
+            if (std::binary_search(mNames.begin(), mNames.end(), std::string_view(prefix))) {
+                results[ii].emplace_back(*std::lower_bound(mNames.begin(),
+                                                           mNames.end(),
+                                                           std::string_view(prefix)));
+            }
+            continue;
+        }
+        if (pattern.tier() == PatternTier::REGEX && prefix.empty()) {
+            fullScan.push_back(ii);
+            continue;
+        }
+        auto first = std::lower_bound(mNames.begin(), mNames.end(), std::string_view(prefix));
+        auto last = std::partition_point(first, mNames.end(), [&prefix](std::string_view name) {
+            return name.compare(0, prefix.size(), prefix) == 0;
+        });
+        mStats.comparisons += static_cast<std::size_t>(last - first);
+        for (auto name = first; name != last; ++name) {
+            if (pattern.matches(*name)) {
+                results[ii].push_back(*name);
+            }
+        }
+    }
+    if (!fullScan.empty()) {
+        mStats.comparisons += fullScan.size() * mNames.size();
+        for (const auto& name : mNames) {
+            for (auto index : fullScan) {
+                if (std::regex_match(name.begin(), name.end(), *patterns[index].regex())) {
+                    results[index].push_back(name);
+                }
+            }
+        }
+    }
+    for (const auto& result : results) {
+        mStats.matches += result.size();
+    }
+    mStats.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return results;
+}
+
+const char* patternTierName(PatternTier tier)
+{
+    switch (tier) {
+        case PatternTier::LITERAL:
+            return "literal";
+        case PatternTier::PREFIX:
+            return "prefix";
+        case PatternTier::GLOB:
+            return "glob";
+        case PatternTier::REGEX:
+        default:
+            return "regex";
+    }
+}
+
+}  // namespace helics
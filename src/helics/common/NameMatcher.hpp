@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace helics {
+
+/** the cheapest strategy that can evaluate a name pattern*/
+enum class PatternTier : std::uint8_t {
+    LITERAL = 0,  //!< the pattern matches a single name exactly
+    PREFIX = 1,  //!< the pattern matches every name starting with a literal prefix
+    GLOB = 2,  //!< the pattern only uses literals and the `.` and `.*` wildcards
+    REGEX = 3  //!< the pattern needs a full regular expression
+};
+
+/** a regular expression matched against a complete interface name
+@details the expression is classified when it is constructed; literal, prefix, and glob patterns
+are evaluated without a regular expression engine*/
+class NamePattern {
+  public:
+    /** construct from an ECMAScript regular expression
+    @throw std::invalid_argument if the expression is not a valid regular expression*/
+    explicit NamePattern(std::string_view expression);
+    PatternTier tier() const { return mTier; }
+    /** the literal text every matching name must start with*/
+    const std::string& prefix() const { return mPrefix; }
+    const std::string& expression() const { return mExpression; }
+    /** check if a complete name matches the pattern*/
+    bool matches(std::string_view name) const;
+    /** get the compiled expression, only available for the REGEX tier*/
+    const std::regex* regex() const { return mRegex ? &(*mRegex) : nullptr; }
+
+  private:
+    /** a piece of a glob pattern*/
+    struct GlobToken {
+        enum class Kind : std::uint8_t { LITERAL, ANY_CHAR, ANY_SEQUENCE };
+        Kind kind{Kind::LITERAL};
+        std::string text;
+    };
+    bool globMatch(std::string_view name) const;
+
+    std::string mExpression;
+    std::string mPrefix;
+    PatternTier mTier{PatternTier::REGEX};
+    std::vector<GlobToken> mTokens;
+    std::optional<std::regex> mRegex;
+};
+
+/** counters describing the last evaluation of a set of patterns*/
+struct NameMatchStatistics {
+    std::size_t names{0};  //!< the number of names searched
+    std::size_t patterns[4]{0, 0, 0, 0};  //!< the number of patterns in each PatternTier
+    std::size_t comparisons{0};  //!< the number of names each pattern was tested against
+    std::size_t matches{0};  //!< the total number of matches found
+    std::chrono::nanoseconds duration{0};  //!< the time taken to find the matches
+};
+
+/** matches a set of patterns against an index of names
+@details the names are sorted so literal and prefix patterns are answered with a binary search
+and glob and regex patterns only test names which share their literal prefix.  Regex patterns
+without a prefix are evaluated together in a single pass over the names.
+*/
+class NameMatcher {
+  public:
+    NameMatcher() = default;
+    /** construct from a set of names, the underlying strings must outlive the matcher*/
+    explicit NameMatcher(std::vector<std::string_view> names);
+    /** replace the indexed names, the underlying strings must outlive the matcher*/
+    void setNames(std::vector<std::string_view> names);
+    /** find the names matching each pattern
+    @return a vector with the sorted matching names for each pattern*/
+    std::vector<std::vector<std::string_view>> match(const std::vector<NamePattern>& patterns);
+    /** get the statistics of the last call to match*/
+    const NameMatchStatistics& statistics() const { return mStats; }
+    std::size_t size() const { return mNames.size(); }
+
+  private:
+    std::vector<std::string_view> mNames;
+    NameMatchStatistics mStats;
+};
+
+/** get a string description of a pattern tier*/
+const char* patternTierName(PatternTier tier);
+
+}  // namespace helics
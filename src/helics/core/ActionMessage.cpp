@@ -11,12 +11,15 @@ SPDX-License-Identifier: BSD-3-Clause
 #endif
 
 #include "ActionMessage.hpp"
+#include "ActionMessageCodec.hpp"
 
 #include "../common/JsonProcessingFunctions.hpp"
+#include "MessagePool.hpp"
 #include "flagOperations.hpp"
 #include "gmlc/utilities/base64.h"
 
 #include <algorithm>
+#include <charconv>
 #include <complex>
 #include <cstring>
 #include <fmt/format.h>
@@ -61,12 +64,20 @@ ActionMessage::ActionMessage(const ActionMessage& act):
 
 ActionMessage::ActionMessage(std::unique_ptr<Message> message):
     messageAction(CMD_SEND_MESSAGE), messageID(message->messageID), flags(message->flags),
-    actionTime(message->time), payload(std::move(message->data)),
-    stringData({std::move(message->dest),
-                std::move(message->source),
-                std::move(message->original_source),
-                std::move(message->original_dest)})
+    actionTime(message->time), payload(std::move(message->data))
 {
+    moveMessageStrings(*message);
+    releaseMessage(std::move(message));
+}
+
+void ActionMessage::moveMessageStrings(Message& message)
+{
+    // an initializer list would copy the strings since its elements are const
+    stringData.resize(4);
+    stringData[0] = std::move(message.dest);
+    stringData[1] = std::move(message.source);
+    stringData[2] = std::move(message.original_source);
+    stringData[3] = std::move(message.original_dest);
 }
 
 ActionMessage::ActionMessage(const std::string& bytes): ActionMessage()
@@ -133,10 +144,8 @@ ActionMessage& ActionMessage::operator=(std::unique_ptr<Message> message) noexce
     flags = message->flags;
     payload = std::move(message->data);
     actionTime = message->time;
-    stringData = {std::move(message->dest),
-                  std::move(message->source),
-                  std::move(message->original_source),
-                  std::move(message->original_dest)};
+    moveMessageStrings(*message);
+    releaseMessage(std::move(message));
     return *this;
 }
 
@@ -434,6 +443,11 @@ std::size_t ActionMessage::fromByteArray(const std::byte* data, std::size_t buff
 {
     std::size_t tsize{action_message_base_size};
     static const uint8_t littleEndian = isLittleEndian();
+    if (buffer_size > 0 && data[0] == compactEncodingMarker) {
+        // compact encoding without a connection specific intern table
+        CompactMessageDecoder decoder;
+        return decoder.decode(data, buffer_size, *this);
+    }
     if (buffer_size < tsize) {
         messageAction = CMD_INVALID;
         return (0);
@@ -678,7 +692,7 @@ std::size_t ActionMessage::from_vector(const std::vector<char>& data)
 
 std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd)
 {
-    auto msg = std::make_unique<Message>();
+    auto msg = acquireMessage();
     switch (cmd.stringData.size()) {
         case 0:
             break;
@@ -711,7 +725,7 @@ std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd)
 
 std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd)
 {
-    auto msg = std::make_unique<Message>();
+    auto msg = acquireMessage();
     switch (cmd.stringData.size()) {
         case 0:
             break;
@@ -744,7 +758,7 @@ std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd)
 static constexpr char unknownStr[] = "unknown";
 
 // Map to translate the action to a description
-static constexpr frozen::unordered_map<action_message_def::action_t, std::string_view, 96>
+static constexpr frozen::unordered_map<action_message_def::action_t, std::string_view, 97>
     actionStrings = {
         // priority commands
         {action_message_def::action_t::cmd_priority_disconnect, "priority_disconnect"},
@@ -791,6 +805,7 @@ static constexpr frozen::unordered_map<action_message_def::action_t, std::string
         {action_message_def::action_t::cmd_time_unblock, "time_unblock"},
         {action_message_def::action_t::cmd_request_current_time, "request current time"},
         {action_message_def::action_t::cmd_pub, "pub"},
+        {action_message_def::action_t::cmd_multicast_pub, "multicast_pub"},
         {action_message_def::action_t::cmd_bye, "bye"},
         {action_message_def::action_t::cmd_log, "log"},
         {action_message_def::action_t::cmd_warning, "warning"},
@@ -921,6 +936,15 @@ std::string prettyPrintString(const ActionMessage& command)
                                    static_cast<double>(command.actionTime),
                                    command.dest_id.baseValue()));
             break;
+        case CMD_MULTICAST_PUB:
+            ret.push_back(':');
+            ret.append(fmt::format("From ({}) handle({}) size {} at {} to {}",
+                                   command.source_id.baseValue(),
+                                   command.source_handle.baseValue(),
+                                   command.payload.size(),
+                                   static_cast<double>(command.actionTime),
+                                   command.getString(0)));
+            break;
         case CMD_REG_BROKER:
             ret.push_back(':');
             ret.append(command.name());
@@ -979,6 +1003,61 @@ int appendMessage(ActionMessage& multiMessage, const ActionMessage& newMessage)
     return (-1);
 }
 
+void setMulticastDestinations(ActionMessage& command, const std::vector<GlobalHandle>& destinations)
+{
+    // stored as text so the list survives json serialization as well as the binary format
+    std::string targets;
+    targets.reserve(destinations.size() * 16);
+    for (const auto& dest : destinations) {
+        targets.append(std::to_string(dest.fed_id.baseValue()));
+        targets.push_back(':');
+        targets.append(std::to_string(dest.handle.baseValue()));
+        targets.push_back(';');
+    }
+    command.setStringData(targets);
+}
+
+std::vector<GlobalHandle> getMulticastDestinations(const ActionMessage& command)
+{
+    std::vector<GlobalHandle> destinations;
+    const std::string_view targets = command.getString(0);
+    const char* current = targets.data();
+    const char* end = targets.data() + targets.size();
+    while (current < end) {
+        GlobalFederateId::BaseType fed{0};
+        InterfaceHandle::BaseType handle{0};
+        auto res = std::from_chars(current, end, fed);
+        if (res.ec != std::errc() || res.ptr == end || *res.ptr != ':') {
+            break;
+        }
+        res = std::from_chars(res.ptr + 1, end, handle);
+        if (res.ec != std::errc()) {
+            break;
+        }
+        destinations.emplace_back(GlobalFederateId(fed), InterfaceHandle(handle));
+        current = (res.ptr < end && *res.ptr == ';') ? res.ptr + 1 : res.ptr;
+    }
+    return destinations;
+}
+
+ActionMessage generateMulticastSubset(const ActionMessage& multicast,
+                                      const std::vector<GlobalHandle>& targets)
+{
+    ActionMessage pub((targets.size() == 1) ? CMD_PUB : CMD_MULTICAST_PUB);
+    pub.source_id = multicast.source_id;
+    pub.source_handle = multicast.source_handle;
+    pub.counter = multicast.counter;
+    pub.flags = multicast.flags;
+    pub.actionTime = multicast.actionTime;
+    if (!targets.empty()) {
+        pub.setDestination(targets.front());
+    }
+    if (targets.size() > 1) {
+        setMulticastDestinations(pub, targets);
+    }
+    return pub;
+}
+
 void setIterationFlags(ActionMessage& command, IterationRequest iterate)
 {
     switch (iterate) {
@@ -63,7 +63,8 @@ class ActionMessage {
                   GlobalFederateId destId);
     /** move constructor*/
     ActionMessage(ActionMessage&& act) noexcept;
-    /** build an action message from a message*/
+    /** build an action message from a message
+    @details the emptied message object is released for reuse by createMessageFromCommand*/
     explicit ActionMessage(std::unique_ptr<Message> message);
     /** construct from a string*/
     explicit ActionMessage(const std::string& bytes);
@@ -206,6 +207,10 @@ class ActionMessage {
 
     friend std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd);
     friend std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd);
+
+  private:
+    /** move the address strings of a message into the stringData*/
+    void moveMessageStrings(Message& message);
 };
 
 inline bool operator<(const ActionMessage& cmd, const ActionMessage& cmd2)
@@ -214,12 +219,12 @@ inline bool operator<(const ActionMessage& cmd, const ActionMessage& cmd2)
 }
 
 /** create a new multiMessage object that copies all the information from the ActionMessage into
- * newly allocated memory for the multiMessage
+ * a recycled or newly allocated multiMessage
  */
 std::unique_ptr<Message> createMessageFromCommand(const ActionMessage& cmd);
 
 /** create a new multiMessage object that moves all the information from the ActionMessage into
- * newly allocated memory for the multiMessage
+ * a recycled or newly allocated multiMessage
  */
 std::unique_ptr<Message> createMessageFromCommand(ActionMessage&& cmd);
 
@@ -356,6 +361,23 @@ std::ostream& operator<<(std::ostream& out, const ActionMessage& command);
 @return the integer location of the multiMessage in the stringData section*/
 int appendMessage(ActionMessage& multiMessage, const ActionMessage& newMessage);
 
+/** store the set of destinations for a CMD_MULTICAST_PUB message in its string data
+@param command the message to store the destinations in
+@param destinations the set of handles the payload should be delivered to*/
+void setMulticastDestinations(ActionMessage& command, const std::vector<GlobalHandle>& destinations);
+
+/** extract the set of destinations from a CMD_MULTICAST_PUB message*/
+std::vector<GlobalHandle> getMulticastDestinations(const ActionMessage& command);
+
+/** generate a publication message for a subset of the destinations of a multicast publication
+@details generates a CMD_PUB if there is a single target otherwise a CMD_MULTICAST_PUB, the payload
+is not copied so the caller can decide whether to copy or move it
+@param multicast the original multicast publication message
+@param targets the destinations to include in the new message
+*/
+ActionMessage generateMulticastSubset(const ActionMessage& multicast,
+                                      const std::vector<GlobalHandle>& targets);
+
 /** generate a string representing an error from an ActionMessage
 @param command the command to generate the error string for
 @return a string describing the error, if the string is not an error the string is empty
@@ -0,0 +1,424 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "ActionMessageCodec.hpp"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace helics {
+// the framing characters must match those used in ActionMessage::packetize
+constexpr auto LEADING_CHAR = '\xF3';
+constexpr auto TAIL_CHAR1 = '\xFA';
+constexpr auto TAIL_CHAR2 = '\xFC';
+
+/// strings longer than this are always sent as literals
+static constexpr std::size_t maxInternedStringSize{128};
+/// the maximum number of strings interned on a single connection
+static constexpr std::size_t maxInternedStrings{4096};
+
+/// bits of the presence bitmap
+enum CompactFields : std::uint32_t {
+    message_id_field = 1U << 0U,
+    source_id_field = 1U << 1U,
+    source_handle_field = 1U << 2U,
+    dest_id_field = 1U << 3U,
+    dest_handle_field = 1U << 4U,
+    counter_field = 1U << 5U,
+    flags_field = 1U << 6U,
+    sequence_field = 1U << 7U,
+    action_time_field = 1U << 8U,
+    te_field = 1U << 9U,
+    tdemin_field = 1U << 10U,
+    tso_field = 1U << 11U,
+    payload_field = 1U << 12U,
+    strings_field = 1U << 13U,
+    /// instruct the decoder to clear its intern table before processing the message
+    reset_table_field = 1U << 14U,
+};
+
+/// string tags, values above string_reference are intern table indices
+enum StringTag : std::uint32_t {
+    string_literal = 0,
+    string_intern = 1,
+    string_reference = 2,
+};
+
+static constexpr std::uint64_t zigzag(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1U) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+static constexpr std::int64_t unzigzag(std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1U) ^ -static_cast<std::int64_t>(value & 1U);
+}
+
+static inline std::byte* writeVarint(std::byte* data, std::uint64_t value)
+{
+    while (value >= 0x80U) {
+        *data++ = static_cast<std::byte>((value & 0x7FU) | 0x80U);
+        value >>= 7U;
+    }
+    *data++ = static_cast<std::byte>(value);
+    return data;
+}
+
+static inline bool
+    readVarint(const std::byte*& data, const std::byte* end, std::uint64_t& value)
+{
+    value = 0;
+    unsigned int shift{0};
+    while (data < end && shift < 64) {
+        const auto byte = std::to_integer<std::uint64_t>(*data++);
+        value |= (byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0) {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+/** time deltas are computed with wrapping arithmetic so extreme values cannot overflow*/
+static inline std::uint64_t timeDelta(Time value, Time base)
+{
+    return zigzag(static_cast<std::int64_t>(static_cast<std::uint64_t>(value.getBaseTimeCode()) -
+                                            static_cast<std::uint64_t>(base.getBaseTimeCode())));
+}
+
+static inline Time timeFromDelta(std::uint64_t delta, Time base)
+{
+    Time result;
+    result.setBaseTimeCode(static_cast<Time::baseType>(
+        static_cast<std::uint64_t>(base.getBaseTimeCode()) +
+        static_cast<std::uint64_t>(unzigzag(delta))));
+    return result;
+}
+
+static constexpr std::size_t maxVarintSize{10};
+
+std::size_t CompactMessageEncoder::encode(const ActionMessage& cmd, std::string& data)
+{
+    static const ActionMessage defaults;
+    const auto& strings = cmd.getStringData();
+
+    std::uint32_t present{0};
+    if (cmd.messageID != 0) {
+        present |= message_id_field;
+    }
+    if (cmd.source_id != defaults.source_id) {
+        present |= source_id_field;
+    }
+    if (cmd.source_handle != defaults.source_handle) {
+        present |= source_handle_field;
+    }
+    if (cmd.dest_id != defaults.dest_id) {
+        present |= dest_id_field;
+    }
+    if (cmd.dest_handle != defaults.dest_handle) {
+        present |= dest_handle_field;
+    }
+    if (cmd.counter != 0) {
+        present |= counter_field;
+    }
+    if (cmd.flags != 0) {
+        present |= flags_field;
+    }
+    if (cmd.sequenceID != 0) {
+        present |= sequence_field;
+    }
+    if (cmd.actionTime != timeZero) {
+        present |= action_time_field;
+    }
+    if (cmd.Te != timeZero) {
+        present |= te_field;
+    }
+    if (cmd.Tdemin != timeZero) {
+        present |= tdemin_field;
+    }
+    if (cmd.Tso != timeZero) {
+        present |= tso_field;
+    }
+    if (!cmd.payload.empty()) {
+        present |= payload_field;
+    }
+    if (!strings.empty()) {
+        present |= strings_field;
+    }
+    if (interning && resetPending) {
+        present |= reset_table_field;
+        resetPending = false;
+    }
+
+    // compute an upper bound on the size
+    std::size_t bound = 2 + 14 * maxVarintSize + cmd.payload.size();
+    for (const auto& str : strings) {
+        bound += 2 * maxVarintSize + str.size();
+    }
+    const auto start = data.size();
+    data.resize(start + bound);
+    auto* begin = reinterpret_cast<std::byte*>(data.data()) + start;
+    auto* out = begin;
+
+    *out++ = compactEncodingMarker;
+    *out++ = static_cast<std::byte>(compactEncodingVersion);
+    out = writeVarint(out, zigzag(static_cast<std::int32_t>(cmd.action())));
+    out = writeVarint(out, present);
+    if ((present & message_id_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.messageID));
+    }
+    if ((present & source_id_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.source_id.baseValue()));
+    }
+    if ((present & source_handle_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.source_handle.baseValue()));
+    }
+    if ((present & dest_id_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.dest_id.baseValue()));
+    }
+    if ((present & dest_handle_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.dest_handle.baseValue()));
+    }
+    if ((present & counter_field) != 0) {
+        out = writeVarint(out, cmd.counter);
+    }
+    if ((present & flags_field) != 0) {
+        out = writeVarint(out, cmd.flags);
+    }
+    if ((present & sequence_field) != 0) {
+        out = writeVarint(out, cmd.sequenceID);
+    }
+    if ((present & action_time_field) != 0) {
+        out = writeVarint(out, zigzag(cmd.actionTime.getBaseTimeCode()));
+    }
+    if ((present & te_field) != 0) {
+        out = writeVarint(out, timeDelta(cmd.Te, cmd.actionTime));
+    }
+    if ((present & tdemin_field) != 0) {
+        out = writeVarint(out, timeDelta(cmd.Tdemin, cmd.actionTime));
+    }
+    if ((present & tso_field) != 0) {
+        out = writeVarint(out, timeDelta(cmd.Tso, cmd.actionTime));
+    }
+    if ((present & payload_field) != 0) {
+        out = writeVarint(out, cmd.payload.size());
+        std::memcpy(out, cmd.payload.data(), cmd.payload.size());
+        out += cmd.payload.size();
+    }
+    if ((present & strings_field) != 0) {
+        out = writeVarint(out, strings.size());
+        for (const auto& str : strings) {
+            if (interning && !str.empty() && str.size() <= maxInternedStringSize) {
+                auto fnd = internTable.find(str);
+                if (fnd != internTable.end()) {
+                    out = writeVarint(out, string_reference + std::uint64_t{fnd->second});
+                    continue;
+                }
+                if (internTable.size() < maxInternedStrings) {
+                    internTable.emplace(str, static_cast<std::uint32_t>(internTable.size()));
+                    out = writeVarint(out, string_intern);
+                } else {
+                    out = writeVarint(out, string_literal);
+                }
+            } else {
+                out = writeVarint(out, string_literal);
+            }
+            out = writeVarint(out, str.size());
+            std::memcpy(out, str.data(), str.size());
+            out += str.size();
+        }
+    }
+    const auto used = static_cast<std::size_t>(out - begin);
+    data.resize(start + used);
+    return used;
+}
+
+void CompactMessageEncoder::packetize(const ActionMessage& cmd, std::string& data)
+{
+    data.assign(4, LEADING_CHAR);
+    encode(cmd, data);
+    // now generate a length header
+    auto dsz = static_cast<std::uint32_t>(data.size());
+    data[1] = static_cast<char>(((dsz >> 16U) & 0xFFU));
+    data[2] = static_cast<char>(((dsz >> 8U) & 0xFFU));
+    data[3] = static_cast<char>(dsz & 0xFFU);
+    data.push_back(TAIL_CHAR1);
+    data.push_back(TAIL_CHAR2);
+}
+
+void CompactMessageEncoder::reset()
+{
+    internTable.clear();
+    resetPending = true;
+}
+
+std::size_t
+    CompactMessageDecoder::decode(const std::byte* data, std::size_t buffer_size, ActionMessage& cmd)
+{
+    const std::byte* const begin = data;
+    const std::byte* const end = data + buffer_size;
+    auto fail = [&cmd]() -> std::size_t {
+        cmd.setAction(CMD_INVALID);
+        return 0;
+    };
+    if (buffer_size < 4 || data[0] != compactEncodingMarker ||
+        std::to_integer<std::uint8_t>(data[1]) != compactEncodingVersion) {
+        return fail();
+    }
+    data += 2;
+    std::uint64_t value{0};
+    if (!readVarint(data, end, value)) {
+        return fail();
+    }
+    const auto action = static_cast<action_message_def::action_t>(unzigzag(value));
+    if (!readVarint(data, end, value)) {
+        return fail();
+    }
+    const auto present = static_cast<std::uint32_t>(value);
+
+    auto readField = [&data, end, &value](std::uint32_t bits, std::uint32_t field) {
+        if ((bits & field) == 0) {
+            value = 0;
+            return true;
+        }
+        return readVarint(data, end, value);
+    };
+    static const ActionMessage defaults;
+
+    cmd.setAction(action);
+    if (!readField(present, message_id_field)) {
+        return fail();
+    }
+    cmd.messageID = static_cast<std::int32_t>(unzigzag(value));
+    if (!readField(present, source_id_field)) {
+        return fail();
+    }
+    cmd.source_id = ((present & source_id_field) != 0) ?
+        GlobalFederateId(static_cast<std::int32_t>(unzigzag(value))) :
+        defaults.source_id;
+    if (!readField(present, source_handle_field)) {
+        return fail();
+    }
+    cmd.source_handle = ((present & source_handle_field) != 0) ?
+        InterfaceHandle(static_cast<std::int32_t>(unzigzag(value))) :
+        defaults.source_handle;
+    if (!readField(present, dest_id_field)) {
+        return fail();
+    }
+    cmd.dest_id = ((present & dest_id_field) != 0) ?
+        GlobalFederateId(static_cast<std::int32_t>(unzigzag(value))) :
+        defaults.dest_id;
+    if (!readField(present, dest_handle_field)) {
+        return fail();
+    }
+    cmd.dest_handle = ((present & dest_handle_field) != 0) ?
+        InterfaceHandle(static_cast<std::int32_t>(unzigzag(value))) :
+        defaults.dest_handle;
+    if (!readField(present, counter_field)) {
+        return fail();
+    }
+    cmd.counter = static_cast<std::uint16_t>(value);
+    if (!readField(present, flags_field)) {
+        return fail();
+    }
+    cmd.flags = static_cast<std::uint16_t>(value);
+    if (!readField(present, sequence_field)) {
+        return fail();
+    }
+    cmd.sequenceID = static_cast<std::uint32_t>(value);
+    if (!readField(present, action_time_field)) {
+        return fail();
+    }
+    cmd.actionTime.setBaseTimeCode(unzigzag(value));
+    if (!readField(present, te_field)) {
+        return fail();
+    }
+    cmd.Te = ((present & te_field) != 0) ? timeFromDelta(value, cmd.actionTime) : timeZero;
+    if (!readField(present, tdemin_field)) {
+        return fail();
+    }
+    cmd.Tdemin = ((present & tdemin_field) != 0) ? timeFromDelta(value, cmd.actionTime) : timeZero;
+    if (!readField(present, tso_field)) {
+        return fail();
+    }
+    cmd.Tso = ((present & tso_field) != 0) ? timeFromDelta(value, cmd.actionTime) : timeZero;
+
+    if ((present & payload_field) != 0) {
+        if (!readVarint(data, end, value) || value > static_cast<std::uint64_t>(end - data)) {
+            return fail();
+        }
+        cmd.payload.assign(data, static_cast<std::size_t>(value));
+        data += value;
+    } else {
+        cmd.payload.resize(0);
+    }
+    if ((present & reset_table_field) != 0) {
+        internTable.clear();
+    }
+    cmd.clearStringData();
+    if ((present & strings_field) != 0) {
+        std::uint64_t count{0};
+        if (!readVarint(data, end, count) || count > 255) {
+            return fail();
+        }
+        for (std::uint64_t ii = 0; ii < count; ++ii) {
+            std::uint64_t tag{0};
+            if (!readVarint(data, end, tag)) {
+                return fail();
+            }
+            if (tag >= string_reference) {
+                const auto index = tag - string_reference;
+                if (index >= internTable.size()) {
+                    return fail();
+                }
+                cmd.setString(static_cast<int>(ii), internTable[index]);
+                continue;
+            }
+            if (!readVarint(data, end, value) || value > static_cast<std::uint64_t>(end - data)) {
+                return fail();
+            }
+            std::string_view str(reinterpret_cast<const char*>(data),
+                                 static_cast<std::size_t>(value));
+            data += value;
+            cmd.setString(static_cast<int>(ii), str);
+            if (tag == string_intern) {
+                internTable.emplace_back(str);
+            }
+        }
+    }
+    return static_cast<std::size_t>(data - begin);
+}
+
+std::size_t CompactMessageDecoder::depacketize(const std::byte* data,
+                                               std::size_t buffer_size,
+                                               ActionMessage& cmd)
+{
+    if (buffer_size < 6 || data[0] != static_cast<std::byte>(LEADING_CHAR)) {
+        return 0;
+    }
+    std::size_t message_size = std::to_integer<std::size_t>(data[1]);
+    message_size <<= 8U;
+    message_size += std::to_integer<std::size_t>(data[2]);
+    message_size <<= 8U;
+    message_size += std::to_integer<std::size_t>(data[3]);
+    if (buffer_size < message_size + 2 || message_size < 4) {
+        return 0;
+    }
+    if (data[message_size] != static_cast<std::byte>(TAIL_CHAR1) ||
+        data[message_size + 1] != static_cast<std::byte>(TAIL_CHAR2)) {
+        return 0;
+    }
+    if (data[4] != compactEncodingMarker) {
+        // original encoding
+        return cmd.depacketize(data, buffer_size);
+    }
+    auto used = decode(data + 4, message_size - 4, cmd);
+    return (used > 0) ? message_size + 2 : 0;
+}
+
+}  // namespace helics
@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "ActionMessage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @file
+@details compact (version 2) binary encoding for ActionMessages.  Fields are written as
+varints after a presence bitmap so zero or default values cost nothing, the Te, Tdemin, and Tso
+times are written as deltas from the actionTime, and short strings in the string data can be
+interned so repeated keys are sent as a small index on a connection.  The first byte of the
+encoding is a marker which cannot be the first byte of the original encoding or of json so
+decoders can tell the formats apart.
+*/
+namespace helics {
+/** the first byte of a compact encoded message*/
+constexpr std::byte compactEncodingMarker{0xC2};
+/** the version number of the compact encoding*/
+constexpr std::uint8_t compactEncodingVersion{2};
+
+/** class to encode ActionMessages in the compact format
+@details an encoder with interning enabled maintains a string table that must be mirrored by a
+single CompactMessageDecoder receiving the messages in order, so it should be used per connection
+*/
+class CompactMessageEncoder {
+  public:
+    /** construct an encoder
+    @param useInterning set to true to enable string interning which requires in order delivery
+    to a single decoder*/
+    explicit CompactMessageEncoder(bool useInterning = false): interning(useInterning) {}
+    /** encode a message appending it to a string
+    @return the number of bytes appended*/
+    std::size_t encode(const ActionMessage& cmd, std::string& data);
+    /** encode a message into a packet with the same framing as ActionMessage::packetize
+     */
+    void packetize(const ActionMessage& cmd, std::string& data);
+    /** clear the intern table, the next message will instruct the decoder to do the same*/
+    void reset();
+
+  private:
+    std::unordered_map<std::string, std::uint32_t> internTable;
+    bool interning{false};
+    bool resetPending{true};
+};
+
+/** class to decode ActionMessages in the compact format*/
+class CompactMessageDecoder {
+  public:
+    /** decode a message
+    @return the number of bytes used, 0 if the message was invalid or incomplete*/
+    std::size_t decode(const std::byte* data, std::size_t buffer_size, ActionMessage& cmd);
+    /** decode a packet generated by CompactMessageEncoder::packetize or
+    ActionMessage::packetize
+    @return the number of bytes used, 0 if the packet was invalid or incomplete*/
+    std::size_t depacketize(const std::byte* data, std::size_t buffer_size, ActionMessage& cmd);
+
+  private:
+    std::vector<std::string> internTable;
+};
+
+}  // namespace helics
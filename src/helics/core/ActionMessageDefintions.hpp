@@ -96,6 +96,7 @@ across different compilers*/
         cmd_time_barrier_clear = 44,  //!< clear a global time barrier
 
         cmd_pub = 52,  //!< publish a value
+        cmd_multicast_pub = 53,  //!< publish a value to a set of destinations with a shared payload
         cmd_bye = 2000,  //!< message stating this is the last communication from a federate
         cmd_log = 55,  //!< log a message with the root broker
         cmd_remote_log = 2055,  //!< send a log message to a remote host
@@ -276,6 +277,7 @@ across different compilers*/
 #define CMD_DEST_FILTER_RESULT action_message_def::action_t::cmd_dest_filter_result
 
 #define CMD_PUB action_message_def::action_t::cmd_pub
+#define CMD_MULTICAST_PUB action_message_def::action_t::cmd_multicast_pub
 #define CMD_LOG action_message_def::action_t::cmd_log
 #define CMD_REMOTE_LOG action_message_def::action_t::cmd_remote_log
 #define CMD_WARNING action_message_def::action_t::cmd_warning
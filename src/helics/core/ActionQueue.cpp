@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "ActionQueue.hpp"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace helics {
+
+/// the number of empty polls the consumer makes before blocking
+static constexpr int consumerSpinCount{64};
+
+MpscActionQueue::Lane::Lane(): head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+
+MpscActionQueue::Lane::~Lane()
+{
+    Node* node = tail;
+    while (node != nullptr) {
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+void MpscActionQueue::Lane::push(Node* node)
+{
+    // the exchange orders the producers, the link publishes the node to the consumer
+    Node* previous = head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+void MpscActionQueue::Lane::advance(Node* next)
+{
+    delete tail;
+    tail = next;
+}
+
+MpscActionQueue::MpscActionQueue() = default;
+
+MpscActionQueue::~MpscActionQueue() = default;
+
+void MpscActionQueue::pushNode(Lane& lane, ActionMessage&& message)
+{
+    auto* node = new Node;
+    node->message = std::move(message);
+    lane.push(node);
+    // pairs with the fence in pop so either the consumer sees the node or the producer sees the
+    // consumer waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(waitLock);
+        waitCondition.notify_one();
+    }
+}
+
+void MpscActionQueue::push(ActionMessage&& message)
+{
+    pushNode(normalLane, std::move(message));
+}
+
+void MpscActionQueue::pushPriority(ActionMessage&& message)
+{
+    pushNode(priorityLane, std::move(message));
+}
+
+std::optional<ActionMessage> MpscActionQueue::try_pop()
+{
+    Lane* lane{&priorityLane};
+    Node* next = lane->peek();
+    if (next == nullptr) {
+        lane = &normalLane;
+        next = lane->peek();
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+    }
+    std::optional<ActionMessage> result(std::move(next->message));
+    lane->advance(next);
+    return result;
+}
+
+ActionMessage MpscActionQueue::pop()
+{
+    int spins{0};
+    while (true) {
+        auto message = try_pop();
+        if (message) {
+            return std::move(*message);
+        }
+        if (spins < consumerSpinCount) {
+            ++spins;
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(waitLock);
+        consumerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        waitCondition.wait(lock, [this] { return !empty(); });
+        consumerWaiting.store(false, std::memory_order_relaxed);
+        spins = 0;
+    }
+}
+
+bool MpscActionQueue::empty() const
+{
+    return priorityLane.peek() == nullptr && normalLane.peek() == nullptr;
+}
+
+void ActionQueue::setLockFree(bool lockFree)
+{
+    if (lockFree == mLockFree) {
+        return;
+    }
+    // transfer any pending messages, priority messages are popped first so the order is kept
+    std::vector<ActionMessage> pending;
+    for (auto message = try_pop(); message; message = try_pop()) {
+        pending.push_back(std::move(*message));
+    }
+    mLockFree = lockFree;
+    for (auto& message : pending) {
+        if (isPriorityCommand(message)) {
+            pushPriority(std::move(message));
+        } else {
+            push(std::move(message));
+        }
+    }
+}
+
+void ActionQueue::push(const ActionMessage& message)
+{
+    if (mLockFree) {
+        mLockFreeQueue.push(ActionMessage(message));
+    } else {
+        mBlockingQueue.push(message);
+    }
+}
+
+void ActionQueue::push(ActionMessage&& message)
+{
+    if (mLockFree) {
+        mLockFreeQueue.push(std::move(message));
+    } else {
+        mBlockingQueue.push(std::move(message));
+    }
+}
+
+void ActionQueue::pushPriority(const ActionMessage& message)
+{
+    if (mLockFree) {
+        mLockFreeQueue.pushPriority(ActionMessage(message));
+    } else {
+        mBlockingQueue.pushPriority(message);
+    }
+}
+
+void ActionQueue::pushPriority(ActionMessage&& message)
+{
+    if (mLockFree) {
+        mLockFreeQueue.pushPriority(std::move(message));
+    } else {
+        mBlockingQueue.pushPriority(std::move(message));
+    }
+}
+
+ActionMessage ActionQueue::pop()
+{
+    return mLockFree ? mLockFreeQueue.pop() : mBlockingQueue.pop();
+}
+
+std::optional<ActionMessage> ActionQueue::try_pop()
+{
+    if (mLockFree) {
+        return mLockFreeQueue.try_pop();
+    }
+    auto message = mBlockingQueue.try_pop();
+    if (message) {
+        return std::move(*message);
+    }
+    return std::nullopt;
+}
+
+bool ActionQueue::empty() const
+{
+    return mLockFree ? mLockFreeQueue.empty() : mBlockingQueue.empty();
+}
+
+}  // namespace helics
@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "ActionMessage.hpp"
+#include "gmlc/containers/BlockingPriorityQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace helics {
+
+/** unbounded lock free multi-producer single-consumer queue of ActionMessages with a priority lane
+@details pushes never take a lock; the consumer only blocks on a condition variable when both lanes
+are empty and producers only touch the mutex to wake an idle consumer.  Messages in the priority
+lane are always popped before those in the normal lane.
+*/
+class MpscActionQueue {
+  public:
+    MpscActionQueue();
+    ~MpscActionQueue();
+    MpscActionQueue(const MpscActionQueue&) = delete;
+    MpscActionQueue& operator=(const MpscActionQueue&) = delete;
+
+    /** push a message onto the normal lane, safe to call from any thread*/
+    void push(ActionMessage&& message);
+    /** push a message onto the priority lane, safe to call from any thread*/
+    void pushPriority(ActionMessage&& message);
+    /** pop a message if one is available, must only be called from the consumer thread*/
+    std::optional<ActionMessage> try_pop();
+    /** pop a message, blocking until one is available, must only be called from the consumer
+    thread*/
+    ActionMessage pop();
+    /** check if the queue is empty,  exact only when called from the consumer thread*/
+    bool empty() const;
+
+  private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        ActionMessage message;
+    };
+    /** intrusive queue, the tail node is a placeholder whose message has already been consumed*/
+    class Lane {
+      public:
+        Lane();
+        ~Lane();
+        void push(Node* node);
+        Node* peek() const { return tail->next.load(std::memory_order_acquire); }
+        /** remove the node returned by peek*/
+        void advance(Node* next);
+
+      private:
+        std::atomic<Node*> head;  //!< the last node pushed by a producer
+        Node* tail;  //!< the consumer position
+    };
+    void pushNode(Lane& lane, ActionMessage&& message);
+
+    Lane priorityLane;
+    Lane normalLane;
+    std::atomic<bool> consumerWaiting{false};
+    std::mutex waitLock;
+    std::condition_variable waitCondition;
+};
+
+/** the primary routing queue of a broker or core
+@details the queue uses a BlockingPriorityQueue by default or the lock free MpscActionQueue if
+selected before the processing thread is started.  Messages can be pushed from any thread but
+only the processing thread can pop messages.
+*/
+class ActionQueue {
+  public:
+    ActionQueue() = default;
+    /** select the lock free queue implementation
+    @details any messages already in the queue are transferred to the new implementation; this must
+    not be called while other threads are using the queue*/
+    void setLockFree(bool lockFree);
+    /** check if the lock free queue is in use*/
+    bool isLockFree() const { return mLockFree; }
+
+    void push(const ActionMessage& message);
+    void push(ActionMessage&& message);
+    void pushPriority(const ActionMessage& message);
+    void pushPriority(ActionMessage&& message);
+    /** construct a message in place on the normal lane*/
+    template<class... Args>
+    void emplace(Args&&... args)
+    {
+        if (mLockFree) {
+            mLockFreeQueue.push(ActionMessage(std::forward<Args>(args)...));
+        } else {
+            mBlockingQueue.emplace(std::forward<Args>(args)...);
+        }
+    }
+    /** construct a message in place on the priority lane*/
+    template<class... Args>
+    void emplacePriority(Args&&... args)
+    {
+        if (mLockFree) {
+            mLockFreeQueue.pushPriority(ActionMessage(std::forward<Args>(args)...));
+        } else {
+            mBlockingQueue.emplacePriority(std::forward<Args>(args)...);
+        }
+    }
+    /** pop a message, blocking until one is available*/
+    ActionMessage pop();
+    /** pop a message if one is available*/
+    std::optional<ActionMessage> try_pop();
+    bool empty() const;
+
+  private:
+    gmlc::containers::BlockingPriorityQueue<ActionMessage> mBlockingQueue;
+    MpscActionQueue mLockFreeQueue;
+    bool mLockFree{false};
+};
+
+}  // namespace helics
@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <iostream>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace helics {
@@ -69,7 +70,7 @@ void AsyncTimeCoordinator::transmitTimingMessagesUpstream(ActionMessage& msg) co
         return;
     }
 
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.connection == ConnectionType::CHILD) {
             continue;
         }
@@ -91,7 +92,7 @@ void AsyncTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage& msg,
         return;
     }
     if ((msg.action() == CMD_TIME_REQUEST || msg.action() == CMD_TIME_GRANT)) {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.connection != ConnectionType::CHILD) {
                 continue;
             }
@@ -110,7 +111,7 @@ void AsyncTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage& msg,
             sendMessageFunction(msg);
         }
     } else {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.dependent) {
                 if (dep.fedID == skipFed) {
                     continue;
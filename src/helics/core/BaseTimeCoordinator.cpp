@@ -63,7 +63,7 @@ void BaseTimeCoordinator::enteringExecMode(IterationRequest /*mode*/)
     }
     bool fedOnly = true;
     noParent = true;
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.connection == ConnectionType::PARENT) {
             fedOnly = false;
             noParent = false;
@@ -103,7 +103,7 @@ void BaseTimeCoordinator::disconnect()
     } else {
         ActionMessage multi(CMD_MULTI_MESSAGE);
         bool hasLocal{false};
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if ((dep.dependency && dep.next < Time::maxVal()) || dep.dependent) {
                 if (dep.fedID == mSourceId) {
                     hasLocal = true;
@@ -128,7 +128,7 @@ void BaseTimeCoordinator::generateDebuggingTimeInfo(nlohmann::json& base) const
     base["federatesonly"] = federatesOnly;
     base["sequenceCounter"] = sequenceCounter;
     base["id"] = mSourceId.baseValue();
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.dependency) {
             nlohmann::json depblock;
             generateJsonOutputDependency(depblock, dep);
@@ -212,7 +212,7 @@ void BaseTimeCoordinator::setVersion(GlobalFederateId fedID, std::int8_t version
 
 GlobalFederateId BaseTimeCoordinator::getParent() const
 {
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.connection == ConnectionType::PARENT) {
             return dep.fedID;
         }
@@ -243,7 +243,7 @@ const DependencyInfo* BaseTimeCoordinator::getDependencyInfo(GlobalFederateId of
 std::vector<GlobalFederateId> BaseTimeCoordinator::getDependencies() const
 {
     std::vector<GlobalFederateId> deps;
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.dependency) {
             deps.push_back(dep.fedID);
         }
@@ -254,7 +254,7 @@ std::vector<GlobalFederateId> BaseTimeCoordinator::getDependencies() const
 std::vector<GlobalFederateId> BaseTimeCoordinator::getDependents() const
 {
     std::vector<GlobalFederateId> deps;
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.dependent) {
             deps.push_back(dep.fedID);
         }
@@ -295,7 +295,7 @@ void BaseTimeCoordinator::sendTimingInfo()
     }
     tinfo.setExtraData(TIME_COORDINATOR_VERSION);
 
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.dependent) {
             tinfo.dest_id = dep.fedID;
             sendMessageFunction(tinfo);
@@ -39,6 +39,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #    endif
 #endif
 
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -64,6 +65,8 @@ static inline std::string genId()
 }
 
 namespace helics {
+/// the amount of binary profiling data held before it is written to the file
+static constexpr std::size_t profilerFlushSize{1U << 20U};
 
 BrokerBase::BrokerBase(bool DisableQueue) noexcept:
     queueDisabled(DisableQueue), mLogManager(std::make_shared<LogManager>())
@@ -196,6 +199,16 @@ std::shared_ptr<helicsCLI11App> BrokerBase::generateBaseCLI()
     hApp->add_flag("--json",
                    useJsonSerialization,
                    "use the JSON serialization mode for communications");
+    hApp->add_option_function<std::string>(
+            "--action_queue",
+            [this](const std::string& arg) {
+                // the queue implementation cannot change once the processing thread is running
+                if (brokerState.load() < BrokerState::CONFIGURED) {
+                    actionQueue.setLockFree(arg == "lockfree");
+                }
+            },
+            "specify the implementation of the primary message queue, \"lockfree\" reduces contention with many federates or connections")
+        ->check(CLI::IsMember({"blocking", "lockfree"}));
 
     // add the profiling setup command
     auto* popt =
@@ -597,6 +610,52 @@ void BrokerBase::saveProfilingData(std::string_view message)
     }
 }
 
+/// copy the binary records out of a CMD_PROFILER_DATA payload to ensure alignment
+static std::vector<ProfilerRecord> loadProfilerRecords(const ActionMessage& command)
+{
+    std::vector<ProfilerRecord> records(command.payload.size() / sizeof(ProfilerRecord));
+    std::memcpy(records.data(), command.payload.data(), records.size() * sizeof(ProfilerRecord));
+    return records;
+}
+
+void BrokerBase::saveProfilingData(const ActionMessage& command)
+{
+    if (!checkActionFlag(command, indicator_flag)) {
+        saveProfilingData(command.payload.to_string());
+        return;
+    }
+    const auto records = loadProfilerRecords(command);
+    const std::string_view fedName =
+        command.getStringData().empty() ? std::string_view{} : command.getString(0);
+    if (prBuff) {
+        prBuff->addRecords(fedName, records.data(), records.size());
+        if (prBuff->bufferedSize() >= profilerFlushSize) {
+            writeProfilingData();
+        }
+    } else {
+        for (const auto& record : records) {
+            sendToLogger(parent_broker_id,
+                         LogLevels::PROFILING,
+                         "[PROFILING]",
+                         generateProfilingString(fedName, record));
+        }
+    }
+}
+
+std::vector<ActionMessage> BrokerBase::generateTextProfilingData(const ActionMessage& command)
+{
+    const auto records = loadProfilerRecords(command);
+    const std::string_view fedName =
+        command.getStringData().empty() ? std::string_view{} : command.getString(0);
+    std::vector<ActionMessage> messages;
+    messages.reserve(records.size());
+    for (const auto& record : records) {
+        auto& prof = messages.emplace_back(CMD_PROFILER_DATA, command.source_id, command.dest_id);
+        prof.payload = generateProfilingString(fedName, record);
+    }
+    return messages;
+}
+
 void BrokerBase::writeProfilingData()
 {
     if (prBuff) {
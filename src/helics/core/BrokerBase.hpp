@@ -12,8 +12,8 @@ and some common methods used cores and brokers
 */
 
 #include "ActionMessage.hpp"
+#include "ActionQueue.hpp"
 #include "FederateIdExtra.hpp"
-#include "gmlc/containers/BlockingPriorityQueue.hpp"
 
 #include <atomic>
 #include <limits>
@@ -107,7 +107,7 @@ class BrokerBase {
 
   protected:
     std::unique_ptr<BaseTimeCoordinator> timeCoord;  //!< object managing the time control
-    gmlc::containers::BlockingPriorityQueue<ActionMessage> actionQueue;  //!< primary routing queue
+    ActionQueue actionQueue;  //!< primary routing queue
     std::shared_ptr<LogManager> mLogManager;  //!< object to handle the logging considerations
     /** enumeration of the possible core states*/
     enum class BrokerState : int16_t {
@@ -148,6 +148,10 @@ class BrokerBase {
     bool allowRemoteControl{true};  //!< if true allows some remote operation
     /// error if there are unmatched connections on init
     bool errorOnUnmatchedConnections{false};
+    /// the parent broker accepts multicast publication messages
+    bool parentMulticast{false};
+    /// the parent broker accepts binary profiler records
+    bool parentBinaryProfiling{false};
     bool globalDisconnect{false};  //!< if true specify that federates should stay connected until a
                                    //!< global disconnect operation
     /// time when the error condition started; related to the errorDelay
@@ -282,6 +286,12 @@ class BrokerBase {
                       bool fromRemote = false) const;
     /** save a profiling message*/
     void saveProfilingData(std::string_view message);
+    /** save the profiling data from a CMD_PROFILER_DATA message containing either a text message
+    or a batch of binary profiler records*/
+    void saveProfilingData(const ActionMessage& command);
+    /** generate a text CMD_PROFILER_DATA message for each record in a batch of binary profiler
+    records, for a parent broker that does not accept the binary records*/
+    static std::vector<ActionMessage> generateTextProfilingData(const ActionMessage& command);
     /** write profiler data to file*/
     void writeProfilingData();
     /** generate a new random id*/
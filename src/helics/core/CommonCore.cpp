@@ -150,6 +150,7 @@ bool CommonCore::connect()
                 }
 
                 setActionFlag(reg, core_flag);
+                setActionFlag(reg, multicast_flag);
                 if (useJsonSerialization) {
                     setActionFlag(reg, use_json_serialization_flag);
                 }
@@ -354,8 +355,7 @@ bool CommonCore::isLocal(GlobalFederateId global_fedid) const
 
 route_id CommonCore::getRoute(GlobalFederateId global_fedid) const
 {
-    auto fnd = routing_table.find(global_fedid);
-    return (fnd != routing_table.end()) ? fnd->second : parent_route_id;
+    return routing_table.find(global_fedid);
 }
 
 bool CommonCore::isConfigured() const
@@ -983,6 +983,86 @@ iteration_time CommonCore::requestTimeIterative(LocalFederateId federateID,
     return fed->requestTime(next, iterate, false);
 }
 
+bool CommonCore::requestTimeAsync(
+    LocalFederateId federateID,
+    Time next,
+    IterationRequest iterate,
+    std::function<void(iteration_time, std::exception_ptr)> completion)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid requestTimeAsync"));
+    }
+    if (fed->isCallbackFederate()) {
+        throw(InvalidFunctionCall(
+            "Time request operation is not permitted for callback based federates"));
+    }
+    switch (fed->getState()) {
+        case FederateStates::EXECUTING:
+            break;
+        case FederateStates::FINISHED:
+        case FederateStates::TERMINATING:
+            completion(iteration_time{Time::maxVal(), IterationResult::HALTED}, nullptr);
+            return true;
+        case FederateStates::CREATED:
+        case FederateStates::INITIALIZING:
+            completion(iteration_time{timeZero, IterationResult::ERROR_RESULT},
+                       std::make_exception_ptr(InvalidFunctionCall(
+                           "time request should only be called in execution state")));
+            return true;
+        case FederateStates::UNKNOWN:
+        case FederateStates::ERRORED:
+            completion(iteration_time{Time::maxVal(), IterationResult::ERROR_RESULT},
+                       std::make_exception_ptr(InvalidFunctionCall(
+                           "time request should only be called in execution state")));
+            return true;
+    }
+
+    // limit the iterations
+    if (iterate == IterationRequest::ITERATE_IF_NEEDED) {
+        if (fed->getCurrentIteration() >= maxIterationCount) {
+            iterate = IterationRequest::NO_ITERATIONS;
+        }
+    }
+    // the federate has to accept the request before the core sees it
+    // errors are reported with the same exceptions timeRequest throws
+    auto fedCompletion = [fed, completion = std::move(completion)](iteration_time result) {
+        std::exception_ptr error;
+        if (result.state == IterationResult::ERROR_RESULT) {
+            error = (fed->lastErrorCode() == HELICS_ERROR_REGISTRATION_FAILURE) ?
+                std::make_exception_ptr(RegistrationFailure(fed->lastErrorString())) :
+                std::make_exception_ptr(FunctionExecutionFailure(fed->lastErrorString()));
+        }
+        completion(result, std::move(error));
+    };
+    if (!fed->requestTimeAsync(next, iterate, std::move(fedCompletion))) {
+        return false;
+    }
+    auto cBrokerState = getBrokerState();
+    switch (cBrokerState) {
+        case BrokerState::TERMINATING:
+        case BrokerState::TERMINATED:
+        case BrokerState::CONNECTED_ERROR:
+        case BrokerState::TERMINATING_ERROR:
+        case BrokerState::ERRORED: {
+            ActionMessage terminate(CMD_STOP);
+            terminate.dest_id = fed->global_id;
+            terminate.source_id = fed->global_id;
+            fed->addAction(terminate);
+        } break;
+        default:
+            break;
+    }
+    ActionMessage treq(CMD_TIME_REQUEST);
+    treq.source_id = fed->global_id.load();
+    treq.dest_id = fed->global_id.load();
+    treq.actionTime = next;
+    setIterationFlags(treq, iterate);
+    setActionFlag(treq, indicator_flag);
+    addActionMessage(treq);
+    return true;
+}
+
 void CommonCore::processCommunications(LocalFederateId federateID,
                                        std::chrono::milliseconds msToWait)
 {
@@ -1741,7 +1821,9 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
         return;  // if the value is not required do nothing
     }
     auto* fed = getFederateAt(handleInfo->local_fed_id);
-    if (fed->checkAndSetValue(handle, data, len)) {
+    SmallBuffer encoded;
+    DeltaFrame frame{DeltaFrame::NONE};
+    if (fed->checkAndSetValue(handle, data, len, encoded, frame)) {
         if (fed->loggingLevel() >= HELICS_LOG_LEVEL_DATA) {
             fed->logMessage(HELICS_LOG_LEVEL_DATA,
                             fed->getIdentifier(),
@@ -1757,35 +1839,31 @@ void CommonCore::setValue(InterfaceHandle handle, const char* data, uint64_t len
             pub.source_handle = handle;
             pub.setDestination(subs[0]);
             pub.counter = static_cast<uint16_t>(fed->getCurrentIteration());
-            pub.payload.assign(data, len);
+            if (encoded.empty()) {
+                pub.payload.assign(data, len);
+            } else {
+                pub.payload = std::move(encoded);
+            }
+            setDeltaFrameFlag(pub, frame);
             pub.actionTime = fed->nextAllowedSendTime();
             actionQueue.push(std::move(pub));
             return;
         }
-        ActionMessage package(CMD_MULTI_MESSAGE);
-        package.source_id = handleInfo->getFederateId();
-        package.source_handle = handle;
-
-        ActionMessage pub(CMD_PUB);
+        // the payload is stored once with the list of subscribers and only split at the last hop
+        ActionMessage pub(CMD_MULTICAST_PUB);
         pub.source_id = handleInfo->getFederateId();
         pub.source_handle = handle;
+        pub.setDestination(subs.front());
         pub.counter = static_cast<uint16_t>(fed->getCurrentIteration());
-        pub.payload.assign(data, len);
-        pub.actionTime = fed->nextAllowedSendTime();
-
-        for (auto& target : subs) {
-            pub.setDestination(target);
-            auto res = appendMessage(package, pub);
-            if (res < 0)  // deal with max package size if there are a lot of subscribers
-            {
-                actionQueue.push(std::move(package));
-                package = ActionMessage(CMD_MULTI_MESSAGE);
-                package.source_id = handleInfo->getFederateId();
-                package.source_handle = handle;
-                appendMessage(package, pub);
-            }
+        if (encoded.empty()) {
+            pub.payload.assign(data, len);
+        } else {
+            pub.payload = std::move(encoded);
         }
-        actionQueue.push(std::move(package));
+        setDeltaFrameFlag(pub, frame);
+        pub.actionTime = fed->nextAllowedSendTime();
+        setMulticastDestinations(pub, subs);
+        actionQueue.push(std::move(pub));
     }
 }
 
@@ -1821,6 +1899,18 @@ const std::vector<std::shared_ptr<const SmallBuffer>>&
     return fed.getAllValues(handle);
 }
 
+void CommonCore::getValues(LocalFederateId federateID,
+                           const std::vector<InterfaceHandle>& handles,
+                           std::vector<std::shared_ptr<const SmallBuffer>>& values)
+{
+    auto* fed = getFederateAt(federateID);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("federateID not valid (getValues)"));
+    }
+    const std::lock_guard<FederateState> lock(*fed);
+    fed->getValues(handles, values);
+}
+
 const std::vector<InterfaceHandle>& CommonCore::getValueUpdates(LocalFederateId federateID)
 {
     auto* fed = getFederateAt(federateID);
@@ -2327,14 +2417,25 @@ void CommonCore::sendMessage(InterfaceHandle sourceHandle, std::unique_ptr<Messa
     }
 }
 
+BasicHandleInfo* CommonCore::findNamedDestination(const ActionMessage& message)
+{
+    const auto& name = message.getString(targetStringLoc);
+    const auto generation = loopHandles.nameGeneration();
+    BasicHandleInfo* destination{nullptr};
+    if (!namedDestinations.find(message.getSource(), name, generation, destination)) {
+        destination = loopHandles.getInterfaceHandle(name, InterfaceType::ENDPOINT);
+        namedDestinations.store(message.getSource(), name, generation, destination);
+    }
+    return destination;
+}
+
 void CommonCore::deliverMessage(ActionMessage& message)
 {
     switch (message.action()) {
         case CMD_SEND_MESSAGE: {
             // Find the destination endpoint
             auto* localP = (message.dest_id == parent_broker_id) ?
-                loopHandles.getInterfaceHandle(message.getString(targetStringLoc),
-                                               InterfaceType::ENDPOINT) :
+                findNamedDestination(message) :
                 loopHandles.findHandle(message.getDest());
             if (localP == nullptr) {
                 auto kfnd = knownExternalEndpoints.find(message.getString(targetStringLoc));
@@ -2401,6 +2502,19 @@ std::unique_ptr<Message> CommonCore::receive(InterfaceHandle destination)
     return fed->receive(destination);
 }
 
+std::vector<std::unique_ptr<Message>> CommonCore::receiveAll(InterfaceHandle destination,
+                                                              Time maxTime)
+{
+    auto* fed = getHandleFederate(destination);
+    if (fed == nullptr) {
+        throw(InvalidIdentifier("invalid handle"));
+    }
+    if (fed->getState() == FederateStates::CREATED) {
+        return {};
+    }
+    return fed->receiveAll(destination, maxTime);
+}
+
 std::unique_ptr<Message> CommonCore::receiveAny(LocalFederateId federateID,
                                                 InterfaceHandle& endpoint_id)
 {
@@ -3269,6 +3383,8 @@ void CommonCore::processPriorityCommand(ActionMessage&& command)
                 if (checkActionFlag(command, global_disconnect_flag)) {
                     globalDisconnect = true;
                 }
+                parentMulticast = checkActionFlag(command, multicast_flag);
+                parentBinaryProfiling = checkActionFlag(command, binary_profiling_flag);
                 timeoutMon->reset();
                 if (delayInitCounter < 0 && minFederateCount == 0 && minChildCount == 0) {
                     if (allInitReady()) {
@@ -3484,6 +3600,7 @@ void CommonCore::processCommand(ActionMessage&& command)
                     reg.name(getIdentifier());
                     reg.setStringData(getAddress());
                     setActionFlag(reg, core_flag);
+                    setActionFlag(reg, multicast_flag);
                     reg.counter = 1;
                     transmit(parent_route_id, reg);
                 }
@@ -3626,6 +3743,9 @@ void CommonCore::processCommand(ActionMessage&& command)
         case CMD_PUB:
             routeMessage(command);
             break;
+        case CMD_MULTICAST_PUB:
+            routeMulticastMessage(std::move(command));
+            break;
         case CMD_LOG:
         case CMD_REMOTE_LOG:
         case CMD_WARNING:
@@ -3713,7 +3833,11 @@ void CommonCore::processCommand(ActionMessage&& command)
             break;
         case CMD_PROFILER_DATA:
             if (enable_profiling) {
-                saveProfilingData(command.payload.to_string());
+                saveProfilingData(command);
+            } else if (checkActionFlag(command, indicator_flag) && !parentBinaryProfiling) {
+                for (auto& prof : generateTextProfilingData(command)) {
+                    routeMessage(std::move(prof), parent_broker_id);
+                }
             } else {
                 routeMessage(std::move(command), parent_broker_id);
             }
@@ -3854,7 +3978,12 @@ void CommonCore::generateTranslatorFederate()
                                 },
                                 [this](const ActionMessage& message) { routeMessage(message); },
                                 [this](ActionMessage&& message) {
-                                    routeMessage(std::move(message));
+                                    // values for several inputs are split by destination here
+                                    if (message.action() == CMD_MULTICAST_PUB) {
+                                        routeMulticastMessage(std::move(message));
+                                    } else {
+                                        routeMessage(std::move(message));
+                                    }
                                 });
 
     translatorFed->setHandleManager(&loopHandles);
@@ -5527,6 +5656,71 @@ void CommonCore::routeMessage(ActionMessage&& cmd)
     }
 }  // namespace helics
 
+void CommonCore::routeMulticastMessage(ActionMessage&& cmd)
+{
+    // group the targets by local federate and by route for remote federates so the payload is
+    // copied at most once per remote route and is shared by all the local federates
+    std::map<GlobalFederateId, std::vector<GlobalHandle>> localTargets;
+    std::map<route_id, std::vector<GlobalHandle>> remoteTargets;
+    std::vector<std::vector<GlobalHandle>> individualTargets;
+    for (const auto& target : getMulticastDestinations(cmd)) {
+        if (target.fed_id == global_broker_id_local || target.fed_id == filterFedID ||
+            target.fed_id == translatorFedID) {
+            individualTargets.push_back({target});
+        } else if (isLocal(target.fed_id)) {
+            localTargets[target.fed_id].push_back(target);
+        } else {
+            auto route = getRoute(target.fed_id);
+            // a parent that did not acknowledge multicast support gets a message per target
+            if (route == parent_route_id && parentMulticast) {
+                remoteTargets[route].push_back(target);
+            } else {
+                individualTargets.push_back({target});
+            }
+        }
+    }
+    const bool sharePayload = localTargets.size() > 1;
+    std::vector<ActionMessage> messages;
+    messages.reserve(localTargets.size() + remoteTargets.size() + individualTargets.size());
+    for (const auto& targets : individualTargets) {
+        messages.push_back(generateMulticastSubset(cmd, targets));
+    }
+    for (const auto& targets : remoteTargets) {
+        messages.push_back(generateMulticastSubset(cmd, targets.second));
+    }
+    if (!sharePayload) {
+        for (const auto& targets : localTargets) {
+            messages.push_back(generateMulticastSubset(cmd, targets.second));
+        }
+    }
+    for (std::size_t ii = 0; ii < messages.size(); ++ii) {
+        if (ii + 1 == messages.size() && !sharePayload) {
+            messages[ii].payload = std::move(cmd.payload);
+        } else {
+            messages[ii].payload = cmd.payload;
+        }
+        routeMessage(std::move(messages[ii]));
+    }
+    if (!sharePayload) {
+        return;
+    }
+    auto data = std::make_shared<const SmallBuffer>(std::move(cmd.payload));
+    for (const auto& [fedID, targets] : localTargets) {
+        auto* fed = getFederateCore(fedID);
+        if (fed == nullptr || fed->getState() == FederateStates::FINISHED) {
+            continue;
+        }
+        auto pub = generateMulticastSubset(cmd, targets);
+        if (pub.action() == CMD_PUB) {
+            pub.setAction(CMD_MULTICAST_PUB);
+            setMulticastDestinations(pub, targets);
+        }
+        setActionFlag(pub, shared_payload_flag);
+        pub.sequenceID = fed->addSharedPayload(data);
+        routeMessage(std::move(pub));
+    }
+}
+
 // Checks for filter operations
 ActionMessage& CommonCore::processMessage(ActionMessage& message)
 {
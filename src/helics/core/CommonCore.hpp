@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "Core.hpp"
 #include "FederateIdExtra.hpp"
 #include "HandleManager.hpp"
+#include "RouteTable.hpp"
 #include "gmlc/concurrency/DelayedObjects.hpp"
 #include "gmlc/concurrency/TriggerVariable.hpp"
 #include "gmlc/containers/AirLock.hpp"
@@ -27,6 +28,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <atomic>
 #include <chrono>
 #include <deque>
+#include <exception>
 #include <map>
 #include <memory>
 #include <set>
@@ -112,6 +114,11 @@ class CommonCore: public Core, public BrokerBase {
     virtual iteration_time requestTimeIterative(LocalFederateId federateID,
                                                 Time next,
                                                 IterationRequest iterate) override final;
+    virtual bool
+        requestTimeAsync(LocalFederateId federateID,
+                         Time next,
+                         IterationRequest iterate,
+                         std::function<void(iteration_time, std::exception_ptr)> completion) override final;
     virtual void processCommunications(LocalFederateId federateID,
                                        std::chrono::milliseconds msToWait) override final;
     virtual Time getCurrentTime(LocalFederateId federateID) const override final;
@@ -170,6 +177,9 @@ class CommonCore: public Core, public BrokerBase {
                                                                uint32_t* inputIndex) override final;
     virtual const std::vector<std::shared_ptr<const SmallBuffer>>&
         getAllValues(InterfaceHandle handle) override final;
+    virtual void getValues(LocalFederateId federateID,
+                           const std::vector<InterfaceHandle>& handles,
+                           std::vector<std::shared_ptr<const SmallBuffer>>& values) override final;
     virtual const std::vector<InterfaceHandle>&
         getValueUpdates(LocalFederateId federateID) override final;
     virtual InterfaceHandle registerEndpoint(LocalFederateId federateID,
@@ -228,6 +238,8 @@ class CommonCore: public Core, public BrokerBase {
                              std::unique_ptr<Message> message) override final;
     virtual uint64_t receiveCount(InterfaceHandle destination) override final;
     virtual std::unique_ptr<Message> receive(InterfaceHandle destination) override final;
+    virtual std::vector<std::unique_ptr<Message>> receiveAll(InterfaceHandle destination,
+                                                             Time maxTime) override final;
     virtual std::unique_ptr<Message> receiveAny(LocalFederateId federateID,
                                                 InterfaceHandle& endpoint_id) override final;
     virtual uint64_t receiveCountAny(LocalFederateId federateID) override final;
@@ -370,8 +382,8 @@ class CommonCore: public Core, public BrokerBase {
     std::atomic<double> simTime{BrokerBase::mInvalidSimulationTime};
     GlobalFederateId keyFed{};
     std::string prevIdentifier;  //!< storage for the case of requiring a renaming
-    /** map for external routes  <global federate id, route id> */
-    std::map<GlobalFederateId, route_id> routing_table;
+    /** table of external routes  <global federate id, route id> */
+    RouteTable routing_table;
     /** FIFO queue for transmissions to the root that need to be delayed for a certain time */
     gmlc::containers::SimpleQueue<ActionMessage> delayTransmitQueue;
     /** external map for all known external endpoints with names and route */
@@ -399,6 +411,8 @@ class CommonCore: public Core, public BrokerBase {
     /** function for routing a message from based on the destination specified in the
      * ActionMessage*/
     void routeMessage(ActionMessage&& cmd);
+    /** split a multicast publication into one message per local federate or remote route*/
+    void routeMulticastMessage(ActionMessage&& cmd);
     /** check that a new interface is valid and is allowed to be created*/
     FederateState*
         checkNewInterface(LocalFederateId federateID, std::string_view key, InterfaceType type);
@@ -474,6 +488,8 @@ class CommonCore: public Core, public BrokerBase {
     ordered_guarded<HandleManager> handles;  //!< local handle information;
     /// copy of handles to use in the primary processing loop without thread protection
     HandleManager loopHandles;
+    /// cache of the loopHandles lookups of messages sent to named endpoints
+    DestinationCache namedDestinations;
     /// sets of ongoing time blocks from filtering
     std::vector<std::pair<GlobalFederateId, int32_t>> timeBlocks;
     TranslatorFederate* translatorFed{nullptr};
@@ -519,6 +535,9 @@ class CommonCore: public Core, public BrokerBase {
                           const std::vector<std::pair<GlobalHandle, std::string_view>>& targets);
     /** deliver a message to the appropriate location*/
     void deliverMessage(ActionMessage& message);
+    /** find the local endpoint a message addressed by name is going to
+    @return nullptr if the endpoint is not in the core*/
+    BasicHandleInfo* findNamedDestination(const ActionMessage& message);
     /** function to deal with a source filters*/
     ActionMessage& processMessage(ActionMessage& message);
     /** add a new handle to the generic structure
@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "LocalFederateId.hpp"
 #include "core-data.hpp"
 
+#include <exception>
 #include <functional>
 #include <memory>
 #include <string>
@@ -268,6 +269,28 @@ class Core {
     virtual iteration_time
         requestTimeIterative(LocalFederateId federateID, Time next, IterationRequest iterate) = 0;
 
+    /**
+     * Request a time advancement without blocking the calling thread.
+     *
+     * The completion is called with the same result requestTimeIterative would return once the
+     * request is granted.  If the request failed the result state is ERROR_RESULT and the second
+     * argument holds the exception timeRequest would have thrown.  It runs on one of the core
+     * threads so it must not make blocking calls on the federate.
+     *
+     * @param federateID the identifier for the federate to process
+     * @param next the requested time
+     * @param iterate the requested iteration mode /ref iteration_request
+     * @param completion the function to call with the result of the request
+     * @return true if the request was started, false if the federate or core cannot make
+     asynchronous requests, in which case the completion is not called and a blocking request
+     should be used instead
+     */
+    virtual bool
+        requestTimeAsync(LocalFederateId federateID,
+                         Time next,
+                         IterationRequest iterate,
+                         std::function<void(iteration_time, std::exception_ptr)> completion) = 0;
+
     /** blocking call that processes helics communication messages
      * this call can be used when expecting communication from other federates or when the federate
      * has nothing else to do and doesn't want to advance time
@@ -452,6 +475,17 @@ class Core {
     virtual const std::vector<std::shared_ptr<const SmallBuffer>>&
         getAllValues(InterfaceHandle handle) = 0;
 
+    /**
+     * Return the latest data for several inputs of a federate with a single lock of the federate
+     * @param federateID the federate the inputs belong to
+     * @param handles the input handles to get the data for
+     * @param[out] values the data for each handle in the same order, nullptr for handles that are
+     * not inputs of the federate
+     */
+    virtual void getValues(LocalFederateId federateID,
+                           const std::vector<InterfaceHandle>& handles,
+                           std::vector<std::shared_ptr<const SmallBuffer>>& values) = 0;
+
     /**
      * Returns vector of input handles that received an update during the last
      * time request.  The data remains valid until the next call to getValueUpdates for the given
@@ -738,6 +772,15 @@ class Core {
      */
     virtual std::unique_ptr<Message> receive(InterfaceHandle destination) = 0;
 
+    /**
+     * Returns all the buffered messages for the specified destination endpoint in time order.
+     @details this is a non-blocking call and retrieves the messages in a single operation
+     @param destination the endpoint handle to get the messages for
+     @param maxTime the latest message time to include, limited to the granted time
+     */
+    virtual std::vector<std::unique_ptr<Message>> receiveAll(InterfaceHandle destination,
+                                                             Time maxTime) = 0;
+
     /**
      * Receives a message for any destination.
      @details this is a non-blocking call and will return a nullptr if no messages are available
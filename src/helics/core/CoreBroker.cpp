@@ -24,6 +24,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "loggingHelper.hpp"
 #include "queryHelpers.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <fmt/format.h>
 #include <iostream>
 #include <limits>
@@ -89,9 +91,43 @@ route_id CoreBroker::getRoute(GlobalFederateId fedid) const
     if ((fedid == parent_broker_id) || (fedid == higher_broker_id)) {
         return parent_route_id;
     }
-    auto fnd = routing_table.find(fedid);
-    return (fnd != routing_table.end()) ? fnd->second :
-                                          parent_route_id;  // zero is the default route
+    return routing_table.find(fedid);  // zero is the default route
+}
+
+void CoreBroker::routeMulticastMessage(ActionMessage&& cmd)
+{
+    // group the targets by route so the payload is copied once per outgoing connection
+    std::map<route_id, std::vector<GlobalHandle>> routeTargets;
+    for (const auto& target : getMulticastDestinations(cmd)) {
+        routeTargets[getRoute(target.fed_id)].push_back(target);
+    }
+    std::size_t count{0};
+    for (const auto& [route, targets] : routeTargets) {
+        const bool lastRoute = (++count == routeTargets.size());
+        const bool multicast = (route == parent_route_id) ?
+            parentMulticast :
+            (multicastRoutes.find(route) != multicastRoutes.end());
+        if (!multicast) {
+            // connections that did not register with multicast support get a message per target
+            for (std::size_t ii = 0; ii < targets.size(); ++ii) {
+                auto pub = generateMulticastSubset(cmd, {targets[ii]});
+                if (lastRoute && ii + 1 == targets.size()) {
+                    pub.payload = std::move(cmd.payload);
+                } else {
+                    pub.payload = cmd.payload;
+                }
+                transmit(route, std::move(pub));
+            }
+            continue;
+        }
+        auto pub = generateMulticastSubset(cmd, targets);
+        if (lastRoute) {
+            pub.payload = std::move(cmd.payload);
+        } else {
+            pub.payload = cmd.payload;
+        }
+        transmit(route, std::move(pub));
+    }
 }
 
 BasicBrokerInfo* CoreBroker::getBrokerById(GlobalBrokerId brokerid)
@@ -231,7 +267,12 @@ void CoreBroker::addAlias(std::string_view interfaceKey, std::string_view alias)
 route_id CoreBroker::fillMessageRouteInformation(ActionMessage& mess)
 {
     const auto& endpointName = mess.getString(targetStringLoc);
-    auto* eptInfo = handles.getInterfaceHandle(endpointName, InterfaceType::ENDPOINT);
+    const auto generation = handles.nameGeneration();
+    BasicHandleInfo* eptInfo{nullptr};
+    if (!namedDestinations.find(mess.getSource(), endpointName, generation, eptInfo)) {
+        eptInfo = handles.getInterfaceHandle(endpointName, InterfaceType::ENDPOINT);
+        namedDestinations.store(mess.getSource(), endpointName, generation, eptInfo);
+    }
     if (eptInfo != nullptr) {
         mess.setDestination(eptInfo->handle);
         return getRoute(eptInfo->handle.fed_id);
@@ -307,13 +348,20 @@ void CoreBroker::brokerRegistration(ActionMessage&& command)
             // we would get this if the ack didn't go through for some reason
             brk->route = generateRouteId(jsonReply ? json_route_code : 0, routeCount++);
             addRoute(brk->route, command.getExtraData(), command.getString(targetStringLoc));
-            routing_table[brk->global_id] = brk->route;
+            routing_table.set(brk->global_id, brk->route);
+            if (!brk->_nonLocal && checkActionFlag(command, multicast_flag)) {
+                multicastRoutes.insert(brk->route);
+            }
 
             // sending the response message
             ActionMessage brokerReply(CMD_BROKER_ACK);
             brokerReply.source_id = global_broker_id_local;  // source is global root
             brokerReply.dest_id = brk->global_id;  // the new id
             brokerReply.name(command.name());  // the identifier of the broker
+            if (!brk->_nonLocal) {
+                setActionFlag(brokerReply, multicast_flag);
+            }
+            setActionFlag(brokerReply, binary_profiling_flag);
             if (no_ping) {
                 setActionFlag(brokerReply, slow_responding_flag);
             }
@@ -403,6 +451,10 @@ void CoreBroker::brokerRegistration(ActionMessage&& command)
         mBrokers.back()._observer = checkActionFlag(command, observer_flag);
     }
     mBrokers.back()._core = checkActionFlag(command, core_flag);
+    // only a direct connection can be sent multicast publications
+    if (!mBrokers.back()._nonLocal && checkActionFlag(command, multicast_flag)) {
+        multicastRoutes.insert(mBrokers.back().route);
+    }
     if (!isRootc) {
         if ((global_broker_id_local.isValid()) && (global_broker_id_local != parent_broker_id)) {
             command.source_id = global_broker_id_local;
@@ -436,6 +488,10 @@ void CoreBroker::brokerRegistration(ActionMessage&& command)
                 setActionFlag(brokerReply, async_timing_flag);
             }
         }
+        if (!mBrokers.back()._nonLocal) {
+            setActionFlag(brokerReply, multicast_flag);
+        }
+        setActionFlag(brokerReply, binary_profiling_flag);
         if (globalDisconnect) {
             setActionFlag(brokerReply, global_disconnect_flag);
         }
@@ -577,9 +633,8 @@ void CoreBroker::fedRegistration(ActionMessage&& command)
         auto route_id = (newFed) ? mFederates.back().route : mFederates.find(fedName)->route;
         auto global_fedid =
             (newFed) ? mFederates.back().global_id : mFederates.find(fedName)->global_id;
-        auto res = routing_table.emplace(global_fedid, route_id);
-        if (!res.second && !newFed) {
-            res.first->second = route_id;
+        if (!routing_table.emplace(global_fedid, route_id) && !newFed) {
+            routing_table.set(global_fedid, route_id);
         }
 
         // don't bother with the federate_table
@@ -733,6 +788,8 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 if (checkActionFlag(command, global_disconnect_flag)) {
                     globalDisconnect = true;
                 }
+                parentMulticast = checkActionFlag(command, multicast_flag);
+                parentBinaryProfiling = checkActionFlag(command, binary_profiling_flag);
                 return;
             }
             auto broker = mBrokers.find(command.name());
@@ -748,6 +805,15 @@ void CoreBroker::processPriorityCommand(ActionMessage&& command)
                 routing_table.emplace(broker->global_id, route);
                 command.source_id = global_broker_id_local;  // we want the intermediate broker to
                                                              // change the source_id
+                // the multicast support is for the next hop which is this broker for a direct
+                // connection, otherwise the intermediate broker sets it
+                if (broker->_nonLocal) {
+                    clearActionFlag(command, multicast_flag);
+                } else {
+                    setActionFlag(command, multicast_flag);
+                }
+                // the next hop is a child of this broker so it accepts binary profiler records
+                setActionFlag(command, binary_profiling_flag);
                 transmit(route, command);
             } else {
                 mBrokers.insert(command.name(), GlobalBrokerId{command.dest_id}, command.name());
@@ -875,6 +941,24 @@ int CoreBroker::generateMapObjectCounter() const
     return result;
 }
 
+std::map<route_id::BaseType, int> CoreBroker::generateRouteObjectCounters() const
+{
+    std::map<route_id::BaseType, int> counters;
+    for (const auto& brk : mBrokers) {
+        counters[brk.route.baseValue()] += static_cast<int>(brk.state);
+    }
+    for (const auto& fed : mFederates) {
+        counters[fed.route.baseValue()] += static_cast<int>(fed.state);
+    }
+    for (const auto& handle : handles) {
+        auto fed = mFederates.find(handle.getFederateId());
+        if (fed != mFederates.end()) {
+            ++counters[fed->route.baseValue()];
+        }
+    }
+    return counters;
+}
+
 void CoreBroker::transmitDelayedMessages()
 {
     auto msg = delayTransmitQueue.pop();
@@ -1396,6 +1480,9 @@ void CoreBroker::processCommand(ActionMessage&& command)
         case CMD_PUB:
             transmit(getRoute(command.dest_id), command);
             break;
+        case CMD_MULTICAST_PUB:
+            routeMulticastMessage(std::move(command));
+            break;
 
         case CMD_LOG:
         case CMD_REMOTE_LOG:
@@ -1505,10 +1592,14 @@ void CoreBroker::processCommand(ActionMessage&& command)
             break;
         case CMD_PROFILER_DATA:
             if (enable_profiling) {
-                saveProfilingData(command.payload.to_string());
+                saveProfilingData(command);
             } else {
                 if (isRootc) {
-                    saveProfilingData(command.payload.to_string());
+                    saveProfilingData(command);
+                } else if (checkActionFlag(command, indicator_flag) && !parentBinaryProfiling) {
+                    for (auto& prof : generateTextProfilingData(command)) {
+                        routeMessage(std::move(prof), parent_broker_id);
+                    }
                 } else {
                     routeMessage(std::move(command), parent_broker_id);
                 }
@@ -2418,6 +2509,7 @@ bool CoreBroker::connect()
                     ActionMessage reg(CMD_REG_BROKER);
                     reg.source_id = GlobalFederateId{};
                     reg.name(getIdentifier());
+                    setActionFlag(reg, multicast_flag);
                     if (no_ping) {
                         setActionFlag(reg, slow_responding_flag);
                     }
@@ -2714,53 +2806,90 @@ void CoreBroker::connectInterfaces(
     transmit(getRoute(connect.dest_id), connect);
 }
 
-void CoreBroker::findRegexMatch(const std::string& target,
-                                InterfaceType type,
-                                GlobalHandle handle,
-                                uint16_t flags)
+void CoreBroker::connectRegexMatches(const std::vector<GlobalHandle>& matches,
+                                     InterfaceType type,
+                                     GlobalHandle handle,
+                                     uint16_t flags)
 {
     const auto* dest = handles.findHandle(handle);
-
-    try {
-        auto matches = handles.regexSearch(target, type);
-        for (auto& mtch : matches) {
-            const auto* hnd = handles.findHandle(mtch);
-            if (hnd == nullptr) {
-                continue;
-            }
-            auto destFlags = flags;
-            if (dest != nullptr && dest->handleType == InterfaceType::FILTER) {
-                if (checkActionFlag(*dest, clone_flag)) {
-                    destFlags |= make_flags(clone_flag);
-                    flags |= make_flags(clone_flag);
-                }
-            }
-            if (type == InterfaceType::ENDPOINT &&
-                (dest == nullptr || dest->handleType != InterfaceType::FILTER)) {
-                destFlags = toggle_flag(destFlags, destination_target);
+    for (const auto& mtch : matches) {
+        const auto* hnd = handles.findHandle(mtch);
+        if (hnd == nullptr) {
+            continue;
+        }
+        auto destFlags = flags;
+        if (dest != nullptr && dest->handleType == InterfaceType::FILTER) {
+            if (checkActionFlag(*dest, clone_flag)) {
+                destFlags |= make_flags(clone_flag);
+                flags |= make_flags(clone_flag);
             }
-            connectInterfaces(*hnd,
-                              flags,
-                              (dest != nullptr) ? *dest :
-                                                  BasicHandleInfo(handle, getMatchType(type)),
-
-                              destFlags,
-                              std::make_pair(getAction(type),
-                                             getMatchAction(type,
-                                                            (dest != nullptr) ?
-                                                                dest->handleType :
-                                                                getMatchType(type))));
         }
-    }
-    catch (const std::invalid_argument& ia) {
-        LOG_WARNING(global_id.load(),
-                    getIdentifier(),
-                    fmt::format("invalid regular expression processing {}", ia.what()));
+        if (type == InterfaceType::ENDPOINT &&
+            (dest == nullptr || dest->handleType != InterfaceType::FILTER)) {
+            destFlags = toggle_flag(destFlags, destination_target);
+        }
+        connectInterfaces(*hnd,
+                          flags,
+                          (dest != nullptr) ? *dest : BasicHandleInfo(handle, getMatchType(type)),
+
+                          destFlags,
+                          std::make_pair(getAction(type),
+                                         getMatchAction(type,
+                                                        (dest != nullptr) ? dest->handleType :
+                                                                            getMatchType(type))));
     }
 }
 
 static constexpr auto regexKey = "REGEX:";
 
+void CoreBroker::processRegexTargets()
+{
+    const auto start = std::chrono::steady_clock::now();
+    struct RegexSearch {
+        std::vector<NamePattern> patterns;
+        std::vector<UnknownHandleManager::TargetInfo> targets;
+    };
+    std::map<InterfaceType, RegexSearch> searches;
+    unknownHandles.processUnknowns([this, &searches](const std::string& target,
+                                                     InterfaceType type,
+                                                     UnknownHandleManager::TargetInfo tinfo) {
+        if (target.compare(0, 6, regexKey) != 0) {
+            return;
+        }
+        try {
+            auto pattern = HandleManager::regexTargetPattern(target);
+            auto& search = searches[type];
+            search.patterns.push_back(std::move(pattern));
+            search.targets.push_back(tinfo);
+        }
+        catch (const std::invalid_argument& ia) {
+            LOG_WARNING(global_id.load(),
+                        getIdentifier(),
+                        fmt::format("invalid regular expression processing {}", ia.what()));
+        }
+    });
+    mRegexMatchStats = NameMatchStatistics{};
+    for (const auto& [type, search] : searches) {
+        NameMatchStatistics stats;
+        auto matches = handles.patternSearch(search.patterns, type, &stats);
+        mRegexMatchStats.names += stats.names;
+        for (std::size_t ii = 0; ii < 4; ++ii) {
+            mRegexMatchStats.patterns[ii] += stats.patterns[ii];
+        }
+        mRegexMatchStats.comparisons += stats.comparisons;
+        mRegexMatchStats.matches += stats.matches;
+        mRegexMatchStats.duration += stats.duration;
+        for (std::size_t ii = 0; ii < matches.size(); ++ii) {
+            connectRegexMatches(matches[ii],
+                                type,
+                                search.targets[ii].first,
+                                search.targets[ii].second);
+        }
+    }
+    mRegexPhaseTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
 void CoreBroker::executeInitializationOperations(bool iterating)
 {
     if (iterating) {
@@ -2871,13 +3000,7 @@ void CoreBroker::executeInitializationOperations(bool iterating)
             }
         }
         if (useRegex) {
-            unknownHandles.processUnknowns([this](const std::string& target,
-                                                  InterfaceType type,
-                                                  UnknownHandleManager::TargetInfo tinfo) {
-                if (target.compare(0, 6, regexKey) == 0) {
-                    findRegexMatch(target, type, tinfo.first, tinfo.second);
-                }
-            });
+            processRegexTargets();
             unknownHandles.clearUnknownsIf([](const std::string& target,
                                               InterfaceType /*type*/,
                                               UnknownHandleManager::TargetInfo /*tinfo*/) {
@@ -3403,30 +3526,19 @@ void CoreBroker::processDisconnectCommand(ActionMessage& command)
 
 void CoreBroker::checkInFlightQueries(GlobalBrokerId brkid)
 {
-    for (auto& builderData : mapBuilders) {
+    for (std::uint16_t index = 0; index < mapBuilders.size(); ++index) {
+        auto& builderData = mapBuilders[index];
         auto& builder = std::get<0>(builderData);
-        auto& requesters = std::get<1>(builderData);
         if (builder.isCompleted()) {
             return;
         }
         if (builder.clearComponents(brkid.baseValue())) {
-            auto str = builder.generate();
-            for (int ii = 0; ii < static_cast<int>(requesters.size()) - 1; ++ii) {
-                if (requesters[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requesters[ii].messageID, str);
-                } else {
-                    requesters[ii].payload = str;
-                    routeMessage(std::move(requesters[ii]));
-                }
-            }
-            if (requesters.back().dest_id == global_broker_id_local) {
-                activeQueries.setDelayedValue(requesters.back().messageID, std::move(str));
+            if (index == GLOBAL_STATUS || index == GLOBAL_FLUSH) {
+                sendMapResponses(index, builder.generate());
             } else {
-                requesters.back().payload = std::move(str);
-                routeMessage(std::move(requesters.back()));
+                mapHistory[index].update(builder);
+                sendMapResponses(index, mapHistory[index].snapshot());
             }
-
-            requesters.clear();
             if (std::get<2>(builderData) == QueryReuse::DISABLED) {
                 builder.reset();
             }
@@ -3663,6 +3775,7 @@ static const std::set<std::string> querySet{"isinit",
                                             "global_flush",
                                             "current_state",
                                             "unconnected_interfaces",
+                                            "interface_matching",
                                             "logs"};
 
 static const std::map<std::string_view, std::pair<std::uint16_t, QueryReuse>> mapIndex{
@@ -3678,6 +3791,34 @@ static const std::map<std::string_view, std::pair<std::uint16_t, QueryReuse>> ma
     {"unconnected_interfaces", {UNCONNECTED_INTERFACES, QueryReuse::DISABLED}},
     {"global_flush", {GLOBAL_FLUSH, QueryReuse::DISABLED}}};
 
+static constexpr std::string_view deltaKey{"delta:"};
+
+static std::uint64_t parseRevision(std::string_view revisionString)
+{
+    std::uint64_t revision{0};
+    auto result = std::from_chars(revisionString.data(),
+                                  revisionString.data() + revisionString.size(),
+                                  revision);
+    return (result.ec == std::errc{}) ? revision : 0;
+}
+
+/** split a query of the form delta:<map query>:<revision> into the map query and the revision*/
+static std::pair<std::string_view, std::optional<std::uint64_t>>
+    splitDeltaQuery(std::string_view request)
+{
+    if (request.compare(0, deltaKey.size(), deltaKey) != 0) {
+        return {request, std::nullopt};
+    }
+    request.remove_prefix(deltaKey.size());
+    std::uint64_t revision{0};
+    auto separator = request.find_last_of(':');
+    if (separator != std::string_view::npos) {
+        revision = parseRevision(request.substr(separator + 1));
+        request = request.substr(0, separator);
+    }
+    return {request, revision};
+}
+
 std::string CoreBroker::quickBrokerQueries(std::string_view request) const
 {
     if (request == "isinit") {
@@ -3735,6 +3876,20 @@ std::string CoreBroker::generateQueryAnswer(std::string_view request, bool force
     if (request == "summary") {
         return generateFederationSummary();
     }
+    if (request == "interface_matching") {
+        nlohmann::json base;
+        addHeader(base);
+        base["interfaces"] = mRegexMatchStats.names;
+        for (std::size_t ii = 0; ii < 4; ++ii) {
+            base["patterns"][patternTierName(static_cast<PatternTier>(ii))] =
+                mRegexMatchStats.patterns[ii];
+        }
+        base["comparisons"] = mRegexMatchStats.comparisons;
+        base["matches"] = mRegexMatchStats.matches;
+        base["search_time"] = std::chrono::duration<double>(mRegexMatchStats.duration).count();
+        base["total_time"] = std::chrono::duration<double>(mRegexPhaseTime).count();
+        return fileops::generateJsonString(base);
+    }
     if (request == "config") {
         nlohmann::json base;
         base["name"] = getIdentifier();
@@ -3830,33 +3985,42 @@ std::string CoreBroker::generateQueryAnswer(std::string_view request, bool force
     if (request.compare(0, 7, "rename:") == 0) {
         return generateRename(request.substr(7));
     }
-    auto mapping = mapIndex.find(request);
+    auto [mapRequest, deltaSince] = splitDeltaQuery(request);
+    auto mapping = mapIndex.find(mapRequest);
     if (mapping != mapIndex.end()) {
         auto index = mapping->second.first;
+        if (deltaSince && (index == GLOBAL_STATUS || index == GLOBAL_FLUSH)) {
+            return generateJsonErrorResponse(JsonErrorCodes::BAD_REQUEST,
+                                             "delta responses are not available for this query");
+        }
         if (isValidIndex(index, mapBuilders) && mapping->second.second == QueryReuse::ENABLED) {
             auto& builder = std::get<0>(mapBuilders[index]);
             if (builder.isCompleted()) {
                 auto center = generateMapObjectCounter();
                 if (center == builder.getCounterCode()) {
-                    return builder.generate();
+                    return generateMapResponse(index, deltaSince);
                 }
-                builder.reset();
-            }
-            if (builder.isActive()) {
+                // a stale map is refreshed from the children which changed
+            } else if (builder.isActive()) {
                 return "#wait";
             }
         }
 
-        initializeMapBuilder(request, index, mapping->second.second, force_ordering);
-        if (std::get<0>(mapBuilders[index]).isCompleted()) {
+        initializeMapBuilder(mapRequest, index, mapping->second.second, force_ordering);
+        auto& builder = std::get<0>(mapBuilders[index]);
+        if (builder.isCompleted()) {
             if (mapping->second.second == QueryReuse::ENABLED) {
                 auto center = generateMapObjectCounter();
-                std::get<0>(mapBuilders[index]).setCounterCode(center);
+                builder.setCounterCode(center);
             }
             if (index == GLOBAL_STATUS) {
-                return generateGlobalStatus(std::get<0>(mapBuilders[index]));
+                return generateGlobalStatus(builder);
+            }
+            if (index == GLOBAL_FLUSH) {
+                return builder.generate();
             }
-            return std::get<0>(mapBuilders[index]).generate();
+            mapHistory[index].update(builder);
+            return generateMapResponse(index, deltaSince);
         }
         return "#wait";
     }
@@ -3936,6 +4100,38 @@ std::string CoreBroker::generateGlobalStatus(fileops::JsonMapBuilder& builder)
     return fileops::generateJsonString(json);
 }
 
+std::string CoreBroker::generateMapResponse(std::uint16_t index,
+                                            std::optional<std::uint64_t> deltaSince) const
+{
+    auto history = mapHistory.find(index);
+    if (history == mapHistory.end()) {
+        return "{}";
+    }
+    return deltaSince ? history->second.generateDelta(*deltaSince) : history->second.snapshot();
+}
+
+void CoreBroker::sendMapResponses(std::uint16_t index, const std::string& response)
+{
+    auto& requesters = std::get<1>(mapBuilders[index]);
+    for (auto& requester : requesters) {
+        std::string answer;
+        if (requester.getStringData().empty()) {
+            answer = response;
+        } else {
+            // the revision of a delta request is stored with the waiting response
+            answer = generateMapResponse(index, parseRevision(requester.getStringData().front()));
+            requester.clearStringData();
+        }
+        if (requester.dest_id == global_broker_id_local) {
+            activeQueries.setDelayedValue(requester.messageID, std::move(answer));
+        } else {
+            requester.payload = std::move(answer);
+            routeMessage(std::move(requester));
+        }
+    }
+    requesters.clear();
+}
+
 std::string CoreBroker::getNameList(std::string_view gidString) const
 {
     if (gidString.back() == ']') {
@@ -3975,6 +4171,18 @@ void CoreBroker::initializeMapBuilder(std::string_view request,
     }
     std::get<2>(mapBuilders[index]) = reuse;
     auto& builder = std::get<0>(mapBuilders[index]);
+    // a reusable map only queries the children which changed since the previous map
+    std::vector<fileops::JsonMapBuilder::Component> previous;
+    std::map<route_id::BaseType, int> routeCounters;
+    auto& childCounters = mapChildCounters[index];
+    if (reuse == QueryReuse::ENABLED) {
+        if (builder.isCompleted()) {
+            previous = builder.extractComponents();
+        }
+        routeCounters = generateRouteObjectCounters();
+    } else {
+        childCounters.clear();
+    }
     builder.reset();
     nlohmann::json& base = builder.getJValue();
     addBaseInformation(base, !isRootc);
@@ -3994,23 +4202,34 @@ void CoreBroker::initializeMapBuilder(std::string_view request,
                 case ConnectionState::CONNECTED:
                 case ConnectionState::INIT_REQUESTED:
                 case ConnectionState::OPERATING: {
-                    int brkindex;
                     if (broker._core) {
                         if (!hasCores) {
                             hasCores = true;
                             base["cores"] = nlohmann::json::array();
                         }
-                        brkindex =
-                            builder.generatePlaceHolder("cores", broker.global_id.baseValue());
                     } else {
                         if (!hasBrokers) {
                             hasBrokers = true;
                             base["brokers"] = nlohmann::json::array();
                         }
-                        brkindex =
-                            builder.generatePlaceHolder("brokers", broker.global_id.baseValue());
                     }
-                    queryReq.messageID = brkindex;
+                    const std::string location{broker._core ? "cores" : "brokers"};
+                    const auto code = broker.global_id.baseValue();
+                    if (reuse == QueryReuse::ENABLED) {
+                        const auto counter = routeCounters[broker.route.baseValue()];
+                        auto lastCounter = childCounters.find(code);
+                        auto component =
+                            std::find_if(previous.begin(), previous.end(), [&](const auto& comp) {
+                                return comp.code == code && comp.location == location;
+                            });
+                        if (lastCounter != childCounters.end() && lastCounter->second == counter &&
+                            component != previous.end()) {
+                            builder.addComponent(std::move(*component));
+                            break;
+                        }
+                        childCounters[code] = counter;
+                    }
+                    queryReq.messageID = builder.generatePlaceHolder(location, code);
                     queryReq.dest_id = broker.global_id;
                     transmit(broker.route, queryReq);
                 } break;
@@ -4160,8 +4379,11 @@ void CoreBroker::processLocalQuery(const ActionMessage& message)
             }
             queryTimeouts.emplace_back(queryRep.messageID, std::chrono::steady_clock::now());
         }
-        std::get<1>(mapBuilders[mapIndex.at(message.payload.to_string()).first])
-            .push_back(queryRep);
+        auto [mapRequest, deltaSince] = splitDeltaQuery(message.payload.to_string());
+        if (deltaSince) {
+            queryRep.setStringData(std::to_string(*deltaSince));
+        }
+        std::get<1>(mapBuilders[mapIndex.at(mapRequest).first]).push_back(queryRep);
     } else if (queryRep.dest_id == global_broker_id_local) {
         activeQueries.setDelayedValue(message.messageID, std::string(queryRep.payload.to_string()));
     } else {
@@ -4430,7 +4652,6 @@ void CoreBroker::processQueryResponse(const ActionMessage& message)
     }
     if (isValidIndex(message.counter, mapBuilders)) {
         auto& builder = std::get<0>(mapBuilders[message.counter]);
-        auto& requesters = std::get<1>(mapBuilders[message.counter]);
         if (builder.addComponent(std::string(message.payload.to_string()), message.messageID)) {
             std::string str;
             switch (message.counter) {
@@ -4441,26 +4662,11 @@ void CoreBroker::processQueryResponse(const ActionMessage& message)
                     str = "{\"status\":true}";
                     break;
                 default:
-                    str = builder.generate();
+                    mapHistory[message.counter].update(builder);
+                    str = mapHistory[message.counter].snapshot();
                     break;
             }
-
-            for (int ii = 0; ii < static_cast<int>(requesters.size()) - 1; ++ii) {
-                if (requesters[ii].dest_id == global_broker_id_local) {
-                    activeQueries.setDelayedValue(requesters[ii].messageID, str);
-                } else {
-                    requesters[ii].payload = str;
-                    routeMessage(std::move(requesters[ii]));
-                }
-            }
-            if (requesters.back().dest_id == global_broker_id_local) {
-                activeQueries.setDelayedValue(requesters.back().messageID, std::move(str));
-            } else {
-                requesters.back().payload = std::move(str);
-                routeMessage(std::move(requesters.back()));
-            }
-
-            requesters.clear();
+            sendMapResponses(message.counter, str);
             if (std::get<2>(mapBuilders[message.counter]) == QueryReuse::DISABLED) {
                 builder.reset();
             } else {
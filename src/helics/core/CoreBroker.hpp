@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "BrokerBase.hpp"
 #include "FederateIdExtra.hpp"
 #include "HandleManager.hpp"
+#include "RouteTable.hpp"
 #include "TimeDependencies.hpp"
 #include "UnknownHandleManager.hpp"
 #include "gmlc/concurrency/DelayedObjects.hpp"
@@ -24,10 +25,13 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <any>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -104,6 +108,8 @@ class CoreBroker: public Broker, public BrokerBase {
     bool connectionEstablished{false};  //!< the setup has been received by the core loop thread
     bool initIterating{false};  //!< using init iterations in some cores
     int routeCount = 1;  //!< counter for creating new routes;
+    /// routes to child brokers and cores which accept multicast publication messages
+    std::set<route_id> multicastRoutes;
     /// container for all federates
     gmlc::containers::
         DualStringMappedVector<BasicFedInfo, GlobalFederateId, reference_stability::unstable>
@@ -116,13 +122,15 @@ class CoreBroker: public Broker, public BrokerBase {
     std::string mPreviousLocalBrokerIdentifier;
 
     HandleManager handles;  //!< structure for managing handles and search operations on handles
+    /// cache of the handle lookups of messages sent to named endpoints
+    DestinationCache namedDestinations;
     UnknownHandleManager unknownHandles;  //!< structure containing unknown targeted handles
     /// set of dependencies that need to be created on init
     std::vector<std::pair<std::string, GlobalFederateId>> delayedDependencies;
     /// map to translate global ids to local ones
     std::unordered_map<GlobalFederateId, LocalFederateId> global_id_translation;
     /// map for external routes  <global federate id, route id>
-    std::unordered_map<GlobalFederateId, route_id> routing_table;
+    RouteTable routing_table;
     /// external map for all known external endpoints with names and route
     std::unordered_map<std::string, route_id> knownExternalEndpoints;
     std::unordered_map<std::string, std::string> global_values;  //!< storage for global values
@@ -134,6 +142,10 @@ class CoreBroker: public Broker, public BrokerBase {
     /// holder for the query map builder information
     std::vector<std::tuple<fileops::JsonMapBuilder, std::vector<ActionMessage>, QueryReuse>>
         mapBuilders;
+    /// the last completed result of each map query for generating delta responses
+    std::map<std::uint16_t, fileops::JsonMapHistory> mapHistory;
+    /// the object counter of each child broker when it was last queried for a reusable map
+    std::map<std::uint16_t, std::map<GlobalBrokerId::BaseType, int>> mapChildCounters;
     /// timeout manager for queries
     std::deque<std::pair<int32_t, decltype(std::chrono::steady_clock::now())>> queryTimeouts;
 
@@ -155,6 +167,11 @@ class CoreBroker: public Broker, public BrokerBase {
     Time mTimeMonitorCurrentTime{Time::minVal()};  //!< the last time from the timing federate
     std::atomic<double> simTime{mInvalidSimulationTime};  //!< loaded simTime for logging
     Time mNextTimeBarrier{Time::maxVal()};  //!< the last known time barrier
+    /// statistics from the last matching of REGEX: targets to interfaces
+    NameMatchStatistics mRegexMatchStats;
+    /// time spent matching and connecting REGEX: targets during initialization
+    std::chrono::nanoseconds mRegexPhaseTime{0};
+
   private:
     /** function that processes all the messages
     @param command -- the message to process
@@ -182,6 +199,8 @@ class CoreBroker: public Broker, public BrokerBase {
      * ActionMessage*/
     void routeMessage(const ActionMessage& cmd);
     void routeMessage(ActionMessage&& cmd);
+    /** split a multicast publication into one message per outgoing route*/
+    void routeMulticastMessage(ActionMessage&& cmd);
     /** transmit a message to the parent or root */
     void transmitToParent(ActionMessage&& cmd);
     /** propagate an error message or escalate it depending on settings*/
@@ -350,10 +369,15 @@ class CoreBroker: public Broker, public BrokerBase {
     void findAndNotifyFilterTargets(BasicHandleInfo& handleInfo, const std::string& key);
     void findAndNotifyEndpointTargets(BasicHandleInfo& handleInfo, const std::string& key);
 
-    void findRegexMatch(const std::string& target,
-                        InterfaceType type,
-                        GlobalHandle handle,
-                        uint16_t flags);
+    /** match all the unknown REGEX: targets against the interfaces and connect them
+    @details the targets are grouped by interface type so the names of each type are indexed and
+    searched once*/
+    void processRegexTargets();
+    /** connect an interface to the interfaces matching its REGEX: target*/
+    void connectRegexMatches(const std::vector<GlobalHandle>& matches,
+                             InterfaceType type,
+                             GlobalHandle handle,
+                             uint16_t flags);
     /** process a disconnect message*/
     void processDisconnectCommand(ActionMessage& command);
     /** handle disconnect timing */
@@ -434,6 +458,13 @@ class CoreBroker: public Broker, public BrokerBase {
                               bool force_ordering);
 
     std::string generateGlobalStatus(fileops::JsonMapBuilder& builder);
+    /** generate the response to a map query from the last completed map
+    @param index the map index
+    @param deltaSince the revision a delta request is relative to, if any*/
+    std::string generateMapResponse(std::uint16_t index,
+                                    std::optional<std::uint64_t> deltaSince) const;
+    /** send a completed map to all the queries waiting on it*/
+    void sendMapResponses(std::uint16_t index, const std::string& response);
     /** send an error code to all direct cores*/
     void sendErrorToImmediateBrokers(int errorCode);
     /** send a disconnect message to time dependencies and child brokers*/
@@ -450,6 +481,8 @@ class CoreBroker: public Broker, public BrokerBase {
     /** generate a time barrier request*/
     void generateTimeBarrier(ActionMessage& message);
     int generateMapObjectCounter() const;
+    /** generate an object counter for the brokers and federates reached through each route*/
+    std::map<route_id::BaseType, int> generateRouteObjectCounters() const;
     /** handle the renaming operation*/
     std::string generateRename(std::string_view name);
     friend class TimeoutMonitor;
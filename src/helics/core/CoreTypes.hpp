@@ -58,6 +58,7 @@ enum class CoreType : int {
     TCP_SS = HELICS_CORE_TYPE_TCP_SS,  //!< a single socket version of the TCP core for more easily
                                        //!< handling firewalls
     UDP = HELICS_CORE_TYPE_UDP,  //!< use UDP packets to send the data
+    SHM = HELICS_CORE_TYPE_SHM,  //!< use shared memory ring buffers to transfer data
     NNG = HELICS_CORE_TYPE_NNG,  //!< reserved for future Nanomsg implementation
     ZMQ_SS = HELICS_CORE_TYPE_ZMQ_SS,  //!< single socket version of ZMQ core for better
                                        //!< scalability performance
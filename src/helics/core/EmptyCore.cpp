@@ -147,6 +147,15 @@ iteration_time EmptyCore::requestTimeIterative(LocalFederateId /*federateID*/,
     throw(InvalidFunctionCall("time request should only be called in execution state"));
 }
 
+bool EmptyCore::requestTimeAsync(
+    LocalFederateId /*federateID*/,
+    Time /*next*/,
+    IterationRequest /*iterate*/,
+    std::function<void(iteration_time, std::exception_ptr)> /*completion*/)
+{
+    return false;
+}
+
 void EmptyCore::processCommunications(LocalFederateId /*federateID*/,
                                       std::chrono::milliseconds /*msToWait*/)
 {
@@ -300,6 +309,13 @@ const std::vector<std::shared_ptr<const SmallBuffer>>&
     return emptyV;
 }
 
+void EmptyCore::getValues(LocalFederateId /*federateID*/,
+                          const std::vector<InterfaceHandle>& handles,
+                          std::vector<std::shared_ptr<const SmallBuffer>>& values)
+{
+    values.assign(handles.size(), nullptr);
+}
+
 const std::vector<InterfaceHandle>& EmptyCore::getValueUpdates(LocalFederateId /*federateID*/)
 {
     static const std::vector<InterfaceHandle> emptyV;
@@ -419,6 +435,12 @@ std::unique_ptr<Message> EmptyCore::receive(InterfaceHandle /*destination*/)
     return nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> EmptyCore::receiveAll(InterfaceHandle /*destination*/,
+                                                             Time /*maxTime*/)
+{
+    return {};
+}
+
 std::unique_ptr<Message> EmptyCore::receiveAny(LocalFederateId /*federateID*/,
                                                InterfaceHandle& /*endpoint_id*/)
 {
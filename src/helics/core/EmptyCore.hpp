@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "Core.hpp"
 
+#include <exception>
 #include <memory>
 #include <string>
 #include <utility>
@@ -52,6 +53,11 @@ class EmptyCore: public Core {
     virtual iteration_time requestTimeIterative(LocalFederateId federateID,
                                                 Time next,
                                                 IterationRequest iterate) override;
+    virtual bool
+        requestTimeAsync(LocalFederateId federateID,
+                         Time next,
+                         IterationRequest iterate,
+                         std::function<void(iteration_time, std::exception_ptr)> completion) override;
     virtual void processCommunications(LocalFederateId fedId,
                                        std::chrono::milliseconds msToWait) override final;
     virtual Time getCurrentTime(LocalFederateId federateID) const override;
@@ -108,6 +114,9 @@ class EmptyCore: public Core {
                                                                uint32_t* inputIndex) override;
     virtual const std::vector<std::shared_ptr<const SmallBuffer>>&
         getAllValues(InterfaceHandle handle) override;
+    virtual void getValues(LocalFederateId federateID,
+                           const std::vector<InterfaceHandle>& handles,
+                           std::vector<std::shared_ptr<const SmallBuffer>>& values) override;
     virtual const std::vector<InterfaceHandle>&
         getValueUpdates(LocalFederateId federateID) override;
     virtual InterfaceHandle registerEndpoint(LocalFederateId federateID,
@@ -159,6 +168,8 @@ class EmptyCore: public Core {
                              std::unique_ptr<Message> message) override;
     virtual uint64_t receiveCount(InterfaceHandle destination) override;
     virtual std::unique_ptr<Message> receive(InterfaceHandle destination) override;
+    virtual std::vector<std::unique_ptr<Message>> receiveAll(InterfaceHandle destination,
+                                                             Time maxTime) override;
     virtual std::unique_ptr<Message> receiveAny(LocalFederateId federateID,
                                                 InterfaceHandle& endpoint_id) override;
     virtual uint64_t receiveCountAny(LocalFederateId federateID) override;
@@ -7,10 +7,12 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "EndpointInfo.hpp"
 
 #include "../common/JsonGeneration.hpp"
+#include "MessagePool.hpp"
 #include "helics_definitions.hpp"
 // #include "core/core-data.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <fmt/format.h>
 #include <memory>
@@ -24,6 +26,7 @@ bool EndpointInfo::updateTimeUpTo(Time newTime)
 {
     int index{0};
     auto handle = message_queue.lock();
+    mergeIncoming(*handle);
 
     auto message = handle.begin();
     auto it_final = handle.end();
@@ -45,6 +48,7 @@ bool EndpointInfo::updateTimeNextIteration(Time newTime)
 {
     int index{0};
     auto handle = message_queue.lock();
+    mergeIncoming(*handle);
 
     auto message = handle.begin();
     auto it_final = handle.end();
@@ -66,6 +70,7 @@ bool EndpointInfo::updateTimeInclusive(Time newTime)
 {
     int index{0};
     auto handle = message_queue.lock();
+    mergeIncoming(*handle);
 
     auto message = handle.begin();
     auto it_final = handle.end();
@@ -87,6 +92,7 @@ std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
 {
     if (mAvailableMessages.load() > 0) {
         auto handle = message_queue.lock();
+        mergeIncoming(*handle);
         if (handle->empty()) {
             return nullptr;
         }
@@ -102,9 +108,25 @@ std::unique_ptr<Message> EndpointInfo::getMessage(Time maxTime)
     return nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> EndpointInfo::getMessages(Time maxTime)
+{
+    std::vector<std::unique_ptr<Message>> messages;
+    if (mAvailableMessages.load() > 0) {
+        auto handle = message_queue.lock();
+        mergeIncoming(*handle);
+        while (mAvailableMessages > 0 && !handle->empty() && handle->front()->time <= maxTime) {
+            --mAvailableMessages;
+            messages.push_back(std::move(handle->front()));
+            handle->pop_front();
+        }
+    }
+    return messages;
+}
+
 Time EndpointInfo::firstMessageTime() const
 {
-    auto handle = message_queue.lock_shared();
+    auto handle = message_queue.lock();
+    mergeIncoming(*handle);
     return (handle->empty()) ? Time::maxVal() : handle->front()->time;
 }
 
@@ -118,15 +140,39 @@ static auto msgSorter = [](const auto& message1, const auto& message2) {
 
 void EndpointInfo::addMessage(std::unique_ptr<Message> message)
 {
-    auto handle = message_queue.lock();
-    handle->push_back(std::move(message));
-    std::stable_sort(handle->begin(), handle->end(), msgSorter);
+    mIncoming.push(std::move(message));
+}
+
+void EndpointInfo::mergeIncoming(std::deque<std::unique_ptr<Message>>& queue) const
+{
+    const auto existing = static_cast<std::ptrdiff_t>(queue.size());
+    std::unique_ptr<Message> message;
+    while (mIncoming.try_pop(message)) {
+        queue.push_back(std::move(message));
+    }
+    if (static_cast<std::ptrdiff_t>(queue.size()) == existing) {
+        return;
+    }
+    // equivalent to a stable insertion of each message in arrival order
+    auto middle = queue.begin() + existing;
+    std::stable_sort(middle, queue.end(), msgSorter);
+    if (existing > 0 && msgSorter(*middle, *(middle - 1))) {
+        std::inplace_merge(queue.begin(), middle, queue.end(), msgSorter);
+    }
 }
 
 void EndpointInfo::clearQueue()
 {
+    auto handle = message_queue.lock();
     mAvailableMessages.store(0);
-    message_queue.lock()->clear();
+    std::unique_ptr<Message> message;
+    while (mIncoming.try_pop(message)) {
+        releaseMessage(std::move(message));
+    }
+    for (auto& queued : *handle) {
+        releaseMessage(std::move(queued));
+    }
+    handle->clear();
 }
 
 int32_t EndpointInfo::availableMessages() const
@@ -151,7 +197,8 @@ bool EndpointInfo::hasTarget() const
 
 int32_t EndpointInfo::queueSize(Time maxTime) const
 {
-    auto handle = message_queue.lock_shared();
+    auto handle = message_queue.lock();
+    mergeIncoming(*handle);
     int32_t cnt = 0;
     for (const auto& msg : *handle) {
         if (msg->time <= maxTime) {
@@ -165,7 +212,8 @@ int32_t EndpointInfo::queueSize(Time maxTime) const
 /** get the number of messages available prior to a specific time*/
 int32_t EndpointInfo::queueSizeUpTo(Time maxTime) const
 {
-    auto handle = message_queue.lock_shared();
+    auto handle = message_queue.lock();
+    mergeIncoming(*handle);
     int32_t cnt = 0;
     for (const auto& msg : *handle) {
         if (msg->time < maxTime) {
@@ -195,6 +243,31 @@ void EndpointInfo::addDestination(GlobalHandle dest,
     }
 }
 
+/** reconstruct delta encoded publication data sent to an endpoint*/
+bool EndpointInfo::reconstructData(GlobalHandle source, SmallBuffer& data, DeltaFrame frame)
+{
+    auto reference = std::find_if(deltaReferences.begin(),
+                                  deltaReferences.end(),
+                                  [source](const auto& ref) { return ref.first == source; });
+    if (frame == DeltaFrame::NONE) {
+        if (reference != deltaReferences.end()) {
+            reference->second.clear();
+        }
+        return true;
+    }
+    if (reference == deltaReferences.end()) {
+        deltaReferences.emplace_back(source, VectorDeltaReference{});
+        reference = deltaReferences.end() - 1;
+    }
+    auto full =
+        reference->second.update(std::make_shared<const SmallBuffer>(std::move(data)), frame);
+    if (!full) {
+        return false;
+    }
+    data = *full;
+    return true;
+}
+
 /** add a source to an endpoint*/
 void EndpointInfo::addSource(GlobalHandle source,
                              std::string_view sourceName,
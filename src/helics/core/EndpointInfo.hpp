@@ -7,6 +7,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include "../common/GuardedTypes.hpp"
+#include "SpscQueue.hpp"
+#include "VectorDelta.hpp"
 #include "basic_CoreTypes.hpp"
 
 #include <atomic>
@@ -41,13 +43,17 @@ class EndpointInfo {
     const std::string key;  //!< name of the endpoint
     const std::string type;  //!< type of the endpoint
   private:
-    /// storage for the messages
-    shared_guarded<std::deque<std::unique_ptr<Message>>> message_queue;
+    /// messages added by the federate which have not been merged into message_queue yet
+    mutable SpscQueue<std::unique_ptr<Message>> mIncoming;
+    /// storage for the messages in time order
+    mutable guarded<std::deque<std::unique_ptr<Message>>> message_queue;
     std::atomic<int32_t> mAvailableMessages{0};  //!< indicator of how many message are available
 
     std::vector<EndpointInformation> sourceInformation;
     std::vector<EndpointInformation> targetInformation;
     std::vector<std::pair<GlobalHandle, std::string_view>> targets;
+    /// the last full value from publications sending delta encoded values to the endpoint
+    std::vector<std::pair<GlobalHandle, VectorDeltaReference>> deltaReferences;
     mutable std::string sourceTargets;
     mutable std::string destinationTargets;
 
@@ -60,14 +66,23 @@ class EndpointInfo {
     int32_t requiredConnections{0};  //!< an exact number of connections required
     /** get the next message up to the specified time*/
     std::unique_ptr<Message> getMessage(Time maxTime);
+    /** get all the available messages up to the specified time in a single operation*/
+    std::vector<std::unique_ptr<Message>> getMessages(Time maxTime);
     /** get the number of messages in the queue up to the specified time*/
     int32_t availableMessages() const;
     /** get the number of messages available up to a specific time inclusive*/
     int32_t queueSize(Time maxTime) const;
     /** get the number of messages available prior to a specific time*/
     int32_t queueSizeUpTo(Time maxTime) const;
-    /** add a message to the queue*/
+    /** add a message to the queue
+    @details the message is staged without a lock and merged into the ordered queue the next time
+    the queue is read or the time is updated, only one thread may add messages at a time*/
     void addMessage(std::unique_ptr<Message> message);
+    /** get the full value of publication data sent to the endpoint
+    @details delta encoded values are reconstructed in place from the previous value from the source
+    @param frame the delta encoding role of the data from the flags of the publication message
+    @return false if the data could not be reconstructed and should be dropped*/
+    bool reconstructData(GlobalHandle source, SmallBuffer& data, DeltaFrame frame);
     /** update current data not including data at the specified time
     @param newTime the time to move the subscription to
     @return true if the value has changed
@@ -117,5 +132,9 @@ class EndpointInfo {
 
     void setProperty(int32_t option, int32_t value);
     int32_t getProperty(int32_t option) const;
+
+  private:
+    /** move the staged messages into the ordered queue*/
+    void mergeIncoming(std::deque<std::unique_ptr<Message>>& queue) const;
 };
 }  // namespace helics
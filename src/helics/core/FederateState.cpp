@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "EndpointInfo.hpp"
 #include "InputInfo.hpp"
 #include "LogManager.hpp"
+#include "MessagePool.hpp"
 #include "PublicationInfo.hpp"
 #include "TimeCoordinator.hpp"
 #include "TimeCoordinatorProcessing.hpp"
@@ -107,6 +108,24 @@ static const std::string gHelicsEmptyStr;
 using namespace std::chrono_literals;  // NOLINT
 
 namespace helics {
+/// the number of profiling records sent to the parent in a single message
+static constexpr std::size_t profilerBatchSize{256};
+
+#ifndef HELICS_DISABLE_ASIO
+/** get a timer tick fine enough for the real time tolerances of a federate*/
+static std::chrono::nanoseconds realTimeTickResolution(Time lead, Time lag)
+{
+    static constexpr std::chrono::nanoseconds minimumTick{std::chrono::microseconds(10)};
+    auto resolution = TimerWheel::defaultTickResolution;
+    for (auto tolerance : {lead, lag}) {
+        if (tolerance > timeZero && tolerance < Time::maxVal()) {
+            resolution = std::min(resolution, tolerance.to_ns() / 4);
+        }
+    }
+    return std::max(resolution, minimumTick);
+}
+#endif
+
 FederateState::FederateState(const std::string& fedName, const CoreFederateInfo& fedInfo):
     name(fedName),
     timeCoord(new TimeCoordinator([this](const ActionMessage& msg) { routeMessage(msg); })),
@@ -135,8 +154,12 @@ void FederateState::setState(FederateStates newState)
         return;
     }
     switch (newState) {
-        case FederateStates::ERRORED:
         case FederateStates::FINISHED:
+            state = newState;
+            // publications still in the queue will not be delivered
+            sharedPayloads.lock()->clear();
+            break;
+        case FederateStates::ERRORED:
         case FederateStates::CREATED:
         case FederateStates::TERMINATING:
             state = newState;
@@ -162,6 +185,7 @@ void FederateState::reset(const CoreFederateInfo& fedInfo)
     state = FederateStates::CREATED;
     queue.clear();
     delayQueues.clear();
+    sharedPayloads.lock()->clear();
     interfaceInformation.reset();
 
     timeCoord =
@@ -242,12 +266,25 @@ int32_t FederateState::getCurrentIteration() const
     return timeCoord->getCurrentIteration();
 }
 
-bool FederateState::checkAndSetValue(InterfaceHandle pub_id, const char* data, uint64_t len)
+bool FederateState::checkAndSetValue(InterfaceHandle pub_id,
+                                     const char* data,
+                                     uint64_t len,
+                                     SmallBuffer& encoded,
+                                     DeltaFrame& frame)
 {
     const std::lock_guard<FederateState> plock(*this);
     // this function could be called externally in a multi-threaded context
     auto* pub = interfaceInformation.getPublication(pub_id);
     auto res = pub->CheckSetValue(data, len, time_granted, only_transmit_on_change);
+    frame = DeltaFrame::NONE;
+    if (res && pub->deltaKeyframeInterval > 0) {
+        frame = DeltaFrame::KEYFRAME;
+        if (!pub->encodedData.empty()) {
+            encoded = std::move(pub->encodedData);
+            pub->encodedData.clear();
+            frame = DeltaFrame::DELTA;
+        }
+    }
     return res;
 }
 
@@ -302,6 +339,15 @@ std::unique_ptr<Message> FederateState::receive(InterfaceHandle hid)
     return nullptr;
 }
 
+std::vector<std::unique_ptr<Message>> FederateState::receiveAll(InterfaceHandle hid, Time maxTime)
+{
+    auto* epI = interfaceInformation.getEndpoint(hid);
+    if (epI != nullptr) {
+        return epI->getMessages(std::min(maxTime, time_granted));
+    }
+    return {};
+}
+
 std::unique_ptr<Message> FederateState::receiveAny(InterfaceHandle& hid)
 {
     Time earliest_time = Time::maxVal();
@@ -341,6 +387,21 @@ const std::vector<std::shared_ptr<const SmallBuffer>>&
     return interfaces().getInput(handle)->getAllData();
 }
 
+void FederateState::getValues(const std::vector<InterfaceHandle>& handles,
+                              std::vector<std::shared_ptr<const SmallBuffer>>& values)
+{
+    values.clear();
+    values.reserve(handles.size());
+    for (auto handle : handles) {
+        auto* input = interfaces().getInput(handle);
+        if (input != nullptr) {
+            values.push_back(input->getData(nullptr));
+        } else {
+            values.emplace_back();
+        }
+    }
+}
+
 std::pair<SmallBuffer, Time> FederateState::getPublishedValue(InterfaceHandle handle)
 {
     auto* pub = interfaces().getPublication(handle);
@@ -386,6 +447,8 @@ void FederateState::addAction(const ActionMessage& action)
         queue.push(action);
         if (mCallbackBased) {
             callbackProcessing();
+        } else if (mAsyncPending.load()) {
+            asyncTimeProcessing();
         }
     }
 }
@@ -396,10 +459,31 @@ void FederateState::addAction(ActionMessage&& action)
         queue.push(std::move(action));
         if (mCallbackBased) {
             callbackProcessing();
+        } else if (mAsyncPending.load()) {
+            asyncTimeProcessing();
         }
     }
 }
 
+std::uint32_t FederateState::addSharedPayload(std::shared_ptr<const SmallBuffer> data)
+{
+    const auto key = ++sharedPayloadCounter;
+    sharedPayloads.lock()->emplace(key, std::move(data));
+    return key;
+}
+
+std::shared_ptr<const SmallBuffer> FederateState::takeSharedPayload(std::uint32_t key)
+{
+    auto payloads = sharedPayloads.lock();
+    auto payload = payloads->find(key);
+    if (payload == payloads->end()) {
+        return {};
+    }
+    auto data = std::move(payload->second);
+    payloads->erase(payload);
+    return data;
+}
+
 void FederateState::createInterface(InterfaceType htype,
                                     InterfaceHandle handle,
                                     std::string_view key,
@@ -485,6 +569,12 @@ std::optional<ActionMessage>
         case CMD_REQUEST_CURRENT_TIME:
             optAct = ActionMessage(CMD_DISCONNECT, global_id.load(), action.source_id);
             break;
+        case CMD_MULTICAST_PUB:
+            // the publication is dropped so release the payload held for it
+            if (checkActionFlag(action, shared_payload_flag)) {
+                takeSharedPayload(action.sequenceID);
+            }
+            break;
         default:
             break;
     }
@@ -587,7 +677,8 @@ iteration_time FederateState::enterExecutingMode(IterationRequest iterate, bool
         if ((realtime) && (ret == MessageProcessingResult::NEXT_STEP)) {
             if (!mTimer) {
                 mTimer = std::make_shared<MessageTimer>(
-                    [this](ActionMessage&& mess) { return this->addAction(std::move(mess)); });
+                    [this](ActionMessage&& mess) { return this->addAction(std::move(mess)); },
+                    realTimeTickResolution(rt_lead, rt_lag));
             }
             start_clock_time = std::chrono::steady_clock::now();
         } else if (grantTimeOutPeriod > timeZero) {
@@ -709,77 +800,27 @@ iteration_time FederateState::requestTime(Time nextTime, IterationRequest iterat
             LOG_TRACE(timeCoord->printTimeStatus());
         }
 
-// timeCoord->timeRequest (nextTime, iterate, nextValueTime (), nextMessageTime ());
-#ifndef HELICS_DISABLE_ASIO
-        if ((realtime) && (rt_lag < Time::maxVal())) {
-            auto current_clock_time = std::chrono::steady_clock::now();
-            auto timegap = current_clock_time - start_clock_time;
-            auto current_lead = (nextTime + rt_lag).to_ns() - timegap;
-            if (current_lead > std::chrono::milliseconds(0)) {
-                ActionMessage tforce(CMD_FORCE_TIME_GRANT);
-                tforce.source_id = global_id.load();
-                tforce.actionTime = nextTime;
-                if (realTimeTimerIndex < 0) {
-                    realTimeTimerIndex =
-                        mTimer->addTimer(current_clock_time + current_lead, std::move(tforce));
-                } else {
-                    mTimer->updateTimer(realTimeTimerIndex,
-                                        current_clock_time + current_lead,
-                                        std::move(tforce));
-                }
-            } else {
-                ActionMessage tforce(CMD_FORCE_TIME_GRANT);
-                tforce.source_id = global_id.load();
-                tforce.actionTime = nextTime;
-                addAction(tforce);
-            }
-        } else if (grantTimeOutPeriod > timeZero) {
-            ActionMessage grantCheck(CMD_GRANT_TIMEOUT_CHECK);
-            grantCheck.setExtraData(static_cast<std::int32_t>(mGrantCount));
-            grantCheck.counter = 0;
-            if (grantTimeoutTimeIndex < 0) {
-                grantTimeoutTimeIndex =
-                    mTimer->addTimerFromNow(grantTimeOutPeriod.to_ms(), std::move(grantCheck));
-            } else {
-                mTimer->updateTimerFromNow(realTimeTimerIndex,
-                                           grantTimeOutPeriod.to_ms(),
-                                           std::move(grantCheck));
-            }
-        }
-#endif
+        // timeCoord->timeRequest (nextTime, iterate, nextValueTime (), nextMessageTime ());
+        startTimeRequestTimers(nextTime);
         auto ret = processQueue();
         updateDataForTimeReturn(ret, nextTime, iterate);
         iteration_time retTime = {time_granted, static_cast<IterationResult>(ret)};
+        stopTimeRequestTimers();
 #ifndef HELICS_DISABLE_ASIO
-        if (realtime) {
-            if (rt_lag < Time::maxVal()) {
-                mTimer->cancelTimer(realTimeTimerIndex);
-            }
-            if (ret == MessageProcessingResult::NEXT_STEP) {
-                auto current_clock_time = std::chrono::steady_clock::now();
-                auto timegap = current_clock_time - start_clock_time;
-                if (time_granted - Time(timegap) > rt_lead) {
-                    auto current_lead = (time_granted - rt_lead).to_ns() - timegap;
-                    if (current_lead > std::chrono::milliseconds(5)) {
-                        std::this_thread::sleep_for(current_lead);
-                    }
+        if (realtime && ret == MessageProcessingResult::NEXT_STEP) {
+            auto current_clock_time = std::chrono::steady_clock::now();
+            auto timegap = current_clock_time - start_clock_time;
+            if (time_granted - Time(timegap) > rt_lead) {
+                auto current_lead = (time_granted - rt_lead).to_ns() - timegap;
+                if (current_lead > std::chrono::milliseconds(5)) {
+                    std::this_thread::sleep_for(current_lead);
                 }
             }
-        } else if (grantTimeOutPeriod > timeZero) {
-            mTimer->cancelTimer(grantTimeoutTimeIndex);
         }
 #endif
 
         unlock();
-        if (retTime.grantedTime > nextTime && nextTime > lastTime &&
-            retTime.grantedTime < Time::maxVal()) {
-            if (!ignore_time_mismatch_warnings) {
-                LOG_WARNING(fmt::format(
-                    "Time mismatch detected: granted time greater than requested time {} vs {}",
-                    static_cast<double>(retTime.grantedTime),
-                    static_cast<double>(nextTime)));
-            }
-        }
+        checkTimeMismatch(lastTime, nextTime, retTime.grantedTime);
         return retTime;
     }
 
@@ -804,6 +845,190 @@ iteration_time FederateState::requestTime(Time nextTime, IterationRequest iterat
     return {time_granted, ret};
 }
 
+void FederateState::startTimeRequestTimers(Time nextTime)
+{
+#ifndef HELICS_DISABLE_ASIO
+    if ((realtime) && (rt_lag < Time::maxVal())) {
+        auto current_clock_time = std::chrono::steady_clock::now();
+        auto timegap = current_clock_time - start_clock_time;
+        auto current_lead = (nextTime + rt_lag).to_ns() - timegap;
+        ActionMessage tforce(CMD_FORCE_TIME_GRANT);
+        tforce.source_id = global_id.load();
+        tforce.actionTime = nextTime;
+        if (current_lead > std::chrono::milliseconds(0)) {
+            if (realTimeTimerIndex < 0) {
+                realTimeTimerIndex =
+                    mTimer->addTimer(current_clock_time + current_lead, std::move(tforce));
+            } else {
+                mTimer->updateTimer(realTimeTimerIndex,
+                                    current_clock_time + current_lead,
+                                    std::move(tforce));
+            }
+        } else {
+            addAction(tforce);
+        }
+    } else if (grantTimeOutPeriod > timeZero) {
+        ActionMessage grantCheck(CMD_GRANT_TIMEOUT_CHECK);
+        grantCheck.setExtraData(static_cast<std::int32_t>(mGrantCount));
+        grantCheck.counter = 0;
+        if (grantTimeoutTimeIndex < 0) {
+            grantTimeoutTimeIndex =
+                mTimer->addTimerFromNow(grantTimeOutPeriod.to_ms(), std::move(grantCheck));
+        } else {
+            mTimer->updateTimerFromNow(grantTimeoutTimeIndex,
+                                       grantTimeOutPeriod.to_ms(),
+                                       std::move(grantCheck));
+        }
+    }
+#else
+    (void)nextTime;
+#endif
+}
+
+void FederateState::stopTimeRequestTimers()
+{
+#ifndef HELICS_DISABLE_ASIO
+    if (realtime) {
+        if (rt_lag < Time::maxVal()) {
+            mTimer->cancelTimer(realTimeTimerIndex);
+        }
+    } else if (grantTimeOutPeriod > timeZero) {
+        mTimer->cancelTimer(grantTimeoutTimeIndex);
+    }
+#endif
+}
+
+void FederateState::checkTimeMismatch(Time lastTime, Time nextTime, Time grantedTime)
+{
+    if (grantedTime > nextTime && nextTime > lastTime && grantedTime < Time::maxVal()) {
+        if (!ignore_time_mismatch_warnings) {
+            LOG_WARNING(fmt::format(
+                "Time mismatch detected: granted time greater than requested time {} vs {}",
+                static_cast<double>(grantedTime),
+                static_cast<double>(nextTime)));
+        }
+    }
+}
+
+bool FederateState::requestTimeAsync(Time nextTime,
+                                     IterationRequest iterate,
+                                     std::function<void(iteration_time)> completion)
+{
+    if (realtime || mCallbackBased) {
+        return false;
+    }
+    sleeplock();
+    if (mAsyncPending.load()) {
+        // a request is already outstanding so report the current state like requestTime does
+        IterationResult ret = iterating ? IterationResult::ITERATING : IterationResult::NEXT_STEP;
+        if (state == FederateStates::FINISHED) {
+            ret = IterationResult::HALTED;
+        } else if (state == FederateStates::ERRORED) {
+            ret = IterationResult::ERROR_RESULT;
+        }
+        const iteration_time current{time_granted, ret};
+        unlock();
+        LOG_WARNING("duplicate time request attempted");
+        if (completion) {
+            completion(current);
+        }
+        return true;
+    }
+    events.clear();  // clear the event queue
+    LOG_TRACE(timeCoord->printTimeStatus());
+    mTimeCompletion = std::move(completion);
+    mAsyncLastTime = timeCoord->getGrantedTime();
+    mAsyncRequestTime = nextTime;
+    mAsyncIterate = iterate;
+    startTimeRequestTimers(nextTime);
+    mAsyncPending.store(true);
+    unlock();
+    // handle anything that arrived before the request was pending
+    asyncTimeProcessing();
+    return true;
+}
+
+void FederateState::asyncTimeProcessing() noexcept
+{
+    if (mAsyncWork.fetch_add(1, std::memory_order_acq_rel) != 0) {
+        // the thread already processing will go through the queue again
+        return;
+    }
+    std::function<void(iteration_time)> completion;
+    iteration_time result{timeZero, IterationResult::NEXT_STEP};
+    Time lastTime{timeZero};
+    Time requestTime{timeZero};
+    std::int32_t work{1};
+    do {
+        if (mAsyncPending.load()) {
+            const std::lock_guard<FederateState> fedlock(*this);
+            const bool initError = (state == FederateStates::ERRORED);
+            bool error_cmd{false};
+            auto ret_code = (state == FederateStates::FINISHED) ? MessageProcessingResult::HALTED :
+                                                                  processDelayQueue();
+            while (!returnableResult(ret_code)) {
+                auto cmd = queue.try_pop();
+                if (!cmd) {
+                    break;
+                }
+                if (messageShouldBeDelayed(*cmd)) {
+                    delayQueues[cmd->source_id].push_back(*cmd);
+                    continue;
+                }
+                ret_code = processActionMessage(*cmd);
+                if (ret_code == MessageProcessingResult::DELAY_MESSAGE) {
+                    delayQueues[static_cast<GlobalFederateId>(cmd->source_id)].push_back(*cmd);
+                }
+                if (ret_code == MessageProcessingResult::ERROR_RESULT &&
+                    cmd->action() == CMD_GLOBAL_ERROR) {
+                    error_cmd = true;
+                }
+            }
+            if (returnableResult(ret_code)) {
+                if (ret_code == MessageProcessingResult::ERROR_RESULT &&
+                    state == FederateStates::ERRORED && !initError && !error_cmd) {
+                    sendProcessingError();
+                }
+                if (initError) {
+                    ret_code = MessageProcessingResult::ERROR_RESULT;
+                }
+                updateDataForTimeReturn(ret_code, mAsyncRequestTime, mAsyncIterate);
+                result = {time_granted, static_cast<IterationResult>(ret_code)};
+                stopTimeRequestTimers();
+                lastTime = mAsyncLastTime;
+                requestTime = mAsyncRequestTime;
+                completion = std::move(mTimeCompletion);
+                mTimeCompletion = nullptr;
+                mAsyncPending.store(false);
+            }
+        }
+        work = mAsyncWork.fetch_sub(work, std::memory_order_acq_rel) - work;
+    } while (work != 0);
+    // called after releasing everything so the completion can make another request
+    if (completion) {
+        checkTimeMismatch(lastTime, requestTime, result.grantedTime);
+        completion(result);
+    }
+}
+
+void FederateState::sendProcessingError()
+{
+    if (mParent == nullptr) {
+        return;
+    }
+    ActionMessage gError(CMD_LOCAL_ERROR);
+    if (terminate_on_error) {
+        gError.setAction(CMD_GLOBAL_ERROR);
+    } else {
+        timeCoord->localError();
+    }
+    gError.source_id = global_id.load();
+    gError.dest_id = parent_broker_id;
+    gError.messageID = errorCode;
+    gError.payload = errorString;
+    mParent->addActionMessage(std::move(gError));
+}
+
 void FederateState::updateDataForTimeReturn(MessageProcessingResult result,
                                             Time nextTime,
                                             IterationRequest iterate)
@@ -958,6 +1183,8 @@ void FederateState::finalize()
             break;
         }
     }
+    // publications still pending will not be delivered
+    sharedPayloads.lock()->clear();
 #ifndef HELICS_DISABLE_ASIO
     ++mGrantCount;
     if (grantTimeOutPeriod > timeZero) {
@@ -1062,25 +1289,35 @@ bool FederateState::messageShouldBeDelayed(const ActionMessage& cmd) const noexc
     }
 }
 
+ProfilerRecord FederateState::generateProfilingRecord(ProfilerEvent event) const
+{
+    ProfilerRecord record;
+    record.steadyTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+    record.grantedTime = time_granted.getBaseTimeCode();
+    record.federateId = global_id.load().baseValue();
+    record.state = static_cast<std::uint8_t>(getState());
+    record.event = event;
+    return record;
+}
+
 void FederateState::generateProfilingMarker()
 {
-    auto ctime = std::chrono::steady_clock::now();
-    auto gtime = std::chrono::system_clock::now();
-    const std::string message = fmt::format(
-        "<PROFILING>{}[{}]({})MARKER<{}|{}>[t={}]</PROFILING>",
-        name,
-        global_id.load().baseValue(),
-        fedStateString(getState()),
-        std::chrono::duration_cast<std::chrono::nanoseconds>(ctime.time_since_epoch()).count(),
-        std::chrono::duration_cast<std::chrono::nanoseconds>(gtime.time_since_epoch()).count(),
-        static_cast<double>(time_granted));
+    auto record = generateProfilingRecord(ProfilerEvent::MARKER);
+    record.systemTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
 
     if (mLocalProfileCapture) {
-        logMessage(HELICS_LOG_LEVEL_PROFILING, name, message);
+        logMessage(HELICS_LOG_LEVEL_PROFILING, name, generateProfilingString(name, record));
     } else {
+        // markers can be generated outside of queue processing so are sent immediately
         if (mParent != nullptr) {
             ActionMessage prof(CMD_PROFILER_DATA, global_id.load(), parent_broker_id);
-            prof.payload = message;
+            setActionFlag(prof, indicator_flag);
+            prof.payload.assign(&record, sizeof(ProfilerRecord));
+            prof.setStringData(name);
             mParent->addActionMessage(std::move(prof));
         }
     }
@@ -1088,28 +1325,35 @@ void FederateState::generateProfilingMarker()
 
 void FederateState::generateProfilingMessage(bool enterHelicsCode)
 {
-    auto ctime = std::chrono::steady_clock::now();
-    static constexpr std::string_view entry_string("ENTRY");
-    static constexpr std::string_view exit_string("EXIT");
-    const std::string message = fmt::format(
-        "<PROFILING>{}[{}]({})HELICS CODE {}<{}>[t={}]</PROFILING>",
-        name,
-        global_id.load().baseValue(),
-        fedStateString(getState()),
-        (enterHelicsCode ? entry_string : exit_string),
-        std::chrono::duration_cast<std::chrono::nanoseconds>(ctime.time_since_epoch()).count(),
-        static_cast<double>(time_granted));
+    const auto record =
+        generateProfilingRecord(enterHelicsCode ? ProfilerEvent::ENTRY : ProfilerEvent::EXIT);
     if (mLocalProfileCapture) {
-        logMessage(HELICS_LOG_LEVEL_PROFILING, name, message);
+        logMessage(HELICS_LOG_LEVEL_PROFILING, name, generateProfilingString(name, record));
     } else {
-        if (mParent != nullptr) {
-            ActionMessage prof(CMD_PROFILER_DATA, global_id.load(), parent_broker_id);
-            prof.payload = message;
-            mParent->addActionMessage(std::move(prof));
+        mProfilerRecords.push_back(record);
+        if (mProfilerRecords.size() >= profilerBatchSize) {
+            flushProfilingRecords();
         }
     }
 }
 
+void FederateState::flushProfilingRecords()
+{
+    if (mProfilerRecords.empty()) {
+        return;
+    }
+    if (mParent != nullptr) {
+        ActionMessage prof(CMD_PROFILER_DATA, global_id.load(), parent_broker_id);
+        // the indicator flag marks the payload as binary profiler records
+        setActionFlag(prof, indicator_flag);
+        prof.payload.assign(mProfilerRecords.data(),
+                            mProfilerRecords.size() * sizeof(ProfilerRecord));
+        prof.setStringData(name);
+        mParent->addActionMessage(std::move(prof));
+    }
+    mProfilerRecords.clear();
+}
+
 void FederateState::initCallbackProcessing()
 {
     auto initIter = fedCallbacks->initializeOperations();
@@ -1295,19 +1539,7 @@ void FederateState::callbackProcessing() noexcept
         }
         if (ret_code == MessageProcessingResult::ERROR_RESULT && state == FederateStates::ERRORED) {
             if (!initError && !error_cmd) {
-                if (mParent != nullptr) {
-                    ActionMessage gError(CMD_LOCAL_ERROR);
-                    if (terminate_on_error) {
-                        gError.setAction(CMD_GLOBAL_ERROR);
-                    } else {
-                        timeCoord->localError();
-                    }
-                    gError.source_id = global_id.load();
-                    gError.dest_id = parent_broker_id;
-                    gError.messageID = errorCode;
-                    gError.payload = errorString;
-                    mParent->addActionMessage(std::move(gError));
-                }
+                sendProcessingError();
             }
         }
         if (initError) {
@@ -1354,20 +1586,7 @@ MessageProcessingResult FederateState::processQueue() noexcept
 
     if (ret_code == MessageProcessingResult::ERROR_RESULT && state == FederateStates::ERRORED) {
         if (!initError && !error_cmd) {
-            if (mParent != nullptr) {
-                ActionMessage gError(CMD_LOCAL_ERROR);
-                if (terminate_on_error) {
-                    gError.setAction(CMD_GLOBAL_ERROR);
-                } else {
-                    timeCoord->localError();
-                }
-                gError.source_id = global_id.load();
-                gError.dest_id = parent_broker_id;
-                gError.messageID = errorCode;
-                gError.payload = errorString;
-
-                mParent->addActionMessage(std::move(gError));
-            }
+            sendProcessingError();
         }
     }
     if (initError) {
@@ -1377,6 +1596,11 @@ MessageProcessingResult FederateState::processQueue() noexcept
     if (profilerActive) {
         generateProfilingMessage(false);
     }
+    if (!mProfilerRecords.empty() &&
+        (!mProfilerActive || ret_code == MessageProcessingResult::HALTED ||
+         ret_code == MessageProcessingResult::ERROR_RESULT)) {
+        flushProfilingRecords();
+    }
     return ret_code;
 }
 
@@ -1549,6 +1773,7 @@ MessageProcessingResult FederateState::processActionMessage(ActionMessage& cmd)
             break;
         case CMD_SEND_MESSAGE:
         case CMD_PUB:
+        case CMD_MULTICAST_PUB:
             processDataMessage(cmd);
             break;
         case CMD_LOG:
@@ -1829,57 +2054,57 @@ void FederateState::processDataMessage(ActionMessage& cmd)
             if (subI == nullptr) {
                 auto* eptI = interfaceInformation.getEndpoint(cmd.dest_handle);
                 if (eptI != nullptr) {
-                    // if (!epi->not_interruptible)
-                    {
-                        timeCoord->updateMessageTime(cmd.actionTime, !timeGranted_mode);
-                    }
-                    LOG_DATA(fmt::format("receive_message {}", prettyPrintString(cmd)));
-                    if (cmd.actionTime < time_granted &&
-                        timeMethod != TimeSynchronizationMethod::ASYNC) {
-                        LOG_WARNING(fmt::format(
-                            "received message {} at time({}) earlier than granted time({})",
-                            prettyPrintString(cmd),
-                            static_cast<double>(cmd.actionTime),
-                            static_cast<double>(time_granted)));
+                    if (eptI->reconstructData(
+                            cmd.getSource(), cmd.payload, getDeltaFrame(cmd.flags))) {
+                        addPublicationToEndpoint(eptI, cmd, std::move(cmd.payload));
                     }
-                    auto mess = std::make_unique<Message>();
-                    mess->data = std::move(cmd.payload);
-                    mess->dest = eptI->key;
-                    mess->flags = cmd.flags;
-                    mess->time = cmd.actionTime;
-                    mess->counter = cmd.counter;
-                    mess->messageID = cmd.messageID;
-                    mess->original_dest = eptI->key;
-                    eptI->addMessage(std::move(mess));
                     if (state <= FederateStates::EXECUTING) {
                         timeCoord->processTimeMessage(cmd);
                     }
                 }
                 break;
             }
-            for (auto& src : subI->input_sources) {
-                auto valueTime = cmd.actionTime;
-                if (timeMethod == TimeSynchronizationMethod::ASYNC) {
-                    if (valueTime < time_granted) {
-                        valueTime = time_granted;
-                    }
+            addPublicationToInput(subI,
+                                  cmd,
+                                  std::make_shared<const SmallBuffer>(std::move(cmd.payload)));
+            if (state <= FederateStates::EXECUTING) {
+                timeCoord->processTimeMessage(cmd);
+            }
+        } break;
+        case CMD_MULTICAST_PUB: {
+            // all the targets in this federate share a single copy of the data, which may also
+            // be shared with other federates in the same core
+            const auto targets = getMulticastDestinations(cmd);
+            std::shared_ptr<const SmallBuffer> data;
+            if (checkActionFlag(cmd, shared_payload_flag)) {
+                clearActionFlag(cmd, shared_payload_flag);
+                data = takeSharedPayload(cmd.sequenceID);
+                if (!data) {
+                    LOG_WARNING(
+                        fmt::format("missing shared payload for {}", prettyPrintString(cmd)));
+                    break;
                 }
-                if ((cmd.source_id == src.fed_id) && (cmd.source_handle == src.handle)) {
-                    if (subI->addData(src,
-                                      valueTime,
-                                      cmd.counter,
-                                      std::make_shared<const SmallBuffer>(
-                                          std::move(cmd.payload)))) {
-                        if (!subI->not_interruptible) {
-                            timeCoord->updateValueTime(valueTime, !timeGranted_mode);
-                            LOG_TRACE(timeCoord->printTimeStatus());
-                        }
-                        LOG_DATA(fmt::format("receive PUBLICATION {} from {}",
-                                             prettyPrintString(cmd),
-                                             subI->getSourceName(src)));
+            } else {
+                data = std::make_shared<const SmallBuffer>(std::move(cmd.payload));
+            }
+            const auto fedID = global_id.load();
+            for (const auto& target : targets) {
+                if (target.fed_id != fedID) {
+                    continue;
+                }
+                cmd.dest_handle = target.handle;
+                auto* subI = interfaceInformation.getInput(target.handle);
+                if (subI != nullptr) {
+                    addPublicationToInput(subI, cmd, data);
+                    continue;
+                }
+                auto* eptI = interfaceInformation.getEndpoint(target.handle);
+                if (eptI != nullptr) {
+                    SmallBuffer value(*data);
+                    if (eptI->reconstructData(
+                            cmd.getSource(), value, getDeltaFrame(cmd.flags))) {
+                        addPublicationToEndpoint(eptI, cmd, std::move(value));
                     }
-                    // this can only match once
-                    break;
                 }
             }
             if (state <= FederateStates::EXECUTING) {
@@ -1891,6 +2116,62 @@ void FederateState::processDataMessage(ActionMessage& cmd)
     }
 }
 
+void FederateState::addPublicationToInput(InputInfo* subI,
+                                          const ActionMessage& cmd,
+                                          const std::shared_ptr<const SmallBuffer>& data)
+{
+    for (auto& src : subI->input_sources) {
+        auto valueTime = cmd.actionTime;
+        if (timeMethod == TimeSynchronizationMethod::ASYNC) {
+            if (valueTime < time_granted) {
+                valueTime = time_granted;
+            }
+        }
+        if ((cmd.source_id == src.fed_id) && (cmd.source_handle == src.handle)) {
+            if (subI->addData(src, valueTime, cmd.counter, data, getDeltaFrame(cmd.flags))) {
+                if (!subI->not_interruptible) {
+                    timeCoord->updateValueTime(valueTime, !timeGranted_mode);
+                    LOG_TRACE(timeCoord->printTimeStatus());
+                }
+                LOG_DATA(fmt::format("receive PUBLICATION {} size {} from {}",
+                                     prettyPrintString(cmd),
+                                     data->size(),
+                                     subI->getSourceName(src)));
+            }
+            // this can only match once
+            break;
+        }
+    }
+}
+
+void FederateState::addPublicationToEndpoint(EndpointInfo* eptI,
+                                             const ActionMessage& cmd,
+                                             SmallBuffer&& data)
+{
+    // if (!epi->not_interruptible)
+    {
+        timeCoord->updateMessageTime(cmd.actionTime, !timeGranted_mode);
+    }
+    LOG_DATA(fmt::format("receive_message {}", prettyPrintString(cmd)));
+    if (cmd.actionTime < time_granted && timeMethod != TimeSynchronizationMethod::ASYNC) {
+        LOG_WARNING(fmt::format("received message {} at time({}) earlier than granted time({})",
+                                prettyPrintString(cmd),
+                                static_cast<double>(cmd.actionTime),
+                                static_cast<double>(time_granted)));
+    }
+    auto mess = acquireMessage();
+    mess->data = std::move(data);
+    mess->dest = eptI->key;
+    mess->flags = cmd.flags;
+    clearActionFlag(*mess, delta_encoded_flag);
+    clearActionFlag(*mess, delta_keyframe_flag);
+    mess->time = cmd.actionTime;
+    mess->counter = cmd.counter;
+    mess->messageID = cmd.messageID;
+    mess->original_dest = eptI->key;
+    eptI->addMessage(std::move(mess));
+}
+
 void FederateState::processLoggingMessage(ActionMessage& cmd)
 {
     switch (cmd.action()) {
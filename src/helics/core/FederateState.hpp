@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "BasicHandleInfo.hpp"
 #include "CoreTypes.hpp"
 #include "InterfaceInfo.hpp"
+#include "ProfilerBuffer.hpp"
 #include "core-data.hpp"
 #include "gmlc/containers/BlockingQueue.hpp"
 #include "helicsTime.hpp"
@@ -19,6 +20,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <atomic>
 #include <chrono>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -32,6 +34,7 @@ namespace helics {
 class SubscriptionInfo;
 class PublicationInfo;
 class EndpointInfo;
+class InputInfo;
 class FilterInfo;
 class CommonCore;
 class CoreFederateInfo;
@@ -103,6 +106,9 @@ class FederateState {
     /// flag indicating that the profiling should be captured in the federate log instead of
     /// forwarded
     bool mLocalProfileCapture{false};
+    /// profiling records waiting to be sent to the parent in a batch, only accessed while
+    /// processing the queue
+    std::vector<ProfilerRecord> mProfilerRecords;
     int errorCode{0};  //!< storage for an error code
     CommonCore* mParent{nullptr};  //!< pointer to the higher level;
     std::string errorString;  //!< storage for an error string populated on an error
@@ -132,6 +138,15 @@ class FederateState {
     TimeSynchronizationMethod timeMethod{TimeSynchronizationMethod::DISTRIBUTED};
     /** counter for the number of times time or execution mode has been granted */
     std::uint32_t mGrantCount{0};  // this is intended to allow wrapping
+    /// completion of the outstanding asynchronous time request
+    std::function<void(iteration_time)> mTimeCompletion;
+    Time mAsyncRequestTime{timeZero};  //!< the time of the asynchronous time request
+    Time mAsyncLastTime{timeZero};  //!< the granted time when the asynchronous request was made
+    IterationRequest mAsyncIterate{IterationRequest::NO_ITERATIONS};
+    /// flag indicating an asynchronous time request is waiting for its grant
+    std::atomic<bool> mAsyncPending{false};
+    /// count of the calls to process the queue for an asynchronous request
+    std::atomic<std::int32_t> mAsyncWork{0};
     /** message timer object for real time operations and timeouts */
     std::shared_ptr<MessageTimer> mTimer;
     /** processing queue for messages incoming to a federate */
@@ -140,6 +155,9 @@ class FederateState {
     gmlc::containers::BlockingQueue<std::pair<std::string, std::string>> commandQueue;
     /** current defaults for operational flags of interfaces for this federate */
     std::atomic<uint16_t> interfaceFlags{0};
+    /** payloads shared with other local federates waiting for their publication message*/
+    guarded<std::map<std::uint32_t, std::shared_ptr<const SmallBuffer>>> sharedPayloads;
+    std::atomic<std::uint32_t> sharedPayloadCounter{0};  //!< key for the next shared payload
     /** queue for delaying processing of messages for a time */
     std::map<GlobalFederateId, std::deque<ActionMessage>> delayQueues;
     std::vector<InterfaceHandle> events;  //!< list of value events to process
@@ -200,6 +218,10 @@ class FederateState {
     @param hid the handle of an endpoint or filter
     @return a pointer to a message -the ownership of the message is transferred to the caller*/
     std::unique_ptr<Message> receive(InterfaceHandle hid);
+    /** get all the available messages for an endpoint up to a specified time
+    @param hid the handle of an endpoint
+    @param maxTime the latest message time to include, the granted time is used if it is earlier*/
+    std::vector<std::unique_ptr<Message>> receiveAll(InterfaceHandle hid, Time maxTime);
     /** get any message ready for reception
     @param[out] hid the endpoint related to the message*/
     std::unique_ptr<Message> receiveAny(InterfaceHandle& hid);
@@ -215,6 +237,12 @@ class FederateState {
      */
     const std::vector<std::shared_ptr<const SmallBuffer>>& getAllValues(InterfaceHandle handle);
 
+    /**
+     * Load the data for several inputs, nullptr for handles that are not inputs of the federate
+     */
+    void getValues(const std::vector<InterfaceHandle>& handles,
+                   std::vector<std::shared_ptr<const SmallBuffer>>& values);
+
     /** getPublishedValue */
     std::pair<SmallBuffer, Time> getPublishedValue(InterfaceHandle handle);
     /** set the CommonCore object that is managing this Federate*/
@@ -333,6 +361,17 @@ class FederateState {
     /** process a message containing data
      */
     void processDataMessage(ActionMessage& cmd);
+    /** add publication data to an input
+    @param subI the input to add the data to
+    @param cmd the publication message, the payload is not used
+    @param data the data to add which may be shared with other inputs*/
+    void addPublicationToInput(InputInfo* subI,
+                               const ActionMessage& cmd,
+                               const std::shared_ptr<const SmallBuffer>& data);
+    /** retrieve and remove a shared payload stored by addSharedPayload*/
+    std::shared_ptr<const SmallBuffer> takeSharedPayload(std::uint32_t key);
+    /** add publication data to an endpoint as a message*/
+    void addPublicationToEndpoint(EndpointInfo* eptI, const ActionMessage& cmd, SmallBuffer&& data);
     /** run a timeout check*/
     void timeoutCheck(ActionMessage& cmd);
     /** process a logging message*/
@@ -366,11 +405,26 @@ class FederateState {
     void generateProfilingMessage(bool enterHelicsCode);
     /** generate a timing marker message system time + steady time*/
     void generateProfilingMarker();
+    /** send the batched profiling records to the parent*/
+    void flushProfilingRecords();
+    /** generate a profiling record for the current state of the federate*/
+    ProfilerRecord generateProfilingRecord(ProfilerEvent event) const;
     /** go through and update the max log level*/
     void updateMaxLogLevel();
 
     /** run the processing but don't block assuming a callback based federate*/
     void callbackProcessing() noexcept;
+    /** process the available messages for an asynchronous time request and call the completion
+    if the request returns, the thread that gets in first processes the work of all callers*/
+    void asyncTimeProcessing() noexcept;
+    /** set up the real time and grant timeout timers for a time request*/
+    void startTimeRequestTimers(Time nextTime);
+    /** cancel the timers set up for a time request once it returns*/
+    void stopTimeRequestTimers();
+    /** warn if a time request was granted a time after the requested time*/
+    void checkTimeMismatch(Time lastTime, Time nextTime, Time grantedTime);
+    /** notify the parent of an error encountered while processing the queue*/
+    void sendProcessingError();
     void callbackReturnResult(FederateStates lastState,
                               MessageProcessingResult result,
                               FederateStates newState) noexcept;
@@ -428,6 +482,19 @@ class FederateState {
     @return an iteration time with two elements the granted time and the iteration result
     */
     iteration_time requestTime(Time nextTime, IterationRequest iterate, bool sendRequest = false);
+    /** request a time advancement without blocking the calling thread
+    @details the queue is processed by the threads delivering messages to the federate and the
+    completion is called on one of them once the request returns, the completion must not call any
+    blocking operations on the federate.  Realtime and callback federates are not supported.  A
+    request made while another is outstanding completes immediately with the current time.
+    @param nextTime the time of the requested advancement
+    @param iterate the type of iteration requested
+    @param completion the function to call with the granted time and iteration result
+    @return false for realtime and callback federates, the completion is not called in that case
+    */
+    bool requestTimeAsync(Time nextTime,
+                          IterationRequest iterate,
+                          std::function<void(iteration_time)> completion);
     /** get a list of current subscribers to a publication
     @param handle the publication handle to use
     */
@@ -452,6 +519,12 @@ class FederateState {
     void addAction(const ActionMessage& action);
     /** move a message to the queue*/
     void addAction(ActionMessage&& action);
+    /** store a publication payload shared with other local federates
+    @details the key is sent in the sequenceID of a CMD_MULTICAST_PUB with the
+    shared_payload_flag set so the payload is not copied for each federate, it is released when the
+    message is processed or dropped, or when the federate finishes
+    @return the key for the payload*/
+    std::uint32_t addSharedPayload(std::shared_ptr<const SmallBuffer> data);
     /** sometime a message comes in after a federate has terminated and may require a response*/
     std::optional<ActionMessage> processPostTerminationAction(const ActionMessage& action);
 
@@ -507,9 +580,16 @@ class FederateState {
     @param pub_id the handle of the publication
     @param data the raw data to check
     @param len the length of the data
+    @param[out] encoded the delta encoded value to send in place of the data, left empty if the
+    data should be sent as is
+    @param[out] frame the delta encoding role of the value to mark on the publication message
     @return true if it should be published, false if not
     */
-    bool checkAndSetValue(InterfaceHandle pub_id, const char* data, uint64_t len);
+    bool checkAndSetValue(InterfaceHandle pub_id,
+                          const char* data,
+                          uint64_t len,
+                          SmallBuffer& encoded,
+                          DeltaFrame& frame);
 
     /** route a message either forward to parent or add to queue*/
     void routeMessage(const ActionMessage& msg);
@@ -25,6 +25,53 @@ SPDX-License-Identifier: BSD-3-Clause
 
 namespace helics {
 
+/** address a message produced by a filter to its destination endpoint by name*/
+static void readdressMessage(ActionMessage& command)
+{
+    command.setAction(CMD_SEND_MESSAGE);
+    command.dest_id = parent_broker_id;
+    command.dest_handle = InterfaceHandle{};
+}
+
+/** run a non-cloning filter operator on a message
+@details operators that support command processing work on the ActionMessage directly, the
+others see a Message built from it
+@return false if the operator dropped the message*/
+static bool runFilterOperator(FilterOperator& filterOp, ActionMessage& command)
+{
+    if (filterOp.supportsCommandProcessing()) {
+        if (!filterOp.processCommand(command)) {
+            return false;
+        }
+        readdressMessage(command);
+        return true;
+    }
+    auto message = filterOp.process(createMessageFromCommand(std::move(command)));
+    if (!message) {
+        return false;
+    }
+    command = std::move(message);
+    readdressMessage(command);
+    return true;
+}
+
+/** generate the messages from a cloning filter operator that supports command processing*/
+static std::vector<ActionMessage> runCloningOperator(FilterOperator& filterOp,
+                                                     const ActionMessage& command)
+{
+    std::vector<ActionMessage> messages;
+    if (!filterOp.processCommandVector(command, messages)) {
+        ActionMessage clone(command);
+        if (filterOp.processCommand(clone)) {
+            messages.push_back(std::move(clone));
+        }
+    }
+    for (auto& message : messages) {
+        readdressMessage(message);
+    }
+    return messages;
+}
+
 FilterFederate::FilterFederate(GlobalFederateId fedID,
                                std::string name,
                                GlobalBrokerId coreID,
@@ -82,6 +129,12 @@ void FilterFederate::processMessageFilter(ActionMessage& cmd)
             mCoord.triggered = true;
             if ((!checkActionFlag(*FiltI, disconnected_flag)) && (FiltI->filterOp)) {
                 if (FiltI->cloning) {
+                    if (FiltI->filterOp->supportsCommandProcessing()) {
+                        for (auto& msg : runCloningOperator(*FiltI->filterOp, cmd)) {
+                            mDeliverMessage(msg);
+                        }
+                        return;
+                    }
                     auto new_messages =
                         FiltI->filterOp->processVector(createMessageFromCommand(std::move(cmd)));
                     for (auto& msg : new_messages) {
@@ -98,20 +151,14 @@ void FilterFederate::processMessageFilter(ActionMessage& cmd)
                     auto filterCounter = cmd.counter;
                     auto seqID = cmd.sequenceID;
                     if (FiltI->filterOp) {
-                        auto tempMessage = createMessageFromCommand(std::move(cmd));
-                        auto dest = tempMessage->dest;
-                        tempMessage = FiltI->filterOp->process(std::move(tempMessage));
-
-                        if (tempMessage) {
-                            if (tempMessage->dest != dest && destFilter) {
+                        auto dest = cmd.getString(targetStringLoc);
+                        if (runFilterOperator(*FiltI->filterOp, cmd)) {
+                            if (destFilter && cmd.getString(targetStringLoc) != dest) {
                                 // the destination was altered we need to start the process over
-                                cmd = ActionMessage(std::move(tempMessage));
                                 cmd.dest_id = parent_broker_id;
                                 cmd.dest_handle = InterfaceHandle{};
                                 mDeliverMessage(cmd);
                                 cmd = CMD_IGNORE;
-                            } else {
-                                cmd = ActionMessage(std::move(tempMessage));
                             }
                         } else {
                             cmd = CMD_IGNORE;
@@ -263,30 +310,19 @@ void FilterFederate::processFilterReturn(ActionMessage& cmd)
         auto* filtFunc = getFilterCoordinator(handle->getInterfaceHandle());
         cmd.setAction(CMD_SEND_MESSAGE);
         bool needToSendMessage{true};
-        for (auto ii = static_cast<size_t>(cmd.counter) + 1; ii < filtFunc->sourceFilters.size();
-             ++ii) {
-            auto* filt = filtFunc->sourceFilters[ii];
-            if (checkActionFlag(*filt, disconnected_flag)) {
-                continue;
-            }
-
-            auto press = executeFilter(cmd, filt);
-            if (!press.second) {
-                if (cmd.action() == CMD_IGNORE) {
-                    needToSendMessage = false;
-                    break;
-                }
-
-                if (ii < filtFunc->sourceFilters.size() - 1) {
-                    cmd.counter = static_cast<uint16_t>(ii);
-                    cmd.setAction(CMD_SEND_FOR_FILTER_AND_RETURN);
-                    cmd.sequenceID = messageCounter++;
-                    cmd.setSource(handle->handle);
-                    generateProcessMarker(handle->getFederateId(), cmd.sequenceID, cmd.actionTime);
-                } else {
-                    cmd.setAction(CMD_SEND_FOR_FILTER);
-                }
-                break;
+        const auto& filters = filtFunc->sourceFilters;
+        auto ii = executeSourceFilters(cmd, filters, static_cast<size_t>(cmd.counter) + 1);
+        if (ii < filters.size()) {
+            if (cmd.action() == CMD_IGNORE) {
+                needToSendMessage = false;
+            } else if (ii < filters.size() - 1) {
+                cmd.counter = static_cast<uint16_t>(ii);
+                cmd.setAction(CMD_SEND_FOR_FILTER_AND_RETURN);
+                cmd.sequenceID = messageCounter++;
+                cmd.setSource(handle->handle);
+                generateProcessMarker(handle->getFederateId(), cmd.sequenceID, cmd.actionTime);
+            } else {
+                cmd.setAction(CMD_SEND_FOR_FILTER);
             }
         }
         acceptProcessReturn(fid, mid);
@@ -327,12 +363,50 @@ void FilterFederate::processDestFilterReturn(ActionMessage& command)
     }
 }
 
-std::pair<ActionMessage&, bool> FilterFederate::executeFilter(ActionMessage& command,
-                                                              FilterInfo* filt)
+std::size_t FilterFederate::executeSourceFilters(ActionMessage& command,
+                                                 const std::vector<FilterInfo*>& filters,
+                                                 std::size_t start)
 {
     mCoord.triggered = true;
-    if (filt->core_id == mFedID) {
+    // the Message shared by a run of operators that do not support command processing
+    std::unique_ptr<Message> message;
+    auto restoreCommand = [&command, &message]() {
+        if (message) {
+            command = std::move(message);
+            readdressMessage(command);
+        }
+    };
+    for (auto ii = start; ii < filters.size(); ++ii) {
+        auto* filt = filters[ii];
+        if (checkActionFlag(*filt, disconnected_flag)) {
+            continue;
+        }
+        if (filt->core_id != mFedID) {
+            restoreCommand();
+            if (!filt->cloning) {
+                command.dest_id = filt->core_id;
+                command.dest_handle = filt->handle;
+                return ii;
+            }
+            ActionMessage cloneMessage(command);
+            cloneMessage.setAction(CMD_SEND_FOR_FILTER);
+            setActionFlag(cloneMessage, clone_flag);
+            cloneMessage.dest_id = filt->core_id;
+            cloneMessage.dest_handle = filt->handle;
+            mSendMessage(cloneMessage);
+            continue;
+        }
+        if (!filt->filterOp) {
+            continue;
+        }
         if (filt->cloning) {
+            restoreCommand();
+            if (filt->filterOp->supportsCommandProcessing()) {
+                for (auto& msg : runCloningOperator(*filt->filterOp, command)) {
+                    mDeliverMessage(msg);
+                }
+                continue;
+            }
             // cloning filter returns a vector
             auto new_messages = filt->filterOp->processVector(createMessageFromCommand(command));
             for (auto& msg : new_messages) {
@@ -341,32 +415,29 @@ std::pair<ActionMessage&, bool> FilterFederate::executeFilter(ActionMessage& com
                     mDeliverMessage(cmd);
                 }
             }
-        } else {
-            // deal with local source filters
-            auto tempMessage = createMessageFromCommand(std::move(command));
-            tempMessage = filt->filterOp->process(std::move(tempMessage));
-            if (tempMessage) {
-                command = ActionMessage(std::move(tempMessage));
-            } else {
-                // the filter dropped the message;
+            continue;
+        }
+        if (filt->filterOp->supportsCommandProcessing()) {
+            restoreCommand();
+            if (!runFilterOperator(*filt->filterOp, command)) {
+                // the filter dropped the message
                 command = CMD_IGNORE;
-                return {command, false};
+                return ii;
             }
+            continue;
+        }
+        if (!message) {
+            message = createMessageFromCommand(std::move(command));
+        }
+        message = filt->filterOp->process(std::move(message));
+        if (!message) {
+            // the filter dropped the message
+            command = CMD_IGNORE;
+            return ii;
         }
-    } else if (filt->cloning) {
-        ActionMessage cloneMessage(command);
-        cloneMessage.setAction(CMD_SEND_FOR_FILTER);
-        setActionFlag(cloneMessage, clone_flag);
-        cloneMessage.dest_id = filt->core_id;
-        cloneMessage.dest_handle = filt->handle;
-        mSendMessage(cloneMessage);
-    } else {
-        command.dest_id = filt->core_id;
-        command.dest_handle = filt->handle;
-
-        return {command, false};
     }
-    return {command, true};
+    restoreCommand();
+    return filters.size();
 }
 
 ActionMessage& FilterFederate::processMessage(ActionMessage& command, const BasicHandleInfo* handle)
@@ -376,30 +447,19 @@ ActionMessage& FilterFederate::processMessage(ActionMessage& command, const Basi
         return command;
     }
     if (filtFunc->hasSourceFilters) {
-        //   for (int ii = 0; ii < static_cast<int> (filtFunc->sourceFilters.size ()); ++ii)
-        size_t ii = 0;
-        for (auto& filt : filtFunc->sourceFilters) {
-            if (checkActionFlag(*filt, disconnected_flag)) {
-                continue;
-            }
-            auto press = executeFilter(command, filt);
-            if (!press.second) {
-                if (command.action() == CMD_IGNORE) {
-                    return command;
-                }
-                command.counter = static_cast<uint16_t>(ii);
-                if (ii < filtFunc->sourceFilters.size() - 1) {
-                    command.setAction(CMD_SEND_FOR_FILTER_AND_RETURN);
-                    command.sequenceID = messageCounter++;
-                    generateProcessMarker(handle->getFederateId(),
-                                          command.sequenceID,
-                                          command.actionTime);
-                } else {
-                    command.setAction(CMD_SEND_FOR_FILTER);
-                }
-                return command;
+        const auto& filters = filtFunc->sourceFilters;
+        auto ii = executeSourceFilters(command, filters, 0);
+        if (ii < filters.size() && command.action() != CMD_IGNORE) {
+            command.counter = static_cast<uint16_t>(ii);
+            if (ii < filters.size() - 1) {
+                command.setAction(CMD_SEND_FOR_FILTER_AND_RETURN);
+                command.sequenceID = messageCounter++;
+                generateProcessMarker(handle->getFederateId(),
+                                      command.sequenceID,
+                                      command.actionTime);
+            } else {
+                command.setAction(CMD_SEND_FOR_FILTER);
             }
-            ++ii;
         }
     }
     return command;
@@ -434,14 +494,13 @@ bool FilterFederate::destinationProcessMessage(ActionMessage& command,
                 // the filter is part of this core
 
                 if (ffunc->destFilter->filterOp) {
-                    auto tempMessage = createMessageFromCommand(std::move(command));
-                    auto odest = tempMessage->dest;
-                    auto nmessage = ffunc->destFilter->filterOp->process(std::move(tempMessage));
-                    if (odest == nmessage->dest) {
-                        command = std::move(nmessage);
-                    } else {
+                    auto odest = command.getString(targetStringLoc);
+                    if (!runFilterOperator(*ffunc->destFilter->filterOp, command)) {
+                        // the filter dropped the message
+                        return false;
+                    }
+                    if (odest != command.getString(targetStringLoc)) {
                         // handle destination reroute filters
-                        command = std::move(nmessage);
                         mDeliverMessage(command);
                         return false;
                     }
@@ -468,7 +527,18 @@ void FilterFederate::runCloningDestinationFilters(const FilterCoordinator* fcoor
         if (clFilter->core_id == mFedID) {
             const auto* FiltI = getFilterInfo(mFedID, clFilter->handle);
             if (FiltI != nullptr) {
-                if (FiltI->filterOp != nullptr) {
+                if (FiltI->filterOp != nullptr && FiltI->filterOp->supportsCommandProcessing()) {
+                    for (auto& cmd : runCloningOperator(*FiltI->filterOp, command)) {
+                        if (cmd.getString(targetStringLoc) == handle->key) {
+                            // in case the clone filter send to itself.
+                            cmd.dest_id = handle->handle.fed_id;
+                            cmd.dest_handle = handle->handle.handle;
+                            mSendMessageMove(std::move(cmd));
+                        } else {
+                            mDeliverMessage(cmd);
+                        }
+                    }
+                } else if (FiltI->filterOp != nullptr) {
                     // this is a cloning filter so it generates a bunch(?) of new
                     // messages
                     auto new_messages =
@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/containers/MappedPointerVector.hpp"
 
 #include <any>
+#include <cstddef>
 #include <deque>
 #include <functional>
 #include <map>
@@ -149,7 +150,14 @@ class FilterFederate {
     void addTimeReturn(int32_t id, Time TimeVal);
     void clearTimeReturn(int32_t id);
 
-    std::pair<ActionMessage&, bool> executeFilter(ActionMessage& command, FilterInfo* filt);
+    /** run the source filters of an endpoint on a message starting from a given filter
+    @details consecutive local filters are run in a single pass.  Operators supporting command
+    processing work on the ActionMessage directly and a run of other operators shares one Message
+    @return the index of the filter the processing stopped at, or the number of filters if all of
+    them completed locally; the command is CMD_IGNORE if the message was dropped*/
+    std::size_t executeSourceFilters(ActionMessage& command,
+                                     const std::vector<FilterInfo*>& filters,
+                                     std::size_t start);
     void generateProcessMarker(GlobalFederateId fid, uint32_t pid, Time returnTime);
     void acceptProcessReturn(GlobalFederateId fid, uint32_t pid);
 
@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <nlohmann/json.hpp>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace helics {
@@ -143,7 +144,7 @@ MessageProcessingResult ForwardingTimeCoordinator::checkExecEntry(GlobalFederate
         bool allowed{false};
         if (downstream.mTimeState == TimeState::exec_requested_iterative) {
             allowed = true;
-            for (auto& dep : dependencies) {
+            for (const auto& dep : std::as_const(dependencies)) {
                 if (dep.dependency) {
                     if (dep.minFed != mSourceId) {
                         allowed = false;
@@ -180,7 +181,7 @@ void ForwardingTimeCoordinator::transmitTimingMessagesUpstream(ActionMessage& ms
         return;
     }
 
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.connection == ConnectionType::CHILD) {
             continue;
         }
@@ -202,7 +203,7 @@ void ForwardingTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage&
         return;
     }
     if ((msg.action() == CMD_TIME_REQUEST || msg.action() == CMD_TIME_GRANT)) {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.connection != ConnectionType::CHILD) {
                 continue;
             }
@@ -224,7 +225,7 @@ void ForwardingTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage&
             sendMessageFunction(msg);
         }
     } else {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.dependent) {
                 if (dep.fedID == skipFed) {
                     continue;
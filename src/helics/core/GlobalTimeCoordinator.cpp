@@ -62,15 +62,11 @@ void GlobalTimeCoordinator::sendTimeUpdateRequest(Time triggerTime)
 {
     ActionMessage updateTime(CMD_REQUEST_CURRENT_TIME, mSourceId, mSourceId);
     updateTime.counter = sequenceCounter;
-    for (auto& dep : dependencies) {
-        if (dep.next <= triggerTime && dep.next < cBigTime) {
-            updateTime.dest_id = dep.fedID;
-            updateTime.setExtraDestData(dep.sequenceCounter);
-            dep.updateRequested = true;
-            dep.grantedIteration = sequenceCounter;
-            sendMessageFunction(updateTime);
-        }
-    }
+    dependencies.requestUpdates(triggerTime, sequenceCounter, [&](const DependencyInfo& dep) {
+        updateTime.dest_id = dep.fedID;
+        updateTime.setExtraDestData(dep.sequenceCounter);
+        sendMessageFunction(updateTime);
+    });
 }
 
 bool GlobalTimeCoordinator::updateTimeFactors()
@@ -117,7 +113,7 @@ bool GlobalTimeCoordinator::updateTimeFactors()
 
                 ++sequenceCounter;
                 updateTime.counter = sequenceCounter;
-                for (const auto& dep : dependencies) {
+                for (const auto& dep : std::as_const(dependencies)) {
                     if (dep.next <= trigTime && dep.next < cBigTime) {
                         updateTime.dest_id = dep.fedID;
                         updateTime.setExtraDestData(dep.sequenceCounter);
@@ -128,7 +124,7 @@ bool GlobalTimeCoordinator::updateTimeFactors()
                 currentMinTime = timeStream.Te;
                 nextEvent = timeStream.Te;
             } else {
-                for (auto& dep : dependencies) {
+                for (const auto& dep : std::as_const(dependencies)) {
                     if (dep.updateRequested) {
                         continue;
                     }
@@ -199,7 +195,7 @@ MessageProcessingResult GlobalTimeCoordinator::checkExecEntry(GlobalFederateId /
         bool allowed{false};
         if (currentTimeState == TimeState::exec_requested_iterative) {
             allowed = true;
-            for (const auto& dep : dependencies) {
+            for (const auto& dep : std::as_const(dependencies)) {
                 if (dep.dependency) {
                     if (dep.minFed != mSourceId) {
                         allowed = false;
@@ -236,7 +232,7 @@ void GlobalTimeCoordinator::transmitTimingMessagesUpstream(ActionMessage& msg) c
         return;
     }
 
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.connection == ConnectionType::CHILD) {
             continue;
         }
@@ -258,7 +254,7 @@ void GlobalTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage& msg,
         return;
     }
     if ((msg.action() == CMD_TIME_REQUEST || msg.action() == CMD_TIME_GRANT)) {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.connection != ConnectionType::CHILD) {
                 continue;
             }
@@ -277,7 +273,7 @@ void GlobalTimeCoordinator::transmitTimingMessagesDownstream(ActionMessage& msg,
             sendMessageFunction(msg);
         }
     } else {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.dependent) {
                 if (dep.fedID == skipFed) {
                     continue;
@@ -7,7 +7,6 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "HandleManager.hpp"
 
 #include <algorithm>
-#include <regex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -86,6 +85,7 @@ void HandleManager::removeHandle(GlobalHandle handle)
     }
     // construct a blank at the previous index
     new (&(handles[index])) BasicHandleInfo;
+    ++mNameGeneration;
 }
 
 void HandleManager::removeFederateHandles(GlobalFederateId fedToRemove)
@@ -342,31 +342,51 @@ const BasicHandleInfo* HandleManager::getInterfaceHandle(std::string_view name,
 std::vector<GlobalHandle> HandleManager::regexSearch(const std::string& regexExpression,
                                                      InterfaceType type) const
 {
-    const auto& imap = getMap(type);
-    std::vector<GlobalHandle> matches;
     if (regexExpression.compare(0, 6, "REGEX:") != 0) {
-        return matches;
+        return {};
     }
+    std::vector<NamePattern> patterns{regexTargetPattern(regexExpression)};
+    return std::move(patternSearch(patterns, type).front());
+}
 
-    std::string rex = regexExpression.substr(6);
-    if (rex == "*") {
-        rex = ".*";
-    }
-    try {
-        const std::regex rgx(rex);
-        for (const auto& mres : imap) {
-            if (std::regex_match(mres.first.data(), rgx)) {
-                const auto* handle = getHandleInfo(mres.second);
-                matches.push_back(handle->handle);
-            }
+std::vector<std::vector<GlobalHandle>>
+    HandleManager::patternSearch(const std::vector<NamePattern>& patterns,
+                                 InterfaceType type,
+                                 NameMatchStatistics* stats) const
+{
+    const auto& imap = getMap(type);
+    std::vector<std::string_view> names;
+    names.reserve(imap.size());
+    for (const auto& mres : imap) {
+        names.push_back(mres.first);
+    }
+    NameMatcher matcher(std::move(names));
+    auto nameMatches = matcher.match(patterns);
+    if (stats != nullptr) {
+        *stats = matcher.statistics();
+    }
+    std::vector<std::vector<GlobalHandle>> matches(patterns.size());
+    for (std::size_t ii = 0; ii < patterns.size(); ++ii) {
+        matches[ii].reserve(nameMatches[ii].size());
+        for (const auto& name : nameMatches[ii]) {
+            const auto* handle = getHandleInfo(imap.find(name)->second);
+            matches[ii].push_back(handle->handle);
         }
     }
-    catch (const std::regex_error& re) {
-        throw std::invalid_argument(re.what());
-    }
     return matches;
 }
 
+NamePattern HandleManager::regexTargetPattern(std::string_view target)
+{
+    if (target.compare(0, 6, "REGEX:") == 0) {
+        target.remove_prefix(6);
+    }
+    if (target == "*") {
+        return NamePattern(".*");
+    }
+    return NamePattern(target);
+}
+
 BasicHandleInfo* HandleManager::getInterfaceHandle(InterfaceHandle handle, InterfaceType type)
 {
     auto index = handle.baseValue();
@@ -408,6 +428,7 @@ void HandleManager::addAlias(std::string_view interfaceName, std::string_view al
     auto [iName, existing2] = alias_names.emplace(interfaceName);
     const std::string& aliasStableName = *aliasName;
     const std::string& interfaceStableName = *iName;
+    ++mNameGeneration;
 
     bool cascade = addAliasName(interfaceStableName, aliasStableName);
 
@@ -567,6 +588,7 @@ static void addFields(std::string_view key,
 
 void HandleManager::addSearchFields(const BasicHandleInfo& handle, int32_t index)
 {
+    ++mNameGeneration;
     if (!handle.key.empty()) {
         switch (handle.handleType) {
             case InterfaceType::ENDPOINT:
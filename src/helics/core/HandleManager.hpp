@@ -5,10 +5,12 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
+#include "../common/NameMatcher.hpp"
 #include "BasicHandleInfo.hpp"
 #include "Core.hpp"
 #include "helicsTime.hpp"
 
+#include <cstdint>
 #include <deque>
 #include <string>
 #include <string_view>
@@ -43,6 +45,9 @@ class HandleManager {
     /// set of all valid aliases <interface_name,aliases>
     std::unordered_map<std::string_view, std::vector<std::string_view>> aliases;
     std::unordered_set<std::string> alias_names;  //!< set of actual alias strings
+    /// incremented whenever the set of names that can be looked up changes
+    std::uint32_t mNameGeneration{0};
+
   public:
     /** default constructor*/
     HandleManager() = default;
@@ -108,9 +113,23 @@ class HandleManager {
     auto begin() const { return handles.begin(); }
     auto end() const { return handles.end(); }
     auto size() const { return handles.size(); }
+    /** get a counter which changes any time an interface name is added, removed, or aliased
+    @details results of name lookups can be cached as long as the generation is unchanged*/
+    std::uint32_t nameGeneration() const { return mNameGeneration; }
     /* search for handles based on a regex string and type*/
     std::vector<GlobalHandle> regexSearch(const std::string& regexExpression,
                                           InterfaceType type) const;
+    /** search for the handles matching each of a set of name patterns
+    @param patterns the patterns to match against the interface names
+    @param type the type of interface to search
+    @param stats optional location to store the statistics of the search
+    @return a vector of the matching handles for each pattern*/
+    std::vector<std::vector<GlobalHandle>> patternSearch(const std::vector<NamePattern>& patterns,
+                                                         InterfaceType type,
+                                                         NameMatchStatistics* stats = nullptr) const;
+    /** generate the name pattern for a REGEX: target
+    @throw std::invalid_argument if the target is not a valid regular expression*/
+    static NamePattern regexTargetPattern(std::string_view target);
     /** get all the aliases*/
     const std::unordered_map<std::string_view, std::vector<std::string_view>>& getAliases() const
     {
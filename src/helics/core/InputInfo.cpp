@@ -85,7 +85,8 @@ static auto recordComparison = [](const InputInfo::dataRecord& rec1,
 bool InputInfo::addData(GlobalHandle source_id,
                         Time valueTime,
                         unsigned int iteration,
-                        std::shared_ptr<const SmallBuffer> data)
+                        std::shared_ptr<const SmallBuffer> data,
+                        DeltaFrame frame)
 {
     if (!data) {
         return false;
@@ -104,6 +105,11 @@ bool InputInfo::addData(GlobalHandle source_id,
     if (!found) {
         return false;
     }
+    // the reference must be updated even if the value is filtered out below
+    data = delta_references[index].update(std::move(data), frame);
+    if (!data) {
+        return false;
+    }
     if (data_queues[index].empty()) {
         if (current_data[index]) {
             if (minTimeGap > timeZero) {
@@ -155,6 +161,19 @@ bool InputInfo::addData(GlobalHandle source_id,
     return true;
 }
 
+std::shared_ptr<const SmallBuffer>
+    InputInfo::reconstructData(GlobalHandle source_id,
+                               std::shared_ptr<const SmallBuffer> data,
+                               DeltaFrame frame)
+{
+    for (std::size_t index = 0; index < input_sources.size(); ++index) {
+        if (input_sources[index] == source_id) {
+            return delta_references[index].update(std::move(data), frame);
+        }
+    }
+    return data;
+}
+
 bool InputInfo::addSource(GlobalHandle newSource,
                           std::string_view sourceName,
                           std::string_view stype,
@@ -180,6 +199,7 @@ bool InputInfo::addSource(GlobalHandle newSource,
     input_sources.push_back(newSource);
     source_info.emplace_back(sourceName, stype, sunits);
     data_queues.resize(input_sources.size());
+    delta_references.resize(input_sources.size());
     current_data.resize(input_sources.size());
     current_data_time.resize(input_sources.size(), {Time::minVal(), 0});
     deactivated.push_back(Time::maxVal());
@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include "VectorDelta.hpp"
 #include "basic_CoreTypes.hpp"
 
 #include <memory>
@@ -84,6 +85,8 @@ class InputInfo {
     std::vector<int32_t> priority_sources;  //!< the list of priority inputs;
   private:
     std::vector<std::vector<dataRecord>> data_queues;  //!< queue of the data
+    /// the last full value received from each source for reconstructing delta encoded values
+    std::vector<VectorDeltaReference> delta_references;
 
   public:
     /** get all the current data*/
@@ -93,11 +96,21 @@ class InputInfo {
     /** get a the most recent data point*/
     const std::shared_ptr<const SmallBuffer>& getData(uint32_t* inputIndex) const;
     /** add a data block into the queue
+    @param frame the delta encoding role of the data from the flags of the publication message
     @return true if the data was accepted and added to queues*/
     [[nodiscard]] bool addData(GlobalHandle source_id,
                                Time valueTime,
                                unsigned int iteration,
-                               std::shared_ptr<const SmallBuffer> data);
+                               std::shared_ptr<const SmallBuffer> data,
+                               DeltaFrame frame = DeltaFrame::NONE);
+
+    /** get the full value of data received from a source
+    @details delta encoded values are reconstructed from the previous value from the source, this
+    is called by addData and only needs to be called directly for data that is not queued
+    @return the full value or nullptr if the data could not be reconstructed*/
+    std::shared_ptr<const SmallBuffer> reconstructData(GlobalHandle source_id,
+                                                       std::shared_ptr<const SmallBuffer> data,
+                                                       DeltaFrame frame);
 
     /** update current data not including data at the specified time
     @param newTime the time to move the subscription to
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "MessagePool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace helics {
+
+/// strings with a larger capacity are released rather than kept in a cached message
+static constexpr std::size_t maxRetainedStringCapacity{256};
+/// the number of messages moved between a thread cache and the shared pool at once
+static constexpr std::size_t transferCount{maxCachedMessages / 4};
+
+namespace {
+    /** released messages available to all threads
+    @details the storage is fixed so moving messages in and out never allocates*/
+    class SharedMessagePool {
+      public:
+        /** move up to count messages into storage starting at destination
+        @return the number of messages moved*/
+        std::size_t take(std::unique_ptr<Message>* destination, std::size_t count) noexcept
+        {
+            const std::lock_guard<std::mutex> lock(poolLock);
+            const auto moved = std::min(count, available);
+            for (std::size_t ii = 0; ii < moved; ++ii) {
+                destination[ii] = std::move(messages[--available]);
+            }
+            return moved;
+        }
+        /** take ownership of count messages starting at source, those which do not fit are
+        deleted*/
+        void give(std::unique_ptr<Message>* source, std::size_t count) noexcept
+        {
+            {
+                const std::lock_guard<std::mutex> lock(poolLock);
+                while (count > 0 && available < maxSharedMessages) {
+                    messages[available++] = std::move(source[--count]);
+                }
+            }
+            for (std::size_t ii = 0; ii < count; ++ii) {
+                source[ii].reset();
+            }
+        }
+        std::size_t size() noexcept
+        {
+            const std::lock_guard<std::mutex> lock(poolLock);
+            return available;
+        }
+
+      private:
+        std::mutex poolLock;
+        std::array<std::unique_ptr<Message>, maxSharedMessages> messages;
+        std::size_t available{0};
+    };
+
+    SharedMessagePool& sharedPool()
+    {
+        // never destroyed so threads exiting during shutdown can still return their messages
+        static auto* pool = new SharedMessagePool();  // NOLINT
+        return *pool;
+    }
+
+    /** fixed size stack of released messages held by a thread*/
+    struct MessageCache {
+        std::array<std::unique_ptr<Message>, maxCachedMessages> messages;
+        std::size_t count{0};
+        // create the shared pool up front so the destructor never allocates
+        MessageCache() { sharedPool(); }
+        MessageCache(const MessageCache&) = delete;
+        MessageCache& operator=(const MessageCache&) = delete;
+        /** the messages cached by an exiting thread are left for the other threads*/
+        ~MessageCache() { sharedPool().give(messages.data(), count); }
+    };
+    // NOLINTNEXTLINE
+    thread_local MessageCache messageCache;
+}  // namespace
+
+static void resetString(std::string& str) noexcept
+{
+    if (str.capacity() > maxRetainedStringCapacity) {
+        std::string().swap(str);
+    } else {
+        str.clear();
+    }
+}
+
+std::unique_ptr<Message> acquireMessage()
+{
+    auto& cache = messageCache;
+    if (cache.count == 0) {
+        cache.count = sharedPool().take(cache.messages.data(), transferCount);
+    }
+    if (cache.count > 0) {
+        return std::move(cache.messages[--cache.count]);
+    }
+    return std::make_unique<Message>();
+}
+
+void releaseMessage(std::unique_ptr<Message> message) noexcept
+{
+    // locked buffers may reference memory the message does not own so are never reused
+    if (!message || message->data.isLocked()) {
+        return;
+    }
+    auto& cache = messageCache;
+    message->time = timeZero;
+    message->flags = 0;
+    message->messageValidation = 0U;
+    message->messageID = 0;
+    message->counter = 0;
+    message->backReference = nullptr;
+    message->data = SmallBuffer{};
+    resetString(message->dest);
+    resetString(message->source);
+    resetString(message->original_source);
+    resetString(message->original_dest);
+    if (cache.count == maxCachedMessages) {
+        // a thread which only consumes messages passes them on to the threads creating them
+        cache.count -= transferCount;
+        sharedPool().give(cache.messages.data() + cache.count, transferCount);
+    }
+    cache.messages[cache.count++] = std::move(message);
+}
+
+std::size_t cachedMessageCount() noexcept
+{
+    return messageCache.count;
+}
+
+std::size_t sharedMessageCount() noexcept
+{
+    return sharedPool().size();
+}
+
+}  // namespace helics
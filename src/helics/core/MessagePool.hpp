@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "core-data.hpp"
+
+#include <cstddef>
+#include <memory>
+
+/** @file
+@details recycling of Message objects on the message path.  Every message delivered to an
+endpoint or passed through a filter is converted from an ActionMessage into a Message and every
+Message sent from a federate is converted back.  The emptied objects are cached on the thread
+which released them and handed back out by acquireMessage so a steady stream of messages does not
+allocate a new Message for each hop.  Messages are usually created and released on different
+threads, so a thread with a full cache moves a batch of them to a pool shared by all threads and
+a thread with an empty cache takes a batch from it; the shared pool lock is taken at most once
+per batch.
+*/
+namespace helics {
+
+/// the maximum number of Message objects cached by each thread
+constexpr std::size_t maxCachedMessages{256};
+/// the maximum number of Message objects held in the pool shared between threads
+constexpr std::size_t maxSharedMessages{4096};
+
+/** get an empty Message, reusing a released Message if the calling thread has one available*/
+std::unique_ptr<Message> acquireMessage();
+
+/** return a Message which is no longer needed so it can be reused by acquireMessage
+@details the message is cleared before it is cached, string capacity is kept for short names but
+payload buffers are always released*/
+void releaseMessage(std::unique_ptr<Message> message) noexcept;
+
+/** get the number of Message objects currently cached by the calling thread*/
+std::size_t cachedMessageCount() noexcept;
+
+/** get the number of Message objects currently in the pool shared between threads*/
+std::size_t sharedMessageCount() noexcept;
+
+}  // namespace helics
@@ -12,24 +12,26 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <utility>
 
 namespace helics {
-MessageTimer::MessageTimer(std::function<void(ActionMessage&&)> sFunction):
-    sendFunction(std::move(sFunction)),
-    contextPtr(gmlc::networking::AsioContextManager::getContextPointer()),
-    loopHandle(contextPtr->startContextLoop())
+MessageTimer::MessageTimer(std::function<void(ActionMessage&&)> sFunction,
+                           std::chrono::nanoseconds tickResolution):
+    sendFunction(std::move(sFunction)), wheel(TimerWheel::getSharedWheel(tickResolution))
 {
 }
 
-static void processTimerCallback(const std::shared_ptr<MessageTimer>& mtimer,
-                                 int32_t index,
-                                 const std::error_code& ec)
+MessageTimer::~MessageTimer()
 {
-    if (ec != asio::error::operation_aborted) {
-        try {
-            mtimer->sendMessage(index);
-        }
-        catch (std::exception& e) {
-            std::cerr << "exception caught from sendMessage:" << e.what() << std::endl;
-        }
+    for (auto timer : timers) {
+        wheel->releaseTimer(timer);
+    }
+}
+
+void MessageTimer::timerExpired(std::int32_t index)
+{
+    try {
+        sendMessage(index);
+    }
+    catch (std::exception& e) {
+        std::cerr << "exception caught from sendMessage:" << e.what() << std::endl;
     }
 }
 
@@ -40,24 +42,17 @@ int32_t MessageTimer::addTimerFromNow(std::chrono::nanoseconds time, ActionMessa
 
 int32_t MessageTimer::addTimer(time_type expirationTime, ActionMessage mess)
 {
-    // these two calls need to be before the lock
-    auto timer = std::make_shared<asio::steady_timer>(contextPtr->getBaseContext());
-    timer->expires_at(expirationTime);
-
     std::unique_lock<std::mutex> lock(timerLock);
 
     auto index = static_cast<int32_t>(timers.size());
-    auto timerCallback = [ptr = shared_from_this(), index](const std::error_code& ec) {
-        processTimerCallback(ptr, index, ec);
-    };
     buffers.push_back(std::move(mess));
     expirationTimes.push_back(expirationTime);
-    timers.push_back(std::move(timer));
+    timers.push_back(wheel->createTimer(index));
     if (expirationTime > std::chrono::steady_clock::now()) {
-        timers.back()->async_wait(timerCallback);
+        wheel->schedule(timers.back(), expirationTime, shared_from_this());
     } else {
         lock.unlock();
-        timerCallback(std::error_code{});
+        timerExpired(index);
     }
 
     return index;
@@ -68,7 +63,7 @@ void MessageTimer::cancelTimer(int32_t index)
     std::lock_guard<std::mutex> lock(timerLock);
     if ((index >= 0) && (index < static_cast<int32_t>(timers.size()))) {
         buffers[index].setAction(CMD_IGNORE);
-        timers[index]->cancel();
+        wheel->cancel(timers[index]);
     }
 }
 
@@ -78,8 +73,8 @@ void MessageTimer::cancelAll()
     for (auto& buf : buffers) {
         buf.setAction(CMD_IGNORE);
     }
-    for (auto& tmr : timers) {
-        tmr->cancel();
+    for (auto timer : timers) {
+        wheel->cancel(timer);
     }
 }
 
@@ -87,15 +82,9 @@ void MessageTimer::updateTimer(int32_t timerIndex, time_type expirationTime, Act
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        timers[timerIndex]->expires_at(expirationTime);
         expirationTimes[timerIndex] = expirationTime;
         buffers[timerIndex] = std::move(mess);
-
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
-
-        timers[timerIndex]->async_wait(timerCallback);
+        wheel->schedule(timers[timerIndex], expirationTime, shared_from_this());
     }
 }
 
@@ -110,14 +99,10 @@ bool MessageTimer::addTimeToTimer(int32_t timerIndex, std::chrono::nanoseconds t
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        auto newTime = timers[timerIndex]->expires_at() + time;
-        timers[timerIndex]->expires_at(newTime);
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
+        auto newTime = expirationTimes[timerIndex] + time;
         expirationTimes[timerIndex] = newTime;
         auto ret = (buffers[timerIndex].action() != CMD_IGNORE);
-        timers[timerIndex]->async_wait(timerCallback);
+        wheel->schedule(timers[timerIndex], newTime, shared_from_this());
         return ret;
     }
     return false;
@@ -127,13 +112,9 @@ bool MessageTimer::updateTimer(int32_t timerIndex, time_type expirationTime)
 {
     std::lock_guard<std::mutex> lock(timerLock);
     if ((timerIndex >= 0) && (timerIndex < static_cast<int32_t>(timers.size()))) {
-        timers[timerIndex]->expires_at(expirationTime);
-        auto timerCallback = [ptr = shared_from_this(), timerIndex](const std::error_code& ec) {
-            processTimerCallback(ptr, timerIndex, ec);
-        };
         expirationTimes[timerIndex] = expirationTime;
         auto ret = (buffers[timerIndex].action() != CMD_IGNORE);
-        timers[timerIndex]->async_wait(timerCallback);
+        wheel->schedule(timers[timerIndex], expirationTime, shared_from_this());
         return ret;
     }
     return false;
@@ -7,20 +7,35 @@ SPDX-License-Identifier: BSD-3-Clause
 #pragma once
 
 #include "ActionMessage.hpp"
-#include "gmlc/networking/AsioContextManager.h"
+#include "TimerWheel.hpp"
 
-#include <asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 namespace helics {
 /** class containing a message timer for sending messages at particular points in time
+@details the timers are run by the timer wheel shared by all the message timers in the process with
+the same tick length so any number of timers only use a single asio timer
  */
-class MessageTimer: public std::enable_shared_from_this<MessageTimer> {
+class MessageTimer:
+    public std::enable_shared_from_this<MessageTimer>,
+    public TimerWheel::Client {
   public:
     using time_type = decltype(std::chrono::steady_clock::now());
-    explicit MessageTimer(std::function<void(ActionMessage&&)> sFunction);
+    /** construct a message timer
+    @param sFunction the function to send the messages with
+    @param tickResolution the length of a tick of the timer wheel, timers fire at most one tick
+    late*/
+    explicit MessageTimer(
+        std::function<void(ActionMessage&&)> sFunction,
+        std::chrono::nanoseconds tickResolution = TimerWheel::defaultTickResolution);
+    ~MessageTimer() override;
+    MessageTimer(const MessageTimer&) = delete;
+    MessageTimer& operator=(const MessageTimer&) = delete;
     /** add a timer and message to the queue
     @return an index for referencing the timer in the future*/
     int32_t addTimerFromNow(std::chrono::nanoseconds time, ActionMessage mess);
@@ -49,15 +64,16 @@ class MessageTimer: public std::enable_shared_from_this<MessageTimer> {
     void sendMessage(int32_t timerIndex);
 
   private:
+    virtual void timerExpired(std::int32_t index) override;
+
     std::mutex timerLock;  //!< lock protecting the timer buffers
     std::vector<ActionMessage> buffers;
     std::vector<time_type> expirationTimes;
     /** the callback to use when sending a message */
     const std::function<void(ActionMessage&&)> sendFunction;
-    std::vector<std::shared_ptr<asio::steady_timer>> timers;
-    /** context manager to use for handling real time operations */
-    std::shared_ptr<gmlc::networking::AsioContextManager> contextPtr;
-    /** loop controller for async real time operations */
-    decltype(contextPtr->startContextLoop()) loopHandle;
+    /** the wheel running the timers */
+    std::shared_ptr<TimerWheel> wheel;
+    /** the wheel timer for each index */
+    std::vector<std::int32_t> timers;
 };
 }  // namespace helics
@@ -7,13 +7,61 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include "ProfilerBuffer.hpp"
 
+#include "../common/JsonGeneration.hpp"
+#include "CoreTypes.hpp"
+#include "helicsTime.hpp"
+
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <string>
+#include <system_error>
 #include <utility>
 
 namespace helics {
 
+static_assert(sizeof(ProfilerRecord) == 32, "profiler records must be packed");
+
+/// the header of a binary profile file
+static constexpr char profileMagic[8]{'H', 'E', 'L', 'I', 'C', 'S', 'P', 'F'};
+static constexpr std::uint32_t profileVersion{1};
+static constexpr std::uint32_t profileByteOrder{0x01020304};
+static constexpr std::size_t profileHeaderSize{sizeof(profileMagic) + 2 * sizeof(std::uint32_t)};
+
+static double grantedTime(const ProfilerRecord& record)
+{
+    Time granted;
+    granted.setBaseTimeCode(record.grantedTime);
+    return static_cast<double>(granted);
+}
+
+std::string generateProfilingString(std::string_view federateName, const ProfilerRecord& record)
+{
+    const auto& state = fedStateString(static_cast<FederateStates>(record.state));
+    if (record.event == ProfilerEvent::MARKER) {
+        return fmt::format("<PROFILING>{}[{}]({})MARKER<{}|{}>[t={}]</PROFILING>",
+                           federateName,
+                           record.federateId,
+                           state,
+                           record.steadyTime,
+                           record.systemTime,
+                           grantedTime(record));
+    }
+    return fmt::format("<PROFILING>{}[{}]({})HELICS CODE {}<{}>[t={}]</PROFILING>",
+                       federateName,
+                       record.federateId,
+                       state,
+                       (record.event == ProfilerEvent::ENTRY) ? "ENTRY" : "EXIT",
+                       record.steadyTime,
+                       grantedTime(record));
+}
+
 void ProfilerBuffer::addMessage(const std::string& data)
 {
     mBuffers.emplace_back(data);
@@ -24,10 +72,29 @@ void ProfilerBuffer::addMessage(std::string&& data)
     mBuffers.push_back(std::move(data));
 }
 
+void ProfilerBuffer::addRecords(std::string_view federateName,
+                                const ProfilerRecord* records,
+                                std::size_t count)
+{
+    if (!mBinary) {
+        for (std::size_t ii = 0; ii < count; ++ii) {
+            mBuffers.push_back(generateProfilingString(federateName, records[ii]));
+        }
+        return;
+    }
+    // each batch is stored as the name, the record count, and the records
+    auto nameSize = static_cast<std::uint32_t>(federateName.size());
+    auto recordCount = static_cast<std::uint32_t>(count);
+    mBinaryData.append(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+    mBinaryData.append(federateName);
+    mBinaryData.append(reinterpret_cast<const char*>(&recordCount), sizeof(recordCount));
+    mBinaryData.append(reinterpret_cast<const char*>(records), count * sizeof(ProfilerRecord));
+}
+
 ProfilerBuffer::~ProfilerBuffer()
 {
     try {
-        if (!mBuffers.empty()) {
+        if (!mBuffers.empty() || !mBinaryData.empty()) {
             writeFile();
         }
     }
@@ -37,6 +104,25 @@ ProfilerBuffer::~ProfilerBuffer()
 
 void ProfilerBuffer::writeFile()
 {
+    if (mBinary) {
+        std::error_code ec;
+        const bool newFile = !std::filesystem::exists(mFileName, ec) ||
+            std::filesystem::file_size(mFileName, ec) == 0;
+        std::ofstream file(mFileName, std::ios::out | std::ios::app | std::ios::binary);
+        if (file.fail()) {
+            throw std::ios_base::failure(std::strerror(errno));
+        }
+        file.exceptions(file.exceptions() | std::ios::failbit | std::ifstream::badbit);
+        if (newFile) {
+            file.write(profileMagic, sizeof(profileMagic));
+            file.write(reinterpret_cast<const char*>(&profileVersion), sizeof(profileVersion));
+            file.write(reinterpret_cast<const char*>(&profileByteOrder), sizeof(profileByteOrder));
+        }
+        file.write(mBinaryData.data(), static_cast<std::streamsize>(mBinaryData.size()));
+        mBinaryData.clear();
+        mBuffers.clear();
+        return;
+    }
     std::ofstream file;
     // can't enable exception now because of gcc bug that raises ios_base::failure with useless
     // message file.exceptions(file.exceptions() | std::ios::failbit);
@@ -64,6 +150,7 @@ void ProfilerBuffer::setOutputFile(std::string fileName, bool append)
         return;
     }
     mFileName = std::move(fileName);
+    mBinary = (std::filesystem::path(mFileName).extension() == ".hprof");
     if (append) {
         return;
     }
@@ -77,4 +164,135 @@ void ProfilerBuffer::setOutputFile(std::string fileName, bool append)
     }
 }
 
+std::vector<ProfilerFederateData> loadBinaryProfile(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw std::ios_base::failure(std::strerror(errno));
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::uint32_t version{0};
+    std::uint32_t byteOrder{0};
+    if (data.size() < profileHeaderSize ||
+        std::memcmp(data.data(), profileMagic, sizeof(profileMagic)) != 0) {
+        throw std::ios_base::failure(fileName + " is not a HELICS profile file");
+    }
+    std::memcpy(&version, data.data() + sizeof(profileMagic), sizeof(version));
+    std::memcpy(&byteOrder, data.data() + sizeof(profileMagic) + sizeof(version), sizeof(byteOrder));
+    if (version != profileVersion || byteOrder != profileByteOrder) {
+        throw std::ios_base::failure(fileName + " has an unsupported profile format");
+    }
+
+    std::vector<ProfilerFederateData> federates;
+    std::map<std::pair<std::string, std::int32_t>, std::size_t> federateIndex;
+    std::size_t position{profileHeaderSize};
+    // a truncated batch at the end of the file is ignored
+    while (position + sizeof(std::uint32_t) <= data.size()) {
+        std::uint32_t nameSize{0};
+        std::memcpy(&nameSize, data.data() + position, sizeof(nameSize));
+        position += sizeof(nameSize);
+        if (position + nameSize + sizeof(std::uint32_t) > data.size()) {
+            break;
+        }
+        std::string name = data.substr(position, nameSize);
+        position += nameSize;
+        std::uint32_t count{0};
+        std::memcpy(&count, data.data() + position, sizeof(count));
+        position += sizeof(count);
+        const auto available = (data.size() - position) / sizeof(ProfilerRecord);
+        const std::size_t used = std::min<std::size_t>(count, available);
+        for (std::size_t ii = 0; ii < used; ++ii) {
+            ProfilerRecord record;
+            std::memcpy(&record, data.data() + position, sizeof(ProfilerRecord));
+            position += sizeof(ProfilerRecord);
+            auto key = std::make_pair(name, record.federateId);
+            auto fnd = federateIndex.find(key);
+            if (fnd == federateIndex.end()) {
+                fnd = federateIndex.emplace(std::move(key), federates.size()).first;
+                federates.emplace_back();
+                federates.back().name = name;
+                federates.back().federateId = record.federateId;
+            }
+            federates[fnd->second].records.push_back(record);
+        }
+        if (used < count) {
+            break;
+        }
+    }
+    // markers are sent separately from the batched records so restore the time order
+    for (auto& federate : federates) {
+        std::stable_sort(federate.records.begin(),
+                         federate.records.end(),
+                         [](const ProfilerRecord& rec1, const ProfilerRecord& rec2) {
+                             return rec1.steadyTime < rec2.steadyTime;
+                         });
+    }
+    return federates;
+}
+
+std::size_t convertProfileToTrace(const std::string& profileFile, const std::string& traceFile)
+{
+    auto federates = loadBinaryProfile(profileFile);
+
+    std::ofstream out(traceFile, std::ios::out | std::ios::trunc);
+    if (!out) {
+        throw std::ios_base::failure(std::strerror(errno));
+    }
+    std::int64_t startTime{std::numeric_limits<std::int64_t>::max()};
+    for (const auto& federate : federates) {
+        if (!federate.records.empty()) {
+            startTime = std::min(startTime, federate.records.front().steadyTime);
+        }
+    }
+
+    std::size_t eventCount{0};
+    bool first{true};
+    auto writeEvent = [&out, &first, &eventCount](const std::string& event) {
+        out << (first ? "\n" : ",\n") << event;
+        first = false;
+        ++eventCount;
+    };
+    out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+    for (const auto& federate : federates) {
+        const auto tid = federate.federateId;
+        writeEvent(fmt::format(
+            R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":{}}}}})",
+            tid,
+            fileops::generateJsonQuotedString(federate.name)));
+        for (const auto& record : federate.records) {
+            // trace timestamps are in microseconds
+            const double timestamp = static_cast<double>(record.steadyTime - startTime) / 1000.0;
+            const auto& state = fedStateString(static_cast<FederateStates>(record.state));
+            switch (record.event) {
+                case ProfilerEvent::ENTRY:
+                case ProfilerEvent::EXIT:
+                    writeEvent(fmt::format(
+                        R"({{"name":"HELICS","cat":"helics","ph":"{}","ts":{:.3f},"pid":1,"tid":{},"args":{{"state":"{}","granted_time":{}}}}})",
+                        (record.event == ProfilerEvent::ENTRY) ? 'B' : 'E',
+                        timestamp,
+                        tid,
+                        state,
+                        grantedTime(record)));
+                    break;
+                case ProfilerEvent::MARKER:
+                    writeEvent(fmt::format(
+                        R"({{"name":"marker","cat":"helics","ph":"i","s":"t","ts":{:.3f},"pid":1,"tid":{},"args":{{"state":"{}","granted_time":{},"system_time_ns":{}}}}})",
+                        timestamp,
+                        tid,
+                        state,
+                        grantedTime(record),
+                        record.systemTime));
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    out << "\n]}\n";
+    if (!out) {
+        throw std::ios_base::failure(std::strerror(errno));
+    }
+    return eventCount;
+}
+
 }  // namespace helics
@@ -6,27 +6,87 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace helics {
+
+/** the type of event captured in a profiling record*/
+enum class ProfilerEvent : std::uint8_t {
+    ENTRY = 0,  //!< entering HELICS code
+    EXIT = 1,  //!< exiting HELICS code
+    MARKER = 2  //!< timing marker relating the steady clock to the system clock
+};
+
+/** a fixed size binary profiling record
+@details records are generated by the federates and sent in batches as the payload of a
+CMD_PROFILER_DATA message with the indicator_flag set and the federate name as the string data
+*/
+struct ProfilerRecord {
+    std::int64_t steadyTime{0};  //!< steady clock time in ns
+    std::int64_t systemTime{0};  //!< system clock time in ns (markers only)
+    std::int64_t grantedTime{0};  //!< base time code of the granted time of the federate
+    std::int32_t federateId{0};  //!< the global id of the federate
+    std::uint8_t state{0};  //!< the FederateStates value of the federate
+    ProfilerEvent event{ProfilerEvent::ENTRY};
+    std::uint16_t reserved{0};
+};
+
+/** the records of a single federate loaded from a binary profile file*/
+struct ProfilerFederateData {
+    std::string name;
+    std::int32_t federateId{0};
+    std::vector<ProfilerRecord> records;
+};
+
+/** generate the text form of a profiling record
+@details the text form is the same as the legacy <PROFILING> messages*/
+std::string generateProfilingString(std::string_view federateName, const ProfilerRecord& record);
+
+/** load the records from a binary profile file
+@throw std::ios_base::failure if the file cannot be read or is not a profile file
+*/
+std::vector<ProfilerFederateData> loadBinaryProfile(const std::string& fileName);
+
+/** convert a binary profile file to the Chrome trace event JSON format which can be loaded into
+the Chrome trace viewer or Perfetto
+@details each federate is shown as a thread with a slice for each section of HELICS code and
+markers are shown as instant events
+@return the number of trace events written
+@throw std::ios_base::failure if either file cannot be opened
+*/
+std::size_t convertProfileToTrace(const std::string& profileFile, const std::string& traceFile);
+
 class ProfilerBuffer {
   public:
     ~ProfilerBuffer();
     void addMessage(const std::string& data);
     void addMessage(std::string&& data);
+    /** add a batch of binary records from a federate
+    @details in a text file the records are converted to text messages*/
+    void addRecords(std::string_view federateName, const ProfilerRecord* records, std::size_t count);
     void writeFile();
     /** specify the output file for writing the profiler information to
     @details the file will be cleared when the output file is set unless the append parameter is
-    specified as true
+    specified as true.  Files with a .hprof extension are written in the binary profile format.
     @param fileName the name of the file to write the profile to
     @param append if set to true the output file will be appended instead of cleared on first use
     */
     void setOutputFile(std::string fileName, bool append = false);
+    /** check if the output file uses the binary profile format, text messages are not written
+    to binary files*/
+    bool isBinary() const { return mBinary; }
+    /** get the number of bytes of binary data waiting to be written*/
+    std::size_t bufferedSize() const { return mBinaryData.size(); }
 
   private:
     std::vector<std::string> mBuffers;
+    std::string mBinaryData;  //!< binary record batches waiting to be written
     std::string mFileName;
+    bool mBinary{false};
 };
 }  // namespace helics
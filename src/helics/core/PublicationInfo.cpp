@@ -8,9 +8,11 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "PublicationInfo.hpp"
 
 #include "../common/JsonGeneration.hpp"
+#include "VectorDelta.hpp"
 #include "helics_definitions.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 #include <string_view>
 
@@ -25,7 +27,12 @@ bool PublicationInfo::CheckSetValue(const char* dataToCheck,
             return false;
         }
     }
-    if (only_update_on_change || forceChangeCheck) {
+    if (deltaKeyframeInterval > 0) {
+        if (!checkDeltaValue(std::string_view(dataToCheck, len),
+                             only_update_on_change || forceChangeCheck)) {
+            return false;
+        }
+    } else if (only_update_on_change || forceChangeCheck) {
         if (std::string_view(dataToCheck, len) != data.to_string()) {
             data.assign(dataToCheck, len);
         } else {
@@ -38,6 +45,37 @@ bool PublicationInfo::CheckSetValue(const char* dataToCheck,
     return true;
 }
 
+bool PublicationInfo::checkDeltaValue(std::string_view value, bool changeCheck)
+{
+    encodedData.clear();
+    if (!forceKeyframe && deltaSequence < static_cast<uint32_t>(deltaKeyframeInterval) &&
+        !data.empty()) {
+        switch (encodeVectorDelta(data, value, deltaTolerance, deltaSequence + 1, encodedData)) {
+            case DeltaEncoding::UNCHANGED:
+                if (changeCheck) {
+                    encodedData.clear();
+                    return false;
+                }
+                ++deltaSequence;
+                return true;
+            case DeltaEncoding::DELTA:
+                ++deltaSequence;
+                return true;
+            case DeltaEncoding::FULL_VALUE:
+            default:
+                // the reference may have been partially updated so it is always reset below
+                encodedData.clear();
+                break;
+        }
+    } else if (changeCheck && value == data.to_string()) {
+        return false;
+    }
+    data.assign(value.data(), value.size());
+    deltaSequence = 0;
+    forceKeyframe = false;
+    return true;
+}
+
 bool PublicationInfo::addSubscriber(GlobalHandle newSubscriber, std::string_view subscriberName)
 {
     for (auto& sub : subscribers) {
@@ -46,6 +84,8 @@ bool PublicationInfo::addSubscriber(GlobalHandle newSubscriber, std::string_view
         }
     }
     subscribers.emplace_back(newSubscriber, subscriberName);
+    // a new subscriber has no reference value for the deltas
+    forceKeyframe = true;
     return true;
 }
 
@@ -97,6 +137,13 @@ void PublicationInfo::setProperty(int32_t option, int32_t value)
         case defs::Options::TIME_RESTRICTED:
             minTimeGap = Time(value, time_units::ms);
             break;
+        case defs::Options::DELTA_ENCODING:
+            deltaKeyframeInterval = (value == 1) ? defaultDeltaKeyframeInterval : std::max(value, 0);
+            forceKeyframe = true;
+            break;
+        case defs::Options::DELTA_TOLERANCE:
+            deltaTolerance = static_cast<double>(value) * 1e-6;
+            break;
         default:
             break;
     }
@@ -128,6 +175,10 @@ int32_t PublicationInfo::getProperty(int32_t option) const
             return static_cast<int32_t>(subscribers.size());
         case defs::Options::TIME_RESTRICTED:
             return static_cast<std::int32_t>(minTimeGap.to_ms().count());
+        case defs::Options::DELTA_ENCODING:
+            return deltaKeyframeInterval;
+        case defs::Options::DELTA_TOLERANCE:
+            return static_cast<std::int32_t>(std::lround(deltaTolerance * 1e6));
         default:
             break;
     }
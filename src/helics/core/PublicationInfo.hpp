@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-3-Clause
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -47,7 +48,15 @@ class PublicationInfo {
     bool buffer_data{false};  //!< indicator that the publication should buffer data
     int32_t requiredConnections{0};  //!< the number of required connections 0 is no requirement
     Time minTimeGap{timeZero};  //!< a time restriction on amount of publishing
-    /** check if the value should be published or not*/
+    /// the number of delta encoded updates between full values, 0 if delta encoding is disabled
+    int32_t deltaKeyframeInterval{0};
+    double deltaTolerance{0.0};  //!< element changes at or below this are not transmitted
+    uint32_t deltaSequence{0};  //!< the number of delta updates since the last full value
+    bool forceKeyframe{false};  //!< indicator that the next update must be a full value
+    /// the delta encoded form of the most recent publication, empty if it is sent in full
+    SmallBuffer encodedData;
+    /** check if the value should be published or not
+    @details if delta encoding is enabled this also generates encodedData*/
     bool CheckSetValue(const char* dataToCheck,
                        uint64_t len,
                        Time currentTime,
@@ -66,6 +75,8 @@ class PublicationInfo {
     const std::string& getTargets() const;
 
   private:
+    /** check a value for publication with delta encoding enabled*/
+    bool checkDeltaValue(std::string_view value, bool changeCheck);
     mutable std::string destTargets;
 };
 }  // namespace helics
@@ -0,0 +1,141 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "RouteTable.hpp"
+
+namespace helics {
+
+/// the largest id offset stored in the dense vectors, ids beyond it go in the sparse map
+static constexpr IdentifierBaseType maxDenseIndex{1 << 20};
+
+static IdentifierBaseType denseIndex(GlobalFederateId id, bool& broker)
+{
+    const auto gid = id.baseValue();
+    broker = gid >= gGlobalBrokerIdShift;
+    if (broker) {
+        return gid - gGlobalBrokerIdShift;
+    }
+    if (gid >= gGlobalFederateIdShift) {
+        return gid - gGlobalFederateIdShift;
+    }
+    return -1;
+}
+
+route_id* RouteTable::denseSlot(GlobalFederateId id, bool create)
+{
+    bool broker{false};
+    const auto index = denseIndex(id, broker);
+    if (index < 0 || index >= maxDenseIndex) {
+        return nullptr;
+    }
+    auto& routes = broker ? mBrokerRoutes : mFederateRoutes;
+    const auto slot = static_cast<std::size_t>(index);
+    if (slot >= routes.size()) {
+        if (!create) {
+            return nullptr;
+        }
+        routes.resize(slot + 1);
+    }
+    return &routes[slot];
+}
+
+const route_id* RouteTable::denseSlot(GlobalFederateId id) const
+{
+    bool broker{false};
+    const auto index = denseIndex(id, broker);
+    if (index < 0) {
+        return nullptr;
+    }
+    const auto& routes = broker ? mBrokerRoutes : mFederateRoutes;
+    const auto slot = static_cast<std::size_t>(index);
+    return (slot < routes.size()) ? &routes[slot] : nullptr;
+}
+
+bool RouteTable::emplace(GlobalFederateId id, route_id route)
+{
+    if (!id.isValid() || !route.isValid()) {
+        return false;
+    }
+    auto* slot = denseSlot(id, true);
+    if (slot != nullptr) {
+        if (slot->isValid()) {
+            return false;
+        }
+        *slot = route;
+        ++mCount;
+        return true;
+    }
+    // the dense range check in denseSlot keeps the sparse entries out of the vectors
+    if (mSparseRoutes.emplace(id, route).second) {
+        ++mCount;
+        return true;
+    }
+    return false;
+}
+
+void RouteTable::set(GlobalFederateId id, route_id route)
+{
+    if (!emplace(id, route)) {
+        if (!id.isValid() || !route.isValid()) {
+            return;
+        }
+        auto* slot = denseSlot(id, false);
+        if (slot != nullptr) {
+            *slot = route;
+        } else {
+            mSparseRoutes[id] = route;
+        }
+    }
+}
+
+route_id RouteTable::find(GlobalFederateId id, route_id defaultRoute) const
+{
+    const auto* slot = denseSlot(id);
+    if (slot != nullptr) {
+        return slot->isValid() ? *slot : defaultRoute;
+    }
+    if (mSparseRoutes.empty()) {
+        return defaultRoute;
+    }
+    auto fnd = mSparseRoutes.find(id);
+    return (fnd != mSparseRoutes.end()) ? fnd->second : defaultRoute;
+}
+
+void RouteTable::clear()
+{
+    mFederateRoutes.clear();
+    mBrokerRoutes.clear();
+    mSparseRoutes.clear();
+    mCount = 0;
+}
+
+bool DestinationCache::find(GlobalHandle source,
+                            std::string_view name,
+                            std::uint32_t generation,
+                            BasicHandleInfo*& destination) const
+{
+    auto fnd = mEntries.find(static_cast<std::uint64_t>(source));
+    if (fnd == mEntries.end() || fnd->second.generation != generation ||
+        fnd->second.name != name) {
+        return false;
+    }
+    destination = fnd->second.destination;
+    return true;
+}
+
+void DestinationCache::store(GlobalHandle source,
+                             std::string_view name,
+                             std::uint32_t generation,
+                             BasicHandleInfo* destination)
+{
+    auto& entry = mEntries[static_cast<std::uint64_t>(source)];
+    entry.name.assign(name);
+    entry.destination = destination;
+    entry.generation = generation;
+}
+
+}  // namespace helics
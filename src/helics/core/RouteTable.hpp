@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "GlobalFederateId.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace helics {
+class BasicHandleInfo;
+
+/** the routes to federates and brokers held by a core or broker
+@details federate and broker ids are assigned sequentially by the root broker so the routes for
+them are stored in vectors indexed directly by the id offset.  Ids outside the dense ranges, such
+as the special ids used for filter and translator federates, are kept in a hash map.  Invalid ids
+and routes are ignored.
+*/
+class RouteTable {
+  public:
+    /** add a route for an id if it does not already have one
+    @return true if the route was added*/
+    bool emplace(GlobalFederateId id, route_id route);
+    /** set the route for an id replacing any existing route*/
+    void set(GlobalFederateId id, route_id route);
+    /** get the route for an id
+    @return the route or defaultRoute if the id has no route*/
+    route_id find(GlobalFederateId id, route_id defaultRoute = parent_route_id) const;
+    /** check if an id has a route*/
+    bool contains(GlobalFederateId id) const { return find(id, route_id{}).isValid(); }
+    /** get the number of ids with a route*/
+    std::size_t size() const { return mCount; }
+    /** remove all the routes*/
+    void clear();
+
+  private:
+    /** get the storage location for a route, nullptr if it is not in a dense range
+    @param create allow the dense storage to grow to include the id*/
+    route_id* denseSlot(GlobalFederateId id, bool create);
+    const route_id* denseSlot(GlobalFederateId id) const;
+
+    std::vector<route_id> mFederateRoutes;  //!< routes indexed by federate id offset
+    std::vector<route_id> mBrokerRoutes;  //!< routes indexed by broker id offset
+    std::unordered_map<GlobalFederateId, route_id> mSparseRoutes;  //!< all other routes
+    std::size_t mCount{0};  //!< the number of ids with a route
+};
+
+/** cache of the named endpoint each message source last sent to
+@details messages addressed by endpoint name have to be resolved through a string keyed map.  A
+source endpoint usually sends to the same destination repeatedly so the result is kept for each
+source and reused if the name matches, which only requires comparing the strings.  Entries are
+tagged with the name generation of the HandleManager they came from and are ignored once it
+changes.
+*/
+class DestinationCache {
+  public:
+    /** look up the cached destination for a source
+    @param source the source endpoint of the message
+    @param name the destination endpoint name
+    @param generation the current name generation of the handle manager
+    @param[out] destination the cached destination, nullptr if the name was not found
+    @return true if a valid entry was found*/
+    bool find(GlobalHandle source,
+              std::string_view name,
+              std::uint32_t generation,
+              BasicHandleInfo*& destination) const;
+    /** store the result of a name lookup for a source*/
+    void store(GlobalHandle source,
+               std::string_view name,
+               std::uint32_t generation,
+               BasicHandleInfo* destination);
+    /** remove all the entries*/
+    void clear() { mEntries.clear(); }
+
+  private:
+    struct Entry {
+        std::string name;
+        BasicHandleInfo* destination{nullptr};
+        std::uint32_t generation{0};
+    };
+    std::unordered_map<std::uint64_t, Entry> mEntries;
+};
+
+}  // namespace helics
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace helics {
+
+/** unbounded lock free single-producer single-consumer queue
+@details items are stored in linked blocks of a fixed size so a block is only allocated once every
+BlockSize pushes.  Only one thread may push and only one thread may pop at a time, different
+threads may take either role over time as long as the hand off is synchronized externally.
+T must be default constructible and move assignable.
+*/
+template<class T, std::size_t BlockSize = 64>
+class SpscQueue {
+  public:
+    SpscQueue(): mWriteBlock(new Block), mReadBlock(mWriteBlock) {}
+    ~SpscQueue()
+    {
+        Block* block = mReadBlock;
+        while (block != nullptr) {
+            Block* next = block->next.load(std::memory_order_relaxed);
+            delete block;
+            block = next;
+        }
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /** add an item to the queue, must only be called from the producer*/
+    void push(T&& item)
+    {
+        auto index = mWriteBlock->written.load(std::memory_order_relaxed);
+        if (index == BlockSize) {
+            auto* block = new Block;
+            mWriteBlock->next.store(block, std::memory_order_release);
+            // the consumer may free the previous block as soon as next is visible
+            mWriteBlock = block;
+            index = 0;
+        }
+        mWriteBlock->items[index] = std::move(item);
+        mWriteBlock->written.store(index + 1, std::memory_order_release);
+    }
+    /** remove an item from the queue, must only be called from the consumer
+    @return false if the queue was empty*/
+    bool try_pop(T& item)
+    {
+        if (mReadIndex == BlockSize) {
+            Block* next = mReadBlock->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+            delete mReadBlock;
+            mReadBlock = next;
+            mReadIndex = 0;
+        }
+        if (mReadIndex == mReadBlock->written.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(mReadBlock->items[mReadIndex]);
+        ++mReadIndex;
+        return true;
+    }
+    /** check if the queue is empty, only exact when called from the consumer*/
+    bool empty() const
+    {
+        if (mReadIndex == BlockSize) {
+            return mReadBlock->next.load(std::memory_order_acquire) == nullptr;
+        }
+        return mReadIndex == mReadBlock->written.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Block {
+        std::array<T, BlockSize> items;
+        std::atomic<std::size_t> written{0};  //!< the number of items published by the producer
+        std::atomic<Block*> next{nullptr};
+    };
+    Block* mWriteBlock;  //!< the block the producer is filling
+    Block* mReadBlock;  //!< the block the consumer is reading
+    std::size_t mReadIndex{0};  //!< the next item the consumer will read in mReadBlock
+};
+
+}  // namespace helics
@@ -84,7 +84,7 @@ void TimeCoordinator::localError()
 
         } else {
             ActionMessage multi(CMD_MULTI_MESSAGE);
-            for (const auto& dep : dependencies) {
+            for (const auto& dep : std::as_const(dependencies)) {
                 if ((dep.dependency && dep.next < Time::maxVal()) || dep.dependent) {
                     bye.dest_id = dep.fedID;
                     if (dep.fedID == mSourceId) {
@@ -306,7 +306,7 @@ void TimeCoordinator::enterInitialization()
     if (dynamicJoining) {
         ActionMessage timeUpdateRequest(CMD_REQUEST_CURRENT_TIME);
         timeUpdateRequest.source_id = mSourceId;
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             // send to all dependencies
             if (dep.dependency) {
                 if (dep.fedID == mSourceId) {
@@ -329,7 +329,7 @@ void TimeCoordinator::requestTimeCheck()
     if (dynamicJoining) {
         ActionMessage timeUpdateRequest(CMD_REQUEST_CURRENT_TIME);
         timeUpdateRequest.source_id = mSourceId;
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             // send to all dependencies
             if (dep.dependency) {
                 if (dep.fedID == mSourceId) {
@@ -639,7 +639,7 @@ MessageProcessingResult TimeCoordinator::checkTimeGrant(GlobalFederateId trigger
                     bool restrictionAdvance{restricted};
                     int restrictionLevel{50};
                     if (allowed) {
-                        for (const auto& dep : dependencies) {
+                        for (const auto& dep : std::as_const(dependencies)) {
                             if (!dep.dependency) {
                                 continue;
                             }
@@ -840,7 +840,7 @@ void TimeCoordinator::sendTimeRequest(GlobalFederateId triggerFed) const
         }
     } else if (triggerFed.isValid()) {
         upd.dest_id = triggerFed;
-        const auto* dep = dependencies.getDependencyInfo(triggerFed);
+        const auto* dep = std::as_const(dependencies).getDependencyInfo(triggerFed);
         if (dep->dependent) {
             upd.setExtraDestData(dep->sequenceCounter);
             sendMessageFunction(upd);
@@ -939,7 +939,7 @@ std::vector<GlobalFederateId> TimeCoordinator::getDependencies() const
 bool TimeCoordinator::transmitTimingMessages(ActionMessage& msg, GlobalFederateId skipFed) const
 {
     bool skipped{false};
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (dep.dependent) {
             if (dep.fedID == skipFed) {
                 skipped = true;
@@ -980,7 +980,7 @@ void TimeCoordinator::sendUpdatedExecRequest(GlobalFederateId target,
         execreq.setExtraDestData(responseSequenceCounter);
         sendMessageFunction(execreq);
     } else {
-        for (const auto& dep : dependencies) {
+        for (const auto& dep : std::as_const(dependencies)) {
             if (dep.dependent && dep.mTimeState < TimeState::time_granted) {
                 execreq.dest_id = dep.fedID;
                 execreq.setExtraDestData(dep.sequenceCounter);
@@ -1008,7 +1008,8 @@ MessageProcessingResult TimeCoordinator::checkExecEntry(GlobalFederateId trigger
                                                GlobalFederateId{},
                                                mfed.sequenceCounter);
                     } else {
-                        const auto* tfed = dependencies.getDependencyInfo(triggerFed);
+                        const auto* tfed =
+                            std::as_const(dependencies).getDependencyInfo(triggerFed);
                         if (tfed->dependent) {
                             sendUpdatedExecRequest(triggerFed,
                                                    GlobalFederateId{},
@@ -1066,7 +1067,7 @@ MessageProcessingResult TimeCoordinator::checkExecEntry(GlobalFederateId trigger
                     bool restrictionAdvance{restricted};
                     int restrictionLevel{50};
                     if (allowed) {
-                        for (const auto& dep : dependencies) {
+                        for (const auto& dep : std::as_const(dependencies)) {
                             if (!dep.dependency) {
                                 continue;
                             }
@@ -1184,7 +1185,7 @@ MessageProcessingResult TimeCoordinator::checkExecEntry(GlobalFederateId trigger
                 if (triggerFed == mfed.fedID && mfed.dependent) {
                     sendUpdatedExecRequest(triggerFed, mfed.fedID, mfed.sequenceCounter);
                 } else {
-                    const auto* tfed = dependencies.getDependencyInfo(triggerFed);
+                    const auto* tfed = std::as_const(dependencies).getDependencyInfo(triggerFed);
                     if (tfed->dependent) {
                         sendUpdatedExecRequest(triggerFed, mfed.fedID, tfed->sequenceCounter);
                     }
@@ -1204,7 +1205,7 @@ std::pair<GlobalFederateId, Time> TimeCoordinator::getMinGrantedDependency() con
 {
     Time minTime = Time::maxVal();
     GlobalFederateId minID;
-    for (const auto& dep : dependencies) {
+    for (const auto& dep : std::as_const(dependencies)) {
         if (!dep.dependency) {
             continue;
         }
@@ -1275,7 +1276,7 @@ TimeProcessingResult TimeCoordinator::processTimeMessage(const ActionMessage& cm
             break;
     }
     if (isDelayableMessage(cmd, mSourceId)) {
-        auto* dep = dependencies.getDependencyInfo(cmd.source_id);
+        const auto* dep = std::as_const(dependencies).getDependencyInfo(cmd.source_id);
         if (dep == nullptr) {
             return TimeProcessingResult::NOT_PROCESSED;
         }
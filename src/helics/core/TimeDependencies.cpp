@@ -158,6 +158,7 @@ static TimeProcessingResult processMessage(const ActionMessage& cmd, DependencyI
             break;
         case CMD_SEND_MESSAGE:
         case CMD_PUB:
+        case CMD_MULTICAST_PUB:
             dep.hasData = true;
             break;
         case CMD_REQUEST_CURRENT_TIME:
@@ -340,6 +341,8 @@ const DependencyInfo* TimeDependencies::getDependencyInfo(GlobalFederateId gid)
 
 DependencyInfo* TimeDependencies::getDependencyInfo(GlobalFederateId gid)
 {
+    // the caller may modify the dependency
+    mIndexValid = false;
     auto res = std::lower_bound(dependencies.begin(), dependencies.end(), gid, dependencyCompare);
     if ((res == dependencies.end()) || (res->fedID != gid)) {
         return nullptr;
@@ -351,6 +354,7 @@ DependencyInfo* TimeDependencies::getDependencyInfo(GlobalFederateId gid)
 bool TimeDependencies::addDependency(GlobalFederateId gid)
 
 {
+    mIndexValid = false;
     if (dependencies.empty()) {
         dependencies.emplace_back(gid);
         dependencies.back().dependency = true;
@@ -381,6 +385,7 @@ bool TimeDependencies::addDependency(GlobalFederateId gid)
 
 void TimeDependencies::removeDependency(GlobalFederateId gid)
 {
+    mIndexValid = false;
     auto dep = std::lower_bound(dependencies.begin(), dependencies.end(), gid, dependencyCompare);
     if (dep != dependencies.end()) {
         if (dep->fedID == gid) {
@@ -395,6 +400,7 @@ void TimeDependencies::removeDependency(GlobalFederateId gid)
 bool TimeDependencies::addDependent(GlobalFederateId gid)
 
 {
+    mIndexValid = false;
     if (dependencies.empty()) {
         dependencies.emplace_back(gid);
         dependencies.back().dependent = true;
@@ -419,6 +425,7 @@ bool TimeDependencies::addDependent(GlobalFederateId gid)
 
 void TimeDependencies::removeDependent(GlobalFederateId gid)
 {
+    mIndexValid = false;
     auto dep = std::lower_bound(dependencies.begin(), dependencies.end(), gid, dependencyCompare);
     if (dep != dependencies.end()) {
         if (dep->fedID == gid) {
@@ -432,6 +439,7 @@ void TimeDependencies::removeDependent(GlobalFederateId gid)
 
 void TimeDependencies::resetDependency(GlobalFederateId gid)
 {
+    mIndexValid = false;
     auto dep = std::lower_bound(dependencies.begin(), dependencies.end(), gid, dependencyCompare);
     if (dep != dependencies.end()) {
         if (dep->fedID == gid) {
@@ -444,6 +452,7 @@ void TimeDependencies::resetDependency(GlobalFederateId gid)
 
 void TimeDependencies::removeInterdependence(GlobalFederateId gid)
 {
+    mIndexValid = false;
     auto dep = std::lower_bound(dependencies.begin(), dependencies.end(), gid, dependencyCompare);
     if (dep != dependencies.end()) {
         if (dep->fedID == gid) {
@@ -452,13 +461,214 @@ void TimeDependencies::removeInterdependence(GlobalFederateId gid)
     }
 }
 
+static bool isGrantRestricting(const DependencyInfo& dep)
+{
+    return dep.dependency && dep.connection != ConnectionType::SELF && dep.next < cBigTime;
+}
+
 TimeProcessingResult TimeDependencies::updateTime(const ActionMessage& cmd)
 {
-    auto* depInfo = getDependencyInfo(cmd.source_id);
-    if (depInfo == nullptr || !depInfo->dependency) {
+    auto res = std::lower_bound(dependencies.begin(),
+                                dependencies.end(),
+                                cmd.source_id,
+                                dependencyCompare);
+    if (res == dependencies.end() || res->fedID != cmd.source_id || !res->dependency) {
         return TimeProcessingResult::NOT_PROCESSED;
     }
-    return processMessage(cmd, *depInfo);
+    auto& dep = *res;
+    auto result = processMessage(cmd, dep);
+    if (mIndexValid) {
+        updateIndex(static_cast<std::size_t>(res - dependencies.begin()));
+    }
+    return result;
+}
+
+/** generate the summary of a single dependency as scanned by generateMinTimeImplementation*/
+static DependencyTimeSummary generateTimeSummary(const DependencyInfo& dep,
+                                                 std::int32_t sequenceCode)
+{
+    DependencyTimeSummary summary;
+    summary.count = 1;
+    summary.pending = (dep.mTimeState < TimeState::time_granted) ? 1 : 0;
+    summary.sequenceSum = dep.sequenceCounter;
+    const bool responding = (dep.responseSequenceCounter == sequenceCode && dep.dependent);
+    if (dep.connection != ConnectionType::SELF &&
+        (sequenceCode == 0 || dep.responseSequenceCounter == sequenceCode ||
+         dep.timingVersion == 0 || !dep.dependent)) {
+        if (dep.minDe >= dep.next) {
+            summary.minDe = dep.minDe;
+        } else {
+            summary.minDeReset = true;
+        }
+    } else if (responding) {
+        if (dep.minDe >= dep.next) {
+            summary.minDe = dep.minDe;
+        }
+    } else {
+        summary.minDe = dep.next;
+    }
+
+    summary.next = dep.next;
+    summary.firstState = dep.mTimeState;
+    summary.firstInterrupted = responding && dep.interrupted;
+    summary.firstKeepsInterrupted = (dep.mTimeState != TimeState::time_granted && dep.interrupted);
+
+    summary.Te = dep.Te;
+    summary.minFed = dep.fedID;
+    summary.sequenceCounter = dep.sequenceCounter;
+    if (dep.minFed.isValid()) {
+        summary.actualTe = dep.Te;
+        summary.minFedActual = dep.minFed;
+    }
+    return summary;
+}
+
+/** combine the summaries of two adjacent ranges of dependencies in dependency order*/
+static DependencyTimeSummary combineTimeSummary(const DependencyTimeSummary& first,
+                                                const DependencyTimeSummary& second)
+{
+    if (second.count == 0) {
+        return first;
+    }
+    if (first.count == 0) {
+        return second;
+    }
+    DependencyTimeSummary summary = (second.next < first.next) ? second : first;
+    summary.count = first.count + second.count;
+    summary.pending = first.pending + second.pending;
+    summary.sequenceSum = first.sequenceSum + second.sequenceSum;
+
+    // a reset discards the dependent event times before it
+    summary.minDeReset = first.minDeReset || second.minDeReset;
+    summary.minDe = second.minDeReset ? second.minDe : (std::min)(first.minDe, second.minDe);
+
+    if (second.next == first.next) {
+        summary.tieGranted = first.tieGranted || second.tieGranted ||
+            second.firstState == TimeState::time_granted;
+        summary.tieInterrupted =
+            first.tieInterrupted && second.tieInterrupted && second.firstKeepsInterrupted;
+    }
+
+    const auto& minTe = (second.Te < first.Te) ? second : first;
+    summary.Te = minTe.Te;
+    summary.minFed = minTe.minFed;
+    summary.sequenceCounter = minTe.sequenceCounter;
+    if (second.Te < first.Te) {
+        summary.TePrior = (std::min)(first.Te, second.TePrior);
+        summary.TeTie = second.TeTie;
+    } else {
+        summary.TePrior = first.TePrior;
+        summary.TeTie = first.TeTie || second.Te == first.Te;
+    }
+    // a forwarded minimum from the second range only counts if it lowered the event time
+    const auto& actual =
+        (second.minFedActual.isValid() && second.actualTe < first.Te) ? second : first;
+    summary.actualTe = actual.actualTe;
+    summary.minFedActual = actual.minFedActual;
+    return summary;
+}
+
+static DependencyGrantSummary generateGrantSummary(const DependencyInfo& dep)
+{
+    DependencyGrantSummary summary;
+    if (!isGrantRestricting(dep)) {
+        return summary;
+    }
+    summary.count = 1;
+    summary.next = dep.next;
+    summary.blocking = (dep.mTimeState == TimeState::time_granted) ||
+        (dep.mTimeState == TimeState::time_requested && dep.nonGranting);
+    summary.blockingInterrupted = summary.blocking || !(dep.interrupted || dep.delayedTiming);
+    return summary;
+}
+
+static DependencyGrantSummary combineGrantSummary(const DependencyGrantSummary& first,
+                                                  const DependencyGrantSummary& second)
+{
+    if (second.count == 0) {
+        return first;
+    }
+    if (first.count == 0) {
+        return second;
+    }
+    DependencyGrantSummary summary = (second.next < first.next) ? second : first;
+    summary.count = first.count + second.count;
+    if (second.next == first.next) {
+        summary.blocking = first.blocking || second.blocking;
+        summary.blockingInterrupted = first.blockingInterrupted || second.blockingInterrupted;
+    }
+    return summary;
+}
+
+void TimeDependencies::rebuildIndex(std::int32_t sequenceCode) const
+{
+    mIndexLeaves = 1;
+    while (mIndexLeaves < dependencies.size()) {
+        mIndexLeaves *= 2;
+    }
+    mIndex.assign(2 * mIndexLeaves, IndexNode{});
+    mIndexSequence = sequenceCode;
+    for (std::size_t ii = 0; ii < dependencies.size(); ++ii) {
+        const auto& dep = dependencies[ii];
+        auto& leaf = mIndex[mIndexLeaves + ii];
+        if (dep.dependency) {
+            leaf.total = generateTimeSummary(dep, sequenceCode);
+            if (dep.connection != ConnectionType::PARENT) {
+                leaf.upstream = leaf.total;
+            }
+        }
+        leaf.grant = generateGrantSummary(dep);
+    }
+    for (std::size_t node = mIndexLeaves - 1; node > 0; --node) {
+        auto& parent = mIndex[node];
+        const auto& left = mIndex[2 * node];
+        const auto& right = mIndex[2 * node + 1];
+        parent.total = combineTimeSummary(left.total, right.total);
+        parent.upstream = combineTimeSummary(left.upstream, right.upstream);
+        parent.grant = combineGrantSummary(left.grant, right.grant);
+    }
+    mIndexValid = true;
+}
+
+void TimeDependencies::updateIndex(std::size_t position) const
+{
+    const auto& dep = dependencies[position];
+    std::size_t node = mIndexLeaves + position;
+    auto& leaf = mIndex[node];
+    leaf = IndexNode{};
+    if (dep.dependency) {
+        leaf.total = generateTimeSummary(dep, mIndexSequence);
+        if (dep.connection != ConnectionType::PARENT) {
+            leaf.upstream = leaf.total;
+        }
+    }
+    leaf.grant = generateGrantSummary(dep);
+    for (node /= 2; node > 0; node /= 2) {
+        auto& parent = mIndex[node];
+        const auto& left = mIndex[2 * node];
+        const auto& right = mIndex[2 * node + 1];
+        parent.total = combineTimeSummary(left.total, right.total);
+        parent.upstream = combineTimeSummary(left.upstream, right.upstream);
+        parent.grant = combineGrantSummary(left.grant, right.grant);
+    }
+}
+
+Time TimeDependencies::minimumNextTime() const
+{
+    if (!mIndexValid) {
+        rebuildIndex(mIndexSequence);
+    }
+    return mIndex[1].grant.next;
+}
+
+const DependencyTimeSummary* TimeDependencies::getTimeSummary(bool upstream,
+                                                              std::int32_t sequenceCode) const
+{
+    if (!mIndexValid || mIndexSequence != sequenceCode) {
+        rebuildIndex(sequenceCode);
+    }
+    const auto& summary = upstream ? mIndex[1].upstream : mIndex[1].total;
+    return (summary.pending == 0) ? &summary : nullptr;
 }
 
 bool TimeDependencies::checkIfAllDependenciesArePastExec(bool iterating) const
@@ -554,6 +764,17 @@ bool TimeDependencies::checkIfReadyForTimeGrant(bool iterating,
                                                 Time desiredGrantTime,
                                                 GrantDelayMode delayMode) const
 {
+    if (!mIndexValid) {
+        rebuildIndex(mIndexSequence);
+    }
+    const auto& grant = mIndex[1].grant;
+    if (grant.count == 0) {
+        return true;
+    }
+    // any dependency with an earlier next time blocks the grant in all modes
+    if (grant.next < desiredGrantTime) {
+        return false;
+    }
     if (iterating) {
         return std::all_of(dependencies.begin(),
                            dependencies.end(),
@@ -561,67 +782,17 @@ bool TimeDependencies::checkIfReadyForTimeGrant(bool iterating,
                                return iteratingTimeGrantCheck(dep, desiredGrantTime, delayMode);
                            });
     }
+    // without iteration only the dependencies at the desired time can block the grant
+    if (grant.next > desiredGrantTime) {
+        return true;
+    }
     switch (delayMode) {
         case GrantDelayMode::NONE:
-            for (const auto& dep : dependencies) {
-                if (!dep.dependency || dep.next >= cBigTime) {
-                    continue;
-                }
-                if (dep.connection == ConnectionType::SELF) {
-                    continue;
-                }
-                if (dep.next < desiredGrantTime) {
-                    return false;
-                }
-                if (dep.next == desiredGrantTime) {
-                    if (dep.mTimeState == TimeState::time_granted) {
-                        return false;
-                    }
-                    if (dep.mTimeState == TimeState::time_requested && dep.nonGranting) {
-                        return false;
-                    }
-                }
-            }
-            break;
+            return !grant.blocking;
         case GrantDelayMode::INTERRUPTED:
-            for (const auto& dep : dependencies) {
-                if (!dep.dependency || dep.next >= cBigTime) {
-                    continue;
-                }
-                if (dep.connection == ConnectionType::SELF) {
-                    continue;
-                }
-                if (dep.next < desiredGrantTime) {
-                    return false;
-                }
-                if (dep.next == desiredGrantTime) {
-                    if (dep.mTimeState == TimeState::time_granted) {
-                        return false;
-                    }
-                    if (dep.mTimeState == TimeState::time_requested && dep.nonGranting) {
-                        return false;
-                    }
-
-                    if (dep.interrupted || dep.delayedTiming) {
-                        continue;
-                    }
-                    return false;
-                }
-            }
-            break;
+            return !grant.blockingInterrupted;
         case GrantDelayMode::WAITING:
-            for (const auto& dep : dependencies) {
-                if (!dep.dependency || dep.next >= cBigTime) {
-                    continue;
-                }
-                if (dep.connection == ConnectionType::SELF) {
-                    continue;
-                }
-                if (dep.next <= desiredGrantTime) {
-                    return false;
-                }
-            }
-            break;
+            return false;
     }
 
     return true;
@@ -666,6 +837,7 @@ GlobalFederateId TimeDependencies::getMinDependency() const
 
 void TimeDependencies::resetIteratingExecRequests()
 {
+    mIndexValid = false;
     for (auto& dep : dependencies) {
         if (dep.dependency && dep.mTimeState <= TimeState::exec_requested_iterative) {
             dep.mTimeState = TimeState::initialized;
@@ -680,6 +852,7 @@ void TimeDependencies::resetIteratingExecRequests()
 
 void TimeDependencies::resetIteratingTimeRequests(helics::Time requestTime)
 {
+    mIndexValid = false;
     for (auto& dep : dependencies) {
         if (dep.dependency && dep.mTimeState == TimeState::time_requested_iterative) {
             if (dep.next == requestTime) {
@@ -693,6 +866,7 @@ void TimeDependencies::resetIteratingTimeRequests(helics::Time requestTime)
 
 void TimeDependencies::resetDependentEvents(helics::Time grantTime)
 {
+    mIndexValid = false;
     for (auto& dep : dependencies) {
         if (dep.dependency) {
             dep.Te = (std::max)(dep.next, grantTime);
@@ -836,6 +1010,39 @@ static void generateMinTimeImplementation(TimeData& mTime,
     // }
 }
 
+/** generate the result of generateMinTimeImplementation over the dependencies of a summary*/
+static TimeData generateMinTimeSummary(const DependencyTimeSummary& summary)
+{
+    TimeData mTime(Time::maxVal(), TimeState::error);
+    if (summary.count == 0) {
+        return mTime;
+    }
+    if (summary.minDeReset) {
+        mTime.minDe = -1;
+    }
+    if (summary.minDe < mTime.minDe) {
+        mTime.minDe = summary.minDe;
+    }
+    if (summary.next < mTime.next) {
+        mTime.next = summary.next;
+        mTime.mTimeState = summary.tieGranted ? TimeState::time_granted : summary.firstState;
+        mTime.interrupted = summary.firstInterrupted && summary.tieInterrupted;
+    } else if (summary.tieGranted || summary.firstState == TimeState::time_granted) {
+        mTime.mTimeState = TimeState::time_granted;
+    }
+    if (summary.Te < mTime.Te) {
+        mTime.Te = summary.Te;
+        mTime.TeAlt = summary.TeTie ? summary.Te : summary.TePrior;
+        mTime.minFed = summary.TeTie ? GlobalFederateId{} : summary.minFed;
+        mTime.sequenceCounter = summary.sequenceCounter;
+        mTime.responseSequenceCounter = summary.sequenceCounter;
+    }
+    if (summary.minFedActual.isValid() && summary.actualTe < Time::maxVal()) {
+        mTime.minFedActual = summary.minFedActual;
+    }
+    return mTime;
+}
+
 const DependencyInfo& getExecEntryMinFederate(const TimeDependencies& dependencies,
                                               GlobalFederateId self,
                                               ConnectionType ignoreType,
@@ -885,18 +1092,26 @@ TimeData generateMinTimeUpstream(const TimeDependencies& dependencies,
 {
     TimeData mTime(Time::maxVal(), TimeState::error);
     std::int32_t iterationCount{0};
-    for (const auto& dep : dependencies) {
-        if (!dep.dependency) {
-            continue;
-        }
-        if (dep.connection == ConnectionType::PARENT) {
-            continue;
-        }
-        if (self.isValid() && dep.minFedActual == self) {
-            continue;
+    const auto* summary = (self.isValid() || ignore.isValid()) ?
+        nullptr :
+        dependencies.getTimeSummary(true, responseCode);
+    if (summary != nullptr) {
+        mTime = generateMinTimeSummary(*summary);
+        iterationCount = summary->sequenceSum;
+    } else {
+        for (const auto& dep : dependencies) {
+            if (!dep.dependency) {
+                continue;
+            }
+            if (dep.connection == ConnectionType::PARENT) {
+                continue;
+            }
+            if (self.isValid() && dep.minFedActual == self) {
+                continue;
+            }
+            iterationCount += dep.sequenceCounter;
+            generateMinTimeImplementation(mTime, dep, ignore, responseCode);
         }
-        iterationCount += dep.sequenceCounter;
-        generateMinTimeImplementation(mTime, dep, ignore, responseCode);
     }
     if (mTime.Te < mTime.minDe) {
         mTime.minDe = mTime.Te;
@@ -965,15 +1180,22 @@ TimeData generateMinTimeTotal(const TimeDependencies& dependencies,
                               std::int32_t responseCode)
 {
     TimeData mTime(Time::maxVal(), TimeState::error);
-    for (const auto& dep : dependencies) {
-        if (!dep.dependency) {
-            continue;
-        }
+    const auto* summary = (self.isValid() || ignore.isValid()) ?
+        nullptr :
+        dependencies.getTimeSummary(false, responseCode);
+    if (summary != nullptr) {
+        mTime = generateMinTimeSummary(*summary);
+    } else {
+        for (const auto& dep : dependencies) {
+            if (!dep.dependency) {
+                continue;
+            }
 
-        if (self.isValid() && dep.minFedActual == self) {
-            continue;
+            if (self.isValid() && dep.minFedActual == self) {
+                continue;
+            }
+            generateMinTimeImplementation(mTime, dep, ignore, responseCode);
         }
-        generateMinTimeImplementation(mTime, dep, ignore, responseCode);
     }
 
     if (mTime.Te < mTime.minDe) {
@@ -125,11 +125,62 @@ class DependencyInfo: public TimeData {
     }
 };
 
+/** summary of the time values of a contiguous range of dependencies
+@details the summaries of two adjacent ranges combine to the values a sequential scan of both
+ranges in generateMinTimeTotal or generateMinTimeUpstream produces*/
+class DependencyTimeSummary {
+  public:
+    Time next{Time::maxVal()};  //!< the minimum next time
+    TimeState firstState{TimeState::error};  //!< the state of the first dependency at next
+    bool firstInterrupted{false};  //!< the interruption recorded by the first dependency at next
+    bool firstKeepsInterrupted{false};  //!< the first dependency at next would keep an interruption
+    bool tieGranted{false};  //!< a later dependency at next is granted
+    bool tieInterrupted{true};  //!< all later dependencies at next keep an interruption
+    Time Te{Time::maxVal()};  //!< the minimum event time
+    Time TePrior{Time::maxVal()};  //!< the minimum event time before the first dependency at Te
+    GlobalFederateId minFed{};  //!< the first dependency at Te
+    bool TeTie{false};  //!< more than one dependency is at Te
+    std::int32_t sequenceCounter{0};  //!< the sequence counter of the first dependency at Te
+    Time actualTe{Time::maxVal()};  //!< the event time of the last forwarded minimum federate
+    GlobalFederateId minFedActual{};  //!< the last forwarded minimum federate
+    Time minDe{Time::maxVal()};  //!< the minimum dependent event time after the last reset
+    bool minDeReset{false};  //!< an untrusted dependent event time reset minDe
+    std::int32_t sequenceSum{0};  //!< the sum of the sequence counters
+    std::int32_t count{0};  //!< the number of dependencies in the range
+    std::int32_t pending{0};  //!< the number of dependencies which have not been granted a time
+};
+
+/** summary of the dependencies of a contiguous range which can restrict a time grant*/
+class DependencyGrantSummary {
+  public:
+    Time next{Time::maxVal()};  //!< the minimum next time
+    bool blocking{false};  //!< a dependency at next blocks a grant at next
+    bool blockingInterrupted{false};  //!< a dependency at next blocks an interrupted grant
+    std::int32_t count{0};  //!< the number of restricting dependencies in the range
+};
+
 /** class for managing a set of dependencies*/
 class TimeDependencies {
   private:
+    /** node of the dependency summary tree*/
+    struct IndexNode {
+        DependencyTimeSummary total;
+        DependencyTimeSummary upstream;
+        DependencyGrantSummary grant;
+    };
     std::vector<DependencyInfo> dependencies;  //!< container
     mutable GlobalFederateId mDelayedDependency{};
+    /** tree of the dependency summaries in dependency order, the leaves start at mIndexLeaves
+    @details the tree is maintained incrementally by updateTime and rebuilt on first use after
+    any other modification of the dependencies or a change of the response sequence code*/
+    mutable std::vector<IndexNode> mIndex;
+    mutable std::size_t mIndexLeaves{0};
+    mutable std::int32_t mIndexSequence{0};
+    mutable bool mIndexValid{false};
+    /** rebuild the summary tree from the dependencies*/
+    void rebuildIndex(std::int32_t sequenceCode) const;
+    /** update the summary tree after a change to a single dependency*/
+    void updateIndex(std::size_t position) const;
 
   public:
     /** default constructor*/
@@ -157,9 +208,17 @@ class TimeDependencies {
     /** get the number of dependencies*/
     auto size() const { return dependencies.size(); }
     /** iterator to first dependency*/
-    auto begin() { return dependencies.begin(); }
+    auto begin()
+    {
+        mIndexValid = false;
+        return dependencies.begin();
+    }
     /** iterator to end point*/
-    auto end() { return dependencies.end(); }
+    auto end()
+    {
+        mIndexValid = false;
+        return dependencies.end();
+    }
     /**  const iterator to first dependency*/
     auto begin() const { return dependencies.cbegin(); }
     /** const iterator to end point*/
@@ -199,14 +258,46 @@ class TimeDependencies {
     void resetDependentEvents(Time grantTime);
     /** check if there are active dependencies*/
     bool hasActiveTimeDependencies() const;
+    /** flag an update request on each dependency with a next time at or before a trigger time
+    @details the flags are not part of the next time index so it remains valid
+    @param triggerTime the time to check the dependencies against
+    @param iteration the iteration to record in the flagged dependencies
+    @param request callable run for each flagged dependency*/
+    template<class Callable>
+    void requestUpdates(Time triggerTime, std::int32_t iteration, Callable request)
+    {
+        for (auto& dep : dependencies) {
+            if (dep.next <= triggerTime && dep.next < cBigTime) {
+                dep.updateRequested = true;
+                dep.grantedIteration = iteration;
+                request(std::as_const(dep));
+            }
+        }
+    }
     /** verify that all the sequence Counters match*/
     bool verifySequenceCounter(Time tmin, std::int32_t sequenceCount);
     /** get a count of the active dependencies*/
     int activeDependencyCount() const;
     /** get a count of the active dependencies*/
     GlobalFederateId getMinDependency() const;
+    /** get the minimum next time of the dependencies that can restrict a time grant
+    @details this is O(1) unless the dependencies were modified other than through updateTime
+    @return Time::maxVal() if there are no such dependencies*/
+    Time minimumNextTime() const;
+    /** get the summary of the dependencies scanned by generateMinTimeTotal or
+    generateMinTimeUpstream without ignored federates
+    @details this is O(1) unless the dependencies were modified other than through updateTime
+    or the sequence code changed
+    @param upstream true to exclude the dependencies with a parent connection
+    @param sequenceCode the response sequence code of the scan
+    @return nullptr if a dependency has not been granted a time and the scan is required*/
+    const DependencyTimeSummary* getTimeSummary(bool upstream, std::int32_t sequenceCode) const;
 
-    void setDependencyVector(const std::vector<DependencyInfo>& deps) { dependencies = deps; }
+    void setDependencyVector(const std::vector<DependencyInfo>& deps)
+    {
+        dependencies = deps;
+        mIndexValid = false;
+    }
     /** check the dependency set for any issues
     @return an error code and string containing an error description */
     std::pair<int, std::string> checkForIssues(bool waiting) const;
@@ -0,0 +1,323 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "TimerWheel.hpp"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace helics {
+
+namespace {
+    /** get the position of the lowest set bit of a non zero value*/
+    int lowestBit(std::uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        int index{0};
+        while ((value & 0xFFU) == 0U) {
+            value >>= 8U;
+            index += 8;
+        }
+        while ((value & 1U) == 0U) {
+            value >>= 1U;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    std::uint64_t rotateRight(std::uint64_t value, std::uint64_t shift)
+    {
+        return (shift == 0U) ? value : ((value >> shift) | (value << (64U - shift)));
+    }
+}  // namespace
+
+std::shared_ptr<TimerWheel> TimerWheel::getSharedWheel(std::chrono::nanoseconds tickResolution)
+{
+    static std::mutex wheelLock;
+    static std::map<std::chrono::nanoseconds, std::weak_ptr<TimerWheel>> sharedWheels;
+    tickResolution = std::max(tickResolution, std::chrono::nanoseconds(1));
+    const std::lock_guard<std::mutex> lock(wheelLock);
+    auto& sharedWheel = sharedWheels[tickResolution];
+    auto wheel = sharedWheel.lock();
+    if (!wheel) {
+        wheel = std::make_shared<TimerWheel>(tickResolution);
+        sharedWheel = wheel;
+    }
+    return wheel;
+}
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds tickResolution):
+    mResolution(std::max(tickResolution, std::chrono::nanoseconds(1))),
+    mOrigin(std::chrono::steady_clock::now()),
+    contextPtr(gmlc::networking::AsioContextManager::getContextPointer()),
+    loopHandle(contextPtr->startContextLoop()), mTimer(contextPtr->getBaseContext())
+{
+    mSlots.fill(-1);
+}
+
+TimerWheel::~TimerWheel()
+{
+    const std::lock_guard<std::mutex> lock(mLock);
+    mTimer.cancel();
+}
+
+std::int32_t TimerWheel::createTimer(std::int32_t clientIndex)
+{
+    const std::lock_guard<std::mutex> lock(mLock);
+    std::int32_t timer = mFreeNodes;
+    if (timer >= 0) {
+        mFreeNodes = mNodes[timer].next;
+    } else {
+        timer = static_cast<std::int32_t>(mNodes.size());
+        mNodes.emplace_back();
+    }
+    auto& node = mNodes[timer];
+    node.clientIndex = clientIndex;
+    node.prev = -1;
+    node.next = -1;
+    node.slot = -1;
+    return timer;
+}
+
+void TimerWheel::releaseTimer(std::int32_t timer)
+{
+    // the client is released after the lock in case this is the last reference to it
+    std::shared_ptr<Client> client;
+    const std::lock_guard<std::mutex> lock(mLock);
+    if (timer < 0 || timer >= static_cast<std::int32_t>(mNodes.size())) {
+        return;
+    }
+    if (mNodes[timer].slot >= 0) {
+        unlink(timer);
+        --mScheduled;
+    }
+    client = std::move(mNodes[timer].client);
+    mNodes[timer].next = mFreeNodes;
+    mFreeNodes = timer;
+}
+
+void TimerWheel::schedule(std::int32_t timer, time_type expiration, std::shared_ptr<Client> client)
+{
+    std::shared_ptr<Client> previousClient;
+    const std::lock_guard<std::mutex> lock(mLock);
+    if (timer < 0 || timer >= static_cast<std::int32_t>(mNodes.size())) {
+        return;
+    }
+    auto& node = mNodes[timer];
+    if (node.slot >= 0) {
+        unlink(timer);
+    } else {
+        ++mScheduled;
+    }
+    previousClient = std::exchange(node.client, std::move(client));
+    // anything already due goes in the next tick
+    node.expirationTick = std::max(toTick(expiration), mCurrentTick + 1);
+    link(timer);
+    if (node.expirationTick < mArmedTick) {
+        arm(node.expirationTick);
+    }
+}
+
+bool TimerWheel::cancel(std::int32_t timer)
+{
+    std::shared_ptr<Client> client;
+    const std::lock_guard<std::mutex> lock(mLock);
+    if (timer < 0 || timer >= static_cast<std::int32_t>(mNodes.size()) ||
+        mNodes[timer].slot < 0) {
+        return false;
+    }
+    unlink(timer);
+    --mScheduled;
+    client = std::move(mNodes[timer].client);
+    return true;
+}
+
+std::size_t TimerWheel::processExpired(time_type now)
+{
+    std::vector<Expired> expired;
+    {
+        const std::lock_guard<std::mutex> lock(mLock);
+        const auto nowTick = (now > mOrigin) ?
+            static_cast<std::uint64_t>((now - mOrigin) / mResolution) :
+            std::uint64_t{0};
+        advance(nowTick, expired);
+        mArmedTick = noTick;
+        const auto nextTick = nextEventTick();
+        if (nextTick != noTick) {
+            arm(nextTick);
+        }
+    }
+    for (auto& timer : expired) {
+        timer.client->timerExpired(timer.clientIndex);
+    }
+    return expired.size();
+}
+
+std::size_t TimerWheel::size() const
+{
+    const std::lock_guard<std::mutex> lock(mLock);
+    return mScheduled;
+}
+
+std::uint64_t TimerWheel::toTick(time_type time) const
+{
+    if (time <= mOrigin) {
+        return 0;
+    }
+    const auto span = std::chrono::duration_cast<std::chrono::nanoseconds>(time - mOrigin).count();
+    const auto resolution = mResolution.count();
+    // round up so a timer never fires before its expiration
+    return static_cast<std::uint64_t>((span + resolution - 1) / resolution);
+}
+
+TimerWheel::time_type TimerWheel::tickTime(std::uint64_t tick) const
+{
+    return mOrigin +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(mResolution * tick);
+}
+
+void TimerWheel::link(std::int32_t node)
+{
+    auto& entry = mNodes[node];
+    const auto span = (entry.expirationTick > mCurrentTick) ?
+        std::min(entry.expirationTick - mCurrentTick, maxTickSpan) :
+        std::uint64_t{0};
+    int level{0};
+    while (level < levels - 1 && span >= (std::uint64_t{1} << (levelBits * (level + 1)))) {
+        ++level;
+    }
+    const auto slotIndex = ((mCurrentTick + span) >> (levelBits * level)) & slotMask;
+    const auto slot = static_cast<std::int32_t>(level * slotsPerLevel + slotIndex);
+    entry.slot = slot;
+    entry.prev = -1;
+    entry.next = mSlots[slot];
+    if (entry.next >= 0) {
+        mNodes[entry.next].prev = node;
+    }
+    mSlots[slot] = node;
+    mOccupied[level] |= (std::uint64_t{1} << slotIndex);
+}
+
+void TimerWheel::unlink(std::int32_t node)
+{
+    auto& entry = mNodes[node];
+    if (entry.prev >= 0) {
+        mNodes[entry.prev].next = entry.next;
+    } else {
+        mSlots[entry.slot] = entry.next;
+        if (entry.next < 0) {
+            mOccupied[entry.slot / slotsPerLevel] &=
+                ~(std::uint64_t{1} << (static_cast<std::uint64_t>(entry.slot) & slotMask));
+        }
+    }
+    if (entry.next >= 0) {
+        mNodes[entry.next].prev = entry.prev;
+    }
+    entry.slot = -1;
+    entry.prev = -1;
+    entry.next = -1;
+}
+
+void TimerWheel::cascade(std::uint64_t tick)
+{
+    for (int level = 1; level < levels; ++level) {
+        const auto slotIndex = (tick >> (levelBits * level)) & slotMask;
+        const auto slot = level * slotsPerLevel + slotIndex;
+        auto node = mSlots[slot];
+        mSlots[slot] = -1;
+        mOccupied[level] &= ~(std::uint64_t{1} << slotIndex);
+        while (node >= 0) {
+            const auto next = mNodes[node].next;
+            link(node);
+            node = next;
+        }
+        // the next level only comes due when this one wraps around
+        if (slotIndex != 0U) {
+            break;
+        }
+    }
+}
+
+void TimerWheel::collectSlot(std::uint64_t slotIndex, std::vector<Expired>& expired)
+{
+    auto node = mSlots[slotIndex];
+    mSlots[slotIndex] = -1;
+    mOccupied[0] &= ~(std::uint64_t{1} << slotIndex);
+    while (node >= 0) {
+        auto& entry = mNodes[node];
+        const auto next = entry.next;
+        entry.slot = -1;
+        if (entry.expirationTick > mCurrentTick) {
+            link(node);
+        } else {
+            entry.prev = -1;
+            entry.next = -1;
+            expired.push_back({std::move(entry.client), entry.clientIndex});
+            --mScheduled;
+        }
+        node = next;
+    }
+}
+
+void TimerWheel::advance(std::uint64_t targetTick, std::vector<Expired>& expired)
+{
+    while (mCurrentTick < targetTick) {
+        // the ticks in between have no slots to collect or cascade so they can be skipped
+        const auto nextTick = nextEventTick();
+        if (nextTick > targetTick) {
+            mCurrentTick = targetTick;
+            break;
+        }
+        mCurrentTick = nextTick;
+        const auto slotIndex = mCurrentTick & slotMask;
+        if (slotIndex == 0U) {
+            cascade(mCurrentTick);
+        }
+        if ((mOccupied[0] & (std::uint64_t{1} << slotIndex)) != 0U) {
+            collectSlot(slotIndex, expired);
+        }
+    }
+}
+
+std::uint64_t TimerWheel::nextEventTick() const
+{
+    std::uint64_t nextTick{noTick};
+    for (int level = 0; level < levels; ++level) {
+        if (mOccupied[level] == 0U) {
+            continue;
+        }
+        const auto shift = levelBits * level;
+        const auto base = (mCurrentTick >> shift) + 1;
+        // the slots come due in order starting with the one after the current slot
+        const auto offset = lowestBit(rotateRight(mOccupied[level], base & slotMask));
+        nextTick = std::min(nextTick, (base + offset) << shift);
+    }
+    return nextTick;
+}
+
+void TimerWheel::arm(std::uint64_t tick)
+{
+    if (tick == mArmedTick) {
+        return;
+    }
+    mArmedTick = tick;
+    mTimer.expires_at(tickTime(tick));
+    mTimer.async_wait([wheel = weak_from_this()](const std::error_code& error) {
+        if (error == asio::error::operation_aborted) {
+            return;
+        }
+        if (auto timerWheel = wheel.lock()) {
+            timerWheel->processExpired(std::chrono::steady_clock::now());
+        }
+    });
+}
+
+}  // namespace helics
@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "gmlc/networking/AsioContextManager.h"
+
+#include <array>
+#include <asio/steady_timer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace helics {
+/** hierarchical timer wheel running any number of timers from a single asio timer
+@details time is divided into ticks and each scheduled timer is placed in a slot of one of several
+wheels depending on how far in the future it expires, timers in the higher wheels are moved down as
+their slots come up.  Scheduling and cancelling a timer are constant time operations.  When the asio
+timer fires all the timers that expired in the elapsed ticks are collected and their clients are
+notified as a batch once the lock is released.  Timers never fire early and fire at most one tick
+late.
+*/
+class TimerWheel: public std::enable_shared_from_this<TimerWheel> {
+  public:
+    using time_type = decltype(std::chrono::steady_clock::now());
+
+    /** interface for the owner of timers in the wheel*/
+    class Client {
+      public:
+        virtual ~Client() = default;
+        /** called when a timer expires
+        @param index the client index the timer was created with*/
+        virtual void timerExpired(std::int32_t index) = 0;
+    };
+
+    /** the default length of a tick*/
+    static constexpr std::chrono::nanoseconds defaultTickResolution{std::chrono::microseconds(100)};
+
+    /** get the wheel shared by all the message timers in the process using a given tick length
+    @details one wheel is shared for each distinct tick length in use*/
+    static std::shared_ptr<TimerWheel>
+        getSharedWheel(std::chrono::nanoseconds tickResolution = defaultTickResolution);
+
+    /** construct a wheel
+    @param tickResolution the length of a tick*/
+    explicit TimerWheel(std::chrono::nanoseconds tickResolution = defaultTickResolution);
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /** create a timer, the timer is not scheduled
+    @param clientIndex the index passed to the client when the timer expires
+    @return an identifier for the timer*/
+    std::int32_t createTimer(std::int32_t clientIndex);
+    /** release a timer created with createTimer, cancelling it if it is scheduled*/
+    void releaseTimer(std::int32_t timer);
+    /** schedule a timer replacing any previous schedule
+    @param timer the identifier of the timer
+    @param expiration the time the timer should expire
+    @param client the object to notify, it is held until the timer expires or is cancelled*/
+    void schedule(std::int32_t timer, time_type expiration, std::shared_ptr<Client> client);
+    /** cancel a timer
+    @return true if the timer was scheduled*/
+    bool cancel(std::int32_t timer);
+    /** notify the clients of all the timers that have expired by a given time
+    @details this is called when the asio timer fires
+    @return the number of timers that expired*/
+    std::size_t processExpired(time_type now);
+    /** get the number of scheduled timers*/
+    std::size_t size() const;
+    /** get the length of a tick*/
+    std::chrono::nanoseconds getTickResolution() const { return mResolution; }
+
+  private:
+    static constexpr int levelBits{6};
+    static constexpr int levels{4};
+    static constexpr std::uint64_t slotsPerLevel{1U << levelBits};
+    static constexpr std::uint64_t slotMask{slotsPerLevel - 1};
+    /** the furthest ahead of the current tick a timer can be placed, timers past this are placed
+    at the limit and moved again when they reach it*/
+    static constexpr std::uint64_t maxTickSpan{(std::uint64_t{1} << (levelBits * levels)) - 1};
+    static constexpr std::uint64_t noTick{std::numeric_limits<std::uint64_t>::max()};
+
+    struct Node {
+        std::shared_ptr<Client> client;
+        std::uint64_t expirationTick{0};
+        std::int32_t clientIndex{0};
+        std::int32_t prev{-1};
+        std::int32_t next{-1};
+        std::int32_t slot{-1};  //!< the slot the node is linked in, -1 if not scheduled
+    };
+    /** a timer that expired with the client to notify*/
+    struct Expired {
+        std::shared_ptr<Client> client;
+        std::int32_t clientIndex;
+    };
+
+    std::uint64_t toTick(time_type time) const;
+    time_type tickTime(std::uint64_t tick) const;
+    /** place a node in the slot matching its expiration tick*/
+    void link(std::int32_t node);
+    /** remove a node from its slot*/
+    void unlink(std::int32_t node);
+    /** move the nodes of the higher level slots that come due at a tick to lower levels*/
+    void cascade(std::uint64_t tick);
+    /** collect the expired nodes in a slot of the lowest level*/
+    void collectSlot(std::uint64_t slotIndex, std::vector<Expired>& expired);
+    /** advance the current tick collecting all the nodes that expire on the way*/
+    void advance(std::uint64_t targetTick, std::vector<Expired>& expired);
+    /** get the next tick at which a node expires or needs to move down a level*/
+    std::uint64_t nextEventTick() const;
+    /** set the asio timer to fire at a tick*/
+    void arm(std::uint64_t tick);
+
+    mutable std::mutex mLock;  //!< lock protecting all the wheel data
+    std::vector<Node> mNodes;
+    std::int32_t mFreeNodes{-1};  //!< the head of the list of unused nodes
+    std::array<std::int32_t, levels * slotsPerLevel> mSlots;  //!< the first node in each slot
+    std::array<std::uint64_t, levels> mOccupied{};  //!< bit mask of the non empty slots per level
+    std::size_t mScheduled{0};  //!< the number of scheduled timers
+    std::uint64_t mCurrentTick{0};  //!< the last tick processed
+    std::uint64_t mArmedTick{noTick};  //!< the tick the asio timer is set for
+    const std::chrono::nanoseconds mResolution;
+    const time_type mOrigin;  //!< the time of tick 0
+    /** context manager to use for handling real time operations */
+    std::shared_ptr<gmlc::networking::AsioContextManager> contextPtr;
+    /** loop controller for async real time operations */
+    decltype(contextPtr->startContextLoop()) loopHandle;
+    asio::steady_timer mTimer;
+};
+}  // namespace helics
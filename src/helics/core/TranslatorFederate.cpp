@@ -20,6 +20,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace helics {
 
@@ -81,20 +82,32 @@ void TranslatorFederate::executeTranslator(ActionMessage& command, TranslatorInf
                     sendM.payload = std::move(val);
                     mSendMessageMove(std::move(sendM));
                 } else {
-                    ActionMessage sendM(CMD_PUB);
-
+                    // the converted value is sent once with the list of targets and only split at
+                    // the last hop
+                    ActionMessage sendM(CMD_MULTICAST_PUB);
                     sendM.setSource(trans->id);
+                    sendM.setDestination(targets.front().id);
                     sendM.actionTime = trans->tranOp->computeNewValueTime(command.actionTime);
                     sendM.payload = std::move(val);
+                    std::vector<GlobalHandle> destinations;
+                    destinations.reserve(targets.size());
                     for (const auto& target : targets) {
-                        sendM.setDestination(target.id);
-                        mSendMessage(sendM);
+                        destinations.push_back(target.id);
                     }
+                    setMulticastDestinations(sendM, destinations);
+                    mSendMessageMove(std::move(sendM));
                 }
             }
         } break;
         case CMD_PUB: {
-            auto message = trans->tranOp->convertToMessage(command.payload);
+            auto value = trans->getInputInfo()->reconstructData(
+                command.getSource(),
+                std::make_shared<const SmallBuffer>(std::move(command.payload)),
+                getDeltaFrame(command.flags));
+            if (!value) {
+                break;
+            }
+            auto message = trans->tranOp->convertToMessage(*value);
             if (message) {
                 auto targets = trans->getEndpointInfo()->getTargets();
                 if (targets.empty()) {
@@ -107,18 +120,16 @@ void TranslatorFederate::executeTranslator(ActionMessage& command, TranslatorInf
                 ActionMessage sendM(std::move(message));
                 sendM.setSource(command.getSource());
 
-                if (targets.size() == 1) {
-                    sendM.setString(targetStringLoc, targets.front().second);
-                    sendM.setDestination(targets.front().first);
-                    mDeliverMessage(sendM);
-                } else {
-                    for (const auto& target : targets) {
-                        auto messageCopy(sendM);
-                        messageCopy.setString(targetStringLoc, target.second);
-                        messageCopy.setDestination(target.first);
-                        mDeliverMessage(messageCopy);
-                    }
+                // messages are delivered individually so copy for all but the last target
+                for (std::size_t ii = 0; ii + 1 < targets.size(); ++ii) {
+                    auto messageCopy(sendM);
+                    messageCopy.setString(targetStringLoc, targets[ii].second);
+                    messageCopy.setDestination(targets[ii].first);
+                    mDeliverMessage(messageCopy);
                 }
+                sendM.setString(targetStringLoc, targets.back().second);
+                sendM.setDestination(targets.back().first);
+                mDeliverMessage(sendM);
             }
         }
 
@@ -0,0 +1,224 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "VectorDelta.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace helics {
+
+// these must match the type codes used by the value serialization in ValueConverter.cpp
+static constexpr std::byte vectorCode{0x6C};
+static constexpr std::byte cvCode{0x62};
+/// code for a delta encoded value, it is not a valid value type code
+static constexpr std::byte deltaCode{0xD6};
+
+static constexpr std::size_t valueHeaderSize{8};
+/** code, reference code, 2 reserved, element count, sequence, block count*/
+static constexpr std::size_t deltaHeaderSize{16};
+/** start index, element count*/
+static constexpr std::size_t blockHeaderSize{8};
+
+static void writeSize(std::byte* data, std::size_t size)
+{
+    data[0] = static_cast<std::byte>((size >> 24U) & 0xFFU);
+    data[1] = static_cast<std::byte>((size >> 16U) & 0xFFU);
+    data[2] = static_cast<std::byte>((size >> 8U) & 0xFFU);
+    data[3] = static_cast<std::byte>(size & 0xFFU);
+}
+
+static std::uint32_t readSize(const std::byte* data)
+{
+    return (std::to_integer<std::uint32_t>(data[0]) << 24U) +
+        (std::to_integer<std::uint32_t>(data[1]) << 16U) +
+        (std::to_integer<std::uint32_t>(data[2]) << 8U) + std::to_integer<std::uint32_t>(data[3]);
+}
+
+static std::size_t elementSize(std::byte code)
+{
+    if (code == vectorCode) {
+        return sizeof(double);
+    }
+    if (code == cvCode) {
+        return 2 * sizeof(double);
+    }
+    return 0;
+}
+
+static const std::byte* bytes(std::string_view data)
+{
+    return reinterpret_cast<const std::byte*>(data.data());
+}
+
+bool isDeltaEncoded(std::string_view data)
+{
+    return data.size() >= deltaHeaderSize && bytes(data)[0] == deltaCode;
+}
+
+bool isDeltaReference(std::string_view data)
+{
+    if (data.size() < valueHeaderSize) {
+        return false;
+    }
+    const auto esize = elementSize(bytes(data)[0]);
+    return esize > 0 && data.size() == valueHeaderSize + esize * readSize(bytes(data) + 4);
+}
+
+std::uint32_t getDeltaSequence(std::string_view data)
+{
+    return isDeltaEncoded(data) ? readSize(bytes(data) + 8) : 0U;
+}
+
+DeltaEncoding encodeVectorDelta(SmallBuffer& reference,
+                                std::string_view value,
+                                double tolerance,
+                                std::uint32_t sequence,
+                                SmallBuffer& output)
+{
+    if (!isDeltaReference(value) || reference.size() != value.size() ||
+        std::memcmp(reference.data(), value.data(), valueHeaderSize) != 0) {
+        return DeltaEncoding::FULL_VALUE;
+    }
+    const auto esize = elementSize(bytes(value)[0]);
+    const std::size_t count = readSize(bytes(value) + 4);
+    std::byte* ref = reference.data() + valueHeaderSize;
+    const std::byte* val = bytes(value) + valueHeaderSize;
+
+    auto changed = [ref, val, esize, tolerance](std::size_t index) {
+        const auto offset = index * esize;
+        if (std::memcmp(ref + offset, val + offset, esize) == 0) {
+            return false;
+        }
+        if (tolerance <= 0.0) {
+            return true;
+        }
+        for (std::size_t part = 0; part < esize; part += sizeof(double)) {
+            double previous{0.0};
+            double current{0.0};
+            std::memcpy(&previous, ref + offset + part, sizeof(double));
+            std::memcpy(&current, val + offset + part, sizeof(double));
+            // written so a NaN in either value counts as a change
+            if (!(std::abs(current - previous) <= tolerance)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    output.resize(deltaHeaderSize);
+    std::byte* header = output.data();
+    std::memset(header, 0, deltaHeaderSize);
+    header[0] = deltaCode;
+    header[1] = bytes(value)[0];
+    writeSize(header + 4, count);
+    writeSize(header + 8, sequence);
+
+    std::uint32_t blocks{0};
+    std::size_t index{0};
+    while (index < count) {
+        if (!changed(index)) {
+            ++index;
+            continue;
+        }
+        // an unchanged element costs at least as much as a block header so blocks never span one
+        const std::size_t start{index};
+        ++index;
+        while (index < count && changed(index)) {
+            ++index;
+        }
+        const std::size_t run{index - start};
+        const std::size_t offset{output.size()};
+        if (offset + blockHeaderSize + run * esize >= value.size()) {
+            return DeltaEncoding::FULL_VALUE;
+        }
+        output.resize(offset + blockHeaderSize + run * esize);
+        writeSize(output.data() + offset, start);
+        writeSize(output.data() + offset + 4, run);
+        std::memcpy(output.data() + offset + blockHeaderSize, val + start * esize, run * esize);
+        std::memcpy(ref + start * esize, val + start * esize, run * esize);
+        ++blocks;
+    }
+    writeSize(output.data() + 12, blocks);
+    return (blocks == 0) ? DeltaEncoding::UNCHANGED : DeltaEncoding::DELTA;
+}
+
+bool applyVectorDelta(const SmallBuffer& reference, std::string_view delta, SmallBuffer& output)
+{
+    if (!isDeltaEncoded(delta) || !isDeltaReference(reference.to_string())) {
+        return false;
+    }
+    const std::byte* header = bytes(delta);
+    const auto esize = elementSize(header[1]);
+    const std::size_t count = readSize(header + 4);
+    if (reference[0] != header[1] || readSize(reference.data() + 4) != count) {
+        return false;
+    }
+    output = reference;
+    std::byte* target = output.data() + valueHeaderSize;
+    const std::uint32_t blocks = readSize(header + 12);
+    std::size_t offset{deltaHeaderSize};
+    for (std::uint32_t block = 0; block < blocks; ++block) {
+        if (offset + blockHeaderSize > delta.size()) {
+            return false;
+        }
+        const std::size_t start = readSize(header + offset);
+        const std::size_t run = readSize(header + offset + 4);
+        offset += blockHeaderSize;
+        if (start > count || run > count - start || run * esize > delta.size() - offset) {
+            return false;
+        }
+        std::memcpy(target + start * esize, header + offset, run * esize);
+        offset += run * esize;
+    }
+    return offset == delta.size();
+}
+
+std::shared_ptr<const SmallBuffer>
+    VectorDeltaReference::update(std::shared_ptr<const SmallBuffer> data, DeltaFrame frame)
+{
+    if (!data) {
+        return data;
+    }
+    switch (frame) {
+        case DeltaFrame::DELTA: {
+            const auto view = data->to_string();
+            if (!mValue || getDeltaSequence(view) != mSequence + 1) {
+                return nullptr;
+            }
+            auto full = std::make_shared<SmallBuffer>();
+            if (!applyVectorDelta(*mValue, view, *full)) {
+                clear();
+                return nullptr;
+            }
+            ++mSequence;
+            mValue = std::move(full);
+            return mValue;
+        }
+        case DeltaFrame::KEYFRAME:
+            if (isDeltaReference(data->to_string())) {
+                mValue = data;
+                mSequence = 0;
+                return data;
+            }
+            break;
+        case DeltaFrame::NONE:
+        default:
+            break;
+    }
+    clear();
+    return data;
+}
+
+void VectorDeltaReference::clear()
+{
+    mValue.reset();
+    mSequence = 0;
+}
+
+}  // namespace helics
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "SmallBuffer.hpp"
+#include "flagOperations.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+/** @file
+@details delta encoding of vector and complex vector publication values.  A publication with delta
+encoding enabled sends the first value and a periodic keyframe in the normal serialized form and
+every other update as a set of blocks containing only the elements that changed from the previous
+value.  Each block is a start index, an element count, and the raw elements, so an isolated
+change costs an index/value pair and a run of changes costs a single block header.  Deltas and
+full values from such a publication are marked with message flags, the receiving side keeps the
+last full value from each source and reconstructs the full value from the marked deltas so inputs
+and translators only ever see complete values.
+*/
+namespace helics {
+
+/// the number of delta updates sent between full values if no interval is specified
+constexpr std::int32_t defaultDeltaKeyframeInterval{64};
+
+/** the result of delta encoding a value*/
+enum class DeltaEncoding : std::uint8_t {
+    /// the value could not be encoded or the delta is not smaller and the full value should be sent
+    FULL_VALUE,
+    /// no element changed by more than the tolerance, the delta contains no blocks
+    UNCHANGED,
+    /// the delta contains the changed elements
+    DELTA
+};
+
+/** the role of a publication payload in a delta encoded stream*/
+enum class DeltaFrame : std::uint8_t {
+    /// the publication does not use delta encoding
+    NONE,
+    /// a full value from a publication using delta encoding
+    KEYFRAME,
+    /// the changes from the previous value of the publication
+    DELTA
+};
+
+/** get the delta frame type of a publication from the flags of its message*/
+inline DeltaFrame getDeltaFrame(std::uint16_t flags)
+{
+    if (checkActionFlag(flags, delta_encoded_flag)) {
+        return DeltaFrame::DELTA;
+    }
+    return checkActionFlag(flags, delta_keyframe_flag) ? DeltaFrame::KEYFRAME : DeltaFrame::NONE;
+}
+
+/** mark the delta frame type of a publication on its message*/
+template<class FlagContainer>
+inline void setDeltaFrameFlag(FlagContainer& M, DeltaFrame frame)
+{
+    if (frame == DeltaFrame::DELTA) {
+        setActionFlag(M, delta_encoded_flag);
+    } else if (frame == DeltaFrame::KEYFRAME) {
+        setActionFlag(M, delta_keyframe_flag);
+    }
+}
+
+/** check if a serialized value is a delta encoded vector*/
+bool isDeltaEncoded(std::string_view data);
+
+/** check if a serialized value is a vector or complex vector that can be a delta reference*/
+bool isDeltaReference(std::string_view data);
+
+/** get the sequence number of a delta encoded value, the number of deltas since the last full
+value*/
+std::uint32_t getDeltaSequence(std::string_view data);
+
+/** encode a value as the changes from a reference value
+@details the reference is updated to the value the receivers will reconstruct, elements within the
+tolerance of the reference are left unchanged so small drifts do not accumulate on the receivers.
+If the result is FULL_VALUE the reference may have been partially updated and should be replaced
+by the value.
+@param reference the previously transmitted value
+@param value the new serialized vector or complex vector
+@param tolerance changes to an element (or to either component of a complex element) at or below
+this magnitude are not transmitted, 0 transmits any change in the bit pattern
+@param sequence the sequence number to place in the delta
+@param[out] output the delta encoded value
+*/
+DeltaEncoding encodeVectorDelta(SmallBuffer& reference,
+                                std::string_view value,
+                                double tolerance,
+                                std::uint32_t sequence,
+                                SmallBuffer& output);
+
+/** reconstruct a full value from a reference and a delta
+@return false if the delta is malformed or does not match the reference*/
+bool applyVectorDelta(const SmallBuffer& reference, std::string_view delta, SmallBuffer& output);
+
+/** the most recent full value received from a source that may be sending delta encoded values*/
+class VectorDeltaReference {
+  public:
+    /** process a value received from the source
+    @param data the received value
+    @param frame the type of the value from the flags of its message, only values marked as deltas
+    are reconstructed
+    @return the full value, the original data if it was not delta encoded, or nullptr if the delta
+    does not follow the last value received and must be dropped until the next full value*/
+    std::shared_ptr<const SmallBuffer> update(std::shared_ptr<const SmallBuffer> data,
+                                              DeltaFrame frame);
+    /** drop the stored reference value*/
+    void clear();
+
+  private:
+    std::shared_ptr<const SmallBuffer> mValue;  //!< the last full value
+    std::uint32_t mSequence{0};  //!< the number of deltas applied to the last keyframe
+};
+
+}  // namespace helics
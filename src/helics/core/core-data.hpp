@@ -24,6 +24,7 @@ SPDX-License-Identifier: BSD-3-Clause
 all user functions are found in this namespace along with many other functions in the Core API
  */
 namespace helics {
+class ActionMessage;
 
 /** class containing a message structure*/
 class Message {
@@ -109,6 +110,22 @@ class FilterOperator {
     /** indicator if the filter Operator has the capability of generating completely new messages or
      * redirecting messages*/
     virtual bool isMessageGenerating() const { return false; }
+    /** check if the operator can work directly on the ActionMessage holding a message
+    @details the core calls processCommand and processCommandVector for these operators instead of
+    building a Message for them*/
+    virtual bool supportsCommandProcessing() const { return false; }
+    /** filter a message held in an ActionMessage in place
+    @return false if the message should be dropped*/
+    virtual bool processCommand(ActionMessage& /*command*/) { return true; }
+    /** generate the messages for a cloning filter from a message held in an ActionMessage
+    @param[out] messages the generated messages are appended to the vector
+    @return false if the operator does not generate the messages itself, the core then runs
+    processCommand on a copy of the message*/
+    virtual bool processCommandVector(const ActionMessage& /*command*/,
+                                      std::vector<ActionMessage>& /*messages*/)
+    {
+        return false;
+    }
 };
 
 /** special filter operator defining no operation the original message is simply returned
@@ -121,6 +138,7 @@ class NullFilterOperator final: public FilterOperator {
     {
         return message;
     }
+    virtual bool supportsCommandProcessing() const override { return true; }
 };
 
 /**
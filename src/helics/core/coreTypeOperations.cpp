@@ -60,6 +60,8 @@ std::string to_string(CoreType type)
             return "http_";
         case CoreType::UDP:
             return "udp_";
+        case CoreType::SHM:
+            return "shm_";
         case CoreType::NNG:
             return "nng_";
         case CoreType::INPROC:
@@ -74,7 +76,7 @@ std::string to_string(CoreType type)
             return {};
     }
 }
-static constexpr frozen::unordered_map<std::string_view, CoreType, 57> coreTypes{
+static constexpr frozen::unordered_map<std::string_view, CoreType, 61> coreTypes{
     {"default", CoreType::DEFAULT},
     {"def", CoreType::DEFAULT},
     {"mpi", CoreType::MPI},
@@ -118,6 +120,10 @@ static constexpr frozen::unordered_map<std::string_view, CoreType, 57> coreTypes
     {"udp", CoreType::UDP},
     {"test", CoreType::TEST},
     {"UDP", CoreType::UDP},
+    {"shm", CoreType::SHM},
+    {"SHM", CoreType::SHM},
+    {"sharedmem", CoreType::SHM},
+    {"shared_memory", CoreType::SHM},
     {"local", CoreType::TEST},
     {"inprocess", CoreType::INPROC},
     {"websocket", CoreType::WEBSOCKET},
@@ -170,6 +176,9 @@ CoreType coreTypeFromString(std::string_view type) noexcept
     if (type.compare(0, 3, "ipc") == 0) {
         return CoreType::INTERPROCESS;
     }
+    if (type.compare(0, 3, "shm") == 0) {
+        return CoreType::SHM;
+    }
     if (type.compare(0, 4, "test") == 0) {
         return CoreType::TEST;
     }
@@ -231,6 +240,12 @@ static bool constexpr ipc_availability{false};
 static bool constexpr ipc_availability{true};
 #endif
 
+#ifndef HELICS_ENABLE_SHM_CORE
+static bool constexpr shm_availability{false};
+#else
+static bool constexpr shm_availability{true};
+#endif
+
 #ifndef HELICS_ENABLE_TEST_CORE
 static bool constexpr test_availability{false};
 #else
@@ -262,6 +277,9 @@ bool isCoreTypeAvailable(CoreType type) noexcept
         case CoreType::IPC:
             available = ipc_availability;
             break;
+        case CoreType::SHM:
+            available = shm_availability;
+            break;
         case CoreType::UDP:
             available = udp_availability;
             break;
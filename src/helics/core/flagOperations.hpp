@@ -86,6 +86,12 @@ enum FilterFlags {
 
 /// @brief flags used when connecting a federate/core/broker to a federation
 enum ConnectionFlags : uint16_t {
+    /// flag indicating the connection accepts binary profiler records
+    binary_profiling_flag = 0,
+    /// flag indicating the connection can use the compact message encoding
+    compact_encoding_flag = 1,
+    /// flag indicating the connection accepts multicast publication messages
+    multicast_flag = 2,
     /// flag indicating that message comes from a core vs a broker
     core_flag = 3,
     /// flag indicating to use global timing (overload of indicator flag)
@@ -118,10 +124,17 @@ enum ConnectionFlags : uint16_t {
 enum MessageFlags : uint16_t {
     /// flag indicating that the message requires processing for filters yet
     filter_processing_required_flag = 7,
+    /// flag indicating the publication payload is a delta from the previous value of the source
+    delta_encoded_flag = 8,
+    /// flag indicating the publication payload is held by the receiving federate
+    /// shares bit 9 with clone_flag which is only set on filter and registration messages
+    shared_payload_flag = 9,
     /// custom message flag 1
     user_custom_message_flag1 = 10,
     /// flag indicating the message is for destination processing
     destination_processing_flag = 11,
+    /// flag indicating the publication payload is a full value from a delta encoded publication
+    delta_keyframe_flag = 12,
     /// flag indicating the message is empty
     /// custom message flag 2
     user_custom_message_flag2 = 13,
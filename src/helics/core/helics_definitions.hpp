@@ -170,7 +170,9 @@ namespace defs {
         INPUT_PRIORITY_LOCATION = HELICS_HANDLE_OPTION_INPUT_PRIORITY_LOCATION,
         CLEAR_PRIORITY_LIST = HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST,
         CONNECTIONS = HELICS_HANDLE_OPTION_CONNECTIONS,
-        TIME_RESTRICTED = HELICS_HANDLE_OPTION_TIME_RESTRICTED
+        TIME_RESTRICTED = HELICS_HANDLE_OPTION_TIME_RESTRICTED,
+        DELTA_ENCODING = HELICS_HANDLE_OPTION_DELTA_ENCODING,
+        DELTA_TOLERANCE = HELICS_HANDLE_OPTION_DELTA_TOLERANCE
     };
 
 }  // namespace defs
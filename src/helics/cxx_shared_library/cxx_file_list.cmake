@@ -17,6 +17,7 @@ set(helics_shared_public_headers
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/Filters.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/Translator.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/Federate.hpp
+    ${HELICS_LIBRARY_SOURCE_DIR}/application_api/TimeRequestAwaitable.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/helicsTypes.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/data_view.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/MessageFederate.hpp
@@ -42,6 +43,7 @@ set(helics_shared_private_headers
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/TranslatorOperations.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/ConnectorFederateManager.hpp
     ${HELICS_LIBRARY_SOURCE_DIR}/application_api/PotentialInterfacesManager.hpp
+    ${HELICS_LIBRARY_SOURCE_DIR}/application_api/InputCallbackPool.hpp
 )
 
 set(conv_headers
@@ -39,6 +39,9 @@ typedef enum { /* NOLINT */
                HELICS_CORE_TYPE_TCP = 6,
                /** use UDP packets to send the data */
                HELICS_CORE_TYPE_UDP = 7,
+               /** use lock free ring buffers in shared memory to transfer data (for use when all
+                  federates are on the same machine)*/
+               HELICS_CORE_TYPE_SHM = 8,
                /** single socket version of ZMQ core usually for high fed count on the same system*/
                HELICS_CORE_TYPE_ZMQ_SS = 10,
                /** for using the nanomsg communications */
@@ -384,7 +387,14 @@ typedef enum { /* NOLINT */
                   connections*/
                HELICS_HANDLE_OPTION_CONNECTIONS = 522,
                /** specify that the interface only sends or receives data at specified intervals*/
-               HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557
+               HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557,
+               /** specify that vector and complex vector values of a publication are sent as the
+                  changes from the previous value, the value is the number of updates between full
+                  values or 1 to use the default interval*/
+               HELICS_HANDLE_OPTION_DELTA_ENCODING = 562,
+               /** specify the tolerance in millionths of a unit below which changes to an element
+                  of a delta encoded value are not transmitted*/
+               HELICS_HANDLE_OPTION_DELTA_TOLERANCE = 564
 } HelicsHandleOptions;
 
 /** enumeration of the predefined filter types*/
@@ -98,6 +98,32 @@ std::shared_ptr<helicsCLI11App> NetworkBrokerData::commandLineParser(std::string
         ->check(CLI::PositiveNumber);
     nbparser->add_option("--networkretries", maxRetries, "the maximum number of network retries")
         ->capture_default_str();
+    nbparser->add_flag("--batch_transmit",
+                       batchTransmit,
+                       "combine all queued messages into a single transmission per route");
+    nbparser
+        ->add_option("--max_batch_size",
+                     maxBatchSize,
+                     "the maximum number of messages to combine in a batched transmission")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
+    nbparser
+        ->add_option("--batch_linger",
+                     batchLingerTime,
+                     "the time in milliseconds to wait for additional messages to fill a batch")
+        ->capture_default_str()
+        ->check(CLI::NonNegativeNumber);
+    nbparser->add_flag(
+        "--compact_encoding",
+        compactEncoding,
+        "use the compact binary message encoding on connections that support it (tcp only)");
+    nbparser
+        ->add_option("--max_datagram_size",
+                     maxDatagramSize,
+                     "the maximum size in bytes of a batched udp datagram, larger messages are "
+                     "fragmented")
+        ->capture_default_str()
+        ->check(CLI::Range(256, 65507));
     nbparser->add_flag("--useosport",
                        use_os_port,
                        "specify that the ports should be allocated by the host operating system");
@@ -43,6 +43,9 @@ class NetworkBrokerData {
     int maxMessageSize{16 * 256};  //!< maximum message size
     int maxMessageCount{256};  //!< maximum message count
     int maxRetries{5};  //!< the maximum number of retries to establish a network connection
+    int maxBatchSize{64};  //!< maximum number of messages to combine in a batched transmission
+    int batchLingerTime{0};  //!< time in ms to wait for additional messages to fill a batch
+    int maxDatagramSize{1400};  //!< maximum size of a batched udp datagram
     gmlc::networking::InterfaceNetworks interfaceNetwork{
         gmlc::networking::InterfaceNetworks::LOCAL};
     bool reuse_address{false};  //!< allow reuse of binding address
@@ -58,6 +61,8 @@ class NetworkBrokerData {
     ServerModeOptions server_mode{ServerModeOptions::UNSPECIFIED};  //!< setup a server mode
     bool encrypted{false};  // enable encryption
     bool forceConnection{false};  // force the connection and terminate existing connections
+    bool batchTransmit{false};  //!< combine queued messages into a single transmission per route
+    bool compactEncoding{false};  //!< request the compact message encoding on connections
     std::string encryptionConfig;
 
   public:
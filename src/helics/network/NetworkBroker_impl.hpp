@@ -23,7 +23,7 @@ constexpr const char* tstr[] = {"default",
                                 "interprocess",
                                 "TCP",
                                 "UDP",
-                                "undef",
+                                "SHM",
                                 "nng",
                                 "ZMQ_SS",
                                 "TCPSS",
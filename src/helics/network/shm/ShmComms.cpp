@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "ShmComms.h"
+
+#include "../../core/ActionMessage.hpp"
+#include "../../core/helics_definitions.hpp"
+#include "ShmMailbox.h"
+
+#include <fmt/format.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace helics {
+namespace shm {
+    /// the generic default name the network cores and brokers use for interprocess connections
+    static constexpr std::string_view ipcDefaultName{"_ipc_broker"};
+    /// the default name of a shared memory broker mailbox
+    static constexpr std::string_view shmDefaultName{"_shm_broker"};
+
+    ShmComms::ShmComms()
+    {
+        // override the default value for this comm system
+        maxMessageSize = 64 * 1024;
+    }
+    /** destructor*/
+    ShmComms::~ShmComms()
+    {
+        disconnect();
+    }
+
+    void ShmComms::loadNetworkInfo(const NetworkBrokerData& netInfo)
+    {
+        CommsInterface::loadNetworkInfo(netInfo);
+        if (!propertyLock()) {
+            return;
+        }
+        // use a separate default name from the IPC core so both types of broker can run at once
+        if (brokerTargetAddress == ipcDefaultName) {
+            brokerTargetAddress = shmDefaultName;
+        }
+        if (localTargetAddress == ipcDefaultName) {
+            localTargetAddress = shmDefaultName;
+        }
+        if (localTargetAddress.empty()) {
+            if (serverMode) {
+                localTargetAddress = shmDefaultName;
+            } else {
+                localTargetAddress = name;
+            }
+        }
+        propertyUnLock();
+    }
+
+    void ShmComms::queue_rx_function()
+    {
+        OwnedMailbox rxMailbox;
+        // the mailbox is a stream so the message size only sets the ring capacity
+        bool connected =
+            rxMailbox.connect(localTargetAddress, static_cast<std::uint32_t>(maxMessageSize));
+        if (!connected) {
+            std::this_thread::sleep_for(connectionTimeout);
+            connected =
+                rxMailbox.connect(localTargetAddress, static_cast<std::uint32_t>(maxMessageSize));
+            if (!connected) {
+                disconnecting = true;
+                ActionMessage err(CMD_ERROR);
+                err.messageID = defs::Errors::CONNECTION_FAILURE;
+                err.payload = rxMailbox.getError();
+                ActionCallback(std::move(err));
+                setRxStatus(ConnectionStatus::ERRORED);  // the connection has failed
+                return;
+            }
+        }
+        setRxStatus(
+            ConnectionStatus::CONNECTED);  // this is a atomic indicator that the rx queue is ready
+        bool operating = false;
+        while (!closeRequested.load()) {
+            auto cmdopt = rxMailbox.getMessage(200);
+            if (!cmdopt) {
+                continue;
+            }
+            if (isProtocolCommand(*cmdopt)) {
+                if (cmdopt->messageID == CLOSE_RECEIVER) {
+                    disconnecting = true;
+                    break;
+                }
+                continue;
+            }
+            if (cmdopt->action() == CMD_INIT_GRANT) {
+                if (!operating) {
+                    rxMailbox.changeState(MailboxState::OPERATING);
+                    operating = true;
+                }
+            }
+            ActionCallback(std::move(*cmdopt));
+        }
+        closeRequested = false;
+        rxMailbox.changeState(MailboxState::CLOSING);
+        setRxStatus(ConnectionStatus::TERMINATED);
+    }
+
+    void ShmComms::queue_tx_function()
+    {
+        MailboxSender brokerMailbox;  //!< the mailbox of the broker
+        MailboxSender rxMailbox;
+        std::map<route_id, MailboxSender> routes;  //!< table of the routes to other brokers
+        bool hasBroker = false;
+
+        if (!brokerTargetAddress.empty()) {
+            bool conn = brokerMailbox.connect(brokerTargetAddress, true, 20);
+            if (!conn) {
+                std::this_thread::sleep_for(connectionTimeout);
+                conn = brokerMailbox.connect(brokerTargetAddress, true, 20);
+                if (!conn) {
+                    ActionMessage err(CMD_ERROR);
+                    err.payload = fmt::format("Unable to open broker connection -> {}",
+                                              brokerMailbox.getError());
+                    err.messageID = defs::Errors::CONNECTION_FAILURE;
+                    ActionCallback(std::move(err));
+                    setTxStatus(ConnectionStatus::ERRORED);
+                    return;
+                }
+            }
+            hasBroker = true;
+        }
+        // wait for the receiver to STARTUP
+        if (!rxTrigger.wait_forActivation(connectionTimeout)) {
+            ActionMessage err(CMD_ERROR);
+            err.messageID = defs::Errors::CONNECTION_FAILURE;
+            err.payload = "Unable to link with receiver";
+            ActionCallback(std::move(err));
+            setTxStatus(ConnectionStatus::ERRORED);
+            return;
+        }
+        if (getRxStatus() == ConnectionStatus::ERRORED) {
+            setTxStatus(ConnectionStatus::ERRORED);
+            return;
+        }
+        if (!rxMailbox.connect(localTargetAddress, false, 3)) {
+            ActionMessage err(CMD_ERROR);
+            err.messageID = defs::Errors::CONNECTION_FAILURE;
+            err.payload =
+                fmt::format("Unable to open receiver connection -> {}", rxMailbox.getError());
+            ActionCallback(std::move(err));
+            setTxStatus(ConnectionStatus::ERRORED);
+            closeRequested = true;
+            return;
+        }
+
+        setTxStatus(ConnectionStatus::CONNECTED);
+        bool continueLoop{true};
+        while (continueLoop) {
+            route_id rid;
+            ActionMessage cmd;
+            std::tie(rid, cmd) = txQueue.pop();
+            if (isProtocolCommand(cmd)) {
+                if (rid == control_route) {
+                    switch (cmd.messageID) {
+                        case NEW_ROUTE: {
+                            MailboxSender newMailbox;
+                            bool newConnected =
+                                newMailbox.connect(std::string(cmd.payload.to_string()), false, 3);
+                            if (newConnected) {
+                                routes.emplace(route_id{cmd.getExtraData()},
+                                               std::move(newMailbox));
+                            }
+                            continue;
+                        }
+                        case REMOVE_ROUTE:
+                            routes.erase(route_id{cmd.getExtraData()});
+                            continue;
+                        case DISCONNECT:
+                            continueLoop = false;
+                            continue;
+                    }
+                }
+            }
+            MailboxSender* target{nullptr};
+            if (rid == parent_route_id) {
+                if (hasBroker) {
+                    target = &brokerMailbox;
+                }
+            } else if (rid == control_route) {
+                target = &rxMailbox;
+            } else {
+                auto routeFnd = routes.find(rid);
+                if (routeFnd != routes.end()) {
+                    target = &routeFnd->second;
+                } else {
+                    if (hasBroker) {
+                        target = &brokerMailbox;
+                    }
+                }
+            }
+            if (target != nullptr && !target->sendMessage(cmd)) {
+                logError(fmt::format("shm send {} to route {} failed::{}",
+                                     actionMessageType(cmd.action()),
+                                     rid.baseValue(),
+                                     target->getError()));
+            }
+        }
+        setTxStatus(ConnectionStatus::TERMINATED);
+    }
+
+    void ShmComms::closeReceiver()
+    {
+        if ((getRxStatus() == ConnectionStatus::ERRORED) ||
+            (getRxStatus() == ConnectionStatus::TERMINATED)) {
+            return;
+        }
+        if (getTxStatus() == ConnectionStatus::CONNECTED) {
+            ActionMessage cmd(CMD_PROTOCOL);
+            cmd.messageID = CLOSE_RECEIVER;
+            transmit(control_route, cmd);
+        } else if (!disconnecting) {
+            // the receiver checks this flag every time its wait times out
+            closeRequested.store(true);
+        }
+    }
+
+    std::string ShmComms::getAddress() const
+    {
+        return localTargetAddress;
+    }
+
+}  // namespace shm
+}  // namespace helics
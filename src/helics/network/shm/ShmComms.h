@@ -0,0 +1,41 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "../CommsInterface.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace helics {
+namespace shm {
+    /** implementation for the core that uses lock free ring buffers in POSIX shared memory to
+     * communicate*/
+    class ShmComms final: public CommsInterface {
+      public:
+        /** default constructor*/
+        ShmComms();
+        /** destructor*/
+        ~ShmComms();
+
+        virtual void loadNetworkInfo(const NetworkBrokerData& netInfo) override;
+
+      private:
+        std::atomic<bool> closeRequested{false};  //!< back channel request to close the receiver
+        virtual void queue_rx_function() override;  //!< the functional loop for the receive queue
+        virtual void queue_tx_function() override;  //!< the loop for transmitting data
+        virtual void closeReceiver() override;  //!< function to instruct the receiver loop to close
+
+      public:
+        /** get the port number of the comms object to push message to*/
+        int getPort() const { return -1; }
+
+        std::string getAddress() const;
+    };
+
+}  // namespace shm
+}  // namespace helics
@@ -0,0 +1,15 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "ShmCore.h"
+
+#include "../NetworkCore_impl.hpp"
+#include "ShmComms.h"
+
+namespace helics {
+template class NetworkCore<shm::ShmComms, InterfaceTypes::IPC>;
+}  // namespace helics
@@ -0,0 +1,624 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "ShmMailbox.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <new>
+#include <signal.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+#ifdef __linux__
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#endif
+
+namespace helics {
+namespace shm {
+    static constexpr std::uint32_t mailboxMagic{0x48534D42U};  // "HSMB"
+    static constexpr std::uint32_t mailboxVersion{2U};
+    /// owner value of a slot left with a partially written message
+    static constexpr std::uint32_t abandonedSlot{0xFFFFFFFFU};
+    /// how often the owner checks for slots held by producers which exited
+    static constexpr std::chrono::milliseconds ownerCheckInterval{1000};
+    /// the maximum length of a shared memory name on some platforms (macOS)
+    static constexpr std::size_t maxObjectNameLength{30};
+    /// size of the length prefix of each message in the ring
+    static constexpr std::size_t frameHeaderSize{sizeof(std::uint32_t)};
+
+    static constexpr std::size_t headerBlockSize()
+    {
+        return ((sizeof(MailboxHeader) + alignof(SlotControl) - 1) / alignof(SlotControl)) *
+            alignof(SlotControl);
+    }
+
+    static constexpr std::size_t mailboxSize(std::uint32_t slotCount, std::uint32_t ringSize)
+    {
+        return headerBlockSize() + static_cast<std::size_t>(slotCount) * sizeof(SlotControl) +
+            static_cast<std::size_t>(slotCount) * ringSize;
+    }
+
+    static SlotControl* slotArray(void* region)
+    {
+        return reinterpret_cast<SlotControl*>(static_cast<std::byte*>(region) + headerBlockSize());
+    }
+
+    static std::byte* ringStart(void* region,
+                                std::uint32_t slotCount,
+                                std::uint32_t ringSize,
+                                std::uint32_t index)
+    {
+        return static_cast<std::byte*>(region) + headerBlockSize() +
+            static_cast<std::size_t>(slotCount) * sizeof(SlotControl) +
+            static_cast<std::size_t>(index) * ringSize;
+    }
+
+    /** copy data out of a ring handling the wrap around*/
+    static void copyFromRing(const std::byte* ring,
+                             std::uint32_t ringSize,
+                             std::uint64_t position,
+                             std::byte* dest,
+                             std::size_t count)
+    {
+        const auto offset = static_cast<std::size_t>(position & (ringSize - 1));
+        const auto first = std::min<std::size_t>(count, ringSize - offset);
+        std::memcpy(dest, ring + offset, first);
+        if (first < count) {
+            std::memcpy(dest + first, ring, count - first);
+        }
+    }
+
+    /** copy data into a ring handling the wrap around*/
+    static void copyToRing(std::byte* ring,
+                           std::uint32_t ringSize,
+                           std::uint64_t position,
+                           const std::byte* source,
+                           std::size_t count)
+    {
+        const auto offset = static_cast<std::size_t>(position & (ringSize - 1));
+        const auto first = std::min<std::size_t>(count, ringSize - offset);
+        std::memcpy(ring + offset, source, first);
+        if (first < count) {
+            std::memcpy(ring, source + first, count - first);
+        }
+    }
+
+    static void waitForSequence(std::atomic<std::uint32_t>& word,
+                                std::uint32_t expected,
+                                std::chrono::milliseconds timeout)
+    {
+#ifdef __linux__
+        timespec wait{};
+        wait.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+        wait.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+        // the futex is shared between processes so the private flag cannot be used
+        syscall(SYS_futex,
+                reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT,
+                expected,
+                &wait,
+                nullptr,
+                0);
+#else
+        // no portable cross process wait primitive so poll with a backoff
+        auto delay = std::chrono::microseconds(50);
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (word.load(std::memory_order_acquire) == expected &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(delay);
+            delay = std::min(delay * 2, std::chrono::microseconds(2000));
+        }
+#endif
+    }
+
+    static void wakeSequence(std::atomic<std::uint32_t>& word)
+    {
+#ifdef __linux__
+        syscall(SYS_futex,
+                reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE,
+                1,
+                nullptr,
+                nullptr,
+                0);
+#else
+        (void)word;
+#endif
+    }
+
+    /** check if a process is still running*/
+    static bool isProcessRunning(std::uint32_t pid)
+    {
+        if (pid == 0U || pid == abandonedSlot) {
+            return false;
+        }
+        // EPERM means the process exists but belongs to another user
+        return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+    }
+
+    static std::uint32_t roundUpPowerOf2(std::uint32_t value)
+    {
+        std::uint32_t result{minimumRingSize};
+        while (result < value && result < (1U << 30U)) {
+            result <<= 1U;
+        }
+        return result;
+    }
+
+    std::string shmObjectName(const std::string& connection)
+    {
+        std::string name = connection;
+        std::replace_if(
+            name.begin(),
+            name.end(),
+            [](auto c) { return !(std::isalnum(static_cast<unsigned char>(c)) || (c == '_')); },
+            '_');
+        name.insert(0, "/hshm_");
+        if (name.size() > maxObjectNameLength) {
+            auto hashValue = std::hash<std::string>{}(connection);
+            name = "/hshm_" + connection.substr(0, 8) + '_' + std::to_string(hashValue);
+            std::replace_if(
+                name.begin() + 1,
+                name.end(),
+                [](auto c) { return !(std::isalnum(static_cast<unsigned char>(c)) || (c == '_')); },
+                '_');
+            name.resize(std::min(name.size(), maxObjectNameLength));
+        }
+        return name;
+    }
+
+    OwnedMailbox::~OwnedMailbox()
+    {
+        close();
+    }
+
+    void OwnedMailbox::close()
+    {
+        if (region != nullptr) {
+            header->state.store(static_cast<std::uint32_t>(MailboxState::CLOSING),
+                                std::memory_order_release);
+            munmap(region, regionSize);
+            shm_unlink(objectName.c_str());
+            region = nullptr;
+            header = nullptr;
+        }
+    }
+
+    bool OwnedMailbox::connect(const std::string& connection,
+                               std::uint32_t ringSize,
+                               std::uint32_t slotCount)
+    {
+        // remove the old mailbox if are connecting again
+        close();
+        connectionName = connection;
+        objectName = shmObjectName(connection);
+        // remove any stale object from a previous run
+        shm_unlink(objectName.c_str());
+
+        ringSize = roundUpPowerOf2(ringSize);
+        slotCount = std::max(slotCount, 1U);
+        regionSize = mailboxSize(slotCount, ringSize);
+
+        int fd = shm_open(objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            errorString =
+                std::string("Unable to create shared memory mailbox:") + std::strerror(errno);
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(regionSize)) != 0) {
+            errorString =
+                std::string("Unable to size shared memory mailbox:") + std::strerror(errno);
+            ::close(fd);
+            shm_unlink(objectName.c_str());
+            return false;
+        }
+        void* mapped = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            errorString =
+                std::string("Unable to map shared memory mailbox:") + std::strerror(errno);
+            shm_unlink(objectName.c_str());
+            return false;
+        }
+        region = mapped;
+        header = new (region) MailboxHeader();
+        header->version = mailboxVersion;
+        header->slotCount = slotCount;
+        header->ringSize = ringSize;
+        header->state.store(static_cast<std::uint32_t>(MailboxState::STARTUP));
+        header->ownerPid.store(static_cast<std::uint32_t>(getpid()));
+        auto* slots = slotArray(region);
+        for (std::uint32_t ii = 0; ii < slotCount; ++ii) {
+            new (slots + ii) SlotControl();
+        }
+        assembly.clear();
+        assembly.resize(slotCount);
+        scanStart = 0;
+        lastOwnerCheck = std::chrono::steady_clock::now();
+        header->magic.store(mailboxMagic, std::memory_order_release);
+        return true;
+    }
+
+    void OwnedMailbox::changeState(MailboxState newState)
+    {
+        if (header != nullptr) {
+            header->state.store(static_cast<std::uint32_t>(newState), std::memory_order_release);
+        }
+    }
+
+    std::optional<ActionMessage> OwnedMailbox::scanSlots()
+    {
+        auto* slots = slotArray(region);
+        const auto slotCount = header->slotCount;
+        const auto ringSize = header->ringSize;
+        for (std::uint32_t scan = 0; scan < slotCount; ++scan) {
+            const auto index = (scanStart + scan) % slotCount;
+            auto& control = slots[index];
+            const auto head = control.head.load(std::memory_order_acquire);
+            auto tail = control.tail.load(std::memory_order_relaxed);
+            if (head == tail) {
+                continue;
+            }
+            const auto* ring = ringStart(region, slotCount, ringSize, index);
+            auto& partial = assembly[index];
+            while (tail != head) {
+                if (partial.headerBytes < frameHeaderSize) {
+                    const auto count = std::min<std::size_t>(frameHeaderSize - partial.headerBytes,
+                                                             head - tail);
+                    copyFromRing(ring,
+                                 ringSize,
+                                 tail,
+                                 reinterpret_cast<std::byte*>(&partial.expected) +
+                                     partial.headerBytes,
+                                 count);
+                    partial.headerBytes += static_cast<std::uint32_t>(count);
+                    tail += count;
+                    if (partial.headerBytes < frameHeaderSize) {
+                        break;
+                    }
+                    partial.data.clear();
+                    const auto offset = static_cast<std::size_t>(tail & (ringSize - 1));
+                    if (head - tail >= partial.expected &&
+                        offset + partial.expected <= ringSize) {
+                        // the full message is available and contiguous so decode in place
+                        ActionMessage cmd(ring + offset, partial.expected);
+                        tail += partial.expected;
+                        partial.headerBytes = 0;
+                        control.tail.store(tail, std::memory_order_release);
+                        scanStart = index + 1;
+                        return cmd;
+                    }
+                    partial.data.reserve(partial.expected);
+                    continue;
+                }
+                const auto count =
+                    std::min<std::size_t>(partial.expected - partial.data.size(), head - tail);
+                const auto current = partial.data.size();
+                partial.data.resize(current + count);
+                copyFromRing(ring, ringSize, tail, partial.data.data() + current, count);
+                tail += count;
+                if (partial.data.size() == partial.expected) {
+                    partial.headerBytes = 0;
+                    control.tail.store(tail, std::memory_order_release);
+                    scanStart = index + 1;
+                    return ActionMessage(partial.data.data(), partial.data.size());
+                }
+            }
+            control.tail.store(tail, std::memory_order_release);
+        }
+        return std::nullopt;
+    }
+
+    void OwnedMailbox::reclaimSlots()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (header->reclaimRequest.exchange(0U) == 0U &&
+            now - lastOwnerCheck < ownerCheckInterval) {
+            return;
+        }
+        lastOwnerCheck = now;
+        auto* slots = slotArray(region);
+        for (std::uint32_t index = 0; index < header->slotCount; ++index) {
+            auto& control = slots[index];
+            auto owner = control.owner.load(std::memory_order_acquire);
+            if (owner == 0U || (owner != abandonedSlot && isProcessRunning(owner))) {
+                continue;
+            }
+            // anything left in the ring is part of a message which will never be completed
+            control.tail.store(control.head.load(std::memory_order_acquire),
+                               std::memory_order_release);
+            assembly[index] = SlotAssembly{};
+            control.owner.compare_exchange_strong(owner, 0U);
+        }
+    }
+
+    std::optional<ActionMessage> OwnedMailbox::getMessage(int timeout)
+    {
+        if (header == nullptr) {
+            return std::nullopt;
+        }
+        auto msg = scanSlots();
+        if (!msg) {
+            reclaimSlots();
+        }
+        if (msg || timeout <= 0) {
+            return msg;
+        }
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+        while (true) {
+            const auto sequence = header->wakeSequence.load(std::memory_order_acquire);
+            header->sleeping.store(1U);
+            msg = scanSlots();
+            if (msg) {
+                header->sleeping.store(0U);
+                return msg;
+            }
+            reclaimSlots();
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                header->sleeping.store(0U);
+                return std::nullopt;
+            }
+            waitForSequence(header->wakeSequence,
+                            sequence,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now) +
+                                std::chrono::milliseconds(1));
+            header->sleeping.store(0U);
+            msg = scanSlots();
+            if (msg) {
+                return msg;
+            }
+        }
+    }
+
+    MailboxSender::~MailboxSender()
+    {
+        release();
+    }
+
+    MailboxSender::MailboxSender(MailboxSender&& other) noexcept:
+        connectionName(std::move(other.connectionName)),
+        errorString(std::move(other.errorString)), header(other.header), slot(other.slot),
+        ring(other.ring), region(other.region), regionSize(other.regionSize),
+        buffer(std::move(other.buffer)), sendTimeout(other.sendTimeout)
+    {
+        other.header = nullptr;
+        other.slot = nullptr;
+        other.ring = nullptr;
+        other.region = nullptr;
+    }
+
+    MailboxSender& MailboxSender::operator=(MailboxSender&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            connectionName = std::move(other.connectionName);
+            errorString = std::move(other.errorString);
+            header = other.header;
+            slot = other.slot;
+            ring = other.ring;
+            region = other.region;
+            regionSize = other.regionSize;
+            buffer = std::move(other.buffer);
+            sendTimeout = other.sendTimeout;
+            other.header = nullptr;
+            other.slot = nullptr;
+            other.ring = nullptr;
+            other.region = nullptr;
+        }
+        return *this;
+    }
+
+    void MailboxSender::release()
+    {
+        if (region != nullptr) {
+            if (slot != nullptr) {
+                slot->owner.store(0U, std::memory_order_release);
+            }
+            munmap(region, regionSize);
+            region = nullptr;
+            header = nullptr;
+            slot = nullptr;
+            ring = nullptr;
+        }
+    }
+
+    bool MailboxSender::connect(const std::string& connection, bool initOnly, int retries)
+    {
+        release();
+        connectionName = connection;
+        const auto objectName = shmObjectName(connection);
+        int tries = 0;
+        while (true) {
+            int fd = shm_open(objectName.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+            if (fd >= 0) {
+                struct stat info{};
+                void* mapped = MAP_FAILED;
+                if (fstat(fd, &info) == 0 &&
+                    static_cast<std::size_t>(info.st_size) >= headerBlockSize()) {
+                    mapped = mmap(nullptr,
+                                  static_cast<std::size_t>(info.st_size),
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_SHARED,
+                                  fd,
+                                  0);
+                }
+                ::close(fd);
+                if (mapped != MAP_FAILED) {
+                    auto* mheader = static_cast<MailboxHeader*>(mapped);
+                    bool goodToConnect{false};
+                    // a mailbox left behind by an owner which exited is never read
+                    if (mheader->magic.load(std::memory_order_acquire) == mailboxMagic &&
+                        mheader->version == mailboxVersion &&
+                        static_cast<std::size_t>(info.st_size) >=
+                            mailboxSize(mheader->slotCount, mheader->ringSize) &&
+                        isProcessRunning(mheader->ownerPid.load())) {
+                        switch (static_cast<MailboxState>(mheader->state.load())) {
+                            case MailboxState::STARTUP:
+                                goodToConnect = true;
+                                break;
+                            case MailboxState::OPERATING:
+                                goodToConnect = !initOnly;
+                                break;
+                            case MailboxState::CLOSING:
+                            default:
+                                break;
+                        }
+                    }
+                    if (goodToConnect) {
+                        region = mapped;
+                        regionSize = static_cast<std::size_t>(info.st_size);
+                        header = mheader;
+                        break;
+                    }
+                    munmap(mapped, static_cast<std::size_t>(info.st_size));
+                }
+            }
+            ++tries;
+            if (tries > retries) {
+                errorString = "timed out waiting for the mailbox to become available";
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        // claim a producer slot, if they are all in use ask the owner to reclaim the slots of
+        // producers which exited
+        const auto pid = static_cast<std::uint32_t>(getpid());
+        auto* slots = slotArray(region);
+        tries = 0;
+        while (true) {
+            for (std::uint32_t ii = 0; ii < header->slotCount; ++ii) {
+                std::uint32_t expected{0};
+                if (slots[ii].owner.compare_exchange_strong(expected, pid)) {
+                    slot = slots + ii;
+                    ring = ringStart(region, header->slotCount, header->ringSize, ii);
+                    return true;
+                }
+            }
+            if (tries >= retries) {
+                break;
+            }
+            ++tries;
+            header->reclaimRequest.store(1U);
+            wakeConsumer();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        errorString = "no free producer slots in mailbox";
+        munmap(region, regionSize);
+        region = nullptr;
+        header = nullptr;
+        return false;
+    }
+
+    void MailboxSender::wakeConsumer()
+    {
+        header->wakeSequence.fetch_add(1U);
+        if (header->sleeping.load() != 0U) {
+            wakeSequence(header->wakeSequence);
+        }
+    }
+
+    void MailboxSender::abandonSlot()
+    {
+        slot->owner.store(abandonedSlot, std::memory_order_release);
+        header->reclaimRequest.store(1U);
+        wakeConsumer();
+        slot = nullptr;
+        ring = nullptr;
+    }
+
+    bool MailboxSender::writeBytes(const std::byte* data, std::size_t size)
+    {
+        const auto ringSize = header->ringSize;
+        const auto totalSize = size;
+        auto head = slot->head.load(std::memory_order_relaxed);
+        int spins{0};
+        std::chrono::steady_clock::time_point deadline;
+        while (size > 0) {
+            const auto tail = slot->tail.load(std::memory_order_acquire);
+            const auto space = static_cast<std::size_t>(ringSize - (head - tail));
+            if (space == 0) {
+                if (header->state.load(std::memory_order_acquire) ==
+                    static_cast<std::uint32_t>(MailboxState::CLOSING)) {
+                    errorString = "mailbox is closing";
+                    return false;
+                }
+                if (spins == 0) {
+                    deadline = std::chrono::steady_clock::now() + sendTimeout;
+                }
+                // the consumer is behind, make sure it is awake and back off
+                wakeConsumer();
+                if (++spins < 64) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+                if (spins % 256 == 0) {
+                    if (!isProcessRunning(header->ownerPid.load())) {
+                        errorString = "mailbox owner is no longer running";
+                    } else if (std::chrono::steady_clock::now() >= deadline) {
+                        errorString = "timed out waiting for space in the mailbox";
+                    } else {
+                        continue;
+                    }
+                    if (size != totalSize) {
+                        abandonSlot();
+                    }
+                    return false;
+                }
+                continue;
+            }
+            spins = 0;
+            const auto count = std::min(space, size);
+            copyToRing(ring, ringSize, head, data, count);
+            head += count;
+            data += count;
+            size -= count;
+            slot->head.store(head, std::memory_order_release);
+            if (size > 0) {
+                // large messages are streamed so the consumer can start assembling
+                wakeConsumer();
+            }
+        }
+        wakeConsumer();
+        return true;
+    }
+
+    bool MailboxSender::sendMessage(const ActionMessage& cmd)
+    {
+        if (slot == nullptr) {
+            return false;
+        }
+        if (header->state.load(std::memory_order_acquire) ==
+            static_cast<std::uint32_t>(MailboxState::CLOSING)) {
+            errorString = "mailbox is closing";
+            return false;
+        }
+        const auto size = static_cast<std::uint32_t>(cmd.serializedByteCount());
+        buffer.resize(frameHeaderSize + size);
+        const auto written = cmd.toByteArray(buffer.data() + frameHeaderSize, size);
+        if (written < 0) {
+            errorString = "unable to serialize message";
+            return false;
+        }
+        const auto frameSize = static_cast<std::uint32_t>(written);
+        std::memcpy(buffer.data(), &frameSize, frameHeaderSize);
+        return writeBytes(buffer.data(), frameHeaderSize + static_cast<std::size_t>(written));
+    }
+}  // namespace shm
+}  // namespace helics
@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "helics/core/ActionMessage.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace helics {
+namespace shm {
+    /** the default number of independent producer slots in a mailbox
+    @details slots of producer processes which exit without releasing them are reclaimed by the
+    owner of the mailbox*/
+    constexpr std::uint32_t defaultSlotCount{128U};
+    /** the default time a sender waits for space in a mailbox before giving up*/
+    constexpr std::chrono::milliseconds defaultSendTimeout{5000};
+    /** the minimum size of the ring buffer for each slot (must be a power of 2)*/
+    constexpr std::uint32_t minimumRingSize{1U << 16U};
+
+    /** generate a valid POSIX shared memory object name from a connection name*/
+    std::string shmObjectName(const std::string& connection);
+
+    /** enumeration of mailbox states*/
+    enum class MailboxState : std::uint32_t {
+        STARTUP = 0,
+        OPERATING = 1,
+        CLOSING = 2,
+    };
+
+    /** header placed at the start of each shared memory mailbox*/
+    struct MailboxHeader {
+        /// written last by the owner to indicate the mailbox is initialized
+        std::atomic<std::uint32_t> magic{0};
+        std::uint32_t version{0};
+        std::uint32_t slotCount{0};
+        std::uint32_t ringSize{0};
+        std::atomic<std::uint32_t> state{0};
+        /// the pid of the process owning the mailbox
+        std::atomic<std::uint32_t> ownerPid{0};
+        /// set by a producer which could not find a free slot
+        std::atomic<std::uint32_t> reclaimRequest{0};
+        /// word used for futex wakeups, incremented after every write
+        std::atomic<std::uint32_t> wakeSequence{0};
+        /// set by the consumer when it is about to sleep
+        std::atomic<std::uint32_t> sleeping{0};
+    };
+
+    /** control block for a single producer/single consumer ring in a mailbox
+    @details the head is only written by the producer and the tail only by the consumer, they are
+    kept on separate cache lines to avoid false sharing*/
+    struct alignas(64) SlotControl {
+        /// 0 if the slot is free, the pid of the producing process, or abandonedSlot
+        std::atomic<std::uint32_t> owner{0};
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+    };
+
+    /** class implementing the receiving side of a mailbox, the receiver creates and owns the
+    shared memory*/
+    class OwnedMailbox {
+      private:
+        /** partially assembled message from a slot*/
+        struct SlotAssembly {
+            std::uint32_t headerBytes{0};
+            std::uint32_t expected{0};
+            std::vector<std::byte> data;
+        };
+        std::string connectionName;
+        std::string objectName;
+        std::string errorString;
+        MailboxHeader* header{nullptr};
+        void* region{nullptr};
+        std::size_t regionSize{0};
+        std::vector<SlotAssembly> assembly;
+        std::uint32_t scanStart{0};
+        std::chrono::steady_clock::time_point lastOwnerCheck;
+
+      public:
+        OwnedMailbox() = default;
+        ~OwnedMailbox();
+        OwnedMailbox(const OwnedMailbox&) = delete;
+        OwnedMailbox& operator=(const OwnedMailbox&) = delete;
+        /** create the shared memory region for the mailbox
+        @param connection the name of the connection
+        @param ringSize the size in bytes of each producer ring (rounded to a power of 2)
+        @param slotCount the maximum number of producers connected at the same time*/
+        bool connect(const std::string& connection,
+                     std::uint32_t ringSize,
+                     std::uint32_t slotCount = defaultSlotCount);
+
+        void changeState(MailboxState newState);
+        /** get a message from the mailbox waiting up to timeout milliseconds if none are
+         * available*/
+        std::optional<ActionMessage> getMessage(int timeout);
+
+        const std::string& getError() const { return errorString; }
+
+      private:
+        /** try to extract a complete message from one of the slots*/
+        std::optional<ActionMessage> scanSlots();
+        /** free the slots of producers which exited or abandoned a partially written message
+        @details only called when there are no complete messages left in any slot*/
+        void reclaimSlots();
+        void close();
+    };
+
+    /** class implementing a producer connection to a mailbox owned by another object*/
+    class MailboxSender {
+      private:
+        std::string connectionName;
+        std::string errorString;
+        MailboxHeader* header{nullptr};
+        SlotControl* slot{nullptr};
+        std::byte* ring{nullptr};
+        void* region{nullptr};
+        std::size_t regionSize{0};
+        std::vector<std::byte> buffer;  //!< storage for serialized data of the message
+        std::chrono::milliseconds sendTimeout{defaultSendTimeout};
+
+      public:
+        MailboxSender() = default;
+        ~MailboxSender();
+        MailboxSender(MailboxSender&& other) noexcept;
+        MailboxSender& operator=(MailboxSender&& other) noexcept;
+        MailboxSender(const MailboxSender&) = delete;
+        MailboxSender& operator=(const MailboxSender&) = delete;
+
+        /** connect to an existing mailbox and claim a producer slot
+        @param connection the name of the mailbox
+        @param initOnly set to true if the mailbox is required to still be in startup mode
+        @param retries the number of times to retry the connection if it is not available*/
+        bool connect(const std::string& connection, bool initOnly, int retries);
+        /** send a message through the mailbox
+        @return false if the mailbox is closed or otherwise unavailable*/
+        bool sendMessage(const ActionMessage& cmd);
+        /** set the time to wait for the receiver to make space in the mailbox
+        @details if a message times out part way through, the slot is abandoned and further sends
+        fail until the sender connects again*/
+        void setSendTimeout(std::chrono::milliseconds timeout) { sendTimeout = timeout; }
+
+        const std::string& getError() const { return errorString; }
+
+      private:
+        /** write a block of bytes to the ring waiting for space if needed*/
+        bool writeBytes(const std::byte* data, std::size_t size);
+        void wakeConsumer();
+        /** give up the slot leaving the partial message for the owner to discard*/
+        void abandonSlot();
+        void release();
+    };
+}  // namespace shm
+}  // namespace helics
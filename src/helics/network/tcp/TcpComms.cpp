@@ -7,6 +7,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "TcpComms.h"
 
 #include "../../core/ActionMessage.hpp"
+#include "../../core/flagOperations.hpp"
 #include "../NetworkBrokerData.hpp"
 #include "../networkDefaults.hpp"
 #include "TcpCommsCommon.h"
@@ -14,6 +15,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "gmlc/networking/TcpHelperClasses.h"
 #include "gmlc/networking/TcpOperations.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -41,6 +43,10 @@ void TcpComms::loadNetworkInfo(const NetworkBrokerData& netInfo)
     }
     reuse_address = netInfo.reuse_address;
     encryption_config = netInfo.encryptionConfig;
+    batchTransmit = netInfo.batchTransmit;
+    maxBatchSize = netInfo.maxBatchSize;
+    batchLinger = std::chrono::milliseconds(netInfo.batchLingerTime);
+    compactEncoding = netInfo.compactEncoding;
     propertyUnLock();
 }
 
@@ -51,6 +57,16 @@ void TcpComms::setFlag(std::string_view flag, bool val)
             reuse_address = val;
             propertyUnLock();
         }
+    } else if (flag == "batch_transmit") {
+        if (propertyLock()) {
+            batchTransmit = val;
+            propertyUnLock();
+        }
+    } else if (flag == "compact_encoding") {
+        if (propertyLock()) {
+            compactEncoding = val;
+            propertyUnLock();
+        }
     } else if (flag == "encrypted") {
         if (propertyLock()) {
             encrypted = val;
@@ -82,14 +98,16 @@ int TcpComms::processIncomingMessage(ActionMessage&& cmd)
 }
 
 size_t TcpComms::dataReceive(gmlc::networking::TcpConnection* connection,
+                             CompactMessageDecoder& decoder,
                              const char* data,
                              size_t bytes_received)
 {
     size_t used_total = 0;
     while (used_total < bytes_received) {
         ActionMessage m;
-        auto used = m.depacketize(reinterpret_cast<const std::byte*>(data) + used_total,
-                                  bytes_received - used_total);
+        auto used = decoder.depacketize(reinterpret_cast<const std::byte*>(data) + used_total,
+                                        bytes_received - used_total,
+                                        m);
         if (used == 0) {
             break;
         }
@@ -98,6 +116,10 @@ size_t TcpComms::dataReceive(gmlc::networking::TcpConnection* connection,
             // forward the original message on to the receiver to handle
             auto rep = generateReplyToIncomingMessage(m);
             if (rep.action() != CMD_IGNORE) {
+                if (checkActionFlag(m, compact_encoding_flag)) {
+                    // this comms can decode the compact encoding on any connection
+                    setActionFlag(rep, compact_encoding_flag);
+                }
                 try {
                     connection->send(rep.packetize());
                 }
@@ -173,10 +195,14 @@ void TcpComms::queue_rx_function()
         }
     }
     auto contextLoop = ioctx->startContextLoop();
-    server->setDataCall(
-        [this](const TcpConnection::pointer& connection, const char* data, size_t datasize) {
-            return dataReceive(connection.get(), data, datasize);
-        });
+    // the server copies the callback into each accepted connection so every connection gets its
+    // own decoder, which lives and dies with the connection; calls for a connection are sequential
+    server->setDataCall([this, decoder = CompactMessageDecoder{}](
+                            const TcpConnection::pointer& connection,
+                            const char* data,
+                            size_t datasize) mutable {
+        return dataReceive(connection.get(), decoder, data, datasize);
+    });
     CommsInterface* ci = this;
     server->setErrorCall(
         [ci](const TcpConnection::pointer& connection, const std::error_code& error) {
@@ -298,6 +324,9 @@ bool TcpComms::establishBrokerConnection(
             m.messageID = (PortNumber <= 0) ? REQUEST_PORTS : CONNECTION_REQUEST;
 
             m.setStringData(brokerName, brokerInitString);
+            if (compactEncoding) {
+                setActionFlag(m, compact_encoding_flag);
+            }
             try {
                 brokerConnection->send(m.packetize());
             }
@@ -320,6 +349,11 @@ bool TcpComms::establishBrokerConnection(
             auto mess = txQueue.pop(popTimeout);
             if (mess) {
                 if (isProtocolCommand(mess->second)) {
+                    if (mess->second.messageID == PORT_DEFINITIONS ||
+                        mess->second.messageID == CONNECTION_ACK) {
+                        brokerCompactEncoding =
+                            compactEncoding && checkActionFlag(mess->second, compact_encoding_flag);
+                    }
                     if (mess->second.messageID == PORT_DEFINITIONS) {
                         if (PortNumber <= 0) {
                             rxMessageQueue.push(mess->second);
@@ -339,6 +373,8 @@ bool TcpComms::establishBrokerConnection(
                     if (mess->second.messageID == NEW_BROKER_INFORMATION) {
                         logMessage("got new broker information");
                         brokerConnection->close();
+                        brokerCompactEncoding = false;
+                        brokerEncoder.reset();
 
                         auto brkprt =
                             gmlc::networking::extractInterfaceAndPort(mess->second.getString(0));
@@ -387,9 +423,40 @@ bool TcpComms::establishBrokerConnection(
     return true;
 }
 
+namespace {
+    /** structure containing the accumulated data for a single connection in a batched
+     * transmission*/
+    struct TxBatchBuffer {
+        TcpConnection* connection{nullptr};  //!< the connection to send the data on
+        route_id rid;  //!< the route id used for error reporting
+        bool brokerRoute{false};  //!< the connection is the broker connection
+        bool disconnectOnly{true};  //!< all the messages in the buffer are disconnect commands
+        action_message_def::action_t lastAction{CMD_IGNORE};  //!< the last action in the buffer
+        std::string data;  //!< the packetized message data
+    };
+}  // namespace
+
+void TcpComms::collectTransmitBatch(std::vector<std::pair<route_id, ActionMessage>>& batch)
+{
+    const auto deadline = std::chrono::steady_clock::now() + batchLinger;
+    while (static_cast<int>(batch.size()) < maxBatchSize) {
+        auto next = txQueue.try_pop();
+        if (!next && batchLinger.count() > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() > 0) {
+                next = txQueue.pop(remaining);
+            }
+        }
+        if (!next) {
+            break;
+        }
+        batch.push_back(std::move(*next));
+    }
+}
+
 void TcpComms::queue_tx_function()
 {
-    // std::vector<char> buffer;
     auto ioctx = gmlc::networking::AsioContextManager::getContextPointer();
     auto sf = encrypted ? gmlc::networking::SocketFactory(encryption_config) :
                           gmlc::networking::SocketFactory();
@@ -418,114 +485,149 @@ void TcpComms::queue_tx_function()
     }
     setTxStatus(ConnectionStatus::CONNECTED);
 
-    //  std::vector<ActionMessage> txlist;
-    bool processing{true};
-    while (processing) {
-        route_id rid;
-        ActionMessage cmd;
-
-        std::tie(rid, cmd) = txQueue.pop();
-        bool processed = false;
-        if (isProtocolCommand(cmd)) {
-            if (rid == control_route) {
-                switch (cmd.messageID) {
-                    case NEW_ROUTE: {
-                        std::string newroute(cmd.payload.to_string());
+    std::vector<std::pair<route_id, ActionMessage>> batch;
+    // the buffers are reused across batches to avoid reallocation
+    std::vector<TxBatchBuffer> txBuffers;
+    std::size_t activeBuffers{0};
+    std::string packet;
 
-                        try {
-                            std::string interface;
-                            std::string port;
-                            std::tie(interface, port) =
-                                gmlc::networking::extractInterfaceAndPortString(newroute);
-                            auto new_connect =
-                                TcpConnection::create(sf, ioctx->getBaseContext(), interface, port);
-
-                            routes.emplace(route_id{cmd.getExtraData()}, std::move(new_connect));
-                        }
-                        catch (std::exception& e) {
-                            logWarning(std::string("unable to create route ") + newroute +
-                                       "::" + e.what());
-                        }
-                        processed = true;
-                    } break;
-                    case REMOVE_ROUTE:
-                        routes.erase(route_id{cmd.getExtraData()});
-                        processed = true;
-                        break;
-                    case CLOSE_RECEIVER:
-                        rxMessageQueue.push(cmd);
-                        processed = true;
-                        break;
-                    case DISCONNECT:
-                        processing = false;
-                        processed = true;
-                        break;
+    auto flushBuffers = [&]() {
+        for (std::size_t ii = 0; ii < activeBuffers; ++ii) {
+            auto& buffer = txBuffers[ii];
+            try {
+                buffer.connection->send(buffer.data);
+            }
+            catch (const std::system_error& se) {
+                if (se.code() != asio::error::connection_aborted && !buffer.disconnectOnly) {
+                    if (buffer.brokerRoute) {
+                        logError(std::string("broker send ") +
+                                 std::to_string(buffer.rid.baseValue()) + ' ' +
+                                 actionMessageType(buffer.lastAction) + "::" + se.what());
+                    } else {
+                        logError(std::string("rt send ") + std::to_string(buffer.rid.baseValue()) +
+                                 "::" + se.what());
+                    }
                 }
             }
+            buffer.data.clear();
+        }
+        activeBuffers = 0;
+    };
+
+    auto addToBuffer = [&](TcpConnection* connection,
+                           route_id rid,
+                           bool brokerRoute,
+                           const ActionMessage& cmd) {
+        std::size_t index{0};
+        while (index < activeBuffers && txBuffers[index].connection != connection) {
+            ++index;
+        }
+        if (index == activeBuffers) {
+            if (activeBuffers == txBuffers.size()) {
+                txBuffers.emplace_back();
+            }
+            auto& buffer = txBuffers[activeBuffers++];
+            buffer.connection = connection;
+            buffer.rid = rid;
+            buffer.brokerRoute = brokerRoute;
+            buffer.disconnectOnly = true;
         }
-        if (processed) {
-            continue;
+        auto& buffer = txBuffers[index];
+        if (brokerRoute && brokerCompactEncoding) {
+            brokerEncoder.packetize(cmd, packet);
+        } else {
+            cmd.packetize(packet);
+        }
+        buffer.data.append(packet);
+        buffer.lastAction = cmd.action();
+        if (!isDisconnectCommand(cmd)) {
+            buffer.disconnectOnly = false;
         }
+    };
 
-        if (rid == parent_route_id) {
-            if (hasBroker) {
-                try {
-                    brokerConnection->send(cmd.packetize());
-                }
-                catch (const std::system_error& se) {
-                    if (se.code() != asio::error::connection_aborted) {
-                        if (!isDisconnectCommand(cmd)) {
-                            logError(std::string("broker send 0 ") +
-                                     actionMessageType(cmd.action()) + ':' + se.what());
-                        }
-                    }
-                }
+    bool processing{true};
+    while (processing) {
+        batch.clear();
+        batch.push_back(txQueue.pop());
+        if (batchTransmit) {
+            collectTransmitBatch(batch);
+        }
+        for (auto& [rid, cmd] : batch) {
+            bool processed = false;
+            if (isProtocolCommand(cmd)) {
+                if (rid == control_route) {
+                    // route modifications and shutdown must happen after all previous messages
+                    // have been transmitted
+                    flushBuffers();
+                    switch (cmd.messageID) {
+                        case NEW_ROUTE: {
+                            std::string newroute(cmd.payload.to_string());
+
+                            try {
+                                std::string interface;
+                                std::string port;
+                                std::tie(interface, port) =
+                                    gmlc::networking::extractInterfaceAndPortString(newroute);
+                                auto new_connect = TcpConnection::create(sf,
+                                                                         ioctx->getBaseContext(),
+                                                                         interface,
+                                                                         port);
 
-                // if (error)
-                {
-                    //     std::cerr << "transmit failure to broker " << error.message() <<
-                    //     '\n';
+                                routes.emplace(route_id{cmd.getExtraData()},
+                                               std::move(new_connect));
+                            }
+                            catch (std::exception& e) {
+                                logWarning(std::string("unable to create route ") + newroute +
+                                           "::" + e.what());
+                            }
+                            processed = true;
+                        } break;
+                        case REMOVE_ROUTE:
+                            routes.erase(route_id{cmd.getExtraData()});
+                            processed = true;
+                            break;
+                        case CLOSE_RECEIVER:
+                            rxMessageQueue.push(cmd);
+                            processed = true;
+                            break;
+                        case DISCONNECT:
+                            processing = false;
+                            processed = true;
+                            break;
+                    }
                 }
             }
-        } else if (rid == control_route) {  // send to rx thread loop
-            rxMessageQueue.push(cmd);
-        } else {
-            //  txlist.push_back(cmd);
-            auto rt_find = routes.find(rid);
-            if (rt_find != routes.end()) {
-                try {
-                    rt_find->second->send(cmd.packetize());
-                }
-                catch (const std::system_error& se) {
-                    if (se.code() != asio::error::connection_aborted) {
-                        if (!isDisconnectCommand(cmd)) {
-                            logError(std::string("rt send ") + std::to_string(rid.baseValue()) +
-                                     "::" + se.what());
-                        }
-                    }
+            if (!processing) {
+                break;
+            }
+            if (processed) {
+                continue;
+            }
+
+            if (rid == parent_route_id) {
+                if (hasBroker) {
+                    addToBuffer(brokerConnection.get(), rid, true, cmd);
                 }
+            } else if (rid == control_route) {  // send to rx thread loop
+                rxMessageQueue.push(cmd);
             } else {
-                if (hasBroker) {
-                    try {
-                        brokerConnection->send(cmd.packetize());
-                    }
-                    catch (const std::system_error& se) {
-                        if (se.code() != asio::error::connection_aborted) {
-                            if (!isDisconnectCommand(cmd)) {
-                                logError(std::string("broker send") +
-                                         std::to_string(rid.baseValue()) + " ::" + se.what());
-                            }
-                        }
-                    }
+                auto rt_find = routes.find(rid);
+                if (rt_find != routes.end()) {
+                    addToBuffer(rt_find->second.get(), rid, false, cmd);
                 } else {
-                    if (!isDisconnectCommand(cmd)) {
-                        logWarning(
-                            std::string("(tcp) unknown message destination message dropped ") +
-                            prettyPrintString(cmd));
+                    if (hasBroker) {
+                        addToBuffer(brokerConnection.get(), rid, true, cmd);
+                    } else {
+                        if (!isDisconnectCommand(cmd)) {
+                            logWarning(
+                                std::string("(tcp) unknown message destination message dropped ") +
+                                prettyPrintString(cmd));
+                        }
                     }
                 }
             }
         }
+        flushBuffers();
     }
     for (auto& rt : routes) {
         rt.second->close();
@@ -6,13 +6,17 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #pragma once
 
+#include "../../core/ActionMessageCodec.hpp"
 #include "../NetworkCommsInterface.hpp"
 #include "gmlc/containers/BlockingQueue.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace gmlc::networking {
 class AsioContextManager;
@@ -35,6 +39,14 @@ class TcpComms final: public NetworkCommsInterface {
 
   private:
     bool reuse_address{false};
+    bool batchTransmit{false};  //!< combine queued messages into a single send per connection
+    int maxBatchSize{64};  //!< the maximum number of messages to include in a batch
+    std::chrono::milliseconds batchLinger{0};  //!< max time to wait for a batch to fill
+    bool compactEncoding{false};  //!< request the compact encoding on the broker connection
+    /// the broker connection negotiated the compact encoding (only used by the tx thread)
+    bool brokerCompactEncoding{false};
+    /// encoder with the intern table for the broker connection
+    CompactMessageEncoder brokerEncoder{true};
     std::string encryption_config;
     virtual int getDefaultBrokerPort() const override;
     virtual void queue_rx_function() override;  //!< the functional loop for the receive queue
@@ -42,6 +54,10 @@ class TcpComms final: public NetworkCommsInterface {
 
     virtual void closeReceiver() override;  //!< function to instruct the receiver loop to close
 
+    /** gather additional queued messages into a transmission batch
+    @details stops when the queue is empty and the linger time has expired or the batch is full*/
+    void collectTransmitBatch(std::vector<std::pair<route_id, ActionMessage>>& batch);
+
     /** make the initial connection to a broker and get setup information*/
     bool establishBrokerConnection(
         std::shared_ptr<gmlc::networking::AsioContextManager>& ioctx,
@@ -56,11 +72,13 @@ return code for required action 0=NONE, -1 TERMINATE*/
 
     /** callback function for receiving data asynchronously from the socket
 @param connection pointer to the connection
+@param decoder the decoder holding the intern table for the connection
 @param data the pointer to the data
 @param bytes_received the length of the received data
 @return a the number of bytes used by the function
 */
     size_t dataReceive(gmlc::networking::TcpConnection* connection,
+                       CompactMessageDecoder& decoder,
                        const char* data,
                        size_t bytes_received);
 
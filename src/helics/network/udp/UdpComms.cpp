@@ -9,16 +9,29 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../../core/ActionMessage.hpp"
 #include "../NetworkBrokerData.hpp"
 #include "../networkDefaults.hpp"
+#include "UdpDatagram.h"
 #include "gmlc/networking/AsioContextManager.h"
 
+#include <algorithm>
+#include <array>
 #include <asio/ip/udp.hpp>
+#include <cerrno>
+#include <chrono>
 #include <fmt/format.h>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#ifdef __linux__
+#    include <sys/socket.h>
+#    include <sys/uio.h>
+#endif
+
 namespace helics::udp {
 using asio::ip::udp;
 UdpComms::UdpComms(): NetworkCommsInterface(gmlc::networking::InterfaceTypes::UDP)
@@ -41,7 +54,10 @@ void UdpComms::loadNetworkInfo(const NetworkBrokerData& netInfo)
 
     promisePort = std::promise<int>();
     futurePort = promisePort.get_future();
-
+    batchTransmit = netInfo.batchTransmit;
+    maxBatchSize = netInfo.maxBatchSize;
+    batchLinger = std::chrono::milliseconds(netInfo.batchLingerTime);
+    maxDatagram = static_cast<std::size_t>(netInfo.maxDatagramSize);
     propertyUnLock();
 }
 /** destructor*/
@@ -55,6 +71,58 @@ static inline auto udpnet(gmlc::networking::InterfaceNetworks net)
     return (net != gmlc::networking::InterfaceNetworks::IPV6) ? udp::v4() : udp::v6();
 }
 
+/// the time to wait for an acknowledgement of a reliable datagram before retransmitting
+static constexpr std::chrono::milliseconds ackTimeout{50};
+/// the number of datagrams to send or receive in a single system call
+static constexpr std::size_t datagramGroupSize{16};
+
+/** transmit a set of datagrams, grouped into sendmmsg calls where available
+@return the last error encountered*/
+static std::error_code sendDatagrams(udp::socket& socket, const std::vector<Datagram>& datagrams)
+{
+    std::error_code lastError;
+#ifdef __linux__
+    std::array<mmsghdr, datagramGroupSize> headers{};
+    std::array<iovec, datagramGroupSize> vectors{};
+    std::size_t position{0};
+    while (position < datagrams.size()) {
+        const auto group = std::min(datagramGroupSize, datagrams.size() - position);
+        for (std::size_t ii = 0; ii < group; ++ii) {
+            const auto& datagram = datagrams[position + ii];
+            vectors[ii].iov_base = const_cast<char*>(datagram.data.data());
+            vectors[ii].iov_len = datagram.data.size();
+            headers[ii] = mmsghdr{};
+            headers[ii].msg_hdr.msg_name = const_cast<sockaddr*>(datagram.destination.data());
+            headers[ii].msg_hdr.msg_namelen = static_cast<socklen_t>(datagram.destination.size());
+            headers[ii].msg_hdr.msg_iov = &vectors[ii];
+            headers[ii].msg_hdr.msg_iovlen = 1;
+        }
+        auto sent = ::sendmmsg(socket.native_handle(),
+                               headers.data(),
+                               static_cast<unsigned int>(group),
+                               0);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            lastError = std::error_code(errno, std::system_category());
+            // skip the datagram that failed and continue with the rest
+            sent = 1;
+        }
+        position += static_cast<std::size_t>(sent);
+    }
+#else
+    std::error_code error;
+    for (const auto& datagram : datagrams) {
+        socket.send_to(asio::buffer(datagram.data), datagram.destination, 0, error);
+        if (error) {
+            lastError = error;
+        }
+    }
+#endif
+    return lastError;
+}
+
 void UdpComms::queue_rx_function()
 {
     using gmlc::networking::makePortAddress;
@@ -125,42 +193,129 @@ void UdpComms::queue_rx_function()
         }
     }
 
-    std::vector<char> data(10192);
+    // batched datagrams from other comms can be up to the maximum udp payload even if this comms
+    // does not batch its own transmissions
+    std::vector<char> data(maxDatagramSize);
     udp::endpoint remote_endp;
     std::error_code error;
     std::error_code ignored_error;
-    setRxStatus(ConnectionStatus::CONNECTED);
-    while (true) {
-        auto len = socket.receive_from(asio::buffer(data), remote_endp, 0, error);
-        if (error) {
-            setRxStatus(ConnectionStatus::ERRORED);
-            return;
-        }
-        if (len == 5) {
-            const std::string_view str(data.data(), len);
-            if (str == "close") {
-                break;
-            }
-        }
-        ActionMessage cmd(reinterpret_cast<std::byte*>(data.data()), len);
+    DatagramAssembler assembler;
+    std::vector<ActionMessage> received;
+    std::vector<std::pair<udp::endpoint, std::vector<std::uint32_t>>> acks;
+
+    // returns false if the receiver should stop
+    auto processMessage = [&](ActionMessage& cmd, const udp::endpoint& source) {
         if (!isValidCommand(cmd)) {
             logWarning("invalid command received udp");
-            continue;
+            return true;
         }
         if (isProtocolCommand(cmd)) {
             if (cmd.messageID == CLOSE_RECEIVER) {
-                break;
+                return false;
             }
             auto reply = generateReplyToIncomingMessage(cmd);
             if (reply.messageID == DISCONNECT) {
-                break;
+                return false;
             }
             if (reply.action() != CMD_IGNORE) {
-                socket.send_to(asio::buffer(reply.to_string()), remote_endp, 0, ignored_error);
+                socket.send_to(asio::buffer(reply.to_string()), source, 0, ignored_error);
             }
         } else {
             ActionCallback(std::move(cmd));
         }
+        return true;
+    };
+    // returns false if the receiver should stop
+    auto processDatagram = [&](const char* buffer, std::size_t len, const udp::endpoint& source) {
+        if (len == 5) {
+            const std::string_view str(buffer, len);
+            if (str == "close") {
+                return false;
+            }
+        }
+        if (!isBatchDatagram(buffer, len)) {
+            ActionMessage cmd(buffer, len);
+            return processMessage(cmd, source);
+        }
+        auto ack = assembler.process(source, buffer, len, received);
+        if (ack) {
+            auto fnd = std::find_if(acks.begin(), acks.end(), [&source](const auto& sourceAcks) {
+                return sourceAcks.first == source;
+            });
+            if (fnd == acks.end()) {
+                fnd = acks.emplace(acks.end(), source, std::vector<std::uint32_t>{});
+            }
+            fnd->second.push_back(*ack);
+        }
+        bool keepReceiving{true};
+        for (auto& cmd : received) {
+            if (keepReceiving) {
+                keepReceiving = processMessage(cmd, source);
+            }
+        }
+        received.clear();
+        return keepReceiving;
+    };
+    auto sendAcks = [&]() {
+        for (const auto& sourceAcks : acks) {
+            socket.send_to(asio::buffer(generateAckDatagram(sourceAcks.second)),
+                           sourceAcks.first,
+                           0,
+                           ignored_error);
+        }
+        acks.clear();
+    };
+
+    setRxStatus(ConnectionStatus::CONNECTED);
+    bool receiving{true};
+#ifdef __linux__
+    if (batchTransmit) {
+        // receive groups of datagrams with a single system call, each datagram has its own
+        // section of the buffer
+        data.resize(datagramGroupSize * maxDatagramSize);
+        std::array<mmsghdr, datagramGroupSize> headers{};
+        std::array<iovec, datagramGroupSize> vectors{};
+        std::array<udp::endpoint, datagramGroupSize> sources;
+        while (receiving) {
+            for (std::size_t ii = 0; ii < datagramGroupSize; ++ii) {
+                vectors[ii].iov_base = data.data() + ii * maxDatagramSize;
+                vectors[ii].iov_len = maxDatagramSize;
+                headers[ii] = mmsghdr{};
+                headers[ii].msg_hdr.msg_name = sources[ii].data();
+                headers[ii].msg_hdr.msg_namelen = static_cast<socklen_t>(sources[ii].capacity());
+                headers[ii].msg_hdr.msg_iov = &vectors[ii];
+                headers[ii].msg_hdr.msg_iovlen = 1;
+            }
+            auto count = ::recvmmsg(socket.native_handle(),
+                                    headers.data(),
+                                    static_cast<unsigned int>(datagramGroupSize),
+                                    MSG_WAITFORONE,
+                                    nullptr);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                setRxStatus(ConnectionStatus::ERRORED);
+                return;
+            }
+            for (int ii = 0; ii < count && receiving; ++ii) {
+                sources[ii].resize(headers[ii].msg_hdr.msg_namelen);
+                receiving = processDatagram(data.data() + ii * maxDatagramSize,
+                                            headers[ii].msg_len,
+                                            sources[ii]);
+            }
+            sendAcks();
+        }
+    }
+#endif
+    while (receiving) {
+        auto len = socket.receive_from(asio::buffer(data), remote_endp, 0, error);
+        if (error) {
+            setRxStatus(ConnectionStatus::ERRORED);
+            return;
+        }
+        receiving = processDatagram(data.data(), len, remote_endp);
+        sendAcks();
     }
     disconnecting = true;
     setRxStatus(ConnectionStatus::TERMINATED);
@@ -348,107 +503,211 @@ void UdpComms::queue_tx_function()
     }
 
     setTxStatus(ConnectionStatus::CONNECTED);
-    bool continueProcessing{true};
-    while (continueProcessing) {
-        route_id rid;
-        ActionMessage cmd;
-
-        std::tie(rid, cmd) = txQueue.pop();
-        bool processed = false;
-        if (isProtocolCommand(cmd)) {
-            if (rid == control_route) {
-                switch (cmd.messageID) {
-                    case NEW_ROUTE: {
-                        try {
-                            const std::string newroute(cmd.payload.to_string());
-                            std::string interface;
-                            std::string port;
-                            std::tie(interface, port) =
-                                gmlc::networking::extractInterfaceAndPortString(newroute);
-                            const udp::resolver::query queryNew(udpnet(interfaceNetwork),
-                                                                interface,
-                                                                port);
+    DatagramBatcher batcher(maxDatagram);
+    RetransmitTracker tracker(ackTimeout, maxRetries);
+    std::vector<std::pair<route_id, ActionMessage>> batch;
+    std::vector<Datagram> resend;
+    std::vector<std::uint32_t> acknowledged;
+    std::vector<char> ackBuffer(2048);
+    std::string buffer;
 
-                            routes.emplace(route_id{cmd.getExtraData()},
-                                           *resolver.resolve(queryNew));
-                        }
-                        catch (const std::exception& err) {
-                            logError(fmt::format("unable to resolve new route: {}", err.what()));
-                        }
-                        processed = true;
-                    } break;
-                    case REMOVE_ROUTE:
-                        routes.erase(route_id{cmd.getExtraData()});
-                        processed = true;
-                        break;
-                    case CLOSE_RECEIVER:
-                        transmitSocket.send_to(asio::buffer(cmd.to_string()), rxEndpoint, 0, error);
-                        if (error) {
-                            logError(
-                                fmt::format("transmit failure on sending 'close' to receiver  {}",
-                                            error.message()));
-                        }
-                        closingRx = true;
-                        processed = true;
-                        break;
-                    case DISCONNECT:
-                        continueProcessing = false;
-                        processed = true;
-                        break;
-                    default:
-                        break;
-                }
+    // send a message immediately or add it to the datagram for the destination
+    auto sendMessage = [&](const udp::endpoint& destination, const ActionMessage& cmd) {
+        std::error_code sendError;
+        if (batchTransmit) {
+            try {
+                batcher.add(destination, cmd);
             }
+            catch (const std::invalid_argument& err) {
+                logWarning(fmt::format("(udp) {}, message dropped {}",
+                                       err.what(),
+                                       prettyPrintString(cmd)));
+            }
+            return sendError;
         }
-        if (processed) {
-            continue;
+        cmd.to_string(buffer);
+        transmitSocket.send_to(asio::buffer(buffer), destination, 0, sendError);
+        return sendError;
+    };
+    auto transmitBatch = [&]() {
+        auto& ready = batcher.flush();
+        if (ready.empty()) {
+            return;
         }
-
-        if (rid == parent_route_id) {
-            if (hasBroker) {
-                transmitSocket.send_to(asio::buffer(cmd.to_string()), broker_endpoint, 0, error);
-                if (error) {
-                    logWarning(
-                        fmt::format("transmit failure sending to broker  {}", error.message()));
+        auto sendError = sendDatagrams(transmitSocket, ready);
+        if (sendError) {
+            logWarning(
+                fmt::format("transmit failure sending batched datagrams {}", sendError.message()));
+        }
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& datagram : ready) {
+            if (datagram.reliable) {
+                tracker.track(datagram, now);
+            }
+        }
+        ready.clear();
+    };
+    // read the acknowledgements from the receivers and retransmit any overdue datagrams
+    auto processAcknowledgements = [&]() {
+        std::error_code ackError;
+        while (transmitSocket.available(ackError) > 0 && !ackError) {
+            udp::endpoint source;
+            auto len = transmitSocket.receive_from(asio::buffer(ackBuffer), source, 0, ackError);
+            if (ackError) {
+                break;
+            }
+            acknowledged.clear();
+            if (readAckDatagram(ackBuffer.data(), len, acknowledged)) {
+                for (auto sequence : acknowledged) {
+                    tracker.acknowledge(sequence);
                 }
-            } else {
-                logWarning(fmt::format(
-                    "message directed to broker of comm system with no broker, message dropped {}",
-                    prettyPrintString(cmd)));
             }
-        } else if (rid == control_route) {  // send to rx thread loop
-            transmitSocket.send_to(asio::buffer(cmd.to_string()), rxEndpoint, 0, error);
-            if (error) {
-                logWarning(fmt::format("transmit failure sending control message to receiver  {}",
-                                       error.message()));
+        }
+        resend.clear();
+        auto dropped = tracker.collectExpired(std::chrono::steady_clock::now(), resend);
+        if (!resend.empty()) {
+            auto sendError = sendDatagrams(transmitSocket, resend);
+            if (sendError) {
+                logWarning(fmt::format("transmit failure retransmitting datagrams {}",
+                                       sendError.message()));
             }
+        }
+        if (dropped > 0) {
+            logWarning(fmt::format("(udp) {} datagrams were not acknowledged after {} retries",
+                                   dropped,
+                                   maxRetries));
+        }
+    };
+
+    bool continueProcessing{true};
+    while (continueProcessing) {
+        batch.clear();
+        if (!batchTransmit || tracker.empty()) {
+            batch.push_back(txQueue.pop());
         } else {
-            auto rt_find = routes.find(rid);
-            if (rt_find != routes.end()) {
-                transmitSocket.send_to(asio::buffer(cmd.to_string()), rt_find->second, 0, error);
-                if (error) {
-                    logWarning(fmt::format("transmit failure sending to route {}:{}",
-                                           rid.baseValue(),
-                                           error.message()));
+            // wake up in time to retransmit anything which has not been acknowledged
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                tracker.nextDeadline() - std::chrono::steady_clock::now());
+            auto next = txQueue.pop(std::max(wait, std::chrono::milliseconds(1)));
+            if (next) {
+                batch.push_back(std::move(*next));
+            }
+        }
+        if (batchTransmit && !batch.empty()) {
+            collectTransmitBatch(batch);
+        }
+        for (auto& [rid, cmd] : batch) {
+            bool processed = false;
+            if (isProtocolCommand(cmd)) {
+                if (rid == control_route) {
+                    switch (cmd.messageID) {
+                        case NEW_ROUTE: {
+                            try {
+                                const std::string newroute(cmd.payload.to_string());
+                                std::string interface;
+                                std::string port;
+                                std::tie(interface, port) =
+                                    gmlc::networking::extractInterfaceAndPortString(newroute);
+                                const udp::resolver::query queryNew(udpnet(interfaceNetwork),
+                                                                    interface,
+                                                                    port);
+
+                                routes.emplace(route_id{cmd.getExtraData()},
+                                               *resolver.resolve(queryNew));
+                            }
+                            catch (const std::exception& err) {
+                                logError(
+                                    fmt::format("unable to resolve new route: {}", err.what()));
+                            }
+                            processed = true;
+                        } break;
+                        case REMOVE_ROUTE:
+                            routes.erase(route_id{cmd.getExtraData()});
+                            processed = true;
+                            break;
+                        case CLOSE_RECEIVER:
+                            error = sendMessage(rxEndpoint, cmd);
+                            if (error) {
+                                logError(fmt::format(
+                                    "transmit failure on sending 'close' to receiver  {}",
+                                    error.message()));
+                            }
+                            closingRx = true;
+                            processed = true;
+                            break;
+                        case DISCONNECT:
+                            continueProcessing = false;
+                            processed = true;
+                            break;
+                        default:
+                            break;
+                    }
                 }
-            } else {
+            }
+            if (!continueProcessing) {
+                break;
+            }
+            if (processed) {
+                continue;
+            }
+
+            if (rid == parent_route_id) {
                 if (hasBroker) {
-                    transmitSocket.send_to(asio::buffer(cmd.to_string()),
-                                           broker_endpoint,
-                                           0,
-                                           error);
+                    error = sendMessage(broker_endpoint, cmd);
                     if (error) {
                         logWarning(
                             fmt::format("transmit failure sending to broker  {}", error.message()));
                     }
                 } else {
-                    if (!isDisconnectCommand(cmd)) {
-                        logWarning(std::string("(udp) unknown route, message dropped ") +
-                                   prettyPrintString(cmd));
+                    logWarning(fmt::format("message directed to broker of comm system with no "
+                                           "broker, message dropped {}",
+                                           prettyPrintString(cmd)));
+                }
+            } else if (rid == control_route) {  // send to rx thread loop
+                error = sendMessage(rxEndpoint, cmd);
+                if (error) {
+                    logWarning(
+                        fmt::format("transmit failure sending control message to receiver  {}",
+                                    error.message()));
+                }
+            } else {
+                auto rt_find = routes.find(rid);
+                if (rt_find != routes.end()) {
+                    error = sendMessage(rt_find->second, cmd);
+                    if (error) {
+                        logWarning(fmt::format("transmit failure sending to route {}:{}",
+                                               rid.baseValue(),
+                                               error.message()));
+                    }
+                } else {
+                    if (hasBroker) {
+                        error = sendMessage(broker_endpoint, cmd);
+                        if (error) {
+                            logWarning(fmt::format("transmit failure sending to broker  {}",
+                                                   error.message()));
+                        }
+                    } else {
+                        if (!isDisconnectCommand(cmd)) {
+                            logWarning(std::string("(udp) unknown route, message dropped ") +
+                                       prettyPrintString(cmd));
+                        }
                     }
                 }
             }
         }
+        if (batchTransmit) {
+            transmitBatch();
+            processAcknowledgements();
+        }
+    }
+    if (batchTransmit) {
+        // give the final control messages a short time to be acknowledged, the receivers may
+        // already be gone so the wait is bounded
+        const auto drainEnd = std::chrono::steady_clock::now() + 4 * ackTimeout;
+        while (!tracker.empty() && std::chrono::steady_clock::now() < drainEnd) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            processAcknowledgements();
+        }
     }
     routes.clear();
     if (getRxStatus() == ConnectionStatus::CONNECTED) {
@@ -478,6 +737,25 @@ void UdpComms::queue_tx_function()
     setTxStatus(ConnectionStatus::TERMINATED);
 }
 
+void UdpComms::collectTransmitBatch(std::vector<std::pair<route_id, ActionMessage>>& batch)
+{
+    const auto deadline = std::chrono::steady_clock::now() + batchLinger;
+    while (static_cast<int>(batch.size()) < maxBatchSize) {
+        auto next = txQueue.try_pop();
+        if (!next && batchLinger.count() > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (remaining.count() > 0) {
+                next = txQueue.pop(remaining);
+            }
+        }
+        if (!next) {
+            break;
+        }
+        batch.push_back(std::move(*next));
+    }
+}
+
 void UdpComms::closeReceiver()
 {
     if (getTxStatus() == ConnectionStatus::CONNECTED) {
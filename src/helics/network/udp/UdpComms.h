@@ -9,8 +9,11 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "../NetworkCommsInterface.hpp"
 #include "helics/helics-config.h"
 
+#include <chrono>
 #include <future>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace helics::udp {
 /** implementation for the communication interface that uses ZMQ messages to communicate*/
@@ -24,11 +27,19 @@ class UdpComms final: public NetworkCommsInterface {
     virtual void loadNetworkInfo(const NetworkBrokerData& netInfo) override;
 
   private:
+    bool batchTransmit{false};  //!< coalesce messages into batched datagrams
+    int maxBatchSize{64};  //!< the maximum number of messages to gather for a batch
+    std::chrono::milliseconds batchLinger{0};  //!< max time to wait for a batch to fill
+    std::size_t maxDatagram{1400};  //!< the maximum size of a batched datagram
     virtual int getDefaultBrokerPort() const override;
     virtual void queue_rx_function() override;  //!< the functional loop for the receive queue
     virtual void queue_tx_function() override;  //!< the loop for transmitting data
     virtual void closeReceiver() override;  //!< function to instruct the receiver loop to close
 
+    /** gather additional queued messages into a transmission batch
+    @details stops when the queue is empty and the linger time has expired or the batch is full*/
+    void collectTransmitBatch(std::vector<std::pair<route_id, ActionMessage>>& batch);
+
     // promise and future for communicating port number from tx_thread to rx_thread
     std::promise<int> promisePort;
     std::future<int> futurePort;
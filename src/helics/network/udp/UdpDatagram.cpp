@@ -0,0 +1,403 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "UdpDatagram.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace helics::udp {
+/*
+all batched datagrams start with a 12 byte header
+[0] marker [1] type [2] flags [3] version [4-7] sequence number [8-11] sender session id
+fragments continue with [12-15] message id [16-17] fragment index [18-19] fragment count
+integers are written in little endian byte order
+*/
+static constexpr std::uint8_t datagramVersion{2};
+static constexpr std::uint8_t ackRequestedFlag{0x01};
+/// the number of reliable sequence numbers remembered from each source to detect duplicates
+static constexpr std::size_t duplicateWindow{1024};
+/// the maximum number of incomplete fragmented messages held at one time
+static constexpr std::size_t maxPartialMessages{256};
+
+static void writeU16(char* location, std::uint16_t value)
+{
+    location[0] = static_cast<char>(value & 0xFFU);
+    location[1] = static_cast<char>((value >> 8U) & 0xFFU);
+}
+
+static void writeU32(char* location, std::uint32_t value)
+{
+    for (int ii = 0; ii < 4; ++ii) {
+        location[ii] = static_cast<char>((value >> (8U * ii)) & 0xFFU);
+    }
+}
+
+static std::uint16_t readU16(const unsigned char* location)
+{
+    return static_cast<std::uint16_t>(location[0] | (location[1] << 8U));
+}
+
+static std::uint32_t readU32(const unsigned char* location)
+{
+    std::uint32_t value{0};
+    for (int ii = 3; ii >= 0; --ii) {
+        value = (value << 8U) | location[ii];
+    }
+    return value;
+}
+
+static void writeHeader(std::string& data, DatagramType type)
+{
+    data.assign(batchHeaderSize, '\0');
+    data[0] = static_cast<char>(batchDatagramMarker);
+    data[1] = static_cast<char>(type);
+    data[3] = static_cast<char>(datagramVersion);
+}
+
+static void
+    stampHeader(std::string& data, std::uint32_t session, std::uint32_t sequence, bool reliable)
+{
+    data[2] = static_cast<char>(reliable ? ackRequestedFlag : 0U);
+    writeU32(&data[4], sequence);
+    writeU32(&data[8], session);
+}
+
+static std::uint32_t generateSession()
+{
+    std::random_device randomSource;
+    std::uint32_t session{0};
+    // zero marks a source without a session
+    while (session == 0) {
+        session = randomSource();
+    }
+    return session;
+}
+
+bool isBatchDatagram(const void* data, std::size_t size)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return size >= batchHeaderSize &&
+        bytes[0] == std::to_integer<unsigned char>(batchDatagramMarker) &&
+        bytes[3] == datagramVersion;
+}
+
+bool requiresAcknowledgement(const ActionMessage& cmd)
+{
+    return isProtocolCommand(cmd) || isPriorityCommand(cmd) || isTimingCommand(cmd) ||
+        isDisconnectCommand(cmd);
+}
+
+std::string generateAckDatagram(const std::vector<std::uint32_t>& sequences)
+{
+    std::string data;
+    writeHeader(data, DatagramType::ACK);
+    data.resize(batchHeaderSize + sequences.size() * sizeof(std::uint32_t));
+    char* location = &data[batchHeaderSize];
+    for (auto sequence : sequences) {
+        writeU32(location, sequence);
+        location += sizeof(std::uint32_t);
+    }
+    return data;
+}
+
+bool readAckDatagram(const void* data, std::size_t size, std::vector<std::uint32_t>& sequences)
+{
+    if (!isBatchDatagram(data, size)) {
+        return false;
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (bytes[1] != static_cast<unsigned char>(DatagramType::ACK)) {
+        return false;
+    }
+    for (std::size_t position = batchHeaderSize; position + sizeof(std::uint32_t) <= size;
+         position += sizeof(std::uint32_t)) {
+        sequences.push_back(readU32(bytes + position));
+    }
+    return true;
+}
+
+DatagramBatcher::DatagramBatcher(std::size_t maxSize): mSession(generateSession())
+{
+    setMaxDatagramSize(maxSize);
+}
+
+void DatagramBatcher::setMaxDatagramSize(std::size_t maxSize)
+{
+    // fragments need room for at least some data after the header
+    mMaxSize = std::clamp<std::size_t>(maxSize, 4 * fragmentHeaderSize, maxDatagramSize);
+}
+
+DatagramBatcher::PendingDatagram&
+    DatagramBatcher::pendingFor(const asio::ip::udp::endpoint& destination)
+{
+    for (std::size_t ii = 0; ii < mActive; ++ii) {
+        if (mPending[ii].destination == destination) {
+            return mPending[ii];
+        }
+    }
+    if (mActive == mPending.size()) {
+        mPending.emplace_back();
+    }
+    auto& pending = mPending[mActive++];
+    pending.destination = destination;
+    pending.reliable = false;
+    writeHeader(pending.data, DatagramType::BATCH);
+    return pending;
+}
+
+void DatagramBatcher::complete(PendingDatagram& pending)
+{
+    if (pending.data.size() <= batchHeaderSize) {
+        return;
+    }
+    auto& datagram = mReady.emplace_back();
+    datagram.destination = pending.destination;
+    datagram.sequence = ++mSequence;
+    datagram.reliable = pending.reliable;
+    stampHeader(pending.data, mSession, datagram.sequence, datagram.reliable);
+    datagram.data = std::move(pending.data);
+    writeHeader(pending.data, DatagramType::BATCH);
+    pending.reliable = false;
+}
+
+void DatagramBatcher::fragment(const asio::ip::udp::endpoint& destination, const ActionMessage& cmd)
+{
+    const std::string raw = cmd.to_string();
+    const std::size_t chunkSize = mMaxSize - fragmentHeaderSize;
+    const std::size_t count = (raw.size() + chunkSize - 1) / chunkSize;
+    if (count > 0xFFFFU) {
+        throw std::invalid_argument("message is too large to fragment");
+    }
+    const bool reliable = requiresAcknowledgement(cmd);
+    const auto messageId = ++mFragmentId;
+    for (std::size_t index = 0; index < count; ++index) {
+        auto& datagram = mReady.emplace_back();
+        datagram.destination = destination;
+        datagram.sequence = ++mSequence;
+        datagram.reliable = reliable;
+        writeHeader(datagram.data, DatagramType::FRAGMENT);
+        stampHeader(datagram.data, mSession, datagram.sequence, reliable);
+        datagram.data.resize(fragmentHeaderSize);
+        writeU32(&datagram.data[batchHeaderSize], messageId);
+        writeU16(&datagram.data[batchHeaderSize + 4], static_cast<std::uint16_t>(index));
+        writeU16(&datagram.data[batchHeaderSize + 6], static_cast<std::uint16_t>(count));
+        datagram.data.append(raw, index * chunkSize, chunkSize);
+    }
+}
+
+void DatagramBatcher::add(const asio::ip::udp::endpoint& destination, const ActionMessage& cmd)
+{
+    cmd.packetize(mPacket);
+    auto& pending = pendingFor(destination);
+    if (batchHeaderSize + mPacket.size() > mMaxSize) {
+        // anything already queued for the destination goes first to keep the order
+        complete(pending);
+        fragment(destination, cmd);
+        return;
+    }
+    if (pending.data.size() + mPacket.size() > mMaxSize) {
+        complete(pending);
+    }
+    pending.data.append(mPacket);
+    pending.reliable = pending.reliable || requiresAcknowledgement(cmd);
+}
+
+std::vector<Datagram>& DatagramBatcher::flush()
+{
+    for (std::size_t ii = 0; ii < mActive; ++ii) {
+        complete(mPending[ii]);
+    }
+    mActive = 0;
+    return mReady;
+}
+
+DatagramAssembler::DatagramAssembler(std::chrono::milliseconds fragmentTimeout):
+    mTimeout(fragmentTimeout)
+{
+}
+
+DatagramAssembler::SourceHistory&
+    DatagramAssembler::historyFor(const asio::ip::udp::endpoint& source, std::uint32_t session)
+{
+    auto& history = mSources[source];
+    if (history.session != session) {
+        // the sender restarted so its sequence numbers and fragment ids start over
+        history.session = session;
+        history.sequences.clear();
+        for (auto it = mPartials.begin(); it != mPartials.end();) {
+            if (it->first.first == source) {
+                it = mPartials.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    return history;
+}
+
+bool DatagramAssembler::isDuplicate(SourceHistory& history, std::uint32_t sequence)
+{
+    auto& seen = history.sequences;
+    if (!seen.insert(sequence).second) {
+        ++mDuplicates;
+        return true;
+    }
+    if (seen.size() > duplicateWindow) {
+        seen.erase(seen.begin());
+    }
+    return false;
+}
+
+void DatagramAssembler::expire(time_point now)
+{
+    for (auto it = mPartials.begin(); it != mPartials.end();) {
+        if (now - it->second.started > mTimeout) {
+            it = mPartials.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (mPartials.size() > maxPartialMessages) {
+        auto oldest = std::min_element(mPartials.begin(),
+                                       mPartials.end(),
+                                       [](const auto& part1, const auto& part2) {
+                                           return part1.second.started < part2.second.started;
+                                       });
+        mPartials.erase(oldest);
+    }
+}
+
+std::optional<std::uint32_t> DatagramAssembler::process(const asio::ip::udp::endpoint& source,
+                                                        const void* data,
+                                                        std::size_t size,
+                                                        std::vector<ActionMessage>& messages,
+                                                        time_point now)
+{
+    if (!isBatchDatagram(data, size)) {
+        return std::nullopt;
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    const auto type = static_cast<DatagramType>(bytes[1]);
+    const bool reliable = (bytes[2] & ackRequestedFlag) != 0;
+    if (type != DatagramType::BATCH && type != DatagramType::FRAGMENT) {
+        return std::nullopt;
+    }
+    const auto sequence = readU32(bytes + 4);
+    auto& history = historyFor(source, readU32(bytes + 8));
+    std::optional<std::uint32_t> ack;
+    if (reliable) {
+        // acknowledge duplicates as well since the original acknowledgement may have been lost
+        ack = sequence;
+        if (isDuplicate(history, sequence)) {
+            return ack;
+        }
+    }
+    switch (type) {
+        case DatagramType::BATCH: {
+            std::size_t position{batchHeaderSize};
+            while (position < size) {
+                ActionMessage cmd;
+                auto used = cmd.depacketize(bytes + position, size - position);
+                if (used == 0) {
+                    break;
+                }
+                messages.push_back(std::move(cmd));
+                position += used;
+            }
+        } break;
+        case DatagramType::FRAGMENT: {
+            if (size < fragmentHeaderSize) {
+                break;
+            }
+            const auto messageId = readU32(bytes + batchHeaderSize);
+            const auto index = readU16(bytes + batchHeaderSize + 4);
+            const auto count = readU16(bytes + batchHeaderSize + 6);
+            if (index >= count) {
+                break;
+            }
+            expire(now);
+            auto& partial = mPartials[std::make_pair(source, messageId)];
+            if (partial.pieces.empty()) {
+                partial.pieces.resize(count);
+                partial.started = now;
+            }
+            if (partial.pieces.size() != count || !partial.pieces[index].empty()) {
+                break;
+            }
+            partial.pieces[index].assign(reinterpret_cast<const char*>(bytes) + fragmentHeaderSize,
+                                         size - fragmentHeaderSize);
+            if (++partial.received == count) {
+                std::string raw;
+                for (auto& piece : partial.pieces) {
+                    raw.append(piece);
+                }
+                mPartials.erase(std::make_pair(source, messageId));
+                ActionMessage cmd;
+                if (cmd.from_string(raw) > 0) {
+                    messages.push_back(std::move(cmd));
+                }
+            }
+        } break;
+        default:
+            break;
+    }
+    return ack;
+}
+
+RetransmitTracker::RetransmitTracker(std::chrono::milliseconds timeout, int maxRetries):
+    mTimeout(timeout), mMaxRetries(maxRetries)
+{
+}
+
+void RetransmitTracker::track(const Datagram& datagram, time_point now)
+{
+    auto& tracked = mPending[datagram.sequence];
+    tracked.datagram = datagram;
+    tracked.deadline = now + mTimeout;
+    tracked.retries = 0;
+}
+
+void RetransmitTracker::acknowledge(std::uint32_t sequence)
+{
+    mPending.erase(sequence);
+}
+
+std::size_t RetransmitTracker::collectExpired(time_point now, std::vector<Datagram>& resend)
+{
+    std::size_t dropped{0};
+    for (auto it = mPending.begin(); it != mPending.end();) {
+        auto& tracked = it->second;
+        if (tracked.deadline > now) {
+            ++it;
+            continue;
+        }
+        if (tracked.retries >= mMaxRetries) {
+            it = mPending.erase(it);
+            ++dropped;
+            continue;
+        }
+        ++tracked.retries;
+        // back off so a congested receiver is not flooded with retransmissions
+        tracked.deadline = now + mTimeout * (tracked.retries + 1);
+        resend.push_back(tracked.datagram);
+        ++it;
+    }
+    return dropped;
+}
+
+RetransmitTracker::time_point RetransmitTracker::nextDeadline() const
+{
+    auto next = time_point::max();
+    for (const auto& pending : mPending) {
+        next = std::min(next, pending.second.deadline);
+    }
+    return next;
+}
+
+}  // namespace helics::udp
@@ -0,0 +1,186 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include "../../core/ActionMessage.hpp"
+
+#include <asio/ip/udp.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace helics::udp {
+/** the first byte of a batched datagram, distinct from the markers of the ActionMessage encodings
+ */
+constexpr std::byte batchDatagramMarker{0xF5};
+/// the default maximum datagram size, chosen to avoid IP fragmentation on typical networks
+constexpr std::size_t defaultDatagramSize{1400};
+/// the largest payload that can be carried in a single UDP datagram
+constexpr std::size_t maxDatagramSize{65507};
+/// the size of the header at the start of each batched datagram
+constexpr std::size_t batchHeaderSize{12};
+/// the size of the header at the start of each fragment datagram
+constexpr std::size_t fragmentHeaderSize{batchHeaderSize + 8};
+
+/** the types of batched datagram*/
+enum class DatagramType : std::uint8_t {
+    BATCH = 1,  //!< one or more packetized messages
+    FRAGMENT = 2,  //!< a piece of a message too large for a single datagram
+    ACK = 3  //!< a list of acknowledged sequence numbers
+};
+
+/** check if a received buffer is a batched datagram*/
+bool isBatchDatagram(const void* data, std::size_t size);
+
+/** check if a message must be acknowledged by the receiver
+@details protocol, priority, timing, and disconnect commands are control traffic and are
+retransmitted if they are not acknowledged*/
+bool requiresAcknowledgement(const ActionMessage& cmd);
+
+/** a datagram ready to be transmitted*/
+struct Datagram {
+    asio::ip::udp::endpoint destination;
+    std::string data;
+    std::uint32_t sequence{0};
+    bool reliable{false};  //!< the receiver will acknowledge the datagram
+};
+
+/** generate a datagram acknowledging a set of sequence numbers*/
+std::string generateAckDatagram(const std::vector<std::uint32_t>& sequences);
+
+/** read the sequence numbers from an ack datagram
+@return false if the data is not an ack datagram*/
+bool readAckDatagram(const void* data, std::size_t size, std::vector<std::uint32_t>& sequences);
+
+/** combines messages into datagrams for transmission
+@details small messages are packetized and coalesced into a single datagram per destination,
+messages larger than a datagram are split into fragments.  The order of messages to each
+destination is preserved.
+*/
+class DatagramBatcher {
+  public:
+    explicit DatagramBatcher(std::size_t maxSize = defaultDatagramSize);
+    /** set the maximum size of the generated datagrams*/
+    void setMaxDatagramSize(std::size_t maxSize);
+    std::size_t getMaxDatagramSize() const { return mMaxSize; }
+    /** add a message to the datagram for a destination
+    @throw std::invalid_argument if the message is too large to be fragmented*/
+    void add(const asio::ip::udp::endpoint& destination, const ActionMessage& cmd);
+    /** complete all partially filled datagrams
+    @return the datagrams ready for transmission, the caller should clear the vector once they are
+    sent*/
+    std::vector<Datagram>& flush();
+    /** check if there are no messages waiting to be flushed*/
+    bool empty() const { return mActive == 0 && mReady.empty(); }
+    /** get the random session id identifying this batcher to receivers*/
+    std::uint32_t getSession() const { return mSession; }
+
+  private:
+    struct PendingDatagram {
+        asio::ip::udp::endpoint destination;
+        std::string data;
+        bool reliable{false};
+    };
+    PendingDatagram& pendingFor(const asio::ip::udp::endpoint& destination);
+    void complete(PendingDatagram& pending);
+    void fragment(const asio::ip::udp::endpoint& destination, const ActionMessage& cmd);
+
+    std::size_t mMaxSize;
+    /// the pending buffers are reused across flushes, only the first mActive are in use
+    std::vector<PendingDatagram> mPending;
+    std::size_t mActive{0};
+    std::vector<Datagram> mReady;
+    std::string mPacket;
+    /// sequence numbers restart with each session so a restarted sender is not seen as duplicates
+    std::uint32_t mSession;
+    std::uint32_t mSequence{0};
+    std::uint32_t mFragmentId{0};
+};
+
+/** decodes received batched datagrams into messages
+@details fragments are reassembled, incomplete messages are discarded after a timeout, and
+retransmitted copies of reliable datagrams are detected and dropped.  A new session id from a source
+means the sender restarted, so the duplicate history and fragments from that source are reset*/
+class DatagramAssembler {
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+    explicit DatagramAssembler(
+        std::chrono::milliseconds fragmentTimeout = std::chrono::milliseconds(5000));
+    /** decode a batched datagram
+    @param source the endpoint the datagram was received from
+    @param data the datagram
+    @param size the size of the datagram in bytes
+    @param messages the vector to append the decoded messages to
+    @param now the current time used to expire incomplete fragments
+    @return the sequence number to acknowledge if the datagram was reliable*/
+    std::optional<std::uint32_t> process(const asio::ip::udp::endpoint& source,
+                                         const void* data,
+                                         std::size_t size,
+                                         std::vector<ActionMessage>& messages,
+                                         time_point now = std::chrono::steady_clock::now());
+    /** get the number of messages waiting for additional fragments*/
+    std::size_t incompleteCount() const { return mPartials.size(); }
+    /** get the number of datagrams dropped as duplicates*/
+    std::size_t duplicateCount() const { return mDuplicates; }
+
+  private:
+    struct PartialMessage {
+        std::vector<std::string> pieces;
+        std::size_t received{0};
+        time_point started;
+    };
+    struct SourceHistory {
+        std::uint32_t session{0};
+        /// recently received reliable sequence numbers
+        std::set<std::uint32_t> sequences;
+    };
+    SourceHistory& historyFor(const asio::ip::udp::endpoint& source, std::uint32_t session);
+    bool isDuplicate(SourceHistory& history, std::uint32_t sequence);
+    void expire(time_point now);
+
+    std::chrono::milliseconds mTimeout;
+    std::map<std::pair<asio::ip::udp::endpoint, std::uint32_t>, PartialMessage> mPartials;
+    std::map<asio::ip::udp::endpoint, SourceHistory> mSources;
+    std::size_t mDuplicates{0};
+};
+
+/** tracks reliable datagrams until they are acknowledged*/
+class RetransmitTracker {
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+    RetransmitTracker(std::chrono::milliseconds timeout, int maxRetries);
+    /** start tracking a reliable datagram which was just transmitted*/
+    void track(const Datagram& datagram, time_point now = std::chrono::steady_clock::now());
+    /** remove an acknowledged datagram*/
+    void acknowledge(std::uint32_t sequence);
+    /** get the datagrams whose acknowledgement is overdue
+    @details datagrams which have been retransmitted the maximum number of times are dropped
+    @return the number of datagrams dropped*/
+    std::size_t collectExpired(time_point now, std::vector<Datagram>& resend);
+    /** get the time of the next retransmission*/
+    time_point nextDeadline() const;
+    bool empty() const { return mPending.empty(); }
+    std::size_t size() const { return mPending.size(); }
+
+  private:
+    struct TrackedDatagram {
+        Datagram datagram;
+        time_point deadline;
+        int retries{0};
+    };
+    std::chrono::milliseconds mTimeout;
+    int mMaxRetries;
+    std::map<std::uint32_t, TrackedDatagram> mPending;
+};
+
+}  // namespace helics::udp
@@ -1152,6 +1152,28 @@ void helicsFederateRequestTimeAsync(HelicsFederate fed, HelicsTime requestTime,
     }
 }
 
+void helicsFederateRequestTimeAsyncCallback(HelicsFederate fed,
+                                            HelicsTime requestTime,
+                                            void (*completion)(HelicsFederate fed, void* userdata),
+                                            void* userdata,
+                                            HelicsError* err)
+{
+    auto* fedObj = getFed(fed, err);
+    if (fedObj == nullptr) {
+        return;
+    }
+    try {
+        if (completion == nullptr) {
+            fedObj->requestTimeAsync(requestTime, std::function<void()>{});
+        } else {
+            fedObj->requestTimeAsync(requestTime, [fed, completion, userdata]() { completion(fed, userdata); });
+        }
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+    }
+}
+
 HelicsTime helicsFederateRequestTimeComplete(HelicsFederate fed, HelicsError* err)
 {
     auto* fedObj = getFed(fed, err);
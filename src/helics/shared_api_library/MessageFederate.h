@@ -344,6 +344,21 @@ HELICS_EXPORT int helicsEndpointPendingMessageCount(HelicsEndpoint endpoint);
  */
 HELICS_EXPORT HelicsMessage helicsEndpointGetMessage(HelicsEndpoint endpoint);
 
+/**
+ * Receive all the pending messages from a particular endpoint in a single call.
+ *
+ * @details The messages are stored in time order and are managed by the federate in the same way as messages from
+ * helicsEndpointGetMessage.  If more than maxCount messages are pending the rest remain available for a later call.
+ *
+ * @param[in] endpoint The identifier for the endpoint.
+ * @param[out] messages The location to store the messages.
+ * @param maxCount The maximum number of messages to store.
+ * @param[out] actualCount Location to place the number of messages stored.
+ * @param[in,out] err An error object that will contain an error code and string if any error occurred during the execution of the function.
+ */
+HELICS_EXPORT void
+    helicsEndpointReceiveAll(HelicsEndpoint endpoint, HelicsMessage messages[], int maxCount, int* actualCount, HelicsError* err);
+
 /**
  * Create a new empty message object.
  *
@@ -5,6 +5,7 @@ additional details. All rights reserved.
 SPDX-License-Identifier: BSD-3-Clause
 */
 
+#include "../core/MessagePool.hpp"
 #include "../core/core-exceptions.hpp"
 #include "../core/flagOperations.hpp"
 #include "../helics.hpp"
@@ -496,12 +497,12 @@ Message* MessageHolder::newMessage()
     if (!freeMessageSlots.empty()) {
         auto index = freeMessageSlots.back();
         freeMessageSlots.pop_back();
-        messages[index] = std::make_unique<Message>();
+        messages[index] = acquireMessage();
         message = messages[index].get();
         message->counter = index;
 
     } else {
-        messages.push_back(std::make_unique<Message>());
+        messages.push_back(acquireMessage());
         message = messages.back().get();
         message->counter = static_cast<int32_t>(messages.size()) - 1;
     }
@@ -530,7 +531,7 @@ void MessageHolder::freeMessage(int index)
         if (messages[index]) {
             messages[index]->backReference = nullptr;
             messages[index]->messageValidation = 0;
-            messages[index].reset();
+            releaseMessage(std::move(messages[index]));
             freeMessageSlots.push_back(index);
         }
     }
@@ -543,6 +544,7 @@ void MessageHolder::clear()
         if (message) {
             message->backReference = nullptr;
             message->messageValidation = 0;
+            releaseMessage(std::move(message));
         }
     }
     messages.clear();
@@ -566,6 +568,29 @@ HelicsMessage helicsEndpointGetMessage(HelicsEndpoint endpoint)
     return endObj->fed->messages.addMessage(message);
 }
 
+void helicsEndpointReceiveAll(HelicsEndpoint endpoint, HelicsMessage messages[], int maxCount, int* actualCount, HelicsError* err)
+{
+    auto* endObj = verifyEndpoint(endpoint, err);
+    if (actualCount != nullptr) {
+        *actualCount = 0;
+    }
+    if (endObj == nullptr) {
+        return;
+    }
+    if ((messages == nullptr) || (maxCount <= 0)) {
+        // this isn't an error, just no messages retrieved
+        return;
+    }
+    int count{0};
+    for (auto& message : endObj->endPtr->receiveAll(static_cast<std::size_t>(maxCount))) {
+        message->messageValidation = messageKeyCode;
+        messages[count++] = endObj->fed->messages.addMessage(message);
+    }
+    if (actualCount != nullptr) {
+        *actualCount = count;
+    }
+}
+
 HelicsMessage helicsFederateGetMessage(HelicsFederate fed)
 {
     auto* mFed = getMessageFed(fed, nullptr);
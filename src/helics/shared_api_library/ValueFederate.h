@@ -281,6 +281,42 @@ HELICS_EXPORT HelicsInput helicsFederateGetInputByTarget(HelicsFederate fed, con
  */
 HELICS_EXPORT void helicsFederateClearUpdates(HelicsFederate fed);
 
+/**
+ * Get the values of all the updated inputs of a federate as doubles in a single call.
+ *
+ * @details This is equivalent to calling helicsInputGetDouble on every updated input with a double, integer, boolean, or time
+ * type, but all the inputs are read under a single lock from the values the last time request loaded from the core.  Updates to
+ * inputs of other types, such as strings or vectors, are not read and remain pending, as do updates beyond maxCount.
+ *
+ * @param fed The value federate object to get the updates from.
+ * @param[out] values An array to store the values in.
+ * @param[out] indices An array to store the input index of each value in, matching helicsFederateGetInputByIndex, may be NULL.
+ * @param maxCount The number of elements the arrays can hold.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ *
+ * @return The number of values stored in the arrays.
+ */
+HELICS_EXPORT int helicsFederateGetUpdatedDoubles(HelicsFederate fed, double values[], int indices[], int maxCount, HelicsError* err);
+
+/**
+ * Get the values of all the updated inputs of a federate as integers in a single call.
+ *
+ * @details This is equivalent to calling helicsInputGetInteger on every updated input with a double, integer, boolean, or time
+ * type, but all the inputs are read under a single lock from the values the last time request loaded from the core.  Updates to
+ * inputs of other types, such as strings or vectors, are not read and remain pending, as do updates beyond maxCount.
+ *
+ * @param fed The value federate object to get the updates from.
+ * @param[out] values An array to store the values in.
+ * @param[out] indices An array to store the input index of each value in, matching helicsFederateGetInputByIndex, may be NULL.
+ * @param maxCount The number of elements the arrays can hold.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ *
+ * @return The number of values stored in the arrays.
+ */
+HELICS_EXPORT int helicsFederateGetUpdatedIntegers(HelicsFederate fed, int64_t values[], int indices[], int maxCount, HelicsError* err);
+
 /**
  * Register the publications via JSON publication string.
  *
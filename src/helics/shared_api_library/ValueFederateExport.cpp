@@ -518,6 +518,46 @@ void helicsFederateClearUpdates(HelicsFederate fed)
     // LCOV_EXCL_STOP
 }
 
+static constexpr char invalidValueArray[] = "the values array is null";
+
+int helicsFederateGetUpdatedDoubles(HelicsFederate fed, double values[], int indices[], int maxCount, HelicsError* err)
+{
+    auto* fedObj = getValueFed(fed, err);
+    if (fedObj == nullptr) {
+        return 0;
+    }
+    if (values == nullptr && maxCount > 0) {
+        assignError(err, HELICS_ERROR_INVALID_ARGUMENT, invalidValueArray);
+        return 0;
+    }
+    try {
+        return fedObj->getUpdatedValues(values, indices, maxCount);
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+        return 0;
+    }
+}
+
+int helicsFederateGetUpdatedIntegers(HelicsFederate fed, int64_t values[], int indices[], int maxCount, HelicsError* err)
+{
+    auto* fedObj = getValueFed(fed, err);
+    if (fedObj == nullptr) {
+        return 0;
+    }
+    if (values == nullptr && maxCount > 0) {
+        assignError(err, HELICS_ERROR_INVALID_ARGUMENT, invalidValueArray);
+        return 0;
+    }
+    try {
+        return fedObj->getUpdatedValues(values, indices, maxCount);
+    }
+    catch (...) {
+        helicsErrorHandler(err);
+        return 0;
+    }
+}
+
 /* getting and publishing values */
 void helicsPublicationPublishBytes(HelicsPublication pub, const void* data, int datalen, HelicsError* err)
 {
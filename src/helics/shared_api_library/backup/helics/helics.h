@@ -65,6 +65,9 @@ typedef enum { /* NOLINT */
                HELICS_CORE_TYPE_TCP = 6,
                /** use UDP packets to send the data */
                HELICS_CORE_TYPE_UDP = 7,
+               /** use lock free ring buffers in shared memory to transfer data (for use when all
+                  federates are on the same machine)*/
+               HELICS_CORE_TYPE_SHM = 8,
                /** single socket version of ZMQ core usually for high fed count on the same system*/
                HELICS_CORE_TYPE_ZMQ_SS = 10,
                /** for using the nanomsg communications */
@@ -410,7 +413,14 @@ typedef enum { /* NOLINT */
                   connections*/
                HELICS_HANDLE_OPTION_CONNECTIONS = 522,
                /** specify that the interface only sends or receives data at specified intervals*/
-               HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557
+               HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557,
+               /** specify that vector and complex vector values of a publication are sent as the
+                  changes from the previous value, the value is the number of updates between full
+                  values or 1 to use the default interval*/
+               HELICS_HANDLE_OPTION_DELTA_ENCODING = 562,
+               /** specify the tolerance in millionths of a unit below which changes to an element
+                  of a delta encoded value are not transmitted*/
+               HELICS_HANDLE_OPTION_DELTA_TOLERANCE = 564
 } HelicsHandleOptions;
 
 /** enumeration of the predefined filter types*/
@@ -2020,6 +2030,26 @@ HELICS_EXPORT HelicsTime helicsFederateRequestTimeIterative(HelicsFederate fed,
  */
 HELICS_EXPORT void helicsFederateRequestTimeAsync(HelicsFederate fed, HelicsTime requestTime, HelicsError* err);
 
+/**
+ * Request the next time for federate execution and have a callback called when it can be completed.
+ *
+ * @details No thread waits on the request; the callback is called from a core thread once the time has been granted and should not
+ * make blocking calls on the federate.  Call /ref helicsFederateRequestTimeComplete from the callback or later to finish the call.
+ * Realtime federates do not support this call.
+ *
+ * @param fed The federate to make the request of.
+ * @param requestTime The next requested time.
+ * @param completion The function to call when the request can be completed, it is passed the federate and the userdata.
+ * @param userdata A pointer to user data that is passed to the completion callback.
+ *
+ * @param[in,out] err An error object that will contain an error code and string if any error occurred during the execution of the function.
+ */
+HELICS_EXPORT void helicsFederateRequestTimeAsyncCallback(HelicsFederate fed,
+                                                          HelicsTime requestTime,
+                                                          void (*completion)(HelicsFederate fed, void* userdata),
+                                                          void* userdata,
+                                                          HelicsError* err);
+
 /**
  * Complete an asynchronous requestTime call.
  *
@@ -2964,6 +2994,42 @@ HELICS_EXPORT HelicsInput helicsFederateGetInputByTarget(HelicsFederate fed, con
  */
 HELICS_EXPORT void helicsFederateClearUpdates(HelicsFederate fed);
 
+/**
+ * Get the values of all the updated inputs of a federate as doubles in a single call.
+ *
+ * @details This is equivalent to calling helicsInputGetDouble on every updated input with a double, integer, boolean, or time
+ * type, but all the inputs are read under a single lock from the values the last time request loaded from the core.  Updates to
+ * inputs of other types, such as strings or vectors, are not read and remain pending, as do updates beyond maxCount.
+ *
+ * @param fed The value federate object to get the updates from.
+ * @param[out] values An array to store the values in.
+ * @param[out] indices An array to store the input index of each value in, matching helicsFederateGetInputByIndex, may be NULL.
+ * @param maxCount The number of elements the arrays can hold.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ *
+ * @return The number of values stored in the arrays.
+ */
+HELICS_EXPORT int helicsFederateGetUpdatedDoubles(HelicsFederate fed, double values[], int indices[], int maxCount, HelicsError* err);
+
+/**
+ * Get the values of all the updated inputs of a federate as integers in a single call.
+ *
+ * @details This is equivalent to calling helicsInputGetInteger on every updated input with a double, integer, boolean, or time
+ * type, but all the inputs are read under a single lock from the values the last time request loaded from the core.  Updates to
+ * inputs of other types, such as strings or vectors, are not read and remain pending, as do updates beyond maxCount.
+ *
+ * @param fed The value federate object to get the updates from.
+ * @param[out] values An array to store the values in.
+ * @param[out] indices An array to store the input index of each value in, matching helicsFederateGetInputByIndex, may be NULL.
+ * @param maxCount The number of elements the arrays can hold.
+ *
+ * @param[in,out] err The error object to complete if there is an error.
+ *
+ * @return The number of values stored in the arrays.
+ */
+HELICS_EXPORT int helicsFederateGetUpdatedIntegers(HelicsFederate fed, int64_t values[], int indices[], int maxCount, HelicsError* err);
+
 /**
  * Register the publications via JSON publication string.
  *
@@ -4092,6 +4158,21 @@ HELICS_EXPORT int helicsEndpointPendingMessageCount(HelicsEndpoint endpoint);
  */
 HELICS_EXPORT HelicsMessage helicsEndpointGetMessage(HelicsEndpoint endpoint);
 
+/**
+ * Receive all the pending messages from a particular endpoint in a single call.
+ *
+ * @details The messages are stored in time order and are managed by the federate in the same way as messages from
+ * helicsEndpointGetMessage.  If more than maxCount messages are pending the rest remain available for a later call.
+ *
+ * @param[in] endpoint The identifier for the endpoint.
+ * @param[out] messages The location to store the messages.
+ * @param maxCount The maximum number of messages to store.
+ * @param[out] actualCount Location to place the number of messages stored.
+ * @param[in,out] err An error object that will contain an error code and string if any error occurred during the execution of the function.
+ */
+HELICS_EXPORT void
+    helicsEndpointReceiveAll(HelicsEndpoint endpoint, HelicsMessage messages[], int maxCount, int* actualCount, HelicsError* err);
+
 /**
  * Create a new empty message object.
  *
@@ -18,6 +18,7 @@ typedef enum {
     HELICS_CORE_TYPE_IPC = 5,
     HELICS_CORE_TYPE_TCP = 6,
     HELICS_CORE_TYPE_UDP = 7,
+    HELICS_CORE_TYPE_SHM = 8,
     HELICS_CORE_TYPE_ZMQ_SS = 10,
     HELICS_CORE_TYPE_NNG = 9,
     HELICS_CORE_TYPE_TCP_SS = 11,
@@ -188,7 +189,9 @@ typedef enum {
     HELICS_HANDLE_OPTION_INPUT_PRIORITY_LOCATION = 510,
     HELICS_HANDLE_OPTION_CLEAR_PRIORITY_LIST = 512,
     HELICS_HANDLE_OPTION_CONNECTIONS = 522,
-    HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557
+    HELICS_HANDLE_OPTION_TIME_RESTRICTED = 557,
+    HELICS_HANDLE_OPTION_DELTA_ENCODING = 562,
+    HELICS_HANDLE_OPTION_DELTA_TOLERANCE = 564
 } HelicsHandleOptions;
 
 typedef enum {
@@ -456,6 +459,11 @@ HelicsTime helicsFederateRequestTimeIterative(HelicsFederate fed,
                                               HelicsIterationResult* outIteration,
                                               HelicsError* err);
 void helicsFederateRequestTimeAsync(HelicsFederate fed, HelicsTime requestTime, HelicsError* err);
+void helicsFederateRequestTimeAsyncCallback(HelicsFederate fed,
+                                            HelicsTime requestTime,
+                                            void (*completion)(HelicsFederate fed, void* userdata),
+                                            void* userdata,
+                                            HelicsError* err);
 HelicsTime helicsFederateRequestTimeComplete(HelicsFederate fed, HelicsError* err);
 void helicsFederateRequestTimeIterativeAsync(HelicsFederate fed, HelicsTime requestTime, HelicsIterationRequest iterate, HelicsError* err);
 HelicsTime helicsFederateRequestTimeIterativeComplete(HelicsFederate fed, HelicsIterationResult* outIterate, HelicsError* err);
@@ -543,6 +551,8 @@ HelicsInput helicsFederateGetInputByIndex(HelicsFederate fed, int index, HelicsE
 HELICS_DEPRECATED HelicsInput helicsFederateGetSubscription(HelicsFederate fed, const char* key, HelicsError* err);
 HelicsInput helicsFederateGetInputByTarget(HelicsFederate fed, const char* target, HelicsError* err);
 void helicsFederateClearUpdates(HelicsFederate fed);
+int helicsFederateGetUpdatedDoubles(HelicsFederate fed, double values[], int indices[], int maxCount, HelicsError* err);
+int helicsFederateGetUpdatedIntegers(HelicsFederate fed, int64_t values[], int indices[], int maxCount, HelicsError* err);
 void helicsFederateRegisterFromPublicationJSON(HelicsFederate fed, const char* json, HelicsError* err);
 void helicsFederatePublishJSON(HelicsFederate fed, const char* json, HelicsError* err);
 HelicsBool helicsPublicationIsValid(HelicsPublication pub);
@@ -652,6 +662,7 @@ HelicsBool helicsEndpointHasMessage(HelicsEndpoint endpoint);
 int helicsFederatePendingMessageCount(HelicsFederate fed);
 int helicsEndpointPendingMessageCount(HelicsEndpoint endpoint);
 HelicsMessage helicsEndpointGetMessage(HelicsEndpoint endpoint);
+void helicsEndpointReceiveAll(HelicsEndpoint endpoint, HelicsMessage messages[], int maxCount, int* actualCount, HelicsError* err);
 HelicsMessage helicsEndpointCreateMessage(HelicsEndpoint endpoint, HelicsError* err);
 void helicsEndpointClearMessages(HelicsEndpoint endpoint);
 HelicsMessage helicsFederateGetMessage(HelicsFederate fed);
@@ -1233,6 +1233,26 @@ HELICS_EXPORT HelicsTime helicsFederateRequestTimeIterative(HelicsFederate fed,
  */
 HELICS_EXPORT void helicsFederateRequestTimeAsync(HelicsFederate fed, HelicsTime requestTime, HelicsError* err);
 
+/**
+ * Request the next time for federate execution and have a callback called when it can be completed.
+ *
+ * @details No thread waits on the request; the callback is called from a core thread once the time has been granted and should not
+ * make blocking calls on the federate.  Call /ref helicsFederateRequestTimeComplete from the callback or later to finish the call.
+ * Realtime federates do not support this call.
+ *
+ * @param fed The federate to make the request of.
+ * @param requestTime The next requested time.
+ * @param completion The function to call when the request can be completed, it is passed the federate and the userdata.
+ * @param userdata A pointer to user data that is passed to the completion callback.
+ *
+ * @param[in,out] err An error object that will contain an error code and string if any error occurred during the execution of the function.
+ */
+HELICS_EXPORT void helicsFederateRequestTimeAsyncCallback(HelicsFederate fed,
+                                                          HelicsTime requestTime,
+                                                          void (*completion)(HelicsFederate fed, void* userdata),
+                                                          void* userdata,
+                                                          HelicsError* err);
+
 /**
  * Complete an asynchronous requestTime call.
  *
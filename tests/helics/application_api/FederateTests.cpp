@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/CoreApp.hpp"
 #include "helics/application_api/Federate.hpp"
 #include "helics/application_api/Filters.hpp"
+#include "helics/application_api/TimeRequestAwaitable.hpp"
 #include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
@@ -18,11 +19,14 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "testFixtures.hpp"
 
 #include "gmock/gmock.h"
+#include <atomic>
+#include <functional>
 #include <future>
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 /** these test cases test out the value converters
  */
@@ -662,6 +666,143 @@ TEST(federate, multiple_federates_async_calls)
     Fed2->finalize();
 }
 
+/** step a federate to a final time using completion callbacks instead of waiting*/
+static void callbackTimeLoop(helics::Federate& fed, helics::Time finalTime, std::promise<int>& done)
+{
+    auto steps = std::make_shared<int>(0);
+    auto step = std::make_shared<std::function<void()>>();
+    *step = [&fed, finalTime, &done, steps, step]() {
+        auto granted = fed.requestTimeComplete();
+        ++(*steps);
+        if (granted >= finalTime) {
+            done.set_value(*steps);
+            // break the reference cycle of the callback holding itself
+            *step = nullptr;
+            return;
+        }
+        fed.requestTimeAsync(granted + 1.0, *step);
+    };
+    fed.requestTimeAsync(1.0, *step);
+}
+
+TEST(federate, async_time_callbacks)
+{
+    constexpr int fedCount{10};
+    helics::FederateInfo fedInfo(CORE_TYPE_TO_TEST);
+    fedInfo.coreName = "core_async_callbacks";
+    fedInfo.coreInitString = "-f " + std::to_string(fedCount) + " --autobroker";
+    fedInfo.setProperty(HELICS_PROPERTY_TIME_PERIOD, 1.0);
+
+    std::vector<std::shared_ptr<helics::Federate>> feds;
+    for (int ii = 0; ii < fedCount; ++ii) {
+        feds.push_back(std::make_shared<helics::Federate>("fed" + std::to_string(ii), fedInfo));
+    }
+    for (auto& fed : feds) {
+        fed->enterExecutingModeAsync();
+    }
+    for (auto& fed : feds) {
+        fed->enterExecutingModeComplete();
+    }
+    std::vector<std::promise<int>> done(fedCount);
+    for (int ii = 0; ii < fedCount; ++ii) {
+        callbackTimeLoop(*feds[ii], 10.0, done[ii]);
+    }
+    for (auto& result : done) {
+        auto fut = result.get_future();
+        ASSERT_EQ(fut.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        EXPECT_EQ(fut.get(), 10);
+    }
+    for (auto& fed : feds) {
+        EXPECT_EQ(fed->getCurrentTime(), 10.0);
+        EXPECT_TRUE(fed->getCurrentMode() == helics::Federate::Modes::EXECUTING);
+        fed->finalize();
+    }
+}
+
+TEST(federate, async_time_callback_mixed)
+{
+    helics::FederateInfo fedInfo(CORE_TYPE_TO_TEST);
+    fedInfo.coreName = "core_async_mixed";
+    fedInfo.coreInitString = "-f 2 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::Federate>("fed1", fedInfo);
+    auto Fed2 = std::make_shared<helics::Federate>("fed2", fedInfo);
+
+    Fed1->enterExecutingModeAsync();
+    Fed2->enterExecutingMode();
+    Fed1->enterExecutingModeComplete();
+
+    std::atomic<int> called{0};
+    EXPECT_THROW(Fed1->requestTimeAsync(1.0, std::function<void()>{}), helics::InvalidParameter);
+    Fed1->requestTimeAsync(2.0, [&called]() { ++called; });
+    EXPECT_THROW(Fed1->requestTimeAsync(2.0, [&called]() { ++called; }),
+                 helics::InvalidFunctionCall);
+    EXPECT_EQ(Fed2->requestTime(2.0), 2.0);
+    EXPECT_EQ(Fed1->requestTimeComplete(), 2.0);
+    EXPECT_EQ(called.load(), 1);
+
+    Fed1->requestTimeIterativeAsync(2.0, helics::IterationRequest::FORCE_ITERATION, [&called]() {
+        ++called;
+    });
+    auto f2res = Fed2->requestTimeIterative(2.0, helics::IterationRequest::FORCE_ITERATION);
+    auto f1res = Fed1->requestTimeIterativeComplete();
+    EXPECT_EQ(f2res.state, helics::IterationResult::ITERATING);
+    EXPECT_EQ(f1res.state, helics::IterationResult::ITERATING);
+    EXPECT_EQ(f1res.grantedTime, 2.0);
+    EXPECT_EQ(called.load(), 2);
+
+    Fed2->finalize();
+    // the remaining federate completes its request without the other
+    Fed1->requestTimeAsync(5.0, [&called]() { ++called; });
+    EXPECT_EQ(Fed1->requestTimeComplete(), 5.0);
+    EXPECT_EQ(called.load(), 3);
+    Fed1->finalize();
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+/** minimal eagerly started coroutine type for running a federate*/
+struct FederateTask {
+    struct promise_type {
+        FederateTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static FederateTask coroutineTimeLoop(helics::Federate& fed, std::promise<helics::Time>& done)
+{
+    helics::Time granted{helics::timeZero};
+    while (granted < 10.0) {
+        granted = co_await helics::requestTimeAwaitable(fed, granted + 1.0);
+    }
+    done.set_value(granted);
+}
+
+TEST(federate, async_time_coroutine)
+{
+    helics::FederateInfo fedInfo(CORE_TYPE_TO_TEST);
+    fedInfo.coreName = "core_async_coroutine";
+    fedInfo.coreInitString = "-f 2 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::Federate>("fed1", fedInfo);
+    auto Fed2 = std::make_shared<helics::Federate>("fed2", fedInfo);
+    Fed1->enterExecutingModeAsync();
+    Fed2->enterExecutingMode();
+    Fed1->enterExecutingModeComplete();
+
+    std::promise<helics::Time> done1;
+    std::promise<helics::Time> done2;
+    coroutineTimeLoop(*Fed1, done1);
+    coroutineTimeLoop(*Fed2, done2);
+    EXPECT_EQ(done1.get_future().get(), 10.0);
+    EXPECT_EQ(done2.get_future().get(), 10.0);
+    Fed1->finalize();
+    Fed2->finalize();
+}
+#endif
+
 TEST(federate, missing_core)
 {
     helics::FederateInfo fedInfo(helics::CoreType::NULLCORE);
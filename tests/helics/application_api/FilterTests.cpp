@@ -859,6 +859,96 @@ TEST_F(filter, many_filters)
     }
 }
 
+TEST_F(filter, builtin_and_custom_filter_chain)
+{
+    auto broker = AddBroker("test", 2);
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "sender");
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "receiver");
+
+    auto send = GetFederateAs<helics::MessageFederate>(0);
+    auto rec = GetFederateAs<helics::MessageFederate>(1);
+
+    auto& ept1 = send->registerGlobalEndpoint("send");
+    auto& ept2 = rec->registerGlobalEndpoint("rec");
+    auto& ept3 = rec->registerGlobalEndpoint("rec2");
+    ept1.setDefaultDestination("rec");
+
+    // built-in filters run on the core message directly, the custom one in between needs a Message
+    auto& delay = helics::make_filter(helics::FilterTypes::DELAY, send.get(), "delay");
+    delay.set("delay", 0.5);
+    delay.addSourceTarget("send");
+    auto& data = send->registerFilter("data");
+    auto dataOp = std::make_shared<helics::MessageDataOperator>();
+    dataOp->setDataFunction([](helics::SmallBuffer& buffer) { buffer.push_back('b'); });
+    data.setOperator(dataOp);
+    data.addSourceTarget("send");
+    auto& reroute = helics::make_filter(helics::FilterTypes::REROUTE, send.get(), "reroute");
+    reroute.setString("newdestination", "rec2");
+    reroute.addSourceTarget("send");
+    auto& drop = helics::make_filter(helics::FilterTypes::RANDOM_DROP, send.get(), "drop");
+    drop.set("prob", 0.0);
+    drop.addSourceTarget("send");
+
+    send->enterExecutingModeAsync();
+    rec->enterExecutingMode();
+    send->enterExecutingModeComplete();
+
+    ept1.send("message");
+    send->requestTimeAsync(1.0);
+    rec->requestTime(1.0);
+    send->requestTimeComplete();
+
+    EXPECT_FALSE(ept2.hasMessage());
+    ASSERT_TRUE(ept3.hasMessage());
+    auto message = ept3.getMessage();
+    EXPECT_EQ(message->to_string(), "messageb");
+    EXPECT_EQ(message->time, 0.5);
+    EXPECT_EQ(message->source, "send");
+    EXPECT_EQ(message->dest, "rec2");
+    EXPECT_EQ(message->original_dest, "rec");
+
+    send->finalizeAsync();
+    rec->finalize();
+    send->finalizeComplete();
+}
+
+TEST_F(filter, random_drop_dest_filter)
+{
+    auto broker = AddBroker("test", 2);
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "sender");
+    AddFederates<helics::MessageFederate>("test", 1, broker, 1.0, "receiver");
+
+    auto send = GetFederateAs<helics::MessageFederate>(0);
+    auto rec = GetFederateAs<helics::MessageFederate>(1);
+
+    auto& ept1 = send->registerGlobalEndpoint("send");
+    auto& ept2 = rec->registerGlobalEndpoint("rec");
+    auto& ept3 = rec->registerGlobalEndpoint("rec2");
+
+    auto& drop = helics::make_filter(helics::FilterTypes::RANDOM_DROP, rec.get(), "drop");
+    drop.set("prob", 1.0);
+    drop.addDestinationTarget("rec");
+
+    send->enterExecutingModeAsync();
+    rec->enterExecutingMode();
+    send->enterExecutingModeComplete();
+
+    for (int ii = 0; ii < 3; ++ii) {
+        ept1.sendTo("message", "rec");
+    }
+    ept1.sendTo("message", "rec2");
+    send->requestTimeAsync(1.0);
+    rec->requestTime(1.0);
+    send->requestTimeComplete();
+
+    EXPECT_EQ(ept2.pendingMessageCount(), 0U);
+    EXPECT_EQ(ept3.pendingMessageCount(), 1U);
+
+    send->finalizeAsync();
+    rec->finalize();
+    send->finalizeComplete();
+}
+
 TEST_F(filter, many_filters_multi)
 {
     auto broker = AddBroker("test", 10);
@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <future>
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 #ifndef HELICS_SHARED_LIBRARY
 #    include "testFixtures.hpp"
 #else
@@ -563,6 +564,45 @@ TEST_F(multiInput, max_units)
     vFed1->finalize();
 }
 
+TEST_F(multiInput, sum_units_many)
+{
+    using namespace helics;
+    SetupTest<ValueFederate>("test", 1, 1.0);
+    auto vFed1 = GetFederateAs<ValueFederate>(0);
+
+    constexpr int pubCount{37};
+    std::vector<Publication*> pubs;
+    auto& in1 = vFed1->registerInput<double>("", "m");
+    for (int ii = 0; ii < pubCount; ++ii) {
+        auto& pub = vFed1->registerGlobalPublication<double>("pub" + std::to_string(ii), "km");
+        in1.addTarget(pub.getName());
+        pubs.push_back(&pub);
+    }
+    in1.setOption(helics::defs::MULTI_INPUT_HANDLING_METHOD,
+                  helics::MultiInputHandlingMethod::SUM_OPERATION);
+    vFed1->enterExecutingMode();
+
+    double expected{0.0};
+    for (int ii = 0; ii < pubCount; ++ii) {
+        pubs[ii]->publish(0.5 * ii);
+        expected += 500.0 * ii;
+    }
+    vFed1->requestNextStep();
+    EXPECT_DOUBLE_EQ(in1.getValue<double>(), expected);
+
+    pubs[5]->publish(-2.0);
+    expected -= 2000.0 + 2500.0;
+    vFed1->requestNextStep();
+    EXPECT_DOUBLE_EQ(in1.getValue<double>(), expected);
+
+    in1.setOption(helics::defs::MULTI_INPUT_HANDLING_METHOD,
+                  helics::MultiInputHandlingMethod::MAX_OPERATION);
+    pubs[0]->publish(100.0);
+    vFed1->requestNextStep();
+    EXPECT_DOUBLE_EQ(in1.getValue<double>(), 100000.0);
+    vFed1->finalize();
+}
+
 TEST_F(multiInput, file_config_json)
 {
     helics::ValueFederate vFed(std::string(TEST_DIR) + "multi_input_config.json");
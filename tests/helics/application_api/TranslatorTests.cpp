@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/Translator.hpp"
 #include "helics/application_api/TranslatorOperations.hpp"
 #include "helics/application_api/ValueFederate.hpp"
+#include "helics/core/core-exceptions.hpp"
 
 #ifndef HELICS_SHARED_LIBRARY
 #    include "helics/core/Broker.hpp"
@@ -898,6 +899,139 @@ TEST_F(TranslatorFixture, translator_multiinput)
     FullDisconnect();
 }
 
+TEST_F(TranslatorFixture, translator_multiinput_2fed)
+{
+    auto broker = AddBroker("test", 2);
+
+    AddFederates<helics::CombinationFederate>("test", 1, broker, 1.0, "A");
+    AddFederates<helics::CombinationFederate>("test", 1, broker, 1.0, "B");
+    auto cFed1 = GetFederateAs<helics::CombinationFederate>(0);
+    auto cFed2 = GetFederateAs<helics::CombinationFederate>(1);
+
+    auto& endpoint1 = cFed1->registerGlobalTargetedEndpoint("e1", "any");
+    auto& input1 = cFed1->registerGlobalInput<double>("i1");
+    auto& input2 = cFed2->registerGlobalInput<double>("i2");
+    endpoint1.setOption(HELICS_HANDLE_OPTION_CONNECTION_REQUIRED);
+
+    // the value from the translator goes to inputs on two different federates
+    input1.addSourceTarget("t1");
+    input2.addSourceTarget("t1");
+    endpoint1.addDestinationTarget("t1");
+
+    cFed1->registerGlobalTranslator(helics::TranslatorTypes::JSON, "t1");
+
+    cFed2->enterExecutingModeAsync();
+    EXPECT_NO_THROW(cFed1->enterExecutingMode());
+    cFed2->enterExecutingModeComplete();
+
+    auto data = helics::typeConvert(helics::DataType::HELICS_JSON, 20.7);
+    endpoint1.send(data.to_string());
+    cFed1->requestTimeAsync(3.0);
+    EXPECT_LE(cFed2->requestTime(3.0), 3.0);
+    EXPECT_LE(cFed1->requestTimeComplete(), 3.0);
+
+    EXPECT_TRUE(input1.isUpdated());
+    EXPECT_DOUBLE_EQ(input1.getValue<double>(), 20.7);
+    EXPECT_TRUE(input2.isUpdated());
+    EXPECT_DOUBLE_EQ(input2.getValue<double>(), 20.7);
+
+    cFed1->finalize();
+    cFed2->finalize();
+    FullDisconnect();
+}
+
+TEST_F(TranslatorFixture, translator_schema_round_trip)
+{
+    auto broker = AddBroker("test", 1);
+
+    AddFederates<helics::CombinationFederate>("test", 1, broker, helics::timeZero, "A");
+
+    auto cFed1 = GetFederateAs<helics::CombinationFederate>(0);
+
+    auto& endpoint1 = cFed1->registerGlobalTargetedEndpoint("e1", "any");
+    auto& endpoint2 = cFed1->registerGlobalTargetedEndpoint("e2", "any");
+    auto& input1 = cFed1->registerGlobalInput<double>("i1");
+    auto& input2 = cFed1->registerGlobalInput<double>("i2");
+    auto& pub1 = cFed1->registerGlobalPublication<double>("p1");
+    pub1.setOption(HELICS_HANDLE_OPTION_CONNECTION_REQUIRED);
+    endpoint1.setOption(HELICS_HANDLE_OPTION_CONNECTION_REQUIRED);
+    input1.setOption(HELICS_HANDLE_OPTION_CONNECTION_REQUIRED);
+
+    endpoint1.addSourceEndpoint("t1");
+    endpoint2.addSourceEndpoint("t1");
+    pub1.addInputTarget("t1");
+    input1.addPublication("t1");
+    input2.addPublication("t1");
+    endpoint1.addDestinationEndpoint("t1");
+
+    auto& translator1 = cFed1->registerGlobalTranslator(helics::TranslatorTypes::JSON, "t1");
+    translator1.setString("schema", "double");
+    EXPECT_THROW(translator1.setString("schema", "not_a_type"), helics::InvalidParameter);
+
+    EXPECT_NO_THROW(cFed1->enterExecutingMode());
+
+    pub1.publish(20.7);
+    auto tres = cFed1->requestTime(2.0);
+    EXPECT_LT(tres, 2.0);
+    ASSERT_TRUE(endpoint1.hasMessage());
+    ASSERT_TRUE(endpoint2.hasMessage());
+    auto message = endpoint1.getMessage();
+    auto message2 = endpoint2.getMessage();
+    EXPECT_EQ(message->data.to_string(), message2->data.to_string());
+
+    auto json = helics::fileops::loadJsonStr(message->data.to_string());
+    EXPECT_DOUBLE_EQ(json["value"].get<double>(), 20.7);
+    EXPECT_EQ(json["type"].get<std::string>(), "double");
+
+    message->dest.clear();
+    endpoint1.send(std::move(message));
+    auto tres2 = cFed1->requestTime(2.0);
+    EXPECT_GT(tres2, tres);
+    EXPECT_TRUE(input1.isUpdated());
+    EXPECT_TRUE(input2.isUpdated());
+    EXPECT_DOUBLE_EQ(input1.getDouble(), 20.7);
+    EXPECT_DOUBLE_EQ(input2.getDouble(), 20.7);
+
+    // a message that does not match the schema still goes through the general conversion
+    endpoint1.send(R"({"type":"int64","value":12})");
+    cFed1->requestTime(2.0);
+    EXPECT_TRUE(input1.isUpdated());
+    EXPECT_DOUBLE_EQ(input1.getDouble(), 12.0);
+    cFed1->finalize();
+    FullDisconnect();
+}
+
+TEST_F(TranslatorFixture, translator_schema_int)
+{
+    auto broker = AddBroker("test", 1);
+
+    AddFederates<helics::CombinationFederate>("test", 1, broker, helics::timeZero, "A");
+
+    auto cFed1 = GetFederateAs<helics::CombinationFederate>(0);
+
+    auto& endpoint1 = cFed1->registerGlobalTargetedEndpoint("e1", "any");
+    auto& input1 = cFed1->registerGlobalInput<std::int64_t>("i1");
+    input1.addPublication("t1");
+    endpoint1.addDestinationEndpoint("t1");
+
+    auto& translator1 = cFed1->registerGlobalTranslator(helics::TranslatorTypes::JSON, "t1");
+    translator1.setString("schema", "int64");
+
+    EXPECT_NO_THROW(cFed1->enterExecutingMode());
+    // integers beyond the precision of a double are kept exact
+    endpoint1.send(R"({"type":"int64","value":9007199254740993})");
+    cFed1->requestTime(1.0);
+    EXPECT_TRUE(input1.isUpdated());
+    EXPECT_EQ(input1.getInteger(), 9007199254740993LL);
+
+    endpoint1.send(R"({"type":"int64","value":12.7})");
+    cFed1->requestTime(2.0);
+    EXPECT_TRUE(input1.isUpdated());
+    EXPECT_EQ(input1.getInteger(), 12);
+    cFed1->finalize();
+    FullDisconnect();
+}
+
 TEST_F(TranslatorFixture, translator_config)
 {
     auto broker = AddBroker("test", 1);
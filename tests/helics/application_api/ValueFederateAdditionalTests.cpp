@@ -15,12 +15,15 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "testFixtures.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <fstream>
 #include <future>
 #include <gtest/gtest.h>
 #include <memory>
 #include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -769,6 +772,52 @@ TEST(valuefederate, toml_file_loadb)
     vFed.disconnect();
 }
 
+class valuefed_multicast_tests:
+    public ::testing::TestWithParam<const char*>,
+    public FederateTestFixture {};
+
+/** a publication with several inputs in each federate routed through local federates, other cores
+and sub brokers*/
+TEST_P(valuefed_multicast_tests, multicast_routing)
+{
+    constexpr int fedCount{4};
+    SetupTest<helics::ValueFederate>(GetParam(), fedCount);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto& pub1 = vFed1->registerGlobalPublication<double>("pub1");
+    std::vector<helics::Input*> inputs;
+    for (int ii = 0; ii < fedCount; ++ii) {
+        auto vFed = GetFederateAs<helics::ValueFederate>(ii);
+        inputs.push_back(&vFed->registerSubscription("pub1"));
+        inputs.push_back(&vFed->registerSubscription("pub1"));
+    }
+    for (int ii = 1; ii < fedCount; ++ii) {
+        GetFederateAs<helics::ValueFederate>(ii)->enterExecutingModeAsync();
+    }
+    vFed1->enterExecutingMode();
+    for (int ii = 1; ii < fedCount; ++ii) {
+        GetFederateAs<helics::ValueFederate>(ii)->enterExecutingModeComplete();
+    }
+    pub1.publish(27.5);
+    for (int ii = 1; ii < fedCount; ++ii) {
+        GetFederateAs<helics::ValueFederate>(ii)->requestTimeAsync(1.0);
+    }
+    EXPECT_EQ(vFed1->requestTime(1.0), 1.0);
+    for (int ii = 1; ii < fedCount; ++ii) {
+        EXPECT_EQ(GetFederateAs<helics::ValueFederate>(ii)->requestTimeComplete(), 1.0);
+    }
+    for (auto* input : inputs) {
+        EXPECT_TRUE(input->isUpdated());
+        EXPECT_EQ(input->getDouble(), 27.5);
+    }
+    for (int ii = 0; ii < fedCount; ++ii) {
+        GetFederateAs<helics::ValueFederate>(ii)->finalize();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(valuefed,
+                         valuefed_multicast_tests,
+                         ::testing::Values("test", "test_5", "test_6", "test_7"));
+
 TEST(valuefederate, toml_file_bad)
 {
     EXPECT_THROW(helics::ValueFederate vFed(std::string(TEST_DIR) + "example_value_fed_bad.toml"),
@@ -1203,6 +1252,131 @@ TEST(valuefederate, update_query)
     Fed1->finalize();
 }
 
+TEST(valuefederate, updated_values)
+{
+    helics::FederateInfo fedInfo(helics::CoreType::TEST);
+    fedInfo.coreName = "core_upd_values";
+    fedInfo.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fedInfo);
+    std::vector<helics::Publication*> pubs;
+    for (int ii = 0; ii < 5; ++ii) {
+        pubs.push_back(&Fed1->registerIndexedPublication<double>("pub", ii));
+        Fed1->registerIndexedSubscription("pub", ii);
+    }
+    Fed1->enterExecutingMode();
+    pubs[1]->publish(2.5);
+    pubs[3]->publish(7.0);
+    pubs[4]->publish(-1.0);
+    Fed1->requestNextStep();
+
+    std::vector<double> values(5, 0.0);
+    std::vector<int> indices(5, -1);
+    // only room for two of the updates
+    auto count = Fed1->getUpdatedValues(values.data(), indices.data(), 2);
+    ASSERT_EQ(count, 2);
+    EXPECT_EQ(indices[0], 1);
+    EXPECT_EQ(indices[1], 3);
+    EXPECT_DOUBLE_EQ(values[0], 2.5);
+    EXPECT_DOUBLE_EQ(values[1], 7.0);
+    EXPECT_FALSE(Fed1->getInput(1).isUpdated());
+    EXPECT_TRUE(Fed1->getInput(4).isUpdated());
+
+    auto remaining = Fed1->getUpdatedValues();
+    ASSERT_EQ(remaining.first.size(), 1U);
+    EXPECT_EQ(remaining.first[0], 4);
+    EXPECT_DOUBLE_EQ(remaining.second[0], -1.0);
+    EXPECT_TRUE(Fed1->queryUpdates().empty());
+
+    pubs[0]->publish(4.0);
+    pubs[2]->publish(9.7);
+    Fed1->requestNextStep();
+    std::vector<std::int64_t> ivalues(5, 0);
+    count = Fed1->getUpdatedValues(ivalues.data(), nullptr, 5);
+    ASSERT_EQ(count, 2);
+    EXPECT_EQ(ivalues[0], 4);
+    EXPECT_EQ(ivalues[1], 10);
+    EXPECT_EQ(Fed1->getUpdatedValues(ivalues.data(), nullptr, 5), 0);
+
+    Fed1->finalize();
+}
+
+TEST(valuefederate, updated_values_other_types)
+{
+    helics::FederateInfo fedInfo(helics::CoreType::TEST);
+    fedInfo.coreName = "core_upd_values_types";
+    fedInfo.coreInitString = "-f 1 --autobroker";
+
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fedInfo);
+    auto& pubDouble = Fed1->registerGlobalPublication<double>("pub_double");
+    auto& pubString = Fed1->registerGlobalPublication<std::string>("pub_string");
+    auto& pubVector = Fed1->registerGlobalPublication<std::vector<double>>("pub_vector");
+    auto& inpDouble = Fed1->registerSubscription("pub_double");
+    auto& inpString = Fed1->registerSubscription("pub_string");
+    auto& inpVector = Fed1->registerSubscription("pub_vector");
+    Fed1->enterExecutingMode();
+    pubDouble.publish(3.5);
+    pubString.publish("a string");
+    pubVector.publish(std::vector<double>{1.0, 2.0});
+    Fed1->requestNextStep();
+
+    auto updates = Fed1->getUpdatedValues();
+    ASSERT_EQ(updates.first.size(), 1U);
+    EXPECT_EQ(updates.first[0], 0);
+    EXPECT_DOUBLE_EQ(updates.second[0], 3.5);
+    EXPECT_FALSE(inpDouble.isUpdated());
+    // the string and vector updates are left for reads of their own type
+    EXPECT_TRUE(inpString.isUpdated());
+    EXPECT_TRUE(inpVector.isUpdated());
+    EXPECT_EQ(inpString.getValue<std::string>(), "a string");
+    EXPECT_EQ(inpVector.getValue<std::vector<double>>(), (std::vector<double>{1.0, 2.0}));
+
+    Fed1->finalize();
+}
+
+TEST(valuefederate, parallel_input_callbacks)
+{
+    helics::FederateInfo fedInfo(helics::CoreType::TEST);
+    fedInfo.coreName = "core_par_callbacks";
+    fedInfo.coreInitString = "-f 1 --autobroker";
+
+    constexpr int inputCount{40};
+    auto Fed1 = std::make_shared<helics::ValueFederate>("vfed1", fedInfo);
+    std::vector<helics::Publication*> pubs;
+    std::vector<std::atomic<int>> calls(inputCount);
+    std::vector<double> received(inputCount, 0.0);
+    for (int ii = 0; ii < inputCount; ++ii) {
+        pubs.push_back(&Fed1->registerIndexedPublication<double>("pub", ii));
+        auto& sub = Fed1->registerIndexedSubscription("pub", ii);
+        Fed1->setInputNotificationCallback(sub, [&, ii](helics::Input& inp, helics::Time /*time*/) {
+            received[ii] = inp.getValue<double>();
+            ++calls[ii];
+        });
+    }
+    Fed1->setInputCallbackThreads(4);
+    Fed1->enterExecutingMode();
+    for (int step = 1; step <= 3; ++step) {
+        for (int ii = 0; ii < inputCount; ++ii) {
+            pubs[ii]->publish(static_cast<double>(ii * step));
+        }
+        Fed1->requestNextStep();
+        for (int ii = 0; ii < inputCount; ++ii) {
+            EXPECT_EQ(calls[ii].load(), step);
+            EXPECT_DOUBLE_EQ(received[ii], static_cast<double>(ii * step));
+        }
+    }
+    // exceptions thrown in a callback are passed back through the time request
+    Fed1->setInputNotificationCallback(Fed1->getInput(7), [](helics::Input& /*inp*/, helics::Time) {
+        throw(std::runtime_error("callback failure"));
+    });
+    pubs[7]->publish(1.0);
+    pubs[8]->publish(1.0);
+    EXPECT_THROW(Fed1->requestNextStep(), std::runtime_error);
+    EXPECT_EQ(calls[8].load(), 4);
+    Fed1->setInputCallbackThreads(1);
+    Fed1->finalize();
+}
+
 TEST(valuefederate, indexed_targets)
 {
     helics::FederateInfo fedInfo(helics::CoreType::TEST);
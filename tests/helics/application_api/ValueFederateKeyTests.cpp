@@ -22,6 +22,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #else
 #    include "testFixtures_shared.hpp"
 #endif
+#include <complex>
 #include <fstream>
 #include <memory>
 #include <streambuf>
@@ -1547,3 +1548,41 @@ TEST_F(valuefed, input_change_restrict)
     EXPECT_LE(returned.size(), 21);
     EXPECT_GE(returned.size(), 19);
 }
+
+TEST_F(valuefed, publish_delta_encoding)
+{
+    SetupTest<helics::ValueFederate>("test", 1);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+
+    auto& pub1 = vFed1->registerGlobalPublication<std::vector<double>>("pub1");
+    auto& pub2 = vFed1->registerGlobalPublication<std::vector<std::complex<double>>>("pub2");
+
+    auto& sub1 = vFed1->registerSubscription("pub1");
+    auto& sub2 = vFed1->registerSubscription("pub2");
+    vFed1->setProperty(HELICS_PROPERTY_TIME_DELTA, 1.0);
+    pub1.setOption(HELICS_HANDLE_OPTION_DELTA_ENCODING, 5);
+    pub2.setOption(HELICS_HANDLE_OPTION_DELTA_ENCODING);
+    EXPECT_EQ(pub1.getOption(HELICS_HANDLE_OPTION_DELTA_ENCODING), 5);
+
+    vFed1->enterExecutingMode();
+    std::vector<double> values(1000, 1.0);
+    std::vector<std::complex<double>> cvalues(200, {1.0, -1.0});
+    for (int ii = 0; ii < 20; ++ii) {
+        values[(ii * 37) % values.size()] += 0.5;
+        values[(ii * 101) % values.size()] = -static_cast<double>(ii);
+        cvalues[(ii * 13) % cvalues.size()] += std::complex<double>(0.0, 0.25);
+        pub1.publish(values);
+        pub2.publish(cvalues);
+        vFed1->requestNextStep();
+        ASSERT_TRUE(sub1.isUpdated());
+        EXPECT_EQ(sub1.getValue<std::vector<double>>(), values);
+        ASSERT_TRUE(sub2.isUpdated());
+        EXPECT_EQ(sub2.getValue<std::vector<std::complex<double>>>(), cvalues);
+    }
+    // a change in size requires a full value
+    values.resize(10, 2.0);
+    pub1.publish(values);
+    vFed1->requestNextStep();
+    EXPECT_EQ(sub1.getValue<std::vector<double>>(), values);
+    vFed1->finalize();
+}
@@ -14,6 +14,8 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/ValueFederate.hpp"
 #include "units/units/units.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <future>
 #include <memory>
 #include <string>
@@ -529,3 +531,62 @@ TEST(inputObject, units)
     EXPECT_NEAR(val3, 40.0, 0.0001);
     vFed->finalize();
 }
+
+TEST(inputObject, vector_units)
+{
+    helics::FederateInfo fedInfo(CORE_TYPE_TO_TEST);
+    fedInfo.coreInitString = "--autobroker";
+
+    auto vFed = std::make_shared<helics::ValueFederate>("test1", fedInfo);
+
+    auto& subObj1 = vFed->registerSubscription("pub1", "V");
+    auto& subObj2 = vFed->registerSubscription("pub2", "V");
+    auto& subObj3 = vFed->registerSubscription("pub3", "K");
+    auto& subObj4 = vFed->registerSubscription("pub1");
+    auto& p1 = vFed->registerGlobalPublication<std::vector<double>>("pub1", "kV");
+    auto& p2 = vFed->registerGlobalPublication<std::vector<std::complex<double>>>("pub2", "kV");
+    auto& p3 = vFed->registerGlobalPublication<std::vector<double>>("pub3", "degC");
+
+    vFed->enterExecutingMode();
+    std::vector<double> voltages(10000);
+    for (std::size_t ii = 0; ii < voltages.size(); ++ii) {
+        voltages[ii] = 0.001 * static_cast<double>(ii);
+    }
+    p1.publish(voltages);
+    p2.publish(std::vector<std::complex<double>>{{1.0, -0.5}, {0.25, 2.0}});
+    p3.publish(std::vector<double>{0.0, 100.0});
+
+    vFed->requestTime(1.0);
+
+    auto val1 = subObj1.getValue<std::vector<double>>();
+    ASSERT_EQ(val1.size(), voltages.size());
+    double maxError{0.0};
+    for (std::size_t ii = 0; ii < voltages.size(); ++ii) {
+        maxError = std::max(maxError, std::abs(val1[ii] - voltages[ii] * 1000.0));
+    }
+    EXPECT_LT(maxError, 1e-8);
+
+    auto val2 = subObj2.getValue<std::vector<std::complex<double>>>();
+    ASSERT_EQ(val2.size(), 2U);
+    EXPECT_NEAR(val2[0].real(), 1000.0, 1e-9);
+    EXPECT_NEAR(val2[0].imag(), -500.0, 1e-9);
+    EXPECT_NEAR(val2[1].real(), 250.0, 1e-9);
+    EXPECT_NEAR(val2[1].imag(), 2000.0, 1e-9);
+
+    auto val3 = subObj3.getValue<std::vector<double>>();
+    ASSERT_EQ(val3.size(), 2U);
+    EXPECT_NEAR(val3[0], 273.15, 1e-9);
+    EXPECT_NEAR(val3[1], 373.15, 1e-9);
+
+    // no units on the subscription so no conversion
+    auto val4 = subObj4.getValue<std::vector<double>>();
+    EXPECT_EQ(val4, voltages);
+
+    p1.publish(std::vector<double>{1.5, -2.0});
+    vFed->requestTime(2.0);
+    std::vector<double> raw(4, 0.0);
+    EXPECT_EQ(subObj1.getValue(raw.data(), 4), 2);
+    EXPECT_NEAR(raw[0], 1500.0, 1e-9);
+    EXPECT_NEAR(raw[1], -2000.0, 1e-9);
+    vFed->finalize();
+}
@@ -13,8 +13,11 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/apps/BrokerApp.hpp"
 #include "helics/apps/Player.hpp"
 
+#include <filesystem>
+#include <fstream>
 #include <future>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <thread>
 #include <vector>
@@ -346,6 +349,144 @@ TEST(player_tests, testfile)
     EXPECT_EQ(results[2][1], 63.0);
 }
 
+TEST(player_tests, mapped_playback)
+{
+    // work on a copy so the index is not written into the test directory
+    const std::string mappedFile = "mapped_oorder.txt";
+    std::filesystem::copy_file(std::string(TEST_DIR) + "oorder.txt",
+                               mappedFile,
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(mappedFile + ".pidx");
+
+    for (int run = 0; run < 2; ++run) {
+        helics::FederateInfo fedInfo(helics::CoreType::TEST);
+        fedInfo.coreName = "pcoremapped" + std::to_string(run);
+        fedInfo.coreInitString = "-f 2 --autobroker";
+        helics::apps::Player play1("player1", fedInfo);
+        // a small look ahead so the points are decoded in several windows
+        play1.enableMappedPlayback(16);
+        play1.loadFile(mappedFile);
+        // the sidecar index is created on the first run and reused on the second
+        EXPECT_TRUE(std::filesystem::exists(mappedFile + ".pidx"));
+        EXPECT_EQ(play1.pointCount(), 131U);
+
+        helics::ValueFederate vfed("receiver", fedInfo);
+        vfed.registerSubscription("player1/G");
+        vfed.registerSubscription("player1/T");
+        vfed.registerSubscription("player1/Fc");
+        vfed.registerSubscription("player1/Ud");
+        vfed.registerSubscription("player1/Rg");
+        vfed.registerSubscription("player1/ctl");
+
+        std::vector<std::vector<double>> results;
+        results.resize(6);
+
+        auto fut = std::async(std::launch::async, [&play1]() { play1.runTo(8.0); });
+        vfed.enterExecutingMode();
+        auto retTime = vfed.requestTime(8.0);
+
+        while (retTime <= 7.0) {
+            for (int ii = 0; ii < 6; ++ii) {
+                auto& inp = vfed.getInput(ii);
+                if (inp.isUpdated()) {
+                    results[ii].push_back(inp.getDouble());
+                }
+            }
+            retTime = vfed.requestTime(7.0);
+        }
+
+        vfed.finalize();
+        fut.get();
+        EXPECT_GE(results[0].size(), 120U);
+        EXPECT_EQ(results[1].size(), 2U);
+        EXPECT_EQ(results[5].size(), 2U);
+        ASSERT_EQ(results[2].size(), 2U);
+        EXPECT_EQ(results[2][1], 63.0);
+        EXPECT_EQ(play1.publicationCount(), 6U);
+    }
+    std::filesystem::remove(mappedFile);
+    std::filesystem::remove(mappedFile + ".pidx");
+}
+
+TEST(player_tests, mapped_index_runs)
+{
+    const std::string mappedFile = "mapped_runs_oorder.txt";
+    std::filesystem::copy_file(std::string(TEST_DIR) + "oorder.txt",
+                               mappedFile,
+                               std::filesystem::copy_options::overwrite_existing);
+    auto readIndex = [&mappedFile]() {
+        std::ifstream indexFile(mappedFile + ".pidx", std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(indexFile),
+                           std::istreambuf_iterator<char>());
+    };
+    std::string sortedIndex;
+    // the index built in a single run matches the one merged from many small sorted runs
+    for (std::size_t runSize : {std::size_t{1048576}, std::size_t{8}, std::size_t{1}}) {
+        std::filesystem::remove(mappedFile + ".pidx");
+        helics::FederateInfo fedInfo(helics::CoreType::TEST);
+        fedInfo.coreName = "pcoremappedruns" + std::to_string(runSize);
+        fedInfo.coreInitString = "-f 1 --autobroker";
+        helics::apps::Player play1("player1", fedInfo);
+        play1.enableMappedPlayback(16, runSize);
+        play1.loadFile(mappedFile);
+        EXPECT_EQ(play1.pointCount(), 131U);
+        auto index = readIndex();
+        EXPECT_FALSE(index.empty());
+        if (sortedIndex.empty()) {
+            sortedIndex = std::move(index);
+        } else {
+            EXPECT_EQ(index, sortedIndex);
+        }
+        play1.finalize();
+    }
+    EXPECT_FALSE(std::filesystem::exists(mappedFile + ".pidx.points.tmp"));
+    EXPECT_FALSE(std::filesystem::exists(mappedFile + ".pidx.messages.tmp"));
+    std::filesystem::remove(mappedFile);
+    std::filesystem::remove(mappedFile + ".pidx");
+}
+
+TEST(player_tests, mapped_playback_messages)
+{
+    const std::string mappedFile = "mapped_message1.player";
+    std::filesystem::copy_file(std::string(TEST_DIR) + "example_message1.player",
+                               mappedFile,
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(mappedFile + ".pidx");
+
+    helics::FederateInfo fedInfo(helics::CoreType::TEST);
+    fedInfo.coreName = "pcoremappedmess";
+    fedInfo.coreInitString = "-f 2 --autobroker";
+    helics::apps::Player play1("player1", fedInfo);
+    play1.enableMappedPlayback(1);
+    play1.loadFile(mappedFile);
+    // messages added directly are merged with the mapped messages
+    play1.addMessage(1.5, "src", "dest", "this is a direct message");
+    EXPECT_EQ(play1.messageCount(), 4U);
+
+    helics::MessageFederate mfed("block1", fedInfo);
+    helics::Endpoint ept1(helics::InterfaceVisibility::GLOBAL, &mfed, "dest");
+    auto fut = std::async(std::launch::async, [&play1]() { play1.run(); });
+    mfed.enterExecutingMode();
+
+    const std::vector<std::pair<double, std::string>> expected{
+        {1.0, "this is a test message"},
+        {1.5, "this is a direct message"},
+        {2.0, "this is test message2"},
+        {3.0, "this is message 3"}};
+    for (const auto& result : expected) {
+        auto retTime = mfed.requestTime(5);
+        EXPECT_EQ(retTime, result.first);
+        auto mess = ept1.getMessage();
+        ASSERT_TRUE(mess);
+        EXPECT_EQ(mess->source, "src");
+        EXPECT_EQ(mess->data.to_string(), result.second);
+    }
+    mfed.finalize();
+    fut.get();
+    std::filesystem::remove(mappedFile);
+    std::filesystem::remove(mappedFile + ".pidx");
+}
+
 TEST(player_tests, simple_player_mlinecomment)
 {
     static char index = 'a';
@@ -13,9 +13,11 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/application_api/Publications.hpp"
 #include "helics/apps/BrokerApp.hpp"
 #include "helics/apps/Recorder.hpp"
+#include "helics/apps/RecorderStream.hpp"
 
 #include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <future>
 #include <string>
 #include <thread>
@@ -748,6 +750,128 @@ TEST(recorder_tests, recorder_test_saveFile3)
     std::filesystem::remove(filename2);
 }
 
+TEST(recorder_tests, recorder_test_stream_binary)
+{
+    helics::FederateInfo fedInfo(helics::CoreType::TEST);
+    fedInfo.coreName = "rcore-stream1";
+    fedInfo.coreInitString = "-f 2 --autobroker";
+    helics::apps::Recorder rec1("rec1", fedInfo);
+    auto filename = std::filesystem::temp_directory_path() / "streamfile.hcap";
+    auto filename2 = std::filesystem::temp_directory_path() / "streamfile_1.hcap";
+    rec1.enableStreaming(filename.string(), 0, 2.0);
+
+    rec1.addSubscription("pub1");
+    rec1.addEndpoint("src1");
+
+    helics::CombinationFederate cfed("block1", fedInfo);
+    helics::Publication pub1(helics::InterfaceVisibility::GLOBAL,
+                             &cfed,
+                             "pub1",
+                             helics::DataType::HELICS_DOUBLE);
+    helics::Endpoint e1(helics::InterfaceVisibility::GLOBAL, &cfed, "d1");
+    auto fut = std::async(std::launch::async, [&rec1]() { rec1.runTo(4); });
+    cfed.enterExecutingMode();
+    auto retTime = cfed.requestTime(1);
+    EXPECT_EQ(retTime, 1.0);
+    pub1.publish(3.4);
+    e1.sendTo("this is a test message", "src1");
+
+    retTime = cfed.requestTime(2.0);
+    EXPECT_EQ(retTime, 2.0);
+    pub1.publish(4.7);
+
+    retTime = cfed.requestTime(3.0);
+    EXPECT_EQ(retTime, 3.0);
+    pub1.publish(5.1);
+
+    retTime = cfed.requestTime(5);
+    EXPECT_EQ(retTime, 5.0);
+
+    cfed.finalize();
+    fut.get();
+    rec1.finalize();
+    EXPECT_EQ(rec1.pointCount(), 3U);
+    EXPECT_EQ(rec1.messageCount(), 1U);
+    // the values are not held in memory in streaming mode
+    EXPECT_FALSE(rec1.getMessage(0));
+
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    ASSERT_TRUE(std::filesystem::exists(filename2));
+
+    helics::apps::CaptureFileReader reader;
+    ASSERT_TRUE(reader.open(filename.string()));
+    EXPECT_TRUE(reader.isComplete());
+    auto points = reader.readPoints("pub1");
+    ASSERT_EQ(points.size(), 1U);
+    EXPECT_EQ(points[0].time, 1.0);
+    EXPECT_EQ(points[0].value, std::to_string(3.4));
+    EXPECT_EQ(reader.getKeys()[points[0].index].type, "double");
+    auto messages = reader.readMessages();
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_EQ(messages[0]->data.to_string(), "this is a test message");
+    EXPECT_EQ(messages[0]->dest, "src1");
+
+    helics::apps::CaptureFileReader reader2;
+    ASSERT_TRUE(reader2.open(filename2.string()));
+    points = reader2.readPoints("pub1");
+    ASSERT_EQ(points.size(), 2U);
+    EXPECT_EQ(points[1].time, 3.0);
+    EXPECT_EQ(points[1].value, std::to_string(5.1));
+    EXPECT_TRUE(reader2.readMessages().empty());
+
+    std::filesystem::remove(filename);
+    std::filesystem::remove(filename2);
+}
+
+TEST(recorder_tests, recorder_test_stream_text)
+{
+    auto filename = std::filesystem::temp_directory_path() / "streamfile.txt";
+    {
+        helics::FederateInfo fedInfo(helics::CoreType::TEST);
+        fedInfo.coreName = "rcore-stream2";
+        fedInfo.coreInitString = "-f 2 --autobroker";
+        helics::apps::Recorder rec1("rec1", fedInfo);
+        rec1.enableStreaming(filename.string());
+        rec1.addSubscription("pub1");
+
+        helics::ValueFederate vfed("block1", fedInfo);
+        helics::Publication pub1(helics::InterfaceVisibility::GLOBAL,
+                                 &vfed,
+                                 "pub1",
+                                 helics::DataType::HELICS_DOUBLE);
+        auto fut = std::async(std::launch::async, [&rec1]() { rec1.runTo(4); });
+        vfed.enterExecutingMode();
+        auto retTime = vfed.requestTime(1);
+        EXPECT_EQ(retTime, 1.0);
+        pub1.publish(3.4);
+
+        retTime = vfed.requestTime(2.0);
+        EXPECT_EQ(retTime, 2.0);
+        pub1.publish(4.7);
+
+        retTime = vfed.requestTime(5);
+        EXPECT_EQ(retTime, 5.0);
+
+        vfed.finalize();
+        fut.get();
+        rec1.finalize();
+        EXPECT_EQ(rec1.pointCount(), 2U);
+    }
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    std::ifstream in(filename);
+    std::string line;
+    int valueLines{0};
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.front() != '#') {
+            ++valueLines;
+            EXPECT_NE(line.find("pub1"), std::string::npos);
+        }
+    }
+    EXPECT_EQ(valueLines, 2);
+    in.close();
+    std::filesystem::remove(filename);
+}
+
 TEST(recorder_tests, recorder_test_help)
 {
     std::vector<std::string> args{"--quiet", "--version"};
@@ -0,0 +1,230 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/common/JsonBuilder.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
+#include "nlohmann/json.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+using helics::fileops::JsonMapBuilder;
+using helics::fileops::JsonMapHistory;
+using helics::fileops::JsonStreamWriter;
+using helics::fileops::loadJsonStr;
+
+TEST(jsonStreamWriter, nested)
+{
+    std::string output;
+    JsonStreamWriter writer(output);
+    writer.beginObject();
+    writer.key("name");
+    writer.value("quote\" slash\\ line\n tab\t \x01");
+    writer.key("values");
+    writer.beginArray();
+    writer.value(std::int64_t{-4});
+    writer.value(std::uint64_t{18});
+    writer.beginObject();
+    writer.endObject();
+    writer.rawValue(R"({"raw":[1,2]})");
+    writer.endArray();
+    writer.key("empty");
+    writer.beginArray();
+    writer.endArray();
+    writer.endObject();
+
+    auto json = loadJsonStr(output);
+    EXPECT_EQ(json["name"].get<std::string>(), "quote\" slash\\ line\n tab\t \x01");
+    ASSERT_EQ(json["values"].size(), 4U);
+    EXPECT_EQ(json["values"][0].get<int>(), -4);
+    EXPECT_EQ(json["values"][1].get<int>(), 18);
+    EXPECT_TRUE(json["values"][2].is_object());
+    EXPECT_EQ(json["values"][3]["raw"][1].get<int>(), 2);
+    EXPECT_TRUE(json["empty"].empty());
+}
+
+TEST(jsonMapBuilder, components)
+{
+    JsonMapBuilder builder;
+    auto& base = builder.getJValue();
+    base["name"] = "broker";
+    base["cores"] = nlohmann::json::array();
+    base["cores"].push_back(nlohmann::json::object({{"state", "disconnected"}}));
+    auto core1 = builder.generatePlaceHolder("cores", 5);
+    auto broker1 = builder.generatePlaceHolder("brokers", 7);
+    auto core2 = builder.generatePlaceHolder("cores", 6);
+    EXPECT_FALSE(builder.addComponent(R"({"id":6})", core2));
+    EXPECT_FALSE(builder.addComponent("not json", broker1));
+    EXPECT_TRUE(builder.addComponent(R"({"id":5, "federates":[]})", core1));
+    EXPECT_TRUE(builder.isCompleted());
+
+    auto json = loadJsonStr(builder.generate());
+    EXPECT_EQ(json["name"].get<std::string>(), "broker");
+    ASSERT_EQ(json["cores"].size(), 3U);
+    EXPECT_EQ(json["cores"][0]["state"].get<std::string>(), "disconnected");
+    EXPECT_EQ(json["cores"][1]["id"].get<int>(), 6);
+    EXPECT_EQ(json["cores"][2]["id"].get<int>(), 5);
+    ASSERT_EQ(json["brokers"].size(), 1U);
+    EXPECT_TRUE(json["brokers"][0].empty());
+
+    // requesting the value merges the components into the document
+    EXPECT_EQ(builder.getJValue(), json);
+    EXPECT_TRUE(builder.getComponents().empty());
+    EXPECT_EQ(loadJsonStr(builder.generate()), json);
+}
+
+TEST(jsonMapHistory, delta)
+{
+    JsonMapBuilder builder;
+    JsonMapHistory history;
+    auto build = [&builder](const std::string& core1, const std::string& core2) {
+        builder.reset();
+        builder.getJValue()["name"] = "root";
+        auto index1 = builder.generatePlaceHolder("cores", 1);
+        auto index2 = builder.generatePlaceHolder("cores", 2);
+        builder.addComponent(core1, index1);
+        if (!core2.empty()) {
+            builder.addComponent(core2, index2);
+        } else {
+            builder.clearComponents(2);
+        }
+    };
+    build(R"({"id":1})", R"({"id":2})");
+    const auto rev1 = history.update(builder);
+    EXPECT_EQ(rev1, 1U);
+    EXPECT_EQ(loadJsonStr(history.snapshot()), loadJsonStr(builder.generate()));
+
+    auto full = loadJsonStr(history.generateDelta(0));
+    EXPECT_EQ(full["revision"].get<std::uint64_t>(), rev1);
+    EXPECT_EQ(full["base"]["name"].get<std::string>(), "root");
+    EXPECT_EQ(full["updated"]["cores"].size(), 2U);
+    EXPECT_FALSE(full.contains("removed"));
+
+    // an identical map does not change the revision
+    build(R"({"id":1})", R"({"id":2})");
+    EXPECT_EQ(history.update(builder), rev1);
+    auto empty = loadJsonStr(history.generateDelta(rev1));
+    EXPECT_FALSE(empty.contains("base"));
+    EXPECT_FALSE(empty.contains("updated"));
+    EXPECT_FALSE(empty.contains("removed"));
+
+    build(R"({"id":1,"state":"executing"})", R"({"id":2})");
+    const auto rev2 = history.update(builder);
+    EXPECT_EQ(rev2, rev1 + 1);
+    auto delta = loadJsonStr(history.generateDelta(rev1));
+    EXPECT_FALSE(delta.contains("base"));
+    ASSERT_EQ(delta["updated"]["cores"].size(), 1U);
+    EXPECT_EQ(delta["updated"]["cores"][0]["state"].get<std::string>(), "executing");
+
+    build(R"({"id":1,"state":"executing"})", "");
+    const auto rev3 = history.update(builder);
+    delta = loadJsonStr(history.generateDelta(rev2));
+    EXPECT_FALSE(delta.contains("updated"));
+    ASSERT_EQ(delta["removed"]["cores"].size(), 1U);
+    EXPECT_EQ(delta["removed"]["cores"][0].get<int>(), 2);
+
+    // changes across several revisions are combined
+    delta = loadJsonStr(history.generateDelta(rev1));
+    EXPECT_EQ(delta["revision"].get<std::uint64_t>(), rev3);
+    EXPECT_EQ(delta["updated"]["cores"].size(), 1U);
+    EXPECT_EQ(delta["removed"]["cores"].size(), 1U);
+
+    // an unknown revision generates everything
+    full = loadJsonStr(history.generateDelta(rev3 + 10));
+    EXPECT_EQ(full["since"].get<std::uint64_t>(), 0U);
+    EXPECT_EQ(full["updated"]["cores"].size(), 1U);
+    EXPECT_FALSE(full.contains("removed"));
+}
+
+TEST(jsonMapBuilder, generate_format)
+{
+    JsonMapBuilder builder;
+    auto& base = builder.getJValue();
+    base["name"] = "brokeré";
+    base["cores"] = nlohmann::json::array();
+    base["cores"].push_back(nlohmann::json::object({{"state", "disconnected"}}));
+    auto core1 = builder.generatePlaceHolder("cores", 5);
+    auto core2 = builder.generatePlaceHolder("cores", 6);
+    auto broker1 = builder.generatePlaceHolder("brokers", 7);
+    auto broker2 = builder.generatePlaceHolder("brokers", 8);
+    builder.addComponent(R"({"federates":[{"id":3,"name":"fed"}],"id":5,"empty":[]})", core1);
+    builder.addComponent(R"({ "name" : "line\n", "id" : 6, "time" : 1.50, "big" : -0 })", core2);
+    builder.addComponent(R"({"a":{},"b":[true,false,null,-12]})", broker1);
+    builder.addComponent(R"({"name":"café"})", broker2);
+    ASSERT_TRUE(builder.isCompleted());
+    // the streamed text matches the formatting of the merged document
+    auto generated = builder.generate();
+    EXPECT_EQ(generated, helics::fileops::generateJsonString(builder.getJValue()));
+}
+
+TEST(jsonMapHistory, element_delta)
+{
+    JsonMapBuilder builder;
+    JsonMapHistory history;
+    auto build = [&builder](const std::string& core) {
+        builder.reset();
+        builder.getJValue()["name"] = "root";
+        builder.addComponent(core, builder.generatePlaceHolder("cores", 1));
+    };
+    build(R"({"id":1,"name":"core1","federates":[{"id":10,"state":"a"},{"id":11,"state":"b"}]})");
+    const auto rev1 = history.update(builder);
+
+    build(R"({"id":1,"name":"core1","federates":[{"id":11,"state":"c"},{"id":12,"state":"d"}]})");
+    const auto rev2 = history.update(builder);
+    EXPECT_EQ(rev2, rev1 + 1);
+    auto delta = loadJsonStr(history.generateDelta(rev1));
+    // only the changed federates are sent
+    ASSERT_EQ(delta["updated"]["cores"].size(), 1U);
+    auto core = delta["updated"]["cores"][0];
+    EXPECT_EQ(core["id"].get<int>(), 1);
+    EXPECT_FALSE(core.contains("name"));
+    ASSERT_EQ(core["federates"].size(), 2U);
+    EXPECT_EQ(core["federates"][0]["id"].get<int>(), 11);
+    EXPECT_EQ(core["federates"][0]["state"].get<std::string>(), "c");
+    EXPECT_EQ(core["federates"][1]["id"].get<int>(), 12);
+    ASSERT_EQ(delta["removed"]["cores"].size(), 1U);
+    EXPECT_EQ(delta["removed"]["cores"][0]["id"].get<int>(), 1);
+    ASSERT_EQ(delta["removed"]["cores"][0]["federates"].size(), 1U);
+    EXPECT_EQ(delta["removed"]["cores"][0]["federates"][0].get<int>(), 10);
+
+    // members which are not element lists are sent whole and removed members are null
+    build(R"({"id":1,"federates":[{"id":11,"state":"c"},{"id":12,"state":"d"}],"tags":[1,2]})");
+    history.update(builder);
+    delta = loadJsonStr(history.generateDelta(rev2));
+    core = delta["updated"]["cores"][0];
+    EXPECT_TRUE(core["name"].is_null());
+    EXPECT_EQ(core["tags"].size(), 2U);
+    EXPECT_FALSE(core.contains("federates"));
+    EXPECT_FALSE(delta.contains("removed"));
+
+    // whitespace changes in a component are not a change
+    const auto rev3 = history.revision();
+    build(R"({"id":1, "federates":[{"id":11,"state":"c"},{"id":12,"state":"d"}],"tags":[1,2]})");
+    EXPECT_EQ(history.update(builder), rev3);
+}
+
+TEST(jsonMapBuilder, reuse_components)
+{
+    JsonMapBuilder builder;
+    builder.getJValue()["name"] = "broker";
+    builder.addComponent(R"({"id":5})", builder.generatePlaceHolder("cores", 5));
+    builder.addComponent(R"({"id":6})", builder.generatePlaceHolder("cores", 6));
+    ASSERT_TRUE(builder.isCompleted());
+    const auto original = builder.generate();
+
+    // carry one component into a rebuilt map and query the other again
+    auto previous = builder.extractComponents();
+    ASSERT_EQ(previous.size(), 2U);
+    builder.reset();
+    builder.getJValue()["name"] = "broker";
+    builder.addComponent(std::move(previous[0]));
+    auto index = builder.generatePlaceHolder("cores", 6);
+    EXPECT_FALSE(builder.isCompleted());
+    EXPECT_TRUE(builder.addComponent(R"({"id":6})", index));
+    EXPECT_EQ(builder.generate(), original);
+}
@@ -0,0 +1,122 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/common/NameMatcher.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using helics::NameMatcher;
+using helics::NamePattern;
+using helics::PatternTier;
+
+TEST(nameMatcher, tiers)
+{
+    EXPECT_EQ(NamePattern("fed1/pub1").tier(), PatternTier::LITERAL);
+    EXPECT_EQ(NamePattern("fed1\\.pub").tier(), PatternTier::LITERAL);
+    EXPECT_EQ(NamePattern("^fed1/pub1$").tier(), PatternTier::LITERAL);
+    EXPECT_EQ(NamePattern("fed1/.*").tier(), PatternTier::PREFIX);
+    EXPECT_EQ(NamePattern(".*").tier(), PatternTier::PREFIX);
+    EXPECT_EQ(NamePattern("fed./pub.*").tier(), PatternTier::GLOB);
+    EXPECT_EQ(NamePattern(".*/voltage").tier(), PatternTier::GLOB);
+    EXPECT_EQ(NamePattern("fed[0-9]+/pub").tier(), PatternTier::REGEX);
+    EXPECT_EQ(NamePattern("fed1/(pub|sub)").tier(), PatternTier::REGEX);
+    EXPECT_EQ(NamePattern("fed\\d/pub").tier(), PatternTier::REGEX);
+    EXPECT_EQ(NamePattern("fed1?/pub").tier(), PatternTier::REGEX);
+
+    EXPECT_EQ(NamePattern("fed1/.*").prefix(), "fed1/");
+    EXPECT_EQ(NamePattern("fed[0-9]+/pub").prefix(), "fed");
+    EXPECT_EQ(NamePattern("fed1?/pub").prefix(), "fed");
+    EXPECT_EQ(NamePattern("fed1|fed2").prefix(), "");
+    EXPECT_THROW(NamePattern("fed[0-9"), std::invalid_argument);
+}
+
+TEST(nameMatcher, pattern_matches)
+{
+    NamePattern glob("fed./pub.*/v");
+    EXPECT_TRUE(glob.matches("fed1/pub/v"));
+    EXPECT_TRUE(glob.matches("fed2/pub_a/b/v"));
+    EXPECT_FALSE(glob.matches("fed12/pub/v"));
+    EXPECT_FALSE(glob.matches("fed1/pub/vv"));
+
+    NamePattern prefix("fed1/.+");
+    EXPECT_EQ(prefix.tier(), PatternTier::GLOB);
+    EXPECT_TRUE(prefix.matches("fed1/a"));
+    EXPECT_FALSE(prefix.matches("fed1/"));
+
+    NamePattern regex("fed[0-9]+/pub");
+    EXPECT_TRUE(regex.matches("fed123/pub"));
+    EXPECT_FALSE(regex.matches("fedx/pub"));
+}
+
+TEST(nameMatcher, consistent_with_regex)
+{
+    const std::vector<std::string> expressions{"fed1/pub1",       "fed1/.*",
+                                               ".*",              "fed./pub.",
+                                               ".*/pub.*",        ".+_a.*b",
+                                               "fed[0-9]+/pub.*", "(fed1|fed3)/.*",
+                                               "fed1\\/pub.",     ".*pub\\.x",
+                                               "f.*1.*",          "^fed2/.*$",
+                                               "fed.?/pub1",      ""};
+    const std::vector<std::string> names{"fed1/pub1",   "fed1/pub2",    "fed2/pub1",
+                                         "fed12/pub1",  "fed3/sub_a",   "fed3/pub.x",
+                                         "fed3/pubax",  "fed1/pub_a_b", "fed",
+                                         "fed1/line\n", "",             "other/pub_a/b",
+                                         "fed1/pub"};
+    std::vector<std::string_view> views(names.begin(), names.end());
+    std::vector<NamePattern> patterns;
+    for (const auto& expression : expressions) {
+        patterns.emplace_back(expression);
+    }
+    NameMatcher matcher(views);
+    auto results = matcher.match(patterns);
+    ASSERT_EQ(results.size(), expressions.size());
+    std::size_t totalMatches{0};
+    for (std::size_t ii = 0; ii < expressions.size(); ++ii) {
+        std::regex reference(expressions[ii]);
+        std::vector<std::string_view> expected;
+        for (const auto& name : names) {
+            EXPECT_EQ(patterns[ii].matches(name), std::regex_match(name, reference))
+                << expressions[ii] << " with " << name;
+            if (std::regex_match(name, reference)) {
+                expected.emplace_back(name);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(results[ii], expected) << expressions[ii];
+        totalMatches += expected.size();
+    }
+    const auto& stats = matcher.statistics();
+    EXPECT_EQ(stats.names, names.size());
+    EXPECT_EQ(stats.matches, totalMatches);
+    EXPECT_EQ(stats.patterns[static_cast<int>(PatternTier::LITERAL)], 2U);
+}
+
+TEST(nameMatcher, prefix_limits_comparisons)
+{
+    std::vector<std::string> names;
+    for (int ii = 0; ii < 100; ++ii) {
+        names.push_back("fed" + std::to_string(ii) + "/pub");
+    }
+    std::vector<std::string_view> views(names.begin(), names.end());
+    NameMatcher matcher(views);
+    std::vector<NamePattern> patterns;
+    patterns.emplace_back("fed5.*");
+    patterns.emplace_back("fed7[0-9]/pub");
+    patterns.emplace_back("fed42/pub");
+    auto results = matcher.match(patterns);
+    EXPECT_EQ(results[0].size(), 11U);
+    EXPECT_EQ(results[1].size(), 10U);
+    EXPECT_EQ(results[2].size(), 1U);
+    // only the names sharing a prefix are tested
+    EXPECT_EQ(matcher.statistics().comparisons, 22U);
+}
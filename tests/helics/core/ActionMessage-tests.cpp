@@ -5,14 +5,19 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
+#include "helics/core/ActionMessageCodec.hpp"
+#include "helics/core/MessagePool.hpp"
 #include "helics/core/flagOperations.hpp"
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace helics;
 
@@ -574,3 +579,213 @@ TEST(ActionMessage, jsonconversion_test_binary_strings2)
     EXPECT_EQ(cmd.flags, cmd2.flags);
     EXPECT_TRUE(cmd.getStringData() == cmd2.getStringData());
 }
+
+TEST(ActionMessage, multicast_destinations)
+{
+    helics::ActionMessage cmd(helics::CMD_MULTICAST_PUB);
+    cmd.source_id = GlobalFederateId{1};
+    cmd.source_handle = InterfaceHandle{2};
+    cmd.actionTime = 12.5;
+    cmd.payload = "test payload";
+    std::vector<helics::GlobalHandle> targets{
+        {GlobalFederateId{131072}, InterfaceHandle{4}},
+        {GlobalFederateId{131072}, InterfaceHandle{7}},
+        {GlobalFederateId{131075}, InterfaceHandle{0}},
+    };
+    helics::setMulticastDestinations(cmd, targets);
+
+    helics::ActionMessage cmd2(cmd.to_string());
+    EXPECT_TRUE(cmd2.action() == helics::CMD_MULTICAST_PUB);
+    EXPECT_EQ(helics::getMulticastDestinations(cmd2), targets);
+
+    auto single = helics::generateMulticastSubset(cmd2, {targets[2]});
+    EXPECT_TRUE(single.action() == helics::CMD_PUB);
+    EXPECT_EQ(single.dest_id, targets[2].fed_id);
+    EXPECT_EQ(single.dest_handle, targets[2].handle);
+    EXPECT_EQ(single.source_handle, cmd.source_handle);
+    EXPECT_EQ(single.actionTime, cmd.actionTime);
+    EXPECT_TRUE(single.payload.empty());
+
+    std::vector<helics::GlobalHandle> subset(targets.begin(), targets.begin() + 2);
+    auto multi = helics::generateMulticastSubset(cmd2, subset);
+    EXPECT_TRUE(multi.action() == helics::CMD_MULTICAST_PUB);
+    EXPECT_EQ(multi.dest_id, targets[0].fed_id);
+    EXPECT_EQ(helics::getMulticastDestinations(multi), subset);
+}
+
+TEST(ActionMessage, compact_encoding)
+{
+    helics::ActionMessage cmd(helics::CMD_TIME_REQUEST);
+    cmd.source_id = GlobalFederateId{131072};
+    cmd.dest_id = GlobalFederateId{131074};
+    cmd.counter = 3;
+    cmd.sequenceID = 5;
+    setActionFlag(cmd, iteration_requested_flag);
+    cmd.actionTime = 45.7;
+    cmd.Te = 46.1;
+    cmd.Tdemin = 45.7;
+    cmd.Tso = helics::Time::maxVal();
+
+    helics::CompactMessageEncoder encoder;
+    std::string data;
+    auto sz = encoder.encode(cmd, data);
+    EXPECT_EQ(sz, data.size());
+    EXPECT_LT(data.size(), cmd.to_string().size());
+    EXPECT_EQ(static_cast<std::byte>(data[0]), helics::compactEncodingMarker);
+
+    helics::ActionMessage cmd2;
+    auto res = cmd2.fromByteArray(reinterpret_cast<const std::byte*>(data.data()), data.size());
+    EXPECT_EQ(res, data.size());
+    EXPECT_TRUE(cmd.action() == cmd2.action());
+    EXPECT_EQ(cmd.source_id, cmd2.source_id);
+    EXPECT_EQ(cmd.dest_id, cmd2.dest_id);
+    EXPECT_EQ(cmd.source_handle, cmd2.source_handle);
+    EXPECT_EQ(cmd.dest_handle, cmd2.dest_handle);
+    EXPECT_EQ(cmd.counter, cmd2.counter);
+    EXPECT_EQ(cmd.sequenceID, cmd2.sequenceID);
+    EXPECT_EQ(cmd.flags, cmd2.flags);
+    EXPECT_EQ(cmd.actionTime, cmd2.actionTime);
+    EXPECT_EQ(cmd.Te, cmd2.Te);
+    EXPECT_EQ(cmd.Tdemin, cmd2.Tdemin);
+    EXPECT_EQ(cmd.Tso, cmd2.Tso);
+
+    // a truncated message should fail
+    helics::ActionMessage cmd3;
+    res = cmd3.fromByteArray(reinterpret_cast<const std::byte*>(data.data()), data.size() - 1);
+    EXPECT_EQ(res, 0U);
+    EXPECT_TRUE(cmd3.action() == helics::CMD_INVALID);
+}
+
+TEST(ActionMessage, compact_packetization_interning)
+{
+    helics::ActionMessage cmd(helics::CMD_SEND_MESSAGE);
+    cmd.source_id = GlobalFederateId(1);
+    cmd.source_handle = InterfaceHandle(2);
+    cmd.dest_id = GlobalFederateId(3);
+    cmd.dest_handle = InterfaceHandle(4);
+    setActionFlag(cmd, required_flag);
+    cmd.actionTime = 45.7;
+    cmd.payload = "hello world";
+    cmd.setStringData("target", "source as a very long string test .........", "original_source");
+
+    helics::CompactMessageEncoder encoder(true);
+    helics::CompactMessageDecoder decoder;
+    std::string first;
+    std::string second;
+    encoder.packetize(cmd, first);
+    encoder.packetize(cmd, second);
+    // the strings are sent as table references the second time
+    EXPECT_LT(second.size(), first.size());
+
+    // both encodings can be read from a single stream
+    std::string stream = first + second + cmd.packetize();
+    std::size_t used_total{0};
+    int count{0};
+    while (used_total < stream.size()) {
+        helics::ActionMessage cmd2;
+        auto used = decoder.depacketize(reinterpret_cast<const std::byte*>(stream.data()) +
+                                            used_total,
+                                        stream.size() - used_total,
+                                        cmd2);
+        ASSERT_GT(used, 0U);
+        used_total += used;
+        ++count;
+        EXPECT_TRUE(cmd.action() == cmd2.action());
+        EXPECT_EQ(cmd.actionTime, cmd2.actionTime);
+        EXPECT_EQ(cmd.source_handle, cmd2.source_handle);
+        EXPECT_EQ(cmd.payload, cmd2.payload);
+        EXPECT_EQ(cmd.flags, cmd2.flags);
+        EXPECT_TRUE(cmd.getStringData() == cmd2.getStringData());
+    }
+    EXPECT_EQ(count, 3);
+
+    // after a reset the first message is self contained again
+    encoder.reset();
+    std::string third;
+    encoder.packetize(cmd, third);
+    EXPECT_EQ(third.size(), first.size());
+    helics::CompactMessageDecoder decoder2;
+    helics::ActionMessage cmd3;
+    auto used =
+        decoder2.depacketize(reinterpret_cast<const std::byte*>(third.data()), third.size(), cmd3);
+    EXPECT_EQ(used, third.size());
+    EXPECT_TRUE(cmd.getStringData() == cmd3.getStringData());
+}
+
+TEST(ActionMessage, message_recycling)
+{
+    auto msg = std::make_unique<helics::Message>();
+    msg->data = std::string(200, 'a');
+    msg->dest = "dest";
+    msg->source = "source";
+    msg->original_source = "original_source";
+    msg->original_dest = std::string(400, 'd');
+    msg->time = 5.0;
+    msg->messageID = 12;
+    msg->counter = 4;
+    msg->messageValidation = 8;
+    auto* location = msg.get();
+
+    const auto cached = helics::cachedMessageCount();
+    ActionMessage cmd(std::move(msg));
+    EXPECT_EQ(helics::cachedMessageCount(), cached + 1);
+    EXPECT_EQ(cmd.payload.size(), 200U);
+    EXPECT_EQ(cmd.getString(targetStringLoc), "dest");
+    EXPECT_EQ(cmd.getString(sourceStringLoc), "source");
+    EXPECT_EQ(cmd.getString(origSourceStringLoc), "original_source");
+    EXPECT_EQ(cmd.getString(origDestStringLoc).size(), 400U);
+
+    // the released message is reused for the next conversion and holds no stale data
+    cmd.actionTime = 7.0;
+    auto msg2 = helics::createMessageFromCommand(std::move(cmd));
+    EXPECT_EQ(msg2.get(), location);
+    EXPECT_EQ(helics::cachedMessageCount(), cached);
+    EXPECT_EQ(msg2->dest, "dest");
+    EXPECT_EQ(msg2->original_dest.size(), 400U);
+    EXPECT_EQ(msg2->data.size(), 200U);
+    EXPECT_EQ(msg2->time, 7.0);
+    EXPECT_EQ(msg2->messageID, 12);
+    EXPECT_EQ(msg2->counter, 0);
+    EXPECT_EQ(msg2->messageValidation, 0U);
+
+    helics::releaseMessage(std::move(msg2));
+    auto msg3 = helics::acquireMessage();
+    EXPECT_EQ(msg3.get(), location);
+    EXPECT_FALSE(msg3->isValid());
+    EXPECT_TRUE(msg3->original_dest.empty());
+    EXPECT_EQ(msg3->time, helics::timeZero);
+
+    // locked buffers may not be owned by the message so are not reused
+    msg3->data.lock();
+    helics::releaseMessage(std::move(msg3));
+    EXPECT_EQ(helics::cachedMessageCount(), cached);
+}
+
+TEST(ActionMessage, message_recycling_across_threads)
+{
+    // messages released on a thread which only consumes them are reused by other threads
+    std::set<helics::Message*> released;
+    std::thread consumer([&released]() {
+        for (std::size_t ii = 0; ii < 2 * helics::maxCachedMessages; ++ii) {
+            auto msg = std::make_unique<helics::Message>();
+            released.insert(msg.get());
+            helics::releaseMessage(std::move(msg));
+        }
+    });
+    consumer.join();
+    // the thread cache of the exited thread has been returned as well
+    EXPECT_GE(helics::sharedMessageCount(), 2 * helics::maxCachedMessages);
+
+    std::vector<std::unique_ptr<helics::Message>> acquired;
+    const auto cached = helics::cachedMessageCount();
+    for (std::size_t ii = 0; ii < cached + helics::maxCachedMessages; ++ii) {
+        acquired.push_back(helics::acquireMessage());
+    }
+    const auto reused = std::count_if(acquired.begin(), acquired.end(), [&released](auto& msg) {
+        return released.count(msg.get()) > 0;
+    });
+    EXPECT_GE(static_cast<std::size_t>(reused), helics::maxCachedMessages);
+    for (auto& msg : acquired) {
+        helics::releaseMessage(std::move(msg));
+    }
+}
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/ActionQueue.hpp"
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace helics;
+
+TEST(actionQueue_tests, priority_order)
+{
+    for (bool lockFree : {false, true}) {
+        ActionQueue queue;
+        queue.setLockFree(lockFree);
+        EXPECT_EQ(queue.isLockFree(), lockFree);
+        EXPECT_TRUE(queue.empty());
+        queue.push(ActionMessage(CMD_PUB));
+        queue.emplace(CMD_SEND_MESSAGE);
+        queue.pushPriority(ActionMessage(CMD_PING_PRIORITY));
+        queue.emplacePriority(CMD_BROKER_QUERY);
+        EXPECT_FALSE(queue.empty());
+        EXPECT_EQ(queue.pop().action(), CMD_PING_PRIORITY);
+        EXPECT_EQ(queue.pop().action(), CMD_BROKER_QUERY);
+        EXPECT_EQ(queue.pop().action(), CMD_PUB);
+        auto message = queue.try_pop();
+        ASSERT_TRUE(message);
+        EXPECT_EQ(message->action(), CMD_SEND_MESSAGE);
+        EXPECT_FALSE(queue.try_pop());
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(actionQueue_tests, transfer_pending)
+{
+    ActionQueue queue;
+    queue.push(ActionMessage(CMD_PUB));
+    queue.pushPriority(ActionMessage(CMD_PING_PRIORITY));
+    queue.setLockFree(true);
+    EXPECT_TRUE(queue.isLockFree());
+    EXPECT_EQ(queue.pop().action(), CMD_PING_PRIORITY);
+    EXPECT_EQ(queue.pop().action(), CMD_PUB);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(actionQueue_tests, multiple_producers)
+{
+    static constexpr int producerCount{8};
+    static constexpr int messageCount{5000};
+    ActionQueue queue;
+    queue.setLockFree(true);
+    std::vector<std::thread> producers;
+    for (int ii = 0; ii < producerCount; ++ii) {
+        producers.emplace_back([&queue, ii]() {
+            for (int jj = 0; jj < messageCount; ++jj) {
+                ActionMessage message(CMD_PUB);
+                message.messageID = ii;
+                message.sequenceID = jj;
+                queue.push(std::move(message));
+            }
+        });
+    }
+    // messages from each producer must arrive in order
+    std::vector<std::int32_t> lastSequence(producerCount, -1);
+    bool ordered{true};
+    for (int ii = 0; ii < producerCount * messageCount; ++ii) {
+        auto message = queue.pop();
+        auto& last = lastSequence[message.messageID];
+        if (static_cast<std::int32_t>(message.sequenceID) != last + 1) {
+            ordered = false;
+        }
+        last = static_cast<std::int32_t>(message.sequenceID);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
@@ -4,12 +4,14 @@ Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance
 Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
 SPDX-License-Identifier: BSD-3-Clause
 */
+#include "helics/core/ActionMessage.hpp"
 #include "helics/core/CoreFederateInfo.hpp"
 #include "helics/core/EndpointInfo.hpp"
 #include "helics/core/FederateState.hpp"
 #include "helics/core/FilterInfo.hpp"
 #include "helics/core/InputInfo.hpp"
 #include "helics/core/PublicationInfo.hpp"
+#include "helics/core/flagOperations.hpp"
 #include "helics/core/helics_definitions.hpp"
 
 #include "gtest/gtest.h"
@@ -286,6 +288,23 @@ TEST_F(FederateStateTests, message)
     // auto fs_process = std::async(std::launch::async, [&]() { return fs->processQueue(); });
 }
 
+TEST_F(FederateStateTests, shared_payload_release)
+{
+    auto data = std::make_shared<const helics::SmallBuffer>(std::string_view("payload"));
+    helics::ActionMessage pub(helics::CMD_MULTICAST_PUB);
+    setActionFlag(pub, helics::shared_payload_flag);
+    pub.sequenceID = fs->addSharedPayload(data);
+    EXPECT_EQ(data.use_count(), 2);
+    // a publication dropped after the federate finished releases its payload
+    EXPECT_FALSE(fs->processPostTerminationAction(pub));
+    EXPECT_EQ(data.use_count(), 1);
+
+    fs->addSharedPayload(data);
+    EXPECT_EQ(data.use_count(), 2);
+    fs->reset(helics::CoreFederateInfo());
+    EXPECT_EQ(data.use_count(), 1);
+}
+
 // Test create filters, publications, subscriptions, endpoints
 // Test queue functions
 // Test dependencies
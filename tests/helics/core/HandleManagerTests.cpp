@@ -605,3 +605,19 @@ TEST(handleManager, aliasCascadeFutureManyOther)
     p1 = h1.getInterfaceHandle("publisher", InterfaceType::PUBLICATION);
     ASSERT_NE(p1, nullptr);
 }
+
+TEST(handleManager, nameGeneration)
+{
+    HandleManager h1;
+    auto gen = h1.nameGeneration();
+    h1.addHandle(fed2, i1, InterfaceType::ENDPOINT, "ept1", "type1", "");
+    EXPECT_NE(h1.nameGeneration(), gen);
+    gen = h1.nameGeneration();
+    EXPECT_NE(h1.getInterfaceHandle("ept1", InterfaceType::ENDPOINT), nullptr);
+    EXPECT_EQ(h1.nameGeneration(), gen);
+    h1.addAlias("ept1", "ept_alias");
+    EXPECT_NE(h1.nameGeneration(), gen);
+    gen = h1.nameGeneration();
+    h1.removeHandle(GlobalHandle(fed2, i1));
+    EXPECT_NE(h1.nameGeneration(), gen);
+}
@@ -8,10 +8,17 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/core/EndpointInfo.hpp"
 #include "helics/core/FilterInfo.hpp"
 #include "helics/core/InputInfo.hpp"
+#include "helics/core/PublicationInfo.hpp"
+#include "helics/core/VectorDelta.hpp"
+#include "helics/core/helics_definitions.hpp"
 
 #include "gtest/gtest.h"
+#include <complex>
+#include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 TEST(InfoClass_tests, basichandleinfo)
 {
@@ -240,6 +247,50 @@ TEST(InfoClass_tests, endpointinfo)
     EXPECT_TRUE(endPI.getMessage(maxT) == nullptr);
 }
 
+TEST(InfoClass_tests, endpointinfo_bulk)
+{
+    helics::EndpointInfo endPI({helics::GlobalFederateId(5), helics::InterfaceHandle(13)},
+                               "name",
+                               "type");
+    auto makeMessage = [](double time, const std::string& source, const std::string& data) {
+        auto message = std::make_unique<helics::Message>();
+        message->time = time;
+        message->original_source = source;
+        message->data = data;
+        return message;
+    };
+    // messages are merged into time and source order in batches
+    endPI.addMessage(makeMessage(2.0, "aFed", "c"));
+    endPI.addMessage(makeMessage(1.0, "bFed", "b"));
+    EXPECT_EQ(endPI.firstMessageTime(), helics::Time(1.0));
+    endPI.addMessage(makeMessage(1.0, "aFed", "a"));
+    endPI.addMessage(makeMessage(3.0, "aFed", "e"));
+    endPI.addMessage(makeMessage(2.0, "aFed", "d"));
+    EXPECT_EQ(endPI.queueSize(2.0), 4);
+
+    // nothing is available until the time is updated
+    EXPECT_TRUE(endPI.getMessages(helics::Time::maxVal()).empty());
+    endPI.updateTimeInclusive(2.0);
+    EXPECT_EQ(endPI.availableMessages(), 4);
+    auto messages = endPI.getMessages(1.0);
+    ASSERT_EQ(messages.size(), 2U);
+    EXPECT_EQ(messages[0]->data.to_string(), "a");
+    EXPECT_EQ(messages[1]->data.to_string(), "b");
+    EXPECT_EQ(endPI.availableMessages(), 2);
+
+    messages = endPI.getMessages(helics::Time::maxVal());
+    ASSERT_EQ(messages.size(), 2U);
+    EXPECT_EQ(messages[0]->data.to_string(), "c");
+    EXPECT_EQ(messages[1]->data.to_string(), "d");
+    EXPECT_EQ(endPI.availableMessages(), 0);
+    EXPECT_EQ(endPI.queueSize(helics::Time::maxVal()), 1);
+
+    endPI.addMessage(makeMessage(4.0, "aFed", "f"));
+    endPI.clearQueue();
+    EXPECT_EQ(endPI.queueSize(helics::Time::maxVal()), 0);
+    EXPECT_EQ(endPI.firstMessageTime(), helics::Time::maxVal());
+}
+
 TEST(InfoClass_tests, filterinfo)
 {
     // Mostly testing ordering of message sorting and maxTime function arguments
@@ -334,3 +385,134 @@ TEST(InfoClass_tests, inputinfo)
     ret_data = subI.getData(0);
     EXPECT_EQ(ret_data->to_string(), "time one");
 }
+
+/** serialize a vector in the format used by the value converters*/
+template<class X>
+static helics::SmallBuffer vectorBuffer(const std::vector<X>& values, std::byte code)
+{
+    helics::SmallBuffer buffer(8 + values.size() * sizeof(X), std::byte{0});
+    buffer[0] = code;
+    buffer[6] = static_cast<std::byte>((values.size() >> 8U) & 0xFFU);
+    buffer[7] = static_cast<std::byte>(values.size() & 0xFFU);
+    std::memcpy(buffer.data() + 8, values.data(), values.size() * sizeof(X));
+    return buffer;
+}
+
+TEST(InfoClass_tests, publicationinfo_delta)
+{
+    const std::byte vectorCode{0x6C};
+    helics::GlobalHandle pubHandle(helics::GlobalFederateId(5), helics::InterfaceHandle(2));
+    helics::GlobalHandle subHandle(helics::GlobalFederateId(7), helics::InterfaceHandle(4));
+    helics::PublicationInfo pubI(pubHandle, "pub", "double_vector", "");
+    pubI.setProperty(helics::defs::Options::DELTA_ENCODING, 3);
+    EXPECT_EQ(pubI.getProperty(helics::defs::Options::DELTA_ENCODING), 3);
+    pubI.addSubscriber(subHandle, "input");
+
+    helics::InputInfo subI(subHandle, "input", "double_vector", "");
+    subI.addSource(pubHandle, "pub", "double_vector", "");
+
+    std::vector<double> values(500, 1.0);
+    auto publish = [&](helics::Time time, bool expectDelta) {
+        auto full = vectorBuffer(values, vectorCode);
+        ASSERT_TRUE(pubI.CheckSetValue(full.char_data(), full.size(), time, false));
+        EXPECT_EQ(!pubI.encodedData.empty(), expectDelta);
+        auto sent = std::make_shared<helics::SmallBuffer>(
+            pubI.encodedData.empty() ? full : pubI.encodedData);
+        EXPECT_LE(sent->size(), full.size());
+        EXPECT_EQ(helics::isDeltaEncoded(sent->to_string()), expectDelta);
+        const auto frame = expectDelta ? helics::DeltaFrame::DELTA : helics::DeltaFrame::KEYFRAME;
+        ASSERT_TRUE(subI.addData(pubHandle, time, 0, sent, frame));
+        subI.updateTimeInclusive(time);
+        EXPECT_EQ(*subI.getData(0), full);
+    };
+    publish(1.0, false);
+    values[3] = 4.0;
+    values[4] = 5.0;
+    values[400] = -1.0;
+    publish(2.0, true);
+    // two blocks with 3 changed elements
+    EXPECT_EQ(pubI.encodedData.size(), 16U + 8U * 2 + 3 * sizeof(double));
+    publish(3.0, true);
+    values[499] = 9.0;
+    publish(4.0, true);
+    // the keyframe interval has been reached
+    publish(5.0, false);
+    values.assign(values.size(), 2.0);
+    // too many changes are sent as a full value
+    publish(6.0, false);
+    values[7] = 7.0;
+    publish(7.0, true);
+    // a new subscriber forces a full value
+    pubI.addSubscriber(
+        helics::GlobalHandle(helics::GlobalFederateId(8), helics::InterfaceHandle(1)), "input2");
+    publish(8.0, false);
+    values.resize(20);
+    publish(9.0, false);
+
+    // a delta which does not follow the last value is dropped until the next full value
+    values[1] = 11.0;
+    auto full = vectorBuffer(values, vectorCode);
+    ASSERT_TRUE(pubI.CheckSetValue(full.char_data(), full.size(), 10.0, false));
+    values[2] = 12.0;
+    full = vectorBuffer(values, vectorCode);
+    ASSERT_TRUE(pubI.CheckSetValue(full.char_data(), full.size(), 11.0, false));
+    auto skipped = std::make_shared<helics::SmallBuffer>(pubI.encodedData);
+    EXPECT_EQ(helics::getDeltaSequence(skipped->to_string()), 2U);
+    EXPECT_FALSE(subI.addData(pubHandle, 11.0, 0, skipped, helics::DeltaFrame::DELTA));
+}
+
+TEST(InfoClass_tests, inputinfo_delta_unflagged)
+{
+    helics::GlobalHandle pubHandle(helics::GlobalFederateId(5), helics::InterfaceHandle(2));
+    helics::GlobalHandle subHandle(helics::GlobalFederateId(7), helics::InterfaceHandle(4));
+    helics::InputInfo subI(subHandle, "input", "raw", "");
+    subI.addSource(pubHandle, "pub", "raw", "");
+    // raw data that looks like a delta header is only reconstructed if the message is flagged
+    helics::SmallBuffer raw(32, std::byte{0});
+    raw[0] = std::byte{0xD6};
+    raw[11] = std::byte{1};
+    auto data = std::make_shared<const helics::SmallBuffer>(raw);
+    ASSERT_TRUE(subI.addData(pubHandle, 1.0, 0, data));
+    subI.updateTimeInclusive(1.0);
+    EXPECT_EQ(*subI.getData(0), raw);
+    EXPECT_FALSE(subI.addData(pubHandle, 2.0, 0, data, helics::DeltaFrame::DELTA));
+
+    helics::EndpointInfo eptI({helics::GlobalFederateId(7), helics::InterfaceHandle(5)}, "ept", "");
+    helics::SmallBuffer message(raw);
+    EXPECT_TRUE(eptI.reconstructData(pubHandle, message, helics::DeltaFrame::NONE));
+    EXPECT_EQ(message, raw);
+}
+
+TEST(InfoClass_tests, publicationinfo_delta_tolerance)
+{
+    const std::byte cvCode{0x62};
+    helics::GlobalHandle pubHandle(helics::GlobalFederateId(5), helics::InterfaceHandle(2));
+    helics::PublicationInfo pubI(pubHandle, "pub", "complex_vector", "");
+    pubI.setProperty(helics::defs::Options::DELTA_ENCODING, 1);
+    pubI.setProperty(helics::defs::Options::DELTA_TOLERANCE, 1000);
+    pubI.setProperty(helics::defs::Options::HANDLE_ONLY_TRANSMIT_ON_CHANGE, 1);
+    EXPECT_EQ(pubI.getProperty(helics::defs::Options::DELTA_ENCODING),
+              helics::defaultDeltaKeyframeInterval);
+    EXPECT_EQ(pubI.getProperty(helics::defs::Options::DELTA_TOLERANCE), 1000);
+
+    std::vector<std::complex<double>> values(100, {1.0, 0.0});
+    auto full = vectorBuffer(values, cvCode);
+    EXPECT_TRUE(pubI.CheckSetValue(full.char_data(), full.size(), 1.0, false));
+    EXPECT_TRUE(pubI.encodedData.empty());
+
+    // changes within the tolerance are not transmitted
+    values[10] += std::complex<double>(0.0, 0.0005);
+    full = vectorBuffer(values, cvCode);
+    EXPECT_FALSE(pubI.CheckSetValue(full.char_data(), full.size(), 2.0, false));
+    // the drift is measured from the transmitted value so it eventually is sent
+    values[10] += std::complex<double>(0.0, 0.0008);
+    full = vectorBuffer(values, cvCode);
+    EXPECT_TRUE(pubI.CheckSetValue(full.char_data(), full.size(), 3.0, false));
+    EXPECT_EQ(pubI.encodedData.size(), 16U + 8U + 2 * sizeof(double));
+    EXPECT_EQ(pubI.data, full);
+
+    // values which are not vectors are always sent in full
+    helics::SmallBuffer text("not a vector");
+    EXPECT_TRUE(pubI.CheckSetValue(text.char_data(), text.size(), 4.0, false));
+    EXPECT_TRUE(pubI.encodedData.empty());
+}
@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/core/HandleManager.hpp"
+#include "helics/core/RouteTable.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace helics;
+
+static constexpr GlobalFederateId fed2(2);
+static constexpr GlobalFederateId fed3(3);
+
+static constexpr InterfaceHandle i1(1);
+static constexpr InterfaceHandle i2(2);
+static constexpr InterfaceHandle i3(3);
+static constexpr InterfaceHandle i4(4);
+
+TEST(routeTable, federatesAndBrokers)
+{
+    RouteTable table;
+    const GlobalFederateId fedA(gGlobalFederateIdShift + 4);
+    const GlobalFederateId fedB(gGlobalFederateIdShift + 2000);
+    const GlobalFederateId brk(gGlobalBrokerIdShift + 3);
+    EXPECT_TRUE(table.emplace(fedA, route_id(7)));
+    EXPECT_TRUE(table.emplace(fedB, route_id(8)));
+    EXPECT_TRUE(table.emplace(brk, route_id(9)));
+    EXPECT_FALSE(table.emplace(fedA, route_id(10)));
+    EXPECT_EQ(table.size(), 3U);
+    EXPECT_EQ(table.find(fedA), route_id(7));
+    EXPECT_EQ(table.find(fedB), route_id(8));
+    EXPECT_EQ(table.find(brk), route_id(9));
+
+    EXPECT_FALSE(table.contains(GlobalFederateId(gGlobalFederateIdShift + 5)));
+    EXPECT_EQ(table.find(GlobalFederateId(gGlobalFederateIdShift + 5)), parent_route_id);
+    EXPECT_EQ(table.find(GlobalFederateId(gGlobalBrokerIdShift + 100)), parent_route_id);
+    EXPECT_EQ(table.find(GlobalFederateId{}, route_id(3)), route_id(3));
+
+    table.set(fedA, route_id(12));
+    EXPECT_EQ(table.find(fedA), route_id(12));
+    EXPECT_EQ(table.size(), 3U);
+    table.clear();
+    EXPECT_EQ(table.size(), 0U);
+    EXPECT_FALSE(table.contains(brk));
+}
+
+TEST(routeTable, sparseIds)
+{
+    RouteTable table;
+    // special federate ids sit just below the broker ids
+    const GlobalFederateId special(gGlobalBrokerIdShift - 2);
+    const GlobalFederateId low(5);
+    EXPECT_TRUE(table.emplace(special, route_id(4)));
+    EXPECT_TRUE(table.emplace(low, route_id(6)));
+    EXPECT_FALSE(table.emplace(special, route_id(5)));
+    EXPECT_FALSE(table.emplace(GlobalFederateId{}, route_id(5)));
+    EXPECT_FALSE(table.emplace(GlobalFederateId(gGlobalFederateIdShift), route_id{}));
+    EXPECT_EQ(table.size(), 2U);
+    EXPECT_EQ(table.find(special), route_id(4));
+    EXPECT_EQ(table.find(low), route_id(6));
+    table.set(special, route_id(11));
+    EXPECT_EQ(table.find(special), route_id(11));
+}
+
+TEST(destinationCache, generation)
+{
+    HandleManager h1;
+    auto& ept = h1.addHandle(fed2, i1, InterfaceType::ENDPOINT, "ept1", "type1", "");
+    DestinationCache cache;
+    const GlobalHandle source(fed3, i2);
+    BasicHandleInfo* destination{nullptr};
+    EXPECT_FALSE(cache.find(source, "ept1", h1.nameGeneration(), destination));
+    cache.store(source, "ept1", h1.nameGeneration(), &ept);
+    EXPECT_TRUE(cache.find(source, "ept1", h1.nameGeneration(), destination));
+    EXPECT_EQ(destination, &ept);
+    // a different name or source is not cached
+    EXPECT_FALSE(cache.find(source, "ept2", h1.nameGeneration(), destination));
+    EXPECT_FALSE(cache.find(GlobalHandle(fed3, i3), "ept1", h1.nameGeneration(), destination));
+
+    // cache a missing name then add it
+    cache.store(source, "ept2", h1.nameGeneration(), nullptr);
+    EXPECT_TRUE(cache.find(source, "ept2", h1.nameGeneration(), destination));
+    EXPECT_EQ(destination, nullptr);
+    h1.addHandle(fed2, i4, InterfaceType::ENDPOINT, "ept2", "type1", "");
+    EXPECT_FALSE(cache.find(source, "ept2", h1.nameGeneration(), destination));
+    cache.clear();
+    EXPECT_FALSE(cache.find(source, "ept1", h1.nameGeneration(), destination));
+}
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/core/SpscQueue.hpp"
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <thread>
+
+using namespace helics;
+
+TEST(spscQueue_tests, single_thread)
+{
+    SpscQueue<std::unique_ptr<int>, 4> queue;
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    // cross several block boundaries
+    for (int ii = 0; ii < 10; ++ii) {
+        queue.push(std::make_unique<int>(ii));
+    }
+    for (int ii = 0; ii < 10; ++ii) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(*value, ii);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    queue.push(std::make_unique<int>(10));
+    EXPECT_FALSE(queue.empty());
+}
+
+TEST(spscQueue_tests, producer_consumer)
+{
+    static constexpr int messageCount{100000};
+    SpscQueue<int, 16> queue;
+    std::thread producer([&queue]() {
+        for (int ii = 0; ii < messageCount; ++ii) {
+            queue.push(int{ii});
+        }
+    });
+    bool ordered{true};
+    int expected{0};
+    int value{0};
+    while (expected < messageCount) {
+        if (queue.try_pop(value)) {
+            ordered = ordered && (value == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
@@ -6,6 +6,7 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 #include "helics/core/ActionMessage.hpp"
 #include "helics/core/TimeDependencies.hpp"
+#include "helics/core/flagOperations.hpp"
 
 #include "gtest/gtest.h"
 #include <vector>
@@ -41,3 +42,117 @@ TEST(timeDep_tests, dependency_tests)
     auto total = generateMinTimeTotal(depTest, false, GlobalFederateId{1}, GlobalFederateId{}, 0);
     EXPECT_EQ(total.next, 2.0);
 }
+
+TEST(timeDep_tests, minimum_next_index)
+{
+    TimeDependencies depTest;
+    for (int ii = 0; ii < 5; ++ii) {
+        depTest.addDependency(GlobalFederateId{131072 + ii});
+    }
+    auto request = [&depTest](int index, Time next) {
+        ActionMessage req(CMD_TIME_REQUEST);
+        req.source_id = GlobalFederateId{131072 + index};
+        req.actionTime = next;
+        req.Te = next;
+        req.Tdemin = next;
+        depTest.updateTime(req);
+    };
+    for (int ii = 0; ii < 5; ++ii) {
+        request(ii, Time(static_cast<double>(ii + 1)));
+    }
+    EXPECT_EQ(depTest.minimumNextTime(), 1.0);
+    EXPECT_FALSE(depTest.checkIfReadyForTimeGrant(false, 2.0, GrantDelayMode::NONE));
+
+    // advance the minimum dependency past the others
+    request(0, 6.0);
+    EXPECT_EQ(depTest.minimumNextTime(), 2.0);
+    EXPECT_TRUE(depTest.checkIfReadyForTimeGrant(false, 2.0, GrantDelayMode::NONE));
+    EXPECT_FALSE(depTest.checkIfReadyForTimeGrant(false, 2.0, GrantDelayMode::WAITING));
+    EXPECT_TRUE(depTest.checkIfReadyForTimeGrant(false, 1.5, GrantDelayMode::WAITING));
+
+    // dependencies beyond cBigTime do not restrict the grant
+    for (int ii = 1; ii < 5; ++ii) {
+        request(ii, Time::maxVal());
+    }
+    EXPECT_EQ(depTest.minimumNextTime(), 6.0);
+
+    // the index is rebuilt after structural changes
+    depTest.removeDependency(GlobalFederateId{131072});
+    EXPECT_EQ(depTest.minimumNextTime(), Time::maxVal());
+    EXPECT_TRUE(depTest.checkIfReadyForTimeGrant(false, 10.0, GrantDelayMode::NONE));
+
+    // direct modification of a dependency is picked up
+    auto* dep = depTest.getDependencyInfo(GlobalFederateId{131073});
+    ASSERT_NE(dep, nullptr);
+    dep->next = 3.0;
+    EXPECT_EQ(depTest.minimumNextTime(), 3.0);
+}
+
+static void checkTimeData(const TimeData& summary, const TimeData& scan)
+{
+    EXPECT_EQ(summary.next, scan.next);
+    EXPECT_EQ(summary.Te, scan.Te);
+    EXPECT_EQ(summary.minDe, scan.minDe);
+    EXPECT_EQ(summary.TeAlt, scan.TeAlt);
+    EXPECT_EQ(summary.minFed, scan.minFed);
+    EXPECT_EQ(summary.minFedActual, scan.minFedActual);
+    EXPECT_EQ(summary.mTimeState, scan.mTimeState);
+    EXPECT_EQ(summary.interrupted, scan.interrupted);
+    EXPECT_EQ(summary.sequenceCounter, scan.sequenceCounter);
+    EXPECT_EQ(summary.responseSequenceCounter, scan.responseSequenceCounter);
+}
+
+TEST(timeDep_tests, time_summary)
+{
+    TimeDependencies depTest;
+    for (int ii = 0; ii < 6; ++ii) {
+        depTest.addDependency(GlobalFederateId{131072 + ii});
+    }
+    depTest.getDependencyInfo(GlobalFederateId{131077})->connection = ConnectionType::PARENT;
+    // an ignored federate which is not a dependency makes the generate functions scan
+    const GlobalFederateId scan{131090};
+    auto check = [&depTest, scan](std::int32_t sequenceCode) {
+        const GlobalFederateId self{};
+        checkTimeData(
+            generateMinTimeTotal(depTest, false, self, NoIgnoredFederates, sequenceCode),
+            generateMinTimeTotal(depTest, false, self, scan, sequenceCode));
+        checkTimeData(
+            generateMinTimeUpstream(depTest, true, self, NoIgnoredFederates, sequenceCode),
+            generateMinTimeUpstream(depTest, true, self, scan, sequenceCode));
+    };
+    auto send = [&depTest](ActionMessage& msg, int index) {
+        msg.source_id = GlobalFederateId{131072 + index};
+        depTest.updateTime(msg);
+    };
+    ActionMessage grant(CMD_EXEC_GRANT);
+    for (int ii = 0; ii < 6; ++ii) {
+        send(grant, ii);
+    }
+    check(0);
+
+    ActionMessage req(CMD_TIME_REQUEST);
+    req.actionTime = 2.0;
+    req.Te = 3.0;
+    req.Tdemin = 3.0;
+    send(req, 3);
+    send(req, 1);
+    check(0);
+    // ties on next and event time with interruptions and a forwarded minimum federate
+    setActionFlag(req, interrupted_flag);
+    req.setExtraData(131075);
+    req.Te = 2.0;
+    send(req, 4);
+    req.actionTime = 1.0;
+    req.Te = 1.0;
+    req.Tdemin = 0.5;
+    send(req, 5);
+    check(0);
+    check(1);
+    grant.setAction(CMD_TIME_GRANT);
+    grant.actionTime = 2.0;
+    send(grant, 0);
+    send(grant, 2);
+    send(grant, 5);
+    check(0);
+    check(2);
+}
@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+#include "helics/core/TimerWheel.hpp"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace helics;
+
+using namespace std::literals::chrono_literals;
+
+namespace {
+class RecordingClient: public TimerWheel::Client {
+  public:
+    std::vector<std::int32_t> getExpired()
+    {
+        const std::lock_guard<std::mutex> lock(expiredLock);
+        return std::exchange(expired, {});
+    }
+    std::atomic<int> count{0};
+
+  private:
+    void timerExpired(std::int32_t index) override
+    {
+        const std::lock_guard<std::mutex> lock(expiredLock);
+        expired.push_back(index);
+        ++count;
+    }
+    std::mutex expiredLock;
+    std::vector<std::int32_t> expired;
+};
+
+// the wheel is driven manually from a start time far enough ahead that the asio timer never fires
+const auto startTime = std::chrono::steady_clock::now() + 1000h;
+}  // namespace
+
+TEST(timerWheel_tests, expiration_order)
+{
+    auto wheel = std::make_shared<TimerWheel>();
+    auto client = std::make_shared<RecordingClient>();
+    wheel->processExpired(startTime);
+    const std::vector<std::chrono::nanoseconds> spans{5ms, 100ms, 10s, 2h, 10000h};
+    std::vector<std::int32_t> timers;
+    for (std::int32_t ii = 0; ii < static_cast<std::int32_t>(spans.size()); ++ii) {
+        timers.push_back(wheel->createTimer(ii));
+        wheel->schedule(timers.back(), startTime + spans[ii], client);
+    }
+    EXPECT_EQ(wheel->size(), spans.size());
+    // timers never fire early and fire at most one tick late
+    const auto tick = wheel->getTickResolution();
+    for (std::int32_t ii = 0; ii < static_cast<std::int32_t>(spans.size()); ++ii) {
+        EXPECT_EQ(wheel->processExpired(startTime + spans[ii] - 1ms), 0U);
+        EXPECT_EQ(wheel->processExpired(startTime + spans[ii] + tick), 1U);
+        EXPECT_EQ(client->getExpired(), std::vector<std::int32_t>{ii});
+    }
+    EXPECT_EQ(wheel->size(), 0U);
+    for (auto timer : timers) {
+        wheel->releaseTimer(timer);
+    }
+}
+
+TEST(timerWheel_tests, cancel_and_reschedule)
+{
+    auto wheel = std::make_shared<TimerWheel>();
+    auto client = std::make_shared<RecordingClient>();
+    wheel->processExpired(startTime);
+    auto timer1 = wheel->createTimer(1);
+    auto timer2 = wheel->createTimer(2);
+    EXPECT_FALSE(wheel->cancel(timer1));
+    wheel->schedule(timer1, startTime + 50ms, client);
+    wheel->schedule(timer2, startTime + 50ms, client);
+    EXPECT_TRUE(wheel->cancel(timer1));
+    EXPECT_FALSE(wheel->cancel(timer1));
+    // rescheduling replaces the previous expiration
+    wheel->schedule(timer2, startTime + 5s, client);
+    EXPECT_EQ(wheel->size(), 1U);
+    EXPECT_EQ(wheel->processExpired(startTime + 1s), 0U);
+    EXPECT_EQ(wheel->processExpired(startTime + 5s + wheel->getTickResolution()), 1U);
+    EXPECT_EQ(client->getExpired(), std::vector<std::int32_t>{2});
+    wheel->releaseTimer(timer1);
+    wheel->releaseTimer(timer2);
+    // released timers are reused
+    EXPECT_EQ(wheel->createTimer(3), timer2);
+}
+
+TEST(timerWheel_tests, batch_expiration)
+{
+    auto wheel = std::make_shared<TimerWheel>();
+    auto client = std::make_shared<RecordingClient>();
+    wheel->processExpired(startTime);
+    constexpr std::int32_t timerCount{10000};
+    for (std::int32_t ii = 0; ii < timerCount; ++ii) {
+        wheel->schedule(wheel->createTimer(ii),
+                        startTime + 1s + std::chrono::microseconds(ii),
+                        client);
+    }
+    EXPECT_EQ(wheel->size(), static_cast<std::size_t>(timerCount));
+    // all the timers expire within a few ticks so they come out in a single batch
+    EXPECT_EQ(wheel->processExpired(startTime + 2s), static_cast<std::size_t>(timerCount));
+    EXPECT_EQ(client->count.load(), timerCount);
+    EXPECT_EQ(wheel->size(), 0U);
+}
+
+TEST(timerWheel_tests, shared_wheels)
+{
+    auto wheel1 = TimerWheel::getSharedWheel();
+    auto wheel2 = TimerWheel::getSharedWheel(TimerWheel::defaultTickResolution);
+    auto wheel3 = TimerWheel::getSharedWheel(20us);
+    EXPECT_EQ(wheel1, wheel2);
+    EXPECT_NE(wheel1, wheel3);
+    EXPECT_EQ(wheel1->getTickResolution(), TimerWheel::defaultTickResolution);
+    EXPECT_EQ(wheel3->getTickResolution(), std::chrono::nanoseconds(20us));
+}
+
+TEST(timerWheel_tests, asio_timer)
+{
+    auto wheel = std::make_shared<TimerWheel>();
+    auto client = std::make_shared<RecordingClient>();
+    const auto expiration = std::chrono::steady_clock::now() + 50ms;
+    wheel->schedule(wheel->createTimer(7), expiration, client);
+    int cnt{0};
+    while (client->count.load() == 0 && cnt < 100) {
+        std::this_thread::sleep_for(10ms);
+        ++cnt;
+    }
+    EXPECT_GE(std::chrono::steady_clock::now(), expiration);
+    EXPECT_EQ(client->getExpired(), std::vector<std::int32_t>{7});
+}
@@ -0,0 +1,261 @@
+/*
+Copyright (c) 2017-2025,
+Battelle Memorial Institute; Lawrence Livermore National Security, LLC; Alliance for Sustainable
+Energy, LLC.  See the top-level NOTICE for additional details. All rights reserved.
+SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "helics/common/GuardedTypes.hpp"
+#include "helics/core/ActionMessage.hpp"
+#include "helics/core/BrokerFactory.hpp"
+#include "helics/core/Core.hpp"
+#include "helics/core/CoreBroker.hpp"
+#include "helics/core/CoreFactory.hpp"
+#include "helics/core/CoreTypes.hpp"
+#include "helics/network/shm/ShmComms.h"
+#include "helics/network/shm/ShmCore.h"
+#include "helics/network/shm/ShmMailbox.h"
+
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std::literals::chrono_literals;
+
+TEST(ShmCore, mailbox_stream)
+{
+    helics::shm::OwnedMailbox box;
+    ASSERT_TRUE(box.connect("shmMailboxTest", 1024));
+
+    helics::shm::MailboxSender sender;
+    ASSERT_TRUE(sender.connect("shmMailboxTest", true, 2));
+
+    helics::ActionMessage small(helics::CMD_ACK);
+    // larger than a single ring so it has to stream through
+    helics::ActionMessage large(helics::CMD_SEND_MESSAGE);
+    large.payload = std::string(300000, 'a');
+
+    auto res = std::async(std::launch::async, [&sender, &small, &large] {
+        return sender.sendMessage(small) && sender.sendMessage(large) &&
+            sender.sendMessage(small);
+    });
+
+    auto rM = box.getMessage(1000);
+    ASSERT_TRUE(rM);
+    EXPECT_EQ(rM->action(), helics::CMD_ACK);
+    rM = box.getMessage(1000);
+    ASSERT_TRUE(rM);
+    EXPECT_EQ(rM->action(), helics::CMD_SEND_MESSAGE);
+    EXPECT_EQ(rM->payload.size(), 300000U);
+    rM = box.getMessage(1000);
+    ASSERT_TRUE(rM);
+    EXPECT_EQ(rM->action(), helics::CMD_ACK);
+    EXPECT_TRUE(res.get());
+
+    EXPECT_FALSE(box.getMessage(10));
+}
+
+TEST(ShmCore, mailbox_closed)
+{
+    helics::shm::MailboxSender sender;
+    {
+        helics::shm::OwnedMailbox box;
+        ASSERT_TRUE(box.connect("shmMailboxTest2", 1024));
+        ASSERT_TRUE(sender.connect("shmMailboxTest2", false, 2));
+        box.changeState(helics::shm::MailboxState::CLOSING);
+    }
+    EXPECT_FALSE(sender.sendMessage(helics::ActionMessage(helics::CMD_ACK)));
+    helics::shm::MailboxSender sender2;
+    EXPECT_FALSE(sender2.connect("shmMailboxTest2", false, 0));
+}
+
+TEST(ShmCore, mailbox_reclaim_slots)
+{
+    helics::shm::OwnedMailbox box;
+    ASSERT_TRUE(box.connect("shmMailboxTest3", 1024, 1));
+    // a producer process which exits without releasing its slot
+    auto child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        helics::shm::MailboxSender sender;
+        _exit(sender.connect("shmMailboxTest3", true, 0) ? 0 : 1);
+    }
+    int status{0};
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    helics::shm::MailboxSender sender;
+    EXPECT_FALSE(sender.connect("shmMailboxTest3", true, 0));
+    auto res = std::async(std::launch::async, [&sender] {
+        return sender.connect("shmMailboxTest3", true, 10) &&
+            sender.sendMessage(helics::ActionMessage(helics::CMD_ACK));
+    });
+    auto rM = box.getMessage(3000);
+    ASSERT_TRUE(rM);
+    EXPECT_EQ(rM->action(), helics::CMD_ACK);
+    EXPECT_TRUE(res.get());
+}
+
+TEST(ShmCore, mailbox_send_timeout)
+{
+    helics::shm::OwnedMailbox box;
+    ASSERT_TRUE(box.connect("shmMailboxTest4", 1024, 2));
+    helics::shm::MailboxSender sender;
+    ASSERT_TRUE(sender.connect("shmMailboxTest4", true, 0));
+    sender.setSendTimeout(100ms);
+    helics::ActionMessage large(helics::CMD_SEND_MESSAGE);
+    large.payload = std::string(300000, 'a');
+    // nothing is reading so the message can't be completed
+    EXPECT_FALSE(sender.sendMessage(large));
+    EXPECT_FALSE(sender.getError().empty());
+    EXPECT_FALSE(sender.sendMessage(helics::ActionMessage(helics::CMD_ACK)));
+
+    // the partial message is discarded and the slot can be used again
+    EXPECT_FALSE(box.getMessage(10));
+    helics::shm::MailboxSender sender2;
+    helics::shm::MailboxSender sender3;
+    ASSERT_TRUE(sender2.connect("shmMailboxTest4", true, 0));
+    ASSERT_TRUE(sender3.connect("shmMailboxTest4", true, 0));
+    EXPECT_TRUE(sender3.sendMessage(helics::ActionMessage(helics::CMD_ACK)));
+    auto rM = box.getMessage(1000);
+    ASSERT_TRUE(rM);
+    EXPECT_EQ(rM->action(), helics::CMD_ACK);
+}
+
+TEST(ShmCore, shmcomms_broker)
+{
+    std::atomic<int> counter{0};
+    std::string brokerLoc = "brokerSHM";
+    std::string localLoc = "localSHM";
+    helics::shm::ShmComms comm;
+    comm.loadTargetInfo(localLoc, brokerLoc);
+
+    helics::shm::OwnedMailbox mq;
+    bool mqConn = mq.connect(brokerLoc, 1024);
+    ASSERT_TRUE(mqConn);
+
+    comm.setCallback([&counter](const helics::ActionMessage& /*m*/) { ++counter; });
+
+    bool connected = comm.connect();
+    ASSERT_TRUE(connected);
+    comm.transmit(helics::parent_route_id, helics::CMD_IGNORE);
+
+    auto rM = mq.getMessage(1000);
+    ASSERT_TRUE(rM);
+    EXPECT_TRUE(rM->action() == helics::action_message_def::action_t::cmd_ignore);
+    comm.disconnect();
+    std::this_thread::sleep_for(100ms);
+}
+
+TEST(ShmCore, shmComm_transmit_add_route)
+{
+    std::atomic<int> counter{0};
+    std::string brokerLoc = "brokerSHM";
+    std::string localLoc = "localSHM";
+    std::string localLocB = "localSHM2";
+
+    std::atomic<int> counter2{0};
+    std::atomic<int> counter3{0};
+    guarded<helics::ActionMessage> act;
+    guarded<helics::ActionMessage> act2;
+    guarded<helics::ActionMessage> act3;
+
+    helics::shm::ShmComms comm;
+    helics::shm::ShmComms comm2;
+    helics::shm::ShmComms comm3;
+    comm.loadTargetInfo(localLoc, brokerLoc);
+    comm2.loadTargetInfo(brokerLoc, std::string());
+    comm3.loadTargetInfo(localLocB, brokerLoc);
+
+    comm.setCallback([&counter, &act](const helics::ActionMessage& m) {
+        ++counter;
+        act = m;
+    });
+    comm2.setCallback([&counter2, &act2](const helics::ActionMessage& m) {
+        ++counter2;
+        act2 = m;
+    });
+    comm3.setCallback([&counter3, &act3](const helics::ActionMessage& m) {
+        ++counter3;
+        act3 = m;
+    });
+
+    bool connected = comm2.connect();
+    ASSERT_TRUE(connected);
+    connected = comm.connect();
+    ASSERT_TRUE(connected);
+    connected = comm3.connect();
+    ASSERT_TRUE(connected);
+
+    comm.transmit(helics::parent_route_id, helics::CMD_ACK);
+    std::this_thread::sleep_for(100ms);
+    if (counter2 != 1) {
+        std::this_thread::sleep_for(350ms);
+    }
+    ASSERT_EQ(counter2, 1);
+    EXPECT_TRUE(act2.lock()->action() == helics::action_message_def::action_t::cmd_ack);
+
+    comm3.transmit(helics::parent_route_id, helics::CMD_ACK);
+    std::this_thread::sleep_for(100ms);
+    if (counter2 != 2) {
+        std::this_thread::sleep_for(350ms);
+    }
+    ASSERT_EQ(counter2, 2);
+
+    comm2.addRoute(helics::route_id(3), localLocB);
+    comm2.transmit(helics::route_id(3), helics::CMD_ACK);
+    std::this_thread::sleep_for(100ms);
+    if (counter3 != 1) {
+        std::this_thread::sleep_for(350ms);
+    }
+    ASSERT_EQ(counter3, 1);
+    EXPECT_TRUE(act3.lock()->action() == helics::action_message_def::action_t::cmd_ack);
+
+    comm2.addRoute(helics::route_id(4), localLoc);
+    comm2.transmit(helics::route_id(4), helics::CMD_ACK);
+    std::this_thread::sleep_for(100ms);
+    if (counter.load() != 1) {
+        std::this_thread::sleep_for(350ms);
+    }
+    ASSERT_EQ(counter.load(), 1);
+    EXPECT_TRUE(act.lock()->action() == helics::action_message_def::action_t::cmd_ack);
+
+    comm.disconnect();
+    comm2.disconnect();
+    comm3.disconnect();
+    std::this_thread::sleep_for(100ms);
+}
+
+/** test case checks default values and makes sure they all mesh together*/
+TEST(ShmCore, shmCore_core_broker_default)
+{
+    std::string initializationString = "-f 1";
+
+    auto broker = helics::BrokerFactory::create(helics::CoreType::SHM, initializationString);
+
+    auto core = helics::CoreFactory::create(helics::CoreType::SHM, initializationString);
+    bool connected = broker->isConnected();
+    EXPECT_TRUE(connected);
+    connected = core->connect();
+    EXPECT_TRUE(connected);
+
+    core->disconnect();
+    broker->disconnect();
+    core = nullptr;
+    broker = nullptr;
+    helics::CoreFactory::cleanUpCores(100ms);
+    helics::BrokerFactory::cleanUpBrokers(100ms);
+}
+
+TEST(ShmCore, commFactory)
+{
+    auto comm = helics::CommFactory::create("shm");
+    auto comm2 = helics::CommFactory::create(helics::CoreType::SHM);
+
+    EXPECT_TRUE(dynamic_cast<helics::shm::ShmComms*>(comm.get()) != nullptr);
+    EXPECT_TRUE(dynamic_cast<helics::shm::ShmComms*>(comm2.get()) != nullptr);
+}
@@ -14,9 +14,11 @@ SPDX-License-Identifier: BSD-3-Clause
 #include "helics/network/udp/UdpBroker.h"
 #include "helics/network/udp/UdpComms.h"
 #include "helics/network/udp/UdpCore.h"
+#include "helics/network/udp/UdpDatagram.h"
 
 #include "gtest/gtest.h"
 #include <asio/ip/udp.hpp>
+#include <algorithm>
 #include <future>
 #include <string>
 #include <thread>
@@ -360,6 +362,176 @@ TEST(UdpCore, udpCore_core_broker_default)
     helics::BrokerFactory::cleanUpBrokers(100ms);
 }
 
+TEST(UdpCore, udpCore_batched_core_broker)
+{
+    std::this_thread::sleep_for(500ms);
+    std::string initializationString = "-f 1 --batch_transmit --max_datagram_size=512";
+
+    auto broker = helics::BrokerFactory::create(helics::CoreType::UDP, initializationString);
+
+    auto core = helics::CoreFactory::create(helics::CoreType::UDP, initializationString);
+    EXPECT_TRUE(broker->isConnected());
+    EXPECT_TRUE(core->connect());
+    // the global value is larger than a datagram so is fragmented in both directions
+    const std::string globalVal(4000, 'g');
+    core->setGlobal("large_global", globalVal);
+    auto res = core->query("global_value", "large_global", HELICS_SEQUENCING_MODE_ORDERED);
+    EXPECT_EQ(res, globalVal);
+    core->disconnect();
+    broker->disconnect();
+    core = nullptr;
+    broker = nullptr;
+    helics::CoreFactory::cleanUpCores(100ms);
+    helics::BrokerFactory::cleanUpBrokers(100ms);
+}
+
+TEST(UdpDatagram, coalesce_messages)
+{
+    const udp::endpoint destination(asio::ip::make_address("127.0.0.1"), 23990);
+    const udp::endpoint source(asio::ip::make_address("127.0.0.1"), 23991);
+    helics::udp::DatagramBatcher batcher(1400);
+    for (int ii = 0; ii < 20; ++ii) {
+        helics::ActionMessage cmd(helics::CMD_PUB);
+        cmd.counter = static_cast<uint16_t>(ii);
+        cmd.payload = "value";
+        batcher.add(destination, cmd);
+    }
+    auto& datagrams = batcher.flush();
+    ASSERT_EQ(datagrams.size(), 1U);
+    EXPECT_FALSE(datagrams[0].reliable);
+    EXPECT_EQ(datagrams[0].destination, destination);
+    EXPECT_LE(datagrams[0].data.size(), 1400U);
+
+    helics::udp::DatagramAssembler assembler;
+    std::vector<helics::ActionMessage> messages;
+    auto ack = assembler.process(source,
+                                 datagrams[0].data.data(),
+                                 datagrams[0].data.size(),
+                                 messages);
+    EXPECT_FALSE(ack);
+    ASSERT_EQ(messages.size(), 20U);
+    for (int ii = 0; ii < 20; ++ii) {
+        EXPECT_EQ(messages[ii].action(), helics::CMD_PUB);
+        EXPECT_EQ(messages[ii].counter, ii);
+    }
+    datagrams.clear();
+    EXPECT_TRUE(batcher.empty());
+}
+
+TEST(UdpDatagram, fragment_large_message)
+{
+    const udp::endpoint destination(asio::ip::make_address("127.0.0.1"), 23990);
+    const udp::endpoint source(asio::ip::make_address("127.0.0.1"), 23991);
+    helics::udp::DatagramBatcher batcher(1400);
+    helics::ActionMessage small(helics::CMD_TIME_REQUEST);
+    helics::ActionMessage large(helics::CMD_PUB);
+    large.payload = std::string(100000, 'a');
+    batcher.add(destination, small);
+    batcher.add(destination, large);
+    auto datagrams = batcher.flush();
+    ASSERT_GT(datagrams.size(), 70U);
+    // the time request is sent first and must be acknowledged
+    EXPECT_TRUE(datagrams.front().reliable);
+    for (const auto& datagram : datagrams) {
+        EXPECT_LE(datagram.data.size(), 1400U);
+    }
+
+    helics::udp::DatagramAssembler assembler;
+    std::vector<helics::ActionMessage> messages;
+    // deliver the fragments out of order
+    std::reverse(datagrams.begin() + 1, datagrams.end());
+    for (const auto& datagram : datagrams) {
+        assembler.process(source, datagram.data.data(), datagram.data.size(), messages);
+    }
+    ASSERT_EQ(messages.size(), 2U);
+    EXPECT_EQ(messages[0].action(), helics::CMD_TIME_REQUEST);
+    EXPECT_EQ(messages[1].action(), helics::CMD_PUB);
+    EXPECT_EQ(messages[1].payload.size(), 100000U);
+    EXPECT_EQ(assembler.incompleteCount(), 0U);
+}
+
+TEST(UdpDatagram, retransmit_control_messages)
+{
+    const udp::endpoint destination(asio::ip::make_address("127.0.0.1"), 23990);
+    const udp::endpoint source(asio::ip::make_address("127.0.0.1"), 23991);
+    helics::udp::DatagramBatcher batcher;
+    helics::ActionMessage grant(helics::CMD_TIME_GRANT);
+    batcher.add(destination, grant);
+    auto datagrams = batcher.flush();
+    ASSERT_EQ(datagrams.size(), 1U);
+    ASSERT_TRUE(datagrams[0].reliable);
+
+    helics::udp::RetransmitTracker tracker(std::chrono::milliseconds(50), 2);
+    auto start = std::chrono::steady_clock::now();
+    tracker.track(datagrams[0], start);
+    std::vector<helics::udp::Datagram> resend;
+    EXPECT_EQ(tracker.collectExpired(start, resend), 0U);
+    EXPECT_TRUE(resend.empty());
+    EXPECT_EQ(tracker.collectExpired(start + 60ms, resend), 0U);
+    ASSERT_EQ(resend.size(), 1U);
+
+    // the receiver acknowledges both copies but only delivers the message once
+    helics::udp::DatagramAssembler assembler;
+    std::vector<helics::ActionMessage> messages;
+    auto ack1 =
+        assembler.process(source, datagrams[0].data.data(), datagrams[0].data.size(), messages);
+    auto ack2 = assembler.process(source, resend[0].data.data(), resend[0].data.size(), messages);
+    ASSERT_TRUE(ack1);
+    ASSERT_TRUE(ack2);
+    EXPECT_EQ(*ack1, *ack2);
+    EXPECT_EQ(messages.size(), 1U);
+    EXPECT_EQ(assembler.duplicateCount(), 1U);
+
+    auto ackData = helics::udp::generateAckDatagram({*ack1});
+    std::vector<std::uint32_t> sequences;
+    ASSERT_TRUE(helics::udp::readAckDatagram(ackData.data(), ackData.size(), sequences));
+    ASSERT_EQ(sequences.size(), 1U);
+    tracker.acknowledge(sequences[0]);
+    EXPECT_TRUE(tracker.empty());
+
+    // unacknowledged datagrams are dropped after the maximum number of retries
+    tracker.track(datagrams[0], start);
+    resend.clear();
+    EXPECT_EQ(tracker.collectExpired(start + 1s, resend), 0U);
+    EXPECT_EQ(tracker.collectExpired(start + 2s, resend), 0U);
+    EXPECT_EQ(tracker.collectExpired(start + 3s, resend), 1U);
+    EXPECT_EQ(resend.size(), 2U);
+    EXPECT_TRUE(tracker.empty());
+}
+
+TEST(UdpDatagram, sender_restart)
+{
+    const udp::endpoint destination(asio::ip::make_address("127.0.0.1"), 23990);
+    const udp::endpoint source(asio::ip::make_address("127.0.0.1"), 23991);
+    helics::udp::DatagramAssembler assembler;
+    std::vector<helics::ActionMessage> messages;
+    helics::ActionMessage grant(helics::CMD_TIME_GRANT);
+
+    helics::udp::DatagramBatcher batcher1;
+    batcher1.add(destination, grant);
+    auto datagrams1 = batcher1.flush();
+    ASSERT_EQ(datagrams1.size(), 1U);
+    auto ack1 =
+        assembler.process(source, datagrams1[0].data.data(), datagrams1[0].data.size(), messages);
+    EXPECT_TRUE(ack1);
+    // a restarted sender reuses the sequence numbers with a new session
+    helics::udp::DatagramBatcher batcher2;
+    EXPECT_NE(batcher1.getSession(), batcher2.getSession());
+    batcher2.add(destination, grant);
+    auto datagrams2 = batcher2.flush();
+    ASSERT_EQ(datagrams2.size(), 1U);
+    EXPECT_EQ(datagrams1[0].sequence, datagrams2[0].sequence);
+    auto ack2 =
+        assembler.process(source, datagrams2[0].data.data(), datagrams2[0].data.size(), messages);
+    EXPECT_TRUE(ack2);
+    EXPECT_EQ(messages.size(), 2U);
+    EXPECT_EQ(assembler.duplicateCount(), 0U);
+    // retransmissions within the new session are still dropped
+    assembler.process(source, datagrams2[0].data.data(), datagrams2[0].data.size(), messages);
+    EXPECT_EQ(messages.size(), 2U);
+    EXPECT_EQ(assembler.duplicateCount(), 1U);
+}
+
 TEST(UdpCore, commFactory)
 {
     auto comm = helics::CommFactory::create("udp");
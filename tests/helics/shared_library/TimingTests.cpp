@@ -5,6 +5,7 @@ Energy, LLC.  See the top-level NOTICE for additional details. All rights reserv
 SPDX-License-Identifier: BSD-3-Clause
 */
 
+#include <atomic>
 #include <complex>
 #include <gtest/gtest.h>
 /** these test cases test out the value converters
@@ -133,6 +134,40 @@ TEST_F(timing_tests, simple_timing_test_message)
     CE(helicsFederateFinalize(vFed2, &err));
 }
 
+static void countCompletion(HelicsFederate /*fed*/, void* userdata)
+{
+    ++(*reinterpret_cast<std::atomic<int>*>(userdata));
+}
+
+TEST_F(timing_tests, async_callback_timing)
+{
+    SetupTest(helicsCreateValueFederate, "test", 2);
+    auto vFed1 = GetFederateAt(0);
+    auto vFed2 = GetFederateAt(1);
+
+    CE(helicsFederateSetTimeProperty(vFed1, HELICS_PROPERTY_TIME_PERIOD, 0.5, &err));
+    CE(helicsFederateSetTimeProperty(vFed2, HELICS_PROPERTY_TIME_PERIOD, 0.5, &err));
+    CE(helicsFederateEnterExecutingModeAsync(vFed1, &err));
+    CE(helicsFederateEnterExecutingMode(vFed2, &err));
+    CE(helicsFederateEnterExecutingModeComplete(vFed1, &err));
+
+    std::atomic<int> completions{0};
+    CE(helicsFederateRequestTimeAsyncCallback(vFed1, 2.0, countCompletion, &completions, &err));
+    HelicsTime gtime;
+    CE(gtime = helicsFederateRequestTime(vFed2, 2.0, &err));
+    EXPECT_EQ(gtime, 2.0);
+    CE(gtime = helicsFederateRequestTimeComplete(vFed1, &err));
+    EXPECT_EQ(gtime, 2.0);
+    EXPECT_EQ(completions.load(), 1);
+
+    helicsFederateRequestTimeAsyncCallback(vFed1, 3.0, nullptr, nullptr, &err);
+    EXPECT_NE(err.error_code, 0);
+    helicsErrorClear(&err);
+
+    CE(helicsFederateFinalize(vFed1, &err));
+    CE(helicsFederateFinalize(vFed2, &err));
+}
+
 TEST_F(timing_tests, timing_with_input_delay)
 {
     SetupTest(helicsCreateMessageFederate, "test", 2);
@@ -169,6 +169,43 @@ TEST_F(mfed_tests, send_receive_string)
     helicsCleanupLibrary();
 }
 
+TEST_F(mfed_tests, receive_all)
+{
+    SetupTest(helicsCreateMessageFederate, "test", 1);
+    auto mFed1 = GetFederateAt(0);
+
+    auto epid = helicsFederateRegisterEndpoint(mFed1, "ep1", nullptr, &err);
+    auto epid2 = helicsFederateRegisterGlobalEndpoint(mFed1, "ep2", "random", &err);
+    EXPECT_EQ(err.error_code, HELICS_OK);
+    CE(helicsFederateSetTimeProperty(mFed1, HELICS_PROPERTY_TIME_DELTA, 1.0, &err));
+
+    CE(helicsFederateEnterExecutingMode(mFed1, &err));
+    CE(helicsEndpointSendStringToAt(epid, "third", "ep2", 0.5, &err));
+    CE(helicsEndpointSendStringToAt(epid, "first", "ep2", 0.0, &err));
+    CE(helicsEndpointSendStringToAt(epid, "second", "ep2", 0.25, &err));
+    HelicsTime time;
+    CE(time = helicsFederateRequestTime(mFed1, 1.0, &err));
+    EXPECT_EQ(time, 1.0);
+    EXPECT_EQ(helicsEndpointPendingMessageCount(epid2), 3);
+
+    HelicsMessage messages[4];
+    int count{0};
+    CE(helicsEndpointReceiveAll(epid2, messages, 2, &count, &err));
+    ASSERT_EQ(count, 2);
+    EXPECT_STREQ(helicsMessageGetString(messages[0]), "first");
+    EXPECT_STREQ(helicsMessageGetString(messages[1]), "second");
+    CE(helicsEndpointReceiveAll(epid2, messages, 4, &count, &err));
+    ASSERT_EQ(count, 1);
+    EXPECT_STREQ(helicsMessageGetString(messages[0]), "third");
+    CE(helicsEndpointReceiveAll(epid2, messages, 4, &count, &err));
+    EXPECT_EQ(count, 0);
+    CE(helicsEndpointReceiveAll(epid2, nullptr, 4, &count, &err));
+    EXPECT_EQ(count, 0);
+
+    CE(helicsFederateFinalize(mFed1, &err));
+    helicsCleanupLibrary();
+}
+
 TEST_P(mfed_simple_type_tests, send_receive_mobj)
 {
     SetupTest(helicsCreateMessageFederate, GetParam(), 1);
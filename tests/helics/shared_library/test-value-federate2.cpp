@@ -377,6 +377,48 @@ TEST_F(vfed2_tests, json_register_publish)
     CE(helicsFederateFinalize(vFed1, &err));
 }
 
+TEST_F(vfed2_tests, updated_values)
+{
+    SetupTest(helicsCreateValueFederate, "test", 1);
+    auto vFed1 = GetFederateAt(0);
+    ASSERT_FALSE(vFed1 == nullptr);
+    std::vector<HelicsPublication> pubs;
+    for (int ii = 0; ii < 4; ++ii) {
+        auto pubName = "pub" + std::to_string(ii);
+        pubs.push_back(helicsFederateRegisterGlobalPublication(
+            vFed1, pubName.c_str(), HELICS_DATA_TYPE_DOUBLE, "", &err));
+        helicsFederateRegisterSubscription(vFed1, pubName.c_str(), nullptr, &err);
+    }
+    CE(helicsFederateEnterExecutingMode(vFed1, &err));
+    CE(helicsPublicationPublishDouble(pubs[0], 1.5, &err));
+    CE(helicsPublicationPublishDouble(pubs[2], 3.0, &err));
+    CE(helicsFederateRequestTime(vFed1, 1.0, &err));
+
+    double values[4] = {0.0, 0.0, 0.0, 0.0};
+    int indices[4] = {-1, -1, -1, -1};
+    auto count = helicsFederateGetUpdatedDoubles(vFed1, values, indices, 4, &err);
+    EXPECT_EQ(err.error_code, 0);
+    ASSERT_EQ(count, 2);
+    EXPECT_EQ(indices[0], 0);
+    EXPECT_EQ(indices[1], 2);
+    EXPECT_DOUBLE_EQ(values[0], 1.5);
+    EXPECT_DOUBLE_EQ(values[1], 3.0);
+    EXPECT_EQ(helicsFederateGetUpdatedDoubles(vFed1, values, indices, 4, &err), 0);
+
+    CE(helicsPublicationPublishDouble(pubs[3], 12.2, &err));
+    CE(helicsFederateRequestTime(vFed1, 2.0, &err));
+    int64_t ivalues[4] = {0, 0, 0, 0};
+    count = helicsFederateGetUpdatedIntegers(vFed1, ivalues, nullptr, 4, &err);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(ivalues[0], 12);
+
+    EXPECT_EQ(helicsFederateGetUpdatedDoubles(vFed1, nullptr, nullptr, 4, &err), 0);
+    EXPECT_NE(err.error_code, 0);
+    helicsErrorClear(&err);
+
+    CE(helicsFederateFinalize(vFed1, &err));
+}
+
 INSTANTIATE_TEST_SUITE_P(vfed_tests,
                          vfed2_simple_type_tests,
                          ::testing::ValuesIn(CoreTypes_simple));
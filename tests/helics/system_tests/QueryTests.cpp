@@ -198,6 +198,37 @@ TEST_F(query, federate_map3)
     helics::cleanupHelicsLibrary();
 }
 
+TEST_F(query, federate_map_refresh)
+{
+    SetupTest<helics::ValueFederate>("test_2", 1);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto core = vFed1->getCorePointer();
+    auto res = core->query("root", "federate_map", HELICS_SEQUENCING_MODE_FAST);
+    auto val = loadJsonStr(res);
+    EXPECT_EQ(val["cores"].size(), 1U);
+    // the completed map is reused while nothing changes
+    EXPECT_EQ(core->query("root", "federate_map", HELICS_SEQUENCING_MODE_FAST), res);
+
+    // a new federate makes the completed map stale so it is refreshed instead of waiting
+    AddFederates<helics::ValueFederate>("test_2", 1, brokers[0]);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+    res = core->query("root", "federate_map", HELICS_SEQUENCING_MODE_FAST);
+    val = loadJsonStr(res);
+    ASSERT_EQ(val["cores"].size(), 2U);
+    EXPECT_EQ(val["cores"][0]["federates"].size(), 1U);
+    EXPECT_EQ(val["cores"][1]["federates"].size(), 1U);
+    EXPECT_EQ(val["cores"][1]["federates"][0]["attributes"]["name"].get<std::string>(),
+              vFed2->getName());
+
+    vFed1->enterInitializingModeAsync();
+    vFed2->enterInitializingMode();
+    vFed1->enterInitializingModeComplete();
+    core = nullptr;
+    vFed1->finalize();
+    vFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
 TEST_F(query, dependency_graph)
 {
     SetupTest<helics::ValueFederate>("test", 2);
@@ -609,6 +640,47 @@ TEST_F(query, data_flow_graph_non_utf8)
     helics::cleanupHelicsLibrary();
 }
 
+TEST_F(query, data_flow_graph_delta)
+{
+    SetupTest<helics::ValueFederate>("test", 2);
+    auto vFed1 = GetFederateAs<helics::ValueFederate>(0);
+    auto vFed2 = GetFederateAs<helics::ValueFederate>(1);
+
+    vFed1->registerGlobalInput<double>("ipt1");
+    auto& pub1 = vFed2->registerGlobalPublication<double>("pub1");
+    pub1.addTarget("ipt1");
+    vFed1->enterInitializingModeAsync();
+    vFed2->enterInitializingMode();
+    vFed1->enterInitializingModeComplete();
+    auto core = vFed1->getCorePointer();
+    auto res = core->query("root", "delta:data_flow_graph:0", HELICS_SEQUENCING_MODE_FAST);
+    auto val = loadJsonStr(res);
+    const auto revision = val["revision"].get<std::uint64_t>();
+    EXPECT_GT(revision, 0U);
+    EXPECT_EQ(val["since"].get<std::uint64_t>(), 0U);
+    EXPECT_TRUE(val["base"].is_object());
+    ASSERT_EQ(val["updated"]["cores"].size(), 1U);
+    EXPECT_EQ(val["updated"]["cores"][0]["federates"].size(), 2U);
+
+    // nothing changed so polling with the current revision returns an empty delta
+    res = core->query("root",
+                      "delta:data_flow_graph:" + std::to_string(revision),
+                      HELICS_SEQUENCING_MODE_FAST);
+    val = loadJsonStr(res);
+    EXPECT_EQ(val["revision"].get<std::uint64_t>(), revision);
+    EXPECT_FALSE(val.contains("base"));
+    EXPECT_FALSE(val.contains("updated"));
+    EXPECT_FALSE(val.contains("removed"));
+
+    res = core->query("root", "delta:global_status:0", HELICS_SEQUENCING_MODE_FAST);
+    val = loadJsonStr(res);
+    EXPECT_TRUE(val.contains("error"));
+    core = nullptr;
+    vFed1->finalize();
+    vFed2->finalize();
+    helics::cleanupHelicsLibrary();
+}
+
 TEST_F(query, interfaces)
 {
     SetupTest<helics::CombinationFederate>("test", 1);
@@ -6,9 +6,11 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "helics/application_api/ValueFederate.hpp"
+#include "helics/common/JsonProcessingFunctions.hpp"
 #include "helics/core/BrokerFactory.hpp"
 #include "helics/core/Core.hpp"
 #include "helics/core/CoreFactory.hpp"
+#include "helics/core/ProfilerBuffer.hpp"
 #include "helics/core/core-exceptions.hpp"
 #include "helics/core/helics_definitions.hpp"
 
@@ -18,6 +20,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <gmlc/libguarded/guarded.hpp>
 #include <gtest/gtest.h>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <regex>
 #include <string>
 #include <thread>
@@ -319,6 +322,54 @@ TEST(profiling_tests, save_file)
     std::filesystem::remove("save_profile.txt");
 }
 
+TEST(profiling_tests, save_binary_file)
+{
+    helics::FederateInfo fedInfo(CORE_TYPE_TO_TEST);
+    fedInfo.coreInitString = "--autobroker --profiler=save_profile.hprof";
+
+    auto Fed = std::make_shared<helics::Federate>("test1", fedInfo);
+
+    Fed->enterExecutingMode();
+    Fed->finalize();
+    helics::cleanupHelicsLibrary();
+    if (!std::filesystem::exists("save_profile.hprof")) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        helics::cleanupHelicsLibrary();
+    }
+    ASSERT_TRUE(std::filesystem::exists("save_profile.hprof"));
+
+    auto profile = helics::loadBinaryProfile("save_profile.hprof");
+    ASSERT_EQ(profile.size(), 1U);
+    EXPECT_EQ(profile[0].name, "test1");
+    const auto& records = profile[0].records;
+    ASSERT_FALSE(records.empty());
+    bool hasMarker{false};
+    bool increasing{true};
+    std::int64_t current = 0LL;
+    for (const auto& record : records) {
+        if (record.event == helics::ProfilerEvent::MARKER) {
+            hasMarker = true;
+            EXPECT_GT(record.systemTime, 0);
+        }
+        if (record.steadyTime < current) {
+            increasing = false;
+        }
+        current = record.steadyTime;
+    }
+    EXPECT_TRUE(hasMarker);
+    EXPECT_TRUE(increasing);
+
+    auto count = helics::convertProfileToTrace("save_profile.hprof", "save_profile_trace.json");
+    // one thread name event in addition to the records
+    EXPECT_EQ(count, records.size() + 1);
+    auto trace = helics::fileops::loadJson("save_profile_trace.json");
+    ASSERT_TRUE(trace["traceEvents"].is_array());
+    EXPECT_EQ(trace["traceEvents"].size(), count);
+    EXPECT_EQ(trace["traceEvents"][0]["args"]["name"], "test1");
+    std::filesystem::remove("save_profile.hprof");
+    std::filesystem::remove("save_profile_trace.json");
+}
+
 TEST(profiling_tests, save_file_append)
 {
     {